@@ -0,0 +1,199 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_SCENE_H
+#define BENCHMARK_SCENE_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <cstdint>
+
+namespace reactphysics3d {
+
+// Constants
+constexpr decimal BENCHMARK_TIME_STEP = decimal(1.0) / decimal(60.0);
+
+// Class CountingAllocator
+/**
+ * Base memory allocator of the benchmarks. It forwards the allocations to the default
+ * allocator and counts them. Since the pool and single-frame allocators of the library only
+ * call their base allocator when they run out of memory, this is the number of allocations
+ * that actually reach the system heap.
+ */
+class CountingAllocator : public MemoryAllocator {
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Default allocator
+        DefaultAllocator mAllocator;
+
+        /// Number of allocations since the creation of the allocator
+        uint64_t mNbAllocations = 0;
+
+        /// Number of allocated bytes since the creation of the allocator
+        uint64_t mNbAllocatedBytes = 0;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Allocate memory of a given size (in bytes)
+        virtual void* allocate(size_t size) override {
+            mNbAllocations++;
+            mNbAllocatedBytes += size;
+            return mAllocator.allocate(size);
+        }
+
+        /// Release previously allocated memory
+        virtual void release(void* pointer, size_t size) override {
+            mAllocator.release(pointer, size);
+        }
+
+        /// Return the number of allocations since the creation of the allocator
+        uint64_t getNbAllocations() const {
+            return mNbAllocations;
+        }
+
+        /// Return the number of allocated bytes since the creation of the allocator
+        uint64_t getNbAllocatedBytes() const {
+            return mNbAllocatedBytes;
+        }
+};
+
+// Class BenchmarkRandom
+/**
+ * Small linear congruential generator used to place the bodies of the scenes. Its
+ * sequence only depends on the seed so that the scenes are the same on every run and platform.
+ */
+class BenchmarkRandom {
+
+    private :
+
+        /// Current state of the generator
+        uint32_t mState;
+
+    public :
+
+        /// Constructor
+        explicit BenchmarkRandom(uint32_t seed = 1) : mState(seed) {}
+
+        /// Return a random number in [min, max]
+        decimal next(decimal min, decimal max) {
+            mState = mState * 1664525u + 1013904223u;
+            return min + (max - min) * decimal(mState >> 8) / decimal(0xFFFFFF);
+        }
+};
+
+// Class BenchmarkScene
+/**
+ * Physics world with its own PhysicsCommon and counting allocator. The benchmarks and the
+ * performance regression harness create the bodies of a scene (see BenchmarkScenes.h) in it
+ * and then measure the steps of the world.
+ */
+class BenchmarkScene {
+
+    private :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Counting base allocator of the physics common
+        CountingAllocator mAllocator;
+
+        /// Physics common
+        PhysicsCommon mPhysicsCommon;
+
+        /// Physics world of the scene
+        PhysicsWorld* mWorld;
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        explicit BenchmarkScene(const PhysicsWorld::WorldSettings& worldSettings = PhysicsWorld::WorldSettings())
+            : mPhysicsCommon(&mAllocator) {
+
+            // Sleeping is disabled so that every measured step simulates the whole scene
+            PhysicsWorld::WorldSettings settings = worldSettings;
+            settings.isSleepingEnabled = false;
+            mWorld = mPhysicsCommon.createPhysicsWorld(settings);
+        }
+
+        /// Destructor
+        ~BenchmarkScene() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Deleted copy-constructor
+        BenchmarkScene(const BenchmarkScene& scene) = delete;
+
+        /// Deleted assignment operator
+        BenchmarkScene& operator=(const BenchmarkScene& scene) = delete;
+
+        /// Return the physics common of the scene
+        PhysicsCommon& getPhysicsCommon() {
+            return mPhysicsCommon;
+        }
+
+        /// Return the physics world of the scene
+        PhysicsWorld& getWorld() {
+            return *mWorld;
+        }
+
+        /// Return the counting allocator of the scene
+        const CountingAllocator& getAllocator() const {
+            return mAllocator;
+        }
+
+        /// Create a static box
+        RigidBody* createStaticBox(const Vector3& position, const Vector3& halfExtents) {
+            RigidBody* body = mWorld->createRigidBody(Transform(position, Quaternion::identity()));
+            body->setType(BodyType::STATIC);
+            body->addCollider(mPhysicsCommon.createBoxShape(halfExtents), Transform::identity());
+            return body;
+        }
+
+        /// Create a dynamic body with a single collider
+        RigidBody* createDynamicBody(const Transform& transform, CollisionShape* shape) {
+            RigidBody* body = mWorld->createRigidBody(transform);
+            body->addCollider(shape, Transform::identity());
+            body->updateMassPropertiesFromColliders();
+            return body;
+        }
+
+        /// Take some steps of the world
+        void step(uint32 nbSteps) {
+            for (uint32 i = 0; i < nbSteps; i++) {
+                mWorld->update(BENCHMARK_TIME_STEP);
+            }
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,330 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "BenchmarkScenes.h"
+#include <cmath>
+#include <vector>
+
+namespace reactphysics3d {
+
+namespace {
+
+// Grid of kinematic robots spinning around the vertical axis among dynamic boxes. Each robot has
+// 40 colliders (a chassis, bumpers and two arms of segments) so that all its colliders move at
+// every step.
+bool createSpinningRobots(BenchmarkScene& scene, int nbRobotsPerSide, bool isCompound) {
+
+    const decimal spacing = decimal(9);
+    const decimal halfSize = decimal(nbRobotsPerSide) * spacing * decimal(0.5) + 2;
+    scene.createStaticBox(Vector3(0, -1, 0), Vector3(halfSize, 1, halfSize));
+
+    PhysicsCommon& physicsCommon = scene.getPhysicsCommon();
+    BoxShape* chassisShape = physicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.25), decimal(0.5)));
+    BoxShape* bumperShape = physicsCommon.createBoxShape(Vector3(decimal(0.25), decimal(0.25), decimal(0.1)));
+    CapsuleShape* segmentShape = physicsCommon.createCapsuleShape(decimal(0.15), decimal(0.3));
+    BoxShape* crateShape = physicsCommon.createBoxShape(Vector3(decimal(0.3), decimal(0.3), decimal(0.3)));
+
+    BenchmarkRandom random(11);
+    for (int i = 0; i < nbRobotsPerSide; i++) {
+        for (int j = 0; j < nbRobotsPerSide; j++) {
+
+            const Vector3 center((decimal(i) - decimal(nbRobotsPerSide - 1) * decimal(0.5)) * spacing, decimal(0.5),
+                                 (decimal(j) - decimal(nbRobotsPerSide - 1) * decimal(0.5)) * spacing);
+
+            RigidBody* robot = scene.getWorld().createRigidBody(Transform(center, Quaternion::identity()));
+            robot->setType(BodyType::KINEMATIC);
+            robot->setIsCompoundBroadPhase(isCompound);
+
+            // Chassis (4 x 4 boxes) and bumpers (8)
+            for (int x = 0; x < 4; x++) {
+                for (int z = 0; z < 4; z++) {
+                    robot->addCollider(chassisShape, Transform(Vector3(decimal(x) - decimal(1.5), 0, decimal(z) - decimal(1.5)), Quaternion::identity()));
+                }
+                robot->addCollider(bumperShape, Transform(Vector3(decimal(x) - decimal(1.5), 0, decimal(-2.1)), Quaternion::identity()));
+                robot->addCollider(bumperShape, Transform(Vector3(decimal(x) - decimal(1.5), 0, decimal(2.1)), Quaternion::identity()));
+            }
+
+            // Two horizontal arms of 8 segments
+            const Quaternion segmentOrientation = Quaternion::fromEulerAngles(0, 0, PI_RP3D * decimal(0.5));
+            for (int k = 0; k < 8; k++) {
+                const decimal x = decimal(2.3) + decimal(k) * decimal(0.6);
+                robot->addCollider(segmentShape, Transform(Vector3(x, decimal(0.5), 0), segmentOrientation));
+                robot->addCollider(segmentShape, Transform(Vector3(-x, decimal(0.5), 0), segmentOrientation));
+            }
+
+            robot->setAngularVelocity(Vector3(0, random.next(decimal(0.5), decimal(1.5)), 0));
+
+            // Boxes around the robot that are pushed by its arms
+            for (int k = 0; k < 4; k++) {
+                const decimal angle = decimal(k) * PI_RP3D * decimal(0.5) + decimal(0.4);
+                const Vector3 position = center + Vector3(std::cos(angle) * decimal(4), decimal(0.6), std::sin(angle) * decimal(4));
+                scene.createDynamicBody(Transform(position, Quaternion::identity()), crateShape);
+            }
+        }
+    }
+
+    return true;
+}
+
+}
+
+// Pyramid of boxes (one box deep) with a given number of boxes on its base
+bool createBoxPyramidScene(BenchmarkScene& scene, int nbBaseBoxes) {
+
+    scene.createStaticBox(Vector3(0, -1, 0), Vector3(50, 1, 50));
+
+    BoxShape* boxShape = scene.getPhysicsCommon().createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+    for (int row = 0; row < nbBaseBoxes; row++) {
+        const int nbBoxes = nbBaseBoxes - row;
+        for (int i = 0; i < nbBoxes; i++) {
+            const decimal x = (decimal(i) - decimal(nbBoxes - 1) * decimal(0.5)) * decimal(1.02);
+            const decimal y = decimal(0.5) + decimal(row);
+            scene.createDynamicBody(Transform(Vector3(x, y, 0), Quaternion::identity()), boxShape);
+        }
+    }
+
+    return true;
+}
+
+// Pit of spheres closed by four walls
+bool createBallPitScene(BenchmarkScene& scene, int nbSpheres) {
+
+    const decimal radius = decimal(0.25);
+    const decimal spacing = decimal(0.55);
+    const int nbSpheresX = 25;
+    const int nbSpheresZ = 20;
+
+    // Ground and walls of the pit
+    const decimal halfSizeX = decimal(nbSpheresX) * spacing * decimal(0.5) + radius;
+    const decimal halfSizeZ = decimal(nbSpheresZ) * spacing * decimal(0.5) + radius;
+    scene.createStaticBox(Vector3(0, -1, 0), Vector3(halfSizeX + 1, 1, halfSizeZ + 1));
+    scene.createStaticBox(Vector3(-halfSizeX - decimal(0.5), 10, 0), Vector3(decimal(0.5), 10, halfSizeZ + 1));
+    scene.createStaticBox(Vector3(halfSizeX + decimal(0.5), 10, 0), Vector3(decimal(0.5), 10, halfSizeZ + 1));
+    scene.createStaticBox(Vector3(0, 10, -halfSizeZ - decimal(0.5)), Vector3(halfSizeX + 1, 10, decimal(0.5)));
+    scene.createStaticBox(Vector3(0, 10, halfSizeZ + decimal(0.5)), Vector3(halfSizeX + 1, 10, decimal(0.5)));
+
+    // Layers of spheres slightly shifted so that they do not stay stacked in columns
+    SphereShape* sphereShape = scene.getPhysicsCommon().createSphereShape(radius);
+    BenchmarkRandom random(7);
+    for (int i = 0; i < nbSpheres; i++) {
+        const int layer = i / (nbSpheresX * nbSpheresZ);
+        const int indexInLayer = i % (nbSpheresX * nbSpheresZ);
+        const decimal x = (decimal(indexInLayer % nbSpheresX) - decimal(nbSpheresX - 1) * decimal(0.5)) * spacing;
+        const decimal z = (decimal(indexInLayer / nbSpheresX) - decimal(nbSpheresZ - 1) * decimal(0.5)) * spacing;
+        const decimal y = radius + decimal(layer) * spacing;
+        const Vector3 jitter(random.next(decimal(-0.02), decimal(0.02)), 0, random.next(decimal(-0.02), decimal(0.02)));
+        scene.createDynamicBody(Transform(Vector3(x, y, z) + jitter, Quaternion::identity()), sphereShape);
+    }
+
+    return true;
+}
+
+// Grid of swinging chains of capsules linked by hinge joints with alternating axes and limits
+bool createRagdollChainsScene(BenchmarkScene& scene, int nbLinks) {
+
+    const int nbChainsPerSide = 8;
+    const decimal linkLength = decimal(0.6);
+    const decimal anchorHeight = decimal(2) + decimal(nbLinks) * linkLength;
+
+    scene.createStaticBox(Vector3(0, -1, 0), Vector3(50, 1, 50));
+
+    // The chains start tilted along the (1, -1, 0) direction (parallel, without overlap)
+    const Vector3 direction = Vector3(1, -1, 0).getUnit();
+    const Vector3 hingeAxes[2] = {Vector3(0, 0, 1), Vector3(1, 1, 0).getUnit()};
+    const Quaternion linkOrientation = Quaternion::fromEulerAngles(0, 0, PI_RP3D * decimal(0.25));
+    CapsuleShape* capsuleShape = scene.getPhysicsCommon().createCapsuleShape(decimal(0.1), linkLength - decimal(0.2));
+
+    for (int i = 0; i < nbChainsPerSide; i++) {
+        for (int j = 0; j < nbChainsPerSide; j++) {
+
+            const Vector3 anchor(decimal(i - nbChainsPerSide / 2) * decimal(1.5), anchorHeight,
+                                 decimal(j - nbChainsPerSide / 2) * decimal(1.5));
+            RigidBody* previousBody = scene.getWorld().createRigidBody(Transform(anchor, Quaternion::identity()));
+            previousBody->setType(BodyType::STATIC);
+
+            for (int k = 0; k < nbLinks; k++) {
+                const Vector3 jointPoint = anchor + direction * (decimal(k) * linkLength);
+                const Vector3 center = jointPoint + direction * (linkLength * decimal(0.5));
+                RigidBody* body = scene.createDynamicBody(Transform(center, linkOrientation), capsuleShape);
+
+                HingeJointInfo jointInfo(previousBody, body, jointPoint, hingeAxes[k % 2],
+                                         -PI_RP3D * decimal(0.25), PI_RP3D * decimal(0.25));
+                scene.getWorld().createJoint(jointInfo);
+
+                previousBody = body;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Convex hulls (QuickHull of a point cloud) dropped on a wavy static concave mesh
+bool createConvexHullsOnConcaveMeshScene(BenchmarkScene& scene, int nbHullsPerSide) {
+
+    PhysicsCommon& physicsCommon = scene.getPhysicsCommon();
+
+    // Indexed grid of the concave mesh
+    const int nbCells = 48;
+    std::vector<float> vertices;
+    std::vector<int> indices;
+    for (int i = 0; i <= nbCells; i++) {
+        for (int j = 0; j <= nbCells; j++) {
+            const float x = float(i - nbCells / 2);
+            const float z = float(j - nbCells / 2);
+            vertices.push_back(x);
+            vertices.push_back(0.6f * std::sin(x * 0.35f) * std::cos(z * 0.3f));
+            vertices.push_back(z);
+        }
+    }
+    for (int i = 0; i < nbCells; i++) {
+        for (int j = 0; j < nbCells; j++) {
+            const int v = i * (nbCells + 1) + j;
+            indices.insert(indices.end(), {v, v + 1, v + nbCells + 1, v + 1, v + nbCells + 2, v + nbCells + 1});
+        }
+    }
+    TriangleVertexArray triangleArray(uint32(vertices.size() / 3), vertices.data(), 3 * sizeof(float),
+                                      uint32(indices.size() / 3), indices.data(), 3 * sizeof(int),
+                                      TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                      TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+    std::vector<Message> messages;
+    TriangleMesh* triangleMesh = physicsCommon.createTriangleMesh(triangleArray, messages);
+    RigidBody* ground = scene.getWorld().createRigidBody(Transform::identity());
+    ground->setType(BodyType::STATIC);
+    ground->addCollider(physicsCommon.createConcaveMeshShape(triangleMesh), Transform::identity());
+
+    // Convex hull of random points on a sphere
+    BenchmarkRandom random(3);
+    std::vector<float> hullPoints;
+    for (int i = 0; i < 16; i++) {
+        Vector3 point(random.next(-1, 1), random.next(-1, 1), random.next(-1, 1));
+        point = point.getUnit() * decimal(0.4);
+        hullPoints.insert(hullPoints.end(), {float(point.x), float(point.y), float(point.z)});
+    }
+    VertexArray hullArray(hullPoints.data(), 3 * sizeof(float), uint32(hullPoints.size() / 3),
+                          VertexArray::DataType::VERTEX_FLOAT_TYPE);
+    ConvexMesh* convexMesh = physicsCommon.createConvexMesh(hullArray, messages);
+    if (triangleMesh == nullptr || convexMesh == nullptr) {
+        return false;
+    }
+    ConvexMeshShape* hullShape = physicsCommon.createConvexMeshShape(convexMesh);
+
+    for (int i = 0; i < nbHullsPerSide; i++) {
+        for (int j = 0; j < nbHullsPerSide; j++) {
+            const Vector3 position(decimal(i - nbHullsPerSide / 2) * decimal(1.5), decimal(2) + random.next(0, 3),
+                                   decimal(j - nbHullsPerSide / 2) * decimal(1.5));
+            const Quaternion orientation = Quaternion::fromEulerAngles(random.next(0, PI_RP3D), random.next(0, PI_RP3D), 0);
+            scene.createDynamicBody(Transform(position, orientation), hullShape);
+        }
+    }
+
+    return true;
+}
+
+// Boxes, spheres and capsules dropped on a height-field terrain
+bool createHeightFieldTerrainScene(BenchmarkScene& scene, int nbBodiesPerSide) {
+
+    PhysicsCommon& physicsCommon = scene.getPhysicsCommon();
+
+    const int nbGridPoints = 129;
+    std::vector<float> heights(nbGridPoints * nbGridPoints);
+    for (int i = 0; i < nbGridPoints; i++) {
+        for (int j = 0; j < nbGridPoints; j++) {
+            heights[i * nbGridPoints + j] = 2.0f * std::sin(float(j) * 0.1f) * std::cos(float(i) * 0.12f);
+        }
+    }
+    std::vector<Message> messages;
+    HeightField* heightField = physicsCommon.createHeightField(nbGridPoints, nbGridPoints, heights.data(),
+                                                               HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+    if (heightField == nullptr) {
+        return false;
+    }
+    RigidBody* terrain = scene.getWorld().createRigidBody(Transform::identity());
+    terrain->setType(BodyType::STATIC);
+    terrain->addCollider(physicsCommon.createHeightFieldShape(heightField), Transform::identity());
+
+    CollisionShape* shapes[3] = {physicsCommon.createBoxShape(Vector3(decimal(0.4), decimal(0.4), decimal(0.4))),
+                                 physicsCommon.createSphereShape(decimal(0.4)),
+                                 physicsCommon.createCapsuleShape(decimal(0.3), decimal(0.6))};
+    int index = 0;
+    for (int i = 0; i < nbBodiesPerSide; i++) {
+        for (int j = 0; j < nbBodiesPerSide; j++) {
+            for (int k = 0; k < nbBodiesPerSide; k++) {
+                const Vector3 position(decimal(i - nbBodiesPerSide / 2) * decimal(1.5), decimal(4) + decimal(k) * decimal(1.5),
+                                       decimal(j - nbBodiesPerSide / 2) * decimal(1.5));
+                scene.createDynamicBody(Transform(position, Quaternion::identity()), shapes[index % 3]);
+                index++;
+            }
+        }
+    }
+
+    return true;
+}
+
+// Grid of spinning kinematic robots with 40 colliders each among dynamic boxes
+bool createSpinningRobotsScene(BenchmarkScene& scene, int nbRobotsPerSide) {
+    return createSpinningRobots(scene, nbRobotsPerSide, false);
+}
+
+// Spheres moving fast in all directions without gravity inside a closed box
+bool createBallSwarmScene(BenchmarkScene& scene, int nbSpheres) {
+
+    const decimal radius = decimal(0.25);
+    const decimal halfSize = decimal(20);
+
+    scene.getWorld().setGravity(Vector3(0, 0, 0));
+
+    // Walls of the box
+    for (int axis = 0; axis < 3; axis++) {
+        for (int side = -1; side <= 1; side += 2) {
+            Vector3 position(0, 0, 0);
+            Vector3 halfExtents(halfSize + 1, halfSize + 1, halfSize + 1);
+            position[axis] = decimal(side) * (halfSize + decimal(0.5));
+            halfExtents[axis] = decimal(0.5);
+            scene.createStaticBox(position, halfExtents);
+        }
+    }
+
+    // The spheres start at random places with random velocities of a few meters per second
+    SphereShape* sphereShape = scene.getPhysicsCommon().createSphereShape(radius);
+    BenchmarkRandom random(11);
+    for (int i = 0; i < nbSpheres; i++) {
+        const Vector3 position(random.next(-halfSize + 1, halfSize - 1), random.next(-halfSize + 1, halfSize - 1),
+                               random.next(-halfSize + 1, halfSize - 1));
+        RigidBody* body = scene.createDynamicBody(Transform(position, Quaternion::identity()), sphereShape);
+        body->setLinearVelocity(Vector3(random.next(-5, 5), random.next(-5, 5), random.next(-5, 5)));
+        body->getCollider(0)->getMaterial().setBounciness(decimal(1.0));
+    }
+
+    return true;
+}
+
+// Same scene as createSpinningRobotsScene() with the colliders of each robot grouped in the broad-phase
+bool createCompoundSpinningRobotsScene(BenchmarkScene& scene, int nbRobotsPerSide) {
+    return createSpinningRobots(scene, nbRobotsPerSide, true);
+}
+
+}
@@ -0,0 +1,64 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef BENCHMARK_SCENES_H
+#define BENCHMARK_SCENES_H
+
+// Libraries
+#include "BenchmarkScene.h"
+
+namespace reactphysics3d {
+
+// Builders of the standard scenes shared by the benchmarks and the performance regression
+// harness. A scene only depends on the parameter of its builder so that it is the same on every
+// run. A builder returns false if a mesh or a height-field of its scene cannot be created.
+
+/// Pyramid of boxes (one box deep) with a given number of boxes on its base
+bool createBoxPyramidScene(BenchmarkScene& scene, int nbBaseBoxes);
+
+/// Pit of spheres closed by four walls
+bool createBallPitScene(BenchmarkScene& scene, int nbSpheres);
+
+/// Grid of 8x8 chains of capsules linked by hinge joints
+bool createRagdollChainsScene(BenchmarkScene& scene, int nbLinks);
+
+/// Grid of convex hulls dropped on a static concave mesh
+bool createConvexHullsOnConcaveMeshScene(BenchmarkScene& scene, int nbHullsPerSide);
+
+/// Cube of boxes, spheres and capsules dropped on a height-field terrain
+bool createHeightFieldTerrainScene(BenchmarkScene& scene, int nbBodiesPerSide);
+
+/// Grid of spinning kinematic robots with 40 colliders each among dynamic boxes
+bool createSpinningRobotsScene(BenchmarkScene& scene, int nbRobotsPerSide);
+
+/// Same scene as createSpinningRobotsScene() with the colliders of each robot grouped in the broad-phase
+bool createCompoundSpinningRobotsScene(BenchmarkScene& scene, int nbRobotsPerSide);
+
+/// Spheres moving fast in all directions without gravity inside a closed box
+bool createBallSwarmScene(BenchmarkScene& scene, int nbSpheres);
+
+}
+
+#endif
@@ -0,0 +1,131 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "BenchmarkScene.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace reactphysics3d;
+
+namespace {
+
+// Grid of triangles that do not share their vertices (three vertices per triangle), as
+// exported by many modeling tools. The triangle mesh has to weld those vertices.
+struct UnsharedGrid {
+
+    std::vector<float> vertices;
+    std::vector<int> indices;
+
+    explicit UnsharedGrid(int nbCells) {
+        for (int i = 0; i < nbCells; i++) {
+            for (int j = 0; j < nbCells; j++) {
+                const float x0 = float(i), x1 = float(i + 1), z0 = float(j), z1 = float(j + 1);
+                const float corners[6][2] = {{x0, z0}, {x0, z1}, {x1, z0}, {x1, z0}, {x0, z1}, {x1, z1}};
+                for (const float* corner : corners) {
+                    indices.push_back(int(vertices.size() / 3));
+                    vertices.insert(vertices.end(), {corner[0], 0.01f * corner[0] * corner[1], corner[1]});
+                }
+            }
+        }
+    }
+
+    uint32 getNbTriangles() const {
+        return uint32(indices.size() / 3);
+    }
+};
+
+}
+
+// Creation of a triangle mesh from a triangle vertex array (validation and welding of the vertices)
+static void BM_TriangleMeshCreation(benchmark::State& state) {
+
+    CountingAllocator allocator;
+    PhysicsCommon physicsCommon(&allocator);
+    const UnsharedGrid grid(int(state.range(0)));
+    TriangleVertexArray triangleArray(uint32(grid.vertices.size() / 3), grid.vertices.data(), 3 * sizeof(float),
+                                      grid.getNbTriangles(), grid.indices.data(), 3 * sizeof(int),
+                                      TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                      TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+
+    std::vector<Message> messages;
+    uint32 nbWeldedVertices = 0;
+    for (auto _ : state) {
+        TriangleMesh* triangleMesh = physicsCommon.createTriangleMesh(triangleArray, messages);
+        if (triangleMesh == nullptr) {
+            state.SkipWithError("Cannot create the triangle mesh");
+            return;
+        }
+        nbWeldedVertices = triangleMesh->getNbVertices();
+
+        state.PauseTiming();
+        physicsCommon.destroyTriangleMesh(triangleMesh);
+        state.ResumeTiming();
+    }
+
+    state.counters["triangles"] = double(grid.getNbTriangles());
+    state.counters["vertices"] = double(nbWeldedVertices);
+}
+BENCHMARK(BM_TriangleMeshCreation)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond);
+
+// Creation of the same triangle mesh from its cooked data
+static void BM_TriangleMeshFromCookedData(benchmark::State& state) {
+
+    CountingAllocator allocator;
+    PhysicsCommon physicsCommon(&allocator);
+    std::vector<uint8> cookedData;
+    {
+        const UnsharedGrid grid(int(state.range(0)));
+        TriangleVertexArray triangleArray(uint32(grid.vertices.size() / 3), grid.vertices.data(), 3 * sizeof(float),
+                                          grid.getNbTriangles(), grid.indices.data(), 3 * sizeof(int),
+                                          TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                                          TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+        std::vector<Message> messages;
+        TriangleMesh* triangleMesh = physicsCommon.createTriangleMesh(triangleArray, messages);
+        if (triangleMesh == nullptr) {
+            state.SkipWithError("Cannot create the triangle mesh");
+            return;
+        }
+        physicsCommon.cookTriangleMesh(triangleMesh, cookedData);
+        physicsCommon.destroyTriangleMesh(triangleMesh);
+    }
+
+    std::vector<Message> messages;
+    for (auto _ : state) {
+        TriangleMesh* triangleMesh = physicsCommon.createTriangleMeshFromCookedData(cookedData.data(), cookedData.size(),
+                                                                                    messages);
+        if (triangleMesh == nullptr) {
+            state.SkipWithError("Cannot create the triangle mesh from its cooked data");
+            return;
+        }
+
+        state.PauseTiming();
+        physicsCommon.destroyTriangleMesh(triangleMesh);
+        state.ResumeTiming();
+    }
+
+    state.SetBytesProcessed(int64_t(state.iterations()) * int64_t(cookedData.size()));
+}
+BENCHMARK(BM_TriangleMeshFromCookedData)->Arg(100)->Arg(400)->Unit(benchmark::kMillisecond);
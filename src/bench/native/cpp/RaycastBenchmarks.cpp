@@ -0,0 +1,148 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "BenchmarkScene.h"
+#include <benchmark/benchmark.h>
+#include <vector>
+
+using namespace reactphysics3d;
+
+namespace {
+
+// Raycast callback keeping only the closest hit of each ray
+class ClosestHitCallback : public RaycastCallback {
+
+    public:
+
+        /// True if the current ray has hit a collider
+        bool hasHit = false;
+
+        /// Called when a ray hits a collider
+        virtual decimal notifyRaycastHit(const RaycastInfo& raycastInfo) override {
+            hasHit = true;
+            return raycastInfo.hitFraction;
+        }
+};
+
+// Create a field of static boxes and spheres and the storm of rays cast from the sky over it
+void createRaycastStorm(BenchmarkScene& scene, int nbRays, std::vector<Ray>& rays) {
+
+    PhysicsCommon& physicsCommon = scene.getPhysicsCommon();
+    const decimal halfSize = 40;
+
+    scene.createStaticBox(Vector3(0, -1, 0), Vector3(halfSize, 1, halfSize));
+
+    BenchmarkRandom random(11);
+    BoxShape* boxShape = physicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(1.5), decimal(0.5)));
+    SphereShape* sphereShape = physicsCommon.createSphereShape(decimal(0.75));
+    for (int i = 0; i < 2000; i++) {
+        const Vector3 position(random.next(-halfSize, halfSize), random.next(0, 10), random.next(-halfSize, halfSize));
+        RigidBody* body = scene.getWorld().createRigidBody(Transform(position, Quaternion::identity()));
+        body->setType(BodyType::STATIC);
+        body->addCollider(i % 2 == 0 ? static_cast<CollisionShape*>(boxShape) : sphereShape, Transform::identity());
+    }
+
+    rays.reserve(nbRays);
+    for (int i = 0; i < nbRays; i++) {
+        const Vector3 from(random.next(-halfSize, halfSize), 30, random.next(-halfSize, halfSize));
+        const Vector3 to(random.next(-halfSize, halfSize), -5, random.next(-halfSize, halfSize));
+        rays.emplace_back(from, to);
+    }
+
+    // Update the broad-phase once before the measure
+    scene.step(1);
+}
+
+// Report the counters of a raycast storm benchmark
+void setRaycastStormCounters(benchmark::State& state, BenchmarkScene& scene, uint64_t nbAllocationsBefore, uint64_t nbHits) {
+
+    const double nbAllocations = double(scene.getAllocator().getNbAllocations() - nbAllocationsBefore);
+    state.SetItemsProcessed(int64_t(state.iterations()) * state.range(0));
+    state.counters["allocs/storm"] = benchmark::Counter(nbAllocations, benchmark::Counter::kAvgIterations);
+    state.counters["hits/storm"] = benchmark::Counter(double(nbHits), benchmark::Counter::kAvgIterations);
+}
+
+}
+
+// Storm of rays cast from the sky over a field of static boxes and spheres
+static void BM_RaycastStorm(benchmark::State& state) {
+
+    BenchmarkScene scene;
+    std::vector<Ray> rays;
+    createRaycastStorm(scene, int(state.range(0)), rays);
+
+    const uint64_t nbAllocationsBefore = scene.getAllocator().getNbAllocations();
+    uint64_t nbHits = 0;
+    for (auto _ : state) {
+        for (const Ray& ray : rays) {
+            ClosestHitCallback callback;
+            scene.getWorld().raycast(ray, &callback);
+            nbHits += callback.hasHit ? 1 : 0;
+        }
+    }
+
+    setRaycastStormCounters(state, scene, nbAllocationsBefore, nbHits);
+}
+BENCHMARK(BM_RaycastStorm)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Same storm of rays with the any-hit query (visibility test)
+static void BM_RaycastStormAny(benchmark::State& state) {
+
+    BenchmarkScene scene;
+    std::vector<Ray> rays;
+    createRaycastStorm(scene, int(state.range(0)), rays);
+
+    const uint64_t nbAllocationsBefore = scene.getAllocator().getNbAllocations();
+    uint64_t nbHits = 0;
+    for (auto _ : state) {
+        for (const Ray& ray : rays) {
+            nbHits += scene.getWorld().raycastAny(ray) ? 1 : 0;
+        }
+    }
+
+    setRaycastStormCounters(state, scene, nbAllocationsBefore, nbHits);
+}
+BENCHMARK(BM_RaycastStormAny)->Arg(10000)->Unit(benchmark::kMicrosecond);
+
+// Same storm of rays with the closest-hit query (no callback)
+static void BM_RaycastStormClosest(benchmark::State& state) {
+
+    BenchmarkScene scene;
+    std::vector<Ray> rays;
+    createRaycastStorm(scene, int(state.range(0)), rays);
+
+    const uint64_t nbAllocationsBefore = scene.getAllocator().getNbAllocations();
+    uint64_t nbHits = 0;
+    for (auto _ : state) {
+        for (const Ray& ray : rays) {
+            RaycastInfo raycastInfo;
+            nbHits += scene.getWorld().raycastClosest(ray, raycastInfo) ? 1 : 0;
+        }
+    }
+
+    setRaycastStormCounters(state, scene, nbAllocationsBefore, nbHits);
+}
+BENCHMARK(BM_RaycastStormClosest)->Arg(10000)->Unit(benchmark::kMicrosecond);
@@ -0,0 +1,193 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "BenchmarkScenes.h"
+#include <benchmark/benchmark.h>
+
+using namespace reactphysics3d;
+
+namespace {
+
+// Number of steps taken before the measure of a scene
+constexpr uint32 NB_SETTLING_STEPS = 60;
+
+// Signature of the builders of the scenes
+using SceneBuilder = bool (*)(BenchmarkScene& scene, int parameter);
+
+// Build a scene, let it settle and measure its steps. The allocations, contact points,
+// narrow-phase tests and broad-phase reinsertions per step are reported as counters.
+void runScene(benchmark::State& state, SceneBuilder builder,
+              const PhysicsWorld::WorldSettings& worldSettings = PhysicsWorld::WorldSettings()) {
+
+    BenchmarkScene scene(worldSettings);
+    if (!builder(scene, int(state.range(0)))) {
+        state.SkipWithError("Cannot create the scene");
+        return;
+    }
+    scene.step(NB_SETTLING_STEPS);
+
+    PhysicsWorld& world = scene.getWorld();
+    const uint64_t nbAllocationsBefore = scene.getAllocator().getNbAllocations();
+    uint64_t nbContactPoints = 0;
+    uint64_t nbNarrowPhaseTests = 0;
+    uint64_t nbReinsertions = 0;
+
+    for (auto _ : state) {
+        world.update(BENCHMARK_TIME_STEP);
+
+        const StepStats& stats = world.getLastStepStats();
+        nbContactPoints += stats.nbContactPoints;
+        nbNarrowPhaseTests += stats.nbNarrowPhaseTests;
+        nbReinsertions += stats.nbBroadPhaseReinsertions;
+    }
+
+    const double nbAllocations = double(scene.getAllocator().getNbAllocations() - nbAllocationsBefore);
+    state.counters["allocs/step"] = benchmark::Counter(nbAllocations, benchmark::Counter::kAvgIterations);
+    state.counters["contacts/step"] = benchmark::Counter(double(nbContactPoints), benchmark::Counter::kAvgIterations);
+    state.counters["tests/step"] = benchmark::Counter(double(nbNarrowPhaseTests), benchmark::Counter::kAvgIterations);
+    state.counters["reinserts/step"] = benchmark::Counter(double(nbReinsertions), benchmark::Counter::kAvgIterations);
+    state.counters["bodies"] = double(world.getNbRigidBodies());
+}
+
+}
+
+static void BM_BoxPyramid(benchmark::State& state) {
+    runScene(state, createBoxPyramidScene);
+}
+BENCHMARK(BM_BoxPyramid)->Arg(20)->Arg(40);
+
+static void BM_BallPit(benchmark::State& state) {
+    runScene(state, createBallPitScene);
+}
+BENCHMARK(BM_BallPit)->Arg(5000);
+
+static void BM_RagdollChains(benchmark::State& state) {
+    runScene(state, createRagdollChainsScene);
+}
+BENCHMARK(BM_RagdollChains)->Arg(16);
+
+static void BM_ConvexHullsOnConcaveMesh(benchmark::State& state) {
+    runScene(state, createConvexHullsOnConcaveMeshScene);
+}
+BENCHMARK(BM_ConvexHullsOnConcaveMesh)->Arg(20);
+
+static void BM_HeightFieldTerrain(benchmark::State& state) {
+    runScene(state, createHeightFieldTerrainScene);
+}
+BENCHMARK(BM_HeightFieldTerrain)->Arg(10);
+
+static void BM_SpinningRobots(benchmark::State& state) {
+    runScene(state, createSpinningRobotsScene);
+}
+BENCHMARK(BM_SpinningRobots)->Arg(8);
+
+static void BM_SpinningCompoundRobots(benchmark::State& state) {
+    runScene(state, createCompoundSpinningRobotsScene);
+}
+BENCHMARK(BM_SpinningCompoundRobots)->Arg(8);
+
+// Same scene with the broad-phase trees refitted in place instead of reinserting the moved leaves
+static void BM_SpinningRobotsRefit(benchmark::State& state) {
+    PhysicsWorld::WorldSettings settings;
+    settings.broadPhaseTreeUpdateMethod = DynamicAABBTreeUpdateMethod::REFIT;
+    runScene(state, createSpinningRobotsScene, settings);
+}
+BENCHMARK(BM_SpinningRobotsRefit)->Arg(8);
+
+static void BM_BallSwarm(benchmark::State& state) {
+    runScene(state, createBallSwarmScene);
+}
+BENCHMARK(BM_BallSwarm)->Arg(5000);
+
+// Scenes with the fat AABBs extended along the predicted displacement of the bodies and with
+// margins adapted to the movement of each body. The fast balls of the swarm are reinserted almost
+// ten times less often and the step is more than three times faster. The piles of slow bodies
+// (BallPit, SpinningRobots) have a few more overlapping pairs and are about as fast as before.
+static void BM_BallSwarmPredictive(benchmark::State& state) {
+    PhysicsWorld::WorldSettings settings;
+    settings.isPredictiveFatAABBEnabled = true;
+    runScene(state, createBallSwarmScene, settings);
+}
+BENCHMARK(BM_BallSwarmPredictive)->Arg(5000);
+
+static void BM_BallPitPredictive(benchmark::State& state) {
+    PhysicsWorld::WorldSettings settings;
+    settings.isPredictiveFatAABBEnabled = true;
+    runScene(state, createBallPitScene, settings);
+}
+BENCHMARK(BM_BallPitPredictive)->Arg(5000);
+
+static void BM_SpinningRobotsPredictive(benchmark::State& state) {
+    PhysicsWorld::WorldSettings settings;
+    settings.isPredictiveFatAABBEnabled = true;
+    runScene(state, createSpinningRobotsScene, settings);
+}
+BENCHMARK(BM_SpinningRobotsPredictive)->Arg(8);
+
+// Scenes with the other broad-phase methods. The sweep-and-prune and the grid are much faster than
+// the tree with many colliders of the same size that keep moving out of their fat AABB (BallSwarm).
+// When most of the colliders stay in their fat AABB (BallPit, BoxPyramid, HeightFieldTerrain), the
+// narrow-phase dominates and the methods are close. The sweep-and-prune is then slightly slower if
+// many colliders overlap along its sorting axis (BallPit).
+template<BroadPhaseMethod method>
+static void BM_BroadPhaseBallPit(benchmark::State& state) {
+    PhysicsWorld::WorldSettings settings;
+    settings.broadPhaseMethod = method;
+    settings.broadPhaseGridCellSize = decimal(0.75);
+    runScene(state, createBallPitScene, settings);
+}
+BENCHMARK_TEMPLATE(BM_BroadPhaseBallPit, BroadPhaseMethod::SWEEP_AND_PRUNE)->Arg(5000);
+BENCHMARK_TEMPLATE(BM_BroadPhaseBallPit, BroadPhaseMethod::UNIFORM_GRID)->Arg(5000);
+
+template<BroadPhaseMethod method>
+static void BM_BroadPhaseBallSwarm(benchmark::State& state) {
+    PhysicsWorld::WorldSettings settings;
+    settings.broadPhaseMethod = method;
+    settings.broadPhaseGridCellSize = decimal(0.75);
+    runScene(state, createBallSwarmScene, settings);
+}
+BENCHMARK_TEMPLATE(BM_BroadPhaseBallSwarm, BroadPhaseMethod::SWEEP_AND_PRUNE)->Arg(5000);
+BENCHMARK_TEMPLATE(BM_BroadPhaseBallSwarm, BroadPhaseMethod::UNIFORM_GRID)->Arg(5000);
+
+template<BroadPhaseMethod method>
+static void BM_BroadPhaseBoxPyramid(benchmark::State& state) {
+    PhysicsWorld::WorldSettings settings;
+    settings.broadPhaseMethod = method;
+    settings.broadPhaseGridCellSize = decimal(1.5);
+    runScene(state, createBoxPyramidScene, settings);
+}
+BENCHMARK_TEMPLATE(BM_BroadPhaseBoxPyramid, BroadPhaseMethod::SWEEP_AND_PRUNE)->Arg(40);
+BENCHMARK_TEMPLATE(BM_BroadPhaseBoxPyramid, BroadPhaseMethod::UNIFORM_GRID)->Arg(40);
+
+template<BroadPhaseMethod method>
+static void BM_BroadPhaseHeightFieldTerrain(benchmark::State& state) {
+    PhysicsWorld::WorldSettings settings;
+    settings.broadPhaseMethod = method;
+    settings.broadPhaseGridCellSize = decimal(1.5);
+    runScene(state, createHeightFieldTerrainScene, settings);
+}
+BENCHMARK_TEMPLATE(BM_BroadPhaseHeightFieldTerrain, BroadPhaseMethod::SWEEP_AND_PRUNE)->Arg(10);
+BENCHMARK_TEMPLATE(BM_BroadPhaseHeightFieldTerrain, BroadPhaseMethod::UNIFORM_GRID)->Arg(10);
@@ -0,0 +1,67 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Offline decoder of the binary logs written by the AsyncLogger. It writes a text line per
+// message into the standard output or into a file.
+//
+// Usage: VendorLogDecoder <binary log file> [<text output file>]
+
+// Libraries
+#include <reactphysics3d/utils/BinaryLogDecoder.h>
+#include <fstream>
+#include <iostream>
+
+using namespace reactphysics3d;
+
+int main(int argc, char** argv) {
+
+    if (argc != 2 && argc != 3) {
+        std::cerr << "Usage: " << argv[0] << " <binary log file> [<text output file>]" << std::endl;
+        return 2;
+    }
+
+    std::ifstream input(argv[1], std::ios::binary);
+    if (!input.is_open()) {
+        std::cerr << "Cannot open the binary log " << argv[1] << std::endl;
+        return 2;
+    }
+
+    std::ofstream outputFile;
+    if (argc == 3) {
+        outputFile.open(argv[2]);
+        if (!outputFile.is_open()) {
+            std::cerr << "Cannot open the output file " << argv[2] << std::endl;
+            return 2;
+        }
+    }
+
+    std::vector<Message> messages;
+    const bool isValid = BinaryLogDecoder::decodeToText(input, argc == 3 ? outputFile : std::cout, messages);
+    for (const Message& message : messages) {
+        std::cerr << message.text << std::endl;
+    }
+
+    return isValid ? 0 : 1;
+}
@@ -87,7 +87,7 @@ Collider* Body::addCollider(CollisionShape* collisionShape, const Transform& tra
     const Transform localToWorldTransform = mWorld.mTransformComponents.getTransform(mEntity) * transform;
     Material material(mWorld.mConfig.defaultFrictionCoefficient, mWorld.mConfig.defaultBounciness);
     ColliderComponents::ColliderComponent colliderComponent(mEntity, collider, shapeAABB,
-                                                                  transform, collisionShape, 0x0001, 0xFFFF, localToWorldTransform, material);
+                                                                  transform, collisionShape, 0x0001, ALL_COLLISION_CATEGORIES, localToWorldTransform, material);
     bool isActive = mWorld.mBodyComponents.getIsActive(mEntity);
     mWorld.mCollidersComponents.addComponent(colliderEntity, !isActive, colliderComponent);
 
@@ -518,3 +518,79 @@ void Body::setIsDebugEnabled(bool enabled) {
 bool Body::isDebugEnabled() const {
     return mIsDebugEnabled;
 }
+
+// Set whether or not the contact and trigger events of this body are added to the contact event buffer
+/// An event is created in the ContactEventBuffer of the world for a pair of colliders if at least
+/// one of the two bodies has enabled its contact events. The pairs of bodies that have not enabled
+/// their contact events are never processed by the buffer.
+/**
+ * @param isEnabled True if the events of this body should be added to the contact event buffer
+ */
+void Body::setIsContactEventsEnabled(bool isEnabled) {
+    mWorld.mBodyComponents.setIsContactEventsEnabled(mEntity, isEnabled);
+}
+
+// Return true if the contact and trigger events of this body are added to the contact event buffer
+/**
+ * @return True if the events of this body are added to the contact event buffer
+ */
+bool Body::isContactEventsEnabled() const {
+    return mWorld.mBodyComponents.getIsContactEventsEnabled(mEntity);
+}
+
+// Set whether or not the colliders of this body are grouped under a single node of the broad-phase
+/// A compound body is represented by a single node in the broad-phase tree of the world and its
+/// colliders are stored in a small tree owned by the body. This is useful for bodies with many
+/// colliders (a robot with its chassis, bumpers and arm segments for instance) because the tree
+/// of the world is smaller and a collider that moves out of its fat AABB is only reinserted in the
+/// tree of its body. The colliders of the body are removed from the broad-phase and added again
+/// when this option is changed. Therefore, the overlapping pairs of the body are lost and this
+/// method should be called before the simulation starts.
+/**
+ * @param isCompoundBroadPhase True if the colliders of this body should be grouped in the broad-phase
+ */
+void Body::setIsCompoundBroadPhase(bool isCompoundBroadPhase) {
+
+    // If the state does not change
+    if (mWorld.mBodyComponents.getIsCompoundBroadPhase(mEntity) == isCompoundBroadPhase) return;
+
+    // Remove the colliders from the broad-phase
+    const Array<Entity>& colliderEntities = mWorld.mBodyComponents.getColliders(mEntity);
+    for (uint32 i=0; i < colliderEntities.size(); i++) {
+
+        Collider* collider = mWorld.mCollidersComponents.getCollider(colliderEntities[i]);
+        if (collider->getBroadPhaseId() != -1) {
+            mWorld.mCollisionDetection.removeCollider(collider);
+        }
+    }
+
+    mWorld.mBodyComponents.setIsCompoundBroadPhase(mEntity, isCompoundBroadPhase);
+
+    // Add the colliders again if the body is active
+    if (mWorld.mBodyComponents.getIsActive(mEntity)) {
+
+        const Transform& transform = mWorld.mTransformComponents.getTransform(mEntity);
+
+        for (uint32 i=0; i < colliderEntities.size(); i++) {
+
+            Collider* collider = mWorld.mCollidersComponents.getCollider(colliderEntities[i]);
+
+            // Compute the world-space AABB of the collision shape
+            const AABB aabb = collider->getCollisionShape()->computeTransformedAABB(transform * mWorld.mCollidersComponents.getLocalToBodyTransform(collider->getEntity()));
+
+            mWorld.mCollisionDetection.addCollider(collider, aabb);
+        }
+    }
+
+    RP3D_LOG(mWorld.mConfig.worldName, Logger::Level::Information, Logger::Category::Body,
+             "Body " + std::to_string(mEntity.id) + ": Set isCompoundBroadPhase=" +
+             (isCompoundBroadPhase ? "true" : "false"),  __FILE__, __LINE__);
+}
+
+// Return true if the colliders of this body are grouped under a single node of the broad-phase
+/**
+ * @return True if the colliders of this body are grouped in the broad-phase
+ */
+bool Body::isCompoundBroadPhase() const {
+    return mWorld.mBodyComponents.getIsCompoundBroadPhase(mEntity);
+}
@@ -679,7 +679,7 @@ Collider* RigidBody::addCollider(CollisionShape* collisionShape, const Transform
     const Transform localToWorldTransform = mWorld.mTransformComponents.getTransform(mEntity) * transform;
     Material material(mWorld.mConfig.defaultFrictionCoefficient, mWorld.mConfig.defaultBounciness);
     ColliderComponents::ColliderComponent colliderComponent(mEntity, collider, shapeAABB,
-                                                            transform, collisionShape, 0x0001, 0xFFFF, localToWorldTransform, material);
+                                                            transform, collisionShape, 0x0001, ALL_COLLISION_CATEGORIES, localToWorldTransform, material);
     bool isDisabled = mWorld.mRigidBodyComponents.getIsEntityDisabled(mEntity);
     mWorld.mCollidersComponents.addComponent(colliderEntity, isDisabled, colliderComponent);
 
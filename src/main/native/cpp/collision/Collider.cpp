@@ -67,7 +67,7 @@ bool Collider::testPointInside(const Vector3& worldPoint) {
 /**
  * @param collisionCategoryBits The collision category bits mask of the collider
  */
-void Collider::setCollisionCategoryBits(unsigned short collisionCategoryBits) {
+void Collider::setCollisionCategoryBits(uint64 collisionCategoryBits) {
 
     mBody->mWorld.mCollidersComponents.setCollisionCategoryBits(mEntity, collisionCategoryBits);
 
@@ -85,7 +85,7 @@ void Collider::setCollisionCategoryBits(unsigned short collisionCategoryBits) {
 /**
  * @param collideWithMaskBits The bits mask that specifies with which collision category this shape will collide
  */
-void Collider::setCollideWithMaskBits(unsigned short collideWithMaskBits) {
+void Collider::setCollideWithMaskBits(uint64 collideWithMaskBits) {
 
     mBody->mWorld.mCollidersComponents.setCollideWithMaskBits(mEntity, collideWithMaskBits);
 
@@ -171,6 +171,18 @@ const Transform& Collider::getLocalToBodyTransform() const {
  * @return True if the ray hits the collision shape
  */
 bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
+    return raycast(ray, raycastInfo, mMemoryManager.getPoolAllocator());
+}
+
+// Raycast method with feedback information (using a given allocator for temporary memory)
+/**
+ * @param ray Ray to use for the raycasting in world-space
+ * @param[out] raycastInfo Result of the raycasting that is valid only if the
+ *             methods returned true
+ * @param allocator Allocator used for the temporary memory of the raycast
+ * @return True if the ray hits the collision shape
+ */
+bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo, MemoryAllocator& allocator) {
 
     // If the corresponding body is not active, it cannot be hit by rays
     if (!mBody->isActive()) return false;
@@ -181,7 +193,7 @@ bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
     Ray rayLocal(worldToLocalTransform * ray.point1, worldToLocalTransform * ray.point2, ray.maxFraction);
 
     const CollisionShape* collisionShape = mBody->mWorld.mCollidersComponents.getCollisionShape(mEntity);
-    bool isHit = collisionShape->raycast(rayLocal, raycastInfo, this, mMemoryManager.getPoolAllocator());
+    bool isHit = collisionShape->raycast(rayLocal, raycastInfo, this, allocator);
 
     // Convert the raycast info into world-space
     raycastInfo.worldPoint = localToWorldTransform * raycastInfo.worldPoint;
@@ -191,11 +203,30 @@ bool Collider::raycast(const Ray& ray, RaycastInfo& raycastInfo) {
     return isHit;
 }
 
+// Return true if a ray hits the collider (without computing the hit point and normal)
+/**
+ * @param ray Ray to use for the raycasting in world-space
+ * @param allocator Allocator used for the temporary memory of the raycast
+ * @return True if the ray hits the collision shape
+ */
+bool Collider::testRayHit(const Ray& ray, MemoryAllocator& allocator) {
+
+    // If the corresponding body is not active, it cannot be hit by rays
+    if (!mBody->isActive()) return false;
+
+    // Convert the ray into the local-space of the collision shape
+    const Transform worldToLocalTransform = mBody->mWorld.mCollidersComponents.getLocalToWorldTransform(mEntity).getInverse();
+    Ray rayLocal(worldToLocalTransform * ray.point1, worldToLocalTransform * ray.point2, ray.maxFraction);
+
+    const CollisionShape* collisionShape = mBody->mWorld.mCollidersComponents.getCollisionShape(mEntity);
+    return collisionShape->testRayHit(rayLocal, this, allocator);
+}
+
 // Return the collision category bits
 /**
  * @return The collision category bits mask of the collider
  */
-unsigned short Collider::getCollisionCategoryBits() const {
+uint64 Collider::getCollisionCategoryBits() const {
     return mBody->mWorld.mCollidersComponents.getCollisionCategoryBits(mEntity);
 }
 
@@ -203,7 +234,7 @@ unsigned short Collider::getCollisionCategoryBits() const {
 /**
  * @return The bits mask that specifies with which collision category this shape will collide
  */
-unsigned short Collider::getCollideWithMaskBits() const {
+uint64 Collider::getCollideWithMaskBits() const {
     return mBody->mWorld.mCollidersComponents.getCollideWithMaskBits(mEntity);
 }
 
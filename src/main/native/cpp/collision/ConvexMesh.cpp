@@ -30,6 +30,7 @@
 #include <reactphysics3d/utils/DefaultLogger.h>
 #include <reactphysics3d/engine/PhysicsCommon.h>
 #include <reactphysics3d/utils/Message.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
 #include <cstdlib>
 #include <vector>
 
@@ -262,3 +263,70 @@ void ConvexMesh::computeVolume() {
 
     mVolume = std::abs(sum) / decimal(3.0);
 }
+
+// Write the cooked data of the mesh into a binary buffer
+/// The vertices, the half-edge structure, the faces normals, the centroid, the bounds
+/// and the volume are written so that nothing has to be recomputed when the mesh is loaded.
+/**
+ * @param writer The writer used to write the mesh
+ */
+void ConvexMesh::serialize(BinaryWriter& writer) const {
+
+    writer.write(static_cast<uint32>(mVertices.size()));
+    writer.writeVectors3(&mVertices[0], mVertices.size());
+
+    mHalfEdgeStructure.serialize(writer);
+
+    writer.writeVectors3(&mFacesNormals[0], mFacesNormals.size());
+    writer.writeVector3(mCentroid);
+    writer.writeVector3(mBounds.getMin());
+    writer.writeVector3(mBounds.getMax());
+    writer.write(mVolume);
+}
+
+// Initialize the mesh from cooked data and returns errors if any
+/**
+ * @param reader The reader used to read the mesh
+ * @param errors A reference to the array where the errors will be stored
+ * @return True if the mesh has been read and is valid
+ */
+bool ConvexMesh::initFromCookedData(BinaryReader& reader, std::vector<Message>& errors) {
+
+    const uint32 nbVertices = reader.read<uint32>();
+    if (nbVertices == 0 || !reader.hasRemaining(nbVertices, 3 * sizeof(float))) {
+        errors.push_back(Message("The cooked convex mesh data does not contain valid vertices"));
+        return false;
+    }
+
+    mVertices.reserve(nbVertices);
+    mVertices.addWithoutInit(nbVertices);
+    reader.readVectors3(&mVertices[0], nbVertices);
+
+    if (!mHalfEdgeStructure.deserialize(reader, nbVertices)) {
+        errors.push_back(Message("The cooked convex mesh data does not contain a valid half-edge structure"));
+        return false;
+    }
+
+    const uint32 nbFaces = mHalfEdgeStructure.getNbFaces();
+    if (!reader.hasRemaining(nbFaces, 3 * sizeof(float))) {
+        errors.push_back(Message("The cooked convex mesh data does not contain the faces normals"));
+        return false;
+    }
+    mFacesNormals.reserve(nbFaces);
+    mFacesNormals.addWithoutInit(nbFaces);
+    reader.readVectors3(&mFacesNormals[0], nbFaces);
+
+    mCentroid = reader.readVector3();
+    const Vector3 boundsMin = reader.readVector3();
+    const Vector3 boundsMax = reader.readVector3();
+    mBounds.setMin(boundsMin);
+    mBounds.setMax(boundsMax);
+    mVolume = reader.readDecimal();
+
+    if (reader.hasError()) {
+        errors.push_back(Message("The cooked convex mesh data is truncated"));
+        return false;
+    }
+
+    return true;
+}
@@ -28,6 +28,7 @@
 #include <reactphysics3d/containers/Map.h>
 #include <reactphysics3d/containers/Pair.h>
 #include <reactphysics3d/containers/containers_common.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
 
 using namespace reactphysics3d;
 
@@ -129,6 +130,98 @@ void HalfEdgeStructure::reserve(uint32 facesCapacity, uint32 verticesCapacity, u
 
 }
 
+// Write the vertices, faces and half-edges into a binary buffer
+/**
+ * @param writer The writer used to write the structure
+ */
+void HalfEdgeStructure::serialize(BinaryWriter& writer) const {
+
+    static_assert(sizeof(Vertex) == 2 * sizeof(uint32), "A vertex must only contain two indices");
+    static_assert(sizeof(Edge) == 4 * sizeof(uint32), "An edge must only contain four indices");
+
+    writer.write(static_cast<uint32>(mVertices.size()));
+    writer.write(static_cast<uint32>(mEdges.size()));
+    writer.write(static_cast<uint32>(mFaces.size()));
+
+    if (mVertices.size() > 0) {
+        writer.writeArray(reinterpret_cast<const uint32*>(&mVertices[0]), mVertices.size() * 2);
+    }
+    if (mEdges.size() > 0) {
+        writer.writeArray(reinterpret_cast<const uint32*>(&mEdges[0]), mEdges.size() * 4);
+    }
+
+    for (uint32 f=0; f < mFaces.size(); f++) {
+        writer.write(mFaces[f].edgeIndex);
+        writer.write(static_cast<uint32>(mFaces[f].faceVertices.size()));
+        for (uint32 v=0; v < mFaces[f].faceVertices.size(); v++) {
+            writer.write(mFaces[f].faceVertices[v]);
+        }
+    }
+}
+
+// Replace the vertices, faces and half-edges by the ones read from a binary buffer
+/// The half-edges are not recomputed. The indices are only checked to be in range.
+/**
+ * @param reader The reader used to read the structure
+ * @param nbVertexPoints Number of vertex points in the mesh using this structure
+ * @return True if the structure has been read and all its indices are valid
+ */
+bool HalfEdgeStructure::deserialize(BinaryReader& reader, uint32 nbVertexPoints) {
+
+    const uint32 nbVertices = reader.read<uint32>();
+    const uint32 nbEdges = reader.read<uint32>();
+    const uint32 nbFaces = reader.read<uint32>();
+
+    if (reader.hasError() || !reader.hasRemaining(nbVertices, 2 * sizeof(uint32)) ||
+        !reader.hasRemaining(nbEdges, 4 * sizeof(uint32)) || !reader.hasRemaining(nbFaces, 2 * sizeof(uint32))) {
+        return false;
+    }
+
+    mVertices.clear();
+    mEdges.clear();
+    mFaces.clear();
+    reserve(nbFaces, nbVertices, nbEdges);
+
+    mVertices.addWithoutInit(nbVertices);
+    mEdges.addWithoutInit(nbEdges);
+    bool isValid = nbVertices > 0 && nbEdges > 0 && nbFaces > 0;
+    isValid = isValid && reader.readArray(reinterpret_cast<uint32*>(&mVertices[0]), nbVertices * 2);
+    isValid = isValid && reader.readArray(reinterpret_cast<uint32*>(&mEdges[0]), nbEdges * 4);
+
+    for (uint32 f=0; isValid && f < nbFaces; f++) {
+
+        const uint32 edgeIndex = reader.read<uint32>();
+        const uint32 nbFaceVertices = reader.read<uint32>();
+        if (nbFaceVertices < 3 || !reader.hasRemaining(nbFaceVertices, sizeof(uint32))) {
+            return false;
+        }
+
+        mFaces.emplace(mAllocator);
+        Face& face = mFaces[f];
+        face.edgeIndex = edgeIndex;
+        face.faceVertices.reserve(nbFaceVertices);
+        face.faceVertices.addWithoutInit(nbFaceVertices);
+        isValid &= reader.readArray(&face.faceVertices[0], nbFaceVertices);
+
+        isValid &= edgeIndex < nbEdges;
+        for (uint32 v=0; v < nbFaceVertices; v++) {
+            isValid &= face.faceVertices[v] < nbVertices;
+        }
+    }
+
+    for (uint32 v=0; isValid && v < nbVertices; v++) {
+        isValid &= mVertices[v].vertexPointIndex < nbVertexPoints && mVertices[v].edgeIndex < nbEdges;
+    }
+
+    for (uint32 e=0; isValid && e < nbEdges; e++) {
+        const Edge& edge = mEdges[e];
+        isValid &= edge.vertexIndex < nbVertices && edge.twinEdgeIndex < nbEdges && edge.faceIndex < nbFaces &&
+                   edge.nextEdgeIndex < nbEdges;
+    }
+
+    return isValid && !reader.hasError();
+}
+
 // Return a string representation of the half-edge structure
 std::string HalfEdgeStructure::to_string() const {
 
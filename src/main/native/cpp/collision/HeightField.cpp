@@ -30,21 +30,99 @@
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/utils/Message.h>
 #include <iostream>
+#include <fstream>
+#include <cstring>
+#include <algorithm>
 #include <vector>
 
 using namespace reactphysics3d;
 
+// Tiled height-field file format
+// The file starts with a TiledHeightFieldFileHeader followed by the quantized (16-bits) height values of each
+// tile. The tiles are stored row by row (tile index = tileZ * nbTilesX + tileX) and each tile contains
+// tileSize * tileSize height values also stored row by row (the values outside of the grid are set to zero).
+// The values are written with the endianness of the machine that has written the file. A file written with
+// the other endianness is detected with the endianness tag of the header and its values are byte-swapped.
+namespace {
+
+    /// Magic string at the beginning of a tiled height-field file
+    const char TILED_FILE_MAGIC[8] = {'R', 'P', '3', 'D', 'H', 'F', 'T', '\0'};
+
+    /// Version of the tiled height-field file format
+    const uint32 TILED_FILE_VERSION = 1;
+
+    /// Value used to detect a file written with a different endianness
+    const uint32 TILED_FILE_ENDIANNESS_TAG = 0x01020304;
+
+    /// Largest absolute value of a quantized height value
+    const int32 MAX_QUANTIZED_HEIGHT = 32767;
+
+    /// Header of a tiled height-field file
+    struct TiledHeightFieldFileHeader {
+        char magic[8];
+        uint32 version;
+        uint32 endiannessTag;
+        uint32 nbColumns;
+        uint32 nbRows;
+        uint32 tileSize;
+        uint32 dataType;
+        double integerHeightScale;
+        double quantizationScale;
+        double quantizationOffset;
+        double minHeight;
+        double maxHeight;
+    };
+
+    static_assert(sizeof(TiledHeightFieldFileHeader) == 72, "Unexpected size of the tiled height-field file header");
+
+    // Reverse the order of the bytes of a value
+    template<typename T>
+    T swapBytes(T value) {
+        uint8 bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        std::reverse(bytes, bytes + sizeof(T));
+        std::memcpy(&value, bytes, sizeof(T));
+        return value;
+    }
+
+    // Reverse the order of the bytes of all the values of a header written with the other endianness
+    void swapHeaderBytes(TiledHeightFieldFileHeader& header) {
+        header.version = swapBytes(header.version);
+        header.endiannessTag = swapBytes(header.endiannessTag);
+        header.nbColumns = swapBytes(header.nbColumns);
+        header.nbRows = swapBytes(header.nbRows);
+        header.tileSize = swapBytes(header.tileSize);
+        header.dataType = swapBytes(header.dataType);
+        header.integerHeightScale = swapBytes(header.integerHeightScale);
+        header.quantizationScale = swapBytes(header.quantizationScale);
+        header.quantizationOffset = swapBytes(header.quantizationOffset);
+        header.minHeight = swapBytes(header.minHeight);
+        header.maxHeight = swapBytes(header.maxHeight);
+    }
+
+    // Quantize a height value into a 16-bits integer
+    int16 quantizeHeight(decimal height, decimal scale, decimal offset) {
+        const decimal quantized = std::round((height - offset) / scale);
+        return static_cast<int16>(clamp(quantized, decimal(-MAX_QUANTIZED_HEIGHT), decimal(MAX_QUANTIZED_HEIGHT)));
+    }
+}
+
 // Constructor
 HeightField::HeightField(MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure)
-            : mAllocator(allocator), mHeightFieldData(allocator),
+            : mAllocator(allocator), mHeightStorageType(HeightStorageType::COPY), mHeightFieldData(allocator),
+              mReferencedHeightData(nullptr), mQuantizedHeightData(allocator), mQuantizationScale(1),
+              mQuantizationOffset(0), mFileTilesData(nullptr), mIsFileByteSwapped(false), mTileSize(0), mNbTilesX(0), mNbTilesZ(0),
+              mNbMaxCachedTiles(0), mTileCacheHeights(allocator), mTileToCacheSlot(allocator),
+              mCacheSlotToTile(allocator), mCacheSlotLastUse(allocator), mTileUseCounter(0), mNbTileLoads(0),
               mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
 
 }
 
-// Initialize the height-field
+// Initialize the height-field
 bool HeightField::init(int nbGridColumns, int nbGridRows,
                        const void* heightFieldData, HeightDataType dataType,
-                       std::vector<Message>& messages, decimal integerHeightScale) {
+                       std::vector<Message>& messages, decimal integerHeightScale,
+                       HeightStorageType storageType) {
 
     bool isValid = true;
 
@@ -55,8 +133,12 @@ bool HeightField::init(int nbGridColumns, int nbGridRows,
         return false;
     }
 
-    mHeightFieldData.reserve(nbGridColumns * nbGridRows);
-    mHeightFieldData.addWithoutInit(nbGridColumns * nbGridRows);
+    if (storageType == HeightStorageType::TILED_FILE) {
+
+        messages.push_back(Message("A height field with the TILED_FILE storage must be created from a tiled height-field file",
+                                   Message::Type::Error));
+        return false;
+    }
 
     mNbColumns = nbGridColumns;
     mNbRows = nbGridRows;
@@ -64,12 +146,159 @@ bool HeightField::init(int nbGridColumns, int nbGridRows,
     mLength = static_cast<decimal>(nbGridRows - 1);
     mIntegerHeightScale = integerHeightScale;
     mHeightDataType = dataType;
+    mHeightStorageType = storageType;
+
+    switch (storageType) {
+
+        case HeightStorageType::COPY:
+
+            mHeightFieldData.reserve(nbGridColumns * nbGridRows);
+            mHeightFieldData.addWithoutInit(nbGridColumns * nbGridRows);
+
+            // Copy the height values from the user into the height-field
+            copyData(heightFieldData);
+
+            assert(mHeightFieldData.size() == mNbRows * mNbColumns);
+            break;
+
+        case HeightStorageType::REFERENCE:
+
+            // Keep a pointer to the user data (the height values are not copied)
+            mReferencedHeightData = heightFieldData;
+            computeMinMaxHeights(heightFieldData);
+            break;
+
+        case HeightStorageType::QUANTIZED:
+
+            mQuantizedHeightData.reserve(nbGridColumns * nbGridRows);
+            mQuantizedHeightData.addWithoutInit(nbGridColumns * nbGridRows);
 
-    // Copy the height values from the user into the height-field
-    copyData(heightFieldData);
+            // Quantize the height values from the user into the height-field
+            computeMinMaxHeights(heightFieldData);
+            computeQuantization(mMinHeight, mMaxHeight, mQuantizationScale, mQuantizationOffset);
+            quantizeData(heightFieldData);
+
+            assert(mQuantizedHeightData.size() == mNbRows * mNbColumns);
+            break;
+
+        default:
+            assert(false);  // This should never happen
+    }
+
+    computeBounds();
+
+    return isValid;
+}
+
+// Initialize the height-field from a tiled height-field file
+/// The file is memory-mapped and the tiles are only decoded the first time one of their height values
+/// is queried. The decoded tiles are kept in a cache whose size is limited by the memory budget.
+bool HeightField::initFromTiledFile(const std::string& filePath, std::vector<Message>& messages,
+                                    size_t tileCacheMemoryBudget) {
+
+    if (!mTiledFile.open(filePath)) {
+        messages.push_back(Message("Cannot open the tiled height-field file " + filePath, Message::Type::Error));
+        return false;
+    }
+
+    TiledHeightFieldFileHeader header;
+    if (mTiledFile.getSize() < sizeof(TiledHeightFieldFileHeader)) {
+        messages.push_back(Message("The file " + filePath + " is not a valid tiled height-field file", Message::Type::Error));
+        mTiledFile.close();
+        return false;
+    }
+    std::memcpy(&header, mTiledFile.getData(), sizeof(TiledHeightFieldFileHeader));
+
+    if (std::memcmp(header.magic, TILED_FILE_MAGIC, sizeof(TILED_FILE_MAGIC)) != 0) {
+        messages.push_back(Message("The file " + filePath + " is not a valid tiled height-field file", Message::Type::Error));
+        mTiledFile.close();
+        return false;
+    }
+
+    // If the file has been written with the other endianness, all its values must be byte-swapped
+    const bool isByteSwapped = header.endiannessTag == swapBytes(TILED_FILE_ENDIANNESS_TAG);
+    if (isByteSwapped) {
+        swapHeaderBytes(header);
+    }
+
+    if (header.endiannessTag != TILED_FILE_ENDIANNESS_TAG) {
+        messages.push_back(Message("The file " + filePath + " is not a valid tiled height-field file", Message::Type::Error));
+        mTiledFile.close();
+        return false;
+    }
+
+    if (header.version != TILED_FILE_VERSION) {
+        messages.push_back(Message("The version of the tiled height-field file " + filePath + " is not supported",
+                                   Message::Type::Error));
+        mTiledFile.close();
+        return false;
+    }
+
+    if (header.nbColumns < 2 || header.nbRows < 2 || header.tileSize == 0 ||
+        header.dataType > static_cast<uint32>(HeightDataType::HEIGHT_INT_TYPE)) {
+        messages.push_back(Message("The header of the tiled height-field file " + filePath + " is not valid",
+                                   Message::Type::Error));
+        mTiledFile.close();
+        return false;
+    }
+
+    const uint32 nbTilesX = (header.nbColumns + header.tileSize - 1) / header.tileSize;
+    const uint32 nbTilesZ = (header.nbRows + header.tileSize - 1) / header.tileSize;
+    const uint64 nbValuesPerTile = static_cast<uint64>(header.tileSize) * header.tileSize;
+    const uint64 expectedFileSize = sizeof(TiledHeightFieldFileHeader) +
+                                    static_cast<uint64>(nbTilesX) * nbTilesZ * nbValuesPerTile * sizeof(int16);
+    if (mTiledFile.getSize() < expectedFileSize) {
+        messages.push_back(Message("The tiled height-field file " + filePath + " is truncated", Message::Type::Error));
+        mTiledFile.close();
+        return false;
+    }
+
+    mNbColumns = header.nbColumns;
+    mNbRows = header.nbRows;
+    mWidth = static_cast<decimal>(mNbColumns - 1);
+    mLength = static_cast<decimal>(mNbRows - 1);
+    mIntegerHeightScale = static_cast<decimal>(header.integerHeightScale);
+    mHeightDataType = static_cast<HeightDataType>(header.dataType);
+    mHeightStorageType = HeightStorageType::TILED_FILE;
+    mQuantizationScale = static_cast<decimal>(header.quantizationScale);
+    mQuantizationOffset = static_cast<decimal>(header.quantizationOffset);
+    mMinHeight = static_cast<decimal>(header.minHeight);
+    mMaxHeight = static_cast<decimal>(header.maxHeight);
+
+    mFileTilesData = reinterpret_cast<const int16*>(mTiledFile.getData() + sizeof(TiledHeightFieldFileHeader));
+    mIsFileByteSwapped = isByteSwapped;
+    mTileSize = header.tileSize;
+    mNbTilesX = nbTilesX;
+    mNbTilesZ = nbTilesZ;
+
+    // Compute the maximum number of decoded tiles in the cache (a grid cell can overlap four tiles
+    // and therefore we always keep at least four tiles in the cache)
+    const uint32 nbTiles = nbTilesX * nbTilesZ;
+    const size_t tileMemorySize = static_cast<size_t>(nbValuesPerTile) * sizeof(decimal);
+    mNbMaxCachedTiles = static_cast<uint32>(std::min(tileCacheMemoryBudget / tileMemorySize, static_cast<size_t>(nbTiles)));
+    mNbMaxCachedTiles = std::max(mNbMaxCachedTiles, std::min(nbTiles, uint32(4)));
+
+    // No tile is decoded at the beginning
+    mTileToCacheSlot.reserve(nbTiles);
+    for (uint32 i=0; i < nbTiles; i++) {
+        mTileToCacheSlot.add(-1);
+    }
+    mCacheSlotToTile.reserve(mNbMaxCachedTiles);
+    mCacheSlotLastUse.reserve(mNbMaxCachedTiles);
+
+    computeBounds();
+
+    return true;
+}
+
+// Compute the bounds of the height field (once the min/max height values are known)
+void HeightField::computeBounds() {
 
     assert(mMinHeight <= mMaxHeight);
 
+    // Compute the height origin
+    mHeightOrigin = -(mMaxHeight - mMinHeight) * decimal(0.5) - mMinHeight;
+
     const decimal halfHeight = (mMaxHeight - mMinHeight) * decimal(0.5);
     assert(halfHeight >= 0);
 
@@ -79,35 +308,35 @@ bool HeightField::init(int nbGridColumns, int nbGridRows,
     // Compute the local AABB of the height field
     mBounds.setMin(Vector3(-mWidth * decimal(0.5), -halfHeight, -mLength * decimal(0.5)));
     mBounds.setMax(Vector3(mWidth * decimal(0.5), halfHeight, mLength * decimal(0.5)));
+}
 
-    assert(mHeightFieldData.size() == mNbRows * mNbColumns);
-
-    return isValid;
+// Read a height value in the data of the user
+decimal HeightField::readHeightValue(const void* heightFieldData, uint64 index, HeightDataType dataType,
+                                     decimal integerHeightScale) {
+
+    switch(dataType) {
+        case HeightDataType::HEIGHT_FLOAT_TYPE:
+            return decimal(static_cast<const float*>(heightFieldData)[index]);
+        case HeightDataType::HEIGHT_DOUBLE_TYPE:
+            return decimal(static_cast<const double*>(heightFieldData)[index]);
+        case HeightDataType::HEIGHT_INT_TYPE:
+            return decimal(static_cast<const int*>(heightFieldData)[index] * integerHeightScale);
+        default:
+            assert(false);  // This should never happen
+            return decimal(0.0);
+    }
 }
 
-// Copy the data from the user into the height-field array
+// Copy the data from the user into the height-field array
 void HeightField::copyData(const void* heightFieldData) {
 
-    // For each height value
+    // For each height value
     for (uint32 x=0; x < mNbColumns; x++) {
 
         for (uint32 y=0; y < mNbRows; y++) {
 
-            decimal height = 0.0;
-
-            switch(mHeightDataType) {
-                case HeightDataType::HEIGHT_FLOAT_TYPE:
-                    height = decimal(((float*)heightFieldData)[y * mNbColumns + x]);
-                    break;
-                case HeightDataType::HEIGHT_DOUBLE_TYPE:
-                    height = decimal(((double*)heightFieldData)[y * mNbColumns + x]);
-                    break;
-                case HeightDataType::HEIGHT_INT_TYPE:
-                    height = decimal(((int*)heightFieldData)[y * mNbColumns + x] * mIntegerHeightScale);
-                    break;
-                default:
-                    assert(false);  // This should never happen
-            }
+            const decimal height = readHeightValue(heightFieldData, y * mNbColumns + x, mHeightDataType,
+                                                   mIntegerHeightScale);
 
             mHeightFieldData[y * mNbColumns + x] = height;
 
@@ -116,7 +345,7 @@ void HeightField::copyData(const void* heightFieldData) {
                mMaxHeight = height;
             }
 
-            // Compute minimum height
+            // Compute minimum height
             if (height < mMinHeight) {
                 mMinHeight = height;
             }
@@ -127,9 +356,261 @@ void HeightField::copyData(const void* heightFieldData) {
             }
         }
     }
+}
 
-    // Compute the height origin
-    mHeightOrigin = -(mMaxHeight - mMinHeight) * decimal(0.5) - mMinHeight;
+// Compute the min/max height values of the height values given by the user
+void HeightField::computeMinMaxHeights(const void* heightFieldData) {
+
+    const uint64 nbValues = static_cast<uint64>(mNbColumns) * mNbRows;
+
+    mMinHeight = readHeightValue(heightFieldData, 0, mHeightDataType, mIntegerHeightScale);
+    mMaxHeight = mMinHeight;
+
+    for (uint64 i=1; i < nbValues; i++) {
+
+        const decimal height = readHeightValue(heightFieldData, i, mHeightDataType, mIntegerHeightScale);
+
+        mMinHeight = std::min(mMinHeight, height);
+        mMaxHeight = std::max(mMaxHeight, height);
+    }
+}
+
+// Compute the quantization scale and offset that maps the [min, max] range into 16-bits integers
+void HeightField::computeQuantization(decimal minHeight, decimal maxHeight, decimal& outScale, decimal& outOffset) {
+
+    assert(minHeight <= maxHeight);
+
+    outOffset = (minHeight + maxHeight) * decimal(0.5);
+    outScale = (maxHeight - minHeight) / decimal(2 * MAX_QUANTIZED_HEIGHT);
+
+    // If all the heights are the same
+    if (outScale <= decimal(0.0)) {
+        outScale = decimal(1.0);
+    }
+}
+
+// Quantize the data from the user into the 16-bits quantized height-field array
+/// Note that the min/max heights are updated to the min/max of the quantized heights so that
+/// the bounds of the height field contain all the quantized height values
+void HeightField::quantizeData(const void* heightFieldData) {
+
+    const uint64 nbValues = static_cast<uint64>(mNbColumns) * mNbRows;
+
+    int16 minQuantizedHeight = MAX_QUANTIZED_HEIGHT;
+    int16 maxQuantizedHeight = -MAX_QUANTIZED_HEIGHT;
+
+    for (uint64 i=0; i < nbValues; i++) {
+
+        const decimal height = readHeightValue(heightFieldData, i, mHeightDataType, mIntegerHeightScale);
+        const int16 quantizedHeight = quantizeHeight(height, mQuantizationScale, mQuantizationOffset);
+
+        mQuantizedHeightData[i] = quantizedHeight;
+
+        minQuantizedHeight = std::min(minQuantizedHeight, quantizedHeight);
+        maxQuantizedHeight = std::max(maxQuantizedHeight, quantizedHeight);
+    }
+
+    mMinHeight = minQuantizedHeight * mQuantizationScale + mQuantizationOffset;
+    mMaxHeight = maxQuantizedHeight * mQuantizationScale + mQuantizationOffset;
+}
+
+// Return the height value at a given (x,y) point for the storages other than COPY
+decimal HeightField::getStoredHeightAt(uint32 x, uint32 y) const {
+
+    switch (mHeightStorageType) {
+
+        case HeightStorageType::REFERENCE:
+            return readHeightValue(mReferencedHeightData, y * mNbColumns + x, mHeightDataType, mIntegerHeightScale);
+
+        case HeightStorageType::QUANTIZED:
+            return mQuantizedHeightData[y * mNbColumns + x] * mQuantizationScale + mQuantizationOffset;
+
+        case HeightStorageType::TILED_FILE:
+        {
+            const uint32 tileX = x / mTileSize;
+            const uint32 tileZ = y / mTileSize;
+            const uint64 nbValuesPerTile = static_cast<uint64>(mTileSize) * mTileSize;
+            const uint32 localX = x - tileX * mTileSize;
+            const uint32 localZ = y - tileZ * mTileSize;
+
+            // The slot must be read before another thread can evict it or grow the cache
+            std::lock_guard<std::mutex> lock(mTileCacheMutex);
+            const uint32 slot = getCachedTileSlot(tileZ * mNbTilesX + tileX);
+
+            return mTileCacheHeights[slot * nbValuesPerTile + localZ * mTileSize + localX];
+        }
+
+        default:
+            return mHeightFieldData[y * mNbColumns + x];
+    }
+}
+
+// Return the index of the cache slot with the decoded heights of a given tile (decode it if necessary)
+/// If the cache is full, the least recently used tile is evicted from the cache. The tile cache
+/// mutex must be locked by the caller.
+uint32 HeightField::getCachedTileSlot(uint32 tileIndex) const {
+
+    assert(tileIndex < mNbTilesX * mNbTilesZ);
+
+    mTileUseCounter++;
+
+    // If the tile is already decoded
+    const int32 cachedSlot = mTileToCacheSlot[tileIndex];
+    if (cachedSlot >= 0) {
+        mCacheSlotLastUse[cachedSlot] = mTileUseCounter;
+        return static_cast<uint32>(cachedSlot);
+    }
+
+    const uint64 nbValuesPerTile = static_cast<uint64>(mTileSize) * mTileSize;
+    uint32 slot;
+
+    // If the cache is not full yet
+    if (mCacheSlotToTile.size() < mNbMaxCachedTiles) {
+
+        slot = static_cast<uint32>(mCacheSlotToTile.size());
+        mCacheSlotToTile.add(tileIndex);
+        mCacheSlotLastUse.add(mTileUseCounter);
+        mTileCacheHeights.addWithoutInit(nbValuesPerTile);
+    }
+    else {
+
+        // Evict the least recently used tile
+        slot = 0;
+        for (uint32 i=1; i < mCacheSlotLastUse.size(); i++) {
+            if (mCacheSlotLastUse[i] < mCacheSlotLastUse[slot]) {
+                slot = i;
+            }
+        }
+
+        mTileToCacheSlot[mCacheSlotToTile[slot]] = -1;
+        mCacheSlotToTile[slot] = tileIndex;
+        mCacheSlotLastUse[slot] = mTileUseCounter;
+    }
+
+    mTileToCacheSlot[tileIndex] = static_cast<int32>(slot);
+
+    // Decode the tile from the memory-mapped file
+    const int16* quantizedHeights = mFileTilesData + tileIndex * nbValuesPerTile;
+    decimal* heights = &(mTileCacheHeights[slot * nbValuesPerTile]);
+    if (mIsFileByteSwapped) {
+        for (uint64 i=0; i < nbValuesPerTile; i++) {
+            heights[i] = swapBytes(quantizedHeights[i]) * mQuantizationScale + mQuantizationOffset;
+        }
+    }
+    else {
+        for (uint64 i=0; i < nbValuesPerTile; i++) {
+            heights[i] = quantizedHeights[i] * mQuantizationScale + mQuantizationOffset;
+        }
+    }
+
+    mNbTileLoads++;
+
+    return slot;
+}
+
+// Write height values into a tiled height-field file
+/**
+ * The file can then be used to create a height field with the TILED_FILE storage using
+ * PhysicsCommon::createHeightField(). The height values are quantized into 16-bits integers.
+ * @param filePath Path of the file to write
+ * @param nbGridColumns Number of columns in the grid of the height field (along the local x axis)
+ * @param nbGridRows Number of rows in the grid of the height field (along the local z axis)
+ * @param heightFieldData Pointer to the first height value data
+ * @param dataType Data type for the height values (int, float, double)
+ * @param[out] messages A reference to the array where the messages (warnings, errors, ...) will be stored
+ * @param integerHeightScale Scaling factor for the height values of the height field
+ * @param tileSize Number of grid points along each side of a tile
+ * @return True if the file has been successfully written
+ */
+bool HeightField::writeTiledFile(const std::string& filePath, int nbGridColumns, int nbGridRows,
+                                 const void* heightFieldData, HeightDataType dataType,
+                                 std::vector<Message>& messages, decimal integerHeightScale, uint32 tileSize) {
+
+    if (nbGridColumns < 2 || nbGridRows < 2) {
+        messages.push_back(Message("The number of grid columns and grid rows must be at least two", Message::Type::Error));
+        return false;
+    }
+
+    if (tileSize == 0) {
+        messages.push_back(Message("The tile size of a tiled height-field file must be at least one", Message::Type::Error));
+        return false;
+    }
+
+    std::ofstream file(filePath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        messages.push_back(Message("Cannot create the tiled height-field file " + filePath, Message::Type::Error));
+        return false;
+    }
+
+    const uint32 nbColumns = static_cast<uint32>(nbGridColumns);
+    const uint32 nbRows = static_cast<uint32>(nbGridRows);
+    const uint64 nbValues = static_cast<uint64>(nbColumns) * nbRows;
+
+    // Compute the min/max height values
+    decimal minHeight = readHeightValue(heightFieldData, 0, dataType, integerHeightScale);
+    decimal maxHeight = minHeight;
+    for (uint64 i=1; i < nbValues; i++) {
+        const decimal height = readHeightValue(heightFieldData, i, dataType, integerHeightScale);
+        minHeight = std::min(minHeight, height);
+        maxHeight = std::max(maxHeight, height);
+    }
+
+    decimal quantizationScale, quantizationOffset;
+    computeQuantization(minHeight, maxHeight, quantizationScale, quantizationOffset);
+
+    // Use the min/max of the quantized heights so that the bounds contain all the quantized height values
+    const int16 minQuantizedHeight = quantizeHeight(minHeight, quantizationScale, quantizationOffset);
+    const int16 maxQuantizedHeight = quantizeHeight(maxHeight, quantizationScale, quantizationOffset);
+
+    TiledHeightFieldFileHeader header;
+    std::memset(&header, 0, sizeof(TiledHeightFieldFileHeader));
+    std::memcpy(header.magic, TILED_FILE_MAGIC, sizeof(TILED_FILE_MAGIC));
+    header.version = TILED_FILE_VERSION;
+    header.endiannessTag = TILED_FILE_ENDIANNESS_TAG;
+    header.nbColumns = nbColumns;
+    header.nbRows = nbRows;
+    header.tileSize = tileSize;
+    header.dataType = static_cast<uint32>(dataType);
+    header.integerHeightScale = static_cast<double>(integerHeightScale);
+    header.quantizationScale = static_cast<double>(quantizationScale);
+    header.quantizationOffset = static_cast<double>(quantizationOffset);
+    header.minHeight = static_cast<double>(minQuantizedHeight * quantizationScale + quantizationOffset);
+    header.maxHeight = static_cast<double>(maxQuantizedHeight * quantizationScale + quantizationOffset);
+    file.write(reinterpret_cast<const char*>(&header), sizeof(TiledHeightFieldFileHeader));
+
+    const uint32 nbTilesX = (nbColumns + tileSize - 1) / tileSize;
+    const uint32 nbTilesZ = (nbRows + tileSize - 1) / tileSize;
+
+    // For each tile
+    for (uint32 tileZ=0; tileZ < nbTilesZ; tileZ++) {
+        for (uint32 tileX=0; tileX < nbTilesX; tileX++) {
+
+            // For each height value of the tile
+            for (uint32 localZ=0; localZ < tileSize; localZ++) {
+                for (uint32 localX=0; localX < tileSize; localX++) {
+
+                    const uint32 x = tileX * tileSize + localX;
+                    const uint32 y = tileZ * tileSize + localZ;
+
+                    int16 quantizedHeight = 0;
+                    if (x < nbColumns && y < nbRows) {
+                        const decimal height = readHeightValue(heightFieldData, static_cast<uint64>(y) * nbColumns + x,
+                                                               dataType, integerHeightScale);
+                        quantizedHeight = quantizeHeight(height, quantizationScale, quantizationOffset);
+                    }
+
+                    file.write(reinterpret_cast<const char*>(&quantizedHeight), sizeof(int16));
+                }
+            }
+        }
+    }
+
+    if (!file.good()) {
+        messages.push_back(Message("Error while writing the tiled height-field file " + filePath, Message::Type::Error));
+        return false;
+    }
+
+    return true;
 }
 
 // Test collision with the triangles of the height field shape. The idea is to use the AABB
@@ -422,6 +903,7 @@ std::string HeightField::to_string() const {
     ss << ", minHeight=" << mMinHeight << std::endl;
     ss << ", maxHeight=" << mMaxHeight << std::endl;
     ss << ", integerHeightScale=" << mIntegerHeightScale << std::endl;
+    ss << ", storageType=" << static_cast<int>(mHeightStorageType) << std::endl;
     ss << "}";
 
     return ss.str();
@@ -28,21 +28,71 @@
 #include <vector>
 #include <reactphysics3d/utils/Message.h>
 #include <reactphysics3d/collision/TriangleVertexArray.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
+#include <reactphysics3d/containers/Map.h>
+#include <cmath>
+#include <limits>
 
 using namespace reactphysics3d;
 
+namespace {
+
+    /// Index of a user vertex that is not used by any valid triangle in the vertices remap table
+    const uint32 INVALID_VERTEX_INDEX = std::numeric_limits<uint32>::max();
+
+    /// Return the key of a cell of the spatial hash used to weld the vertices
+    uint64 computeWeldingCellKey(int64 x, int64 y, int64 z) {
+        return (static_cast<uint64>(x) * 73856093u) ^ (static_cast<uint64>(y) * 19349663u) ^
+               (static_cast<uint64>(z) * 83492791u);
+    }
+}
+
 // Constructor
 TriangleMesh::TriangleMesh(MemoryAllocator& allocator)
              : mAllocator(allocator), mVertices(allocator), mTriangles(allocator),
-               mVerticesNormals(allocator), mDynamicAABBTree(allocator), mEpsilon(0) {
+               mVerticesNormals(allocator), mDynamicAABBTree(allocator), mEpsilon(0),
+               mStorageType(StorageType::COPY), mNbReferencedVertices(0), mNbReferencedTriangles(0),
+               mReferencedVerticesStart(nullptr), mReferencedVerticesStride(0),
+               mReferencedVertexDataType(TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE),
+               mReferencedNormalsStart(nullptr), mReferencedNormalsStride(0),
+               mReferencedNormalDataType(TriangleVertexArray::NormalDataType::NORMAL_FLOAT_TYPE),
+               mReferencedIndicesStart(nullptr), mReferencedIndicesStride(0),
+               mReferencedIndexDataType(TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE) {
 
 }
 
 // Initialize the mesh using a TriangleVertexArray
-bool TriangleMesh::init(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages) {
+bool TriangleMesh::init(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages,
+                        StorageType storageType) {
 
     bool isValid = true;
 
+    mStorageType = storageType;
+
+    // If the mesh directly uses the user buffers
+    if (storageType == StorageType::REFERENCE) {
+
+        computeEpsilon(triangleVertexArray);
+
+        // Reference and validate the triangles of the user
+        Array<bool> areTrianglesDiscarded(mAllocator, triangleVertexArray.getNbTriangles());
+        isValid &= referenceData(triangleVertexArray, areTrianglesDiscarded, messages);
+
+        // If the normals are not provided by the user
+        if (!triangleVertexArray.getHasNormals() && isValid) {
+
+            // Compute the normals
+            computeVerticesNormals(areTrianglesDiscarded);
+        }
+
+        // Insert all the valid triangles into the dynamic AABB tree
+        if (isValid) {
+            initBVHTree(areTrianglesDiscarded);
+        }
+
+        return isValid;
+    }
+
     // Reserve memory for the vertices, faces and edges
     mVertices.reserve(triangleVertexArray.getNbVertices());
     mTriangles.reserve(triangleVertexArray.getNbTriangles() * 3);
@@ -57,11 +107,11 @@ bool TriangleMesh::init(const TriangleVertexArray& triangleVertexArray, std::vec
     if (!triangleVertexArray.getHasNormals() && isValid) {
 
         // Compute the normals
-        computeVerticesNormals();
+        computeVerticesNormals(Array<bool>(mAllocator));
     }
 
     // Insert all the triangles into the dynamic AABB tree
-    initBVHTree();
+    initBVHTree(Array<bool>(mAllocator));
 
     return isValid;
 }
@@ -96,19 +146,19 @@ bool TriangleMesh::copyData(const TriangleVertexArray& triangleVertexArray, std:
 
     const decimal epsilonSquare = mEpsilon * mEpsilon;
 
-    Array<bool> areUserVerticesUsed(mAllocator);
+    Array<bool> areUserVerticesUsed(mAllocator, triangleVertexArray.getNbVertices());
     for (uint32 i=0 ; i < triangleVertexArray.getNbVertices(); i++) {
        areUserVerticesUsed.add(false);
-       mVertices.add(Vector3::zero());
-       mVerticesNormals.add(Vector3::zero());
     }
 
+    // Index in the user array of each triangle added to the mesh
+    Array<uint32> userTrianglesIndices(mAllocator, triangleVertexArray.getNbTriangles());
+
     // For each face
     for (uint32 i=0 ; i < triangleVertexArray.getNbTriangles(); i++) {
 
         bool isValidFace = true;
         uint32 vertexIndices[3];
-        Vector3 vertexNormal[3] = {Vector3::zero(), Vector3::zero(), Vector3::zero()};
 
         // Get the vertex indices from the user
         triangleVertexArray.getTriangleVerticesIndices(i, vertexIndices[0], vertexIndices[1], vertexIndices[2]);
@@ -130,45 +180,21 @@ bool TriangleMesh::copyData(const TriangleVertexArray& triangleVertexArray, std:
 
         if (isValidFace) {
 
-            // Check if the triangle area is not almost zero
+            // Check if the triangle area and edges lengths are not almost zero
             const Vector3 v1 = triangleVertexArray.getVertex(vertexIndices[0]);
             const Vector3 v2 = triangleVertexArray.getVertex(vertexIndices[1]);
             const Vector3 v3 = triangleVertexArray.getVertex(vertexIndices[2]);
-            const Vector3 faceNormal = (v3 - v1).cross(v2 - v1);
-            const bool isFaceZeroArea = faceNormal.lengthSquare() < epsilonSquare;
-            if (isFaceZeroArea) {
-
-                // Add a warning message for the user
-                messages.push_back(Message("The face with index " + std::to_string(i) + " has almost zero area. This triangle will not be part of the final collision shape.",
-                                           Message::Type::Warning));
-            }
-
-            // Check that edges lengths are not almost zero
-            decimal edgesLengthsSquare[3];
-            edgesLengthsSquare[0] = (v2 - v1).lengthSquare();
-            edgesLengthsSquare[1] = (v3 - v2).lengthSquare();
-            edgesLengthsSquare[2] = (v1 - v3).lengthSquare();
-            bool hasFaceZeroLengthEdge = edgesLengthsSquare[0] < epsilonSquare || edgesLengthsSquare[1] < epsilonSquare ||
-                                         edgesLengthsSquare[2] < epsilonSquare;
-            if (hasFaceZeroLengthEdge) {
-
-                // Add a warning message for the user
-                messages.push_back(Message("The face with index " + std::to_string(i) + " has an almost zero length edge. This triangle will not be part of the final collision shape.",
-                                           Message::Type::Warning));
-            }
 
             // If the face does not have a zero area
-            if (!isFaceZeroArea && !hasFaceZeroLengthEdge) {
+            if (checkTriangleArea(i, v1, v2, v3, messages)) {
 
                 // If the vertices normals are provided by the user
                 if (triangleVertexArray.getHasNormals()) {
 
                     for (int v=0; v < 3; v++) {
 
-                        vertexNormal[v] = triangleVertexArray.getVertexNormal(vertexIndices[v]);
-
                         // Check that the normal is not too small
-                        if (vertexNormal[v].lengthSquare() < epsilonSquare) {
+                        if (triangleVertexArray.getVertexNormal(vertexIndices[v]).lengthSquare() < epsilonSquare) {
 
                             messages.push_back(Message("The length of the provided normal for vertex with index " + std::to_string(vertexIndices[v]) + " is too small"))  ;
                             isValid = false;
@@ -176,29 +202,22 @@ bool TriangleMesh::copyData(const TriangleVertexArray& triangleVertexArray, std:
                     }
                 }
 
-                // Add the vertices to the mesh
-                mVerticesNormals[vertexIndices[0]] = vertexNormal[0];
-                mVertices[vertexIndices[0]] = v1;
-                mVerticesNormals[vertexIndices[1]] = vertexNormal[1];
-                mVertices[vertexIndices[1]] = v2;
-                mVerticesNormals[vertexIndices[2]] = vertexNormal[2];
-                mVertices[vertexIndices[2]] = v3;
-
-                // Add the triangle to the mesh
+                // Add the triangle to the mesh (with the user vertex indices that are remapped
+                // to the mesh vertex indices once the vertices have been welded)
                 mTriangles.add(vertexIndices[0]);
                 mTriangles.add(vertexIndices[1]);
                 mTriangles.add(vertexIndices[2]);
+                userTrianglesIndices.add(i);
 
                 areUserVerticesUsed[vertexIndices[0]] = true;
                 areUserVerticesUsed[vertexIndices[1]] = true;
                 areUserVerticesUsed[vertexIndices[2]] = true;
-
-                assert(mVertices.size() == mVerticesNormals.size());
             }
         }
     }
 
-    removeUnusedVertices(areUserVerticesUsed);
+    weldVertices(triangleVertexArray, areUserVerticesUsed);
+    removeWeldedDegenerateTriangles(userTrianglesIndices, messages);
 
     if (mTriangles.size() == 0) {
 
@@ -212,47 +231,320 @@ bool TriangleMesh::copyData(const TriangleVertexArray& triangleVertexArray, std:
     return isValid;
 }
 
-// Remove the ununsed vertices (because they are not used in any triangles or
-// are part of discarded triangles)
-void TriangleMesh::removeUnusedVertices(Array<bool>& areUsedVertices) {
+// Check that a triangle does not have an almost zero area or an almost zero length edge
+/// A warning message is added for the user if the triangle is not valid
+bool TriangleMesh::checkTriangleArea(uint32 triangleIndex, const Vector3& v1, const Vector3& v2, const Vector3& v3,
+                                     std::vector<Message>& messages) const {
+
+    const decimal epsilonSquare = mEpsilon * mEpsilon;
+
+    // Check if the triangle area is not almost zero
+    const Vector3 faceNormal = (v3 - v1).cross(v2 - v1);
+    const bool isFaceZeroArea = faceNormal.lengthSquare() < epsilonSquare;
+    if (isFaceZeroArea) {
+
+        // Add a warning message for the user
+        messages.push_back(Message("The face with index " + std::to_string(triangleIndex) + " has almost zero area. This triangle will not be part of the final collision shape.",
+                                   Message::Type::Warning));
+    }
+
+    // Check that edges lengths are not almost zero
+    decimal edgesLengthsSquare[3];
+    edgesLengthsSquare[0] = (v2 - v1).lengthSquare();
+    edgesLengthsSquare[1] = (v3 - v2).lengthSquare();
+    edgesLengthsSquare[2] = (v1 - v3).lengthSquare();
+    bool hasFaceZeroLengthEdge = edgesLengthsSquare[0] < epsilonSquare || edgesLengthsSquare[1] < epsilonSquare ||
+                                 edgesLengthsSquare[2] < epsilonSquare;
+    if (hasFaceZeroLengthEdge) {
+
+        // Add a warning message for the user
+        messages.push_back(Message("The face with index " + std::to_string(triangleIndex) + " has an almost zero length edge. This triangle will not be part of the final collision shape.",
+                                   Message::Type::Warning));
+    }
+
+    return !isFaceZeroArea && !hasFaceZeroLengthEdge;
+}
+
+// Reference the user buffers of the triangles and validate the triangles
+/// Nothing is copied. The triangles with invalid vertex indices make the mesh invalid and
+/// the triangles with an almost zero area are marked as discarded.
+bool TriangleMesh::referenceData(const TriangleVertexArray& triangleVertexArray, Array<bool>& areTrianglesDiscarded,
+                                 std::vector<Message>& messages) {
+
+    bool isValid = true;
+
+    assert(mEpsilon > 0);
+
+    const decimal epsilonSquare = mEpsilon * mEpsilon;
+
+    mNbReferencedVertices = triangleVertexArray.getNbVertices();
+    mNbReferencedTriangles = triangleVertexArray.getNbTriangles();
+    mReferencedVerticesStart = static_cast<const uchar*>(triangleVertexArray.getVerticesStart());
+    mReferencedVerticesStride = triangleVertexArray.getVerticesStride();
+    mReferencedVertexDataType = triangleVertexArray.getVertexDataType();
+    mReferencedIndicesStart = static_cast<const uchar*>(triangleVertexArray.getIndicesStart());
+    mReferencedIndicesStride = triangleVertexArray.getIndicesStride();
+    mReferencedIndexDataType = triangleVertexArray.getIndexDataType();
+
+    if (triangleVertexArray.getHasNormals()) {
+        mReferencedNormalsStart = static_cast<const uchar*>(triangleVertexArray.getVerticesNormalsStart());
+        mReferencedNormalsStride = triangleVertexArray.getVerticesNormalsStride();
+        mReferencedNormalDataType = triangleVertexArray.getVertexNormalDataType();
+    }
+
+    uint32 nbValidTriangles = 0;
+
+    // For each face
+    for (uint32 i=0 ; i < mNbReferencedTriangles; i++) {
+
+        bool isValidFace = true;
+        uint32 vertexIndices[3];
+        getReferencedTriangleVerticesIndices(i, vertexIndices[0], vertexIndices[1], vertexIndices[2]);
+
+        for (int v=0; v < 3; v++) {
+
+            if (vertexIndices[v] >= mNbReferencedVertices) {
+
+                // Add an error message for the user
+                messages.push_back(Message("The face with index " + std::to_string(i) +
+                                           " has a vertex with index " + std::to_string(vertexIndices[v]) +
+                                           " but the TriangleVertexArray only has " +
+                                           std::to_string(mNbReferencedVertices) + " vertices"));
+
+                isValid = false;
+                isValidFace = false;
+            }
+        }
+
+        if (isValidFace) {
+
+            const Vector3 v1 = getReferencedVertex(vertexIndices[0]);
+            const Vector3 v2 = getReferencedVertex(vertexIndices[1]);
+            const Vector3 v3 = getReferencedVertex(vertexIndices[2]);
+
+            isValidFace = checkTriangleArea(i, v1, v2, v3, messages);
+
+            // If the vertices normals are provided by the user
+            if (isValidFace && mReferencedNormalsStart != nullptr) {
+
+                for (int v=0; v < 3; v++) {
+
+                    // Check that the normal is not too small
+                    if (getReferencedVertexNormal(vertexIndices[v]).lengthSquare() < epsilonSquare) {
+
+                        messages.push_back(Message("The length of the provided normal for vertex with index " + std::to_string(vertexIndices[v]) + " is too small"));
+                        isValid = false;
+                    }
+                }
+            }
+        }
+
+        areTrianglesDiscarded.add(!isValidFace);
+
+        if (isValidFace) {
+            nbValidTriangles++;
+        }
+    }
+
+    if (nbValidTriangles == 0) {
+
+        messages.push_back(Message("The mesh does not have any valid triangle faces"));
+
+        isValid = false;
+    }
+
+    return isValid;
+}
+
+// Copy the used vertices into the mesh, weld the duplicated vertices and remap the triangles
+/// The unused vertices (not used in any triangle or only part of discarded triangles) are not
+/// copied. Each used vertex is looked up in a spatial hash of the vertices already copied into
+/// the mesh and is welded with a vertex closer than the mesh epsilon (that also has the same
+/// normal if the normals are provided by the user). The triangles indices are then remapped in
+/// a single pass so that the whole process is linear in the number of vertices and triangles.
+void TriangleMesh::weldVertices(const TriangleVertexArray& triangleVertexArray, const Array<bool>& areUserVerticesUsed) {
 
-    // For each vertex of the user mesh
-    for (uint32 i=mVertices.size() - 1; i > 0; i--) {
+    assert(mEpsilon > 0);
+
+    const uint32 nbUserVertices = triangleVertexArray.getNbVertices();
+    const bool hasNormals = triangleVertexArray.getHasNormals();
+    const decimal epsilonSquare = mEpsilon * mEpsilon;
 
-        // If the vertex is not used
-        if (!areUsedVertices[i]) {
+    // The cells are larger than the welding distance so that we only need to look
+    // into the neighbor cells for the vertices that are close to a cell boundary
+    const decimal cellSize = decimal(4.0) * mEpsilon;
 
-            mVertices.removeAt(i);
-            mVerticesNormals.removeAt(i);
+    // Mesh vertex index of each user vertex
+    Array<uint32> vertexRemap(mAllocator, nbUserVertices);
 
-            // For each triangle index of the mesh
-            for (uint32 t=0; t < mTriangles.size(); t++) {
+    // Spatial hash with the first mesh vertex of each cell and the next mesh vertex in the same cell
+    Map<uint64, uint32> firstVertexInCell(mAllocator, nbUserVertices);
+    Array<uint32> nextVertexInCell(mAllocator, nbUserVertices);
 
-                assert(mTriangles[t] != i);
+    // For each vertex of the user mesh
+    for (uint32 i=0; i < nbUserVertices; i++) {
 
-                if (mTriangles[t] > i) {
-                    mTriangles[t]--;
+        if (!areUserVerticesUsed[i]) {
+            vertexRemap.add(INVALID_VERTEX_INDEX);
+            continue;
+        }
+
+        const Vector3 vertex = triangleVertexArray.getVertex(i);
+        const Vector3 normal = hasNormals ? triangleVertexArray.getVertexNormal(i) : Vector3::zero();
+
+        // Compute the cell of the vertex and the range of cells that can contain a vertex closer than epsilon
+        int64 cell[3];
+        int64 minCell[3];
+        int64 maxCell[3];
+        for (int a=0; a < 3; a++) {
+            const decimal coordinate = vertex[a] / cellSize;
+            cell[a] = static_cast<int64>(std::floor(coordinate));
+            const decimal distanceToCellMin = (coordinate - decimal(cell[a])) * cellSize;
+            minCell[a] = distanceToCellMin < mEpsilon ? cell[a] - 1 : cell[a];
+            maxCell[a] = cellSize - distanceToCellMin < mEpsilon ? cell[a] + 1 : cell[a];
+        }
+
+        // Look for a vertex of the mesh to weld with
+        uint32 weldedVertex = INVALID_VERTEX_INDEX;
+        for (int64 x=minCell[0]; x <= maxCell[0]; x++) {
+            for (int64 y=minCell[1]; y <= maxCell[1]; y++) {
+                for (int64 z=minCell[2]; z <= maxCell[2]; z++) {
+
+                    auto it = firstVertexInCell.find(computeWeldingCellKey(x, y, z));
+                    if (it == firstVertexInCell.end()) continue;
+
+                    for (uint32 v = it->second; v != INVALID_VERTEX_INDEX && weldedVertex == INVALID_VERTEX_INDEX; v = nextVertexInCell[v]) {
+                        if ((mVertices[v] - vertex).lengthSquare() < epsilonSquare && mVerticesNormals[v] == normal) {
+                            weldedVertex = v;
+                        }
+                    }
                 }
             }
         }
+
+        if (weldedVertex != INVALID_VERTEX_INDEX) {
+            vertexRemap.add(weldedVertex);
+            continue;
+        }
+
+        // Add the vertex to the mesh
+        const uint32 meshVertex = static_cast<uint32>(mVertices.size());
+        mVertices.add(vertex);
+        mVerticesNormals.add(normal);
+        vertexRemap.add(meshVertex);
+
+        // Add the vertex in its cell of the spatial hash
+        const uint64 cellKey = computeWeldingCellKey(cell[0], cell[1], cell[2]);
+        auto it = firstVertexInCell.find(cellKey);
+        nextVertexInCell.add(it != firstVertexInCell.end() ? it->second : INVALID_VERTEX_INDEX);
+        firstVertexInCell.add(Pair<uint64, uint32>(cellKey, meshVertex), true);
+    }
+
+    assert(mVertices.size() == mVerticesNormals.size());
+
+    // Remap the vertex indices of the triangles
+    const uint32 nbTrianglesIndices = static_cast<uint32>(mTriangles.size());
+    for (uint32 t=0; t < nbTrianglesIndices; t++) {
+        assert(vertexRemap[mTriangles[t]] != INVALID_VERTEX_INDEX);
+        mTriangles[t] = vertexRemap[mTriangles[t]];
+    }
+}
+
+// Remove the triangles that have become degenerate when their vertices have been welded
+/// A welded vertex can move by up to the mesh epsilon. Therefore, a triangle with a valid area
+/// can end up with twice the same vertex or with an almost zero area after the welding. Those
+/// triangles are removed (with a warning message for the user) together with the vertices that
+/// are not used by the remaining triangles anymore.
+/**
+ * @param userTrianglesIndices Index in the user TriangleVertexArray of each triangle of the mesh
+ * @param messages The array of messages for the user
+ */
+void TriangleMesh::removeWeldedDegenerateTriangles(const Array<uint32>& userTrianglesIndices, std::vector<Message>& messages) {
+
+    assert(userTrianglesIndices.size() == getNbTriangles());
+
+    const decimal epsilonSquare = mEpsilon * mEpsilon;
+    const uint32 nbTriangles = getNbTriangles();
+
+    // Move the valid triangles at the beginning of the array of triangles
+    uint32 nbValidTrianglesIndices = 0;
+    for (uint32 t=0; t < nbTriangles; t++) {
+
+        const uint32 v1 = mTriangles[t * 3];
+        const uint32 v2 = mTriangles[t * 3 + 1];
+        const uint32 v3 = mTriangles[t * 3 + 2];
+
+        const bool hasRepeatedVertex = v1 == v2 || v2 == v3 || v3 == v1;
+        if (hasRepeatedVertex || (mVertices[v3] - mVertices[v1]).cross(mVertices[v2] - mVertices[v1]).lengthSquare() < epsilonSquare) {
+
+            // Add a warning message for the user
+            messages.push_back(Message("The face with index " + std::to_string(userTrianglesIndices[t]) + " has almost zero area once its vertices closer than the mesh epsilon are welded. This triangle will not be part of the final collision shape.",
+                                       Message::Type::Warning));
+            continue;
+        }
+
+        mTriangles[nbValidTrianglesIndices++] = v1;
+        mTriangles[nbValidTrianglesIndices++] = v2;
+        mTriangles[nbValidTrianglesIndices++] = v3;
+    }
+
+    if (nbValidTrianglesIndices == mTriangles.size()) return;
+
+    while (mTriangles.size() > nbValidTrianglesIndices) {
+        mTriangles.removeAt(mTriangles.size() - 1);
+    }
+
+    // Find the vertices that are still used by a triangle
+    const uint32 nbVertices = static_cast<uint32>(mVertices.size());
+    Array<uint32> vertexRemap(mAllocator, nbVertices);
+    for (uint32 v=0; v < nbVertices; v++) {
+        vertexRemap.add(INVALID_VERTEX_INDEX);
+    }
+    for (uint32 i=0; i < nbValidTrianglesIndices; i++) {
+        vertexRemap[mTriangles[i]] = 0;
+    }
+
+    // Move the used vertices at the beginning of the arrays of vertices and normals
+    uint32 nbUsedVertices = 0;
+    for (uint32 v=0; v < nbVertices; v++) {
+
+        if (vertexRemap[v] == INVALID_VERTEX_INDEX) continue;
+
+        mVertices[nbUsedVertices] = mVertices[v];
+        mVerticesNormals[nbUsedVertices] = mVerticesNormals[v];
+        vertexRemap[v] = nbUsedVertices;
+        nbUsedVertices++;
+    }
+
+    while (mVertices.size() > nbUsedVertices) {
+        mVertices.removeAt(mVertices.size() - 1);
+        mVerticesNormals.removeAt(mVerticesNormals.size() - 1);
+    }
+
+    // Remap the vertex indices of the triangles
+    for (uint32 i=0; i < nbValidTrianglesIndices; i++) {
+        mTriangles[i] = vertexRemap[mTriangles[i]];
     }
 }
 
-// Insert all the triangles into the dynamic AABB tree
-void TriangleMesh::initBVHTree() {
+// Insert all the triangles that are not discarded into the dynamic AABB tree
+/// An empty array of discarded triangles means that no triangle is discarded
+void TriangleMesh::initBVHTree(const Array<bool>& areTrianglesDiscarded) {
 
     assert(mTriangles.size() % 3 == 0);
+    assert(areTrianglesDiscarded.size() == 0 || areTrianglesDiscarded.size() == getNbTriangles());
 
     // TODO : Try to randomly add the triangles into the tree to obtain a better tree
 
     // For each triangle of the mesh
-    for (uint32 f=0; f < mTriangles.size() / 3; f++) {
+    const uint32 nbTriangles = getNbTriangles();
+    for (uint32 f=0; f < nbTriangles; f++) {
+
+        if (areTrianglesDiscarded.size() > 0 && areTrianglesDiscarded[f]) continue;
 
         // Get the triangle vertices
         Vector3 trianglePoints[3];
-        trianglePoints[0] = mVertices[mTriangles[f * 3]];
-        trianglePoints[1] = mVertices[mTriangles[f * 3 + 1]];
-        trianglePoints[2] = mVertices[mTriangles[f * 3 + 2]];
+        getTriangleVertices(f, trianglePoints[0], trianglePoints[1], trianglePoints[2]);
 
         // Create the AABB for the triangle
         AABB aabb = AABB::createAABBForTriangle(trianglePoints);
@@ -262,6 +554,100 @@ void TriangleMesh::initBVHTree() {
     }
 }
 
+// Write the cooked data of the mesh into a binary buffer
+/// The vertices, the vertices normals, the triangles and the flattened nodes of the BVH are written so
+/// that nothing has to be recomputed when the mesh is loaded. A mesh with the REFERENCE storage is
+/// written like a mesh with the COPY storage (the data of the user buffers are written).
+/**
+ * @param writer The writer used to write the mesh
+ */
+void TriangleMesh::serialize(BinaryWriter& writer) const {
+
+    const uint32 nbVertices = getNbVertices();
+    const uint32 nbTriangles = getNbTriangles();
+
+    writer.write(mEpsilon);
+    writer.write(nbVertices);
+    writer.write(nbTriangles);
+
+    if (mStorageType == StorageType::COPY) {
+        writer.writeVectors3(&mVertices[0], nbVertices);
+        writer.writeVectors3(&mVerticesNormals[0], nbVertices);
+        writer.writeArray(&mTriangles[0], mTriangles.size());
+    }
+    else {
+        for (uint32 v=0; v < nbVertices; v++) {
+            writer.writeVector3(getVertex(v));
+        }
+        for (uint32 v=0; v < nbVertices; v++) {
+            writer.writeVector3(getVertexNormal(v));
+        }
+        for (uint32 t=0; t < nbTriangles; t++) {
+            uint32 v1, v2, v3;
+            getTriangleVerticesIndices(t, v1, v2, v3);
+            writer.write(v1);
+            writer.write(v2);
+            writer.write(v3);
+        }
+    }
+
+    mDynamicAABBTree.serialize(writer);
+}
+
+// Initialize the mesh from cooked data
+/// The data are copied into the mesh (COPY storage) with a single copy per array and
+/// the BVH nodes are restored as they were when the mesh has been cooked.
+/**
+ * @param reader The reader used to read the mesh
+ * @param messages A reference to the array where the messages (warnings, errors, ...) will be stored
+ * @return True if the mesh has been read and is valid
+ */
+bool TriangleMesh::initFromCookedData(BinaryReader& reader, std::vector<Message>& messages) {
+
+    mStorageType = StorageType::COPY;
+
+    mEpsilon = reader.readDecimal();
+    const uint32 nbVertices = reader.read<uint32>();
+    const uint32 nbTriangles = reader.read<uint32>();
+
+    if (nbVertices == 0 || nbTriangles == 0 || !reader.hasRemaining(nbVertices, 6 * sizeof(float)) ||
+        !reader.hasRemaining(nbTriangles, 3 * sizeof(uint32))) {
+        messages.push_back(Message("The cooked triangle mesh data does not contain valid vertices and triangles"));
+        return false;
+    }
+
+    mVertices.reserve(nbVertices);
+    mVertices.addWithoutInit(nbVertices);
+    reader.readVectors3(&mVertices[0], nbVertices);
+
+    mVerticesNormals.reserve(nbVertices);
+    mVerticesNormals.addWithoutInit(nbVertices);
+    reader.readVectors3(&mVerticesNormals[0], nbVertices);
+
+    mTriangles.reserve(nbTriangles * 3);
+    mTriangles.addWithoutInit(nbTriangles * 3);
+    reader.readArray(&mTriangles[0], mTriangles.size());
+
+    if (reader.hasError()) {
+        messages.push_back(Message("The cooked triangle mesh data is truncated"));
+        return false;
+    }
+
+    for (uint32 i=0; i < mTriangles.size(); i++) {
+        if (mTriangles[i] >= nbVertices) {
+            messages.push_back(Message("The cooked triangle mesh data contains an invalid vertex index"));
+            return false;
+        }
+    }
+
+    if (!mDynamicAABBTree.deserialize(reader, nbTriangles) || mDynamicAABBTree.isEmpty()) {
+        messages.push_back(Message("The cooked triangle mesh data does not contain a valid BVH"));
+        return false;
+    }
+
+    return true;
+}
+
 // Return the minimum bounds of the mesh in the x,y,z direction
 /**
  * @return The three mimimum bounds of the mesh in the x,y,z direction
@@ -274,17 +660,33 @@ const AABB& TriangleMesh::getBounds() const {
 /// Compute the vertices normals if they are not provided by the user
 /// The vertices normals are computed with weighted average of the associated
 /// triangle face normal. The weights are the angle between the associated edges of neighbor triangle face.
-void TriangleMesh::computeVerticesNormals() {
+/// An empty array of discarded triangles means that no triangle is discarded.
+void TriangleMesh::computeVerticesNormals(const Array<bool>& areTrianglesDiscarded) {
+
+    const uint32 nbVertices = getNbVertices();
+    const uint32 nbTriangles = getNbTriangles();
+
+    // With the REFERENCE storage, the computed normals are the only data stored in the mesh
+    if (mStorageType == StorageType::REFERENCE) {
+        mVerticesNormals.reserve(nbVertices);
+        for (uint32 v=0; v < nbVertices; v++) {
+            mVerticesNormals.add(Vector3::zero());
+        }
+    }
 
     // For each triangle face in the array
-    for (uint32 f=0; f < mTriangles.size() / 3; f++) {
+    for (uint32 f=0; f < nbTriangles; f++) {
+
+        if (areTrianglesDiscarded.size() > 0 && areTrianglesDiscarded[f]) continue;
 
         // Get the triangle vertices
+        uint32 verticesIndices[3];
+        getTriangleVerticesIndices(f, verticesIndices[0], verticesIndices[1], verticesIndices[2]);
         Vector3 triangleVertices[3];
-        assert(mTriangles[f * 3 + 2] < mVertices.size());
-        triangleVertices[0] = mVertices[mTriangles[f * 3]];
-        triangleVertices[1] = mVertices[mTriangles[f * 3 + 1]];
-        triangleVertices[2] = mVertices[mTriangles[f * 3 + 2]];
+        assert(verticesIndices[2] < nbVertices);
+        triangleVertices[0] = getVertex(verticesIndices[0]);
+        triangleVertices[1] = getVertex(verticesIndices[1]);
+        triangleVertices[2] = getVertex(verticesIndices[2]);
 
         // Edges lengths
         decimal edgesLengths[3];
@@ -307,7 +709,7 @@ void TriangleMesh::computeVerticesNormals() {
 
             decimal cosA = dotProduct / lengthATimesLengthB;
             cosA = std::min(std::max(cosA, decimal(0.0)), decimal(1.0));    // Angle inside a triangle should be in [0, pi]
-            const decimal angle = std::acos(cosA);
+            const decimal angle = computeAcos(cosA);
             assert(angle >= decimal(0.0));
 
             Vector3 normal = a.cross(b);
@@ -315,14 +717,21 @@ void TriangleMesh::computeVerticesNormals() {
             normal.normalize();
 
             // Add the normal component of this vertex into the normals array
-            mVerticesNormals[mTriangles[f * 3 + v]] += angle * normal;
+            mVerticesNormals[verticesIndices[v]] += angle * normal;
         }
     }
 
-    assert(mVertices.size() == mVerticesNormals.size());
+    assert(nbVertices == mVerticesNormals.size());
 
     // Normalize the computed vertices normals
-    for (uint32 v=0; v < mVertices.size(); v++) {
+    for (uint32 v=0; v < nbVertices; v++) {
+
+        // With the REFERENCE storage, the vertices that are not used by any valid triangle
+        // are kept in the mesh. They are given an arbitrary normal.
+        if (mStorageType == StorageType::REFERENCE && mVerticesNormals[v].lengthSquare() < mEpsilon * mEpsilon) {
+            mVerticesNormals[v] = Vector3(0, 1, 0);
+            continue;
+        }
 
         assert(mVerticesNormals[v].lengthSquare() >= mEpsilon * mEpsilon);
 
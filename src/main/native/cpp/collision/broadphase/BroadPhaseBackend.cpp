@@ -0,0 +1,235 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/BroadPhaseBackend.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
+
+using namespace reactphysics3d;
+
+// Constructor
+BroadPhaseBackend::BroadPhaseBackend(MemoryAllocator& allocator, decimal fatAABBInflatePercentage)
+                  : mAllocator(allocator), mFatAABBInflatePercentage(fatAABBInflatePercentage),
+                    mProxies(allocator), mFreeProxies(allocator), mNbProxies(0) {
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    mProfiler = nullptr;
+
+#endif
+
+}
+
+// Add an object into the broad-phase and return its proxy id
+/**
+ * @param aabb The AABB of the object (it is inflated to compute the fat AABB)
+ * @param collider The collider of the object
+ * @return The id of the proxy of the object
+ */
+int32 BroadPhaseBackend::addObject(const AABB& aabb, Collider* collider) {
+
+    assert(collider != nullptr);
+
+    // Get a free proxy
+    int32 proxyId;
+    if (mFreeProxies.size() > 0) {
+        proxyId = mFreeProxies[mFreeProxies.size() - 1];
+        mFreeProxies.removeAt(mFreeProxies.size() - 1);
+    }
+    else {
+        proxyId = static_cast<int32>(mProxies.size());
+        mProxies.add(Proxy());
+    }
+
+    // Create the fat AABB (inflate the AABB by a constant percentage of its size)
+    const Vector3 gap(aabb.getExtent() * mFatAABBInflatePercentage * decimal(0.5));
+    mProxies[proxyId].aabb = AABB(aabb.getMin() - gap, aabb.getMax() + gap);
+    mProxies[proxyId].collider = collider;
+    mNbProxies++;
+
+    insertProxy(proxyId);
+
+    return proxyId;
+}
+
+// Remove an object from the broad-phase
+/**
+ * @param proxyId The id of the proxy of the object
+ */
+void BroadPhaseBackend::removeObject(int32 proxyId) {
+
+    assert(isProxyUsed(proxyId));
+
+    removeProxy(proxyId);
+
+    mProxies[proxyId].collider = nullptr;
+    mFreeProxies.add(proxyId);
+    mNbProxies--;
+}
+
+// Update the broad-phase after an object has moved
+/// As with DynamicAABBTree::updateObject(), nothing is done if the new AABB is still inside
+/// the fat AABB of the proxy. Otherwise, a new fat AABB is computed from the new AABB.
+/**
+ * @param proxyId The id of the proxy of the object
+ * @param newAABB The new AABB of the object
+ * @param forceUpdate If true, the fat AABB takes the size of the new AABB even if it contains it
+ * @return True if the fat AABB of the proxy has changed
+ */
+bool BroadPhaseBackend::updateObject(int32 proxyId, const AABB& newAABB, bool forceUpdate) {
+
+    RP3D_PROFILE("BroadPhaseBackend::updateObject()", mProfiler);
+
+    assert(isProxyUsed(proxyId));
+
+    // If the new AABB is still inside the fat AABB of the proxy
+    if (!forceUpdate && mProxies[proxyId].aabb.contains(newAABB)) {
+        return false;
+    }
+
+    const Vector3 gap(newAABB.getExtent() * mFatAABBInflatePercentage * decimal(0.5));
+
+    return updateObject(proxyId, newAABB, AABB(newAABB.getMin() - gap, newAABB.getMax() + gap), true);
+}
+
+// Update the broad-phase after an object has moved using a given fat AABB
+/**
+ * @param proxyId The id of the proxy of the object
+ * @param newAABB The new AABB of the object
+ * @param newFatAABB The fat AABB to use if the proxy is updated (it must contain the new AABB)
+ * @param forceUpdate If true, the fat AABB is changed even if it contains the new AABB
+ * @return True if the fat AABB of the proxy has changed
+ */
+bool BroadPhaseBackend::updateObject(int32 proxyId, const AABB& newAABB, const AABB& newFatAABB, bool forceUpdate) {
+
+    assert(isProxyUsed(proxyId));
+    assert(newFatAABB.contains(newAABB));
+
+    // If the new AABB is still inside the fat AABB of the proxy
+    if (!forceUpdate && mProxies[proxyId].aabb.contains(newAABB)) {
+        return false;
+    }
+
+    mProxies[proxyId].aabb = newFatAABB;
+
+    moveProxy(proxyId);
+
+    return true;
+}
+
+// Called once all the objects that have moved during a step have been updated
+void BroadPhaseBackend::update() {
+
+}
+
+// Report the proxies whose fat AABB is within a shrinking distance of a given AABB
+/// The callback is called as in DynamicAABBTree::reportShapesWithinDistance() but the proxies
+/// are not visited from the nearest to the farthest.
+/**
+ * @param aabb The AABB of the query
+ * @param maxDistance The initial search distance
+ * @param callback The callback that returns the new search distance (a negative distance stops the query)
+ */
+void BroadPhaseBackend::reportShapesWithinDistance(const AABB& aabb, decimal maxDistance, DynamicAABBTreeDistanceCallback& callback) const {
+
+    RP3D_PROFILE("BroadPhaseBackend::reportShapesWithinDistance()", mProfiler);
+
+    const int32 nbProxies = static_cast<int32>(mProxies.size());
+    for (int32 i=0; i < nbProxies; i++) {
+
+        if (mProxies[i].collider == nullptr || aabb.computeSquareDistance(mProxies[i].aabb) > maxDistance * maxDistance) continue;
+
+        const decimal distance = callback.notifyNodeWithinDistance(i, maxDistance);
+
+        // If the user returned a negative distance, the query stops here
+        if (distance < decimal(0.0)) {
+            return;
+        }
+
+        if (distance < maxDistance) {
+            maxDistance = distance;
+        }
+    }
+}
+
+// Write the proxies and the acceleration structure into a world snapshot
+/// As with DynamicAABBTree::takeSnapshot(), the proxies are written in the memory layout
+/// of the host and the snapshot can only be restored in the same broad-phase.
+/**
+ * @param writer The writer used to write the snapshot
+ */
+void BroadPhaseBackend::takeSnapshot(BinaryWriter& writer) const {
+
+    writer.write(static_cast<uint32>(mProxies.size()));
+    if (mProxies.size() > 0) {
+        writer.writeBytes(&mProxies[0], mProxies.size() * sizeof(Proxy));
+    }
+
+    writer.write(static_cast<uint32>(mFreeProxies.size()));
+    if (mFreeProxies.size() > 0) {
+        writer.writeArray(&mFreeProxies[0], mFreeProxies.size());
+    }
+
+    takeStructureSnapshot(writer);
+}
+
+// Restore the proxies and the acceleration structure from a world snapshot
+/**
+ * @param reader The reader used to read the snapshot
+ * @return True if the proxies have been restored
+ */
+bool BroadPhaseBackend::restoreSnapshot(BinaryReader& reader) {
+
+    const uint32 nbProxies = reader.read<uint32>();
+    if (!reader.hasRemaining(nbProxies, sizeof(Proxy))) {
+        return false;
+    }
+
+    mProxies.clear();
+    mProxies.addWithoutInit(nbProxies);
+    if (nbProxies > 0) {
+        reader.readBytes(&mProxies[0], nbProxies * sizeof(Proxy));
+    }
+
+    const uint32 nbFreeProxies = reader.read<uint32>();
+    if (!reader.hasRemaining(nbFreeProxies, sizeof(int32)) || nbFreeProxies > nbProxies) {
+        return false;
+    }
+
+    mFreeProxies.clear();
+    for (uint32 i=0; i < nbFreeProxies; i++) {
+        const int32 proxyId = reader.read<int32>();
+        if (proxyId < 0 || proxyId >= static_cast<int32>(nbProxies)) {
+            return false;
+        }
+        mFreeProxies.add(proxyId);
+    }
+
+    mNbProxies = nbProxies - nbFreeProxies;
+
+    return restoreStructureSnapshot(reader) && !reader.hasError();
+}
@@ -28,15 +28,29 @@
 #include <reactphysics3d/systems/BroadPhaseSystem.h>
 #include <reactphysics3d/containers/Stack.h>
 #include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
+#include <algorithm>
 
 using namespace reactphysics3d;
 
 // Initialization of static variables
 const int32 TreeNode::NULL_TREE_NODE = -1;
 
+namespace {
+
+// Return the surface area of an AABB (cost of a node for the surface area heuristic)
+decimal computeSurfaceArea(const AABB& aabb) {
+
+    const Vector3 size = aabb.getExtent();
+    return decimal(2.0) * (size.x * size.y + size.y * size.z + size.z * size.x);
+}
+
+}
+
 // Constructor
 DynamicAABBTree::DynamicAABBTree(MemoryAllocator& allocator, decimal fatAABBInflatePercentage)
-                : mAllocator(allocator), mFatAABBInflatePercentage(fatAABBInflatePercentage) {
+                : mAllocator(allocator), mFatAABBInflatePercentage(fatAABBInflatePercentage),
+                  mRefitLeaves(allocator), mRefitNodes(allocator) {
 
     init();
 }
@@ -85,10 +99,189 @@ void DynamicAABBTree::reset() {
     // Free the allocated memory for the nodes
     mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
 
+    mRefitLeaves.clear();
+    mRefitNodes.clear();
+
     // Initialize the tree
     init();
 }
 
+// Write the nodes of the tree (with integer data) into a binary buffer
+/// Only the nodes up to the last node in use are written. The free nodes are written
+/// with a negative height and their links are rebuilt when the tree is read back.
+/**
+ * @param writer The writer used to write the nodes
+ */
+void DynamicAABBTree::serialize(BinaryWriter& writer) const {
+
+    int32 nbSerializedNodes = 0;
+    for (int32 i=0; i < mNbAllocatedNodes; i++) {
+        if (mNodes[i].height >= 0) {
+            nbSerializedNodes = i + 1;
+        }
+    }
+
+    writer.write(mRootNodeID);
+    writer.write(nbSerializedNodes);
+
+    for (int32 i=0; i < nbSerializedNodes; i++) {
+
+        const TreeNode& node = mNodes[i];
+        const bool isUsed = node.height >= 0;
+        writer.write(isUsed ? node.parentID : TreeNode::NULL_TREE_NODE);
+        writer.write(isUsed ? node.children[0] : TreeNode::NULL_TREE_NODE);
+        writer.write(isUsed && !node.isLeaf() ? node.children[1] : TreeNode::NULL_TREE_NODE);
+        writer.write(node.height);
+        writer.writeVector3(node.aabb.getMin());
+        writer.writeVector3(node.aabb.getMax());
+    }
+}
+
+// Replace the nodes of the tree by the nodes read from a binary buffer
+/**
+ * @param reader The reader used to read the nodes
+ * @param maxNodeDataInt The integer data of each leaf node must be smaller than this value
+ * @return True if the nodes have been read and form a valid tree
+ */
+bool DynamicAABBTree::deserialize(BinaryReader& reader, uint32 maxNodeDataInt) {
+
+    const int32 rootNodeID = reader.read<int32>();
+    const int32 nbSerializedNodes = reader.read<int32>();
+
+    // Minimum size of a node in the buffer (with single precision decimals)
+    const size_t minNodeSize = 3 * sizeof(int32) + sizeof(int16) + 6 * sizeof(float);
+
+    if (reader.hasError() || nbSerializedNodes < 0 || !reader.hasRemaining(static_cast<size_t>(nbSerializedNodes), minNodeSize) ||
+        rootNodeID < TreeNode::NULL_TREE_NODE || rootNodeID >= nbSerializedNodes) {
+        return false;
+    }
+
+    // Replace the nodes of the tree
+    reset();
+    if (nbSerializedNodes > mNbAllocatedNodes) {
+
+        for (int32 i=0; i < mNbAllocatedNodes; i++) {
+            mNodes[i].~TreeNode();
+        }
+        mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+
+        mNbAllocatedNodes = nbSerializedNodes;
+        mNodes = static_cast<TreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode)));
+        assert(mNodes);
+        for (int32 i=0; i < mNbAllocatedNodes; i++) {
+            new (mNodes + i) TreeNode();
+        }
+    }
+
+    bool isValid = true;
+    mNbNodes = 0;
+    for (int32 i=0; i < nbSerializedNodes; i++) {
+
+        TreeNode& node = mNodes[i];
+        node.parentID = reader.read<int32>();
+        const int32 child0 = reader.read<int32>();
+        const int32 child1 = reader.read<int32>();
+        node.height = reader.read<int16>();
+        const Vector3 aabbMin = reader.readVector3();
+        const Vector3 aabbMax = reader.readVector3();
+        node.aabb.setMin(aabbMin);
+        node.aabb.setMax(aabbMax);
+
+        if (node.height < 0) continue;
+
+        mNbNodes++;
+
+        isValid &= node.parentID >= TreeNode::NULL_TREE_NODE && node.parentID < nbSerializedNodes;
+        if (node.isLeaf()) {
+            node.dataInt = static_cast<uint32>(child0);
+            isValid &= node.dataInt < maxNodeDataInt;
+        }
+        else {
+            node.children[0] = child0;
+            node.children[1] = child1;
+            isValid &= child0 >= 0 && child0 < nbSerializedNodes && child1 >= 0 && child1 < nbSerializedNodes;
+        }
+    }
+
+    isValid &= !reader.hasError() && (rootNodeID == TreeNode::NULL_TREE_NODE || mNodes[rootNodeID].height >= 0);
+    mRootNodeID = isValid ? rootNodeID : TreeNode::NULL_TREE_NODE;
+
+    // Rebuild the linked list of the free nodes
+    mFreeNodeID = TreeNode::NULL_TREE_NODE;
+    for (int32 i = mNbAllocatedNodes - 1; i >= 0; i--) {
+        if (i >= nbSerializedNodes || mNodes[i].height < 0) {
+            mNodes[i].height = -1;
+            mNodes[i].nextNodeID = mFreeNodeID;
+            mFreeNodeID = i;
+        }
+    }
+
+    if (!isValid) {
+        reset();
+    }
+
+    return isValid;
+}
+
+// Write the raw nodes of the tree into a world snapshot
+/// Contrary to serialize(), all the allocated nodes are written in the memory layout of the
+/// host. The pointer data of the leaves is written as is and therefore the snapshot can
+/// only be restored in the same tree.
+/**
+ * @param writer The writer used to write the snapshot
+ */
+void DynamicAABBTree::takeSnapshot(BinaryWriter& writer) const {
+
+    writer.write(mRootNodeID);
+    writer.write(mFreeNodeID);
+    writer.write(mNbAllocatedNodes);
+    writer.write(mNbNodes);
+    writer.writeBytes(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+}
+
+// Replace the nodes of the tree by the raw nodes of a world snapshot
+/**
+ * @param reader The reader used to read the snapshot
+ * @return True if the nodes have been restored
+ */
+bool DynamicAABBTree::restoreSnapshot(BinaryReader& reader) {
+
+    const int32 rootNodeID = reader.read<int32>();
+    const int32 freeNodeID = reader.read<int32>();
+    const int32 nbAllocatedNodes = reader.read<int32>();
+    const int32 nbNodes = reader.read<int32>();
+
+    if (reader.hasError() || nbAllocatedNodes <= 0 || nbNodes < 0 || nbNodes > nbAllocatedNodes ||
+        rootNodeID < TreeNode::NULL_TREE_NODE || rootNodeID >= nbAllocatedNodes ||
+        freeNodeID < TreeNode::NULL_TREE_NODE || freeNodeID >= nbAllocatedNodes ||
+        !reader.hasRemaining(static_cast<size_t>(nbAllocatedNodes), sizeof(TreeNode))) {
+        return false;
+    }
+
+    // Allocate the same number of nodes as in the snapshot
+    if (nbAllocatedNodes != mNbAllocatedNodes) {
+
+        for (int32 i=0; i < mNbAllocatedNodes; i++) {
+            mNodes[i].~TreeNode();
+        }
+        mAllocator.release(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+
+        mNbAllocatedNodes = nbAllocatedNodes;
+        mNodes = static_cast<TreeNode*>(mAllocator.allocate(static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode)));
+        assert(mNodes);
+        for (int32 i=0; i < mNbAllocatedNodes; i++) {
+            new (mNodes + i) TreeNode();
+        }
+    }
+
+    reader.readBytes(mNodes, static_cast<size_t>(mNbAllocatedNodes) * sizeof(TreeNode));
+    mRootNodeID = rootNodeID;
+    mFreeNodeID = freeNodeID;
+    mNbNodes = nbNodes;
+
+    return true;
+}
+
 // Allocate and return a new node in the tree
 int32 DynamicAABBTree::allocateNode() {
 
@@ -170,6 +363,7 @@ void DynamicAABBTree::removeObject(int32 nodeID) {
 
     assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
     assert(mNodes[nodeID].isLeaf());
+    assert(mRefitLeaves.size() == 0);
 
     // Remove the node from the tree
     removeLeafNode(nodeID);
@@ -196,23 +390,164 @@ bool DynamicAABBTree::updateObject(int32 nodeID, const AABB& newAABB, bool force
         return false;
     }
 
+    // Compute the fat AABB by inflating the AABB with by a constant percentage of the size of the AABB
+    const Vector3 gap(newAABB.getExtent() * mFatAABBInflatePercentage * decimal(0.5f));
+
+    return updateObject(nodeID, newAABB, AABB(newAABB.getMin() - gap, newAABB.getMax() + gap), true);
+}
+
+// Update the dynamic tree after an object has moved using a given fat AABB
+/// This is the same as the other updateObject() method except that the fat AABB of the node
+/// is given by the caller (for instance to extend it along the predicted motion of the object)
+/// instead of being inflated by the constant percentage of the tree.
+/**
+ * @param nodeID The ID of the leaf node of the object
+ * @param newAABB The new AABB of the object
+ * @param newFatAABB The fat AABB to use if the node is reinserted (it must contain the new AABB)
+ * @param forceReinsert If true, the node is reinserted even if its fat AABB contains the new AABB
+ * @return True if the node has been reinserted into the tree
+ */
+bool DynamicAABBTree::updateObject(int32 nodeID, const AABB& newAABB, const AABB& newFatAABB, bool forceReinsert) {
+
+    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
+    assert(mNodes[nodeID].isLeaf());
+    assert(mNodes[nodeID].height >= 0);
+    assert(newFatAABB.contains(newAABB));
+
+    // If the new AABB is still inside the fat AABB of the node
+    if (!forceReinsert && mNodes[nodeID].aabb.contains(newAABB)) {
+        return false;
+    }
+
     // If the new AABB is outside the fat AABB, we remove the corresponding node
     removeLeafNode(nodeID);
 
+    mNodes[nodeID].aabb = newFatAABB;
+
+    // Reinsert the node into the tree
+    insertLeafNode(nodeID);
+
+    return true;
+}
+
+// Change the fat AABB of an object that has moved in place (the tree must then be refitted)
+/// Contrary to updateObject(), the node is not removed and reinserted into the tree when the
+/// new AABB is outside its fat AABB. Only the fat AABB of the leaf is changed and the
+/// ancestors of the leaf are refitted later for all the moved objects at once with
+/// refit(). The tree must not be used before refit() has been called.
+/**
+ * @param nodeID The ID of the leaf node of the object
+ * @param newAABB The new AABB of the object
+ * @param forceRefit If true, the fat AABB takes the size of the new AABB even if it contains it
+ * @return True if the fat AABB of the leaf node has been changed
+ */
+bool DynamicAABBTree::refitObject(int32 nodeID, const AABB& newAABB, bool forceRefit) {
+
+    RP3D_PROFILE("DynamicAABBTree::refitObject()", mProfiler);
+
+    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
+    assert(mNodes[nodeID].isLeaf());
+
+    // If the new AABB is still inside the fat AABB of the node
+    if (!forceRefit && mNodes[nodeID].aabb.contains(newAABB)) {
+        return false;
+    }
+
     // Compute the fat AABB by inflating the AABB with by a constant percentage of the size of the AABB
-    mNodes[nodeID].aabb = newAABB;
     const Vector3 gap(newAABB.getExtent() * mFatAABBInflatePercentage * decimal(0.5f));
-    mNodes[nodeID].aabb.mMinCoordinates -= gap;
-    mNodes[nodeID].aabb.mMaxCoordinates += gap;
 
-    assert(mNodes[nodeID].aabb.contains(newAABB));
+    return refitObject(nodeID, newAABB, AABB(newAABB.getMin() - gap, newAABB.getMax() + gap), true);
+}
+
+// Change the fat AABB of an object that has moved in place using a given fat AABB
+/**
+ * @param nodeID The ID of the leaf node of the object
+ * @param newAABB The new AABB of the object
+ * @param newFatAABB The fat AABB to use if the leaf is changed (it must contain the new AABB)
+ * @param forceRefit If true, the fat AABB is changed even if it contains the new AABB
+ * @return True if the fat AABB of the leaf node has been changed
+ */
+bool DynamicAABBTree::refitObject(int32 nodeID, const AABB& newAABB, const AABB& newFatAABB, bool forceRefit) {
 
-    // Reinsert the node into the tree
-    insertLeafNode(nodeID);
+    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
+    assert(mNodes[nodeID].isLeaf());
+    assert(newFatAABB.contains(newAABB));
+
+    // If the new AABB is still inside the fat AABB of the node
+    if (!forceRefit && mNodes[nodeID].aabb.contains(newAABB)) {
+        return false;
+    }
+
+    mNodes[nodeID].aabb = newFatAABB;
+
+    // The ancestors of the leaf will be refitted by the next call to refit()
+    mRefitLeaves.add(nodeID);
 
     return true;
 }
 
+// Refit the ancestors of the objects that have moved and perform some tree rotations
+/// The ancestors of all the leaves changed with refitObject() since the last call are
+/// collected and their AABB and height are recomputed in a single bottom-up pass. Each
+/// internal node is therefore visited only once even if many of its leaves have moved.
+/// During this pass, at most "maxNbRotations" tree rotations are performed on the refitted
+/// nodes to reduce the surface area of the tree (as in the dynamic tree of Box2D v3).
+/**
+ * @param maxNbRotations Maximum number of tree rotations to perform
+ * @return The number of tree rotations that have been performed
+ */
+uint32 DynamicAABBTree::refit(uint32 maxNbRotations) {
+
+    if (mRefitLeaves.size() == 0) return 0;
+
+    RP3D_PROFILE("DynamicAABBTree::refit()", mProfiler);
+
+    // Collect the ancestors of the moved leaves. We stop climbing as soon as we reach a node
+    // that has already been collected because all its ancestors have been collected too
+    for (uint32 i=0; i < mRefitLeaves.size(); i++) {
+
+        int32 nodeID = mNodes[mRefitLeaves[i]].parentID;
+        while (nodeID != TreeNode::NULL_TREE_NODE && !mNodes[nodeID].isRefitPending) {
+
+            mNodes[nodeID].isRefitPending = true;
+            mRefitNodes.add(nodeID);
+            nodeID = mNodes[nodeID].parentID;
+        }
+    }
+    mRefitLeaves.clear();
+
+    // Sort the nodes by increasing height so that the children of a node are refitted before it
+    std::sort(mRefitNodes.begin(), mRefitNodes.end(), [this](int32 nodeID1, int32 nodeID2) {
+        return mNodes[nodeID1].height < mNodes[nodeID2].height ||
+               (mNodes[nodeID1].height == mNodes[nodeID2].height && nodeID1 < nodeID2);
+    });
+
+    uint32 nbRotations = 0;
+    for (uint32 i=0; i < mRefitNodes.size(); i++) {
+
+        const int32 nodeID = mRefitNodes[i];
+        TreeNode& node = mNodes[nodeID];
+        assert(!node.isLeaf());
+
+        node.isRefitPending = false;
+
+        // Recompute the AABB and the height of the node from its children
+        const TreeNode& leftChild = mNodes[node.children[0]];
+        const TreeNode& rightChild = mNodes[node.children[1]];
+        node.aabb.mergeTwoAABBs(leftChild.aabb, rightChild.aabb);
+        node.height = std::max(leftChild.height, rightChild.height) + 1;
+
+        // A rotation only changes the nodes of the sub-tree that have already been refitted
+        // and keeps the AABB of the node. Its ancestors are refitted later in the loop.
+        if (nbRotations < maxNbRotations && rotateNode(nodeID)) {
+            nbRotations++;
+        }
+    }
+    mRefitNodes.clear();
+
+    return nbRotations;
+}
+
 // Insert a leaf node in the tree. The process of inserting a new leaf node
 // in the dynamic tree is described in the book "Introduction to Game Physics
 // with Box2D" by Ian Parberry.
@@ -585,6 +920,68 @@ int32 DynamicAABBTree::balanceSubTreeAtNode(int32 nodeID) {
     return nodeID;
 }
 
+// Swap a child of a node with a grandchild if this reduces the surface area of the sub-tree
+/// If A is the node with children B and C, we try to swap B with one of the children of C
+/// and C with one of the children of B. The set of leaves of the sub-tree of A does not change
+/// and therefore only the AABB of the child of A that receives the swapped node changes. We
+/// select the swap that reduces the most the surface area of this child (if any).
+/// The method returns true if a rotation has been performed.
+bool DynamicAABBTree::rotateNode(int32 nodeID) {
+
+    assert(nodeID >= 0 && nodeID < mNbAllocatedNodes);
+
+    TreeNode& nodeA = mNodes[nodeID];
+    if (nodeA.height < 2) return false;
+
+    // Index (in A) of the child to swap and index (in the sibling) of the grandchild to swap with
+    int bestChildIndex = -1;
+    int bestGrandChildIndex = -1;
+    decimal bestAreaReduction = decimal(0.0);
+
+    for (int i=0; i < 2; i++) {
+
+        const TreeNode& child = mNodes[nodeA.children[i]];
+        const TreeNode& sibling = mNodes[nodeA.children[1 - i]];
+        if (sibling.isLeaf()) continue;
+
+        // If the child is swapped with a grandchild, the sibling will contain the child and the other grandchild
+        const decimal siblingArea = computeSurfaceArea(sibling.aabb);
+        for (int j=0; j < 2; j++) {
+
+            AABB newSiblingAABB;
+            newSiblingAABB.mergeTwoAABBs(child.aabb, mNodes[sibling.children[1 - j]].aabb);
+            const decimal areaReduction = siblingArea - computeSurfaceArea(newSiblingAABB);
+            if (areaReduction > bestAreaReduction) {
+                bestAreaReduction = areaReduction;
+                bestChildIndex = i;
+                bestGrandChildIndex = j;
+            }
+        }
+    }
+
+    if (bestChildIndex < 0) return false;
+
+    // Swap the child and the grandchild
+    const int32 childID = nodeA.children[bestChildIndex];
+    const int32 siblingID = nodeA.children[1 - bestChildIndex];
+    TreeNode& sibling = mNodes[siblingID];
+    const int32 grandChildID = sibling.children[bestGrandChildIndex];
+
+    nodeA.children[bestChildIndex] = grandChildID;
+    mNodes[grandChildID].parentID = nodeID;
+    sibling.children[bestGrandChildIndex] = childID;
+    mNodes[childID].parentID = siblingID;
+
+    // Recompute the AABB and the height of the sibling and the height of A
+    const TreeNode& siblingLeftChild = mNodes[sibling.children[0]];
+    const TreeNode& siblingRightChild = mNodes[sibling.children[1]];
+    sibling.aabb.mergeTwoAABBs(siblingLeftChild.aabb, siblingRightChild.aabb);
+    sibling.height = std::max(siblingLeftChild.height, siblingRightChild.height) + 1;
+    nodeA.height = std::max(mNodes[nodeA.children[0]].height, mNodes[nodeA.children[1]].height) + 1;
+
+    return true;
+}
+
 /// Take an array of shapes to be tested for broad-phase overlap and return an array of pair of overlapping shapes
 void DynamicAABBTree::reportAllShapesOverlappingWithShapes(const Array<int32>& nodesToTest, uint32 startIndex,
                                                            size_t endIndex, Array<Pair<int32, int32>>& outOverlappingNodes) const {
@@ -639,11 +1036,19 @@ void DynamicAABBTree::reportAllShapesOverlappingWithShapes(const Array<int32>& n
 
 // Report all shapes overlapping with the AABB given in parameter.
 void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes) const {
+    reportAllShapesOverlappingWithAABB(aabb, overlappingNodes, mAllocator);
+}
+
+// Report all shapes overlapping with the AABB given in parameter.
+/// The stack of nodes to visit is allocated with the allocator in parameter. The tree itself is
+/// only read, so several threads can call this method at the same time with different allocators.
+void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes,
+                                                         MemoryAllocator& stackAllocator) const {
 
     RP3D_PROFILE("DynamicAABBTree::reportAllShapesOverlappingWithAABB()", mProfiler);
 
     // Create a stack with the nodes to visit
-    Stack<int32> stack(mAllocator, 64);
+    Stack<int32> stack(stackAllocator, 64);
     stack.push(mRootNodeID);
 
     // While there are still nodes to visit
@@ -682,6 +1087,13 @@ void DynamicAABBTree::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array
 
 // Ray casting method
 void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const {
+    raycast(ray, callback, mAllocator);
+}
+
+// Ray casting method
+/// The stack of nodes to visit is allocated with the allocator in parameter. The tree itself is
+/// only read, so several threads can call this method at the same time with different allocators.
+void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& stackAllocator) const {
 
     RP3D_PROFILE("DynamicAABBTree::raycast()", mProfiler);
 
@@ -691,7 +1103,7 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& ca
     const Vector3 rayDirection = ray.point2 - ray.point1;
     const Vector3 rayDirectionInverse(decimal(1.0) / rayDirection.x, decimal(1.0) / rayDirection.y, decimal(1.0) / rayDirection.z);
 
-    Stack<int32> stack(mAllocator, 128);
+    Stack<int32> stack(stackAllocator, 128);
     stack.push(mRootNodeID);
 
     // Walk through the tree from the root looking for colliders
@@ -746,6 +1158,63 @@ void DynamicAABBTree::raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& ca
     }
 }
 
+// Report the shapes whose AABB is within a shrinking distance of the AABB given in parameter
+/// The callback is called for each leaf node whose AABB is closer than the current search distance
+/// and returns the new search distance. The nearest child of each node is visited first so that the
+/// search distance shrinks quickly and most of the tree is never visited.
+void DynamicAABBTree::reportShapesWithinDistance(const AABB& aabb, decimal maxDistance, DynamicAABBTreeDistanceCallback& callback,
+                                                 MemoryAllocator& stackAllocator) const {
+
+    RP3D_PROFILE("DynamicAABBTree::reportShapesWithinDistance()", mProfiler);
+
+    Stack<int32> stack(stackAllocator, 64);
+    stack.push(mRootNodeID);
+
+    while (stack.size() > 0) {
+
+        // Get the next node in the stack
+        int32 nodeID = stack.pop();
+
+        // If it is a null node, skip it
+        if (nodeID == TreeNode::NULL_TREE_NODE) continue;
+
+        // Get the corresponding node
+        const TreeNode* node = mNodes + nodeID;
+
+        // Skip the node if its AABB is farther than the search distance
+        if (aabb.computeSquareDistance(node->aabb) > maxDistance * maxDistance) continue;
+
+        // If the node is a leaf of the tree
+        if (node->isLeaf()) {
+
+            const decimal distance = callback.notifyNodeWithinDistance(nodeID, maxDistance);
+
+            // If the user returned a negative distance, the query stops here
+            if (distance < decimal(0.0)) {
+                return;
+            }
+
+            if (distance < maxDistance) {
+                maxDistance = distance;
+            }
+        }
+        else {  // If the node has children
+
+            // Push the farthest child first so that the nearest one is visited first
+            const int32 child1 = node->children[0];
+            const int32 child2 = node->children[1];
+            if (aabb.computeSquareDistance(mNodes[child1].aabb) < aabb.computeSquareDistance(mNodes[child2].aabb)) {
+                stack.push(child2);
+                stack.push(child1);
+            }
+            else {
+                stack.push(child1);
+                stack.push(child2);
+            }
+        }
+    }
+}
+
 #ifndef NDEBUG
 
 // Check if the tree structure is valid (for debugging purpose)
@@ -0,0 +1,340 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/SweepAndPruneBroadPhase.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
+#include <algorithm>
+
+using namespace reactphysics3d;
+
+// Constructor
+SweepAndPruneBroadPhase::SweepAndPruneBroadPhase(MemoryAllocator& allocator, decimal fatAABBInflatePercentage)
+                        : BroadPhaseBackend(allocator, fatAABBInflatePercentage), mAxis(0), mSortedMins(allocator),
+                          mSortedAABBs(allocator), mSortedProxies(allocator), mProxyIndices(allocator),
+                          mMaxExtent(decimal(0.0)), mIsProxyToTest(allocator) {
+
+}
+
+// Add a new proxy into the sorted arrays
+void SweepAndPruneBroadPhase::insertProxy(int32 proxyId) {
+
+    while (mProxyIndices.size() <= static_cast<uint64>(proxyId)) {
+        mProxyIndices.add(0);
+        mIsProxyToTest.add(false);
+    }
+
+    const AABB& aabb = mProxies[proxyId].aabb;
+
+    // Add the proxy at the end of the sorted arrays and move it to its sorted place
+    const uint32 index = static_cast<uint32>(mSortedProxies.size());
+    mSortedMins.add(aabb.getMin()[mAxis]);
+    mSortedAABBs.add(aabb);
+    mSortedProxies.add(proxyId);
+    mProxyIndices[proxyId] = index;
+
+    mMaxExtent = std::max(mMaxExtent, aabb.getMax()[mAxis] - aabb.getMin()[mAxis]);
+
+    sortEntry(index);
+}
+
+// Remove a proxy from the sorted arrays
+void SweepAndPruneBroadPhase::removeProxy(int32 proxyId) {
+
+    const uint32 index = mProxyIndices[proxyId];
+    assert(mSortedProxies[index] == proxyId);
+
+    // Remove the entry (the following entries are shifted to keep the arrays sorted)
+    mSortedMins.removeAt(index);
+    mSortedAABBs.removeAt(index);
+    mSortedProxies.removeAt(index);
+
+    const uint32 nbSortedProxies = static_cast<uint32>(mSortedProxies.size());
+    for (uint32 i=index; i < nbSortedProxies; i++) {
+        mProxyIndices[mSortedProxies[i]] = i;
+    }
+}
+
+// Move a proxy to its new place in the sorted arrays
+void SweepAndPruneBroadPhase::moveProxy(int32 proxyId) {
+
+    const uint32 index = mProxyIndices[proxyId];
+    assert(mSortedProxies[index] == proxyId);
+
+    const AABB& aabb = mProxies[proxyId].aabb;
+    mSortedMins[index] = aabb.getMin()[mAxis];
+    mSortedAABBs[index] = aabb;
+
+    mMaxExtent = std::max(mMaxExtent, aabb.getMax()[mAxis] - aabb.getMin()[mAxis]);
+
+    sortEntry(index);
+}
+
+// Swap two consecutive entries of the sorted arrays
+void SweepAndPruneBroadPhase::swapSortedEntries(uint32 index1, uint32 index2) {
+
+    std::swap(mSortedMins[index1], mSortedMins[index2]);
+    std::swap(mSortedAABBs[index1], mSortedAABBs[index2]);
+    std::swap(mSortedProxies[index1], mSortedProxies[index2]);
+    mProxyIndices[mSortedProxies[index1]] = index1;
+    mProxyIndices[mSortedProxies[index2]] = index2;
+}
+
+// Move an entry of the sorted arrays to its sorted place (insertion sort)
+void SweepAndPruneBroadPhase::sortEntry(uint32 index) {
+
+    while (index > 0 && mSortedMins[index - 1] > mSortedMins[index]) {
+        swapSortedEntries(index - 1, index);
+        index--;
+    }
+
+    const uint32 lastIndex = static_cast<uint32>(mSortedMins.size()) - 1;
+    while (index < lastIndex && mSortedMins[index + 1] < mSortedMins[index]) {
+        swapSortedEntries(index, index + 1);
+        index++;
+    }
+}
+
+// Sort all the proxies along the sorting axis
+/// The proxies with the same minimum coordinate are sorted by id.
+void SweepAndPruneBroadPhase::sortAllProxies() {
+
+    RP3D_PROFILE("SweepAndPruneBroadPhase::sortAllProxies()", mProfiler);
+
+    const uint32 axis = mAxis;
+    std::sort(mSortedProxies.begin(), mSortedProxies.end(), [this, axis](int32 proxyId1, int32 proxyId2) {
+        const decimal min1 = mProxies[proxyId1].aabb.getMin()[axis];
+        const decimal min2 = mProxies[proxyId2].aabb.getMin()[axis];
+        return min1 < min2 || (min1 == min2 && proxyId1 < proxyId2);
+    });
+
+    const uint32 nbSortedProxies = static_cast<uint32>(mSortedProxies.size());
+    for (uint32 i=0; i < nbSortedProxies; i++) {
+        const int32 proxyId = mSortedProxies[i];
+        mSortedAABBs[i] = mProxies[proxyId].aabb;
+        mSortedMins[i] = mSortedAABBs[i].getMin()[axis];
+        mProxyIndices[proxyId] = i;
+    }
+}
+
+// Return the axis with the largest variance of the centers of the AABBs
+uint32 SweepAndPruneBroadPhase::computeBestAxis(decimal& outCurrentAxisVariance, decimal& outBestAxisVariance) const {
+
+    const uint32 nbSortedProxies = static_cast<uint32>(mSortedAABBs.size());
+
+    Vector3 sum(0, 0, 0);
+    Vector3 sumSquares(0, 0, 0);
+    for (uint32 i=0; i < nbSortedProxies; i++) {
+        const Vector3 center = mSortedAABBs[i].getCenter();
+        sum += center;
+        sumSquares += center * center;
+    }
+
+    const decimal inverseNbProxies = decimal(1.0) / decimal(nbSortedProxies);
+    const Vector3 mean = sum * inverseNbProxies;
+    const Vector3 variance = sumSquares * inverseNbProxies - mean * mean;
+
+    const uint32 bestAxis = static_cast<uint32>(variance.getMaxAxis());
+    outCurrentAxisVariance = variance[mAxis];
+    outBestAxisVariance = variance[bestAxis];
+
+    return bestAxis;
+}
+
+// Update the sorting axis and the maximum extent of the AABBs
+/// The proxies are sorted again along a new axis only if the centers of the AABBs are
+/// clearly more spread out along this axis than along the current one.
+void SweepAndPruneBroadPhase::update() {
+
+    RP3D_PROFILE("SweepAndPruneBroadPhase::update()", mProfiler);
+
+    if (mSortedAABBs.size() == 0) {
+        mMaxExtent = decimal(0.0);
+        return;
+    }
+
+    decimal currentAxisVariance, bestAxisVariance;
+    const uint32 bestAxis = computeBestAxis(currentAxisVariance, bestAxisVariance);
+    if (bestAxis != mAxis && bestAxisVariance > currentAxisVariance * AXIS_CHANGE_VARIANCE_FACTOR) {
+        mAxis = bestAxis;
+        sortAllProxies();
+    }
+
+    // Recompute the maximum extent (it only grows when the proxies move)
+    mMaxExtent = decimal(0.0);
+    const uint32 nbSortedProxies = static_cast<uint32>(mSortedAABBs.size());
+    for (uint32 i=0; i < nbSortedProxies; i++) {
+        mMaxExtent = std::max(mMaxExtent, mSortedAABBs[i].getMax()[mAxis] - mSortedMins[i]);
+    }
+}
+
+// Report the pairs of proxies whose fat AABBs overlap with the fat AABB of some proxies to test
+/// If only a few proxies have to be tested, the neighbors of each proxy in the sorted arrays are
+/// tested. Otherwise (or if there are too many neighbors because of some large proxies), all the
+/// sorted proxies are swept once and only the pairs with a proxy to test are reported.
+void SweepAndPruneBroadPhase::reportAllShapesOverlappingWithShapes(const Array<int32>& proxiesToTest,
+                                                                   Array<Pair<int32, int32>>& outOverlappingProxies) {
+
+    RP3D_PROFILE("SweepAndPruneBroadPhase::reportAllShapesOverlappingWithShapes()", mProfiler);
+
+    const uint32 nbSortedProxies = static_cast<uint32>(mSortedProxies.size());
+    const uint32 nbProxiesToTest = static_cast<uint32>(proxiesToTest.size());
+    const uint64 initialNbOverlappingProxies = outOverlappingProxies.size();
+
+    if (nbProxiesToTest * 4 < nbSortedProxies) {
+
+        // Number of sorted entries visited so far (the full sweep is used if it becomes cheaper)
+        uint32 nbVisitedEntries = 0;
+
+        uint32 i;
+        for (i=0; i < nbProxiesToTest && nbVisitedEntries <= nbSortedProxies; i++) {
+
+            const int32 proxyId = proxiesToTest[i];
+            const uint32 index = mProxyIndices[proxyId];
+            const AABB& aabb = mSortedAABBs[index];
+            const decimal minCoordinate = mSortedMins[index];
+            const decimal maxCoordinate = aabb.getMax()[mAxis];
+
+            // Test the next proxies until their interval starts after the end of the interval of the proxy
+            uint32 j = index + 1;
+            for (; j < nbSortedProxies && mSortedMins[j] <= maxCoordinate; j++) {
+                if (aabb.testCollision(mSortedAABBs[j])) {
+                    outOverlappingProxies.add(Pair<int32, int32>(proxyId, mSortedProxies[j]));
+                }
+            }
+            nbVisitedEntries += j - index;
+
+            // Test the previous proxies whose interval can contain the start of the interval of the proxy
+            const decimal lowestCoordinate = minCoordinate - mMaxExtent;
+            for (j = index; j > 0 && mSortedMins[j - 1] >= lowestCoordinate; j--) {
+                if (aabb.testCollision(mSortedAABBs[j - 1])) {
+                    outOverlappingProxies.add(Pair<int32, int32>(proxyId, mSortedProxies[j - 1]));
+                }
+            }
+            nbVisitedEntries += index - j;
+        }
+
+        if (i == nbProxiesToTest) return;
+
+        // Remove the pairs found so far before the full sweep
+        while (outOverlappingProxies.size() > initialNbOverlappingProxies) {
+            outOverlappingProxies.removeAt(outOverlappingProxies.size() - 1);
+        }
+    }
+
+    // Full sweep: each pair is reported once by the proxy with the smallest minimum coordinate
+    for (uint32 i=0; i < nbProxiesToTest; i++) {
+        mIsProxyToTest[proxiesToTest[i]] = true;
+    }
+
+    for (uint32 i=0; i < nbSortedProxies; i++) {
+
+        const int32 proxyId = mSortedProxies[i];
+        const bool isProxyToTest = mIsProxyToTest[proxyId];
+        const AABB& aabb = mSortedAABBs[i];
+        const decimal maxCoordinate = aabb.getMax()[mAxis];
+
+        for (uint32 j = i + 1; j < nbSortedProxies && mSortedMins[j] <= maxCoordinate; j++) {
+            if ((isProxyToTest || mIsProxyToTest[mSortedProxies[j]]) && aabb.testCollision(mSortedAABBs[j])) {
+                outOverlappingProxies.add(Pair<int32, int32>(proxyId, mSortedProxies[j]));
+            }
+        }
+    }
+
+    for (uint32 i=0; i < nbProxiesToTest; i++) {
+        mIsProxyToTest[proxiesToTest[i]] = false;
+    }
+}
+
+// Report the proxies whose fat AABB overlaps with a given AABB
+void SweepAndPruneBroadPhase::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& outOverlappingProxies) const {
+
+    RP3D_PROFILE("SweepAndPruneBroadPhase::reportAllShapesOverlappingWithAABB()", mProfiler);
+
+    // Find the first proxy whose interval can overlap with the interval of the AABB
+    const decimal lowestCoordinate = aabb.getMin()[mAxis] - mMaxExtent;
+    const decimal maxCoordinate = aabb.getMax()[mAxis];
+    const uint32 nbSortedProxies = static_cast<uint32>(mSortedProxies.size());
+    uint32 i = static_cast<uint32>(std::lower_bound(mSortedMins.begin(), mSortedMins.end(), lowestCoordinate) - mSortedMins.begin());
+
+    for (; i < nbSortedProxies && mSortedMins[i] <= maxCoordinate; i++) {
+        if (aabb.testCollision(mSortedAABBs[i])) {
+            outOverlappingProxies.add(mSortedProxies[i]);
+        }
+    }
+}
+
+// Write the sorted arrays into a world snapshot
+void SweepAndPruneBroadPhase::takeStructureSnapshot(BinaryWriter& writer) const {
+
+    writer.write(mAxis);
+    writer.write(mMaxExtent);
+
+    writer.write(static_cast<uint32>(mSortedProxies.size()));
+    if (mSortedProxies.size() > 0) {
+        writer.writeArray(&mSortedProxies[0], mSortedProxies.size());
+    }
+}
+
+// Restore the sorted arrays from a world snapshot
+/// The fat AABBs of the sorted arrays are copied from the restored proxies.
+bool SweepAndPruneBroadPhase::restoreStructureSnapshot(BinaryReader& reader) {
+
+    const uint32 axis = reader.read<uint32>();
+    const decimal maxExtent = reader.read<decimal>();
+    const uint32 nbSortedProxies = reader.read<uint32>();
+    if (axis > 2 || nbSortedProxies != mNbProxies || !reader.hasRemaining(nbSortedProxies, sizeof(int32))) {
+        return false;
+    }
+
+    mAxis = axis;
+    mMaxExtent = maxExtent;
+
+    mSortedProxies.clear();
+    mSortedMins.clear();
+    mSortedAABBs.clear();
+    mProxyIndices.clear();
+    mIsProxyToTest.clear();
+    for (uint32 i=0; i < mProxies.size(); i++) {
+        mProxyIndices.add(0);
+        mIsProxyToTest.add(false);
+    }
+
+    for (uint32 i=0; i < nbSortedProxies; i++) {
+
+        const int32 proxyId = reader.read<int32>();
+        if (!isProxyUsed(proxyId)) {
+            return false;
+        }
+
+        mSortedProxies.add(proxyId);
+        mSortedAABBs.add(mProxies[proxyId].aabb);
+        mSortedMins.add(mProxies[proxyId].aabb.getMin()[mAxis]);
+        mProxyIndices[proxyId] = i;
+    }
+
+    return true;
+}
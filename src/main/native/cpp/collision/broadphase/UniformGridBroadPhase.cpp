@@ -0,0 +1,328 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/UniformGridBroadPhase.h>
+#include <reactphysics3d/utils/Profiler.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
+#include <cmath>
+
+using namespace reactphysics3d;
+
+// Constructor
+UniformGridBroadPhase::UniformGridBroadPhase(MemoryAllocator& allocator, decimal fatAABBInflatePercentage, decimal cellSize)
+                      : BroadPhaseBackend(allocator, fatAABBInflatePercentage), mCellSize(cellSize),
+                        mInverseCellSize(decimal(1.0) / cellSize), mCells(allocator), mEntries(allocator), mFreeEntry(-1),
+                        mProxyCellRanges(allocator), mLargeProxies(allocator) {
+
+    assert(cellSize > decimal(0.0));
+}
+
+// Compute the range of cells overlapped by an AABB
+UniformGridBroadPhase::CellRange UniformGridBroadPhase::computeCellRange(const AABB& aabb) const {
+
+    CellRange range;
+    for (int i=0; i < 3; i++) {
+        const decimal min = std::floor(aabb.getMin()[i] * mInverseCellSize);
+        const decimal max = std::floor(aabb.getMax()[i] * mInverseCellSize);
+        range.min[i] = static_cast<int32>(clamp(min, decimal(-MAX_CELL_COORDINATE), decimal(MAX_CELL_COORDINATE)));
+        range.max[i] = static_cast<int32>(clamp(max, decimal(-MAX_CELL_COORDINATE), decimal(MAX_CELL_COORDINATE)));
+    }
+    range.isLarge = computeNbCells(range) > MAX_NB_CELLS_PER_PROXY;
+
+    return range;
+}
+
+// Add a proxy into the cells of its range
+void UniformGridBroadPhase::addProxyToCells(int32 proxyId) {
+
+    const CellRange& range = mProxyCellRanges[proxyId];
+
+    if (range.isLarge) {
+        mLargeProxies.add(proxyId);
+        return;
+    }
+
+    for (int32 x=range.min[0]; x <= range.max[0]; x++) {
+        for (int32 y=range.min[1]; y <= range.max[1]; y++) {
+            for (int32 z=range.min[2]; z <= range.max[2]; z++) {
+
+                // Get a free entry
+                int32 entry;
+                if (mFreeEntry != -1) {
+                    entry = mFreeEntry;
+                    mFreeEntry = mEntries[entry].nextEntry;
+                }
+                else {
+                    entry = static_cast<int32>(mEntries.size());
+                    mEntries.add(CellEntry());
+                }
+
+                // Add the entry at the beginning of the list of the cell
+                const uint64 key = computeCellKey(x, y, z);
+                auto it = mCells.find(key);
+                mEntries[entry].proxyId = proxyId;
+                mEntries[entry].nextEntry = it != mCells.end() ? it->second : -1;
+                mCells.add(Pair<uint64, int32>(key, entry), true);
+            }
+        }
+    }
+}
+
+// Remove a proxy from the cells of its range
+void UniformGridBroadPhase::removeProxyFromCells(int32 proxyId) {
+
+    const CellRange& range = mProxyCellRanges[proxyId];
+
+    if (range.isLarge) {
+        for (uint32 i=0; i < mLargeProxies.size(); i++) {
+            if (mLargeProxies[i] == proxyId) {
+                mLargeProxies.removeAtAndReplaceByLast(i);
+                break;
+            }
+        }
+        return;
+    }
+
+    for (int32 x=range.min[0]; x <= range.max[0]; x++) {
+        for (int32 y=range.min[1]; y <= range.max[1]; y++) {
+            for (int32 z=range.min[2]; z <= range.max[2]; z++) {
+
+                const uint64 key = computeCellKey(x, y, z);
+                int32& firstEntry = mCells[key];
+
+                // Find the entry of the proxy in the list of the cell
+                int32 previousEntry = -1;
+                int32 entry = firstEntry;
+                while (mEntries[entry].proxyId != proxyId) {
+                    previousEntry = entry;
+                    entry = mEntries[entry].nextEntry;
+                    assert(entry != -1);
+                }
+
+                // Remove the entry from the list
+                if (previousEntry == -1) {
+                    firstEntry = mEntries[entry].nextEntry;
+                }
+                else {
+                    mEntries[previousEntry].nextEntry = mEntries[entry].nextEntry;
+                }
+                mEntries[entry].nextEntry = mFreeEntry;
+                mFreeEntry = entry;
+
+                // Remove the cell if it is now empty
+                if (firstEntry == -1) {
+                    mCells.remove(key);
+                }
+            }
+        }
+    }
+}
+
+// Add a new proxy into the grid
+void UniformGridBroadPhase::insertProxy(int32 proxyId) {
+
+    while (mProxyCellRanges.size() <= static_cast<uint64>(proxyId)) {
+        mProxyCellRanges.add(CellRange());
+    }
+
+    mProxyCellRanges[proxyId] = computeCellRange(mProxies[proxyId].aabb);
+    addProxyToCells(proxyId);
+}
+
+// Remove a proxy from the grid
+void UniformGridBroadPhase::removeProxy(int32 proxyId) {
+    removeProxyFromCells(proxyId);
+}
+
+// Update the cells of a proxy that has moved
+/// Nothing is done if the new fat AABB overlaps with the same cells.
+void UniformGridBroadPhase::moveProxy(int32 proxyId) {
+
+    const CellRange range = computeCellRange(mProxies[proxyId].aabb);
+    if (range == mProxyCellRanges[proxyId]) return;
+
+    removeProxyFromCells(proxyId);
+    mProxyCellRanges[proxyId] = range;
+    addProxyToCells(proxyId);
+}
+
+// Report the pairs of proxies whose fat AABBs overlap with the fat AABB of some proxies to test
+void UniformGridBroadPhase::reportAllShapesOverlappingWithShapes(const Array<int32>& proxiesToTest,
+                                                                 Array<Pair<int32, int32>>& outOverlappingProxies) {
+
+    RP3D_PROFILE("UniformGridBroadPhase::reportAllShapesOverlappingWithShapes()", mProfiler);
+
+    const uint32 nbProxiesToTest = static_cast<uint32>(proxiesToTest.size());
+    const int32 nbProxies = static_cast<int32>(mProxies.size());
+    for (uint32 i=0; i < nbProxiesToTest; i++) {
+
+        const int32 proxyId = proxiesToTest[i];
+        const AABB& aabb = mProxies[proxyId].aabb;
+        const CellRange& range = mProxyCellRanges[proxyId];
+
+        // A large proxy is tested against all the other proxies
+        if (range.isLarge) {
+            for (int32 j=0; j < nbProxies; j++) {
+                if (j != proxyId && mProxies[j].collider != nullptr && aabb.testCollision(mProxies[j].aabb)) {
+                    outOverlappingProxies.add(Pair<int32, int32>(proxyId, j));
+                }
+            }
+            continue;
+        }
+
+        // Test the proxies that share a cell with the proxy
+        auto testProxy = [&](int32 otherProxyId) {
+            if (otherProxyId != proxyId && aabb.testCollision(mProxies[otherProxyId].aabb)) {
+                outOverlappingProxies.add(Pair<int32, int32>(proxyId, otherProxyId));
+            }
+        };
+        reportProxiesInCells(range, testProxy);
+
+        // Test the large proxies
+        for (uint32 j=0; j < mLargeProxies.size(); j++) {
+            if (aabb.testCollision(mProxies[mLargeProxies[j]].aabb)) {
+                outOverlappingProxies.add(Pair<int32, int32>(proxyId, mLargeProxies[j]));
+            }
+        }
+    }
+}
+
+// Report the proxies whose fat AABB overlaps with a given AABB
+/// If the AABB overlaps with more cells than the number of proxies, all the proxies are tested.
+void UniformGridBroadPhase::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& outOverlappingProxies) const {
+
+    RP3D_PROFILE("UniformGridBroadPhase::reportAllShapesOverlappingWithAABB()", mProfiler);
+
+    const CellRange range = computeCellRange(aabb);
+
+    if (computeNbCells(range) > std::max(static_cast<uint64>(mNbProxies), MAX_NB_CELLS_PER_PROXY)) {
+
+        const int32 nbProxies = static_cast<int32>(mProxies.size());
+        for (int32 i=0; i < nbProxies; i++) {
+            if (mProxies[i].collider != nullptr && aabb.testCollision(mProxies[i].aabb)) {
+                outOverlappingProxies.add(i);
+            }
+        }
+        return;
+    }
+
+    auto testProxy = [&](int32 proxyId) {
+        if (aabb.testCollision(mProxies[proxyId].aabb)) {
+            outOverlappingProxies.add(proxyId);
+        }
+    };
+    reportProxiesInCells(range, testProxy);
+
+    for (uint32 i=0; i < mLargeProxies.size(); i++) {
+        testProxy(mLargeProxies[i]);
+    }
+}
+
+// Write the grid into a world snapshot
+void UniformGridBroadPhase::takeStructureSnapshot(BinaryWriter& writer) const {
+
+    writer.write(mCellSize);
+    writer.write(mFreeEntry);
+
+    writer.write(static_cast<uint32>(mEntries.size()));
+    if (mEntries.size() > 0) {
+        writer.writeBytes(&mEntries[0], mEntries.size() * sizeof(CellEntry));
+    }
+
+    writer.write(static_cast<uint32>(mProxyCellRanges.size()));
+    if (mProxyCellRanges.size() > 0) {
+        writer.writeBytes(&mProxyCellRanges[0], mProxyCellRanges.size() * sizeof(CellRange));
+    }
+
+    writer.write(static_cast<uint32>(mLargeProxies.size()));
+    if (mLargeProxies.size() > 0) {
+        writer.writeArray(&mLargeProxies[0], mLargeProxies.size());
+    }
+
+    writer.write(static_cast<uint32>(mCells.size()));
+    for (auto it = mCells.begin(); it != mCells.end(); ++it) {
+        writer.write(it->first);
+        writer.write(it->second);
+    }
+}
+
+// Restore the grid from a world snapshot
+/// The size of the cells must be the same as in the snapshot.
+bool UniformGridBroadPhase::restoreStructureSnapshot(BinaryReader& reader) {
+
+    const decimal cellSize = reader.read<decimal>();
+    const int32 freeEntry = reader.read<int32>();
+    const uint32 nbEntries = reader.read<uint32>();
+    if (cellSize != mCellSize || freeEntry < -1 || freeEntry >= static_cast<int32>(nbEntries) ||
+        !reader.hasRemaining(nbEntries, sizeof(CellEntry))) {
+        return false;
+    }
+
+    mFreeEntry = freeEntry;
+    mEntries.clear();
+    mEntries.addWithoutInit(nbEntries);
+    if (nbEntries > 0) {
+        reader.readBytes(&mEntries[0], nbEntries * sizeof(CellEntry));
+    }
+
+    const uint32 nbCellRanges = reader.read<uint32>();
+    if (nbCellRanges != mProxies.size() || !reader.hasRemaining(nbCellRanges, sizeof(CellRange))) {
+        return false;
+    }
+
+    mProxyCellRanges.clear();
+    mProxyCellRanges.addWithoutInit(nbCellRanges);
+    if (nbCellRanges > 0) {
+        reader.readBytes(&mProxyCellRanges[0], nbCellRanges * sizeof(CellRange));
+    }
+
+    const uint32 nbLargeProxies = reader.read<uint32>();
+    if (!reader.hasRemaining(nbLargeProxies, sizeof(int32))) {
+        return false;
+    }
+
+    mLargeProxies.clear();
+    for (uint32 i=0; i < nbLargeProxies; i++) {
+        mLargeProxies.add(reader.read<int32>());
+    }
+
+    const uint32 nbCells = reader.read<uint32>();
+    if (!reader.hasRemaining(nbCells, sizeof(uint64) + sizeof(int32))) {
+        return false;
+    }
+
+    mCells.clear();
+    for (uint32 i=0; i < nbCells; i++) {
+        const uint64 key = reader.read<uint64>();
+        const int32 firstEntry = reader.read<int32>();
+        if (firstEntry < 0 || firstEntry >= static_cast<int32>(nbEntries)) {
+            return false;
+        }
+        mCells.add(Pair<uint64, int32>(key, firstEntry));
+    }
+
+    return true;
+}
@@ -236,3 +236,177 @@ void GJKAlgorithm::testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uin
         gjkResults.add(GJKResult::INTERPENETRATE);
     }
 }
+
+// Compute the distance and the closest points between two convex shapes
+/// The GJK algorithm is run on the original objects (without margin) and the closest points
+/// are then projected on the margins. This method returns false if the two shapes interpenetrate
+/// (even without their margins). In this case, the distance and closest points are not computed.
+/// If the two shapes only overlap in their margins, the returned distance is zero.
+/**
+ * @param shape1 Pointer to the first convex shape
+ * @param shape1ToWorldTransform Local-to-world transform of the first shape
+ * @param shape2 Pointer to the second convex shape
+ * @param shape2ToWorldTransform Local-to-world transform of the second shape
+ * @param[out] outDistance Distance between the two shapes
+ * @param[out] outPoint1 Closest point of the first shape in world-space
+ * @param[out] outPoint2 Closest point of the second shape in world-space
+ * @param[out] outNormal Unit direction from the first shape to the second one in world-space
+ * @return False if the two shapes interpenetrate and true otherwise
+ */
+bool GJKAlgorithm::computeClosestPoints(const ConvexShape* shape1, const Transform& shape1ToWorldTransform,
+                                        const ConvexShape* shape2, const Transform& shape2ToWorldTransform,
+                                        decimal& outDistance, Vector3& outPoint1, Vector3& outPoint2, Vector3& outNormal) const {
+
+    RP3D_PROFILE("GJKAlgorithm::computeClosestPoints()", mProfiler);
+
+    // The GJK algorithm is done in local space of shape 1
+    const Transform shape2ToShape1 = shape1ToWorldTransform.getInverse() * shape2ToWorldTransform;
+    const Quaternion rotateToShape2 = shape2ToWorldTransform.getOrientation().getInverse() * shape1ToWorldTransform.getOrientation();
+
+    VoronoiSimplex simplex;
+
+    // Start with the direction between the two shapes
+    Vector3 v = -shape2ToShape1.getPosition();
+    if (v.lengthSquare() < MACHINE_EPSILON) {
+        v.setAllValues(0, 1, 0);
+    }
+
+    decimal distSquare = DECIMAL_LARGEST;
+    bool isSeparated = false;
+
+    for (int i=0; i < MAX_ITERATIONS_GJK_DISTANCE; i++) {
+
+        // Compute the support points for original objects (without margins) A and B
+        const Vector3 suppA = shape1->getLocalSupportPointWithoutMargin(-v);
+        const Vector3 suppB = shape2ToShape1 * shape2->getLocalSupportPointWithoutMargin(rotateToShape2 * v);
+
+        // Compute the support point for the Minkowski difference A-B
+        const Vector3 w = suppA - suppB;
+        const decimal vDotw = v.dot(w);
+
+        // If the distance does not improve anymore, we have found the closest points
+        if (simplex.isPointInSimplex(w) || distSquare - vDotw <= distSquare * REL_ERROR_SQUARE) {
+            isSeparated = true;
+            break;
+        }
+
+        // Add the new support point to the simplex
+        simplex.addPoint(w, suppA, suppB);
+
+        if (simplex.isAffinelyDependent() || !simplex.computeClosestPoint(v)) {
+            isSeparated = true;
+            break;
+        }
+
+        // Store and update the squared distance of the closest point
+        const decimal prevDistSquare = distSquare;
+        distSquare = v.lengthSquare();
+
+        // If the distance to the closest point doesn't improve a lot
+        if (prevDistSquare - distSquare <= MACHINE_EPSILON * prevDistSquare) {
+            simplex.backupClosestPointInSimplex(v);
+            distSquare = v.lengthSquare();
+            isSeparated = true;
+            break;
+        }
+
+        // If the origin is inside the simplex, the shapes interpenetrate
+        if (simplex.isFull() || distSquare <= MACHINE_EPSILON * simplex.getMaxLengthSquareOfAPoint()) {
+            break;
+        }
+    }
+
+    if (!isSeparated || distSquare <= MACHINE_EPSILON) {
+        return false;
+    }
+
+    // Compute the closest points of both objects (without the margins)
+    Vector3 pA;
+    Vector3 pB;
+    simplex.computeClosestPointsOfAandB(pA, pB);
+
+    // Project those two points on the margins to have the closest points of both objects with the margins
+    const decimal dist = std::sqrt(distSquare);
+    pA = pA - (shape1->getMargin() / dist) * v;
+    pB = pB + (shape2->getMargin() / dist) * v;
+
+    outDistance = std::max(dist - shape1->getMargin() - shape2->getMargin(), decimal(0.0));
+    outPoint1 = shape1ToWorldTransform * pA;
+    outPoint2 = shape1ToWorldTransform * pB;
+    outNormal = shape1ToWorldTransform.getOrientation() * (-v / dist);
+
+    return true;
+}
+
+// Compute the time of impact of a convex shape moving along a translation with another convex shape
+/// This method uses conservative advancement: the distance between the two shapes is computed with GJK
+/// and the first shape is moved along its translation by the largest step that cannot make it go
+/// through the second shape. The shape stops at a distance smaller than GJK_TIME_OF_IMPACT_TOLERANCE
+/// from the second one. If the two shapes already overlap at the start, a hit with a zero fraction and
+/// a zero normal is reported.
+/**
+ * @param shape1 Pointer to the moving convex shape
+ * @param shape1ToWorldTransform Local-to-world transform of the moving shape at the start
+ * @param translation1 Translation of the moving shape in world-space
+ * @param shape2 Pointer to the static convex shape
+ * @param shape2ToWorldTransform Local-to-world transform of the static shape
+ * @param maxFraction Maximum fraction of the translation to test
+ * @param[out] outHitFraction Fraction of the translation where the shapes touch
+ * @param[out] outWorldPoint Contact point on the second shape in world-space
+ * @param[out] outWorldNormal Surface normal of the second shape at the contact point in world-space
+ * @return True if the moving shape hits the second shape before maxFraction
+ */
+bool GJKAlgorithm::computeTimeOfImpact(const ConvexShape* shape1, const Transform& shape1ToWorldTransform, const Vector3& translation1,
+                                       const ConvexShape* shape2, const Transform& shape2ToWorldTransform, decimal maxFraction,
+                                       decimal& outHitFraction, Vector3& outWorldPoint, Vector3& outWorldNormal) const {
+
+    RP3D_PROFILE("GJKAlgorithm::computeTimeOfImpact()", mProfiler);
+
+    Transform transform1 = shape1ToWorldTransform;
+    decimal fraction = decimal(0.0);
+
+    for (int i=0; i < MAX_ITERATIONS_GJK_TIME_OF_IMPACT; i++) {
+
+        transform1.setPosition(shape1ToWorldTransform.getPosition() + fraction * translation1);
+
+        decimal distance;
+        Vector3 point1;
+        Vector3 point2;
+        Vector3 normal;
+        if (!computeClosestPoints(shape1, transform1, shape2, shape2ToWorldTransform, distance, point1, point2, normal)) {
+
+            // The shapes overlap at the start of the translation or we have slightly gone through the
+            // second shape because of numerical errors
+            outHitFraction = fraction;
+            outWorldPoint = transform1.getPosition();
+            outWorldNormal = fraction == decimal(0.0) ? Vector3::zero() : -translation1.getUnit();
+            return true;
+        }
+
+        // If the shapes are close enough, we have found the time of impact
+        if (distance <= GJK_TIME_OF_IMPACT_TOLERANCE) {
+            outHitFraction = fraction;
+            outWorldPoint = point2;
+            outWorldNormal = -normal;
+            return true;
+        }
+
+        // Compute the speed at which the moving shape gets closer to the other one
+        const decimal approachSpeed = translation1.dot(normal);
+        if (approachSpeed <= MACHINE_EPSILON) {
+            return false;
+        }
+
+        // Move the shape as far as possible while staying outside of the other shape
+        fraction += (distance - decimal(0.5) * GJK_TIME_OF_IMPACT_TOLERANCE) / approachSpeed;
+        if (fraction > maxFraction) {
+            return false;
+        }
+    }
+
+    // The advancement has not converged but the shape can safely move up to the current fraction
+    outHitFraction = fraction;
+    outWorldPoint = shape1ToWorldTransform.getPosition() + fraction * translation1;
+    outWorldNormal = -translation1.getUnit();
+    return true;
+}
@@ -26,15 +26,11 @@
 // Libraries
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
 #include <reactphysics3d/collision/ContactPointInfo.h>
-#include <reactphysics3d/collision/shapes/TriangleShape.h>
 #include <reactphysics3d/engine/OverlappingPairs.h>
 #include <iostream>
 
 using namespace reactphysics3d;
 
-// TriangleShape allocated size
-const size_t NarrowPhaseInfoBatch::mTriangleShapeAllocatedSize = std::ceil(sizeof(TriangleShape) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
-
 // Constructor
 NarrowPhaseInfoBatch::NarrowPhaseInfoBatch(OverlappingPairs& overlappingPairs, MemoryAllocator& allocator)
                      : mMemoryAllocator(allocator), mOverlappingPairs(overlappingPairs), narrowPhaseInfos(allocator){
@@ -55,24 +51,15 @@ void NarrowPhaseInfoBatch::reserveMemory() {
 // Clear all the objects in the batch
 void NarrowPhaseInfoBatch::clear() {
 
+#ifndef NDEBUG
     const uint32 nbNarrowPhaseInfos = static_cast<uint32>(narrowPhaseInfos.size());
     for (uint32 i=0; i < nbNarrowPhaseInfos; i++) {
-
         assert(narrowPhaseInfos[i].nbContactPoints == 0);
-
-        // TODO OPTI : Better manage this
-
-        // Release the memory of the TriangleShape (this memory was allocated in the
-        // MiddlePhaseTriangleCallback::testTriangle() method)
-        if (narrowPhaseInfos[i].collisionShape1->getName() == CollisionShapeName::TRIANGLE) {
-            narrowPhaseInfos[i].collisionShape1->~CollisionShape();
-            narrowPhaseInfos[i].collisionShapeAllocator->release(narrowPhaseInfos[i].collisionShape1, mTriangleShapeAllocatedSize);
-        }
-        if (narrowPhaseInfos[i].collisionShape2->getName() == CollisionShapeName::TRIANGLE) {
-            narrowPhaseInfos[i].collisionShape2->~CollisionShape();
-            narrowPhaseInfos[i].collisionShapeAllocator->release(narrowPhaseInfos[i].collisionShape2, mTriangleShapeAllocatedSize);
-        }
     }
+#endif
+
+    // Note that the TriangleShape objects of concave shapes are owned by the
+    // TriangleShapeBatch of the NarrowPhaseInput and are not released here
 
     // Note that we clear the following containers and we release their allocated memory. Therefore,
     // if the memory allocator is a single frame allocator, the memory is deallocated and will be
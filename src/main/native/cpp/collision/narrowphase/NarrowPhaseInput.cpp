@@ -29,11 +29,13 @@
 using namespace reactphysics3d;
 
 /// Constructor
-NarrowPhaseInput::NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs& overlappingPairs)
+NarrowPhaseInput::NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs& overlappingPairs, MemoryAllocator& triangleAllocator,
+                                   HalfEdgeStructure& triangleHalfEdgeStructure)
     :mSphereVsSphereBatch(overlappingPairs, allocator), mSphereVsCapsuleBatch(overlappingPairs, allocator),
      mCapsuleVsCapsuleBatch(overlappingPairs, allocator), mSphereVsConvexPolyhedronBatch(overlappingPairs, allocator),
      mCapsuleVsConvexPolyhedronBatch(overlappingPairs, allocator),
-     mConvexPolyhedronVsConvexPolyhedronBatch(overlappingPairs, allocator) {
+     mConvexPolyhedronVsConvexPolyhedronBatch(overlappingPairs, allocator),
+     mTriangleShapeBatch(triangleAllocator, triangleHalfEdgeStructure) {
 
 }
 
@@ -57,4 +59,7 @@ void NarrowPhaseInput::clear() {
     mSphereVsConvexPolyhedronBatch.clear();
     mCapsuleVsConvexPolyhedronBatch.clear();
     mConvexPolyhedronVsConvexPolyhedronBatch.clear();
+
+    // The triangle shapes are kept to be reused in the next frame
+    mTriangleShapeBatch.clear();
 }
@@ -0,0 +1,99 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/collision/narrowphase/TriangleShapeBatch.h>
+#include <reactphysics3d/collision/shapes/TriangleShape.h>
+#include <reactphysics3d/memory/MemoryAllocator.h>
+#include <cmath>
+
+using namespace reactphysics3d;
+
+// Number of triangle shapes in each allocated block
+const uint32 TriangleShapeBatch::NB_TRIANGLES_PER_BLOCK = 64;
+
+// TriangleShape allocated size
+const size_t TriangleShapeBatch::mTriangleShapeAllocatedSize = std::ceil(sizeof(TriangleShape) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
+
+// Constructor
+TriangleShapeBatch::TriangleShapeBatch(MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure)
+                   : mAllocator(allocator), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure), mBlocks(allocator),
+                     mTriangleShapes(allocator), mNbTriangleShapes(0), triangleVertices(allocator, 64),
+                     triangleVerticesNormals(allocator, 64), triangleShapeIds(allocator, 64) {
+
+}
+
+// Destructor
+TriangleShapeBatch::~TriangleShapeBatch() {
+
+    // Destroy the triangle shapes
+    const uint32 nbTriangleShapes = static_cast<uint32>(mTriangleShapes.size());
+    for (uint32 i=0; i < nbTriangleShapes; i++) {
+        mTriangleShapes[i]->~TriangleShape();
+    }
+
+    // Release the blocks of triangle shapes
+    const uint32 nbBlocks = static_cast<uint32>(mBlocks.size());
+    for (uint32 i=0; i < nbBlocks; i++) {
+        mAllocator.release(mBlocks[i], NB_TRIANGLES_PER_BLOCK * mTriangleShapeAllocatedSize);
+    }
+}
+
+// Return a triangle shape for the triangle at a given index of the triangles arrays
+// The returned triangle shape is owned by the batch and remains valid until the next call
+// to clear(). The vertices and normals are copied into the shape so the triangles arrays
+// can be cleared and refilled before the narrow-phase runs.
+TriangleShape* TriangleShapeBatch::createTriangleShape(uint32 triangleIndex) {
+
+    assert(triangleIndex < triangleShapeIds.size());
+
+    const Vector3* vertices = &(triangleVertices[triangleIndex * 3]);
+    const Vector3* verticesNormals = &(triangleVerticesNormals[triangleIndex * 3]);
+    const uint32 shapeId = triangleShapeIds[triangleIndex];
+
+    // If a triangle shape has already been constructed at this position, we reuse it
+    if (mNbTriangleShapes < mTriangleShapes.size()) {
+
+        TriangleShape* triangleShape = mTriangleShapes[mNbTriangleShapes];
+        triangleShape->setTriangle(vertices, verticesNormals, shapeId);
+        mNbTriangleShapes++;
+
+        return triangleShape;
+    }
+
+    // If all the blocks are full, we allocate a new one
+    const uint32 indexInBlock = mNbTriangleShapes % NB_TRIANGLES_PER_BLOCK;
+    if (indexInBlock == 0) {
+        mBlocks.add(mAllocator.allocate(NB_TRIANGLES_PER_BLOCK * mTriangleShapeAllocatedSize));
+    }
+
+    unsigned char* block = static_cast<unsigned char*>(mBlocks[mBlocks.size() - 1]);
+    TriangleShape* triangleShape = new (block + indexInBlock * mTriangleShapeAllocatedSize)
+                                   TriangleShape(vertices, verticesNormals, shapeId, mTriangleHalfEdgeStructure, mAllocator);
+    mTriangleShapes.add(triangleShape);
+    mNbTriangleShapes++;
+
+    return triangleShape;
+}
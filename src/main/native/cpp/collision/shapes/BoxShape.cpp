@@ -123,6 +123,42 @@ bool BoxShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* colli
     return true;
 }
 
+// Return true if a ray hits the box (without computing the hit point and normal)
+bool BoxShape::testRayHit(const Ray& ray, Collider* /*collider*/, MemoryAllocator& /*allocator*/) const {
+
+    const Vector3 rayDirection = ray.point2 - ray.point1;
+    decimal tMin = DECIMAL_SMALLEST;
+    decimal tMax = DECIMAL_LARGEST;
+
+    // For each of the three slabs
+    for (int i=0; i<3; i++) {
+
+        // If ray is parallel to the slab
+        if (std::abs(rayDirection[i]) < MACHINE_EPSILON) {
+
+            // If the ray's origin is not inside the slab, there is no hit
+            if (ray.point1[i] > mHalfExtents[i] || ray.point1[i] < -mHalfExtents[i]) return false;
+        }
+        else {
+
+            // Compute the intersection of the ray with the near and far plane of the slab
+            const decimal oneOverD = decimal(1.0) / rayDirection[i];
+            decimal t1 = (-mHalfExtents[i] - ray.point1[i]) * oneOverD;
+            decimal t2 = (mHalfExtents[i] - ray.point1[i]) * oneOverD;
+            if (t1 > t2) std::swap(t1, t2);
+
+            tMin = std::max(tMin, t1);
+            tMax = std::min(tMax, t2);
+
+            // If the slabs intersection is empty or beyond the maximum fraction, there is no hit
+            if (tMin > ray.maxFraction || tMin > tMax) return false;
+        }
+    }
+
+    // If tMin is negative (origin inside the box), we return no hit (as raycast())
+    return tMin >= decimal(0.0) && tMin <= ray.maxFraction;
+}
+
 // Return a given face of the polyhedron
 const HalfEdgeStructure::Face& BoxShape::getFace(uint32 faceIndex) const {
     assert(faceIndex < mPhysicsCommon.mBoxShapeHalfEdgeStructure.getNbFaces());
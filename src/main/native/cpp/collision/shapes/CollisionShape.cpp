@@ -28,6 +28,7 @@
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/body/Body.h>
 #include <reactphysics3d/collision/Collider.h>
+#include <reactphysics3d/collision/RaycastInfo.h>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
@@ -92,6 +93,14 @@ AABB CollisionShape::computeTransformedAABB(const Transform& transform) const {
     return aabb;
 }
 
+// Return true if a ray hits the shape (without computing the hit point and normal)
+/// The ray is in the local-space of the shape. This default implementation uses the raycast() method.
+/// A shape can override it with a cheaper test.
+bool CollisionShape::testRayHit(const Ray& ray, Collider* collider, MemoryAllocator& allocator) const {
+    RaycastInfo raycastInfo;
+    return raycast(ray, raycastInfo, collider, allocator);
+}
+
 /// Notify all the assign colliders that the size of the collision shape has changed
 void CollisionShape::notifyColliderAboutChangedSize() {
 
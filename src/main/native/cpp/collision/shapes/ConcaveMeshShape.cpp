@@ -206,48 +206,95 @@ bool ConcaveMeshShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collide
     return raycastCallback.getIsHit();
 }
 
+// Return true if a ray hits the shape (without computing the hit point and normal)
+/// The traversal of the triangles tree stops at the first triangle hit by the ray.
+bool ConcaveMeshShape::testRayHit(const Ray& ray, Collider* collider, MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("ConcaveMeshShape::testRayHit()", mProfiler);
+
+    // Apply the concave mesh inverse scale factor because the mesh is stored without scaling
+    // inside the dynamic AABB tree
+    const Vector3 inverseScale(decimal(1.0) / mScale.x, decimal(1.0) / mScale.y, decimal(1.0) / mScale.z);
+    Ray scaledRay(ray.point1 * inverseScale, ray.point2 * inverseScale, ray.maxFraction);
+
+    RaycastInfo raycastInfo;
+    ConcaveMeshRaycastCallback raycastCallback(*this, collider, raycastInfo, ray, allocator);
+    raycastCallback.setIsAnyHitQuery(true);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+	// Set the profiler
+	raycastCallback.setProfiler(mProfiler);
+
+#endif
+
+    mTriangleMesh->raycast(scaledRay, raycastCallback);
+
+    return raycastCallback.getIsHit();
+}
+
 // Collect all the AABB nodes that are hit by the ray in the Dynamic AABB Tree
 decimal ConcaveMeshRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
 
+    // For an any-hit query, the triangle is tested right away and the traversal
+    // of the tree stops (returned fraction of zero) at the first hit
+    if (mIsAnyHitQuery) {
+
+        RaycastInfo raycastInfo;
+        if (raycastTriangle(nodeId, raycastInfo)) {
+            mIsHit = true;
+            return decimal(0.0);
+        }
+
+        return ray.maxFraction;
+    }
+
     // Add the id of the hit AABB node into
     mHitAABBNodes.add(nodeId);
 
     return ray.maxFraction;
 }
 
-// Raycast all collision shapes that have been collected
-void ConcaveMeshRaycastCallback::raycastTriangles() {
+// Raycast the triangle of a given node of the Dynamic AABB Tree
+bool ConcaveMeshRaycastCallback::raycastTriangle(int32 nodeId, RaycastInfo& raycastInfo) const {
 
-    Array<int>::Iterator it;
-    decimal smallestHitFraction = mRay.maxFraction;
+    // Get the node data (triangle index and mesh subpart index)
+    int32 data = mConcaveMeshShape.getDynamicAABBTreeNodeDataInt(nodeId);
 
-    for (it = mHitAABBNodes.begin(); it != mHitAABBNodes.end(); ++it) {
+    // Get the triangle vertices for this node from the concave mesh shape
+    Vector3 trianglePoints[3];
+    mConcaveMeshShape.getTriangleVertices(data, trianglePoints[0], trianglePoints[1], trianglePoints[2]);
 
-        // Get the node data (triangle index and mesh subpart index)
-        int32 data = mConcaveMeshShape.getDynamicAABBTreeNodeDataInt(*it);
+    // Get the vertices normals of the triangle
+    Vector3 verticesNormals[3];
+    mConcaveMeshShape.getTriangleVerticesNormals(data, verticesNormals[0], verticesNormals[1], verticesNormals[2]);
 
-        // Get the triangle vertices for this node from the concave mesh shape
-        Vector3 trianglePoints[3];
-        mConcaveMeshShape.getTriangleVertices(data, trianglePoints[0], trianglePoints[1], trianglePoints[2]);
+    // Create a triangle collision shape
+    TriangleShape triangleShape(trianglePoints, verticesNormals, mConcaveMeshShape.computeTriangleShapeId(data), mConcaveMeshShape.mTriangleHalfEdgeStructure, mAllocator);
+    triangleShape.setRaycastTestType(mConcaveMeshShape.getRaycastTestType());
 
-        // Get the vertices normals of the triangle
-        Vector3 verticesNormals[3];
-        mConcaveMeshShape.getTriangleVerticesNormals(data, verticesNormals[0], verticesNormals[1], verticesNormals[2]);
-
-        // Create a triangle collision shape
-        TriangleShape triangleShape(trianglePoints, verticesNormals, mConcaveMeshShape.computeTriangleShapeId(data), mConcaveMeshShape.mTriangleHalfEdgeStructure, mAllocator);
-        triangleShape.setRaycastTestType(mConcaveMeshShape.getRaycastTestType());
-		
 #ifdef IS_RP3D_PROFILING_ENABLED
 
-		// Set the profiler to the triangle shape
-		triangleShape.setProfiler(mProfiler);
+    // Set the profiler to the triangle shape
+    triangleShape.setProfiler(mProfiler);
 
 #endif
 
-        // Ray casting test against the collision shape
+    // Ray casting test against the collision shape
+    return triangleShape.raycast(mRay, raycastInfo, mCollider, mAllocator);
+}
+
+// Raycast all collision shapes that have been collected
+void ConcaveMeshRaycastCallback::raycastTriangles() {
+
+    Array<int>::Iterator it;
+    decimal smallestHitFraction = mRay.maxFraction;
+
+    for (it = mHitAABBNodes.begin(); it != mHitAABBNodes.end(); ++it) {
+
+        // Ray casting test against the triangle of the node
         RaycastInfo raycastInfo;
-        bool isTriangleHit = triangleShape.raycast(mRay, raycastInfo, mCollider, mAllocator);
+        bool isTriangleHit = raycastTriangle(*it, raycastInfo);
 
         // If the ray hit the collision shape
         if (isTriangleHit && raycastInfo.hitFraction <= smallestHitFraction) {
@@ -259,7 +306,7 @@ void ConcaveMeshRaycastCallback::raycastTriangles() {
             mRaycastInfo.hitFraction = raycastInfo.hitFraction;
             mRaycastInfo.worldPoint = raycastInfo.worldPoint;
             mRaycastInfo.worldNormal = raycastInfo.worldNormal;
-            mRaycastInfo.triangleIndex = data;
+            mRaycastInfo.triangleIndex = mConcaveMeshShape.getDynamicAABBTreeNodeDataInt(*it);
 
             smallestHitFraction = raycastInfo.hitFraction;
             mIsHit = true;
@@ -102,3 +102,29 @@ bool SphereShape::raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* co
 
     return false;
 }
+
+// Return true if a ray hits the sphere (without computing the hit point and normal)
+bool SphereShape::testRayHit(const Ray& ray, Collider* /*collider*/, MemoryAllocator& /*allocator*/) const {
+
+    const Vector3 m = ray.point1;
+    const decimal c = m.dot(m) - mMargin * mMargin;
+
+    // If the origin of the ray is inside the sphere, we return no intersection (as raycast())
+    if (c < decimal(0.0)) return false;
+
+    const Vector3 rayDirection = ray.point2 - ray.point1;
+    const decimal b = m.dot(rayDirection);
+
+    // If the ray is pointing away from the sphere, there is no intersection
+    if (b > decimal(0.0)) return false;
+
+    const decimal raySquareLength = rayDirection.lengthSquare();
+
+    // Compute the discriminant of the quadratic equation
+    const decimal discriminant = b * b - raySquareLength * c;
+    if (discriminant < decimal(0.0) || raySquareLength < MACHINE_EPSILON) return false;
+
+    // The hit point must be within the ray fraction
+    const decimal t = -b - std::sqrt(discriminant);
+    return t < ray.maxFraction * raySquareLength;
+}
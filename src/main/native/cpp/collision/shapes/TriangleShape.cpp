@@ -40,6 +40,13 @@ using namespace reactphysics3d;
 TriangleShape::TriangleShape(const Vector3* vertices, const Vector3* verticesNormals, uint32 shapeId, HalfEdgeStructure& triangleHalfEdgeStructure, MemoryAllocator& allocator)
     : ConvexPolyhedronShape(CollisionShapeName::TRIANGLE, allocator), mTriangleHalfEdgeStructure(triangleHalfEdgeStructure) {
 
+    setTriangle(vertices, verticesNormals, shapeId);
+}
+
+// Set the vertices, vertices normals and id of the triangle
+// This is used to reuse an already constructed triangle shape for another triangle
+void TriangleShape::setTriangle(const Vector3* vertices, const Vector3* verticesNormals, uint32 shapeId) {
+
     mPoints[0] = vertices[0];
     mPoints[1] = vertices[1];
     mPoints[2] = vertices[2];
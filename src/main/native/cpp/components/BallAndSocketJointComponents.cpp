@@ -297,3 +297,21 @@ void BallAndSocketJointComponents::destroyComponent(uint32 index) {
     mImpulse[index].~Vector3();
     mConeLimitACrossB[index].~Vector3();
 }
+
+// Write the simulation state of the components into a world snapshot
+/// The accumulated impulses (used for warm-starting) are written.
+void BallAndSocketJointComponents::takeStateSnapshot(BinaryWriter& writer) const {
+
+    writeSnapshotArray(writer, mImpulse);
+    writeSnapshotArray(writer, mConeLimitImpulse);
+}
+
+// Restore the simulation state of the components from a world snapshot
+bool BallAndSocketJointComponents::restoreStateSnapshot(BinaryReader& reader) {
+
+    bool isValid = true;
+    isValid &= readSnapshotArray(reader, mImpulse);
+    isValid &= readSnapshotArray(reader, mConeLimitImpulse);
+
+    return isValid;
+}
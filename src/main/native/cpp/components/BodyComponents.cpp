@@ -35,7 +35,7 @@ using namespace reactphysics3d;
 // Constructor
 BodyComponents::BodyComponents(MemoryAllocator& allocator)
                     :Components(allocator, sizeof(Entity) + sizeof(Body*) + sizeof(Array<Entity>) +
-                                sizeof(bool) + sizeof(void*) + sizeof(bool), 6 * GLOBAL_ALIGNMENT) {
+                                sizeof(bool) + sizeof(void*) + sizeof(bool) + sizeof(bool) + sizeof(bool), 8 * GLOBAL_ALIGNMENT) {
 
 }
 
@@ -68,7 +68,11 @@ void BodyComponents::allocate(uint32 nbComponentsToAllocate) {
     assert(reinterpret_cast<uintptr_t>(newUserData) % GLOBAL_ALIGNMENT == 0);
     bool* newHasSimulationCollider = reinterpret_cast<bool*>(MemoryAllocator::alignAddress(newUserData + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newHasSimulationCollider) % GLOBAL_ALIGNMENT == 0);
-    assert(reinterpret_cast<uintptr_t>(newHasSimulationCollider + nbComponentsToAllocate) <= reinterpret_cast<uintptr_t>(newBuffer) + totalSizeBytes);
+    bool* newIsContactEventsEnabled = reinterpret_cast<bool*>(MemoryAllocator::alignAddress(newHasSimulationCollider + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
+    assert(reinterpret_cast<uintptr_t>(newIsContactEventsEnabled) % GLOBAL_ALIGNMENT == 0);
+    bool* newIsCompoundBroadPhase = reinterpret_cast<bool*>(MemoryAllocator::alignAddress(newIsContactEventsEnabled + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
+    assert(reinterpret_cast<uintptr_t>(newIsCompoundBroadPhase) % GLOBAL_ALIGNMENT == 0);
+    assert(reinterpret_cast<uintptr_t>(newIsCompoundBroadPhase + nbComponentsToAllocate) <= reinterpret_cast<uintptr_t>(newBuffer) + totalSizeBytes);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -80,6 +84,8 @@ void BodyComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newIsActive, mIsActive, mNbComponents * sizeof(bool));
         memcpy(newUserData, mUserData, mNbComponents * sizeof(void*));
         memcpy(newHasSimulationCollider, mHasSimulationCollider, mNbComponents * sizeof(bool));
+        memcpy(newIsContactEventsEnabled, mIsContactEventsEnabled, mNbComponents * sizeof(bool));
+        memcpy(newIsCompoundBroadPhase, mIsCompoundBroadPhase, mNbComponents * sizeof(bool));
 
         // Deallocate previous memory
         mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
@@ -92,6 +98,8 @@ void BodyComponents::allocate(uint32 nbComponentsToAllocate) {
     mIsActive = newIsActive;
     mUserData = newUserData;
     mHasSimulationCollider = newHasSimulationCollider;
+    mIsContactEventsEnabled = newIsContactEventsEnabled;
+    mIsCompoundBroadPhase = newIsCompoundBroadPhase;
     mNbAllocatedComponents = nbComponentsToAllocate;
 }
 
@@ -108,6 +116,8 @@ void BodyComponents::addComponent(Entity bodyEntity, bool isDisabled, const Body
     mIsActive[index] = true;
     mUserData[index] = nullptr;
     mHasSimulationCollider[index] = false;
+    mIsContactEventsEnabled[index] = false;
+    mIsCompoundBroadPhase[index] = false;
 
     // Map the entity with the new component lookup index
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(bodyEntity, index));
@@ -131,6 +141,8 @@ void BodyComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex) {
     mIsActive[destIndex] = mIsActive[srcIndex];
     mUserData[destIndex] = mUserData[srcIndex];
     mHasSimulationCollider[destIndex] = mHasSimulationCollider[srcIndex];
+    mIsContactEventsEnabled[destIndex] = mIsContactEventsEnabled[srcIndex];
+    mIsCompoundBroadPhase[destIndex] = mIsCompoundBroadPhase[srcIndex];
 
     // Destroy the source component
     destroyComponent(srcIndex);
@@ -153,6 +165,8 @@ void BodyComponents::swapComponents(uint32 index1, uint32 index2) {
     bool isActive1 = mIsActive[index1];
     void* userData1 = mUserData[index1];
     bool hasSimulationCollider = mHasSimulationCollider[index1];
+    bool isContactEventsEnabled = mIsContactEventsEnabled[index1];
+    bool isCompoundBroadPhase = mIsCompoundBroadPhase[index1];
 
     // Destroy component 1
     destroyComponent(index1);
@@ -166,6 +180,8 @@ void BodyComponents::swapComponents(uint32 index1, uint32 index2) {
     mIsActive[index2] = isActive1;
     mUserData[index2] = userData1;
     mHasSimulationCollider[index2] = hasSimulationCollider;
+    mIsContactEventsEnabled[index2] = isContactEventsEnabled;
+    mIsCompoundBroadPhase[index2] = isCompoundBroadPhase;
 
     // Update the entity to component index mapping
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(entity1, index2));
@@ -36,8 +36,8 @@ using namespace reactphysics3d;
 // Constructor
 ColliderComponents::ColliderComponents(MemoryAllocator& allocator)
                     :Components(allocator, sizeof(Entity) + sizeof(Entity) + sizeof(Collider*) + sizeof(int32) +
-                sizeof(Transform) + sizeof(CollisionShape*) + sizeof(unsigned short) +
-                sizeof(unsigned short) + sizeof(Transform) + sizeof(Array<uint64>) + sizeof(bool) +
+                sizeof(Transform) + sizeof(CollisionShape*) + sizeof(uint64) +
+                sizeof(uint64) + sizeof(Transform) + sizeof(Array<uint64>) + sizeof(bool) +
                 sizeof(bool) + sizeof(bool) + sizeof(bool) + sizeof(Material), 15 * GLOBAL_ALIGNMENT) {
 
 }
@@ -70,9 +70,9 @@ void ColliderComponents::allocate(uint32 nbComponentsToAllocate) {
     assert(reinterpret_cast<uintptr_t>(newLocalToBodyTransforms) % GLOBAL_ALIGNMENT == 0);
     CollisionShape** newCollisionShapes = reinterpret_cast<CollisionShape**>(MemoryAllocator::alignAddress(newLocalToBodyTransforms + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newCollisionShapes) % GLOBAL_ALIGNMENT == 0);
-    unsigned short* newCollisionCategoryBits = reinterpret_cast<unsigned short*>(MemoryAllocator::alignAddress(newCollisionShapes + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
+    uint64* newCollisionCategoryBits = reinterpret_cast<uint64*>(MemoryAllocator::alignAddress(newCollisionShapes + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newCollisionCategoryBits) % GLOBAL_ALIGNMENT == 0);
-    unsigned short* newCollideWithMaskBits = reinterpret_cast<unsigned short*>(MemoryAllocator::alignAddress(newCollisionCategoryBits + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
+    uint64* newCollideWithMaskBits = reinterpret_cast<uint64*>(MemoryAllocator::alignAddress(newCollisionCategoryBits + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newCollideWithMaskBits) % GLOBAL_ALIGNMENT == 0);
     Transform* newLocalToWorldTransforms = reinterpret_cast<Transform*>(MemoryAllocator::alignAddress(newCollideWithMaskBits + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newLocalToWorldTransforms) % GLOBAL_ALIGNMENT == 0);
@@ -100,8 +100,8 @@ void ColliderComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy(newBroadPhaseIds, mBroadPhaseIds, mNbComponents * sizeof(int32));
         memcpy(newLocalToBodyTransforms, mLocalToBodyTransforms, mNbComponents * sizeof(Transform));
         memcpy(newCollisionShapes, mCollisionShapes, mNbComponents * sizeof(CollisionShape*));
-        memcpy(newCollisionCategoryBits, mCollisionCategoryBits, mNbComponents * sizeof(unsigned short));
-        memcpy(newCollideWithMaskBits, mCollideWithMaskBits, mNbComponents * sizeof(unsigned short));
+        memcpy(newCollisionCategoryBits, mCollisionCategoryBits, mNbComponents * sizeof(uint64));
+        memcpy(newCollideWithMaskBits, mCollideWithMaskBits, mNbComponents * sizeof(uint64));
         memcpy(newLocalToWorldTransforms, mLocalToWorldTransforms, mNbComponents * sizeof(Transform));
 	    memcpy((void*) newOverlappingPairs, mOverlappingPairs, mNbComponents * sizeof(Array<uint64>));
         memcpy(hasCollisionShapeChangedSize, mHasCollisionShapeChangedSize, mNbComponents * sizeof(bool));
@@ -147,8 +147,8 @@ void ColliderComponents::addComponent(Entity colliderEntity, bool isDisabled, co
     new (mBroadPhaseIds + index) int32(-1);
     new (mLocalToBodyTransforms + index) Transform(component.localToBodyTransform);
     mCollisionShapes[index] = component.collisionShape;
-    new (mCollisionCategoryBits + index) unsigned short(component.collisionCategoryBits);
-    new (mCollideWithMaskBits + index) unsigned short(component.collideWithMaskBits);
+    new (mCollisionCategoryBits + index) uint64(component.collisionCategoryBits);
+    new (mCollideWithMaskBits + index) uint64(component.collideWithMaskBits);
     new (mLocalToWorldTransforms + index) Transform(component.localToWorldTransform);
     new (mOverlappingPairs + index) Array<uint64>(mMemoryAllocator);
     mHasCollisionShapeChangedSize[index] = false;
@@ -178,8 +178,8 @@ void ColliderComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex)
     new (mBroadPhaseIds + destIndex) int32(mBroadPhaseIds[srcIndex]);
     new (mLocalToBodyTransforms + destIndex) Transform(mLocalToBodyTransforms[srcIndex]);
     mCollisionShapes[destIndex] = mCollisionShapes[srcIndex];
-    new (mCollisionCategoryBits + destIndex) unsigned short(mCollisionCategoryBits[srcIndex]);
-    new (mCollideWithMaskBits + destIndex) unsigned short(mCollideWithMaskBits[srcIndex]);
+    new (mCollisionCategoryBits + destIndex) uint64(mCollisionCategoryBits[srcIndex]);
+    new (mCollideWithMaskBits + destIndex) uint64(mCollideWithMaskBits[srcIndex]);
     new (mLocalToWorldTransforms + destIndex) Transform(mLocalToWorldTransforms[srcIndex]);
     new (mOverlappingPairs + destIndex) Array<uint64>(mOverlappingPairs[srcIndex]);
     mHasCollisionShapeChangedSize[destIndex] = mHasCollisionShapeChangedSize[srcIndex];
@@ -209,8 +209,8 @@ void ColliderComponents::swapComponents(uint32 index1, uint32 index2) {
     int32 broadPhaseId1 = mBroadPhaseIds[index1];
     Transform localToBodyTransform1 = mLocalToBodyTransforms[index1];
     CollisionShape* collisionShape1 = mCollisionShapes[index1];
-    unsigned short collisionCategoryBits1 = mCollisionCategoryBits[index1];
-    unsigned short collideWithMaskBits1 = mCollideWithMaskBits[index1];
+    uint64 collisionCategoryBits1 = mCollisionCategoryBits[index1];
+    uint64 collideWithMaskBits1 = mCollideWithMaskBits[index1];
     Transform localToWorldTransform1 = mLocalToWorldTransforms[index1];
     Array<uint64> overlappingPairs = mOverlappingPairs[index1];
     bool hasCollisionShapeChangedSize = mHasCollisionShapeChangedSize[index1];
@@ -231,8 +231,8 @@ void ColliderComponents::swapComponents(uint32 index1, uint32 index2) {
     new (mBroadPhaseIds + index2) int32(broadPhaseId1);
     new (mLocalToBodyTransforms + index2) Transform(localToBodyTransform1);
     mCollisionShapes[index2] = collisionShape1;
-    new (mCollisionCategoryBits + index2) unsigned short(collisionCategoryBits1);
-    new (mCollideWithMaskBits + index2) unsigned short(collideWithMaskBits1);
+    new (mCollisionCategoryBits + index2) uint64(collisionCategoryBits1);
+    new (mCollideWithMaskBits + index2) uint64(collideWithMaskBits1);
     new (mLocalToWorldTransforms + index2) Transform(localToWorldTransform1);
     new (mOverlappingPairs + index2) Array<uint64>(overlappingPairs);
     mHasCollisionShapeChangedSize[index2] = hasCollisionShapeChangedSize;
@@ -267,3 +267,46 @@ void ColliderComponents::destroyComponent(uint32 index) {
     mOverlappingPairs[index].~Array<uint64>();
     mMaterials[index].~Material();
 }
+
+// Write the simulation state of the components into a world snapshot
+/// The world transforms, the broad-phase ids and the ids of the overlapping pairs of each collider are written.
+void ColliderComponents::takeStateSnapshot(BinaryWriter& writer) const {
+
+    writeSnapshotArray(writer, mBroadPhaseIds);
+    writeSnapshotArray(writer, mLocalToWorldTransforms);
+    writeSnapshotArray(writer, mHasCollisionShapeChangedSize);
+
+    for (uint32 i=0; i < mNbComponents; i++) {
+        const uint32 nbOverlappingPairs = static_cast<uint32>(mOverlappingPairs[i].size());
+        writer.write(nbOverlappingPairs);
+        if (nbOverlappingPairs > 0) {
+            writer.writeBytes(&(mOverlappingPairs[i][0]), nbOverlappingPairs * sizeof(uint64));
+        }
+    }
+}
+
+// Restore the simulation state of the components from a world snapshot
+bool ColliderComponents::restoreStateSnapshot(BinaryReader& reader) {
+
+    bool isValid = true;
+    isValid &= readSnapshotArray(reader, mBroadPhaseIds);
+    isValid &= readSnapshotArray(reader, mLocalToWorldTransforms);
+    isValid &= readSnapshotArray(reader, mHasCollisionShapeChangedSize);
+
+    for (uint32 i=0; isValid && i < mNbComponents; i++) {
+
+        const uint32 nbOverlappingPairs = reader.read<uint32>();
+        if (!reader.hasRemaining(nbOverlappingPairs, sizeof(uint64))) {
+            return false;
+        }
+
+        mOverlappingPairs[i].clear();
+        mOverlappingPairs[i].reserve(nbOverlappingPairs);
+        mOverlappingPairs[i].addWithoutInit(nbOverlappingPairs);
+        if (nbOverlappingPairs > 0) {
+            reader.readBytes(&(mOverlappingPairs[i][0]), nbOverlappingPairs * sizeof(uint64));
+        }
+    }
+
+    return isValid && !reader.hasError();
+}
@@ -155,6 +155,107 @@ void Components::removeComponent(Entity entity) {
     assert(mNbComponents == static_cast<uint32>(mMapEntityToComponentIndex.size()));
 }
 
+// Write the order and the simulation state of the components into a world snapshot
+/**
+ * @param writer The writer used to write the snapshot
+ */
+void Components::takeSnapshot(BinaryWriter& writer) const {
+
+    writer.write(mNbComponents);
+    writer.write(mDisabledStartIndex);
+
+    // Write the entities in the order of the components
+    Array<uint32> entities(mMemoryAllocator, mNbComponents);
+    entities.addWithoutInit(mNbComponents);
+    for (auto it = mMapEntityToComponentIndex.begin(); it != mMapEntityToComponentIndex.end(); ++it) {
+        entities[it->second] = it->first.id;
+    }
+    if (mNbComponents > 0) {
+        writer.writeBytes(&entities[0], mNbComponents * sizeof(uint32));
+    }
+
+    takeStateSnapshot(writer);
+}
+
+// Check that the order of the components in a world snapshot matches the current components
+/// The components are not modified. The snapshot must contain each current entity of the
+/// components exactly once. The simulation state of the components is not read.
+/**
+ * @param reader The reader used to read the snapshot
+ * @return True if the snapshot contains the same entities as the components
+ */
+bool Components::validateSnapshot(BinaryReader& reader) const {
+
+    const uint32 nbComponents = reader.read<uint32>();
+    const uint32 disabledStartIndex = reader.read<uint32>();
+    if (reader.hasError() || nbComponents != mNbComponents || disabledStartIndex > nbComponents ||
+        !reader.hasRemaining(nbComponents, sizeof(uint32))) {
+        return false;
+    }
+
+    // Check that the snapshot contains the same entities (each one only once)
+    Array<bool> isEntityInSnapshot(mMemoryAllocator, nbComponents);
+    for (uint32 i=0; i < nbComponents; i++) {
+        isEntityInSnapshot.add(false);
+    }
+    for (uint32 i=0; i < nbComponents; i++) {
+        Entity entity(0, 0);
+        reader.readBytes(&entity.id, sizeof(uint32));
+        uint32 index;
+        if (!hasComponentGetIndex(entity, index) || isEntityInSnapshot[index]) {
+            return false;
+        }
+        isEntityInSnapshot[index] = true;
+    }
+
+    return !reader.hasError();
+}
+
+// Restore the order and the simulation state of the components from a world snapshot
+/// The snapshot must contain a component for each current entity of the components (see
+/// validateSnapshot()). The components are swapped to be stored in the same order as when
+/// the snapshot has been taken.
+/**
+ * @param reader The reader used to read the snapshot
+ * @return True if the snapshot matches the current components and has been restored
+ */
+bool Components::restoreSnapshot(BinaryReader& reader) {
+
+    const uint32 nbComponents = reader.read<uint32>();
+    const uint32 disabledStartIndex = reader.read<uint32>();
+    if (reader.hasError() || nbComponents != mNbComponents || disabledStartIndex > nbComponents ||
+        !reader.hasRemaining(nbComponents, sizeof(uint32))) {
+        return false;
+    }
+
+    // Store the components in the order of the snapshot
+    for (uint32 i=0; i < nbComponents; i++) {
+        Entity entity(0, 0);
+        reader.readBytes(&entity.id, sizeof(uint32));
+        uint32 index;
+        if (!hasComponentGetIndex(entity, index) || index < i) {
+            // The entity has no component or is present twice in the snapshot
+            return false;
+        }
+        if (index != i) {
+            swapComponents(i, index);
+        }
+    }
+    mDisabledStartIndex = disabledStartIndex;
+
+    return restoreStateSnapshot(reader);
+}
+
+// Write the simulation state of the components into a world snapshot
+void Components::takeStateSnapshot(BinaryWriter& /*writer*/) const {
+
+}
+
+// Restore the simulation state of the components from a world snapshot
+bool Components::restoreStateSnapshot(BinaryReader& /*reader*/) {
+    return true;
+}
+
 // Notify if a given entity is disabled (sleeping) or not
 void Components::setIsEntityDisabled(Entity entity, bool isDisabled) {
 
@@ -274,3 +274,21 @@ void FixedJointComponents::destroyComponent(uint32 index) {
     mBiasRotation[index].~Vector3();
     mInitOrientationDifferenceInv[index].~Quaternion();
 }
+
+// Write the simulation state of the components into a world snapshot
+/// The accumulated impulses (used for warm-starting) are written.
+void FixedJointComponents::takeStateSnapshot(BinaryWriter& writer) const {
+
+    writeSnapshotArray(writer, mImpulseTranslation);
+    writeSnapshotArray(writer, mImpulseRotation);
+}
+
+// Restore the simulation state of the components from a world snapshot
+bool FixedJointComponents::restoreStateSnapshot(BinaryReader& reader) {
+
+    bool isValid = true;
+    isValid &= readSnapshotArray(reader, mImpulseTranslation);
+    isValid &= readSnapshotArray(reader, mImpulseRotation);
+
+    return isValid;
+}
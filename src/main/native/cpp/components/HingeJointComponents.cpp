@@ -444,3 +444,27 @@ void HingeJointComponents::destroyComponent(uint32 index) {
     mB2CrossA1[index].~Vector3();
     mC2CrossA1[index].~Vector3();
 }
+
+// Write the simulation state of the components into a world snapshot
+/// The accumulated impulses (used for warm-starting) are written.
+void HingeJointComponents::takeStateSnapshot(BinaryWriter& writer) const {
+
+    writeSnapshotArray(writer, mImpulseTranslation);
+    writeSnapshotArray(writer, mImpulseRotation);
+    writeSnapshotArray(writer, mImpulseLowerLimit);
+    writeSnapshotArray(writer, mImpulseUpperLimit);
+    writeSnapshotArray(writer, mImpulseMotor);
+}
+
+// Restore the simulation state of the components from a world snapshot
+bool HingeJointComponents::restoreStateSnapshot(BinaryReader& reader) {
+
+    bool isValid = true;
+    isValid &= readSnapshotArray(reader, mImpulseTranslation);
+    isValid &= readSnapshotArray(reader, mImpulseRotation);
+    isValid &= readSnapshotArray(reader, mImpulseLowerLimit);
+    isValid &= readSnapshotArray(reader, mImpulseUpperLimit);
+    isValid &= readSnapshotArray(reader, mImpulseMotor);
+
+    return isValid;
+}
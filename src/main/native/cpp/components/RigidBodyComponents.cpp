@@ -44,7 +44,7 @@ RigidBodyComponents::RigidBodyComponents(MemoryAllocator& allocator)
                                 sizeof(Vector3) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(Quaternion) + sizeof(Vector3) + sizeof(Vector3) +
                                 sizeof(bool) + sizeof(bool) + sizeof(Array<Entity>) + sizeof(Array<uint>) +
-                                sizeof(Vector3) + sizeof(Vector3), 31 * GLOBAL_ALIGNMENT) {
+                                sizeof(Vector3) + sizeof(Vector3) + sizeof(decimal) + sizeof(uint32), 33 * GLOBAL_ALIGNMENT) {
 
 }
 
@@ -126,7 +126,11 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     assert(reinterpret_cast<uintptr_t>(newLinearLockAxisFactors) % GLOBAL_ALIGNMENT == 0);
     Vector3* newAngularLockAxisFactors = reinterpret_cast<Vector3*>(MemoryAllocator::alignAddress(newLinearLockAxisFactors + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
     assert(reinterpret_cast<uintptr_t>(newAngularLockAxisFactors) % GLOBAL_ALIGNMENT == 0);
-    assert(reinterpret_cast<uintptr_t>(newAngularLockAxisFactors + nbComponentsToAllocate) <= reinterpret_cast<uintptr_t>(newBuffer) + totalSizeBytes);
+    decimal* newFatAABBMarginScales = reinterpret_cast<decimal*>(MemoryAllocator::alignAddress(newAngularLockAxisFactors + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
+    assert(reinterpret_cast<uintptr_t>(newFatAABBMarginScales) % GLOBAL_ALIGNMENT == 0);
+    uint32* newNbStepsSinceFatAABBUpdate = reinterpret_cast<uint32*>(MemoryAllocator::alignAddress(newFatAABBMarginScales + nbComponentsToAllocate, GLOBAL_ALIGNMENT));
+    assert(reinterpret_cast<uintptr_t>(newNbStepsSinceFatAABBUpdate) % GLOBAL_ALIGNMENT == 0);
+    assert(reinterpret_cast<uintptr_t>(newNbStepsSinceFatAABBUpdate + nbComponentsToAllocate) <= reinterpret_cast<uintptr_t>(newBuffer) + totalSizeBytes);
 
     // If there was already components before
     if (mNbComponents > 0) {
@@ -163,6 +167,8 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
         memcpy((void*) newContactPairs, mContactPairs, mNbComponents * sizeof(Array<uint>));
         memcpy(newLinearLockAxisFactors, mLinearLockAxisFactors, mNbComponents * sizeof(Vector3));
         memcpy(newAngularLockAxisFactors, mAngularLockAxisFactors, mNbComponents * sizeof(Vector3));
+        memcpy(newFatAABBMarginScales, mFatAABBMarginScales, mNbComponents * sizeof(decimal));
+        memcpy(newNbStepsSinceFatAABBUpdate, mNbStepsSinceFatAABBUpdate, mNbComponents * sizeof(uint32));
 
         // Deallocate previous memory
         mMemoryAllocator.release(mBuffer, mNbAllocatedComponents * mComponentDataSize);
@@ -201,6 +207,8 @@ void RigidBodyComponents::allocate(uint32 nbComponentsToAllocate) {
     mContactPairs = newContactPairs;
     mLinearLockAxisFactors = newLinearLockAxisFactors;
     mAngularLockAxisFactors = newAngularLockAxisFactors;
+    mFatAABBMarginScales = newFatAABBMarginScales;
+    mNbStepsSinceFatAABBUpdate = newNbStepsSinceFatAABBUpdate;
 }
 
 // Add a component
@@ -241,6 +249,8 @@ void RigidBodyComponents::addComponent(Entity bodyEntity, bool isDisabled, const
     new (mContactPairs + index) Array<uint>(mMemoryAllocator);
     new (mLinearLockAxisFactors + index) Vector3(1, 1, 1);
     new (mAngularLockAxisFactors + index) Vector3(1, 1, 1);
+    mFatAABBMarginScales[index] = decimal(1.0);
+    mNbStepsSinceFatAABBUpdate[index] = 0;
 
     // Map the entity with the new component lookup index
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(bodyEntity, index));
@@ -289,6 +299,8 @@ void RigidBodyComponents::moveComponentToIndex(uint32 srcIndex, uint32 destIndex
     new (mContactPairs + destIndex) Array<uint>(mContactPairs[srcIndex]);
     new (mLinearLockAxisFactors + destIndex) Vector3(mLinearLockAxisFactors[srcIndex]);
     new (mAngularLockAxisFactors + destIndex) Vector3(mAngularLockAxisFactors[srcIndex]);
+    mFatAABBMarginScales[destIndex] = mFatAABBMarginScales[srcIndex];
+    mNbStepsSinceFatAABBUpdate[destIndex] = mNbStepsSinceFatAABBUpdate[srcIndex];
 
     // Destroy the source component
     destroyComponent(srcIndex);
@@ -336,6 +348,8 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     Array<uint> contactPairs1 = mContactPairs[index1];
     Vector3 linearLockAxisFactor1(mLinearLockAxisFactors[index1]);
     Vector3 angularLockAxisFactor1(mAngularLockAxisFactors[index1]);
+    decimal fatAABBMarginScale1 = mFatAABBMarginScales[index1];
+    uint32 nbStepsSinceFatAABBUpdate1 = mNbStepsSinceFatAABBUpdate[index1];
 
     // Destroy component 1
     destroyComponent(index1);
@@ -374,6 +388,8 @@ void RigidBodyComponents::swapComponents(uint32 index1, uint32 index2) {
     new (mContactPairs + index2) Array<uint>(contactPairs1);
     new (mLinearLockAxisFactors + index2) Vector3(linearLockAxisFactor1);
     new (mAngularLockAxisFactors + index2) Vector3(angularLockAxisFactor1);
+    mFatAABBMarginScales[index2] = fatAABBMarginScale1;
+    mNbStepsSinceFatAABBUpdate[index2] = nbStepsSinceFatAABBUpdate1;
 
     // Update the entity to component index mapping
     mMapEntityToComponentIndex.add(Pair<Entity, uint32>(entity1, index2));
@@ -414,3 +430,38 @@ void RigidBodyComponents::destroyComponent(uint32 index) {
     mLinearLockAxisFactors[index].~Vector3();
     mAngularLockAxisFactors[index].~Vector3();
 }
+
+// Write the simulation state of the components into a world snapshot
+/// The velocities, the external forces and torques (applied before the next update), the sleeping
+/// state and the world center of mass and inverse inertia tensor are written.
+void RigidBodyComponents::takeStateSnapshot(BinaryWriter& writer) const {
+
+    writeSnapshotArray(writer, mIsSleeping);
+    writeSnapshotArray(writer, mSleepTimes);
+    writeSnapshotArray(writer, mLinearVelocities);
+    writeSnapshotArray(writer, mAngularVelocities);
+    writeSnapshotArray(writer, mExternalForces);
+    writeSnapshotArray(writer, mExternalTorques);
+    writeSnapshotArray(writer, mInverseInertiaTensorsWorld);
+    writeSnapshotArray(writer, mCentersOfMassWorld);
+    writeSnapshotArray(writer, mFatAABBMarginScales);
+    writeSnapshotArray(writer, mNbStepsSinceFatAABBUpdate);
+}
+
+// Restore the simulation state of the components from a world snapshot
+bool RigidBodyComponents::restoreStateSnapshot(BinaryReader& reader) {
+
+    bool isValid = true;
+    isValid &= readSnapshotArray(reader, mIsSleeping);
+    isValid &= readSnapshotArray(reader, mSleepTimes);
+    isValid &= readSnapshotArray(reader, mLinearVelocities);
+    isValid &= readSnapshotArray(reader, mAngularVelocities);
+    isValid &= readSnapshotArray(reader, mExternalForces);
+    isValid &= readSnapshotArray(reader, mExternalTorques);
+    isValid &= readSnapshotArray(reader, mInverseInertiaTensorsWorld);
+    isValid &= readSnapshotArray(reader, mCentersOfMassWorld);
+    isValid &= readSnapshotArray(reader, mFatAABBMarginScales);
+    isValid &= readSnapshotArray(reader, mNbStepsSinceFatAABBUpdate);
+
+    return isValid;
+}
@@ -491,3 +491,27 @@ void SliderJointComponents::destroyComponent(uint32 index) {
     mR1PlusUCrossN2[index].~Vector3();
     mR1PlusUCrossSliderAxis[index].~Vector3();
 }
+
+// Write the simulation state of the components into a world snapshot
+/// The accumulated impulses (used for warm-starting) are written.
+void SliderJointComponents::takeStateSnapshot(BinaryWriter& writer) const {
+
+    writeSnapshotArray(writer, mImpulseTranslation);
+    writeSnapshotArray(writer, mImpulseRotation);
+    writeSnapshotArray(writer, mImpulseLowerLimit);
+    writeSnapshotArray(writer, mImpulseUpperLimit);
+    writeSnapshotArray(writer, mImpulseMotor);
+}
+
+// Restore the simulation state of the components from a world snapshot
+bool SliderJointComponents::restoreStateSnapshot(BinaryReader& reader) {
+
+    bool isValid = true;
+    isValid &= readSnapshotArray(reader, mImpulseTranslation);
+    isValid &= readSnapshotArray(reader, mImpulseRotation);
+    isValid &= readSnapshotArray(reader, mImpulseLowerLimit);
+    isValid &= readSnapshotArray(reader, mImpulseUpperLimit);
+    isValid &= readSnapshotArray(reader, mImpulseMotor);
+
+    return isValid;
+}
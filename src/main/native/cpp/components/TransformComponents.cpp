@@ -155,3 +155,19 @@ void TransformComponents::destroyComponent(uint32 index) {
     mBodies[index].~Entity();
     mTransforms[index].~Transform();
 }
+
+// Write the simulation state of the components into a world snapshot
+/// The transforms of the bodies are written.
+void TransformComponents::takeStateSnapshot(BinaryWriter& writer) const {
+
+    writeSnapshotArray(writer, mTransforms);
+}
+
+// Restore the simulation state of the components from a world snapshot
+bool TransformComponents::restoreStateSnapshot(BinaryReader& reader) {
+
+    bool isValid = true;
+    isValid &= readSnapshotArray(reader, mTransforms);
+
+    return isValid;
+}
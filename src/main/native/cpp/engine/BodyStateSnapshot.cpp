@@ -0,0 +1,87 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/engine/BodyStateSnapshot.h>
+#include <reactphysics3d/components/TransformComponents.h>
+#include <reactphysics3d/components/RigidBodyComponents.h>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Constructor
+BodyStateSnapshot::BodyStateSnapshot(MemoryAllocator& allocator)
+                  : mBodiesEntities(allocator), mTransforms(allocator), mLinearVelocities(allocator),
+                    mAngularVelocities(allocator), mMapEntityToIndex(allocator), mStepIndex(0) {
+
+}
+
+// Copy the state of the bodies from the components of a world
+// The map from entities to indices is only rebuilt if the bodies or their order have changed
+void BodyStateSnapshot::update(const TransformComponents& transformComponents, const RigidBodyComponents& rigidBodyComponents,
+                               uint64 stepIndex) {
+
+    const uint32 nbBodies = transformComponents.getNbComponents();
+
+    bool hasBodiesChanged = nbBodies != mBodiesEntities.size();
+    for (uint32 i=0; i < nbBodies && !hasBodiesChanged; i++) {
+        hasBodiesChanged = transformComponents.mBodies[i] != mBodiesEntities[i];
+    }
+
+    if (hasBodiesChanged) {
+
+        mBodiesEntities.clear();
+        mMapEntityToIndex.clear();
+        mBodiesEntities.reserve(nbBodies);
+        for (uint32 i=0; i < nbBodies; i++) {
+            mBodiesEntities.add(transformComponents.mBodies[i]);
+            mMapEntityToIndex.add(Pair<Entity, uint32>(transformComponents.mBodies[i], i));
+        }
+    }
+
+    mTransforms.clear();
+    mLinearVelocities.clear();
+    mAngularVelocities.clear();
+    mTransforms.reserve(nbBodies);
+    mLinearVelocities.reserve(nbBodies);
+    mAngularVelocities.reserve(nbBodies);
+
+    for (uint32 i=0; i < nbBodies; i++) {
+
+        mTransforms.add(transformComponents.mTransforms[i]);
+
+        uint32 rigidBodyIndex;
+        if (rigidBodyComponents.hasComponentGetIndex(mBodiesEntities[i], rigidBodyIndex)) {
+            mLinearVelocities.add(rigidBodyComponents.mLinearVelocities[rigidBodyIndex]);
+            mAngularVelocities.add(rigidBodyComponents.mAngularVelocities[rigidBodyIndex]);
+        }
+        else {
+            mLinearVelocities.add(Vector3::zero());
+            mAngularVelocities.add(Vector3::zero());
+        }
+    }
+
+    mStepIndex = stepIndex;
+}
@@ -0,0 +1,52 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/engine/ContactEventBuffer.h>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Constructor
+ContactEventBuffer::ContactEventBuffer(MemoryAllocator& allocator)
+                   : mBeginContactEvents(allocator), mStayContactEvents(allocator), mEndContactEvents(allocator),
+                     mBeginTriggerEvents(allocator), mStayTriggerEvents(allocator), mEndTriggerEvents(allocator),
+                     mBeginContactPairsIndices(allocator), mStayContactPairsIndices(allocator) {
+
+}
+
+// Remove all the events
+// The memory is kept so that the arrays do not need to grow again at the next step
+void ContactEventBuffer::clear() {
+
+    mBeginContactEvents.clear();
+    mStayContactEvents.clear();
+    mEndContactEvents.clear();
+    mBeginTriggerEvents.clear();
+    mStayTriggerEvents.clear();
+    mEndTriggerEvents.clear();
+    mBeginContactPairsIndices.clear();
+    mStayContactPairsIndices.clear();
+}
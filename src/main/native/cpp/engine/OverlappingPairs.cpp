@@ -480,3 +480,189 @@ void OverlappingPairs::updateCollidingInPreviousFrame() {
         mConcavePairs[i].collidingInPreviousFrame = mConcavePairs[i].collidingInCurrentFrame;
     }
 }
+
+// Destroy all the pairs without removing them from the colliders
+void OverlappingPairs::clearPairs() {
+
+    for (uint64 i=0; i < mConcavePairs.size(); i++) {
+        mConcavePairs[i].destroyLastFrameCollisionInfos();
+    }
+    for (uint64 i=0; i < mDisabledConcavePairs.size(); i++) {
+        mDisabledConcavePairs[i].destroyLastFrameCollisionInfos();
+    }
+
+    mConvexPairs.clear();
+    mConcavePairs.clear();
+    mDisabledConvexPairs.clear();
+    mDisabledConcavePairs.clear();
+    mMapConvexPairIdToPairIndex.clear();
+    mMapConcavePairIdToPairIndex.clear();
+    mMapDisabledConvexPairIdToPairIndex.clear();
+    mMapDisabledConcavePairIdToPairIndex.clear();
+}
+
+// Write the common attributes of a pair into a world snapshot
+void OverlappingPairs::writePairSnapshot(BinaryWriter& writer, const OverlappingPair& pair) {
+
+    writer.write(pair.pairID);
+    writer.write(pair.broadPhaseId1);
+    writer.write(pair.broadPhaseId2);
+    writer.write(pair.collider1.id);
+    writer.write(pair.collider2.id);
+    writer.write(static_cast<int32>(pair.narrowPhaseAlgorithmType));
+    writer.write(static_cast<uint8>(pair.needToTestOverlap));
+    writer.write(static_cast<uint8>(pair.collidingInPreviousFrame));
+    writer.write(static_cast<uint8>(pair.collidingInCurrentFrame));
+    writer.write(static_cast<uint8>(pair.isEnabled));
+}
+
+// Write an array of convex pairs into a world snapshot
+void OverlappingPairs::writeConvexPairsSnapshot(BinaryWriter& writer, const Array<ConvexOverlappingPair>& pairs) {
+
+    writer.write(static_cast<uint32>(pairs.size()));
+    for (uint64 i=0; i < pairs.size(); i++) {
+        writePairSnapshot(writer, pairs[i]);
+        writer.writeBytes(&(pairs[i].lastFrameCollisionInfo), sizeof(LastFrameCollisionInfo));
+    }
+}
+
+// Write an array of concave pairs into a world snapshot
+void OverlappingPairs::writeConcavePairsSnapshot(BinaryWriter& writer, const Array<ConcaveOverlappingPair>& pairs) {
+
+    writer.write(static_cast<uint32>(pairs.size()));
+    for (uint64 i=0; i < pairs.size(); i++) {
+        writePairSnapshot(writer, pairs[i]);
+        writer.write(static_cast<uint8>(pairs[i].isShape1Convex));
+        writer.write(static_cast<uint32>(pairs[i].lastFrameCollisionInfos.size()));
+        for (auto it = pairs[i].lastFrameCollisionInfos.begin(); it != pairs[i].lastFrameCollisionInfos.end(); ++it) {
+            writer.write(it->first);
+            writer.writeBytes(it->second, sizeof(LastFrameCollisionInfo));
+        }
+    }
+}
+
+// Read an array of convex pairs from a world snapshot
+bool OverlappingPairs::readConvexPairsSnapshot(BinaryReader& reader, Array<ConvexOverlappingPair>& pairs,
+                                               Map<uint64, uint64>& mapPairIdToPairIndex) {
+
+    const uint32 nbPairs = reader.read<uint32>();
+    if (!reader.hasRemaining(nbPairs, sizeof(LastFrameCollisionInfo))) {
+        return false;
+    }
+
+    pairs.reserve(nbPairs);
+    for (uint32 i=0; i < nbPairs; i++) {
+
+        const uint64 pairId = reader.read<uint64>();
+        const int32 broadPhaseId1 = reader.read<int32>();
+        const int32 broadPhaseId2 = reader.read<int32>();
+        Entity collider1(0, 0);
+        Entity collider2(0, 0);
+        collider1.id = reader.read<uint32>();
+        collider2.id = reader.read<uint32>();
+        const NarrowPhaseAlgorithmType algorithmType = static_cast<NarrowPhaseAlgorithmType>(reader.read<int32>());
+
+        pairs.emplace(pairId, broadPhaseId1, broadPhaseId2, collider1, collider2, algorithmType, true);
+        ConvexOverlappingPair& pair = pairs[i];
+        pair.needToTestOverlap = reader.read<uint8>() != 0;
+        pair.collidingInPreviousFrame = reader.read<uint8>() != 0;
+        pair.collidingInCurrentFrame = reader.read<uint8>() != 0;
+        pair.isEnabled = reader.read<uint8>() != 0;
+        reader.readBytes(&(pair.lastFrameCollisionInfo), sizeof(LastFrameCollisionInfo));
+
+        mapPairIdToPairIndex.add(Pair<uint64, uint64>(pairId, i));
+    }
+
+    return !reader.hasError();
+}
+
+// Read an array of concave pairs from a world snapshot
+bool OverlappingPairs::readConcavePairsSnapshot(BinaryReader& reader, Array<ConcaveOverlappingPair>& pairs,
+                                                Map<uint64, uint64>& mapPairIdToPairIndex) {
+
+    const uint32 nbPairs = reader.read<uint32>();
+    if (!reader.hasRemaining(nbPairs, sizeof(uint64))) {
+        return false;
+    }
+
+    // Make sure capacity is an integral multiple of alignment
+    const size_t allocatedMemory = std::ceil(sizeof(LastFrameCollisionInfo) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
+
+    pairs.reserve(nbPairs);
+    for (uint32 i=0; i < nbPairs; i++) {
+
+        const uint64 pairId = reader.read<uint64>();
+        const int32 broadPhaseId1 = reader.read<int32>();
+        const int32 broadPhaseId2 = reader.read<int32>();
+        Entity collider1(0, 0);
+        Entity collider2(0, 0);
+        collider1.id = reader.read<uint32>();
+        collider2.id = reader.read<uint32>();
+        const NarrowPhaseAlgorithmType algorithmType = static_cast<NarrowPhaseAlgorithmType>(reader.read<int32>());
+        const bool needToTestOverlap = reader.read<uint8>() != 0;
+        const bool collidingInPreviousFrame = reader.read<uint8>() != 0;
+        const bool collidingInCurrentFrame = reader.read<uint8>() != 0;
+        const bool isEnabled = reader.read<uint8>() != 0;
+        const bool isShape1Convex = reader.read<uint8>() != 0;
+        const uint32 nbLastFrameInfos = reader.read<uint32>();
+        if (reader.hasError() || !reader.hasRemaining(nbLastFrameInfos, sizeof(uint64) + sizeof(LastFrameCollisionInfo))) {
+            return false;
+        }
+
+        pairs.emplace(pairId, broadPhaseId1, broadPhaseId2, collider1, collider2, algorithmType, isShape1Convex,
+                      mPoolAllocator, mHeapAllocator, isEnabled, nbLastFrameInfos > 0);
+        ConcaveOverlappingPair& pair = pairs[i];
+        pair.needToTestOverlap = needToTestOverlap;
+        pair.collidingInPreviousFrame = collidingInPreviousFrame;
+        pair.collidingInCurrentFrame = collidingInCurrentFrame;
+
+        for (uint32 j=0; j < nbLastFrameInfos; j++) {
+
+            const uint64 shapesId = reader.read<uint64>();
+            LastFrameCollisionInfo* lastFrameInfo = new (mPoolAllocator.allocate(allocatedMemory)) LastFrameCollisionInfo();
+            reader.readBytes(lastFrameInfo, sizeof(LastFrameCollisionInfo));
+            pair.lastFrameCollisionInfos.add(Pair<uint64, LastFrameCollisionInfo*>(shapesId, lastFrameInfo));
+        }
+
+        mapPairIdToPairIndex.add(Pair<uint64, uint64>(pairId, i));
+    }
+
+    return !reader.hasError();
+}
+
+// Write the overlapping pairs and their last frame collision infos into a world snapshot
+/// The pairs are written in the order of the internal arrays so that the narrow-phase
+/// processes them in the same order after the snapshot is restored.
+/**
+ * @param writer The writer used to write the snapshot
+ */
+void OverlappingPairs::takeSnapshot(BinaryWriter& writer) const {
+
+    writeConvexPairsSnapshot(writer, mConvexPairs);
+    writeConcavePairsSnapshot(writer, mConcavePairs);
+    writeConvexPairsSnapshot(writer, mDisabledConvexPairs);
+    writeConcavePairsSnapshot(writer, mDisabledConcavePairs);
+}
+
+// Replace the overlapping pairs by the pairs of a world snapshot
+/// The arrays of overlapping pairs ids of the colliders are not modified here because they
+/// are restored with the colliders components.
+/**
+ * @param reader The reader used to read the snapshot
+ * @return True if the pairs have been restored
+ */
+bool OverlappingPairs::restoreSnapshot(BinaryReader& reader) {
+
+    clearPairs();
+
+    bool isValid = readConvexPairsSnapshot(reader, mConvexPairs, mMapConvexPairIdToPairIndex) &&
+                   readConcavePairsSnapshot(reader, mConcavePairs, mMapConcavePairIdToPairIndex) &&
+                   readConvexPairsSnapshot(reader, mDisabledConvexPairs, mMapDisabledConvexPairIdToPairIndex) &&
+                   readConcavePairsSnapshot(reader, mDisabledConcavePairs, mMapDisabledConcavePairIdToPairIndex);
+
+    if (!isValid) {
+        clearPairs();
+    }
+
+    return isValid;
+}
@@ -28,9 +28,33 @@
 #include <reactphysics3d/collision/PolygonVertexArray.h>
 #include <reactphysics3d/collision/VertexArray.h>
 #include <reactphysics3d/utils/quickhull/QuickHull.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
+#include <reactphysics3d/utils/MemoryMappedFile.h>
+#include <reactphysics3d/utils/Message.h>
+#include <cstring>
 
 using namespace reactphysics3d;
 
+// Cooked mesh data format
+// The data start with a header (magic string, version, type of mesh and size of the decimal values)
+// followed by the data of the mesh (see TriangleMesh::serialize() and ConvexMesh::serialize()).
+// All the values are stored in little-endian byte order. Data cooked with a different floating-point
+// precision can still be loaded (the decimal values are converted in this case).
+namespace {
+
+    /// Magic string at the beginning of cooked mesh data
+    const char COOKED_MESH_MAGIC[8] = {'R', 'P', '3', 'D', 'M', 'S', 'H', '\0'};
+
+    /// Version of the cooked mesh data format
+    const uint32 COOKED_MESH_VERSION = 1;
+
+    /// Type of mesh of cooked triangle mesh data
+    const uint32 COOKED_MESH_TYPE_TRIANGLE_MESH = 1;
+
+    /// Type of mesh of cooked convex mesh data
+    const uint32 COOKED_MESH_TYPE_CONVEX_MESH = 2;
+}
+
 // Static variables
 Logger* PhysicsCommon::mLogger = nullptr;
 
@@ -46,6 +70,7 @@ PhysicsCommon::PhysicsCommon(MemoryAllocator* baseMemoryAllocator)
                 mHeightFieldShapes(mMemoryManager.getHeapAllocator()), mConvexMeshes(mMemoryManager.getHeapAllocator()),
                 mTriangleMeshes(mMemoryManager.getHeapAllocator()), mHeightFields(mMemoryManager.getHeapAllocator()),
                 mProfilers(mMemoryManager.getHeapAllocator()), mDefaultLoggers(mMemoryManager.getHeapAllocator()),
+                mAsyncLoggers(mMemoryManager.getHeapAllocator()),
                 mBoxShapeHalfEdgeStructure(mMemoryManager.getHeapAllocator(), 6, 8, 24),
                 mTriangleShapeHalfEdgeStructure(mMemoryManager.getHeapAllocator(), 2, 3, 6) {
 
@@ -199,6 +224,12 @@ void PhysicsCommon::release() {
     }
     mDefaultLoggers.clear();
 
+    // Destroy the asynchronous loggers
+    for (auto it = mAsyncLoggers.begin(); it != mAsyncLoggers.end(); ++it) {
+        deleteAsyncLogger(*it);
+    }
+    mAsyncLoggers.clear();
+
 // If profiling is enabled
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -471,24 +502,61 @@ void PhysicsCommon::deleteConvexMeshShape(ConvexMeshShape* convexMeshShape) {
 /**
  * @param nbGridColumns Number of columns in the grid of the height field (along the local x axis)
  * @param nbGridRows Number of rows in the grid of the height field (along the local z axis)
- * @param heightFieldData Pointer to the first height value data (note that values are copied into the heigh-field)
+ * @param heightFieldData Pointer to the first height value data (note that values are copied into the heigh-field
+ *                        unless the REFERENCE storage is used)
  * @param dataType Data type for the height values (int, float, double)
  * @param[out] messages A reference to the array where the messages (warnings, errors, ...) will be stored
  * @param integerHeightScale Scaling factor for the height values of the height field
+ * @param storageType Storage of the height values in the height field. With the REFERENCE storage, the
+ *                    height values are not copied and the user data must stay valid until the height-field
+ *                    is destroyed.
  * @return A pointer to the created height-field
  */
 HeightField* PhysicsCommon::createHeightField(int nbGridColumns, int nbGridRows,
                                               const void* heightFieldData,
                                               HeightField::HeightDataType dataType,
                                               std::vector<Message>& messages,
-                                              decimal integerHeightScale) {
+                                              decimal integerHeightScale,
+                                              HeightField::HeightStorageType storageType) {
 
     // Create the height-field
-    HeightField* heightField = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(TriangleMesh))) HeightField(mMemoryManager.getHeapAllocator(), mTriangleShapeHalfEdgeStructure);
+    HeightField* heightField = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(HeightField))) HeightField(mMemoryManager.getHeapAllocator(), mTriangleShapeHalfEdgeStructure);
 
     // Initialize the height-field
     bool isValid = heightField->init(nbGridColumns, nbGridRows, heightFieldData, dataType, messages,
-                                     integerHeightScale);
+                                     integerHeightScale, storageType);
+
+    if (!isValid) {
+
+        heightField->~HeightField();
+        mMemoryManager.release(MemoryManager::AllocationType::Pool, heightField, sizeof(HeightField));
+
+        return nullptr;
+    }
+
+    mHeightFields.add(heightField);
+
+    return heightField;
+}
+
+// Create and return a height-field whose tiles are loaded lazily from a tiled height-field file
+/**
+ * The file (see HeightField::writeTiledFile()) is memory-mapped and stays mapped until the height-field
+ * is destroyed. A tile is only decoded the first time one of its height values is needed and the least
+ * recently used tiles are evicted when the memory used by the decoded tiles exceeds the budget.
+ * @param tiledFilePath Path of the tiled height-field file
+ * @param[out] messages A reference to the array where the messages (warnings, errors, ...) will be stored
+ * @param tileCacheMemoryBudget Maximum memory (in bytes) used by the decoded tiles
+ * @return A pointer to the created height-field
+ */
+HeightField* PhysicsCommon::createHeightField(const std::string& tiledFilePath, std::vector<Message>& messages,
+                                              size_t tileCacheMemoryBudget) {
+
+    // Create the height-field
+    HeightField* heightField = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(HeightField))) HeightField(mMemoryManager.getHeapAllocator(), mTriangleShapeHalfEdgeStructure);
+
+    // Initialize the height-field
+    bool isValid = heightField->initFromTiledFile(tiledFilePath, messages, tileCacheMemoryBudget);
 
     if (!isValid) {
 
@@ -672,6 +740,70 @@ ConvexMesh* PhysicsCommon::createConvexMesh(const VertexArray& vertexArray, std:
     return mesh;
 }
 
+// Create a convex mesh from cooked data (see cookConvexMesh())
+/// Nothing is recomputed: the vertices, the half-edge structure and the faces normals are copied
+/// from the cooked data. The cooked data can be released once the mesh has been created.
+/**
+ * @param cookedData Pointer to the first byte of the cooked data
+ * @param cookedDataSize Size (in bytes) of the cooked data
+ * @param messages A reference to the array of messages with errors that might have happened during the creation
+ * @return A pointer to the created ConvexMesh instance or nullptr if errors occured during the creation
+ */
+ConvexMesh* PhysicsCommon::createConvexMeshFromCookedData(const void* cookedData, size_t cookedDataSize,
+                                                          std::vector<Message>& messages) {
+
+    BinaryReader reader(cookedData, cookedDataSize);
+    if (!readCookedMeshHeader(reader, COOKED_MESH_TYPE_CONVEX_MESH, messages)) {
+        return nullptr;
+    }
+
+    ConvexMesh* mesh = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(ConvexMesh))) ConvexMesh(mMemoryManager.getHeapAllocator());
+
+    bool isValid = mesh->initFromCookedData(reader, messages);
+
+    // If the mesh is not valid
+    if (!isValid) {
+        mesh->~ConvexMesh();
+        mMemoryManager.release(MemoryManager::AllocationType::Pool, mesh, sizeof(ConvexMesh));
+        return nullptr;
+    }
+
+    mConvexMeshes.add(mesh);
+
+    return mesh;
+}
+
+// Create a convex mesh from a file of cooked data that is memory-mapped during the loading
+/**
+ * @param cookedFilePath Path of a file containing the data written by cookConvexMesh()
+ * @param messages A reference to the array of messages with errors that might have happened during the creation
+ * @return A pointer to the created ConvexMesh instance or nullptr if errors occured during the creation
+ */
+ConvexMesh* PhysicsCommon::createConvexMeshFromCookedFile(const std::string& cookedFilePath, std::vector<Message>& messages) {
+
+    MemoryMappedFile file;
+    if (!file.open(cookedFilePath)) {
+        messages.push_back(Message("Cannot open the cooked convex mesh file " + cookedFilePath));
+        return nullptr;
+    }
+
+    return createConvexMeshFromCookedData(file.getData(), file.getSize(), messages);
+}
+
+// Write the cooked data of a convex mesh into a byte buffer
+/// The cooked data can be saved into a file and loaded back later with createConvexMeshFromCookedFile()
+/// or createConvexMeshFromCookedData() to avoid computing the convex hull and the half-edge structure again.
+/**
+ * @param convexMesh A pointer to the convex mesh to cook
+ * @param[out] outCookedData The buffer where the cooked data are appended
+ */
+void PhysicsCommon::cookConvexMesh(const ConvexMesh* convexMesh, std::vector<uint8>& outCookedData) const {
+
+    BinaryWriter writer(outCookedData);
+    writeCookedMeshHeader(writer, COOKED_MESH_TYPE_CONVEX_MESH);
+    convexMesh->serialize(writer);
+}
+
 // Destroy a convex mesh
 /**
  * @param convexMesh A pointer to the convex mesh to destroy
@@ -696,17 +828,55 @@ void PhysicsCommon::deleteConvexMesh(ConvexMesh* convexMesh) {
 }
 
 // Create a triangle mesh from a TriangleVertexArray
-/// The data (vertices, faces indices) are copied from the TriangleVertexArray into the created ConvexMesh.
+/// By default, the data (vertices, faces indices) are copied from the TriangleVertexArray into the created
+/// TriangleMesh. With the REFERENCE storage, nothing is copied and the mesh reads the user buffers described by
+/// the TriangleVertexArray. Those buffers must then remain valid and unchanged until the mesh is destroyed.
 /**
  * @param triangleVertexArray A reference to the input TriangleVertexArray
- * @param messages A reference to the array to stored the messages (warnings, erros, ...)
+ * @param messages A reference to the array to stored the messages (warnings, erros, ...)
+ * @param storageType Storage of the vertices and triangles in the mesh (copy or reference to the user buffers)
  * @return A pointer to the created triangle mesh
  */
-TriangleMesh* PhysicsCommon::createTriangleMesh(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages) {
+TriangleMesh* PhysicsCommon::createTriangleMesh(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages,
+                                                TriangleMesh::StorageType storageType) {
+
+    TriangleMesh* mesh = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(TriangleMesh))) TriangleMesh(mMemoryManager.getHeapAllocator());
+
+    bool isValid = mesh->init(triangleVertexArray, messages, storageType);
+
+    if (!isValid) {
+
+        mesh->~TriangleMesh();
+        mMemoryManager.release(MemoryManager::AllocationType::Pool, mesh, sizeof(TriangleMesh));
+
+        return nullptr;
+    }
+
+    mTriangleMeshes.add(mesh);
+
+    return mesh;
+}
+
+// Create a triangle mesh from cooked data (see cookTriangleMesh())
+/// Nothing is recomputed: the vertices, the normals, the triangles and the BVH nodes are copied
+/// from the cooked data. The cooked data can be released once the mesh has been created.
+/**
+ * @param cookedData Pointer to the first byte of the cooked data
+ * @param cookedDataSize Size (in bytes) of the cooked data
+ * @param messages A reference to the array to stored the messages (warnings, erros, ...)
+ * @return A pointer to the created triangle mesh or nullptr if errors occured during the creation
+ */
+TriangleMesh* PhysicsCommon::createTriangleMeshFromCookedData(const void* cookedData, size_t cookedDataSize,
+                                                              std::vector<Message>& messages) {
+
+    BinaryReader reader(cookedData, cookedDataSize);
+    if (!readCookedMeshHeader(reader, COOKED_MESH_TYPE_TRIANGLE_MESH, messages)) {
+        return nullptr;
+    }
 
     TriangleMesh* mesh = new (mMemoryManager.allocate(MemoryManager::AllocationType::Pool, sizeof(TriangleMesh))) TriangleMesh(mMemoryManager.getHeapAllocator());
 
-    bool isValid = mesh->init(triangleVertexArray, messages);
+    bool isValid = mesh->initFromCookedData(reader, messages);
 
     if (!isValid) {
 
@@ -721,6 +891,78 @@ TriangleMesh* PhysicsCommon::createTriangleMesh(const TriangleVertexArray& trian
     return mesh;
 }
 
+// Create a triangle mesh from a file of cooked data that is memory-mapped during the loading
+/**
+ * @param cookedFilePath Path of a file containing the data written by cookTriangleMesh()
+ * @param messages A reference to the array to stored the messages (warnings, erros, ...)
+ * @return A pointer to the created triangle mesh or nullptr if errors occured during the creation
+ */
+TriangleMesh* PhysicsCommon::createTriangleMeshFromCookedFile(const std::string& cookedFilePath,
+                                                              std::vector<Message>& messages) {
+
+    MemoryMappedFile file;
+    if (!file.open(cookedFilePath)) {
+        messages.push_back(Message("Cannot open the cooked triangle mesh file " + cookedFilePath));
+        return nullptr;
+    }
+
+    return createTriangleMeshFromCookedData(file.getData(), file.getSize(), messages);
+}
+
+// Write the cooked data of a triangle mesh into a byte buffer
+/// The cooked data can be saved into a file and loaded back later with createTriangleMeshFromCookedFile()
+/// or createTriangleMeshFromCookedData() to avoid validating the triangles and building the BVH again.
+/**
+ * @param triangleMesh A pointer to the triangle mesh to cook
+ * @param[out] outCookedData The buffer where the cooked data are appended
+ */
+void PhysicsCommon::cookTriangleMesh(const TriangleMesh* triangleMesh, std::vector<uint8>& outCookedData) const {
+
+    BinaryWriter writer(outCookedData);
+    writeCookedMeshHeader(writer, COOKED_MESH_TYPE_TRIANGLE_MESH);
+    triangleMesh->serialize(writer);
+}
+
+// Write the header of cooked mesh data
+void PhysicsCommon::writeCookedMeshHeader(BinaryWriter& writer, uint32 meshType) {
+
+    writer.writeBytes(COOKED_MESH_MAGIC, sizeof(COOKED_MESH_MAGIC));
+    writer.write(COOKED_MESH_VERSION);
+    writer.write(meshType);
+    writer.write(static_cast<uint32>(sizeof(decimal)));
+}
+
+// Read and check the header of cooked mesh data
+bool PhysicsCommon::readCookedMeshHeader(BinaryReader& reader, uint32 meshType, std::vector<Message>& messages) {
+
+    char magic[sizeof(COOKED_MESH_MAGIC)];
+    if (!reader.readBytes(magic, sizeof(magic)) || std::memcmp(magic, COOKED_MESH_MAGIC, sizeof(magic)) != 0) {
+        messages.push_back(Message("The data are not cooked mesh data"));
+        return false;
+    }
+
+    const uint32 version = reader.read<uint32>();
+    const uint32 type = reader.read<uint32>();
+    const uint32 decimalSize = reader.read<uint32>();
+
+    if (version != COOKED_MESH_VERSION) {
+        messages.push_back(Message("The version of the cooked mesh data is not supported"));
+        return false;
+    }
+    if (type != meshType) {
+        messages.push_back(Message("The cooked mesh data do not contain the expected type of mesh"));
+        return false;
+    }
+    if (decimalSize != sizeof(float) && decimalSize != sizeof(double)) {
+        messages.push_back(Message("The cooked mesh data have an invalid decimal size"));
+        return false;
+    }
+
+    reader.setDecimalSize(decimalSize);
+
+    return true;
+}
+
 // Destroy a triangle mesh
 /**
  * @param triangleMesh A pointer to the triangle mesh to destroy
@@ -806,6 +1048,46 @@ void PhysicsCommon::deleteDefaultLogger(DefaultLogger* logger) {
    mMemoryManager.release(MemoryManager::AllocationType::Pool, logger, sizeof(DefaultLogger));
 }
 
+// Create and return a new asynchronous logger
+/**
+ * @param queueCapacity The number of slots of the queue of the logger (rounded up to a power of two)
+ * @return A pointer to the created asynchronous logger
+ */
+AsyncLogger* PhysicsCommon::createAsyncLogger(uint32 queueCapacity) {
+
+    AsyncLogger* logger = new (mMemoryManager.allocate(MemoryManager::AllocationType::Heap, sizeof(AsyncLogger)))
+                              AsyncLogger(mMemoryManager.getHeapAllocator(), queueCapacity);
+
+    mAsyncLoggers.add(logger);
+
+    return logger;
+}
+
+// Destroy an asynchronous logger
+/**
+ * The messages still in the queue of the logger are written before it is destroyed.
+ * @param logger A pointer to the asynchronous logger to destroy
+ */
+void PhysicsCommon::destroyAsyncLogger(AsyncLogger* logger) {
+
+    deleteAsyncLogger(logger);
+
+    mAsyncLoggers.remove(logger);
+}
+
+// Delete an asynchronous logger
+/**
+ * @param logger A pointer to the asynchronous logger to destroy
+ */
+void PhysicsCommon::deleteAsyncLogger(AsyncLogger* logger) {
+
+   // Call the destructor of the logger
+   logger->~AsyncLogger();
+
+   // Release allocated memory
+   mMemoryManager.release(MemoryManager::AllocationType::Heap, logger, sizeof(AsyncLogger));
+}
+
 // If profiling is enabled
 #ifdef IS_RP3D_PROFILING_ENABLED
 
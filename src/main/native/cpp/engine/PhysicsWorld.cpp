@@ -36,11 +36,55 @@
 #include <reactphysics3d/collision/ContactManifold.h>
 #include <reactphysics3d/containers/Stack.h>
 #include <iostream>
+#include <cstring>
 
 // Namespaces
 using namespace reactphysics3d;
 using namespace std;
 
+// World snapshot format
+// The snapshot starts with a header (magic string, version, size of the decimal values and pointers,
+// byte order and address of the world) followed by the sections of the components and of the collision
+// detection state. Each section is preceded by its size so that a snapshot can be checked before it is restored.
+namespace {
+
+    /// Magic string at the beginning of a world snapshot
+    const char SNAPSHOT_MAGIC[8] = {'R', 'P', '3', 'D', 'S', 'N', 'A', 'P'};
+
+    /// Version of the world snapshot format
+    const uint32 SNAPSHOT_VERSION = 2;
+
+    /// Number of sections of components in a world snapshot
+    const uint32 NB_SNAPSHOT_COMPONENTS = 9;
+
+    /// Start a section of a world snapshot and return its offset (the size of the section is written by endSnapshotSection())
+    size_t beginSnapshotSection(BinaryWriter& writer) {
+        const size_t sectionOffset = writer.getSize();
+        writer.write(static_cast<uint64>(0));
+        return sectionOffset;
+    }
+
+    /// Write the size of a section of a world snapshot at its beginning
+    void endSnapshotSection(BinaryWriter& writer, size_t sectionOffset) {
+        writer.writeAt(sectionOffset, static_cast<uint64>(writer.getSize() - sectionOffset - sizeof(uint64)));
+    }
+
+    /// Replace the content of an array of bodies by the bodies of the colliders in parameter (without duplicates)
+    void collectBodiesOfColliders(const Array<Collider*>& colliders, Array<Body*>& outBodies, MemoryAllocator& allocator) {
+
+        outBodies.clear();
+
+        Set<Body*> bodies(allocator, colliders.size());
+        for (uint64 i=0; i < colliders.size(); i++) {
+
+            Body* body = colliders[i]->getBody();
+            if (bodies.add(body)) {
+                outBodies.add(body);
+            }
+        }
+    }
+}
+
 // Static initializations
 
 uint32 PhysicsWorld::mNbWorlds = 0;
@@ -65,6 +109,10 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
                 mSliderJointsComponents(mMemoryManager.getHeapAllocator()), mCollisionDetection(this, mCollidersComponents, mTransformComponents, mBodyComponents, mRigidBodyComponents,
                                         mMemoryManager, physicsCommon.mTriangleShapeHalfEdgeStructure),
                 mCollisionBodies(mMemoryManager.getHeapAllocator()), mEventListener(nullptr),
+                mIsContactEventBufferEnabled(false), mContactEventBuffer(mMemoryManager.getHeapAllocator()), mNbSteps(0),
+                mBodyStateSnapshot1(mMemoryManager.getHeapAllocator()), mBodyStateSnapshot2(mMemoryManager.getHeapAllocator()),
+                mFrontBodyStateSnapshot(&mBodyStateSnapshot1), mBackBodyStateSnapshot(&mBodyStateSnapshot2),
+                mAsyncUpdateTimeStep(0), mIsAsyncUpdatePending(false), mIsAsyncUpdateThreadStopping(false), mIsAsyncUpdateInFlight(false),
                 mName(worldSettings.worldName),  mIslands(mMemoryManager.getSingleFrameAllocator()), mProcessContactPairsOrderIslands(mMemoryManager.getSingleFrameAllocator()),
                 mContactSolverSystem(mMemoryManager, *this, mIslands, mBodyComponents, mRigidBodyComponents,
                                mCollidersComponents, mConfig.restitutionVelocityThreshold),
@@ -91,6 +139,11 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
         mName = ss.str();
     }
 
+    mCollisionDetection.mBroadPhaseSystem.setTreeUpdateMethod(mConfig.broadPhaseTreeUpdateMethod,
+                                                              mConfig.broadPhaseMaxNbTreeRotations);
+    mCollisionDetection.mBroadPhaseSystem.setBroadPhaseMethod(mConfig.broadPhaseMethod, mConfig.broadPhaseGridCellSize);
+    mCollisionDetection.mBroadPhaseSystem.setIsPredictiveFatAABBEnabled(mConfig.isPredictiveFatAABBEnabled);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 
@@ -130,6 +183,9 @@ PhysicsWorld::PhysicsWorld(MemoryManager& memoryManager, PhysicsCommon& physicsC
 // Destructor
 PhysicsWorld::~PhysicsWorld() {
 
+    // Finish the running asynchronous step (if any) and stop the worker thread
+    stopAsyncUpdateThread();
+
     RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
              "Physics World: Physics world " + mName + " has been destroyed",  __FILE__, __LINE__);
 
@@ -218,6 +274,101 @@ bool PhysicsWorld::testOverlap(Body* body1, Body* body2) {
     return mCollisionDetection.testOverlap(body1, body2);
 }
 
+// Report the colliders whose AABB overlaps with a given AABB
+/// Only the broad-phase is used: the shapes of the colliders are not tested. The category mask is
+/// applied while the broad-phase tree is traversed and no callback is called.
+/**
+ * @param aabb AABB of the query in world-space
+ * @param[out] outColliders Array with the colliders overlapping with the AABB (cleared first)
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB If true, the exact AABB of the colliders is tested. Otherwise, only their
+ *                     fat AABB in the broad-phase is tested (faster but less accurate)
+ */
+void PhysicsWorld::queryAABB(const AABB& aabb, Array<Collider*>& outColliders, uint64 categoryMaskBits, bool useExactAABB) const {
+    mCollisionDetection.mBroadPhaseSystem.reportCollidersOverlappingWithAABB(aabb, categoryMaskBits, useExactAABB, outColliders,
+                                                                             mMemoryManager.getPoolAllocator());
+}
+
+// Report the bodies with a collider whose AABB overlaps with a given AABB
+/**
+ * @param aabb AABB of the query in world-space
+ * @param[out] outBodies Array with the bodies overlapping with the AABB (cleared first)
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB If true, the exact AABB of the colliders is tested. Otherwise, only their
+ *                     fat AABB in the broad-phase is tested (faster but less accurate)
+ */
+void PhysicsWorld::queryAABB(const AABB& aabb, Array<Body*>& outBodies, uint64 categoryMaskBits, bool useExactAABB) const {
+
+    Array<Collider*> colliders(mMemoryManager.getPoolAllocator());
+    queryAABB(aabb, colliders, categoryMaskBits, useExactAABB);
+    collectBodiesOfColliders(colliders, outBodies, mMemoryManager.getPoolAllocator());
+}
+
+// Report the colliders whose AABB overlaps with a given sphere
+/// Only the broad-phase is used: the shapes of the colliders are not tested. The category mask is
+/// applied while the broad-phase tree is traversed and no callback is called.
+/**
+ * @param center Center of the sphere in world-space
+ * @param radius Radius of the sphere
+ * @param[out] outColliders Array with the colliders overlapping with the sphere (cleared first)
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB If true, the exact AABB of the colliders is tested. Otherwise, only their
+ *                     fat AABB in the broad-phase is tested (faster but less accurate)
+ */
+void PhysicsWorld::querySphere(const Vector3& center, decimal radius, Array<Collider*>& outColliders, uint64 categoryMaskBits,
+                               bool useExactAABB) const {
+    mCollisionDetection.mBroadPhaseSystem.reportCollidersOverlappingWithSphere(center, radius, categoryMaskBits, useExactAABB, outColliders,
+                                                                               mMemoryManager.getPoolAllocator());
+}
+
+// Report the bodies with a collider whose AABB overlaps with a given sphere
+/**
+ * @param center Center of the sphere in world-space
+ * @param radius Radius of the sphere
+ * @param[out] outBodies Array with the bodies overlapping with the sphere (cleared first)
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB If true, the exact AABB of the colliders is tested. Otherwise, only their
+ *                     fat AABB in the broad-phase is tested (faster but less accurate)
+ */
+void PhysicsWorld::querySphere(const Vector3& center, decimal radius, Array<Body*>& outBodies, uint64 categoryMaskBits,
+                               bool useExactAABB) const {
+
+    Array<Collider*> colliders(mMemoryManager.getPoolAllocator());
+    querySphere(center, radius, colliders, categoryMaskBits, useExactAABB);
+    collectBodiesOfColliders(colliders, outBodies, mMemoryManager.getPoolAllocator());
+}
+
+// Report the colliders whose AABB overlaps with a given frustum
+/// Only the broad-phase is used: the shapes of the colliders are not tested. The category mask is
+/// applied while the broad-phase tree is traversed and no callback is called. The AABB versus frustum
+/// test is conservative: an AABB near a corner of the frustum can be reported even if it is outside.
+/**
+ * @param frustum Frustum of the query in world-space (see Frustum::createPerspective())
+ * @param[out] outColliders Array with the colliders overlapping with the frustum (cleared first)
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB If true, the exact AABB of the colliders is tested. Otherwise, only their
+ *                     fat AABB in the broad-phase is tested (faster but less accurate)
+ */
+void PhysicsWorld::queryFrustum(const Frustum& frustum, Array<Collider*>& outColliders, uint64 categoryMaskBits, bool useExactAABB) const {
+    mCollisionDetection.mBroadPhaseSystem.reportCollidersOverlappingWithFrustum(frustum, categoryMaskBits, useExactAABB, outColliders,
+                                                                                mMemoryManager.getPoolAllocator());
+}
+
+// Report the bodies with a collider whose AABB overlaps with a given frustum
+/**
+ * @param frustum Frustum of the query in world-space (see Frustum::createPerspective())
+ * @param[out] outBodies Array with the bodies overlapping with the frustum (cleared first)
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB If true, the exact AABB of the colliders is tested. Otherwise, only their
+ *                     fat AABB in the broad-phase is tested (faster but less accurate)
+ */
+void PhysicsWorld::queryFrustum(const Frustum& frustum, Array<Body*>& outBodies, uint64 categoryMaskBits, bool useExactAABB) const {
+
+    Array<Collider*> colliders(mMemoryManager.getPoolAllocator());
+    queryFrustum(frustum, colliders, categoryMaskBits, useExactAABB);
+    collectBodiesOfColliders(colliders, outBodies, mMemoryManager.getPoolAllocator());
+}
+
 // Return the current world-space AABB of given collider
 /**
  * @param collider Pointer to a collider
@@ -246,19 +397,28 @@ void PhysicsWorld::update(decimal timeStep) {
 
     RP3D_PROFILE("PhysicsWorld::update()", mProfiler);
 
+    const std::chrono::steady_clock::time_point stepStartTime = std::chrono::steady_clock::now();
+    mLastStepStats.reset();
+    mNbSteps++;
+
     // Reset the debug renderer
     if (mIsDebugRenderingEnabled) {
         mDebugRenderer.reset();
     }
 
     // Compute the collision detection
-    mCollisionDetection.computeCollisionDetection();
+    mCollisionDetection.computeCollisionDetection(mLastStepStats);
 
     // Create the islands
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
     createIslands();
+    mLastStepStats.islandsTime = StepStats::getElapsedTime(startTime);
+    mLastStepStats.nbIslands = mIslands.getNbIslands();
 
     // Create the actual narrow-phase contacts
     mCollisionDetection.createContacts();
+    mLastStepStats.nbContactManifolds = static_cast<uint32>(mCollisionDetection.mCurrentContactManifolds->size());
+    mLastStepStats.nbContactPoints = static_cast<uint32>(mCollisionDetection.mCurrentContactPoints->size());
 
     // Report the contacts to the user
     mCollisionDetection.reportContactsAndTriggers();
@@ -269,23 +429,43 @@ void PhysicsWorld::update(decimal timeStep) {
     // Enable or disable the joints
     enableDisableJoints();
 
+    mLastStepStats.nbAwakeBodies = mRigidBodyComponents.getNbEnabledComponents();
+    mLastStepStats.nbVelocitySolverIterations = mNbVelocitySolverIterations;
+    mLastStepStats.nbPositionSolverIterations = mNbPositionSolverIterations;
+
     // Integrate the velocities
+    startTime = std::chrono::steady_clock::now();
     mDynamicsSystem.integrateRigidBodiesVelocities(timeStep);
+    mLastStepStats.integrateTime = StepStats::getElapsedTime(startTime);
 
     // Solve the contacts and constraints
+    startTime = std::chrono::steady_clock::now();
     solveContactsAndConstraints(timeStep);
+    mLastStepStats.solveTime = StepStats::getElapsedTime(startTime);
+
+    // Collect the contact impulses into the contact event buffer (if enabled)
+    if (mIsContactEventBufferEnabled) {
+        mCollisionDetection.updateContactEventBufferImpulses(mContactEventBuffer);
+    }
 
     // Integrate the position and orientation of each body
+    startTime = std::chrono::steady_clock::now();
     mDynamicsSystem.integrateRigidBodiesPositions(timeStep, mContactSolverSystem.isSplitImpulseActive());
+    mLastStepStats.integrateTime += StepStats::getElapsedTime(startTime);
 
     // Solve the position correction for constraints
+    startTime = std::chrono::steady_clock::now();
     solvePositionCorrection();
+    mLastStepStats.solveTime += StepStats::getElapsedTime(startTime);
 
     // Update the state (positions and velocities) of the bodies
+    startTime = std::chrono::steady_clock::now();
     mDynamicsSystem.updateBodiesState();
+    mLastStepStats.integrateTime += StepStats::getElapsedTime(startTime);
 
     // Update the colliders components
-    mCollisionDetection.updateColliders();
+    mCollisionDetection.updateColliders(timeStep);
+    mLastStepStats.nbBroadPhaseReinsertions = mCollisionDetection.mBroadPhaseSystem.getNbReinsertions();
 
     if (mIsSleepingEnabled) updateSleepingBodies(timeStep);
 
@@ -304,6 +484,244 @@ void PhysicsWorld::update(decimal timeStep) {
 
     // Reset the single frame memory allocator
     mMemoryManager.resetFrameAllocator();
+
+    mLastStepStats.totalTime = StepStats::getElapsedTime(stepStartTime);
+}
+
+// Start a step of the simulation on a worker thread
+/// The step runs on a worker thread owned by the world (started at the first call) while the
+/// calling thread continues. Until waitForUpdate() has been called, the world must not be
+/// accessed by the user (no creation/destruction of bodies, no call of getTransform() ...)
+/// except with getBodyStateSnapshot() that returns the state of the bodies at the end of the
+/// previous asynchronous step. The other worlds created with the same PhysicsCommon share
+/// its memory allocators and must not be updated while the step is running. If the previous
+/// asynchronous step has not been waited for, this method waits for it first. The methods of
+/// the event listener (onContact(), onTrigger(), ...) are called from the worker thread during
+/// the step and must therefore synchronize their access to the user data shared with other threads.
+/**
+ * @param timeStep The amount of time to step the simulation by (in seconds)
+ */
+void PhysicsWorld::updateAsync(decimal timeStep) {
+
+    if (mIsAsyncUpdateInFlight) {
+        waitForUpdate();
+    }
+
+    // The first snapshot contains the state of the bodies before the first asynchronous step
+    if (!mAsyncUpdateThread.joinable()) {
+        mFrontBodyStateSnapshot->update(mTransformComponents, mRigidBodyComponents, mNbSteps);
+        mAsyncUpdateThread = std::thread(&PhysicsWorld::runAsyncUpdateThread, this);
+    }
+
+    {
+        std::lock_guard<std::mutex> lock(mAsyncUpdateMutex);
+        mAsyncUpdateTimeStep = timeStep;
+        mIsAsyncUpdatePending = true;
+    }
+    mIsAsyncUpdateInFlight = true;
+
+    mAsyncUpdateCondition.notify_all();
+}
+
+// Wait for the end of the asynchronous step and publish its body state snapshot
+/// After this call, the world can be accessed again and getBodyStateSnapshot() returns the state
+/// of the bodies at the end of the step. This method does nothing if no asynchronous step is running.
+void PhysicsWorld::waitForUpdate() {
+
+    if (!mIsAsyncUpdateInFlight) return;
+
+    {
+        std::unique_lock<std::mutex> lock(mAsyncUpdateMutex);
+        mAsyncUpdateCondition.wait(lock, [this] { return !mIsAsyncUpdatePending; });
+    }
+
+    // Publish the snapshot of the step
+    std::swap(mFrontBodyStateSnapshot, mBackBodyStateSnapshot);
+    mIsAsyncUpdateInFlight = false;
+}
+
+// Return true if an asynchronous step has been started and is not finished yet
+/// This can be used to poll the worker thread instead of blocking in waitForUpdate(). Note that
+/// waitForUpdate() still has to be called to publish the snapshot of the step.
+/**
+ * @return True if the worker thread is still running the step
+ */
+bool PhysicsWorld::isAsyncUpdateRunning() const {
+
+    std::lock_guard<std::mutex> lock(mAsyncUpdateMutex);
+    return mIsAsyncUpdatePending;
+}
+
+// Main loop of the worker thread of the asynchronous update
+void PhysicsWorld::runAsyncUpdateThread() {
+
+    std::unique_lock<std::mutex> lock(mAsyncUpdateMutex);
+
+    while (true) {
+
+        mAsyncUpdateCondition.wait(lock, [this] { return mIsAsyncUpdatePending || mIsAsyncUpdateThreadStopping; });
+
+        if (!mIsAsyncUpdatePending && mIsAsyncUpdateThreadStopping) return;
+
+        const decimal timeStep = mAsyncUpdateTimeStep;
+        lock.unlock();
+
+        update(timeStep);
+        mBackBodyStateSnapshot->update(mTransformComponents, mRigidBodyComponents, mNbSteps);
+
+        lock.lock();
+        mIsAsyncUpdatePending = false;
+        mAsyncUpdateCondition.notify_all();
+    }
+}
+
+// Stop the worker thread of the asynchronous update
+void PhysicsWorld::stopAsyncUpdateThread() {
+
+    waitForUpdate();
+
+    if (!mAsyncUpdateThread.joinable()) return;
+
+    {
+        std::lock_guard<std::mutex> lock(mAsyncUpdateMutex);
+        mIsAsyncUpdateThreadStopping = true;
+    }
+    mAsyncUpdateCondition.notify_all();
+
+    mAsyncUpdateThread.join();
+}
+
+// Write the simulation state of the world into a binary snapshot
+/// The snapshot contains the components of the bodies, colliders and joints (transforms, velocities,
+/// forces, sleeping state and cached impulses of the joints), the broad-phase tree, the overlapping
+/// pairs with their last frame collision infos and the contacts used to warm start the next update.
+/// The configuration of the world and its objects (masses, materials, collision shapes, ...) is not
+/// part of the snapshot. The component arrays are copied as they are in memory. Therefore, a snapshot
+/// can only be restored in this world (or in the same process with the same build of the library) as
+/// long as no body, collider or joint has been created or destroyed since the snapshot has been taken.
+/**
+ * @param outSnapshot The buffer where the snapshot is written (its previous content is replaced)
+ */
+void PhysicsWorld::takeSnapshot(std::vector<uint8>& outSnapshot) const {
+
+    RP3D_PROFILE("PhysicsWorld::takeSnapshot()", mProfiler);
+
+    outSnapshot.clear();
+    BinaryWriter writer(outSnapshot);
+
+    // Write the header
+    writer.writeBytes(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+    writer.write(SNAPSHOT_VERSION);
+    writer.write(static_cast<uint8>(sizeof(decimal)));
+    writer.write(static_cast<uint8>(sizeof(void*)));
+    writer.write(static_cast<uint8>(BinaryReader::isLittleEndianMachine()));
+    writer.write(static_cast<uint64>(reinterpret_cast<uintptr_t>(this)));
+
+    // Write the components
+    const Components* components[NB_SNAPSHOT_COMPONENTS] = {&mBodyComponents, &mRigidBodyComponents, &mTransformComponents,
+                                                             &mCollidersComponents, &mJointsComponents, &mBallAndSocketJointsComponents,
+                                                             &mFixedJointsComponents, &mHingeJointsComponents, &mSliderJointsComponents};
+    for (uint32 i=0; i < NB_SNAPSHOT_COMPONENTS; i++) {
+        const size_t sectionOffset = beginSnapshotSection(writer);
+        components[i]->takeSnapshot(writer);
+        endSnapshotSection(writer, sectionOffset);
+    }
+
+    // Write the collision detection state
+    const size_t sectionOffset = beginSnapshotSection(writer);
+    mCollisionDetection.takeSnapshot(writer);
+    endSnapshotSection(writer, sectionOffset);
+}
+
+// Restore the simulation state of the world from a binary snapshot
+/// The bodies, colliders and joints are not recreated. The snapshot must have been taken in
+/// this world with the same bodies, colliders and joints. The snapshot is checked before the world
+/// is modified (size of each section and entities of the components). If the snapshot does not match
+/// the world, an error is logged, false is returned and the world is not modified.
+/**
+ * @param snapshot Pointer to the buffer of the snapshot
+ * @param snapshotSize Size (in bytes) of the snapshot
+ * @return True if the state of the world has been restored
+ */
+bool PhysicsWorld::restoreSnapshot(const void* snapshot, size_t snapshotSize) {
+
+    RP3D_PROFILE("PhysicsWorld::restoreSnapshot()", mProfiler);
+
+    BinaryReader reader(snapshot, snapshotSize);
+
+    // Read and check the header
+    char magic[sizeof(SNAPSHOT_MAGIC)];
+    reader.readBytes(magic, sizeof(magic));
+    const uint32 version = reader.read<uint32>();
+    const uint8 decimalSize = reader.read<uint8>();
+    const uint8 pointerSize = reader.read<uint8>();
+    const uint8 isLittleEndian = reader.read<uint8>();
+    const uint64 world = reader.read<uint64>();
+
+    if (reader.hasError() || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC)) != 0 || version != SNAPSHOT_VERSION ||
+        decimalSize != sizeof(decimal) || pointerSize != sizeof(void*) ||
+        isLittleEndian != static_cast<uint8>(BinaryReader::isLittleEndianMachine()) ||
+        world != static_cast<uint64>(reinterpret_cast<uintptr_t>(this))) {
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Error, Logger::Category::World,
+                 "Error when restoring a snapshot: the snapshot has not been taken in this world",  __FILE__, __LINE__);
+        return false;
+    }
+
+    Components* components[NB_SNAPSHOT_COMPONENTS] = {&mBodyComponents, &mRigidBodyComponents, &mTransformComponents,
+                                                       &mCollidersComponents, &mJointsComponents, &mBallAndSocketJointsComponents,
+                                                       &mFixedJointsComponents, &mHingeJointsComponents, &mSliderJointsComponents};
+
+    // Check the sections and the entities of the components before the world is modified
+    BinaryReader validationReader(reader);
+    bool isValid = true;
+    for (uint32 i=0; i < NB_SNAPSHOT_COMPONENTS && isValid; i++) {
+
+        const uint64 sectionSize = validationReader.read<uint64>();
+        const size_t sectionStart = validationReader.getOffset();
+        isValid = validationReader.hasRemaining(sectionSize, 1) && components[i]->validateSnapshot(validationReader) &&
+                  validationReader.getOffset() - sectionStart <= sectionSize &&
+                  validationReader.skip(sectionSize - (validationReader.getOffset() - sectionStart));
+    }
+
+    // The section of the collision detection state ends the snapshot
+    const uint64 collisionDetectionSectionSize = validationReader.read<uint64>();
+    isValid = isValid && !validationReader.hasError() && collisionDetectionSectionSize == snapshotSize - validationReader.getOffset();
+
+    if (!isValid) {
+
+        RP3D_LOG(mConfig.worldName, Logger::Level::Error, Logger::Category::World,
+                 "Error when restoring a snapshot: the snapshot does not match the bodies, colliders and joints of the world",
+                 __FILE__, __LINE__);
+        return false;
+    }
+
+    // Restore the components
+    bool isRestored = true;
+    for (uint32 i=0; i < NB_SNAPSHOT_COMPONENTS && isRestored; i++) {
+
+        const uint64 sectionSize = reader.read<uint64>();
+        const size_t sectionEnd = reader.getOffset() + sectionSize;
+        isRestored = components[i]->restoreSnapshot(reader) && reader.getOffset() == sectionEnd;
+    }
+
+    // Restore the collision detection state
+    reader.read<uint64>();
+    isRestored = isRestored && mCollisionDetection.restoreSnapshot(reader) && !reader.hasError() && reader.getOffset() == snapshotSize;
+
+    if (!isRestored) {
+
+        // The sections and the entities have been checked and therefore the content of the snapshot is corrupted
+        RP3D_LOG(mConfig.worldName, Logger::Level::Error, Logger::Category::World,
+                 "Error when restoring a snapshot: the content of the snapshot is invalid (the world has been partially restored)",
+                 __FILE__, __LINE__);
+        return false;
+    }
+
+    RP3D_LOG(mConfig.worldName, Logger::Level::Information, Logger::Category::World,
+             "Physics World: The world state has been restored from a snapshot",  __FILE__, __LINE__);
+
+    return true;
 }
 
 // Update the world inverse inertia tensors of rigid bodies
@@ -0,0 +1,321 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/engine/WorldQueryContext.h>
+#include <reactphysics3d/engine/PhysicsWorld.h>
+#include <reactphysics3d/collision/RaycastInfo.h>
+#include <reactphysics3d/collision/OverlapCallback.h>
+#include <reactphysics3d/collision/ContactPair.h>
+#include <reactphysics3d/collision/narrowphase/NarrowPhaseInput.h>
+#include <reactphysics3d/collision/shapes/CollisionShape.h>
+#include <reactphysics3d/containers/Set.h>
+#include <cmath>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+// Constructor
+/**
+ * @param world Reference to the physics world to query
+ */
+WorldQueryContext::WorldQueryContext(PhysicsWorld& world)
+                  : mWorld(world), mHeapAllocator(world.mMemoryManager.getBaseAllocator()),
+                    mPoolAllocator(mHeapAllocator) {
+
+}
+
+// Ray cast method
+/**
+ * @param ray Ray to use for raycasting
+ * @param raycastCallback Pointer to the class with the callback method
+ * @param raycastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                    bodies to be raycasted
+ */
+void WorldQueryContext::raycast(const Ray& ray, RaycastCallback* raycastCallback, uint64 raycastWithCategoryMaskBits) {
+
+    // Apply the same filtering as the raycast of the world but raycast the colliders with the allocator of the context
+    auto raycastCollider = [&](Collider* collider, const Ray& clippedRay) {
+
+        // Check if the raycast filtering mask allows raycast against this shape and if world query is enabled for this collider
+        if ((raycastWithCategoryMaskBits & collider->getCollisionCategoryBits()) == 0 || !collider->getIsWorldQueryCollider()) {
+            return decimal(-1.0);
+        }
+
+        // Ray casting test against the collision shape
+        RaycastInfo raycastInfo;
+        if (collider->raycast(clippedRay, raycastInfo, mPoolAllocator)) {
+
+            // Report the hit to the user and return the user hit fraction value
+            return raycastCallback->notifyRaycastHit(raycastInfo);
+        }
+
+        return clippedRay.maxFraction;
+    };
+
+    mWorld.mCollisionDetection.mBroadPhaseSystem.raycastColliders(ray, raycastCollider, mPoolAllocator);
+}
+
+// Return true if two bodies overlap
+/// Contrary to PhysicsWorld::testOverlap(), this method does not compute the broad-phase of the world.
+/// It directly queries the broad-phase tree and can therefore run concurrently with other queries.
+/**
+ * @param body1 Pointer to the first body
+ * @param body2 Pointer to a second body
+ * @return True if the two bodies overlap
+ */
+bool WorldQueryContext::testOverlap(Body* body1, Body* body2) {
+
+    NarrowPhaseInput narrowPhaseInput(mPoolAllocator, mWorld.mCollisionDetection.mOverlappingPairs, mPoolAllocator,
+                                      mWorld.mCollisionDetection.mTriangleHalfEdgeStructure);
+    Array<LastFrameCollisionInfo*> lastFrameInfos(mPoolAllocator);
+    Array<OverlappingPairs::ConcaveOverlappingPair*> concavePairs(mPoolAllocator);
+
+    // Compute the middle-phase collision detection between the colliders of the two bodies
+    computeMiddlePhase(body1, body2, narrowPhaseInput, lastFrameInfos, concavePairs);
+
+    bool isOverlapping = false;
+    if (narrowPhaseInput.getNbNarrowPhaseTests() > 0) {
+
+        // Compute the narrow-phase collision detection
+        isOverlapping = computeNarrowPhase(narrowPhaseInput, nullptr);
+    }
+
+    releaseMiddlePhaseData(lastFrameInfos, concavePairs);
+
+    return isOverlapping;
+}
+
+// Report all the bodies that overlap (collide) with the body in parameter
+/// Contrary to PhysicsWorld::testOverlap(), this method does not compute the broad-phase of the world.
+/// It directly queries the broad-phase tree and can therefore run concurrently with other queries.
+/**
+ * @param body Pointer to the collision body to test overlap with
+ * @param overlapCallback Pointer to the callback class to report overlap
+ */
+void WorldQueryContext::testOverlap(Body* body, OverlapCallback& overlapCallback) {
+
+    NarrowPhaseInput narrowPhaseInput(mPoolAllocator, mWorld.mCollisionDetection.mOverlappingPairs, mPoolAllocator,
+                                      mWorld.mCollisionDetection.mTriangleHalfEdgeStructure);
+    Array<LastFrameCollisionInfo*> lastFrameInfos(mPoolAllocator);
+    Array<OverlappingPairs::ConcaveOverlappingPair*> concavePairs(mPoolAllocator);
+
+    // Compute the middle-phase collision detection between the colliders of the body and the other colliders
+    computeMiddlePhase(body, nullptr, narrowPhaseInput, lastFrameInfos, concavePairs);
+
+    if (narrowPhaseInput.getNbNarrowPhaseTests() > 0) {
+
+        // Compute the narrow-phase collision detection
+        Array<ContactPair> overlapPairs(mPoolAllocator);
+        if (computeNarrowPhase(narrowPhaseInput, &overlapPairs)) {
+
+            // Report overlapping colliders
+            Array<ContactPair> lostOverlapPairs(mPoolAllocator);          // Always empty in this case (snapshot)
+            OverlapCallback::CallbackData callbackData(overlapPairs, lostOverlapPairs, false, mWorld);
+            overlapCallback.onOverlap(callbackData);
+        }
+    }
+
+    releaseMiddlePhaseData(lastFrameInfos, concavePairs);
+}
+
+// Add the narrow-phase tests between the colliders of a body and the colliders overlapping them in the broad-phase
+/// The candidate pairs are filtered the same way as the overlapping pairs of the world: the two colliders must
+/// belong to different bodies that are allowed to collide, their collision filtering bits must match and at least
+/// one of the two shapes must be convex. If otherBody is not null, only the colliders of this body are considered.
+void WorldQueryContext::computeMiddlePhase(Body* body, Body* otherBody, NarrowPhaseInput& narrowPhaseInput,
+                                           Array<LastFrameCollisionInfo*>& lastFrameInfos,
+                                           Array<OverlappingPairs::ConcaveOverlappingPair*>& concavePairs) {
+
+    CollisionDetectionSystem& collisionDetection = mWorld.mCollisionDetection;
+    const ColliderComponents& collidersComponents = mWorld.mCollidersComponents;
+    const BroadPhaseSystem& broadPhaseSystem = collisionDetection.mBroadPhaseSystem;
+
+    const Entity bodyEntity = body->getEntity();
+    const Entity otherBodyEntity = otherBody != nullptr ? otherBody->getEntity() : Entity(0, 0);
+
+    const size_t lastFrameInfoAllocatedSize = std::ceil(sizeof(LastFrameCollisionInfo) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
+
+    Array<int32> overlappingNodes(mPoolAllocator, 64);
+
+    // For each collider of the body
+    const Array<Entity>& colliderEntities = mWorld.mBodyComponents.getColliders(bodyEntity);
+    const uint32 nbColliders = static_cast<uint32>(colliderEntities.size());
+    for (uint32 c=0; c < nbColliders; c++) {
+
+        const uint32 colliderIndex = collidersComponents.getEntityIndex(colliderEntities[c]);
+
+        // If the collider is not in the broad-phase (disabled body), it cannot overlap
+        const int32 broadPhaseId = collidersComponents.mBroadPhaseIds[colliderIndex];
+        if (broadPhaseId == -1) continue;
+
+        // Get the colliders whose fat AABB overlaps with the fat AABB of this collider
+        overlappingNodes.clear();
+        broadPhaseSystem.reportAllShapesOverlappingWithAABB(broadPhaseSystem.getFatAABB(broadPhaseId), overlappingNodes, mPoolAllocator);
+
+        const uint32 nbOverlappingNodes = static_cast<uint32>(overlappingNodes.size());
+        for (uint32 n=0; n < nbOverlappingNodes; n++) {
+
+            const int32 otherBroadPhaseId = overlappingNodes[n];
+            if (otherBroadPhaseId == broadPhaseId) continue;
+
+            Collider* otherCollider = broadPhaseSystem.getColliderForBroadPhaseId(otherBroadPhaseId);
+            const uint32 otherColliderIndex = collidersComponents.getEntityIndex(otherCollider->getEntity());
+
+            // As in the overlapping pairs of the world, the first collider of the pair is the one with the
+            // smallest broad-phase id (the result of the narrow-phase can depend on the order of the shapes)
+            const bool isFirst = broadPhaseId < otherBroadPhaseId;
+            const int32 broadPhaseId1 = isFirst ? broadPhaseId : otherBroadPhaseId;
+            const int32 broadPhaseId2 = isFirst ? otherBroadPhaseId : broadPhaseId;
+            const uint32 collider1Index = isFirst ? colliderIndex : otherColliderIndex;
+            const uint32 collider2Index = isFirst ? otherColliderIndex : colliderIndex;
+
+            // If the two colliders are from the same body or if the other collider is not from the requested body, skip them
+            const Entity otherColliderBodyEntity = collidersComponents.mBodiesEntities[otherColliderIndex];
+            if (otherColliderBodyEntity == bodyEntity || (otherBody != nullptr && otherColliderBodyEntity != otherBodyEntity)) continue;
+
+            // Check if the bodies are in the set of bodies that cannot collide between each other
+            if (collisionDetection.mNoCollisionPairs.contains(OverlappingPairs::computeBodiesIndexPair(bodyEntity, otherColliderBodyEntity))) continue;
+
+            // Check if the collision filtering allows collision between the two shapes
+            if ((collidersComponents.mCollideWithMaskBits[collider1Index] & collidersComponents.mCollisionCategoryBits[collider2Index]) == 0 ||
+                (collidersComponents.mCollisionCategoryBits[collider1Index] & collidersComponents.mCollideWithMaskBits[collider2Index]) == 0) {
+                continue;
+            }
+
+            // Check that at least one collision shape is convex
+            CollisionShape* shape1 = collidersComponents.mCollisionShapes[collider1Index];
+            CollisionShape* shape2 = collidersComponents.mCollisionShapes[collider2Index];
+            const bool isShape1Convex = shape1->isConvex();
+            const bool isShape2Convex = shape2->isConvex();
+            if (!isShape1Convex && !isShape2Convex) continue;
+
+            const Entity collider1Entity = collidersComponents.mCollidersEntities[collider1Index];
+            const Entity collider2Entity = collidersComponents.mCollidersEntities[collider2Index];
+
+            // Compute the overlapping pair ID
+            const uint64 pairId = pairNumbers(std::max(broadPhaseId1, broadPhaseId2), std::min(broadPhaseId1, broadPhaseId2));
+
+            if (isShape1Convex && isShape2Convex) {
+
+                const NarrowPhaseAlgorithmType algorithmType = collisionDetection.mCollisionDispatch.selectNarrowPhaseAlgorithm(shape1->getType(), shape2->getType());
+                if (algorithmType == NarrowPhaseAlgorithmType::NoCollisionTest) continue;
+
+                // The temporal coherence data of the narrow-phase is only used for this query
+                LastFrameCollisionInfo* lastFrameInfo = new (mPoolAllocator.allocate(lastFrameInfoAllocatedSize)) LastFrameCollisionInfo();
+                lastFrameInfos.add(lastFrameInfo);
+
+                narrowPhaseInput.addNarrowPhaseTest(pairId, collider1Entity, collider2Entity, shape1, shape2,
+                                                    collidersComponents.mLocalToWorldTransforms[collider1Index],
+                                                    collidersComponents.mLocalToWorldTransforms[collider2Index],
+                                                    algorithmType, false, lastFrameInfo);
+            }
+            else {
+
+                const NarrowPhaseAlgorithmType algorithmType = collisionDetection.mCollisionDispatch.selectNarrowPhaseAlgorithm(isShape1Convex ? shape1->getType() : shape2->getType(),
+                                                                                                                                 CollisionShapeType::CONVEX_POLYHEDRON);
+                if (algorithmType == NarrowPhaseAlgorithmType::NoCollisionTest) continue;
+
+                // Create a temporary concave pair that holds the temporal coherence data of the triangles
+                OverlappingPairs::ConcaveOverlappingPair* concavePair = new (mPoolAllocator.allocate(sizeof(OverlappingPairs::ConcaveOverlappingPair)))
+                        OverlappingPairs::ConcaveOverlappingPair(pairId, broadPhaseId1, broadPhaseId2, collider1Entity, collider2Entity, algorithmType,
+                                                                 isShape1Convex, mPoolAllocator, mHeapAllocator, true);
+                concavePairs.add(concavePair);
+
+                collisionDetection.computeConvexVsConcaveMiddlePhase(*concavePair, mPoolAllocator, narrowPhaseInput, false);
+            }
+        }
+    }
+}
+
+// Release the temporary data created by the middle-phase of a query
+void WorldQueryContext::releaseMiddlePhaseData(Array<LastFrameCollisionInfo*>& lastFrameInfos,
+                                               Array<OverlappingPairs::ConcaveOverlappingPair*>& concavePairs) {
+
+    const size_t lastFrameInfoAllocatedSize = std::ceil(sizeof(LastFrameCollisionInfo) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
+
+    const uint32 nbLastFrameInfos = static_cast<uint32>(lastFrameInfos.size());
+    for (uint32 i=0; i < nbLastFrameInfos; i++) {
+        lastFrameInfos[i]->LastFrameCollisionInfo::~LastFrameCollisionInfo();
+        mPoolAllocator.release(lastFrameInfos[i], lastFrameInfoAllocatedSize);
+    }
+    lastFrameInfos.clear();
+
+    const uint32 nbConcavePairs = static_cast<uint32>(concavePairs.size());
+    for (uint32 i=0; i < nbConcavePairs; i++) {
+        concavePairs[i]->destroyLastFrameCollisionInfos();
+        concavePairs[i]->~ConcaveOverlappingPair();
+        mPoolAllocator.release(concavePairs[i], sizeof(OverlappingPairs::ConcaveOverlappingPair));
+    }
+    concavePairs.clear();
+}
+
+// Run the narrow-phase and fill the array with the overlapping pairs of colliders (if not null)
+/// This method returns true if at least one pair of colliders overlaps.
+bool WorldQueryContext::computeNarrowPhase(NarrowPhaseInput& narrowPhaseInput, Array<ContactPair>* overlapPairs) {
+
+    // Test the narrow-phase collision detection on the batches to be tested
+    const bool collisionFound = mWorld.mCollisionDetection.testNarrowPhaseCollision(narrowPhaseInput, false, mPoolAllocator);
+    if (!collisionFound || overlapPairs == nullptr) return collisionFound;
+
+    const ColliderComponents& collidersComponents = mWorld.mCollidersComponents;
+
+    // A pair with a concave shape has one narrow-phase test per triangle but must only be reported once
+    Set<uint64> reportedPairIds(mPoolAllocator);
+
+    NarrowPhaseInfoBatch* batches[] = {&narrowPhaseInput.getSphereVsSphereBatch(), &narrowPhaseInput.getSphereVsCapsuleBatch(),
+                                       &narrowPhaseInput.getCapsuleVsCapsuleBatch(), &narrowPhaseInput.getSphereVsConvexPolyhedronBatch(),
+                                       &narrowPhaseInput.getCapsuleVsConvexPolyhedronBatch(),
+                                       &narrowPhaseInput.getConvexPolyhedronVsConvexPolyhedronBatch()};
+
+    for (NarrowPhaseInfoBatch* batch : batches) {
+
+        // For each narrow phase info object
+        for (uint32 i=0; i < batch->getNbObjects(); i++) {
+
+            const NarrowPhaseInfoBatch::NarrowPhaseInfo& narrowPhaseInfo = batch->narrowPhaseInfos[i];
+
+            // If there is a collision and the pair has not been reported yet
+            if (narrowPhaseInfo.isColliding && !reportedPairIds.contains(narrowPhaseInfo.overlappingPairId)) {
+
+                const uint32 collider1Index = collidersComponents.getEntityIndex(narrowPhaseInfo.colliderEntity1);
+                const uint32 collider2Index = collidersComponents.getEntityIndex(narrowPhaseInfo.colliderEntity2);
+
+                const bool isTrigger = collidersComponents.mIsTrigger[collider1Index] || collidersComponents.mIsTrigger[collider2Index];
+
+                // Create a new overlap pair
+                overlapPairs->emplace(narrowPhaseInfo.overlappingPairId, collidersComponents.mBodiesEntities[collider1Index],
+                                      collidersComponents.mBodiesEntities[collider2Index], narrowPhaseInfo.colliderEntity1,
+                                      narrowPhaseInfo.colliderEntity2, static_cast<uint32>(overlapPairs->size()), false, isTrigger);
+
+                reportedPairIds.add(narrowPhaseInfo.overlappingPairId);
+            }
+
+            batch->resetContactPoints(i);
+        }
+    }
+
+    return true;
+}
@@ -25,11 +25,14 @@
 
 // Libraries
 #include <reactphysics3d/systems/BroadPhaseSystem.h>
+#include <reactphysics3d/collision/broadphase/SweepAndPruneBroadPhase.h>
+#include <reactphysics3d/collision/broadphase/UniformGridBroadPhase.h>
 #include <reactphysics3d/systems/CollisionDetectionSystem.h>
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
 #include <reactphysics3d/memory/MemoryManager.h>
 #include <reactphysics3d/engine/PhysicsWorld.h>
+#include <reactphysics3d/body/Body.h>
 
 // We want to use the ReactPhysics3D namespace
 using namespace reactphysics3d;
@@ -38,6 +41,12 @@ using namespace reactphysics3d;
 BroadPhaseSystem::BroadPhaseSystem(CollisionDetectionSystem& collisionDetection, ColliderComponents& collidersComponents,
                                    TransformComponents& transformComponents, RigidBodyComponents& rigidBodyComponents)
                     :mDynamicAABBTree(collisionDetection.getMemoryManager().getHeapAllocator(), DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE),
+                     mBackend(nullptr), mCompoundsTree(collisionDetection.getMemoryManager().getHeapAllocator(), DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE),
+                     mCompoundProxies(collisionDetection.getMemoryManager().getHeapAllocator()),
+                     mCompoundColliders(collisionDetection.getMemoryManager().getHeapAllocator()),
+                     mFreeCompoundColliders(collisionDetection.getMemoryManager().getHeapAllocator()),
+                     mTreeUpdateMethod(DynamicAABBTreeUpdateMethod::REINSERT), mMaxNbTreeRotations(0),
+                     mIsPredictiveFatAABBEnabled(false), mTimeStep(0), mNbReinsertions(0),
                      mCollidersComponents(collidersComponents), mTransformsComponents(transformComponents),
                      mRigidBodyComponents(rigidBodyComponents), mMovedShapes(collisionDetection.getMemoryManager().getHeapAllocator()),
                      mCollisionDetection(collisionDetection) {
@@ -51,6 +60,79 @@ BroadPhaseSystem::BroadPhaseSystem(CollisionDetectionSystem& collisionDetection,
 
 }
 
+// Destructor
+BroadPhaseSystem::~BroadPhaseSystem() {
+
+    MemoryAllocator& allocator = mCollisionDetection.getMemoryManager().getHeapAllocator();
+
+    // Destroy the remaining compound proxies
+    for (auto it = mCompoundProxies.begin(); it != mCompoundProxies.end(); ++it) {
+        it->second->~CompoundProxy();
+        allocator.release(it->second, sizeof(CompoundProxy));
+    }
+
+    destroyBackend();
+}
+
+// Destroy the broad-phase backend (if any)
+void BroadPhaseSystem::destroyBackend() {
+
+    if (mBackend == nullptr) return;
+
+    MemoryAllocator& allocator = mCollisionDetection.getMemoryManager().getHeapAllocator();
+
+    if (mBackend->getMethod() == BroadPhaseMethod::SWEEP_AND_PRUNE) {
+        static_cast<SweepAndPruneBroadPhase*>(mBackend)->~SweepAndPruneBroadPhase();
+        allocator.release(mBackend, sizeof(SweepAndPruneBroadPhase));
+    }
+    else {
+        static_cast<UniformGridBroadPhase*>(mBackend)->~UniformGridBroadPhase();
+        allocator.release(mBackend, sizeof(UniformGridBroadPhase));
+    }
+
+    mBackend = nullptr;
+}
+
+// Set the data structure used for the colliders that are not in a compound body
+/// This method must be called before any collider is added into the broad-phase.
+/**
+ * @param method The broad-phase method
+ * @param gridCellSize The size of the cells of the grid (UNIFORM_GRID method only)
+ */
+void BroadPhaseSystem::setBroadPhaseMethod(BroadPhaseMethod method, decimal gridCellSize) {
+
+    assert(mDynamicAABBTree.isEmpty() && (mBackend == nullptr || mBackend->isEmpty()));
+
+    destroyBackend();
+
+    MemoryAllocator& allocator = mCollisionDetection.getMemoryManager().getHeapAllocator();
+
+    switch (method) {
+
+        case BroadPhaseMethod::SWEEP_AND_PRUNE:
+            mBackend = new (allocator.allocate(sizeof(SweepAndPruneBroadPhase)))
+                    SweepAndPruneBroadPhase(allocator, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE);
+            break;
+
+        case BroadPhaseMethod::UNIFORM_GRID:
+            mBackend = new (allocator.allocate(sizeof(UniformGridBroadPhase)))
+                    UniformGridBroadPhase(allocator, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE, gridCellSize);
+            break;
+
+        case BroadPhaseMethod::DYNAMIC_AABB_TREE:
+            break;
+    }
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    if (mBackend != nullptr) {
+        mBackend->setProfiler(mProfiler);
+    }
+
+#endif
+
+}
+
 // Return true if the two broad-phase collision shapes are overlapping
 bool BroadPhaseSystem::testOverlappingShapes(int32 shape1BroadPhaseId, int32 shape2BroadPhaseId) const {
 
@@ -59,21 +141,372 @@ bool BroadPhaseSystem::testOverlappingShapes(int32 shape1BroadPhaseId, int32 sha
     assert(shape1BroadPhaseId != -1 && shape2BroadPhaseId != -1);
 
     // Get the two AABBs of the collision shapes
-    const AABB& aabb1 = mDynamicAABBTree.getFatAABB(shape1BroadPhaseId);
-    const AABB& aabb2 = mDynamicAABBTree.getFatAABB(shape2BroadPhaseId);
+    const AABB& aabb1 = getFatAABB(shape1BroadPhaseId);
+    const AABB& aabb2 = getFatAABB(shape2BroadPhaseId);
 
     // Check if the two AABBs are overlapping
     return aabb1.testCollision(aabb2);
 }
 
 // Ray casting method
-void BroadPhaseSystem::raycast(const Ray& ray, RaycastTest& raycastTest, unsigned short raycastWithCategoryMaskBits) const {
+void BroadPhaseSystem::raycast(const Ray& ray, RaycastTest& raycastTest, uint64 raycastWithCategoryMaskBits) const {
 
     RP3D_PROFILE("BroadPhaseSystem::raycast()", mProfiler);
 
-    BroadPhaseRaycastCallback broadPhaseRaycastCallback(mDynamicAABBTree, raycastWithCategoryMaskBits, raycastTest);
+    auto raycastCollider = [&](Collider* collider, const Ray& clippedRay) {
+
+        // Check if the raycast filtering mask allows raycast against this shape and if world query is enabled for this collider
+        if ((raycastWithCategoryMaskBits & collider->getCollisionCategoryBits()) == 0 || !collider->getIsWorldQueryCollider()) {
+            return decimal(-1.0);
+        }
+
+        // Ask the collision detection to perform a ray cast test against
+        // the collider because the ray is overlapping with the shape in the broad-phase
+        return raycastTest.raycastAgainstShape(collider, clippedRay);
+    };
+
+    raycastColliders(ray, raycastCollider, mCollisionDetection.getMemoryManager().getHeapAllocator());
+}
+
+// Return true if a ray hits at least one collider
+/// The traversal of the tree stops at the first hit and the hit point and normal are never computed.
+/**
+ * @param ray Ray in world-space
+ * @param raycastWithCategoryMaskBits Bits mask corresponding to the category of colliders to be raycasted
+ * @param allocator Allocator for the temporary memory of the raycast
+ * @return True if the ray hits at least one collider
+ */
+bool BroadPhaseSystem::raycastAny(const Ray& ray, uint64 raycastWithCategoryMaskBits, MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("BroadPhaseSystem::raycastAny()", mProfiler);
+
+    bool isHit = false;
+
+    auto testCollider = [&](Collider* collider, const Ray& clippedRay) {
+
+        const uint32 colliderIndex = mCollidersComponents.getEntityIndex(collider->getEntity());
+
+        // Check if the raycast filtering mask allows raycast against this collider and if world query is enabled for this collider
+        if ((raycastWithCategoryMaskBits & mCollidersComponents.mCollisionCategoryBits[colliderIndex]) == 0 ||
+            !mCollidersComponents.mIsWorldQueryCollider[colliderIndex]) {
+            return decimal(-1.0);
+        }
+
+        // Stop the raycasting at the first hit
+        if (collider->testRayHit(clippedRay, allocator)) {
+            isHit = true;
+            return decimal(0.0);
+        }
+
+        return decimal(-1.0);
+    };
+
+    raycastColliders(ray, testCollider, allocator);
+
+    return isHit;
+}
+
+// Compute the closest hit of a ray with the colliders
+/// This is equivalent to a raycast() with a callback that always returns the hit fraction but
+/// without any virtual call per hit collider.
+/**
+ * @param ray Ray in world-space
+ * @param raycastWithCategoryMaskBits Bits mask corresponding to the category of colliders to be raycasted
+ * @param[out] outRaycastInfo Information about the closest hit (only valid if the method returns true)
+ * @param allocator Allocator for the temporary memory of the raycast
+ * @return True if the ray hits at least one collider
+ */
+bool BroadPhaseSystem::raycastClosest(const Ray& ray, uint64 raycastWithCategoryMaskBits, RaycastInfo& outRaycastInfo,
+                                      MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("BroadPhaseSystem::raycastClosest()", mProfiler);
+
+    bool isHit = false;
+
+    auto raycastCollider = [&](Collider* collider, const Ray& clippedRay) {
+
+        const uint32 colliderIndex = mCollidersComponents.getEntityIndex(collider->getEntity());
+
+        // Check if the raycast filtering mask allows raycast against this collider and if world query is enabled for this collider
+        if ((raycastWithCategoryMaskBits & mCollidersComponents.mCollisionCategoryBits[colliderIndex]) == 0 ||
+            !mCollidersComponents.mIsWorldQueryCollider[colliderIndex]) {
+            return decimal(-1.0);
+        }
+
+        // Raycast against the collider with the ray clipped at the closest hit so far
+        RaycastInfo raycastInfo;
+        if (!collider->raycast(clippedRay, raycastInfo, allocator)) return decimal(-1.0);
+
+        isHit = true;
+        outRaycastInfo.worldPoint = raycastInfo.worldPoint;
+        outRaycastInfo.worldNormal = raycastInfo.worldNormal;
+        outRaycastInfo.hitFraction = raycastInfo.hitFraction;
+        outRaycastInfo.triangleIndex = raycastInfo.triangleIndex;
+        outRaycastInfo.body = raycastInfo.body;
+        outRaycastInfo.collider = raycastInfo.collider;
+
+        // Clip the ray at the hit point
+        return raycastInfo.hitFraction;
+    };
+
+    raycastColliders(ray, raycastCollider, allocator);
+
+    return isHit;
+}
+
+// Call a function with the broad-phase id of each collider of the compound bodies whose fat AABB is accepted by a volume test
+/// The volume test is first applied to the node of each compound body and then to the tree of its colliders.
+/// The colliders of the compound body in parameter (if any) are not reported.
+template<typename VolumeTest, typename ColliderFunction>
+void BroadPhaseSystem::reportCompoundCollidersOverlappingWithVolume(const VolumeTest& volumeTest, ColliderFunction& colliderFunction,
+                                                                    MemoryAllocator& allocator, const CompoundProxy* ignoredProxy) const {
+
+    if (mCompoundsTree.isEmpty()) return;
+
+    auto reportCompound = [&](int32 nodeId) {
+
+        const CompoundProxy* proxy = static_cast<const CompoundProxy*>(mCompoundsTree.getNodeDataPointer(nodeId));
+        if (proxy == ignoredProxy) return;
+
+        auto reportCollider = [&](int32 colliderNodeId) {
+            colliderFunction(proxy->collidersTree.getNodeDataInt(colliderNodeId));
+        };
+
+        proxy->collidersTree.reportAllShapesOverlappingWithVolume(volumeTest, reportCollider, allocator);
+    };
+
+    mCompoundsTree.reportAllShapesOverlappingWithVolume(volumeTest, reportCompound, allocator);
+}
+
+// Report the broad-phase ids of all the colliders whose fat AABB overlaps with a given AABB
+void BroadPhaseSystem::reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes, MemoryAllocator& allocator) const {
+
+    if (mBackend != nullptr) {
+        mBackend->reportAllShapesOverlappingWithAABB(aabb, overlappingNodes);
+    }
+    else if (!mDynamicAABBTree.isEmpty()) {     // The tree cannot be traversed if it is empty
+        mDynamicAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingNodes, allocator);
+    }
+
+    auto addCollider = [&overlappingNodes](int32 broadPhaseId) { overlappingNodes.add(broadPhaseId); };
+    reportCompoundCollidersOverlappingWithVolume([&aabb](const AABB& nodeAABB) { return aabb.testCollision(nodeAABB); },
+                                                 addCollider, allocator);
+}
+
+namespace {
+
+// Class DistanceTrackingCallback
+// Distance callback that keeps track of the search distance returned by the callback of a query
+// so that the search can continue in another tree. If a tree of colliders is set, the node ids of
+// this tree are replaced by the broad-phase ids of the colliders before calling the callback.
+class DistanceTrackingCallback : public DynamicAABBTreeDistanceCallback {
+
+    private:
+
+        DynamicAABBTreeDistanceCallback& mCallback;
+
+        const DynamicAABBTree* mCollidersTree;
+
+    public:
+
+        /// Current search distance (negative if the query has been stopped)
+        decimal maxDistance;
+
+        // Constructor
+        DistanceTrackingCallback(DynamicAABBTreeDistanceCallback& callback, const DynamicAABBTree* collidersTree, decimal maxDistance)
+            : mCallback(callback), mCollidersTree(collidersTree), maxDistance(maxDistance) {
+
+        }
+
+        // Called when the AABB of a leaf node is within the search distance
+        decimal notifyNodeWithinDistance(int32 nodeId, decimal distance) override {
+
+            const int32 broadPhaseId = mCollidersTree != nullptr ? mCollidersTree->getNodeDataInt(nodeId) : nodeId;
+            const decimal newDistance = mCallback.notifyNodeWithinDistance(broadPhaseId, distance);
+            if (newDistance < maxDistance) {
+                maxDistance = newDistance;
+            }
+
+            return newDistance;
+        }
+};
+
+// Class CompoundsDistanceCallback
+// Distance callback of the compounds tree that searches the tree of colliders of each compound body
+class CompoundsDistanceCallback : public DynamicAABBTreeDistanceCallback {
+
+    private:
+
+        const DynamicAABBTree& mCompoundsTree;
+
+        const AABB& mAABB;
+
+        DynamicAABBTreeDistanceCallback& mCallback;
+
+        MemoryAllocator& mAllocator;
+
+        /// Returns the tree of colliders of a compound body from its node in the compounds tree
+        const DynamicAABBTree& (*mGetCollidersTree)(const void* nodeData);
+
+    public:
+
+        // Constructor
+        CompoundsDistanceCallback(const DynamicAABBTree& compoundsTree, const AABB& aabb, DynamicAABBTreeDistanceCallback& callback,
+                                  MemoryAllocator& allocator, const DynamicAABBTree& (*getCollidersTree)(const void* nodeData))
+            : mCompoundsTree(compoundsTree), mAABB(aabb), mCallback(callback), mAllocator(allocator),
+              mGetCollidersTree(getCollidersTree) {
+
+        }
+
+        // Called when the AABB of a compound body is within the search distance
+        decimal notifyNodeWithinDistance(int32 nodeId, decimal distance) override {
+
+            const DynamicAABBTree& collidersTree = mGetCollidersTree(mCompoundsTree.getNodeDataPointer(nodeId));
+
+            DistanceTrackingCallback collidersCallback(mCallback, &collidersTree, distance);
+            collidersTree.reportShapesWithinDistance(mAABB, distance, collidersCallback, mAllocator);
+
+            return collidersCallback.maxDistance;
+        }
+};
+
+}
+
+// Report the broad-phase ids of the colliders whose fat AABB is within a shrinking distance of a given AABB
+void BroadPhaseSystem::reportShapesWithinDistance(const AABB& aabb, decimal maxDistance, DynamicAABBTreeDistanceCallback& callback,
+                                                  MemoryAllocator& allocator) const {
+
+    if (mCompoundsTree.isEmpty()) {
+        if (mBackend != nullptr) {
+            mBackend->reportShapesWithinDistance(aabb, maxDistance, callback);
+        }
+        else {
+            mDynamicAABBTree.reportShapesWithinDistance(aabb, maxDistance, callback, allocator);
+        }
+        return;
+    }
+
+    DistanceTrackingCallback distanceCallback(callback, nullptr, maxDistance);
+    if (mBackend != nullptr) {
+        mBackend->reportShapesWithinDistance(aabb, maxDistance, distanceCallback);
+    }
+    else {
+        mDynamicAABBTree.reportShapesWithinDistance(aabb, maxDistance, distanceCallback, allocator);
+    }
+
+    // If the query has not been stopped, search the compound bodies within the distance found so far
+    if (distanceCallback.maxDistance >= decimal(0.0)) {
+
+        auto getCollidersTree = [](const void* nodeData) -> const DynamicAABBTree& {
+            return static_cast<const CompoundProxy*>(nodeData)->collidersTree;
+        };
+
+        CompoundsDistanceCallback compoundsCallback(mCompoundsTree, aabb, callback, allocator, getCollidersTree);
+        mCompoundsTree.reportShapesWithinDistance(aabb, distanceCallback.maxDistance, compoundsCallback, allocator);
+    }
+}
+
+// Report the colliders whose AABB is accepted by a volume test
+/// The colliders are filtered with the category mask and the world-query flag while the tree is traversed.
+/// If useExactAABB is true, the exact AABB of each collider whose fat AABB passes the test is tested again.
+template<typename VolumeTest>
+void BroadPhaseSystem::reportCollidersOverlappingWithVolume(const VolumeTest& volumeTest, uint64 categoryMaskBits, bool useExactAABB,
+                                                            Array<Collider*>& outColliders, MemoryAllocator& allocator) const {
+
+    outColliders.clear();
+
+    auto reportCollider = [&](Collider* collider) {
+
+        const uint32 colliderIndex = mCollidersComponents.getEntityIndex(collider->getEntity());
+
+        // Check if the filtering mask allows the query against this collider and if world query is enabled for this collider
+        if ((categoryMaskBits & mCollidersComponents.mCollisionCategoryBits[colliderIndex]) == 0 ||
+            !mCollidersComponents.mIsWorldQueryCollider[colliderIndex]) {
+            return;
+        }
+
+        if (useExactAABB && !volumeTest(mCollidersComponents.mCollisionShapes[colliderIndex]->computeTransformedAABB(
+                                        mCollidersComponents.mLocalToWorldTransforms[colliderIndex]))) {
+            return;
+        }
+
+        outColliders.add(collider);
+    };
+
+    auto reportCompoundCollider = [&](int32 broadPhaseId) {
+        reportCollider(getColliderForBroadPhaseId(broadPhaseId));
+    };
+
+    if (mBackend != nullptr) {
+
+        auto reportProxy = [&](int32 proxyId) {
+            reportCollider(mBackend->getCollider(proxyId));
+        };
+
+        mBackend->reportAllShapesOverlappingWithVolume(volumeTest, reportProxy);
+    }
+    else {
+
+        auto reportLeaf = [&](int32 nodeId) {
+            reportCollider(static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(nodeId)));
+        };
+
+        mDynamicAABBTree.reportAllShapesOverlappingWithVolume(volumeTest, reportLeaf, allocator);
+    }
+
+    reportCompoundCollidersOverlappingWithVolume(volumeTest, reportCompoundCollider, allocator);
+}
+
+// Report the colliders whose AABB overlaps with a given AABB
+/**
+ * @param aabb AABB of the query in world-space
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB True if the exact AABB of the colliders has to be tested (instead of the fat AABB only)
+ * @param[out] outColliders Array with the colliders overlapping with the AABB (cleared first)
+ * @param allocator Allocator for the stack of the tree traversal
+ */
+void BroadPhaseSystem::reportCollidersOverlappingWithAABB(const AABB& aabb, uint64 categoryMaskBits, bool useExactAABB,
+                                                          Array<Collider*>& outColliders, MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("BroadPhaseSystem::reportCollidersOverlappingWithAABB()", mProfiler);
+
+    reportCollidersOverlappingWithVolume([&aabb](const AABB& nodeAABB) { return aabb.testCollision(nodeAABB); },
+                                         categoryMaskBits, useExactAABB, outColliders, allocator);
+}
+
+// Report the colliders whose AABB overlaps with a given sphere
+/**
+ * @param center Center of the sphere in world-space
+ * @param radius Radius of the sphere
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB True if the exact AABB of the colliders has to be tested (instead of the fat AABB only)
+ * @param[out] outColliders Array with the colliders overlapping with the sphere (cleared first)
+ * @param allocator Allocator for the stack of the tree traversal
+ */
+void BroadPhaseSystem::reportCollidersOverlappingWithSphere(const Vector3& center, decimal radius, uint64 categoryMaskBits, bool useExactAABB,
+                                                            Array<Collider*>& outColliders, MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("BroadPhaseSystem::reportCollidersOverlappingWithSphere()", mProfiler);
+
+    reportCollidersOverlappingWithVolume([&center, radius](const AABB& nodeAABB) { return nodeAABB.testCollisionWithSphere(center, radius); },
+                                         categoryMaskBits, useExactAABB, outColliders, allocator);
+}
 
-    mDynamicAABBTree.raycast(ray, broadPhaseRaycastCallback);
+// Report the colliders whose AABB overlaps with a given frustum
+/**
+ * @param frustum Frustum of the query in world-space
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be reported
+ * @param useExactAABB True if the exact AABB of the colliders has to be tested (instead of the fat AABB only)
+ * @param[out] outColliders Array with the colliders overlapping with the frustum (cleared first)
+ * @param allocator Allocator for the stack of the tree traversal
+ */
+void BroadPhaseSystem::reportCollidersOverlappingWithFrustum(const Frustum& frustum, uint64 categoryMaskBits, bool useExactAABB,
+                                                             Array<Collider*>& outColliders, MemoryAllocator& allocator) const {
+
+    RP3D_PROFILE("BroadPhaseSystem::reportCollidersOverlappingWithFrustum()", mProfiler);
+
+    reportCollidersOverlappingWithVolume([&frustum](const AABB& nodeAABB) { return nodeAABB.testCollisionWithFrustum(frustum); },
+                                         categoryMaskBits, useExactAABB, outColliders, allocator);
 }
 
 // Add a collider into the broad-phase collision detection
@@ -81,8 +514,14 @@ void BroadPhaseSystem::addCollider(Collider* collider, const AABB& aabb) {
 
     assert(collider->getBroadPhaseId() == -1);
 
-    // Add the collision shape into the dynamic AABB tree and get its broad-phase ID
-    int nodeId = mDynamicAABBTree.addObject(aabb, collider);
+    // The colliders of a compound body are stored in the tree of the body
+    if (collider->getBody()->isCompoundBroadPhase()) {
+        addCompoundCollider(collider, aabb);
+        return;
+    }
+
+    // Add the collision shape into the dynamic AABB tree (or the backend) and get its broad-phase ID
+    int nodeId = mBackend != nullptr ? mBackend->addObject(aabb, collider) : mDynamicAABBTree.addObject(aabb, collider);
 
     // Set the broad-phase ID of the collider
     mCollidersComponents.setBroadPhaseId(collider->getEntity(), nodeId);
@@ -99,16 +538,120 @@ void BroadPhaseSystem::removeCollider(Collider* collider) {
 
     int broadPhaseID = collider->getBroadPhaseId();
 
+    if (isCompoundBroadPhaseId(broadPhaseID)) {
+        removeCompoundCollider(collider);
+        return;
+    }
+
     mCollidersComponents.setBroadPhaseId(collider->getEntity(), -1);
 
-    // Remove the collision shape from the dynamic AABB tree
-    mDynamicAABBTree.removeObject(broadPhaseID);
+    // Remove the collision shape from the dynamic AABB tree (or the backend)
+    if (mBackend != nullptr) {
+        mBackend->removeObject(broadPhaseID);
+    }
+    else {
+        mDynamicAABBTree.removeObject(broadPhaseID);
+    }
 
     // Remove the collision shape into the array of shapes that have moved (or have been created)
     // during the last simulation step
     removeMovedCollider(broadPhaseID);
 }
 
+// Add a collider of a compound body into the broad-phase
+/// The collider is added in the tree of its body. The compound proxy of the body (with its node
+/// in the compounds tree) is created with the first collider of the body.
+void BroadPhaseSystem::addCompoundCollider(Collider* collider, const AABB& aabb) {
+
+    MemoryAllocator& allocator = mCollisionDetection.getMemoryManager().getHeapAllocator();
+
+    // Get or create the compound proxy of the body
+    const Entity bodyEntity = collider->getBody()->getEntity();
+    CompoundProxy* proxy;
+    auto it = mCompoundProxies.find(bodyEntity);
+    if (it != mCompoundProxies.end()) {
+        proxy = it->second;
+    }
+    else {
+        proxy = new (allocator.allocate(sizeof(CompoundProxy))) CompoundProxy(bodyEntity, allocator);
+        mCompoundProxies.add(Pair<Entity, CompoundProxy*>(bodyEntity, proxy));
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+        proxy->collidersTree.setProfiler(mProfiler);
+
+#endif
+
+    }
+
+    // Get a free slot for the collider
+    uint32 slot;
+    if (mFreeCompoundColliders.size() > 0) {
+        slot = mFreeCompoundColliders[mFreeCompoundColliders.size() - 1];
+        mFreeCompoundColliders.removeAt(mFreeCompoundColliders.size() - 1);
+    }
+    else {
+        slot = static_cast<uint32>(mCompoundColliders.size());
+        mCompoundColliders.add(CompoundCollider());
+    }
+
+    const int32 broadPhaseId = COMPOUND_BROAD_PHASE_ID_OFFSET + static_cast<int32>(slot);
+
+    // Add the collider into the tree of the body
+    CompoundCollider& compoundCollider = mCompoundColliders[slot];
+    compoundCollider.collider = collider;
+    compoundCollider.proxy = proxy;
+    compoundCollider.nodeId = proxy->collidersTree.addObject(aabb, static_cast<uint32>(broadPhaseId));
+
+    // Add or update the node of the body in the compounds tree
+    if (proxy->nodeId == -1) {
+        proxy->nodeId = mCompoundsTree.addObject(proxy->collidersTree.getRootAABB(), proxy);
+    }
+    else {
+        mCompoundsTree.updateObject(proxy->nodeId, proxy->collidersTree.getRootAABB());
+    }
+
+    // Set the broad-phase ID of the collider
+    mCollidersComponents.setBroadPhaseId(collider->getEntity(), broadPhaseId);
+
+    // Add the collider into the array of colliders that have moved (or have been created)
+    // during the last simulation step
+    addMovedCollider(broadPhaseId, collider);
+}
+
+// Remove a collider of a compound body from the broad-phase
+/// The compound proxy of the body is destroyed with its last collider.
+void BroadPhaseSystem::removeCompoundCollider(Collider* collider) {
+
+    const int32 broadPhaseId = collider->getBroadPhaseId();
+    const uint32 slot = static_cast<uint32>(broadPhaseId - COMPOUND_BROAD_PHASE_ID_OFFSET);
+
+    mCollidersComponents.setBroadPhaseId(collider->getEntity(), -1);
+
+    // Remove the collider from the tree of the body
+    CompoundCollider& compoundCollider = mCompoundColliders[slot];
+    CompoundProxy* proxy = compoundCollider.proxy;
+    proxy->collidersTree.removeObject(compoundCollider.nodeId);
+
+    compoundCollider.collider = nullptr;
+    compoundCollider.proxy = nullptr;
+    compoundCollider.nodeId = -1;
+    mFreeCompoundColliders.add(slot);
+
+    // If it was the last collider of the body, destroy the compound proxy
+    if (proxy->collidersTree.isEmpty()) {
+
+        mCompoundsTree.removeObject(proxy->nodeId);
+        mCompoundProxies.remove(proxy->bodyEntity);
+
+        MemoryAllocator& allocator = mCollisionDetection.getMemoryManager().getHeapAllocator();
+        proxy->~CompoundProxy();
+        allocator.release(proxy, sizeof(CompoundProxy));
+    }
+
+    removeMovedCollider(broadPhaseId);
+}
+
 // Update the broad-phase state of a single collider
 void BroadPhaseSystem::updateCollider(Entity colliderEntity) {
 
@@ -117,42 +660,149 @@ void BroadPhaseSystem::updateCollider(Entity colliderEntity) {
     // Get the index of the collider component in the array
     const uint32 index = mCollidersComponents.mMapEntityToComponentIndex[colliderEntity];
 
-    // Update the collider component
-    updateCollidersComponents(index, 1);
+    // Update the collider component (the margins of the body are not adapted outside of a step)
+    updateCollidersComponents(index, 1, false);
 }
 
-// Update the broad-phase state of all the enabled colliders
-void BroadPhaseSystem::updateColliders() {
+// Update the broad-phase state of all the enabled colliders at the end of a step
+/**
+ * @param timeStep The time step of the simulation step (used to predict the displacement of the bodies)
+ */
+void BroadPhaseSystem::updateColliders(decimal timeStep) {
 
     RP3D_PROFILE("BroadPhaseSystem::updateColliders()", mProfiler);
 
+    mTimeStep = timeStep;
+    mNbReinsertions = 0;
+
     // Update all the enabled collider components
     if (mCollidersComponents.getNbEnabledComponents() > 0) {
-        updateCollidersComponents(0, mCollidersComponents.getNbEnabledComponents());
+        updateCollidersComponents(0, mCollidersComponents.getNbEnabledComponents(), mIsPredictiveFatAABBEnabled);
+    }
+
+    if (mIsPredictiveFatAABBEnabled) {
+        updateFatAABBMarginScales();
+    }
+}
+
+// Compute the fat AABB of a collider from its AABB, a margin scale and a predicted displacement
+/// The AABB is inflated by the constant percentage of its size (multiplied by the margin scale) and
+/// is then extended on the side of the predicted displacement of the collider. With a margin scale
+/// of one and no displacement, this is the same fat AABB as the one computed by the trees.
+/**
+ * @param aabb The AABB of the collider
+ * @param marginScale The scale of the margin
+ * @param displacement The predicted displacement of the collider
+ * @return The fat AABB of the collider
+ */
+AABB BroadPhaseSystem::computeFatAABB(const AABB& aabb, decimal marginScale, const Vector3& displacement) {
+
+    const Vector3 gap(aabb.getExtent() * DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE * decimal(0.5) * marginScale);
+
+    const Vector3 minDisplacement(std::min(displacement.x, decimal(0.0)), std::min(displacement.y, decimal(0.0)),
+                                  std::min(displacement.z, decimal(0.0)));
+    const Vector3 maxDisplacement(std::max(displacement.x, decimal(0.0)), std::max(displacement.y, decimal(0.0)),
+                                  std::max(displacement.z, decimal(0.0)));
+
+    return AABB(aabb.getMin() - gap + minDisplacement, aabb.getMax() + gap + maxDisplacement);
+}
+
+// Update the number of steps since the last fat AABB update and the margin scale of the awake bodies
+/// The margin scale of a body whose fat AABBs have not been updated for a long time is halved. The fat
+/// AABBs of its colliders have been updated with the new scale in updateCollidersComponents().
+void BroadPhaseSystem::updateFatAABBMarginScales() {
+
+    const uint32 nbBodies = mRigidBodyComponents.getNbEnabledComponents();
+    for (uint32 i=0; i < nbBodies; i++) {
+
+        uint32& nbSteps = mRigidBodyComponents.mNbStepsSinceFatAABBUpdate[i];
+        decimal& marginScale = mRigidBodyComponents.mFatAABBMarginScales[i];
+
+        if (nbSteps >= PREDICTIVE_FAT_AABB_SHRINK_NB_STEPS && marginScale > PREDICTIVE_FAT_AABB_MIN_MARGIN_SCALE) {
+            marginScale = std::max(marginScale * decimal(0.5), PREDICTIVE_FAT_AABB_MIN_MARGIN_SCALE);
+            nbSteps = 0;
+        }
+
+        if (nbSteps < PREDICTIVE_FAT_AABB_SHRINK_NB_STEPS) {
+            nbSteps++;
+        }
     }
 }
 
 // Notify the broad-phase that a collision shape has moved and need to be updated
-void BroadPhaseSystem::updateColliderInternal(int32 broadPhaseId, Collider* collider, const AABB& aabb,
-                                              bool forceReInsert) {
+/**
+ * @return True if the fat AABB of the collider has been updated
+ */
+bool BroadPhaseSystem::updateColliderInternal(int32 broadPhaseId, Collider* collider, const AABB& aabb,
+                                              const AABB& fatAABB, bool forceReInsert) {
 
     assert(broadPhaseId >= 0);
 
-    // Update the dynamic AABB tree according to the movement of the collision shape
-    bool hasBeenReInserted = mDynamicAABBTree.updateObject(broadPhaseId, aabb, forceReInsert);
+    // Update the dynamic AABB tree (or the backend) according to the movement of the collision shape.
+    // With the REFIT method, the tree is refitted at the end of updateCollidersComponents()
+    bool hasMovedOutOfFatAABB;
+    if (mBackend != nullptr) {
+        hasMovedOutOfFatAABB = mBackend->updateObject(broadPhaseId, aabb, fatAABB, forceReInsert);
+    }
+    else {
+        hasMovedOutOfFatAABB = mTreeUpdateMethod == DynamicAABBTreeUpdateMethod::REFIT ?
+                               mDynamicAABBTree.refitObject(broadPhaseId, aabb, fatAABB, forceReInsert) :
+                               mDynamicAABBTree.updateObject(broadPhaseId, aabb, fatAABB, forceReInsert);
+    }
 
     // If the collision shape has moved out of its fat AABB (and therefore has been reinserted
-    // into the tree).
-    if (hasBeenReInserted) {
+    // into the tree or refitted).
+    if (hasMovedOutOfFatAABB) {
 
         // Add the collision shape into the array of shapes that have moved (or have been created)
         // during the last simulation step
         addMovedCollider(broadPhaseId, collider);
     }
+
+    return hasMovedOutOfFatAABB;
+}
+
+// Notify the tree of a compound body that a collider has moved and need to be updated
+/**
+ * @return True if the fat AABB of the collider has been updated
+ */
+bool BroadPhaseSystem::updateCompoundColliderInternal(int32 broadPhaseId, Collider* collider, const AABB& aabb,
+                                                      const AABB& fatAABB, bool forceReInsert) {
+
+    const CompoundCollider& compoundCollider = mCompoundColliders[broadPhaseId - COMPOUND_BROAD_PHASE_ID_OFFSET];
+    CompoundProxy* proxy = compoundCollider.proxy;
+
+    // Only the small tree of the body is updated when the collider moves out of its fat AABB
+    if (proxy->collidersTree.updateObject(compoundCollider.nodeId, aabb, fatAABB, forceReInsert)) {
+
+        // The node of the body in the compounds tree must contain the fat AABBs of all its colliders
+        if (mTreeUpdateMethod == DynamicAABBTreeUpdateMethod::REFIT) {
+            mCompoundsTree.refitObject(proxy->nodeId, proxy->collidersTree.getRootAABB());
+        }
+        else {
+            mCompoundsTree.updateObject(proxy->nodeId, proxy->collidersTree.getRootAABB());
+        }
+
+        addMovedCollider(broadPhaseId, collider);
+
+        return true;
+    }
+
+    return false;
 }
 
 // Update the broad-phase state of some colliders components
-void BroadPhaseSystem::updateCollidersComponents(uint32 startIndex, uint32 nbItems) {
+/// If the predictive fat AABBs are enabled, the fat AABB of a collider of a rigid body is extended along the
+/// displacement of the body (predicted from its linear velocity) during a number of steps given by the margin
+/// scale of the body. If "adaptMargins" is true, the margin scale of a body is doubled when its fat AABBs need
+/// to be updated again shortly after the last update and the fat AABBs of a body that has not moved out of
+/// them for a long time are shrunk (see updateFatAABBMarginScales()).
+/**
+ * @param startIndex Index of the first collider component to update
+ * @param nbItems Number of collider components to update
+ * @param adaptMargins True if the margin scales of the bodies must be adapted (at the end of a step)
+ */
+void BroadPhaseSystem::updateCollidersComponents(uint32 startIndex, uint32 nbItems, bool adaptMargins) {
 
     RP3D_PROFILE("BroadPhaseSystem::updateCollidersComponents()", mProfiler);
 
@@ -174,14 +824,80 @@ void BroadPhaseSystem::updateCollidersComponents(uint32 startIndex, uint32 nbIte
 
             // If the size of the collision shape has been changed by the user,
             // we need to reset the broad-phase AABB to its new size
-            const bool forceReInsert = mCollidersComponents.mHasCollisionShapeChangedSize[i];
+            const bool hasShapeChangedSize = mCollidersComponents.mHasCollisionShapeChangedSize[i];
+            bool forceReInsert = hasShapeChangedSize;
+
+            decimal marginScale = decimal(1.0);
+            Vector3 displacement(0, 0, 0);
+            uint32 bodyIndex = 0;
+            const bool isPredictive = mIsPredictiveFatAABBEnabled &&
+                                      mRigidBodyComponents.hasComponentGetIndex(bodyEntity, bodyIndex);
+            bool isShrinking = false;
+            if (isPredictive) {
+
+                marginScale = mRigidBodyComponents.mFatAABBMarginScales[bodyIndex];
+
+                // If the fat AABBs of the body have not been updated for a long time, they are shrunk
+                // (the new margin scale of the body is set in updateFatAABBMarginScales())
+                isShrinking = adaptMargins && marginScale > PREDICTIVE_FAT_AABB_MIN_MARGIN_SCALE &&
+                              mRigidBodyComponents.mNbStepsSinceFatAABBUpdate[bodyIndex] >= PREDICTIVE_FAT_AABB_SHRINK_NB_STEPS;
+                if (isShrinking) {
+                    marginScale = std::max(marginScale * decimal(0.5), PREDICTIVE_FAT_AABB_MIN_MARGIN_SCALE);
+                    forceReInsert = true;
+                }
+
+                // Predicted displacement of the body during the next steps (one step per unit of margin scale)
+                displacement = mRigidBodyComponents.mLinearVelocities[bodyIndex] * (mTimeStep * marginScale);
+
+                // The margin around the AABB (for the rotations and the changes of velocity) can be shrunk but
+                // does not grow with the scale because it would create many overlapping pairs in the piles of
+                // bodies that move slowly in all directions
+                marginScale = std::min(marginScale, decimal(1.0));
+            }
+
+            const AABB fatAABB = computeFatAABB(aabb, marginScale, displacement);
 
             // Update the broad-phase state of the collider
-            updateColliderInternal(broadPhaseId, mCollidersComponents.mColliders[i], aabb, forceReInsert);
+            bool isUpdated;
+            if (isCompoundBroadPhaseId(broadPhaseId)) {
+                isUpdated = updateCompoundColliderInternal(broadPhaseId, mCollidersComponents.mColliders[i], aabb,
+                                                           fatAABB, forceReInsert);
+            }
+            else {
+                isUpdated = updateColliderInternal(broadPhaseId, mCollidersComponents.mColliders[i], aabb,
+                                                   fatAABB, forceReInsert);
+            }
+
+            if (isUpdated) {
+
+                mNbReinsertions++;
+
+                // If the collider has moved out of its fat AABB, the margin scale of the body is doubled if its
+                // fat AABBs had already been updated a few steps ago (at most once per step for each body)
+                if (isPredictive && adaptMargins && !isShrinking && !hasShapeChangedSize) {
+
+                    uint32& nbSteps = mRigidBodyComponents.mNbStepsSinceFatAABBUpdate[bodyIndex];
+                    if (nbSteps > 0 && nbSteps < PREDICTIVE_FAT_AABB_GROW_NB_STEPS) {
+                        decimal& bodyMarginScale = mRigidBodyComponents.mFatAABBMarginScales[bodyIndex];
+                        bodyMarginScale = std::min(bodyMarginScale * decimal(2.0), PREDICTIVE_FAT_AABB_MAX_MARGIN_SCALE);
+                    }
+                    nbSteps = 0;
+                }
+            }
 
             mCollidersComponents.mHasCollisionShapeChangedSize[i] = false;
         }
     }
+
+    // Refit the ancestors of all the leaves that have moved at once
+    if (mTreeUpdateMethod == DynamicAABBTreeUpdateMethod::REFIT) {
+        mDynamicAABBTree.refit(mMaxNbTreeRotations);
+        mCompoundsTree.refit(mMaxNbTreeRotations);
+    }
+
+    if (mBackend != nullptr) {
+        mBackend->update();
+    }
 }
 
 
@@ -198,6 +914,92 @@ void BroadPhaseSystem::addMovedCollider(int broadPhaseID, Collider* collider) {
     mCollisionDetection.notifyOverlappingPairsToTestOverlap(collider);
 }
 
+// Write the dynamic AABB tree and the moved shapes into a world snapshot
+void BroadPhaseSystem::takeSnapshot(BinaryWriter& writer) const {
+
+    writer.write(static_cast<uint32>(getBroadPhaseMethod()));
+    if (mBackend != nullptr) {
+        mBackend->takeSnapshot(writer);
+    }
+    else {
+        mDynamicAABBTree.takeSnapshot(writer);
+    }
+
+    // Write the trees of the compound bodies
+    mCompoundsTree.takeSnapshot(writer);
+    writer.write(static_cast<uint32>(mCompoundProxies.size()));
+    for (auto it = mCompoundProxies.begin(); it != mCompoundProxies.end(); ++it) {
+        writer.write(it->first.getIndex());
+        writer.write(it->first.getGeneration());
+        it->second->collidersTree.takeSnapshot(writer);
+    }
+
+    // The iteration order of the set of moved shapes depends on its capacity and on the order in which
+    // the shapes have been added into it. The capacity is written and the shapes are written in reverse
+    // iteration order so that the set can be rebuilt with the same iteration order.
+    const Array<int> movedShapes = mMovedShapes.toArray(mCollisionDetection.getMemoryManager().getHeapAllocator());
+    writer.write(static_cast<uint64>(mMovedShapes.capacity()));
+    writer.write(static_cast<uint32>(movedShapes.size()));
+    for (uint32 i=movedShapes.size(); i > 0; i--) {
+        writer.write(static_cast<int32>(movedShapes[i - 1]));
+    }
+}
+
+// Restore the dynamic AABB tree and the moved shapes from a world snapshot
+bool BroadPhaseSystem::restoreSnapshot(BinaryReader& reader) {
+
+    // The broad-phase method must be the same as in the snapshot
+    const uint32 method = reader.read<uint32>();
+    if (reader.hasError() || method != static_cast<uint32>(getBroadPhaseMethod())) {
+        return false;
+    }
+
+    const bool isRestored = mBackend != nullptr ? mBackend->restoreSnapshot(reader) : mDynamicAABBTree.restoreSnapshot(reader);
+    if (!isRestored || !mCompoundsTree.restoreSnapshot(reader)) {
+        return false;
+    }
+
+    // Restore the trees of the compound bodies (the compound bodies must be the same as in the snapshot)
+    const uint32 nbCompoundProxies = reader.read<uint32>();
+    if (reader.hasError() || nbCompoundProxies != mCompoundProxies.size()) {
+        return false;
+    }
+    for (uint32 i=0; i < nbCompoundProxies; i++) {
+
+        const uint32 bodyIndex = reader.read<uint32>();
+        const uint32 bodyGeneration = reader.read<uint32>();
+        auto it = mCompoundProxies.find(Entity(bodyIndex, bodyGeneration));
+        if (reader.hasError() || it == mCompoundProxies.end() || !it->second->collidersTree.restoreSnapshot(reader)) {
+            return false;
+        }
+    }
+
+    const uint64 movedShapesCapacity = reader.read<uint64>();
+    const uint32 nbMovedShapes = reader.read<uint32>();
+    if (!reader.hasRemaining(nbMovedShapes, sizeof(int32)) || nbMovedShapes > movedShapesCapacity ||
+        (movedShapesCapacity > 0 && (movedShapesCapacity < 16 || !isPowerOfTwo(movedShapesCapacity)))) {
+        return false;
+    }
+
+    // Rebuild the set with the same capacity as when the snapshot has been taken. Each shape is added
+    // at the front of its bucket and the shapes have been written in reverse iteration order. Therefore,
+    // the set is iterated in the same order as when the snapshot has been taken.
+    if (mMovedShapes.capacity() != movedShapesCapacity) {
+        mMovedShapes.clear(true);
+        if (movedShapesCapacity > 0) {
+            mMovedShapes.reserve(movedShapesCapacity);
+        }
+    }
+    else {
+        mMovedShapes.clear();
+    }
+    for (uint32 i=0; i < nbMovedShapes; i++) {
+        mMovedShapes.add(reader.read<int32>());
+    }
+
+    return !reader.hasError();
+}
+
 // Compute all the overlapping pairs of collision shapes
 void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, Array<Pair<int32, int32>>& overlappingNodes) {
 
@@ -206,8 +1008,66 @@ void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, Arr
     // Get the array of the colliders that have moved or have been created in the last frame
     Array<int> shapesToTest = mMovedShapes.toArray(memoryManager.getHeapAllocator());
 
-    // Ask the dynamic AABB tree to report all collision shapes that overlap with the shapes to test
-    mDynamicAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, 0, static_cast<uint32>(shapesToTest.size()), overlappingNodes);
+    // If there are compound bodies, the moved colliders of the compound bodies are tested separately
+    Array<int> compoundShapesToTest(memoryManager.getHeapAllocator());
+    if (mCompoundColliders.size() > 0) {
+
+        for (uint32 i=0; i < shapesToTest.size(); i++) {
+            if (isCompoundBroadPhaseId(shapesToTest[i])) {
+                compoundShapesToTest.add(shapesToTest[i]);
+                shapesToTest.removeAtAndReplaceByLast(i);
+                i--;
+            }
+        }
+    }
+
+    // Ask the dynamic AABB tree (or the backend) to report all collision shapes that overlap with the shapes to test
+    if (mBackend != nullptr) {
+        mBackend->reportAllShapesOverlappingWithShapes(shapesToTest, overlappingNodes);
+    }
+    else {
+        mDynamicAABBTree.reportAllShapesOverlappingWithShapes(shapesToTest, 0, static_cast<uint32>(shapesToTest.size()), overlappingNodes);
+    }
+
+    if (!mCompoundsTree.isEmpty()) {
+
+        MemoryAllocator& allocator = memoryManager.getPoolAllocator();
+
+        // Test the moved colliders of the world tree against the colliders of the compound bodies
+        for (uint32 i=0; i < shapesToTest.size(); i++) {
+
+            const int32 broadPhaseId = shapesToTest[i];
+            const AABB& aabb = getFatAABB(broadPhaseId);
+
+            auto addPair = [&](int32 otherBroadPhaseId) { overlappingNodes.add(Pair<int32, int32>(broadPhaseId, otherBroadPhaseId)); };
+            reportCompoundCollidersOverlappingWithVolume([&aabb](const AABB& nodeAABB) { return aabb.testCollision(nodeAABB); },
+                                                         addPair, allocator);
+        }
+
+        // Test the moved colliders of the compound bodies against the colliders of the world tree and
+        // against the colliders of the other compound bodies
+        Array<int32> overlappingShapes(allocator, 64);
+        for (uint32 i=0; i < compoundShapesToTest.size(); i++) {
+
+            const int32 broadPhaseId = compoundShapesToTest[i];
+            const AABB& aabb = getFatAABB(broadPhaseId);
+
+            overlappingShapes.clear();
+            if (mBackend != nullptr) {
+                mBackend->reportAllShapesOverlappingWithAABB(aabb, overlappingShapes);
+            }
+            else if (!mDynamicAABBTree.isEmpty()) {
+                mDynamicAABBTree.reportAllShapesOverlappingWithAABB(aabb, overlappingShapes, allocator);
+            }
+            for (uint32 j=0; j < overlappingShapes.size(); j++) {
+                overlappingNodes.add(Pair<int32, int32>(broadPhaseId, overlappingShapes[j]));
+            }
+
+            auto addPair = [&](int32 otherBroadPhaseId) { overlappingNodes.add(Pair<int32, int32>(broadPhaseId, otherBroadPhaseId)); };
+            reportCompoundCollidersOverlappingWithVolume([&aabb](const AABB& nodeAABB) { return aabb.testCollision(nodeAABB); },
+                                                         addPair, allocator, mCompoundColliders[broadPhaseId - COMPOUND_BROAD_PHASE_ID_OFFSET].proxy);
+        }
+    }
 
     // Reset the array of collision shapes that have move (or have been created) during the
     // last simulation step
@@ -219,23 +1079,3 @@ void BroadPhaseSystem::computeOverlappingPairs(MemoryManager& memoryManager, Arr
 void AABBOverlapCallback::notifyOverlappingNode(int nodeId) {
     mOverlappingNodes.add(nodeId);
 }
-
-// Called for a broad-phase shape that has to be tested for raycast
-decimal BroadPhaseRaycastCallback::raycastBroadPhaseShape(int32 nodeId, const Ray& ray) {
-
-    decimal hitFraction = decimal(-1.0);
-
-    // Get the collider from the node
-    Collider* collider = static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(nodeId));
-
-    // Check if the raycast filtering mask allows raycast against this shape and if world query is enabled for this collider
-    if ((mRaycastWithCategoryMaskBits & collider->getCollisionCategoryBits()) != 0 && collider->getIsWorldQueryCollider()) {
-
-        // Ask the collision detection to perform a ray cast test against
-        // the collider of this node because the ray is overlapping
-        // with the shape in the broad-phase
-        hitFraction = mRaycastTest.raycastAgainstShape(collider, ray);
-    }
-
-    return hitFraction;
-}
@@ -40,6 +40,10 @@
 #include <reactphysics3d/utils/Profiler.h>
 #include <reactphysics3d/engine/EventListener.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
+#include <reactphysics3d/collision/ShapeCastInfo.h>
+#include <reactphysics3d/collision/DistanceInfo.h>
+#include <reactphysics3d/collision/narrowphase/GJK/GJKAlgorithm.h>
+#include <reactphysics3d/collision/narrowphase/TriangleShapeBatch.h>
 #include <reactphysics3d/containers/Pair.h>
 #include <cassert>
 #include <iostream>
@@ -48,22 +52,19 @@
 using namespace reactphysics3d;
 using namespace std;
 
-// TriangleShape allocated size
-const size_t CollisionDetectionSystem::mTriangleShapeAllocatedSize = std::ceil(sizeof(TriangleShape) / float(GLOBAL_ALIGNMENT)) * GLOBAL_ALIGNMENT;
-
 // Constructor
 CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, ColliderComponents& collidersComponents,  TransformComponents& transformComponents,
                                                    BodyComponents& bodyComponents, RigidBodyComponents& rigidBodyComponents,
                                                    MemoryManager& memoryManager, HalfEdgeStructure& triangleHalfEdgeStructure)
                    : mMemoryManager(memoryManager), mCollidersComponents(collidersComponents), mRigidBodyComponents(rigidBodyComponents),
                      mCollisionDispatch(mMemoryManager.getPoolAllocator()), mWorld(world),
-                     mNoCollisionPairs(mMemoryManager.getPoolAllocator()),
+                     mNoCollisionPairs(mMemoryManager.getPoolAllocator()), mCollisionPairFilter(nullptr),
                      mOverlappingPairs(mMemoryManager, mCollidersComponents, bodyComponents, rigidBodyComponents,
                                        mNoCollisionPairs, mCollisionDispatch),
                      mBroadPhaseOverlappingNodes(mMemoryManager.getHeapAllocator(), 32),
                      mBroadPhaseSystem(*this, mCollidersComponents, transformComponents, rigidBodyComponents),
                      mMapBroadPhaseIdToColliderEntity(memoryManager.getPoolAllocator()),
-                     mNarrowPhaseInput(mMemoryManager.getSingleFrameAllocator(), mOverlappingPairs), mPotentialContactPoints(mMemoryManager.getSingleFrameAllocator()),
+                     mNarrowPhaseInput(mMemoryManager.getSingleFrameAllocator(), mOverlappingPairs, mMemoryManager.getHeapAllocator(), triangleHalfEdgeStructure), mPotentialContactPoints(mMemoryManager.getSingleFrameAllocator()),
                      mPotentialContactManifolds(mMemoryManager.getSingleFrameAllocator()), mContactPairs1(mMemoryManager.getPoolAllocator()),
                      mContactPairs2(mMemoryManager.getPoolAllocator()), mPreviousContactPairs(&mContactPairs1), mCurrentContactPairs(&mContactPairs2),
                      mLostContactPairs(mMemoryManager.getSingleFrameAllocator()), mPreviousMapPairIdToContactPairIndex(mMemoryManager.getHeapAllocator()),
@@ -85,18 +86,32 @@ CollisionDetectionSystem::CollisionDetectionSystem(PhysicsWorld* world, Collider
 }
 
 // Compute the collision detection
-void CollisionDetectionSystem::computeCollisionDetection() {
+/// The counters and timings of the broad-phase, middle-phase and narrow-phase are written into the step statistics
+void CollisionDetectionSystem::computeCollisionDetection(StepStats& stepStats) {
 
     RP3D_PROFILE("CollisionDetectionSystem::computeCollisionDetection()", mProfiler);
-	    
+
+    std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
     // Compute the broad-phase collision detection
     computeBroadPhase();
 
+    stepStats.broadPhaseTime = StepStats::getElapsedTime(startTime);
+    stepStats.nbOverlappingPairs = static_cast<uint32>(mOverlappingPairs.mConvexPairs.size() + mOverlappingPairs.mConcavePairs.size());
+    startTime = std::chrono::steady_clock::now();
+
     // Compute the middle-phase collision detection
     computeMiddlePhase(mNarrowPhaseInput, true, false);
-    
+
+    stepStats.middlePhaseTime = StepStats::getElapsedTime(startTime);
+    stepStats.nbNarrowPhaseTests = mNarrowPhaseInput.getNbNarrowPhaseTests();
+    startTime = std::chrono::steady_clock::now();
+
     // Compute the narrow-phase collision detection
     computeNarrowPhase();
+
+    stepStats.narrowPhaseTime = StepStats::getElapsedTime(startTime);
+    stepStats.nbContactPairs = static_cast<uint32>(mCurrentContactPairs->size());
 }
 
 // Compute the broad-phase collision detection
@@ -111,6 +126,12 @@ void CollisionDetectionSystem::computeBroadPhase() {
     // overlapping pairs in the collision detection.
     mBroadPhaseSystem.computeOverlappingPairs(mMemoryManager, mBroadPhaseOverlappingNodes);
 
+    // In deterministic mode, the new overlapping pairs are created in a stable order that
+    // does not depend on the order of the moved shapes in the broad-phase
+    if (mWorld->mConfig.isDeterministic) {
+        sortOverlappingNodes(mBroadPhaseOverlappingNodes);
+    }
+
     // Create new overlapping pairs if necessary
     updateOverlappingPairs(mBroadPhaseOverlappingNodes);
 
@@ -308,11 +329,11 @@ void CollisionDetectionSystem::updateOverlappingPairs(const Array<Pair<int32, in
                     OverlappingPairs::OverlappingPair* overlappingPair = mOverlappingPairs.getOverlappingPair(pairId);
                     if (overlappingPair == nullptr) {
 
-                        const unsigned short shape1CollideWithMaskBits = mCollidersComponents.mCollideWithMaskBits[collider1Index];
-                        const unsigned short shape2CollideWithMaskBits = mCollidersComponents.mCollideWithMaskBits[collider2Index];
+                        const uint64 shape1CollideWithMaskBits = mCollidersComponents.mCollideWithMaskBits[collider1Index];
+                        const uint64 shape2CollideWithMaskBits = mCollidersComponents.mCollideWithMaskBits[collider2Index];
 
-                        const unsigned short shape1CollisionCategoryBits = mCollidersComponents.mCollisionCategoryBits[collider1Index];
-                        const unsigned short shape2CollisionCategoryBits = mCollidersComponents.mCollisionCategoryBits[collider2Index];
+                        const uint64 shape1CollisionCategoryBits = mCollidersComponents.mCollisionCategoryBits[collider1Index];
+                        const uint64 shape2CollisionCategoryBits = mCollidersComponents.mCollisionCategoryBits[collider2Index];
 
                         // Check if the collision filtering allows collision between the two shapes
                         if ((shape1CollideWithMaskBits & shape2CollisionCategoryBits) != 0 &&
@@ -324,7 +345,10 @@ void CollisionDetectionSystem::updateOverlappingPairs(const Array<Pair<int32, in
                             // Check that at least one collision shape is convex
                             const bool isShape1Convex = shape1->getCollisionShape()->isConvex();
                             const bool isShape2Convex = shape2->getCollisionShape()->isConvex();
-                            if (isShape1Convex || isShape2Convex) {
+
+                            // Check that the user filter (if any) allows collision between the two shapes
+                            if ((isShape1Convex || isShape2Convex) &&
+                                (mCollisionPairFilter == nullptr || mCollisionPairFilter->shouldCollide(shape1, shape2))) {
 
                                 // Add the new overlapping pair
                                 mOverlappingPairs.addPair(collider1Index, collider2Index, isShape1Convex && isShape2Convex);
@@ -406,8 +430,7 @@ void CollisionDetectionSystem::computeMiddlePhase(NarrowPhaseInput& narrowPhaseI
                 narrowPhaseInput.addNarrowPhaseTest(overlappingPair.pairID, collider1Entity, collider2Entity, collisionShape1, collisionShape2,
                                                     mCollidersComponents.mLocalToWorldTransforms[collider1Index],
                                                     mCollidersComponents.mLocalToWorldTransforms[collider2Index],
-                                                    algorithmType, reportContacts, &overlappingPair.lastFrameCollisionInfo,
-                                                    mMemoryManager.getSingleFrameAllocator());
+                                                    algorithmType, reportContacts, &overlappingPair.lastFrameCollisionInfo);
             }
         }
     }
@@ -499,7 +522,7 @@ void CollisionDetectionSystem::computeMiddlePhaseCollisionSnapshot(Array<uint64>
         narrowPhaseInput.addNarrowPhaseTest(pairId, collider1Entity, collider2Entity, collisionShape1, collisionShape2,
                                                   mCollidersComponents.mLocalToWorldTransforms[collider1Index],
                                                   mCollidersComponents.mLocalToWorldTransforms[collider2Index],
-                                                  algorithmType, reportContacts, &mOverlappingPairs.mConvexPairs[pairIndex].lastFrameCollisionInfo, mMemoryManager.getSingleFrameAllocator());
+                                                  algorithmType, reportContacts, &mOverlappingPairs.mConvexPairs[pairIndex].lastFrameCollisionInfo);
 
     }
 
@@ -555,10 +578,13 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(OverlappingPair
     // Compute the convex shape AABB in the local-space of the concave shape
     const AABB aabb = convexShape->computeTransformedAABB(convexToConcaveTransform);
 
-    // Compute the concave shape triangles that are overlapping with the convex mesh AABB
-    Array<Vector3> triangleVertices(allocator, 64);
-    Array<Vector3> triangleVerticesNormals(allocator, 64);
-    Array<uint> shapeIds(allocator, 64);
+    // Compute the concave shape triangles that are overlapping with the convex mesh AABB. The triangles
+    // arrays are shared by all the pairs of the narrow-phase input and are only cleared (not released)
+    TriangleShapeBatch& triangleShapeBatch = narrowPhaseInput.getTriangleShapeBatch();
+    triangleShapeBatch.clearTriangles();
+    Array<Vector3>& triangleVertices = triangleShapeBatch.triangleVertices;
+    Array<Vector3>& triangleVerticesNormals = triangleShapeBatch.triangleVerticesNormals;
+    Array<uint32>& shapeIds = triangleShapeBatch.triangleShapeIds;
     concaveShape->computeOverlappingTriangles(aabb, triangleVertices, triangleVerticesNormals, shapeIds, allocator);
 
     assert(triangleVertices.size() == triangleVerticesNormals.size());
@@ -584,10 +610,9 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(OverlappingPair
     const uint32 nbShapeIds = static_cast<uint32>(shapeIds.size());
     for (uint32 i=0; i < nbShapeIds; i++) {
 
-        // Create a triangle collision shape (the allocated memory for the TriangleShape will be released in the
-        // destructor of the corresponding NarrowPhaseInfo.
-        TriangleShape* triangleShape = new (allocator.allocate(mTriangleShapeAllocatedSize))
-                                       TriangleShape(&(triangleVertices[i * 3]), &(triangleVerticesNormals[i * 3]), shapeIds[i], mTriangleHalfEdgeStructure, allocator);
+        // Get a triangle collision shape from the batch (the TriangleShape objects are owned by the batch
+        // and reused from one frame to the next)
+        TriangleShape* triangleShape = triangleShapeBatch.createTriangleShape(i);
 
     #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -610,7 +635,7 @@ void CollisionDetectionSystem::computeConvexVsConcaveMiddlePhase(OverlappingPair
         // Create a narrow phase info for the narrow-phase collision detection
         narrowPhaseInput.addNarrowPhaseTest(overlappingPair.pairID, collider1, collider2, shape1, shape2,
                                             shape1LocalToWorldTransform, shape2LocalToWorldTransform,
-                                            overlappingPair.narrowPhaseAlgorithmType, reportContacts, lastFrameInfo, allocator);
+                                            overlappingPair.narrowPhaseAlgorithmType, reportContacts, lastFrameInfo);
     }
 }
 
@@ -707,6 +732,12 @@ void CollisionDetectionSystem::computeNarrowPhase() {
     processAllPotentialContacts(mNarrowPhaseInput, true, mPotentialContactPoints,
                                 mPotentialContactManifolds, mCurrentContactPairs);
 
+    // In deterministic mode, the contact pairs (and therefore the islands and the contacts
+    // created in createContacts()) are ordered by pair id instead of narrow-phase batch order
+    if (mWorld->mConfig.isDeterministic) {
+        sortContactPairs(mCurrentContactPairs);
+    }
+
     // Reduce the number of contact points in the manifolds
     reducePotentialContactManifolds(mCurrentContactPairs, mPotentialContactManifolds, mPotentialContactPoints);
 
@@ -717,6 +748,40 @@ void CollisionDetectionSystem::computeNarrowPhase() {
     assert(mCurrentContactPoints->size() == 0);
 }
 
+// Sort the overlapping broad-phase nodes by node ids
+/// The two nodes of each pair are also ordered such that the first one has the smallest id.
+void CollisionDetectionSystem::sortOverlappingNodes(Array<Pair<int32, int32>>& overlappingNodes) {
+
+    RP3D_PROFILE("CollisionDetectionSystem::sortOverlappingNodes()", mProfiler);
+
+    const uint64 nbOverlappingNodes = overlappingNodes.size();
+    for (uint64 i=0; i < nbOverlappingNodes; i++) {
+        if (overlappingNodes[i].first > overlappingNodes[i].second) {
+            std::swap(overlappingNodes[i].first, overlappingNodes[i].second);
+        }
+    }
+
+    std::sort(overlappingNodes.begin(), overlappingNodes.end(), [](const Pair<int32, int32>& a, const Pair<int32, int32>& b) {
+        return a.first < b.first || (a.first == b.first && a.second < b.second);
+    });
+}
+
+// Sort the contact pairs by overlapping pair id
+void CollisionDetectionSystem::sortContactPairs(Array<ContactPair>* contactPairs) {
+
+    RP3D_PROFILE("CollisionDetectionSystem::sortContactPairs()", mProfiler);
+
+    std::sort(contactPairs->begin(), contactPairs->end(), [](const ContactPair& a, const ContactPair& b) {
+        return a.pairId < b.pairId;
+    });
+
+    // Update the index of each contact pair
+    const uint32 nbContactPairs = static_cast<uint32>(contactPairs->size());
+    for (uint32 i=0; i < nbContactPairs; i++) {
+        (*contactPairs)[i].contactPairIndex = i;
+    }
+}
+
 // Add the contact pairs to the corresponding bodies
 void CollisionDetectionSystem::addContactPairsToBodies() {
 
@@ -1183,7 +1248,7 @@ void CollisionDetectionSystem::removeCollider(Collider* collider) {
 }
 
 // Ray casting method
-void CollisionDetectionSystem::raycast(RaycastCallback* raycastCallback, const Ray& ray, unsigned short raycastWithCategoryMaskBits) const {
+void CollisionDetectionSystem::raycast(RaycastCallback* raycastCallback, const Ray& ray, uint64 raycastWithCategoryMaskBits) const {
 
     RP3D_PROFILE("CollisionDetectionSystem::raycast()", mProfiler);
 
@@ -1194,6 +1259,396 @@ void CollisionDetectionSystem::raycast(RaycastCallback* raycastCallback, const R
     mBroadPhaseSystem.raycast(ray, rayCastTest, raycastWithCategoryMaskBits);
 }
 
+// Return true if a ray hits at least one collider
+bool CollisionDetectionSystem::raycastAny(const Ray& ray, uint64 raycastWithCategoryMaskBits) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::raycastAny()", mProfiler);
+
+    return mBroadPhaseSystem.raycastAny(ray, raycastWithCategoryMaskBits, mMemoryManager.getPoolAllocator());
+}
+
+// Compute the closest hit of a ray with the colliders
+bool CollisionDetectionSystem::raycastClosest(const Ray& ray, RaycastInfo& outRaycastInfo, uint64 raycastWithCategoryMaskBits) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::raycastClosest()", mProfiler);
+
+    return mBroadPhaseSystem.raycastClosest(ray, raycastWithCategoryMaskBits, outRaycastInfo, mMemoryManager.getPoolAllocator());
+}
+
+// Cast a convex shape along a translation and return true if it hits a collider
+bool CollisionDetectionSystem::shapeCast(const ConvexShape& shape, const Transform& transform, const Vector3& translation,
+                                         ShapeCastInfo& outHit, uint64 shapeCastWithCategoryMaskBits) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::shapeCast()", mProfiler);
+
+    Array<int32> overlappingNodes(mMemoryManager.getPoolAllocator(), 64);
+    TriangleShapeBatch triangleShapeBatch(mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
+
+    return computeShapeCast(shape, transform, translation, shapeCastWithCategoryMaskBits, overlappingNodes, triangleShapeBatch, outHit);
+}
+
+// Cast a convex shape along several translations and return the number of hits
+/// The temporary arrays of the queries are allocated once and reused for all the queries.
+uint32 CollisionDetectionSystem::shapeCast(const ConvexShape& shape, const Array<ShapeCastQuery>& queries, Array<ShapeCastInfo>& outHits,
+                                           uint64 shapeCastWithCategoryMaskBits) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::shapeCast()", mProfiler);
+
+    Array<int32> overlappingNodes(mMemoryManager.getPoolAllocator(), 64);
+    TriangleShapeBatch triangleShapeBatch(mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
+
+    outHits.clear();
+    outHits.reserve(queries.size());
+
+    uint32 nbHits = 0;
+    const uint64 nbQueries = queries.size();
+    for (uint64 i=0; i < nbQueries; i++) {
+
+        outHits.emplace();
+        if (computeShapeCast(shape, queries[i].transform, queries[i].translation, shapeCastWithCategoryMaskBits,
+                             overlappingNodes, triangleShapeBatch, outHits[i])) {
+            nbHits++;
+        }
+    }
+
+    return nbHits;
+}
+
+// Compute the first hit of a convex shape moving along a translation
+/// The broad-phase tree is queried with the AABB swept by the shape and the time of impact with each
+/// candidate collider is computed with conservative advancement. The fraction of the closest hit found so
+/// far is used to discard the other candidates early. For a concave collider, the time of impact is computed
+/// with each triangle overlapping the swept AABB.
+bool CollisionDetectionSystem::computeShapeCast(const ConvexShape& shape, const Transform& transform, const Vector3& translation,
+                                                uint64 shapeCastWithCategoryMaskBits, Array<int32>& overlappingNodes,
+                                                TriangleShapeBatch& triangleShapeBatch, ShapeCastInfo& outHit) const {
+
+    GJKAlgorithm gjkAlgorithm;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    gjkAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+    const Transform endTransform(transform.getPosition() + translation, transform.getOrientation());
+
+    // Compute the AABB swept by the shape
+    AABB sweptAABB = shape.computeTransformedAABB(transform);
+    sweptAABB.mergeWithAABB(shape.computeTransformedAABB(endTransform));
+    sweptAABB.inflate(GJK_TIME_OF_IMPACT_TOLERANCE, GJK_TIME_OF_IMPACT_TOLERANCE, GJK_TIME_OF_IMPACT_TOLERANCE);
+
+    overlappingNodes.clear();
+    mBroadPhaseSystem.reportAllShapesOverlappingWithAABB(sweptAABB, overlappingNodes, mMemoryManager.getPoolAllocator());
+
+    outHit = ShapeCastInfo();
+    bool isHit = false;
+
+    const uint32 nbOverlappingNodes = static_cast<uint32>(overlappingNodes.size());
+    for (uint32 i=0; i < nbOverlappingNodes; i++) {
+
+        Collider* collider = mBroadPhaseSystem.getColliderForBroadPhaseId(overlappingNodes[i]);
+        const uint32 colliderIndex = mCollidersComponents.getEntityIndex(collider->getEntity());
+
+        // Check if the filtering mask allows the shape cast against this collider and if world query is enabled for this collider
+        if ((shapeCastWithCategoryMaskBits & mCollidersComponents.mCollisionCategoryBits[colliderIndex]) == 0 ||
+            !mCollidersComponents.mIsWorldQueryCollider[colliderIndex]) {
+            continue;
+        }
+
+        const CollisionShape* colliderShape = mCollidersComponents.mCollisionShapes[colliderIndex];
+        const Transform& colliderTransform = mCollidersComponents.mLocalToWorldTransforms[colliderIndex];
+
+        decimal hitFraction;
+        Vector3 hitPoint;
+        Vector3 hitNormal;
+
+        if (colliderShape->isConvex()) {
+
+            if (gjkAlgorithm.computeTimeOfImpact(&shape, transform, translation, static_cast<const ConvexShape*>(colliderShape),
+                                                 colliderTransform, outHit.hitFraction, hitFraction, hitPoint, hitNormal) &&
+                (!isHit || hitFraction < outHit.hitFraction)) {
+
+                outHit.hitFraction = hitFraction;
+                outHit.worldPoint = hitPoint;
+                outHit.worldNormal = hitNormal;
+                outHit.collider = collider;
+                outHit.body = collider->getBody();
+                isHit = true;
+            }
+        }
+        else {
+
+            const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(colliderShape);
+
+            // Compute the swept AABB in the local-space of the concave shape
+            const Transform worldToConcave = colliderTransform.getInverse();
+            AABB localSweptAABB = shape.computeTransformedAABB(worldToConcave * transform);
+            localSweptAABB.mergeWithAABB(shape.computeTransformedAABB(worldToConcave * endTransform));
+            localSweptAABB.inflate(GJK_TIME_OF_IMPACT_TOLERANCE, GJK_TIME_OF_IMPACT_TOLERANCE, GJK_TIME_OF_IMPACT_TOLERANCE);
+
+            // Compute the triangles of the concave shape that overlap with the swept AABB
+            triangleShapeBatch.clear();
+            concaveShape->computeOverlappingTriangles(localSweptAABB, triangleShapeBatch.triangleVertices, triangleShapeBatch.triangleVerticesNormals,
+                                                      triangleShapeBatch.triangleShapeIds, mMemoryManager.getPoolAllocator());
+
+            // For each overlapping triangle
+            const uint32 nbTriangles = static_cast<uint32>(triangleShapeBatch.triangleShapeIds.size());
+            for (uint32 t=0; t < nbTriangles; t++) {
+
+                const TriangleShape* triangleShape = triangleShapeBatch.createTriangleShape(t);
+
+                if (gjkAlgorithm.computeTimeOfImpact(&shape, transform, translation, triangleShape, colliderTransform,
+                                                     outHit.hitFraction, hitFraction, hitPoint, hitNormal) &&
+                    (!isHit || hitFraction < outHit.hitFraction)) {
+
+                    outHit.hitFraction = hitFraction;
+                    outHit.worldPoint = hitPoint;
+                    outHit.worldNormal = hitNormal;
+                    outHit.collider = collider;
+                    outHit.body = collider->getBody();
+                    isHit = true;
+                }
+            }
+        }
+    }
+
+    return isHit;
+}
+
+// Compute the distance and the closest points between a convex shape and a collider
+/// Return true if the distance is not larger than the maximum distance in parameter. The category
+/// mask of the collider is not checked.
+/**
+ * @param shape Convex shape of the query
+ * @param transform Local-to-world transform of the shape
+ * @param collider Pointer to the collider
+ * @param[out] outInfo Distance and closest points between the shape and the collider
+ * @param maxDistance Maximum distance
+ * @return True if the distance between the shape and the collider is not larger than the maximum distance
+ */
+bool CollisionDetectionSystem::computeDistance(const ConvexShape& shape, const Transform& transform, Collider* collider,
+                                               DistanceInfo& outInfo, decimal maxDistance) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::computeDistance()", mProfiler);
+
+    GJKAlgorithm gjkAlgorithm;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    gjkAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+    TriangleShapeBatch triangleShapeBatch(mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
+
+    outInfo = DistanceInfo();
+    return computeColliderDistance(shape, transform, collider, maxDistance, gjkAlgorithm, triangleShapeBatch, outInfo);
+}
+
+// Compute the distance and the closest points between a convex shape and the closest collider of the world
+/**
+ * @param shape Convex shape of the query
+ * @param transform Local-to-world transform of the shape
+ * @param[out] outInfo Distance and closest points between the shape and the closest collider
+ * @param maxDistance Colliders farther than this distance are ignored
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be tested
+ * @return True if a collider has been found within the maximum distance
+ */
+bool CollisionDetectionSystem::computeClosestCollider(const ConvexShape& shape, const Transform& transform, DistanceInfo& outInfo,
+                                                      decimal maxDistance, uint64 categoryMaskBits) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::computeClosestCollider()", mProfiler);
+
+    GJKAlgorithm gjkAlgorithm;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    gjkAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+    TriangleShapeBatch triangleShapeBatch(mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
+
+    return computeClosestCollider(shape, transform, maxDistance, categoryMaskBits, gjkAlgorithm, triangleShapeBatch, outInfo);
+}
+
+// Compute the closest collider of the world for several convex shapes and return the number of colliders found
+/// The result of the i-th query is written at index i in the output array. The temporary memory of
+/// the queries is allocated once and reused for all the queries.
+uint32 CollisionDetectionSystem::computeClosestColliders(const Array<DistanceQuery>& queries, Array<DistanceInfo>& outInfos,
+                                                         uint64 categoryMaskBits) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::computeClosestColliders()", mProfiler);
+
+    GJKAlgorithm gjkAlgorithm;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+    gjkAlgorithm.setProfiler(mProfiler);
+
+#endif
+
+    TriangleShapeBatch triangleShapeBatch(mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
+
+    outInfos.clear();
+    outInfos.reserve(queries.size());
+
+    uint32 nbCollidersFound = 0;
+    const uint64 nbQueries = queries.size();
+    for (uint64 i=0; i < nbQueries; i++) {
+
+        assert(queries[i].shape != nullptr);
+
+        outInfos.emplace();
+        if (computeClosestCollider(*queries[i].shape, queries[i].transform, queries[i].maxDistance, categoryMaskBits,
+                                   gjkAlgorithm, triangleShapeBatch, outInfos[i])) {
+            nbCollidersFound++;
+        }
+    }
+
+    return nbCollidersFound;
+}
+
+// Compute the closest collider of the world to a convex shape
+/// The broad-phase tree is searched from the nearest nodes to the farthest ones and the search distance
+/// shrinks each time a closer collider is found. Therefore, only the colliders whose fat AABB is closer
+/// than the closest collider found so far have to be tested with GJK.
+bool CollisionDetectionSystem::computeClosestCollider(const ConvexShape& shape, const Transform& transform, decimal maxDistance,
+                                                      uint64 categoryMaskBits, const GJKAlgorithm& gjkAlgorithm,
+                                                      TriangleShapeBatch& triangleShapeBatch, DistanceInfo& outInfo) const {
+
+    outInfo = DistanceInfo();
+
+    ClosestColliderCallback callback(*this, shape, transform, categoryMaskBits, gjkAlgorithm, triangleShapeBatch, outInfo);
+    mBroadPhaseSystem.reportShapesWithinDistance(shape.computeTransformedAABB(transform), maxDistance, callback,
+                                                 mMemoryManager.getPoolAllocator());
+
+    return callback.isColliderFound();
+}
+
+// Compute the distance between a convex shape and a collider if it is not larger than a maximum distance
+/// For a concave collider, the distance is computed with each triangle of the collider that is within the
+/// maximum distance of the AABB of the shape.
+bool CollisionDetectionSystem::computeColliderDistance(const ConvexShape& shape, const Transform& transform, Collider* collider, decimal maxDistance,
+                                                       const GJKAlgorithm& gjkAlgorithm, TriangleShapeBatch& triangleShapeBatch,
+                                                       DistanceInfo& outInfo) const {
+
+    const uint32 colliderIndex = mCollidersComponents.getEntityIndex(collider->getEntity());
+    const CollisionShape* colliderShape = mCollidersComponents.mCollisionShapes[colliderIndex];
+    const Transform& colliderTransform = mCollidersComponents.mLocalToWorldTransforms[colliderIndex];
+
+    decimal distance;
+    Vector3 point1;
+    Vector3 point2;
+    Vector3 normal;
+    bool isFound = false;
+
+    if (colliderShape->isConvex()) {
+
+        // If the shapes deeply overlap, GJK cannot compute the closest points
+        if (!gjkAlgorithm.computeClosestPoints(&shape, transform, static_cast<const ConvexShape*>(colliderShape), colliderTransform,
+                                               distance, point1, point2, normal)) {
+            distance = decimal(0.0);
+            point1 = transform.getPosition();
+            point2 = transform.getPosition();
+            normal.setToZero();
+        }
+
+        if (distance <= maxDistance) {
+            outInfo.distance = distance;
+            outInfo.worldPoint1 = point1;
+            outInfo.worldPoint2 = point2;
+            outInfo.worldNormal = normal;
+            isFound = true;
+        }
+    }
+    else {
+
+        const ConcaveShape* concaveShape = static_cast<const ConcaveShape*>(colliderShape);
+
+        // Compute the AABB of the shape in the local-space of the concave shape
+        AABB localAABB = shape.computeTransformedAABB(colliderTransform.getInverse() * transform);
+
+        // Inflate it by the maximum distance (bounded by the size of the concave shape because
+        // a triangle is always closer than that)
+        AABB boundsAABB = concaveShape->getLocalBounds();
+        boundsAABB.mergeWithAABB(localAABB);
+        const decimal searchDistance = std::min(maxDistance, (boundsAABB.getMax() - boundsAABB.getMin()).length());
+        localAABB.inflate(searchDistance, searchDistance, searchDistance);
+
+        // Compute the triangles of the concave shape that are within the search distance
+        triangleShapeBatch.clear();
+        concaveShape->computeOverlappingTriangles(localAABB, triangleShapeBatch.triangleVertices, triangleShapeBatch.triangleVerticesNormals,
+                                                  triangleShapeBatch.triangleShapeIds, mMemoryManager.getPoolAllocator());
+
+        // For each triangle
+        const uint32 nbTriangles = static_cast<uint32>(triangleShapeBatch.triangleShapeIds.size());
+        for (uint32 t=0; t < nbTriangles; t++) {
+
+            const TriangleShape* triangleShape = triangleShapeBatch.createTriangleShape(t);
+
+            if (!gjkAlgorithm.computeClosestPoints(&shape, transform, triangleShape, colliderTransform, distance, point1, point2, normal)) {
+                distance = decimal(0.0);
+                point1 = transform.getPosition();
+                point2 = transform.getPosition();
+                normal.setToZero();
+            }
+
+            if (distance <= maxDistance && (!isFound || distance < outInfo.distance)) {
+
+                outInfo.distance = distance;
+                outInfo.worldPoint1 = point1;
+                outInfo.worldPoint2 = point2;
+                outInfo.worldNormal = normal;
+                isFound = true;
+
+                // No triangle can be closer
+                if (distance == decimal(0.0)) break;
+            }
+        }
+    }
+
+    if (isFound) {
+        outInfo.collider = collider;
+        outInfo.body = collider->getBody();
+    }
+
+    return isFound;
+}
+
+// Called for a broad-phase shape whose distance to the query shape has to be computed
+/// Return the new search distance of the query.
+decimal ClosestColliderCallback::notifyNodeWithinDistance(int32 nodeId, decimal maxDistance) {
+
+    Collider* collider = mCollisionDetection.mBroadPhaseSystem.getColliderForBroadPhaseId(nodeId);
+    const Entity colliderEntity = collider->getEntity();
+
+    // Check if the filtering mask allows the query against this collider and if world query is enabled for this collider
+    if ((mCategoryMaskBits & mCollisionDetection.mCollidersComponents.getCollisionCategoryBits(colliderEntity)) == 0 ||
+        !mCollisionDetection.mCollidersComponents.getIsWorldQueryCollider(colliderEntity)) {
+        return maxDistance;
+    }
+
+    DistanceInfo distanceInfo;
+    if (mCollisionDetection.computeColliderDistance(mShape, mTransform, collider, maxDistance, mGJKAlgorithm,
+                                                     mTriangleShapeBatch, distanceInfo) &&
+        (!mIsColliderFound || distanceInfo.distance < mClosestInfo.distance)) {
+
+        mClosestInfo = distanceInfo;
+        mIsColliderFound = true;
+
+        // If the shape overlaps the collider, no other collider can be closer
+        if (distanceInfo.distance == decimal(0.0)) {
+            return decimal(-1.0);
+        }
+
+        return distanceInfo.distance;
+    }
+
+    return maxDistance;
+}
+
 // Convert the potential contact into actual contacts
 void CollisionDetectionSystem::processPotentialContacts(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, bool updateLastFrameInfo,
                                                         Array<ContactPointInfo>& potentialContactPoints,
@@ -1720,6 +2175,12 @@ void CollisionDetectionSystem::reportContactsAndTriggers() {
         reportDebugRenderingContacts(mCurrentContactPairs, mCurrentContactManifolds, mCurrentContactPoints, mLostContactPairs);
     }
 
+    // Fill in the contact event buffer (if enabled)
+    if (mWorld->mIsContactEventBufferEnabled) {
+
+        fillContactEventBuffer(mWorld->mContactEventBuffer, mCurrentContactPairs, mCurrentContactPoints, mLostContactPairs);
+    }
+
     mOverlappingPairs.updateCollidingInPreviousFrame();
 
     mLostContactPairs.clear(true);
@@ -1756,6 +2217,118 @@ void CollisionDetectionSystem::reportTriggers(EventListener& eventListener, Arra
     }
 }
 
+// Return true if one of the two bodies of a pair has enabled its contact events
+// A body of a lost contact pair might have been destroyed during the step
+bool CollisionDetectionSystem::isContactEventsEnabled(Entity body1Entity, Entity body2Entity) const {
+
+    const BodyComponents& bodyComponents = mWorld->mBodyComponents;
+
+    return (bodyComponents.hasComponent(body1Entity) && bodyComponents.getIsContactEventsEnabled(body1Entity)) ||
+           (bodyComponents.hasComponent(body2Entity) && bodyComponents.getIsContactEventsEnabled(body2Entity));
+}
+
+// Fill in the contact event buffer with the contact pairs of the bodies that have enabled their contact events
+// The impulses of the contact events are collected later (after the contact solver) with updateContactEventBufferImpulses()
+void CollisionDetectionSystem::fillContactEventBuffer(ContactEventBuffer& buffer, Array<ContactPair>* contactPairs,
+                                                      Array<ContactPoint>* contactPoints, Array<ContactPair>& lostContactPairs) {
+
+    RP3D_PROFILE("CollisionDetectionSystem::fillContactEventBuffer()", mProfiler);
+
+    buffer.clear();
+
+    // For each contact pair
+    const uint32 nbContactPairs = static_cast<uint32>(contactPairs->size());
+    for (uint32 i=0; i < nbContactPairs; i++) {
+
+        const ContactPair& pair = (*contactPairs)[i];
+
+        // Skip the pairs that nobody listens to
+        if (!isContactEventsEnabled(pair.body1Entity, pair.body2Entity)) continue;
+
+        if (pair.isTrigger) {
+
+            Array<TriggerEvent>& events = pair.collidingInPreviousFrame ? buffer.mStayTriggerEvents : buffer.mBeginTriggerEvents;
+            events.emplace(pair.body1Entity, pair.body2Entity, pair.collider1Entity, pair.collider2Entity);
+            continue;
+        }
+
+        ContactEvent event(pair.body1Entity, pair.body2Entity, pair.collider1Entity, pair.collider2Entity);
+        event.nbContactPoints = pair.nbToTalContactPoints;
+
+        // Compute the average world-space contact point on the first collider
+        const Transform& collider1LocalToWorld = mCollidersComponents.getLocalToWorldTransform(pair.collider1Entity);
+        for (uint32 c=0; c < pair.nbToTalContactPoints; c++) {
+
+            const ContactPoint& contactPoint = (*contactPoints)[pair.contactPointsIndex + c];
+            event.point += collider1LocalToWorld * contactPoint.getLocalPointOnShape1();
+        }
+        if (pair.nbToTalContactPoints > 0) {
+            event.normal = (*contactPoints)[pair.contactPointsIndex].getNormal();
+            event.point /= decimal(pair.nbToTalContactPoints);
+        }
+
+        if (pair.collidingInPreviousFrame) {
+            buffer.mStayContactEvents.add(event);
+            buffer.mStayContactPairsIndices.add(i);
+        }
+        else {
+            buffer.mBeginContactEvents.add(event);
+            buffer.mBeginContactPairsIndices.add(i);
+        }
+    }
+
+    // For each lost contact pair
+    const uint32 nbLostContactPairs = static_cast<uint32>(lostContactPairs.size());
+    for (uint32 i=0; i < nbLostContactPairs; i++) {
+
+        const ContactPair& pair = lostContactPairs[i];
+
+        if (!isContactEventsEnabled(pair.body1Entity, pair.body2Entity)) continue;
+
+        if (pair.isTrigger) {
+            buffer.mEndTriggerEvents.emplace(pair.body1Entity, pair.body2Entity, pair.collider1Entity, pair.collider2Entity);
+        }
+        else {
+            buffer.mEndContactEvents.emplace(pair.body1Entity, pair.body2Entity, pair.collider1Entity, pair.collider2Entity);
+        }
+    }
+}
+
+// Collect the impulses computed by the contact solver into the contact events of the buffer
+// This method must be called after the contact solver has stored its impulses into the contact points and manifolds
+void CollisionDetectionSystem::updateContactEventBufferImpulses(ContactEventBuffer& buffer) const {
+
+    RP3D_PROFILE("CollisionDetectionSystem::updateContactEventBufferImpulses()", mProfiler);
+
+    Array<ContactEvent>* events[2] = {&buffer.mBeginContactEvents, &buffer.mStayContactEvents};
+    const Array<uint32>* pairsIndices[2] = {&buffer.mBeginContactPairsIndices, &buffer.mStayContactPairsIndices};
+
+    for (uint32 t=0; t < 2; t++) {
+
+        assert(events[t]->size() == pairsIndices[t]->size());
+
+        const uint32 nbEvents = static_cast<uint32>(events[t]->size());
+        for (uint32 e=0; e < nbEvents; e++) {
+
+            ContactEvent& event = (*events[t])[e];
+            const ContactPair& pair = (*mCurrentContactPairs)[(*pairsIndices[t])[e]];
+
+            event.normalImpulse = decimal(0.0);
+            for (uint32 c=0; c < pair.nbToTalContactPoints; c++) {
+                event.normalImpulse += (*mCurrentContactPoints)[pair.contactPointsIndex + c].getPenetrationImpulse();
+            }
+
+            event.frictionImpulse.setToZero();
+            for (uint32 m=0; m < pair.nbContactManifolds; m++) {
+
+                const ContactManifold& manifold = (*mCurrentContactManifolds)[pair.contactManifoldsIndex + m];
+                event.frictionImpulse += manifold.frictionVector1 * manifold.frictionImpulse1 +
+                                         manifold.frictionVector2 * manifold.frictionImpulse2;
+            }
+        }
+    }
+}
+
 // Report all contacts for debug rendering
 void CollisionDetectionSystem::reportDebugRenderingContacts(Array<ContactPair>* contactPairs, Array<ContactManifold>* manifolds, Array<ContactPoint>* contactPoints, Array<ContactPair>& lostContactPairs) {
 
@@ -1774,7 +2347,7 @@ void CollisionDetectionSystem::reportDebugRenderingContacts(Array<ContactPair>*
 // Return true if two bodies overlap (collide)
 bool CollisionDetectionSystem::testOverlap(Body* body1, Body* body2) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs, mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
 
     // Compute the broad-phase collision detection
     computeBroadPhase();
@@ -1799,7 +2372,7 @@ bool CollisionDetectionSystem::testOverlap(Body* body1, Body* body2) {
 // Report all the bodies that overlap (collide) in the world
 void CollisionDetectionSystem::testOverlap(OverlapCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs, mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
 
     // Compute the broad-phase collision detection
     computeBroadPhase();
@@ -1814,7 +2387,7 @@ void CollisionDetectionSystem::testOverlap(OverlapCallback& callback) {
 // Report all the bodies that overlap (collide) with the body in parameter
 void CollisionDetectionSystem::testOverlap(Body* body, OverlapCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs, mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
 
     // Compute the broad-phase collision detection
     computeBroadPhase();
@@ -1837,7 +2410,7 @@ void CollisionDetectionSystem::testOverlap(Body* body, OverlapCallback& callback
 // Test collision and report contacts between two bodies.
 void CollisionDetectionSystem::testCollision(Body* body1, Body* body2, CollisionCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs, mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
 
     // Compute the broad-phase collision detection
     computeBroadPhase();
@@ -1860,7 +2433,7 @@ void CollisionDetectionSystem::testCollision(Body* body1, Body* body2, Collision
 // Test collision and report all the contacts involving the body in parameter
 void CollisionDetectionSystem::testCollision(Body* body, CollisionCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs, mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
 
     // Compute the broad-phase collision detection
     computeBroadPhase();
@@ -1883,7 +2456,7 @@ void CollisionDetectionSystem::testCollision(Body* body, CollisionCallback& call
 // Test collision and report contacts between each colliding bodies in the world
 void CollisionDetectionSystem::testCollision(CollisionCallback& callback) {
 
-    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs);
+    NarrowPhaseInput narrowPhaseInput(mMemoryManager.getPoolAllocator(), mOverlappingPairs, mMemoryManager.getPoolAllocator(), mTriangleHalfEdgeStructure);
 
     // Compute the broad-phase collision detection
     computeBroadPhase();
@@ -1963,3 +2536,88 @@ const AABB CollisionDetectionSystem::getWorldAABB(const Collider* collider) cons
     assert(collider->getBroadPhaseId() > -1);
     return mBroadPhaseSystem.getFatAABB(collider->getBroadPhaseId());
 }
+
+// Write an array of contacts of the current frame into a world snapshot
+template<typename T>
+void CollisionDetectionSystem::writeContactsSnapshot(BinaryWriter& writer, const Array<T>& contacts) {
+
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable contacts can be written into a snapshot");
+
+    const uint32 nbContacts = static_cast<uint32>(contacts.size());
+    writer.write(nbContacts);
+    if (nbContacts > 0) {
+        writer.writeBytes(&(contacts[0]), nbContacts * sizeof(T));
+    }
+}
+
+// Read an array of contacts of the current frame from a world snapshot
+template<typename T>
+bool CollisionDetectionSystem::readContactsSnapshot(BinaryReader& reader, Array<T>& contacts) {
+
+    const uint32 nbContacts = reader.read<uint32>();
+    if (!reader.hasRemaining(nbContacts, sizeof(T))) {
+        return false;
+    }
+
+    contacts.clear();
+    contacts.reserve(nbContacts);
+    contacts.addWithoutInit(nbContacts);
+    if (nbContacts > 0) {
+        reader.readBytes(&(contacts[0]), nbContacts * sizeof(T));
+    }
+
+    return true;
+}
+
+// Write the broad-phase, the overlapping pairs and the contacts of the current frame into a world snapshot
+/// The contacts of the current frame are written because they are used to warm start the
+/// contact solver and to detect the lost contacts during the next update of the world.
+/**
+ * @param writer The writer used to write the snapshot
+ */
+void CollisionDetectionSystem::takeSnapshot(BinaryWriter& writer) const {
+
+    mBroadPhaseSystem.takeSnapshot(writer);
+    mOverlappingPairs.takeSnapshot(writer);
+
+    writer.write(mNbPreviousPotentialContactManifolds);
+    writer.write(mNbPreviousPotentialContactPoints);
+    writeContactsSnapshot(writer, *mCurrentContactPairs);
+    writeContactsSnapshot(writer, *mCurrentContactManifolds);
+    writeContactsSnapshot(writer, *mCurrentContactPoints);
+}
+
+// Restore the broad-phase, the overlapping pairs and the contacts of the current frame from a world snapshot
+/**
+ * @param reader The reader used to read the snapshot
+ * @return True if the snapshot has been restored
+ */
+bool CollisionDetectionSystem::restoreSnapshot(BinaryReader& reader) {
+
+    if (!mBroadPhaseSystem.restoreSnapshot(reader) || !mOverlappingPairs.restoreSnapshot(reader)) {
+        return false;
+    }
+
+    mNbPreviousPotentialContactManifolds = reader.read<uint32>();
+    mNbPreviousPotentialContactPoints = reader.read<uint32>();
+    if (!readContactsSnapshot(reader, *mCurrentContactPairs) || !readContactsSnapshot(reader, *mCurrentContactManifolds) ||
+        !readContactsSnapshot(reader, *mCurrentContactPoints)) {
+
+        mCurrentContactPairs->clear();
+        mCurrentContactManifolds->clear();
+        mCurrentContactPoints->clear();
+        computeMapPreviousContactPairs();
+        return false;
+    }
+
+    // The contacts of the previous frame are not used anymore at this point
+    mPreviousContactPairs->clear();
+    mPreviousContactManifolds->clear();
+    mPreviousContactPoints->clear();
+    mLostContactPairs.clear();
+
+    // Compute the map from contact pairs ids to contact pair for the next frame
+    computeMapPreviousContactPairs();
+
+    return !reader.hasError();
+}
@@ -783,10 +783,10 @@ decimal SolveHingeJointSystem::computeCurrentHingeAngle(Entity jointEntity, cons
 
     // If the relative rotation axis and the hinge axis are pointing the same direction
     if (dotProduct >= decimal(0.0)) {
-        hingeAngle = decimal(2.0) * std::atan2(sinHalfAngleAbs, cosHalfAngle);
+        hingeAngle = decimal(2.0) * computeAtan2(sinHalfAngleAbs, cosHalfAngle);
     }
     else {
-        hingeAngle = decimal(2.0) * std::atan2(sinHalfAngleAbs, -cosHalfAngle);
+        hingeAngle = decimal(2.0) * computeAtan2(sinHalfAngleAbs, -cosHalfAngle);
     }
 
     // Convert the angle from range [-2*pi; 2*pi] into the range [-pi; pi]
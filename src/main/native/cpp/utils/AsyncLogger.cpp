@@ -0,0 +1,442 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/utils/AsyncLogger.h>
+#include <algorithm>
+#include <cstring>
+
+using namespace reactphysics3d;
+
+namespace {
+
+// Return the number of slots of the queue (power of two) for a requested capacity
+uint32 computeQueueCapacity(uint32 requestedCapacity) {
+    uint32 capacity = AsyncLogger::MIN_QUEUE_CAPACITY;
+    while (capacity < requestedCapacity && capacity < (1u << 30)) {
+        capacity <<= 1;
+    }
+    return capacity;
+}
+
+// Write a variable-length integer (7 bits per byte, least significant group first)
+void writeVarint(std::ostream& stream, uint64 value) {
+    while (value >= 0x80) {
+        stream.put(static_cast<char>((value & 0x7F) | 0x80));
+        value >>= 7;
+    }
+    stream.put(static_cast<char>(value));
+}
+
+// Write a little-endian integer of a given number of bytes
+void writeLittleEndian(std::ostream& stream, uint64 value, uint32 nbBytes) {
+    for (uint32 i = 0; i < nbBytes; i++) {
+        stream.put(static_cast<char>((value >> (8 * i)) & 0xFF));
+    }
+}
+
+// Write a string with its size
+void writeString(std::ostream& stream, const std::string& string) {
+    writeVarint(stream, string.size());
+    stream.write(string.data(), static_cast<std::streamsize>(string.size()));
+}
+
+}
+
+// Constructor
+AsyncLogger::AsyncLogger(MemoryAllocator& allocator, uint32 queueCapacity)
+    : mAllocator(allocator), mSlots(nullptr), mCapacity(computeQueueCapacity(queueCapacity)), mEnqueuePosition(0),
+      mDequeuePosition(0), mNbDroppedMessages(0), mStartTime(std::chrono::steady_clock::now()),
+      mStartSystemTime(static_cast<uint64>(std::chrono::duration_cast<std::chrono::microseconds>(
+                           std::chrono::system_clock::now().time_since_epoch()).count())),
+      mDestinations(allocator), mIsStopping(false) {
+
+    // Create the slots of the queue (each slot is free for its first position)
+    mSlots = static_cast<Slot*>(mAllocator.allocate(mCapacity * sizeof(Slot)));
+    for (uint32 i = 0; i < mCapacity; i++) {
+        new (mSlots + i) Slot();
+        mSlots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+
+    // Nothing is logged until a destination is added
+    mMaxLevelFlag.store(0, std::memory_order_relaxed);
+
+    mWriterThread = std::thread(&AsyncLogger::runWriterThread, this);
+}
+
+// Destructor
+AsyncLogger::~AsyncLogger() {
+
+    // Stop the writer thread (it writes the remaining messages before it stops)
+    mIsStopping.store(true, std::memory_order_release);
+    mWakeUpCondition.notify_one();
+    mWriterThread.join();
+
+    {
+        std::lock_guard<std::mutex> lock(mDestinationsMutex);
+        writeDroppedMessages();
+        deleteDestinations();
+    }
+
+    for (uint32 i = 0; i < mCapacity; i++) {
+        mSlots[i].~Slot();
+    }
+    mAllocator.release(mSlots, mCapacity * sizeof(Slot));
+}
+
+// Add a file destination in the binary format
+/**
+ * @param filePath The path of the binary log file
+ * @param logLevelFlag The maximum level flag of the messages written in the file
+ * @return False if the file cannot be opened
+ */
+bool AsyncLogger::addBinaryFileDestination(const std::string& filePath, uint logLevelFlag) {
+
+    std::ofstream* fileStream = new std::ofstream(filePath, std::ios::binary);
+    if (!fileStream->is_open()) {
+        delete fileStream;
+        return false;
+    }
+
+    addDestination(fileStream, fileStream, true, logLevelFlag);
+
+    return true;
+}
+
+// Add a stream destination in the binary format
+/**
+ * @param outputStream The binary output stream (it must outlive the destination)
+ * @param logLevelFlag The maximum level flag of the messages written in the stream
+ */
+void AsyncLogger::addBinaryStreamDestination(std::ostream& outputStream, uint logLevelFlag) {
+    addDestination(&outputStream, nullptr, true, logLevelFlag);
+}
+
+// Add a stream destination with a text line per message
+/**
+ * @param outputStream The output stream (it must outlive the destination)
+ * @param logLevelFlag The maximum level flag of the messages written in the stream
+ */
+void AsyncLogger::addTextStreamDestination(std::ostream& outputStream, uint logLevelFlag) {
+    addDestination(&outputStream, nullptr, false, logLevelFlag);
+}
+
+// Add a destination
+void AsyncLogger::addDestination(std::ostream* stream, std::ofstream* fileStream, bool isBinary, uint logLevelFlag) {
+
+    std::lock_guard<std::mutex> lock(mDestinationsMutex);
+
+    Destination* destination = new (mAllocator.allocate(sizeof(Destination)))
+                                   Destination(mAllocator, stream, fileStream, isBinary, logLevelFlag);
+    mDestinations.add(destination);
+
+    // Header of the binary log
+    if (isBinary) {
+        stream->write(BinaryLogDecoder::MAGIC, sizeof(BinaryLogDecoder::MAGIC));
+        writeLittleEndian(*stream, BinaryLogDecoder::FORMAT_VERSION, 4);
+        writeLittleEndian(*stream, mStartSystemTime, 8);
+    }
+
+    updateMaxLevelFlag();
+}
+
+// Remove all the destinations (the messages still in the queue are written before)
+void AsyncLogger::removeAllDestinations() {
+
+    flush();
+
+    std::lock_guard<std::mutex> lock(mDestinationsMutex);
+    deleteDestinations();
+}
+
+// Delete all the destinations (the destinations must be locked)
+void AsyncLogger::deleteDestinations() {
+
+    for (uint32 i = 0; i < mDestinations.size(); i++) {
+
+        mDestinations[i]->stream->flush();
+        delete mDestinations[i]->fileStream;
+
+        mDestinations[i]->~Destination();
+        mAllocator.release(mDestinations[i], sizeof(Destination));
+    }
+    mDestinations.clear();
+
+    updateMaxLevelFlag();
+}
+
+// Update the maximum level flag of the logged messages from the destinations
+void AsyncLogger::updateMaxLevelFlag() {
+
+    uint maxLevelFlag = 0;
+    for (uint32 i = 0; i < mDestinations.size(); i++) {
+        maxLevelFlag = std::max(maxLevelFlag, mDestinations[i]->maxLevelFlag);
+    }
+
+    mMaxLevelFlag.store(maxLevelFlag, std::memory_order_relaxed);
+}
+
+// Wait until all the messages logged before this call are written and flush the destinations
+void AsyncLogger::flush() {
+
+    const uint64 position = mEnqueuePosition.load(std::memory_order_acquire);
+    while (mDequeuePosition.load(std::memory_order_acquire) < position) {
+        mWakeUpCondition.notify_one();
+        std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> lock(mDestinationsMutex);
+    writeDroppedMessages();
+    for (uint32 i = 0; i < mDestinations.size(); i++) {
+        mDestinations[i]->stream->flush();
+    }
+}
+
+// Log something (copy the message into the queue)
+/**
+ * This method does not block and can be called from any thread. The filename must stay valid
+ * until the message is written (this is the case of a string literal such as __FILE__).
+ */
+void AsyncLogger::log(Level level, const std::string& physicsWorldName, Category category, const std::string& message,
+                      const char* filename, int lineNumber) {
+
+    if (!isLevelEnabled(level)) {
+        return;
+    }
+
+    MessageHeader header;
+    header.time = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                          std::chrono::steady_clock::now() - mStartTime).count());
+    header.filename = filename;
+    header.lineNumber = lineNumber;
+    header.level = static_cast<uint8>(level);
+    header.category = static_cast<uint8>(category);
+
+    // A message uses at most a quarter of the queue (longer messages are truncated)
+    header.worldNameSize = static_cast<uint16>(std::min<size_t>(physicsWorldName.size(), MAX_WORLD_NAME_SIZE));
+    const uint32 maxMessageSize = (mCapacity / 4) * SLOT_DATA_SIZE - sizeof(MessageHeader) - header.worldNameSize;
+    header.messageSize = static_cast<uint32>(std::min<size_t>(message.size(), maxMessageSize));
+    const uint32 nbSlots = (sizeof(MessageHeader) + header.worldNameSize + header.messageSize + SLOT_DATA_SIZE - 1) /
+                           SLOT_DATA_SIZE;
+
+    // Reserve consecutive slots. The slots are free if the last one is free because the writer
+    // thread frees the slots in order.
+    uint64 position = mEnqueuePosition.load(std::memory_order_relaxed);
+    while (true) {
+
+        const uint64 lastPosition = position + nbSlots - 1;
+        const uint64 sequence = mSlots[lastPosition & (mCapacity - 1)].sequence.load(std::memory_order_acquire);
+        const int64 difference = static_cast<int64>(sequence - lastPosition);
+
+        if (difference == 0) {
+            if (mEnqueuePosition.compare_exchange_weak(position, position + nbSlots, std::memory_order_relaxed)) {
+                break;
+            }
+        }
+        else if (difference < 0) {
+
+            // The queue is full
+            mNbDroppedMessages.fetch_add(1, std::memory_order_relaxed);
+            return;
+        }
+        else {
+            position = mEnqueuePosition.load(std::memory_order_relaxed);
+        }
+    }
+
+    // Copy the message and publish it (the first slot is published last)
+    writeToSlots(position, 0, &header, sizeof(MessageHeader));
+    writeToSlots(position, sizeof(MessageHeader), physicsWorldName.data(), header.worldNameSize);
+    writeToSlots(position, sizeof(MessageHeader) + header.worldNameSize, message.data(), header.messageSize);
+    mSlots[position & (mCapacity - 1)].sequence.store(position + 1, std::memory_order_release);
+}
+
+// Copy bytes into the slots of the queue from a given position and offset
+void AsyncLogger::writeToSlots(uint64 position, uint32 offset, const void* data, uint32 size) {
+
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    while (size > 0) {
+        Slot& slot = mSlots[(position + offset / SLOT_DATA_SIZE) & (mCapacity - 1)];
+        const uint32 slotOffset = offset % SLOT_DATA_SIZE;
+        const uint32 nbBytes = std::min(size, SLOT_DATA_SIZE - slotOffset);
+        std::memcpy(slot.data + slotOffset, bytes, nbBytes);
+        bytes += nbBytes;
+        offset += nbBytes;
+        size -= nbBytes;
+    }
+}
+
+// Copy bytes from the slots of the queue from a given position and offset
+void AsyncLogger::readFromSlots(uint64 position, uint32 offset, void* data, uint32 size) const {
+
+    unsigned char* bytes = static_cast<unsigned char*>(data);
+    while (size > 0) {
+        const Slot& slot = mSlots[(position + offset / SLOT_DATA_SIZE) & (mCapacity - 1)];
+        const uint32 slotOffset = offset % SLOT_DATA_SIZE;
+        const uint32 nbBytes = std::min(size, SLOT_DATA_SIZE - slotOffset);
+        std::memcpy(bytes, slot.data + slotOffset, nbBytes);
+        bytes += nbBytes;
+        offset += nbBytes;
+        size -= nbBytes;
+    }
+}
+
+// Main loop of the writer thread
+void AsyncLogger::runWriterThread() {
+
+    while (true) {
+
+        // The messages published before the stop request are written before the thread stops
+        const bool isStopping = mIsStopping.load(std::memory_order_acquire);
+        const bool hasWrittenMessages = writeReadyMessages();
+
+        if (!hasWrittenMessages) {
+
+            if (isStopping) {
+                break;
+            }
+
+            // The producers never wait, so the queue is polled when it is empty
+            std::unique_lock<std::mutex> lock(mWakeUpMutex);
+            mWakeUpCondition.wait_for(lock, std::chrono::milliseconds(5));
+        }
+    }
+}
+
+// Write all the ready messages of the queue. Return true if a message has been written.
+bool AsyncLogger::writeReadyMessages() {
+
+    std::lock_guard<std::mutex> lock(mDestinationsMutex);
+
+    writeDroppedMessages();
+
+    bool hasWrittenMessages = false;
+    uint64 position = mDequeuePosition.load(std::memory_order_relaxed);
+    BinaryLogDecoder::Record record;
+
+    while (mSlots[position & (mCapacity - 1)].sequence.load(std::memory_order_acquire) == position + 1) {
+
+        MessageHeader header;
+        readFromSlots(position, 0, &header, sizeof(MessageHeader));
+        const uint32 nbSlots = (sizeof(MessageHeader) + header.worldNameSize + header.messageSize + SLOT_DATA_SIZE - 1) /
+                               SLOT_DATA_SIZE;
+
+        record.time = header.time;
+        record.level = static_cast<Level>(header.level);
+        record.category = static_cast<Category>(header.category);
+        record.lineNumber = header.lineNumber;
+        record.worldName.resize(header.worldNameSize);
+        record.message.resize(header.messageSize);
+        readFromSlots(position, sizeof(MessageHeader), &record.worldName[0], header.worldNameSize);
+        readFromSlots(position, sizeof(MessageHeader) + header.worldNameSize, &record.message[0], header.messageSize);
+
+        // Free the slots for the next lap of the queue
+        for (uint32 i = 0; i < nbSlots; i++) {
+            mSlots[(position + i) & (mCapacity - 1)].sequence.store(position + i + mCapacity, std::memory_order_release);
+        }
+        position += nbSlots;
+        mDequeuePosition.store(position, std::memory_order_release);
+
+        for (uint32 i = 0; i < mDestinations.size(); i++) {
+            if (header.level <= mDestinations[i]->maxLevelFlag) {
+                writeRecord(*mDestinations[i], record, header.filename);
+            }
+        }
+
+        hasWrittenMessages = true;
+    }
+
+    return hasWrittenMessages;
+}
+
+// Write the number of messages dropped since the last report (the destinations must be locked)
+void AsyncLogger::writeDroppedMessages() {
+
+    const uint64 nbDroppedMessages = mNbDroppedMessages.exchange(0, std::memory_order_relaxed);
+    if (nbDroppedMessages > 0) {
+
+        BinaryLogDecoder::Record record;
+        record.time = static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                              std::chrono::steady_clock::now() - mStartTime).count());
+        record.nbDroppedMessages = nbDroppedMessages;
+
+        for (uint32 i = 0; i < mDestinations.size(); i++) {
+            writeRecord(*mDestinations[i], record, nullptr);
+        }
+    }
+}
+
+// Write a record into a destination
+void AsyncLogger::writeRecord(Destination& destination, const BinaryLogDecoder::Record& record, const char* filename) {
+
+    std::ostream& stream = *destination.stream;
+
+    if (!destination.isBinary) {
+        BinaryLogDecoder::Record textRecord = record;
+        textRecord.filename = filename != nullptr ? filename : "";
+        stream << BinaryLogDecoder::formatRecord(textRecord) << '\n';
+        return;
+    }
+
+    if (record.nbDroppedMessages > 0) {
+        stream.put(static_cast<char>(BinaryLogDecoder::DROPPED_RECORD));
+        writeVarint(stream, record.nbDroppedMessages);
+        return;
+    }
+
+    const uint32 worldNameIndex = getStringIndex(destination, record.worldName);
+    const uint32 filenameIndex = getStringIndex(destination, filename != nullptr ? filename : "");
+
+    // The messages of different threads are not always in the order of their time, so the
+    // time difference is zigzag encoded
+    const int64 deltaTime = static_cast<int64>(record.time - destination.previousTime);
+    destination.previousTime = record.time;
+
+    stream.put(static_cast<char>(BinaryLogDecoder::MESSAGE_RECORD));
+    writeVarint(stream, (static_cast<uint64>(deltaTime) << 1) ^ static_cast<uint64>(deltaTime >> 63));
+    writeVarint(stream, static_cast<uint64>(record.level) | (static_cast<uint64>(record.category) << 3));
+    writeVarint(stream, worldNameIndex);
+    writeVarint(stream, filenameIndex);
+    writeVarint(stream, static_cast<uint64>(std::max(record.lineNumber, 0)));
+    writeString(stream, record.message);
+}
+
+// Return the index of a string of a binary destination (the string is defined if needed)
+uint32 AsyncLogger::getStringIndex(Destination& destination, const std::string& string) {
+
+    auto it = destination.stringIndices.find(string);
+    if (it != destination.stringIndices.end()) {
+        return it->second;
+    }
+
+    const uint32 index = destination.stringIndices.size();
+    destination.stringIndices.add(Pair<std::string, uint32>(string, index));
+
+    destination.stream->put(static_cast<char>(BinaryLogDecoder::STRING_RECORD));
+    writeVarint(*destination.stream, index);
+    writeString(*destination.stream, string);
+
+    return index;
+}
@@ -0,0 +1,239 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/utils/BinaryLogDecoder.h>
+#include <cstring>
+#include <ctime>
+#include <iomanip>
+#include <sstream>
+
+using namespace reactphysics3d;
+
+namespace {
+
+// Read a byte. Return false at the end of the input.
+bool readByte(std::istream& input, uint8& outByte) {
+    const int character = input.get();
+    if (character == std::char_traits<char>::eof()) {
+        return false;
+    }
+    outByte = static_cast<uint8>(character);
+    return true;
+}
+
+// Read a variable-length integer (7 bits per byte, least significant group first)
+bool readVarint(std::istream& input, uint64& outValue) {
+    outValue = 0;
+    for (uint32 shift = 0; shift < 64; shift += 7) {
+        uint8 byte;
+        if (!readByte(input, byte)) {
+            return false;
+        }
+        outValue |= static_cast<uint64>(byte & 0x7F) << shift;
+        if ((byte & 0x80) == 0) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Read a little-endian integer of a given number of bytes
+bool readLittleEndian(std::istream& input, uint32 nbBytes, uint64& outValue) {
+    outValue = 0;
+    for (uint32 i = 0; i < nbBytes; i++) {
+        uint8 byte;
+        if (!readByte(input, byte)) {
+            return false;
+        }
+        outValue |= static_cast<uint64>(byte) << (8 * i);
+    }
+    return true;
+}
+
+// Read a string with its size
+bool readString(std::istream& input, std::string& outString) {
+    uint64 size;
+    if (!readVarint(input, size) || size > (1ull << 24)) {
+        return false;
+    }
+    outString.resize(size);
+    input.read(&outString[0], static_cast<std::streamsize>(size));
+    return static_cast<uint64>(input.gcount()) == size;
+}
+
+// Return true if the packed level (three lowest bits) and category of a message are valid
+bool isValidLevelAndCategory(uint64 levelAndCategory) {
+    const uint64 level = levelAndCategory & 0x7;
+    const uint64 category = levelAndCategory >> 3;
+    return (level == 1 || level == 2 || level == 4) && category <= static_cast<uint64>(Logger::Category::Collider);
+}
+
+}
+
+// Decode a binary log and call a function for each record. Return false if the log is invalid.
+/**
+ * @param input The stream of the binary log
+ * @param recordCallback The function called with each decoded record
+ * @param messages The error messages if the log is invalid
+ * @param outStartTime If not null, set to the system time of the start of the logger (in microseconds since the epoch)
+ * @return True if the whole log has been decoded
+ */
+bool BinaryLogDecoder::decode(std::istream& input, const std::function<void(const Record&)>& recordCallback,
+                              std::vector<Message>& messages, uint64* outStartTime) {
+
+    // Header
+    char magic[sizeof(MAGIC)];
+    input.read(magic, sizeof(magic));
+    uint64 version, startTime;
+    if (input.gcount() != sizeof(magic) || std::memcmp(magic, MAGIC, sizeof(MAGIC)) != 0 ||
+        !readLittleEndian(input, 4, version) || !readLittleEndian(input, 8, startTime)) {
+        messages.push_back(Message("The input is not a binary log of ReactPhysics3D"));
+        return false;
+    }
+    if (version != FORMAT_VERSION) {
+        messages.push_back(Message("Unsupported version " + std::to_string(version) + " of the binary log format"));
+        return false;
+    }
+    if (outStartTime != nullptr) {
+        *outStartTime = startTime;
+    }
+
+    std::vector<std::string> strings;
+    Record record;
+    uint64 time = 0;
+    uint8 kind;
+    while (readByte(input, kind)) {
+
+        bool isValid = false;
+        switch (kind) {
+
+            case STRING_RECORD: {
+                uint64 index;
+                std::string string;
+                isValid = readVarint(input, index) && index == strings.size() && readString(input, string);
+                strings.push_back(string);
+                break;
+            }
+
+            case MESSAGE_RECORD: {
+                uint64 deltaTime, levelAndCategory, worldNameIndex, filenameIndex, lineNumber;
+                isValid = readVarint(input, deltaTime) && readVarint(input, levelAndCategory) &&
+                          readVarint(input, worldNameIndex) && readVarint(input, filenameIndex) &&
+                          readVarint(input, lineNumber) && readString(input, record.message) &&
+                          worldNameIndex < strings.size() && filenameIndex < strings.size() &&
+                          isValidLevelAndCategory(levelAndCategory);
+                if (isValid) {
+
+                    // The time difference is zigzag encoded (it can be negative)
+                    time += (deltaTime >> 1) ^ (~(deltaTime & 1) + 1);
+                    record.time = time;
+                    record.level = static_cast<Logger::Level>(levelAndCategory & 0x7);
+                    record.category = static_cast<Logger::Category>(levelAndCategory >> 3);
+                    record.worldName = strings[worldNameIndex];
+                    record.filename = strings[filenameIndex];
+                    record.lineNumber = static_cast<int>(lineNumber);
+                    record.nbDroppedMessages = 0;
+                    recordCallback(record);
+                }
+                break;
+            }
+
+            case DROPPED_RECORD: {
+                Record droppedRecord;
+                isValid = readVarint(input, droppedRecord.nbDroppedMessages);
+                if (isValid) {
+                    droppedRecord.time = time;
+                    recordCallback(droppedRecord);
+                }
+                break;
+            }
+
+            default:
+                break;
+        }
+
+        if (!isValid) {
+            messages.push_back(Message("Invalid record of kind " + std::to_string(kind) + " in the binary log"));
+            return false;
+        }
+    }
+
+    return true;
+}
+
+// Decode a binary log into text lines. Return false if the log is invalid.
+/**
+ * @param input The stream of the binary log
+ * @param output The stream where to write a text line per record (after a header with the start date)
+ * @param messages The error messages if the log is invalid
+ * @return True if the whole log has been decoded
+ */
+bool BinaryLogDecoder::decodeToText(std::istream& input, std::ostream& output, std::vector<Message>& messages) {
+
+    bool isHeaderWritten = false;
+    uint64 startTime = 0;
+
+    return decode(input, [&](const Record& record) {
+
+        if (!isHeaderWritten) {
+            const std::time_t time = static_cast<std::time_t>(startTime / 1000000);
+            std::tm localTime = std::tm();
+#if defined(_MSC_VER)
+            localtime_s(&localTime, &time);
+#else
+            localtime_r(&time, &localTime);
+#endif
+            output << "ReactPhysics3D Logs" << std::endl;
+            output << "Start: " << std::put_time(&localTime, "%Y-%m-%d %X") << std::endl;
+            output << "---------------------------------------------------------" << std::endl;
+            isHeaderWritten = true;
+        }
+
+        output << formatRecord(record) << std::endl;
+
+    }, messages, &startTime);
+}
+
+// Return the text line of a record
+/**
+ * The line starts with the time of the message in seconds since the start of the logger.
+ */
+std::string BinaryLogDecoder::formatRecord(const Record& record) {
+
+    std::stringstream ss;
+    ss << "[" << std::fixed << std::setprecision(6) << std::setw(12) << double(record.time) * 1e-9 << "] ";
+
+    if (record.nbDroppedMessages > 0) {
+        ss << record.nbDroppedMessages << " messages dropped (the queue of the logger was full)";
+        return ss.str();
+    }
+
+    ss << "World:" << record.worldName << " " << Logger::getLevelName(record.level) << " "
+       << Logger::getCategoryName(record.category) << ": " << record.message
+       << " (in file " << record.filename << " at line " << record.lineNumber << ")";
+
+    return ss.str();
+}
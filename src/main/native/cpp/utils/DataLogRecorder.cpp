@@ -0,0 +1,271 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/utils/DataLogRecorder.h>
+#include <reactphysics3d/engine/PhysicsWorld.h>
+#include <wpi/DataLog.h>
+#include <wpi/DataLogBackgroundWriter.h>
+#include <cassert>
+#include <cstring>
+#include <string>
+
+// We want to use the ReactPhysics3D namespace
+using namespace reactphysics3d;
+
+namespace {
+
+// Size of a packed Translation3d struct (in bytes)
+constexpr size_t TRANSLATION3D_SIZE = 3 * sizeof(double);
+
+// Size of a packed Pose3d struct (in bytes)
+constexpr size_t POSE3D_SIZE = 7 * sizeof(double);
+
+// Size of a packed RP3DStepStats struct (in bytes)
+constexpr size_t STEP_STATS_SIZE = 10 * sizeof(uint32) + 7 * sizeof(double);
+
+// Struct schemas (the WPILib geometry structs are used for the poses so that they can be displayed directly)
+constexpr std::string_view TRANSLATION3D_SCHEMA = "double x;double y;double z";
+constexpr std::string_view QUATERNION_SCHEMA = "double w;double x;double y;double z";
+constexpr std::string_view ROTATION3D_SCHEMA = "Quaternion q";
+constexpr std::string_view POSE3D_SCHEMA = "Translation3d translation;Rotation3d rotation";
+constexpr std::string_view STEP_STATS_SCHEMA =
+        "uint32 nbOverlappingPairs;uint32 nbNarrowPhaseTests;uint32 nbContactPairs;uint32 nbContactManifolds;"
+        "uint32 nbContactPoints;uint32 nbIslands;uint32 nbAwakeBodies;uint32 nbVelocitySolverIterations;"
+        "uint32 nbPositionSolverIterations;uint32 nbBroadPhaseReinsertions;double broadPhaseTime;double middlePhaseTime;"
+        "double narrowPhaseTime;double islandsTime;double solveTime;double integrateTime;double totalTime";
+
+// Write an unsigned integer in little-endian (the byte order of the WPILib structs)
+uint8_t* writeUint(uint8_t* dest, uint64 value, size_t nbBytes) {
+
+    for (size_t i=0; i < nbBytes; i++) {
+        dest[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+    return dest + nbBytes;
+}
+
+// Write a double in little-endian
+uint8_t* writeDouble(uint8_t* dest, double value) {
+
+    uint64 bits;
+    std::memcpy(&bits, &value, sizeof(double));
+    return writeUint(dest, bits, sizeof(double));
+}
+
+// Write a Translation3d struct
+uint8_t* writeTranslation3d(uint8_t* dest, const Vector3& vector) {
+
+    dest = writeDouble(dest, vector.x);
+    dest = writeDouble(dest, vector.y);
+    return writeDouble(dest, vector.z);
+}
+
+// Add a struct schema to the log if it is not already there
+void addStructSchema(wpi::log::DataLog& log, std::string_view typeName, std::string_view schema) {
+
+    std::string name = "struct:";
+    name += typeName;
+    if (!log.HasSchema(name)) {
+        log.AddSchema(name, "structschema", schema);
+    }
+}
+
+}
+
+// Constructor to record into an existing data log
+/**
+ * @param world The physics world to record
+ * @param log The data log where the records are appended (it must outlive the recorder)
+ * @param prefix Prefix of the names of the log entries
+ */
+DataLogRecorder::DataLogRecorder(PhysicsWorld& world, wpi::log::DataLog& log, std::string_view prefix)
+                : mWorld(world), mOwnedLog(nullptr), mLog(log), mPosesEntry(0), mBodiesEntry(0), mStepStatsEntry(0),
+                  mContactPointsEntry(0), mNbRecords(0) {
+
+    startEntries(prefix);
+}
+
+// Constructor to record into a new .wpilog file written by a background thread
+/**
+ * @param world The physics world to record
+ * @param directory Directory of the log file (the directory must exist)
+ * @param filename Name of the log file (a name with a random part is chosen by WPILib if it is empty)
+ * @param flushPeriod Time (in seconds) between two writes of the buffered records to the file
+ * @param prefix Prefix of the names of the log entries
+ */
+DataLogRecorder::DataLogRecorder(PhysicsWorld& world, std::string_view directory, std::string_view filename,
+                                 double flushPeriod, std::string_view prefix)
+                : mWorld(world), mOwnedLog(std::make_unique<wpi::log::DataLogBackgroundWriter>(directory, filename, flushPeriod)),
+                  mLog(*mOwnedLog), mPosesEntry(0), mBodiesEntry(0), mStepStatsEntry(0), mContactPointsEntry(0), mNbRecords(0) {
+
+    startEntries(prefix);
+}
+
+// Destructor
+// The log owned by the recorder writes its remaining records and closes the file when it is destroyed
+DataLogRecorder::~DataLogRecorder() {
+
+    mLog.Finish(mPosesEntry);
+    mLog.Finish(mBodiesEntry);
+    mLog.Finish(mStepStatsEntry);
+    mLog.Finish(mContactPointsEntry);
+}
+
+// Add the struct schemas and start the entries of the log
+void DataLogRecorder::startEntries(std::string_view prefix) {
+
+    addStructSchema(mLog, "Translation3d", TRANSLATION3D_SCHEMA);
+    addStructSchema(mLog, "Quaternion", QUATERNION_SCHEMA);
+    addStructSchema(mLog, "Rotation3d", ROTATION3D_SCHEMA);
+    addStructSchema(mLog, "Pose3d", POSE3D_SCHEMA);
+    addStructSchema(mLog, "RP3DStepStats", STEP_STATS_SCHEMA);
+
+    const std::string prefixString(prefix);
+    mPosesEntry = mLog.Start(prefixString + "/Poses", "struct:Pose3d[]");
+    mBodiesEntry = mLog.Start(prefixString + "/Bodies", "int64[]");
+    mStepStatsEntry = mLog.Start(prefixString + "/StepStats", "struct:RP3DStepStats");
+    mContactPointsEntry = mLog.Start(prefixString + "/ContactPoints", "struct:Translation3d[]");
+}
+
+// Append the state of the world after its last step
+/// This method should be called after each call of PhysicsWorld::update() (or every few steps to reduce
+/// the size of the log). The cost of a call is a copy of the transforms of the bodies and a few appends
+/// to the log, whatever the number of bodies.
+/**
+ * @param timestamp Time of the records in microseconds (0 to use the current time of WPILib)
+ */
+void DataLogRecorder::record(int64_t timestamp) {
+
+    recordBodies(timestamp);
+    recordPoses(timestamp);
+    recordStepStats(timestamp);
+
+    if (mWorld.getIsContactEventBufferEnabled()) {
+        recordContactPoints(timestamp);
+    }
+
+    mNbRecords++;
+}
+
+// Ask the data log to write its buffered records
+void DataLogRecorder::flush() {
+    mLog.Flush();
+}
+
+// Append the ids of the bodies if their order has changed since the last record
+// The order of the transform components only changes when bodies are added, removed, disabled or enabled
+void DataLogRecorder::recordBodies(int64_t timestamp) {
+
+    const TransformComponents& transforms = mWorld.mTransformComponents;
+    const uint32 nbBodies = transforms.getNbComponents();
+
+    bool hasChanged = nbBodies != mRecordedBodies.size() || mNbRecords == 0;
+    for (uint32 i=0; i < nbBodies && !hasChanged; i++) {
+        hasChanged = transforms.mBodies[i].id != mRecordedBodies[i];
+    }
+
+    if (!hasChanged) return;
+
+    mRecordedBodies.resize(nbBodies);
+    mBuffer.resize(nbBodies * sizeof(int64_t));
+    uint8_t* dest = mBuffer.data();
+    for (uint32 i=0; i < nbBodies; i++) {
+        mRecordedBodies[i] = transforms.mBodies[i].id;
+        dest = writeUint(dest, transforms.mBodies[i].id, sizeof(int64_t));
+    }
+
+    mLog.AppendRaw(mBodiesEntry, mBuffer, timestamp);
+}
+
+// Append the poses of the bodies
+void DataLogRecorder::recordPoses(int64_t timestamp) {
+
+    const TransformComponents& transforms = mWorld.mTransformComponents;
+    const uint32 nbBodies = transforms.getNbComponents();
+
+    mBuffer.resize(nbBodies * POSE3D_SIZE);
+    uint8_t* dest = mBuffer.data();
+    for (uint32 i=0; i < nbBodies; i++) {
+
+        const Transform& transform = transforms.mTransforms[i];
+        const Quaternion& orientation = transform.getOrientation();
+
+        dest = writeTranslation3d(dest, transform.getPosition());
+        dest = writeDouble(dest, orientation.w);
+        dest = writeDouble(dest, orientation.x);
+        dest = writeDouble(dest, orientation.y);
+        dest = writeDouble(dest, orientation.z);
+    }
+
+    mLog.AppendRaw(mPosesEntry, mBuffer, timestamp);
+}
+
+// Append the statistics of the last step
+void DataLogRecorder::recordStepStats(int64_t timestamp) {
+
+    const StepStats& stats = mWorld.getLastStepStats();
+
+    mBuffer.resize(STEP_STATS_SIZE);
+    uint8_t* dest = mBuffer.data();
+    dest = writeUint(dest, stats.nbOverlappingPairs, sizeof(uint32));
+    dest = writeUint(dest, stats.nbNarrowPhaseTests, sizeof(uint32));
+    dest = writeUint(dest, stats.nbContactPairs, sizeof(uint32));
+    dest = writeUint(dest, stats.nbContactManifolds, sizeof(uint32));
+    dest = writeUint(dest, stats.nbContactPoints, sizeof(uint32));
+    dest = writeUint(dest, stats.nbIslands, sizeof(uint32));
+    dest = writeUint(dest, stats.nbAwakeBodies, sizeof(uint32));
+    dest = writeUint(dest, stats.nbVelocitySolverIterations, sizeof(uint32));
+    dest = writeUint(dest, stats.nbPositionSolverIterations, sizeof(uint32));
+    dest = writeUint(dest, stats.nbBroadPhaseReinsertions, sizeof(uint32));
+    dest = writeDouble(dest, stats.broadPhaseTime);
+    dest = writeDouble(dest, stats.middlePhaseTime);
+    dest = writeDouble(dest, stats.narrowPhaseTime);
+    dest = writeDouble(dest, stats.islandsTime);
+    dest = writeDouble(dest, stats.solveTime);
+    dest = writeDouble(dest, stats.integrateTime);
+    dest = writeDouble(dest, stats.totalTime);
+    assert(dest == mBuffer.data() + STEP_STATS_SIZE);
+
+    mLog.AppendRaw(mStepStatsEntry, mBuffer, timestamp);
+}
+
+// Append the contact points of the contact event buffer
+void DataLogRecorder::recordContactPoints(int64_t timestamp) {
+
+    const ContactEventBuffer& buffer = mWorld.getContactEventBuffer();
+    const Array<ContactEvent>& beginEvents = buffer.getContactEvents(ContactEventBuffer::EventType::Begin);
+    const Array<ContactEvent>& stayEvents = buffer.getContactEvents(ContactEventBuffer::EventType::Stay);
+
+    mBuffer.resize((beginEvents.size() + stayEvents.size()) * TRANSLATION3D_SIZE);
+    uint8_t* dest = mBuffer.data();
+    for (uint32 i=0; i < beginEvents.size(); i++) {
+        dest = writeTranslation3d(dest, beginEvents[i].point);
+    }
+    for (uint32 i=0; i < stayEvents.size(); i++) {
+        dest = writeTranslation3d(dest, stayEvents[i].point);
+    }
+
+    mLog.AppendRaw(mContactPointsEntry, mBuffer, timestamp);
+}
@@ -26,6 +26,7 @@
 // Libraries
 #include <reactphysics3d/utils/DefaultLogger.h>
 #include <reactphysics3d/memory/MemoryManager.h>
+#include <algorithm>
 
 using namespace reactphysics3d;
 
@@ -36,6 +37,9 @@ DefaultLogger::DefaultLogger(MemoryAllocator& allocator)
     // Create the log formatters
     mFormatters.add(Pair<Format, Formatter*>(Format::Text, new TextFormatter()));
     mFormatters.add(Pair<Format, Formatter*>(Format::HTML, new HtmlFormatter()));
+
+    // Nothing is logged until a destination is added
+    mMaxLevelFlag.store(0, std::memory_order_relaxed);
 }
 
 // Destructor
@@ -69,6 +73,8 @@ void DefaultLogger::addFileDestination(const std::string& filePath, uint logLeve
 
     FileDestination* destination = new (mAllocator.allocate(allocatedSize)) FileDestination(filePath, logLevelFlag, getFormatter(format));
     mDestinations.add(destination);
+
+    updateMaxLevelFlag();
 }
 
 /// Add a stream destination to the logger
@@ -79,6 +85,8 @@ void DefaultLogger::addStreamDestination(std::ostream& outputStream, uint logLev
 
     StreamDestination* destination = new (mAllocator.allocate(allocatedSize)) StreamDestination(outputStream, logLevelFlag, getFormatter(format));
     mDestinations.add(destination);
+
+    updateMaxLevelFlag();
 }
 
 // Remove all logs destination previously set
@@ -98,6 +106,19 @@ void DefaultLogger::removeAllDestinations() {
     }
 
     mDestinations.clear();
+
+    updateMaxLevelFlag();
+}
+
+// Update the maximum level flag of the logged messages from the destinations
+void DefaultLogger::updateMaxLevelFlag() {
+
+    uint maxLevelFlag = 0;
+    for (uint32 i=0; i<mDestinations.size(); i++) {
+        maxLevelFlag = std::max(maxLevelFlag, mDestinations[i]->maxLevelFlag);
+    }
+
+    mMaxLevelFlag.store(maxLevelFlag, std::memory_order_relaxed);
 }
 
 // Log something
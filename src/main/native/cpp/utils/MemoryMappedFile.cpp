@@ -0,0 +1,144 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/utils/MemoryMappedFile.h>
+
+#ifdef RP3D_PLATFORM_WINDOWS
+    #ifndef NOMINMAX
+        #define NOMINMAX
+    #endif
+    #include <windows.h>
+#else
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <fcntl.h>
+    #include <unistd.h>
+#endif
+
+using namespace reactphysics3d;
+
+// Constructor
+MemoryMappedFile::MemoryMappedFile()
+                 : mData(nullptr), mSize(0)
+#ifdef RP3D_PLATFORM_WINDOWS
+                 , mFileHandle(nullptr), mMappingHandle(nullptr)
+#endif
+{
+
+}
+
+// Destructor
+MemoryMappedFile::~MemoryMappedFile() {
+    close();
+}
+
+// Map a file into memory
+/**
+ * @param filePath Path of the file to map
+ * @return True if the file has been successfully mapped
+ */
+bool MemoryMappedFile::open(const std::string& filePath) {
+
+    close();
+
+#ifdef RP3D_PLATFORM_WINDOWS
+
+    HANDLE file = CreateFileA(filePath.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                              FILE_ATTRIBUTE_NORMAL, nullptr);
+    if (file == INVALID_HANDLE_VALUE) return false;
+
+    LARGE_INTEGER fileSize;
+    if (!GetFileSizeEx(file, &fileSize) || fileSize.QuadPart == 0) {
+        CloseHandle(file);
+        return false;
+    }
+
+    HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+    if (mapping == nullptr) {
+        CloseHandle(file);
+        return false;
+    }
+
+    void* data = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+    if (data == nullptr) {
+        CloseHandle(mapping);
+        CloseHandle(file);
+        return false;
+    }
+
+    mFileHandle = file;
+    mMappingHandle = mapping;
+    mData = static_cast<const unsigned char*>(data);
+    mSize = static_cast<size_t>(fileSize.QuadPart);
+
+#else
+
+    const int fileDescriptor = ::open(filePath.c_str(), O_RDONLY);
+    if (fileDescriptor < 0) return false;
+
+    struct stat fileStatus;
+    if (fstat(fileDescriptor, &fileStatus) != 0 || fileStatus.st_size <= 0) {
+        ::close(fileDescriptor);
+        return false;
+    }
+
+    void* data = mmap(nullptr, static_cast<size_t>(fileStatus.st_size), PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+
+    // The mapping stays valid after the file descriptor has been closed
+    ::close(fileDescriptor);
+
+    if (data == MAP_FAILED) return false;
+
+    mData = static_cast<const unsigned char*>(data);
+    mSize = static_cast<size_t>(fileStatus.st_size);
+
+#endif
+
+    return true;
+}
+
+// Unmap the file
+void MemoryMappedFile::close() {
+
+    if (mData == nullptr) return;
+
+#ifdef RP3D_PLATFORM_WINDOWS
+
+    UnmapViewOfFile(mData);
+    CloseHandle(static_cast<HANDLE>(mMappingHandle));
+    CloseHandle(static_cast<HANDLE>(mFileHandle));
+    mMappingHandle = nullptr;
+    mFileHandle = nullptr;
+
+#else
+
+    munmap(const_cast<unsigned char*>(mData), mSize);
+
+#endif
+
+    mData = nullptr;
+    mSize = 0;
+}
@@ -0,0 +1,422 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include <reactphysics3d/utils/TraceRecorder.h>
+#include <algorithm>
+#include <cassert>
+#include <fstream>
+#include <iomanip>
+#include <mutex>
+#include <vector>
+
+using namespace reactphysics3d;
+
+namespace {
+
+    /// Default number of events of the ring buffer of each thread
+    const uint32 DEFAULT_NB_EVENTS_PER_THREAD = 1 << 16;
+
+    /// Ring buffer of the events recorded by a thread
+    struct ThreadTraceBuffer {
+
+        /// Events of the ring buffer
+        TraceRecorder::Event* events;
+
+        /// Capacity of the ring buffer minus one (the capacity is a power of two)
+        uint64 capacityMask;
+
+        /// Total number of events written into the ring buffer
+        std::atomic<uint64> nbWrittenEvents;
+
+        /// Id of the thread in the exported traces
+        uint32 threadId;
+
+        /// Name of the thread in the exported traces
+        std::string name;
+
+        /// Constructor
+        ThreadTraceBuffer(uint32 capacity, uint32 id)
+            : events(new TraceRecorder::Event[capacity]), capacityMask(capacity - 1), nbWrittenEvents(0),
+              threadId(id), name("Thread " + std::to_string(id)) {
+
+        }
+
+        /// Destructor
+        ~ThreadTraceBuffer() {
+            delete[] events;
+        }
+    };
+
+    /// Ring buffers of all the threads that have recorded events
+    struct TraceBuffers {
+
+        /// Mutex to register the buffers of new threads
+        std::mutex mutex;
+
+        /// Buffers of the threads
+        std::vector<ThreadTraceBuffer*> buffers;
+
+        /// Number of events of the ring buffer of each thread
+        uint32 capacity = DEFAULT_NB_EVENTS_PER_THREAD;
+
+        /// Destructor
+        ~TraceBuffers() {
+            for (ThreadTraceBuffer* buffer : buffers) {
+                delete buffer;
+            }
+        }
+    };
+
+    /// Return the ring buffers of all the threads
+    TraceBuffers& getTraceBuffers() {
+        static TraceBuffers traceBuffers;
+        return traceBuffers;
+    }
+
+    /// Ring buffer of the calling thread (created with its first event)
+    thread_local ThreadTraceBuffer* threadTraceBuffer = nullptr;
+
+    /// Time origin of the recorded events
+    const std::chrono::steady_clock::time_point traceEpoch = std::chrono::steady_clock::now();
+
+    /// Return the ring buffer of the calling thread
+    ThreadTraceBuffer* getThreadTraceBuffer() {
+
+        if (threadTraceBuffer == nullptr) {
+
+            TraceBuffers& traceBuffers = getTraceBuffers();
+            std::lock_guard<std::mutex> lock(traceBuffers.mutex);
+
+            const uint32 threadId = static_cast<uint32>(traceBuffers.buffers.size()) + 1;
+            threadTraceBuffer = new ThreadTraceBuffer(traceBuffers.capacity, threadId);
+            traceBuffers.buffers.push_back(threadTraceBuffer);
+        }
+
+        return threadTraceBuffer;
+    }
+
+    /// Return the events stored in a ring buffer sorted by starting time (a block of code
+    /// before the nested blocks that start at the same time)
+    std::vector<TraceRecorder::Event> getSortedEvents(const ThreadTraceBuffer& buffer) {
+
+        const uint64 nbWrittenEvents = buffer.nbWrittenEvents.load(std::memory_order_acquire);
+        const uint64 nbEvents = std::min(nbWrittenEvents, buffer.capacityMask + 1);
+
+        std::vector<TraceRecorder::Event> events;
+        events.reserve(nbEvents);
+        for (uint64 i = nbWrittenEvents - nbEvents; i < nbWrittenEvents; i++) {
+            events.push_back(buffer.events[i & buffer.capacityMask]);
+        }
+
+        std::sort(events.begin(), events.end(), [](const TraceRecorder::Event& a, const TraceRecorder::Event& b) {
+            return a.startTime != b.startTime ? a.startTime < b.startTime : a.duration > b.duration;
+        });
+
+        return events;
+    }
+
+    /// Write a string into a JSON file
+    void writeJsonString(std::ostream& stream, const std::string& string) {
+
+        stream << '"';
+        for (const char c : string) {
+            if (c == '"' || c == '\\') {
+                stream << '\\' << c;
+            }
+            else if (static_cast<unsigned char>(c) < 0x20) {
+                stream << ' ';
+            }
+            else {
+                stream << c;
+            }
+        }
+        stream << '"';
+    }
+
+    /// Write a time in nanoseconds as microseconds into a JSON file
+    void writeJsonMicroseconds(std::ostream& stream, uint64 nanoseconds) {
+        stream << (nanoseconds / 1000) << '.' << std::setw(3) << std::setfill('0') << (nanoseconds % 1000);
+    }
+
+    /// Wire types of the protobuf encoding
+    const uint32 PROTOBUF_VARINT = 0;
+    const uint32 PROTOBUF_LENGTH_DELIMITED = 2;
+
+    /// Field numbers of the Perfetto trace messages
+    const uint32 TRACE_PACKET = 1;
+    const uint32 PACKET_TIMESTAMP = 8;
+    const uint32 PACKET_TRUSTED_SEQUENCE_ID = 10;
+    const uint32 PACKET_TRACK_EVENT = 11;
+    const uint32 PACKET_SEQUENCE_FLAGS = 13;
+    const uint32 PACKET_TRACK_DESCRIPTOR = 60;
+    const uint32 TRACK_DESCRIPTOR_UUID = 1;
+    const uint32 TRACK_DESCRIPTOR_THREAD = 4;
+    const uint32 THREAD_DESCRIPTOR_PID = 1;
+    const uint32 THREAD_DESCRIPTOR_TID = 2;
+    const uint32 THREAD_DESCRIPTOR_NAME = 5;
+    const uint32 TRACK_EVENT_TYPE = 9;
+    const uint32 TRACK_EVENT_TRACK_UUID = 11;
+    const uint32 TRACK_EVENT_NAME = 23;
+
+    /// Values of the Perfetto enums
+    const uint64 TRACK_EVENT_SLICE_BEGIN = 1;
+    const uint64 TRACK_EVENT_SLICE_END = 2;
+    const uint64 SEQUENCE_INCREMENTAL_STATE_CLEARED = 1;
+
+    /// Id of the packets sequence and of the process in the Perfetto trace
+    const uint64 PERFETTO_SEQUENCE_ID = 1;
+    const uint64 PERFETTO_PROCESS_ID = 1;
+
+    /// Append a varint to a protobuf message
+    void writeProtobufVarint(std::string& message, uint64 value) {
+        while (value >= 0x80) {
+            message.push_back(static_cast<char>((value & 0x7F) | 0x80));
+            value >>= 7;
+        }
+        message.push_back(static_cast<char>(value));
+    }
+
+    /// Append a varint field to a protobuf message
+    void writeProtobufVarintField(std::string& message, uint32 field, uint64 value) {
+        writeProtobufVarint(message, (field << 3) | PROTOBUF_VARINT);
+        writeProtobufVarint(message, value);
+    }
+
+    /// Append a length-delimited field (string or nested message) to a protobuf message
+    void writeProtobufBytesField(std::string& message, uint32 field, const std::string& bytes) {
+        writeProtobufVarint(message, (field << 3) | PROTOBUF_LENGTH_DELIMITED);
+        writeProtobufVarint(message, bytes.size());
+        message.append(bytes);
+    }
+
+    /// Append a Perfetto packet with a slice begin or end track event to a trace
+    void writePerfettoSliceEvent(std::string& trace, uint64 timestamp, uint64 type, uint64 trackUuid, const char* name) {
+
+        std::string trackEvent;
+        writeProtobufVarintField(trackEvent, TRACK_EVENT_TYPE, type);
+        writeProtobufVarintField(trackEvent, TRACK_EVENT_TRACK_UUID, trackUuid);
+        if (name != nullptr) {
+            writeProtobufBytesField(trackEvent, TRACK_EVENT_NAME, name);
+        }
+
+        std::string packet;
+        writeProtobufVarintField(packet, PACKET_TIMESTAMP, timestamp);
+        writeProtobufVarintField(packet, PACKET_TRUSTED_SEQUENCE_ID, PERFETTO_SEQUENCE_ID);
+        writeProtobufBytesField(packet, PACKET_TRACK_EVENT, trackEvent);
+
+        writeProtobufBytesField(trace, TRACE_PACKET, packet);
+    }
+}
+
+// True if the events are recorded
+std::atomic<bool> TraceRecorder::mIsEnabled(false);
+
+// Enable or disable the recording of the events
+void TraceRecorder::setIsEnabled(bool isEnabled) {
+    mIsEnabled.store(isEnabled, std::memory_order_relaxed);
+}
+
+// Set the number of events of the ring buffer of each thread (rounded up to a power of two)
+// The ring buffers of the threads that have already recorded events are reallocated and
+// their events are removed. The threads write into their buffer without lock, therefore
+// this method must be called while the recording is disabled and no thread is running a
+// profiled scope.
+void TraceRecorder::setBufferCapacity(uint32 nbEventsPerThread) {
+
+    assert(!isEnabled());
+
+    uint32 capacity = 1;
+    while (capacity < nbEventsPerThread && capacity < (1u << 31)) {
+        capacity <<= 1;
+    }
+
+    TraceBuffers& traceBuffers = getTraceBuffers();
+    std::lock_guard<std::mutex> lock(traceBuffers.mutex);
+
+    traceBuffers.capacity = capacity;
+    for (ThreadTraceBuffer* buffer : traceBuffers.buffers) {
+        delete[] buffer->events;
+        buffer->events = new Event[capacity];
+        buffer->capacityMask = capacity - 1;
+        buffer->nbWrittenEvents.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Set the name of the calling thread in the exported traces
+void TraceRecorder::setThreadName(const std::string& name) {
+
+    ThreadTraceBuffer* buffer = getThreadTraceBuffer();
+
+    std::lock_guard<std::mutex> lock(getTraceBuffers().mutex);
+    buffer->name = name;
+}
+
+// Return the current time (in nanoseconds since the recording epoch)
+uint64 TraceRecorder::getTime() {
+    return static_cast<uint64>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - traceEpoch).count());
+}
+
+// Record an event into the ring buffer of the calling thread
+void TraceRecorder::recordEvent(const char* name, uint64 startTime, uint64 endTime) {
+
+    ThreadTraceBuffer* buffer = getThreadTraceBuffer();
+
+    // Only the calling thread writes into its buffer
+    const uint64 index = buffer->nbWrittenEvents.load(std::memory_order_relaxed);
+    Event& event = buffer->events[index & buffer->capacityMask];
+    event.name = name;
+    event.startTime = startTime;
+    event.duration = endTime - startTime;
+
+    buffer->nbWrittenEvents.store(index + 1, std::memory_order_release);
+}
+
+// Return the number of events currently stored in the ring buffers of all the threads
+uint64 TraceRecorder::getNbRecordedEvents() {
+
+    TraceBuffers& traceBuffers = getTraceBuffers();
+    std::lock_guard<std::mutex> lock(traceBuffers.mutex);
+
+    uint64 nbEvents = 0;
+    for (const ThreadTraceBuffer* buffer : traceBuffers.buffers) {
+        nbEvents += std::min(buffer->nbWrittenEvents.load(std::memory_order_acquire), buffer->capacityMask + 1);
+    }
+
+    return nbEvents;
+}
+
+// Remove all the recorded events
+void TraceRecorder::clear() {
+
+    TraceBuffers& traceBuffers = getTraceBuffers();
+    std::lock_guard<std::mutex> lock(traceBuffers.mutex);
+
+    for (ThreadTraceBuffer* buffer : traceBuffers.buffers) {
+        buffer->nbWrittenEvents.store(0, std::memory_order_relaxed);
+    }
+}
+
+// Export the recorded events into a Chrome trace JSON file
+// Each event is exported as a complete event ("X" phase) with times in microseconds
+bool TraceRecorder::exportChromeTrace(const std::string& filePath) {
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    TraceBuffers& traceBuffers = getTraceBuffers();
+    std::lock_guard<std::mutex> lock(traceBuffers.mutex);
+
+    file << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+
+    bool isFirstEvent = true;
+    for (const ThreadTraceBuffer* buffer : traceBuffers.buffers) {
+
+        // Name of the thread
+        file << (isFirstEvent ? "" : ",") << "\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << buffer->threadId
+             << ",\"args\":{\"name\":";
+        writeJsonString(file, buffer->name);
+        file << "}}";
+        isFirstEvent = false;
+
+        for (const Event& event : getSortedEvents(*buffer)) {
+
+            file << ",\n{\"name\":";
+            writeJsonString(file, event.name);
+            file << ",\"cat\":\"rp3d\",\"ph\":\"X\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+            writeJsonMicroseconds(file, event.startTime);
+            file << ",\"dur\":";
+            writeJsonMicroseconds(file, event.duration);
+            file << "}";
+        }
+    }
+
+    file << "\n]}\n";
+
+    return file.good();
+}
+
+// Export the recorded events into a Perfetto protobuf trace file
+// Each thread is exported as a thread track and each event as a pair of slice begin
+// and slice end track events (with timestamps in nanoseconds)
+bool TraceRecorder::exportPerfettoTrace(const std::string& filePath) {
+
+    std::ofstream file(filePath, std::ios::binary);
+    if (!file.is_open()) {
+        return false;
+    }
+
+    TraceBuffers& traceBuffers = getTraceBuffers();
+    std::lock_guard<std::mutex> lock(traceBuffers.mutex);
+
+    std::string trace;
+    bool isFirstPacket = true;
+
+    for (const ThreadTraceBuffer* buffer : traceBuffers.buffers) {
+
+        // Descriptor of the track of the thread
+        std::string threadDescriptor;
+        writeProtobufVarintField(threadDescriptor, THREAD_DESCRIPTOR_PID, PERFETTO_PROCESS_ID);
+        writeProtobufVarintField(threadDescriptor, THREAD_DESCRIPTOR_TID, buffer->threadId);
+        writeProtobufBytesField(threadDescriptor, THREAD_DESCRIPTOR_NAME, buffer->name);
+
+        std::string trackDescriptor;
+        writeProtobufVarintField(trackDescriptor, TRACK_DESCRIPTOR_UUID, buffer->threadId);
+        writeProtobufBytesField(trackDescriptor, TRACK_DESCRIPTOR_THREAD, threadDescriptor);
+
+        std::string packet;
+        writeProtobufVarintField(packet, PACKET_TRUSTED_SEQUENCE_ID, PERFETTO_SEQUENCE_ID);
+        if (isFirstPacket) {
+            writeProtobufVarintField(packet, PACKET_SEQUENCE_FLAGS, SEQUENCE_INCREMENTAL_STATE_CLEARED);
+            isFirstPacket = false;
+        }
+        writeProtobufBytesField(packet, PACKET_TRACK_DESCRIPTOR, trackDescriptor);
+        writeProtobufBytesField(trace, TRACE_PACKET, packet);
+
+        // Slices of the thread (the end of the enclosing slices are written before a slice
+        // that starts after them so that the events are in timestamp order)
+        std::vector<uint64> openSlicesEndTimes;
+        for (const Event& event : getSortedEvents(*buffer)) {
+
+            while (!openSlicesEndTimes.empty() && openSlicesEndTimes.back() <= event.startTime) {
+                writePerfettoSliceEvent(trace, openSlicesEndTimes.back(), TRACK_EVENT_SLICE_END, buffer->threadId, nullptr);
+                openSlicesEndTimes.pop_back();
+            }
+
+            writePerfettoSliceEvent(trace, event.startTime, TRACK_EVENT_SLICE_BEGIN, buffer->threadId, event.name);
+            openSlicesEndTimes.push_back(event.startTime + event.duration);
+        }
+        while (!openSlicesEndTimes.empty()) {
+            writePerfettoSliceEvent(trace, openSlicesEndTimes.back(), TRACK_EVENT_SLICE_END, buffer->threadId, nullptr);
+            openSlicesEndTimes.pop_back();
+        }
+    }
+
+    file.write(trace.data(), static_cast<std::streamsize>(trace.size()));
+
+    return file.good();
+}
@@ -168,6 +168,18 @@ class Body {
         /// Return true if debug lines should be computed for this body
         bool isDebugEnabled() const;
 
+        /// Set whether or not the contact and trigger events of this body are added to the contact event buffer
+        void setIsContactEventsEnabled(bool isEnabled);
+
+        /// Return true if the contact and trigger events of this body are added to the contact event buffer
+        bool isContactEventsEnabled() const;
+
+        /// Set whether or not the colliders of this body are grouped under a single node of the broad-phase
+        void setIsCompoundBroadPhase(bool isCompoundBroadPhase);
+
+        /// Return true if the colliders of this body are grouped under a single node of the broad-phase
+        bool isCompoundBroadPhase() const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -130,17 +130,23 @@ class Collider {
         /// Raycast method with feedback information
         bool raycast(const Ray& ray, RaycastInfo& raycastInfo);
 
+        /// Raycast method with feedback information (using a given allocator for temporary memory)
+        bool raycast(const Ray& ray, RaycastInfo& raycastInfo, MemoryAllocator& allocator);
+
+        /// Return true if a ray hits the collider (without computing the hit point and normal)
+        bool testRayHit(const Ray& ray, MemoryAllocator& allocator);
+
         /// Return the collision bits mask
-        unsigned short getCollideWithMaskBits() const;
+        uint64 getCollideWithMaskBits() const;
 
         /// Set the collision bits mask
-        void setCollideWithMaskBits(unsigned short collideWithMaskBits);
+        void setCollideWithMaskBits(uint64 collideWithMaskBits);
 
         /// Return the collision category bits
-        unsigned short getCollisionCategoryBits() const;
+        uint64 getCollisionCategoryBits() const;
 
         /// Set the collision category bits
-        void setCollisionCategoryBits(unsigned short collisionCategoryBits);
+        void setCollisionCategoryBits(uint64 collisionCategoryBits);
 
         /// Return the broad-phase id
         int getBroadPhaseId() const;
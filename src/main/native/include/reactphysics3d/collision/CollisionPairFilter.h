@@ -0,0 +1,67 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_COLLISION_PAIR_FILTER_H
+#define REACTPHYSICS3D_COLLISION_PAIR_FILTER_H
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class Collider;
+
+// Class CollisionPairFilter
+/**
+ * This class can be used to reject some pairs of colliders before the middle-phase and narrow-phase
+ * collision detection. You need to create a new class that inherits from this one, override the
+ * shouldCollide() method and register it to the physics world using the
+ * PhysicsWorld::setCollisionPairFilter() method. The filter is evaluated when the broad-phase
+ * reports a new pair of overlapping colliders that is accepted by the collision category bits and
+ * collide-with mask bits of the colliders. A rejected pair is not created and is evaluated again the
+ * next time the broad-phase reports it (for instance when one of its colliders moves or when the
+ * collide-with mask bits of a collider are set again). A pair that has already been created is not
+ * evaluated again until its colliders stop overlapping in the broad-phase.
+ */
+class CollisionPairFilter {
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Destructor
+        virtual ~CollisionPairFilter() = default;
+
+        /// Return true if the two colliders can collide with each other
+        /**
+         * @param collider1 Pointer to the first collider of the pair
+         * @param collider2 Pointer to the second collider of the pair
+         * @return False if the pair of colliders must not be tested for collision
+         */
+        virtual bool shouldCollide(const Collider* collider1, const Collider* collider2)=0;
+};
+
+}
+
+#endif
@@ -37,6 +37,8 @@ namespace reactphysics3d {
 // Declarations
 class DefaultAllocator;
 class PolygonVertexArray;
+class BinaryWriter;
+class BinaryReader;
 struct Message;
 
 // Class ConvexMesh
@@ -94,6 +96,12 @@ class ConvexMesh {
         /// Compute the volume of the mesh
         void computeVolume();
 
+        /// Write the cooked data of the mesh into a binary buffer
+        void serialize(BinaryWriter& writer) const;
+
+        /// Initialize the mesh from cooked data and returns errors if any
+        bool initFromCookedData(BinaryReader& reader, std::vector<Message>& errors);
+
     public:
 
         // -------------------- Methods -------------------- //
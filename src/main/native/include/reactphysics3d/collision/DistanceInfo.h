@@ -0,0 +1,109 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_DISTANCE_INFO_H
+#define REACTPHYSICS3D_DISTANCE_INFO_H
+
+// Libraries
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <reactphysics3d/mathematics/Transform.h>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class Body;
+class Collider;
+class ConvexShape;
+
+// Structure DistanceQuery
+/**
+ * This structure describes a convex shape (a sensor for instance) for a batched distance query
+ * (see PhysicsWorld::computeClosestColliders()).
+ */
+struct DistanceQuery {
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Convex shape of the query
+        const ConvexShape* shape;
+
+        /// Local-to-world transform of the shape
+        Transform transform;
+
+        /// Colliders farther than this distance are ignored
+        decimal maxDistance;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        DistanceQuery(const ConvexShape* shape, const Transform& transform, decimal maxDistance = DECIMAL_LARGEST)
+            : shape(shape), transform(transform), maxDistance(maxDistance) {
+
+        }
+};
+
+// Structure DistanceInfo
+/**
+ * This structure contains the result of a distance query between a convex shape and a collider.
+ */
+struct DistanceInfo {
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Closest point on the query shape in world-space coordinates
+        Vector3 worldPoint1;
+
+        /// Closest point on the collider in world-space coordinates
+        Vector3 worldPoint2;
+
+        /// Unit direction from the query shape to the collider in world-space coordinates.
+        /// It is zero if the shapes deeply overlap (the two points are then the position of the query shape).
+        Vector3 worldNormal;
+
+        /// Distance between the query shape and the collider (zero if they overlap)
+        decimal distance;
+
+        /// Pointer to the closest body (null if no collider has been found)
+        Body* body;
+
+        /// Pointer to the closest collider (null if no collider has been found)
+        Collider* collider;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        DistanceInfo() : distance(DECIMAL_LARGEST), body(nullptr), collider(nullptr) {
+
+        }
+};
+
+}
+
+#endif
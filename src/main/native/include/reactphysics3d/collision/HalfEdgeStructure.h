@@ -31,6 +31,10 @@
 
 namespace reactphysics3d {
 
+// Declarations
+class BinaryWriter;
+class BinaryReader;
+
 // Class HalfEdgeStructure
 /**
  * This class describes a polyhedron mesh made of faces and vertices.
@@ -128,6 +132,12 @@ class HalfEdgeStructure {
         /// Return a string representation of the half-edge structure
         std::string to_string() const;
 
+        /// Write the vertices, faces and half-edges into a binary buffer
+        void serialize(BinaryWriter& writer) const;
+
+        /// Replace the vertices, faces and half-edges by the ones read from a binary buffer
+        bool deserialize(BinaryReader& reader, uint32 nbVertexPoints);
+
 };
 
 // Add a vertex
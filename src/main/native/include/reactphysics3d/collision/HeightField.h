@@ -33,6 +33,8 @@
 #include <reactphysics3d/collision/shapes/TriangleShape.h>
 #include <reactphysics3d/collision/Collider.h>
 #include <reactphysics3d/collision/HalfEdgeStructure.h>
+#include <reactphysics3d/utils/MemoryMappedFile.h>
+#include <mutex>
 
 namespace reactphysics3d {
 
@@ -43,7 +45,9 @@ struct Message;
 /**
  * This class represents a static height field that can be used to represent
  * a terrain. The height field is made of a grid with rows and columns with a
- * height value at each grid point. Note that the height values are copied into the shape.
+ * height value at each grid point. By default, the height values are copied into the shape
+ * but they can also be referenced directly from the user memory, quantized into 16-bits
+ * integers or loaded lazily by tiles from a tiled height-field file (see HeightStorageType).
  * The height values can be of type integer, float or double.
  * Note that the HeightField will be re-centered based on its AABB. It means
  * that for instance, if the minimum height value is -200 and the maximum value is 400, the final
@@ -56,6 +60,25 @@ class HeightField {
         /// Data type for the height data of the height field
         enum class HeightDataType {HEIGHT_FLOAT_TYPE, HEIGHT_DOUBLE_TYPE, HEIGHT_INT_TYPE};
 
+        /// Storage of the height values of the height field
+        /// COPY : The height values are copied into the height field (this is the default).
+        /// REFERENCE : The height values are read directly from the user memory (no copy). The
+        ///             user data must stay valid until the height field is destroyed.
+        /// QUANTIZED : The height values are copied into the height field as 16-bits integers with a
+        ///             scale and an offset. This uses less memory but the heights are approximated.
+        /// TILED_FILE : The height values are stored as 16-bits integers in a tiled height-field file
+        ///              (see writeTiledFile()) that is memory-mapped. The tiles are decoded the first time
+        ///              they are queried and are evicted when the tile cache memory budget is exceeded.
+        ///              The tile cache is protected by a mutex so that the height field can be queried
+        ///              from several threads at the same time (see WorldQueryContext).
+        enum class HeightStorageType {COPY, REFERENCE, QUANTIZED, TILED_FILE};
+
+        /// Default number of grid points along each side of a tile of a tiled height-field file
+        static constexpr uint32 DEFAULT_TILE_SIZE = 64;
+
+        /// Default memory budget (in bytes) of the cache of decoded tiles of a tiled height field
+        static constexpr size_t DEFAULT_TILE_CACHE_MEMORY_BUDGET = 16 * 1024 * 1024;
+
     protected:
 
         // -------------------- Attributes -------------------- //
@@ -90,9 +113,66 @@ class HeightField {
         /// Data type of the height values
         HeightDataType mHeightDataType;
 
-        /// Array of data with all the height values of the height field
+        /// Storage of the height values
+        HeightStorageType mHeightStorageType;
+
+        /// Array of data with all the height values of the height field (COPY storage)
         Array<decimal> mHeightFieldData;
 
+        /// Pointer to the user height values (REFERENCE storage)
+        const void* mReferencedHeightData;
+
+        /// Array with all the quantized height values of the height field (QUANTIZED storage)
+        Array<int16> mQuantizedHeightData;
+
+        /// Scale to convert a quantized height value into a height value
+        decimal mQuantizationScale;
+
+        /// Offset to convert a quantized height value into a height value
+        decimal mQuantizationOffset;
+
+        /// Memory-mapped tiled height-field file (TILED_FILE storage)
+        MemoryMappedFile mTiledFile;
+
+        /// Pointer to the quantized height values of the first tile in the mapped file
+        const int16* mFileTilesData;
+
+        /// True if the tiled height-field file has been written with the other endianness
+        bool mIsFileByteSwapped;
+
+        /// Number of grid points along each side of a tile
+        uint32 mTileSize;
+
+        /// Number of tiles along the local x direction
+        uint32 mNbTilesX;
+
+        /// Number of tiles along the local z direction
+        uint32 mNbTilesZ;
+
+        /// Maximum number of decoded tiles in the tile cache
+        uint32 mNbMaxCachedTiles;
+
+        /// Height values of the decoded tiles (one block of mTileSize * mTileSize values per cache slot)
+        mutable Array<decimal> mTileCacheHeights;
+
+        /// For each tile, the index of the cache slot that contains it (-1 if the tile is not decoded)
+        mutable Array<int32> mTileToCacheSlot;
+
+        /// For each cache slot, the index of the tile it contains
+        mutable Array<uint32> mCacheSlotToTile;
+
+        /// For each cache slot, the value of the use counter when the slot was used for the last time
+        mutable Array<uint64> mCacheSlotLastUse;
+
+        /// Counter incremented each time a tile is accessed (used to evict the least recently used tile)
+        mutable uint64 mTileUseCounter;
+
+        /// Number of tiles that have been decoded since the creation of the height field
+        mutable uint64 mNbTileLoads;
+
+        /// Mutex to protect the tile cache when the height field is queried from several threads
+        mutable std::mutex mTileCacheMutex;
+
         /// Local bounds of the height field
         AABB mBounds;
 
@@ -111,12 +191,40 @@ class HeightField {
         /// Constructor
         HeightField(MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure);
 
+        /// Initialize the height-field with height values given by the user
         bool init(int nbGridColumns, int nbGridRows, const void* heightFieldData,
-                  HeightDataType dataType, std::vector<Message>& messages, decimal integerHeightScale = 1.0f);
+                  HeightDataType dataType, std::vector<Message>& messages, decimal integerHeightScale = 1.0f,
+                  HeightStorageType storageType = HeightStorageType::COPY);
+
+        /// Initialize the height-field from a tiled height-field file
+        bool initFromTiledFile(const std::string& filePath, std::vector<Message>& messages,
+                               size_t tileCacheMemoryBudget);
+
+        /// Compute the bounds of the height field (once the min/max height values are known)
+        void computeBounds();
 
         /// Copy the data from the user into the height-field array
         void copyData(const void* heightFieldData);
 
+        /// Compute the min/max height values of the height values given by the user
+        void computeMinMaxHeights(const void* heightFieldData);
+
+        /// Quantize the data from the user into the 16-bits quantized height-field array
+        void quantizeData(const void* heightFieldData);
+
+        /// Read a height value in the data of the user
+        static decimal readHeightValue(const void* heightFieldData, uint64 index, HeightDataType dataType,
+                                       decimal integerHeightScale);
+
+        /// Compute the quantization scale and offset that maps the [min, max] range into 16-bits integers
+        static void computeQuantization(decimal minHeight, decimal maxHeight, decimal& outScale, decimal& outOffset);
+
+        /// Return the height value at a given (x,y) point for the storages other than COPY
+        decimal getStoredHeightAt(uint32 x, uint32 y) const;
+
+        /// Return the index of the cache slot with the decoded heights of a given tile (decode it if necessary)
+        uint32 getCachedTileSlot(uint32 tileIndex) const;
+
         /// Raycast a single triangle of the height-field
         bool raycastTriangle(const Ray& ray, const Vector3& p1, const Vector3& p2, const Vector3& p3, uint32 shapeId,
                              Collider* collider, RaycastInfo& raycastInfo, decimal& smallestHitFraction,
@@ -172,6 +280,21 @@ class HeightField {
         /// Return the type of height value in the height-field
         HeightDataType getHeightDataType() const;
 
+        /// Return the storage of the height values in the height-field
+        HeightStorageType getHeightStorageType() const;
+
+        /// Return the number of tiles that have been decoded (TILED_FILE storage only)
+        uint64 getNbTileLoads() const;
+
+        /// Return the current number of decoded tiles in the tile cache (TILED_FILE storage only)
+        uint32 getNbCachedTiles() const;
+
+        /// Write height values into a tiled height-field file that can be used to create a TILED_FILE height field
+        static bool writeTiledFile(const std::string& filePath, int nbGridColumns, int nbGridRows,
+                                   const void* heightFieldData, HeightDataType dataType,
+                                   std::vector<Message>& messages, decimal integerHeightScale = 1.0f,
+                                   uint32 tileSize = DEFAULT_TILE_SIZE);
+
         /// Return the minimum bounds of the height-field in the x,y,z direction
         const AABB& getBounds() const;
 
@@ -246,11 +369,33 @@ RP3D_FORCE_INLINE HeightField::HeightDataType HeightField::getHeightDataType() c
     return mHeightDataType;
 }
 
+// Return the storage of the height values in the height-field
+RP3D_FORCE_INLINE HeightField::HeightStorageType HeightField::getHeightStorageType() const {
+    return mHeightStorageType;
+}
+
+// Return the number of tiles that have been decoded (TILED_FILE storage only)
+RP3D_FORCE_INLINE uint64 HeightField::getNbTileLoads() const {
+    std::lock_guard<std::mutex> lock(mTileCacheMutex);
+    return mNbTileLoads;
+}
+
+// Return the current number of decoded tiles in the tile cache (TILED_FILE storage only)
+RP3D_FORCE_INLINE uint32 HeightField::getNbCachedTiles() const {
+    std::lock_guard<std::mutex> lock(mTileCacheMutex);
+    return static_cast<uint32>(mCacheSlotToTile.size());
+}
+
 // Return the height value of a given (x,y) point in the height-field
 RP3D_FORCE_INLINE decimal HeightField::getHeightAt(uint32 x, uint32 y) const {
     assert(x < mNbColumns);
     assert(y < mNbRows);
-    return mHeightFieldData[y * mNbColumns + x];
+
+    if (mHeightStorageType == HeightStorageType::COPY) {
+        return mHeightFieldData[y * mNbColumns + x];
+    }
+
+    return getStoredHeightAt(x, y);
 }
 
 // Compute the shape Id for a given triangle
@@ -173,6 +173,7 @@ class OverlapCallback {
                 // -------------------- Friendship -------------------- //
 
                 friend class CollisionDetectionSystem;
+                friend class WorldQueryContext;
         };
 
         /// Destructor
@@ -0,0 +1,104 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SHAPE_CAST_INFO_H
+#define REACTPHYSICS3D_SHAPE_CAST_INFO_H
+
+// Libraries
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <reactphysics3d/mathematics/Transform.h>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class Body;
+class Collider;
+
+// Structure ShapeCastQuery
+/**
+ * This structure describes the motion of a convex shape for a batched shape cast query
+ * (see PhysicsWorld::shapeCast()). The shape moves along a translation without rotating.
+ */
+struct ShapeCastQuery {
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Local-to-world transform of the shape at the start of the motion
+        Transform transform;
+
+        /// Translation of the shape in world-space
+        Vector3 translation;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ShapeCastQuery(const Transform& transform, const Vector3& translation)
+            : transform(transform), translation(translation) {
+
+        }
+};
+
+// Structure ShapeCastInfo
+/**
+ * This structure contains the information about the first hit of a shape cast query.
+ */
+struct ShapeCastInfo {
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Contact point on the hit collider in world-space coordinates
+        Vector3 worldPoint;
+
+        /// Surface normal of the hit collider at the contact point in world-space coordinates.
+        /// It is zero if the shape already deeply overlaps the collider at the start of the motion.
+        Vector3 worldNormal;
+
+        /// Fraction of the translation where the shape touches the hit collider.
+        /// The shape can move to "transform.getPosition() + hitFraction * translation" without
+        /// overlapping the collider. It is 1 if nothing has been hit.
+        decimal hitFraction;
+
+        /// Pointer to the hit body (null if nothing has been hit)
+        Body* body;
+
+        /// Pointer to the hit collider (null if nothing has been hit)
+        Collider* collider;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ShapeCastInfo() : hitFraction(decimal(1.0)), body(nullptr), collider(nullptr) {
+
+        }
+};
+
+}
+
+#endif
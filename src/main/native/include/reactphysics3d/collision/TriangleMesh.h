@@ -32,21 +32,38 @@
 #include <reactphysics3d/memory/MemoryAllocator.h>
 #include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
 #include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/collision/TriangleVertexArray.h>
 
 namespace reactphysics3d {
 
 // Declarations
-class TriangleVertexArray;
 struct Message;
+class BinaryWriter;
+class BinaryReader;
 
 // Class TriangleMesh
 /**
  * This class represents a mesh made of triangles.
  * A single TriangleMesh object can be used to create one or many ConcaveMeshShape (with
  * different scaling for instance).
+ * By default, the vertices and triangles are copied into the mesh. They can also be referenced
+ * directly from the user buffers of the TriangleVertexArray (see StorageType).
  */
 class TriangleMesh {
 
+    public:
+
+        /// Storage of the vertices and triangles of the mesh
+        /// COPY : The vertices, triangles and normals are copied into the mesh. The invalid triangles
+        ///        and the unused vertices are removed (this is the default).
+        /// REFERENCE : The vertices, the triangles indices and the normals (if provided) are read directly
+        ///             from the user buffers described by the TriangleVertexArray. Only the BVH and the
+        ///             vertices normals (if not provided) are computed. The buffers must remain valid and
+        ///             unchanged until the mesh is destroyed but the TriangleVertexArray object itself can
+        ///             be destroyed. The invalid triangles are kept in the buffers but are not inserted into
+        ///             the BVH and therefore never collide.
+        enum class StorageType {COPY, REFERENCE};
+
     protected:
 
         /// Reference to the memory allocator
@@ -67,14 +84,44 @@ class TriangleMesh {
         /// Epsilon value for this mesh
         decimal mEpsilon;
 
-        /// Constructor
-        TriangleMesh(reactphysics3d::MemoryAllocator& allocator);
+        /// Storage of the vertices and triangles of the mesh
+        StorageType mStorageType;
+
+        /// Number of vertices in the user buffers (REFERENCE storage)
+        uint32 mNbReferencedVertices;
+
+        /// Number of triangles in the user buffers (REFERENCE storage)
+        uint32 mNbReferencedTriangles;
+
+        /// Pointer to the first vertex in the user buffers (REFERENCE storage)
+        const uchar* mReferencedVerticesStart;
+
+        /// Stride (number of bytes) between two vertices in the user buffers (REFERENCE storage)
+        uint32 mReferencedVerticesStride;
+
+        /// Data type of the vertices in the user buffers (REFERENCE storage)
+        TriangleVertexArray::VertexDataType mReferencedVertexDataType;
+
+        /// Pointer to the first vertex normal in the user buffers (REFERENCE storage, null if the normals are computed)
+        const uchar* mReferencedNormalsStart;
+
+        /// Stride (number of bytes) between two vertex normals in the user buffers (REFERENCE storage)
+        uint32 mReferencedNormalsStride;
 
-        /// Copy the vertices into the mesh
-        bool copyVertices(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages);
+        /// Data type of the vertex normals in the user buffers (REFERENCE storage)
+        TriangleVertexArray::NormalDataType mReferencedNormalDataType;
 
-        /// Copy or compute the vertices normals
-        void computeVerticesNormals();
+        /// Pointer to the first vertex index in the user buffers (REFERENCE storage)
+        const uchar* mReferencedIndicesStart;
+
+        /// Stride (number of bytes) between the indices of two triangles in the user buffers (REFERENCE storage)
+        uint32 mReferencedIndicesStride;
+
+        /// Data type of the indices in the user buffers (REFERENCE storage)
+        TriangleVertexArray::IndexDataType mReferencedIndexDataType;
+
+        /// Constructor
+        TriangleMesh(reactphysics3d::MemoryAllocator& allocator);
 
         /// Compute the epsilon value for this mesh
         void computeEpsilon(const TriangleVertexArray& triangleVertexArray);
@@ -82,17 +129,48 @@ class TriangleMesh {
         /// Copy the triangles into the mesh
         bool copyData(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& errors);
 
-        /// Insert all the triangles into the dynamic AABB tree
-        void initBVHTree();
+        /// Reference the user buffers of the triangles and validate the triangles
+        bool referenceData(const TriangleVertexArray& triangleVertexArray, Array<bool>& areTrianglesDiscarded,
+                           std::vector<Message>& messages);
+
+        /// Check that a triangle does not have an almost zero area or an almost zero length edge
+        bool checkTriangleArea(uint32 triangleIndex, const Vector3& v1, const Vector3& v2, const Vector3& v3,
+                               std::vector<Message>& messages) const;
+
+        /// Compute the vertices normals (using only the triangles that are not discarded)
+        void computeVerticesNormals(const Array<bool>& areTrianglesDiscarded);
+
+        /// Insert all the triangles that are not discarded into the dynamic AABB tree
+        void initBVHTree(const Array<bool>& areTrianglesDiscarded);
 
         /// Initialize the mesh using a TriangleVertexArray
-        bool init(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages);
+        bool init(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages,
+                  StorageType storageType = StorageType::COPY);
+
+        /// Write the cooked data of the mesh into a binary buffer
+        void serialize(BinaryWriter& writer) const;
+
+        /// Initialize the mesh from cooked data
+        bool initFromCookedData(BinaryReader& reader, std::vector<Message>& messages);
+
+        /// Return a vertex from the user buffers (REFERENCE storage)
+        Vector3 getReferencedVertex(uint32 vertexIndex) const;
+
+        /// Return a vertex normal from the user buffers (REFERENCE storage)
+        Vector3 getReferencedVertexNormal(uint32 vertexIndex) const;
+
+        /// Return the three vertex indices of a triangle from the user buffers (REFERENCE storage)
+        void getReferencedTriangleVerticesIndices(uint32 triangleIndex, uint32& outV1Index, uint32& outV2Index,
+                                                  uint32& outV3Index) const;
 
         /// Report all shapes overlapping with the AABB given in parameter.
         void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes);
 
-        /// Remove the ununsed vertices (because they are not used in any triangles or are part of discarded triangles)
-        void removeUnusedVertices(Array<bool>& areUsedVertices);
+        /// Copy the used vertices into the mesh, weld the duplicated vertices and remap the triangles
+        void weldVertices(const TriangleVertexArray& triangleVertexArray, const Array<bool>& areUserVerticesUsed);
+
+        /// Remove the triangles that have become degenerate when their vertices have been welded
+        void removeWeldedDegenerateTriangles(const Array<uint32>& userTrianglesIndices, std::vector<Message>& messages);
 
         /// Return the integer data of leaf node of the dynamic AABB tree
         int32 getDynamicAABBTreeNodeDataInt(int32 nodeID) const;
@@ -123,10 +201,13 @@ class TriangleMesh {
                                         Vector3& outN2, Vector3& outN3) const;
 
         /// Return the coordinates of a given vertex
-        const Vector3& getVertex(uint32 vertexIndex) const;
+        Vector3 getVertex(uint32 vertexIndex) const;
 
         /// Return the normal of a given vertex
-        const Vector3& getVertexNormal(uint32 vertexIndex) const;
+        Vector3 getVertexNormal(uint32 vertexIndex) const;
+
+        /// Return the storage of the vertices and triangles of the mesh
+        StorageType getStorageType() const;
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -143,18 +224,28 @@ class TriangleMesh {
 
 // Return the number of vertices in the mesh
 RP3D_FORCE_INLINE uint32 TriangleMesh::getNbVertices() const {
-    return mVertices.size();
+    return mStorageType == StorageType::COPY ? static_cast<uint32>(mVertices.size()) : mNbReferencedVertices;
 }
 
 // Return the number of triangles faces of the mesh
 RP3D_FORCE_INLINE uint32 TriangleMesh::getNbTriangles() const {
-    return mTriangles.size() / 3;
+    return mStorageType == StorageType::COPY ? static_cast<uint32>(mTriangles.size() / 3) : mNbReferencedTriangles;
+}
+
+// Return the storage of the vertices and triangles of the mesh
+RP3D_FORCE_INLINE TriangleMesh::StorageType TriangleMesh::getStorageType() const {
+    return mStorageType;
 }
 
 // Return the three vertex indices of a given triangle face
 RP3D_FORCE_INLINE void TriangleMesh::getTriangleVerticesIndices(uint32 triangleIndex, uint32& outV1Index,
                                                                 uint32& outV2Index, uint32& outV3Index) const {
-   assert(triangleIndex < mTriangles.size() / 3);
+   assert(triangleIndex < getNbTriangles());
+
+   if (mStorageType == StorageType::REFERENCE) {
+       getReferencedTriangleVerticesIndices(triangleIndex, outV1Index, outV2Index, outV3Index);
+       return;
+   }
 
    outV1Index = mTriangles[triangleIndex * 3];
    outV2Index = mTriangles[triangleIndex * 3 + 1];
@@ -164,33 +255,98 @@ RP3D_FORCE_INLINE void TriangleMesh::getTriangleVerticesIndices(uint32 triangleI
 // Return the coordinates of the three vertices of a given triangle face
 RP3D_FORCE_INLINE void TriangleMesh::getTriangleVertices(uint32 triangleIndex, Vector3& outV1, Vector3& outV2,
                                                          Vector3& outV3) const {
-    assert(triangleIndex < mTriangles.size() / 3);
+    assert(triangleIndex < getNbTriangles());
 
-    outV1 = mVertices[mTriangles[triangleIndex * 3]];
-    outV2 = mVertices[mTriangles[triangleIndex * 3 + 1]];
-    outV3 = mVertices[mTriangles[triangleIndex * 3 + 2]];
+    uint32 v1Index, v2Index, v3Index;
+    getTriangleVerticesIndices(triangleIndex, v1Index, v2Index, v3Index);
+
+    outV1 = getVertex(v1Index);
+    outV2 = getVertex(v2Index);
+    outV3 = getVertex(v3Index);
 }
 
 // Return the normals of the three vertices of a given triangle face
 RP3D_FORCE_INLINE void TriangleMesh::getTriangleVerticesNormals(uint32 triangleIndex, Vector3& outN1,
                                                                 Vector3& outN2, Vector3& outN3) const {
-    assert(triangleIndex < mTriangles.size() / 3);
+    assert(triangleIndex < getNbTriangles());
+
+    uint32 v1Index, v2Index, v3Index;
+    getTriangleVerticesIndices(triangleIndex, v1Index, v2Index, v3Index);
 
-    outN1 = mVerticesNormals[mTriangles[triangleIndex * 3]];
-    outN2 = mVerticesNormals[mTriangles[triangleIndex * 3 + 1]];
-    outN3 = mVerticesNormals[mTriangles[triangleIndex * 3 + 2]];
+    outN1 = getVertexNormal(v1Index);
+    outN2 = getVertexNormal(v2Index);
+    outN3 = getVertexNormal(v3Index);
 }
 
 // Return the coordinates of a given vertex
-RP3D_FORCE_INLINE const Vector3& TriangleMesh::getVertex(uint32 vertexIndex) const {
-    assert(vertexIndex < mVertices.size());
+RP3D_FORCE_INLINE Vector3 TriangleMesh::getVertex(uint32 vertexIndex) const {
+    assert(vertexIndex < getNbVertices());
+
+    if (mStorageType == StorageType::REFERENCE) {
+        return getReferencedVertex(vertexIndex);
+    }
+
     return mVertices[vertexIndex];
 }
 
 // Return the normal of a given vertex
-RP3D_FORCE_INLINE const Vector3& TriangleMesh::getVertexNormal(uint32 vertexIndex) const {
-    assert(vertexIndex < mVertices.size());
-   return mVerticesNormals[vertexIndex];
+RP3D_FORCE_INLINE Vector3 TriangleMesh::getVertexNormal(uint32 vertexIndex) const {
+    assert(vertexIndex < getNbVertices());
+
+    // If the normals are referenced from the user buffers
+    if (mReferencedNormalsStart != nullptr) {
+        return getReferencedVertexNormal(vertexIndex);
+    }
+
+    return mVerticesNormals[vertexIndex];
+}
+
+// Return a vertex from the user buffers (REFERENCE storage)
+RP3D_FORCE_INLINE Vector3 TriangleMesh::getReferencedVertex(uint32 vertexIndex) const {
+
+    const void* vertexPointer = static_cast<const void*>(mReferencedVerticesStart + vertexIndex * mReferencedVerticesStride);
+
+    if (mReferencedVertexDataType == TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE) {
+        const float* vertex = static_cast<const float*>(vertexPointer);
+        return Vector3(decimal(vertex[0]), decimal(vertex[1]), decimal(vertex[2]));
+    }
+
+    const double* vertex = static_cast<const double*>(vertexPointer);
+    return Vector3(decimal(vertex[0]), decimal(vertex[1]), decimal(vertex[2]));
+}
+
+// Return a vertex normal from the user buffers (REFERENCE storage)
+RP3D_FORCE_INLINE Vector3 TriangleMesh::getReferencedVertexNormal(uint32 vertexIndex) const {
+
+    const void* normalPointer = static_cast<const void*>(mReferencedNormalsStart + vertexIndex * mReferencedNormalsStride);
+
+    if (mReferencedNormalDataType == TriangleVertexArray::NormalDataType::NORMAL_FLOAT_TYPE) {
+        const float* normal = static_cast<const float*>(normalPointer);
+        return Vector3(decimal(normal[0]), decimal(normal[1]), decimal(normal[2]));
+    }
+
+    const double* normal = static_cast<const double*>(normalPointer);
+    return Vector3(decimal(normal[0]), decimal(normal[1]), decimal(normal[2]));
+}
+
+// Return the three vertex indices of a triangle from the user buffers (REFERENCE storage)
+RP3D_FORCE_INLINE void TriangleMesh::getReferencedTriangleVerticesIndices(uint32 triangleIndex, uint32& outV1Index,
+                                                                          uint32& outV2Index, uint32& outV3Index) const {
+
+    const void* indicesPointer = static_cast<const void*>(mReferencedIndicesStart + triangleIndex * mReferencedIndicesStride);
+
+    if (mReferencedIndexDataType == TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE) {
+        const uint32* indices = static_cast<const uint32*>(indicesPointer);
+        outV1Index = indices[0];
+        outV2Index = indices[1];
+        outV3Index = indices[2];
+    }
+    else {
+        const uint16* indices = static_cast<const uint16*>(indicesPointer);
+        outV1Index = indices[0];
+        outV2Index = indices[1];
+        outV3Index = indices[2];
+    }
 }
 
 #ifdef IS_RP3D_PROFILING_ENABLED
@@ -0,0 +1,278 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_BROAD_PHASE_BACKEND_H
+#define REACTPHYSICS3D_BROAD_PHASE_BACKEND_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/collision/shapes/AABB.h>
+#include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/containers/Pair.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+class Collider;
+class MemoryAllocator;
+class Profiler;
+class BinaryWriter;
+class BinaryReader;
+
+/// Enumeration for the data structure used by the broad-phase collision detection
+/// DYNAMIC_AABB_TREE : Dynamic AABB tree. This is the best choice for most of the worlds.
+/// SWEEP_AND_PRUNE : Array of AABBs sorted along the axis where the colliders are the most spread out. The
+///                   array is incrementally sorted when the colliders move. This is usually the fastest method
+///                   for many colliders of similar size that move a little at each step.
+/// UNIFORM_GRID : Grid of cells of a fixed size (hashed so that the world is not bounded). This is usually the
+///                fastest method for many colliders of similar size (slightly smaller than a cell) that move fast.
+///                The colliders that cover too many cells are tested against all the other colliders.
+enum class BroadPhaseMethod {DYNAMIC_AABB_TREE, SWEEP_AND_PRUNE, UNIFORM_GRID};
+
+// Class BroadPhaseBackend
+/**
+ * This abstract class is the base class of the data structures that can be used instead of the
+ * dynamic AABB tree in the broad-phase collision detection. It stores the fat AABB and the collider
+ * of each object (proxy) in an array indexed by the proxy id. The derived classes only have to keep
+ * their acceleration structure in sync with the proxies and use it to compute the overlapping pairs.
+ * The other queries (raycast, volume and distance queries) are less frequent and are computed by
+ * testing all the proxies.
+ */
+class BroadPhaseBackend {
+
+    protected:
+
+        // -------------------- Structures -------------------- //
+
+        /// Object stored in the broad-phase
+        struct Proxy {
+
+            /// Fat AABB of the object
+            AABB aabb;
+
+            /// Collider of the object (null if the proxy is free)
+            Collider* collider;
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Inflate percentage of the AABBs (used to compute the fat AABBs)
+        decimal mFatAABBInflatePercentage;
+
+        /// Proxies of the objects (indexed by proxy id)
+        Array<Proxy> mProxies;
+
+        /// Ids of the free proxies
+        Array<int32> mFreeProxies;
+
+        /// Number of proxies in use
+        uint32 mNbProxies;
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Pointer to the profiler
+		Profiler* mProfiler;
+
+#endif
+
+        // -------------------- Methods -------------------- //
+
+        /// Add a new proxy into the acceleration structure
+        virtual void insertProxy(int32 proxyId)=0;
+
+        /// Remove a proxy from the acceleration structure
+        virtual void removeProxy(int32 proxyId)=0;
+
+        /// Update the acceleration structure after the fat AABB of a proxy has changed
+        virtual void moveProxy(int32 proxyId)=0;
+
+        /// Write the acceleration structure into a world snapshot
+        virtual void takeStructureSnapshot(BinaryWriter& writer) const=0;
+
+        /// Restore the acceleration structure from a world snapshot
+        virtual bool restoreStructureSnapshot(BinaryReader& reader)=0;
+
+        /// Return true if a proxy id is the id of a proxy in use
+        bool isProxyUsed(int32 proxyId) const;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BroadPhaseBackend(MemoryAllocator& allocator, decimal fatAABBInflatePercentage);
+
+        /// Destructor
+        virtual ~BroadPhaseBackend() = default;
+
+        /// Deleted copy-constructor
+        BroadPhaseBackend(const BroadPhaseBackend& backend) = delete;
+
+        /// Deleted assignment operator
+        BroadPhaseBackend& operator=(const BroadPhaseBackend& backend) = delete;
+
+        /// Return the broad-phase method implemented by the backend
+        virtual BroadPhaseMethod getMethod() const=0;
+
+        /// Add an object into the broad-phase and return its proxy id
+        int32 addObject(const AABB& aabb, Collider* collider);
+
+        /// Remove an object from the broad-phase
+        void removeObject(int32 proxyId);
+
+        /// Update the broad-phase after an object has moved (return true if the fat AABB has changed)
+        bool updateObject(int32 proxyId, const AABB& newAABB, bool forceUpdate = false);
+
+        /// Update the broad-phase after an object has moved using a given fat AABB
+        bool updateObject(int32 proxyId, const AABB& newAABB, const AABB& newFatAABB, bool forceUpdate = false);
+
+        /// Called once all the objects that have moved during a step have been updated
+        virtual void update();
+
+        /// Return the fat AABB of a proxy
+        const AABB& getFatAABB(int32 proxyId) const;
+
+        /// Return the collider of a proxy
+        Collider* getCollider(int32 proxyId) const;
+
+        /// Return true if the broad-phase does not contain any object
+        bool isEmpty() const;
+
+        /// Report the pairs of proxies whose fat AABBs overlap with the fat AABB of some proxies to test
+        virtual void reportAllShapesOverlappingWithShapes(const Array<int32>& proxiesToTest,
+                                                          Array<Pair<int32, int32>>& outOverlappingProxies)=0;
+
+        /// Report the proxies whose fat AABB overlaps with a given AABB
+        virtual void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& outOverlappingProxies) const=0;
+
+        /// Call a function with each proxy whose fat AABB is accepted by a volume test
+        template<typename VolumeTest, typename ProxyFunction>
+        void reportAllShapesOverlappingWithVolume(const VolumeTest& volumeTest, ProxyFunction& proxyFunction) const;
+
+        /// Ray casting method that reports the proxies hit by the ray to a function
+        template<typename ProxyFunction>
+        void raycastWithLeafFunction(const Ray& ray, ProxyFunction& proxyFunction) const;
+
+        /// Report the proxies whose fat AABB is within a shrinking distance of a given AABB
+        void reportShapesWithinDistance(const AABB& aabb, decimal maxDistance, DynamicAABBTreeDistanceCallback& callback) const;
+
+        /// Write the proxies and the acceleration structure into a world snapshot
+        void takeSnapshot(BinaryWriter& writer) const;
+
+        /// Restore the proxies and the acceleration structure from a world snapshot
+        bool restoreSnapshot(BinaryReader& reader);
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+		/// Set the profiler
+		void setProfiler(Profiler* profiler);
+
+#endif
+
+};
+
+// Return true if a proxy id is the id of a proxy in use
+RP3D_FORCE_INLINE bool BroadPhaseBackend::isProxyUsed(int32 proxyId) const {
+    return proxyId >= 0 && proxyId < static_cast<int32>(mProxies.size()) && mProxies[proxyId].collider != nullptr;
+}
+
+// Return the fat AABB of a proxy
+RP3D_FORCE_INLINE const AABB& BroadPhaseBackend::getFatAABB(int32 proxyId) const {
+    assert(isProxyUsed(proxyId));
+    return mProxies[proxyId].aabb;
+}
+
+// Return the collider of a proxy
+RP3D_FORCE_INLINE Collider* BroadPhaseBackend::getCollider(int32 proxyId) const {
+    assert(isProxyUsed(proxyId));
+    return mProxies[proxyId].collider;
+}
+
+// Return true if the broad-phase does not contain any object
+RP3D_FORCE_INLINE bool BroadPhaseBackend::isEmpty() const {
+    return mNbProxies == 0;
+}
+
+// Call a function with each proxy whose fat AABB is accepted by a volume test
+/// The function is called as proxyFunction(proxyId) like the leaf function of
+/// DynamicAABBTree::reportAllShapesOverlappingWithVolume().
+template<typename VolumeTest, typename ProxyFunction>
+void BroadPhaseBackend::reportAllShapesOverlappingWithVolume(const VolumeTest& volumeTest, ProxyFunction& proxyFunction) const {
+
+    const int32 nbProxies = static_cast<int32>(mProxies.size());
+    for (int32 i=0; i < nbProxies; i++) {
+        if (mProxies[i].collider != nullptr && volumeTest(mProxies[i].aabb)) {
+            proxyFunction(i);
+        }
+    }
+}
+
+// Ray casting method that reports the proxies hit by the ray to a function
+/// The function is called as proxyFunction(proxyId, ray) and follows the same protocol as
+/// DynamicAABBTree::raycastWithLeafFunction(): a returned fraction of zero stops the raycasting,
+/// a positive fraction clips the ray and a negative one ignores the proxy.
+template<typename ProxyFunction>
+void BroadPhaseBackend::raycastWithLeafFunction(const Ray& ray, ProxyFunction& proxyFunction) const {
+
+    decimal maxFraction = ray.maxFraction;
+
+    // Compute the inverse ray direction
+    const Vector3 rayDirection = ray.point2 - ray.point1;
+    const Vector3 rayDirectionInverse(decimal(1.0) / rayDirection.x, decimal(1.0) / rayDirection.y, decimal(1.0) / rayDirection.z);
+
+    const int32 nbProxies = static_cast<int32>(mProxies.size());
+    for (int32 i=0; i < nbProxies; i++) {
+
+        if (mProxies[i].collider == nullptr || !mProxies[i].aabb.testRayIntersect(ray.point1, rayDirectionInverse, maxFraction)) continue;
+
+        const decimal hitFraction = proxyFunction(i, Ray(ray.point1, ray.point2, maxFraction));
+
+        // A fraction of zero stops the raycasting
+        if (hitFraction == decimal(0.0)) return;
+
+        // A positive fraction clips the ray
+        if (hitFraction > decimal(0.0) && hitFraction < maxFraction) {
+            maxFraction = hitFraction;
+        }
+    }
+}
+
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+// Set the profiler
+RP3D_FORCE_INLINE void BroadPhaseBackend::setProfiler(Profiler* profiler) {
+	mProfiler = profiler;
+}
+
+#endif
+
+}
+
+#endif
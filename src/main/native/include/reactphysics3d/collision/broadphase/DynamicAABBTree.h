@@ -29,7 +29,9 @@
 // Libraries
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/collision/shapes/AABB.h>
+#include <reactphysics3d/containers/Array.h>
 #include <reactphysics3d/containers/Set.h>
+#include <reactphysics3d/containers/Stack.h>
 
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
@@ -43,7 +45,16 @@ struct RaycastTest;
 class AABB;
 class Profiler;
 class MemoryAllocator;
+class BinaryWriter;
+class BinaryReader;
 
+/// Enumeration for the method used to update a leaf of the dynamic AABB tree that has moved out of its fat AABB
+/// REINSERT : The leaf is removed and reinserted into the tree and the sub-trees along its path are balanced.
+/// REFIT : The fat AABB of the leaf is changed in place. The ancestors of all the moved leaves are then refitted
+///         in a single bottom-up pass followed by a bounded number of tree rotations that reduce the surface area.
+///         This is much cheaper for objects that keep moving around the same place but the quality of the tree
+///         decreases if the objects travel far from the place where they have been inserted.
+enum class DynamicAABBTreeUpdateMethod {REINSERT, REFIT};
 
 // Structure TreeNode
 /**
@@ -85,13 +96,16 @@ struct TreeNode {
     /// Height of the node in the tree
     int16 height;
 
+    /// True if the internal node has to be refitted during the next call to DynamicAABBTree::refit()
+    bool isRefitPending;
+
     /// Fat axis aligned bounding box (AABB) corresponding to the node
     AABB aabb;
 
     // -------------------- Methods -------------------- //
 
     /// Constructor
-    TreeNode() : nextNodeID(NULL_TREE_NODE), height(-1) {
+    TreeNode() : nextNodeID(NULL_TREE_NODE), height(-1), isRefitPending(false) {
 
     }
 
@@ -132,6 +146,23 @@ class DynamicAABBTreeRaycastCallback {
 
 };
 
+// Class DynamicAABBTreeDistanceCallback
+/**
+ * Callback in the Dynamic AABB Tree called when the AABB of a leaf node is
+ * within the search distance of a closest-shape query.
+ */
+class DynamicAABBTreeDistanceCallback {
+
+    public:
+
+        // Called when the AABB of a leaf node is within the search distance. The
+        // returned value is the new search distance (a negative value stops the query)
+        virtual decimal notifyNodeWithinDistance(int32 nodeId, decimal maxDistance)=0;
+
+        virtual ~DynamicAABBTreeDistanceCallback() = default;
+
+};
+
 // Class DynamicAABBTree
 /**
  * This class implements a dynamic AABB tree that is used for broad-phase
@@ -166,6 +197,12 @@ class DynamicAABBTree {
         /// The fat AABB is the initial AABB inflated by a given percentage of its size.
         decimal mFatAABBInflatePercentage;
 
+        /// Leaf nodes whose fat AABB has been changed in place and whose ancestors must be refitted
+        Array<int32> mRefitLeaves;
+
+        /// Internal nodes to refit during the call to refit()
+        Array<int32> mRefitNodes;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Pointer to the profiler
@@ -190,6 +227,9 @@ class DynamicAABBTree {
         /// Balance the sub-tree of a given node using left or right rotations.
         int32 balanceSubTreeAtNode(int32 nodeID);
 
+        /// Swap a child of a node with a grandchild if this reduces the surface area of the sub-tree
+        bool rotateNode(int32 nodeID);
+
         /// Compute the height of a given node in the tree
         int computeHeight(int32 nodeID);
 
@@ -231,6 +271,18 @@ class DynamicAABBTree {
         /// Update the dynamic tree after an object has moved.
         bool updateObject(int32 nodeID, const AABB& newAABB, bool forceReinsert = false);
 
+        /// Update the dynamic tree after an object has moved using a given fat AABB
+        bool updateObject(int32 nodeID, const AABB& newAABB, const AABB& newFatAABB, bool forceReinsert = false);
+
+        /// Change the fat AABB of an object that has moved in place (the tree must then be refitted)
+        bool refitObject(int32 nodeID, const AABB& newAABB, bool forceRefit = false);
+
+        /// Change the fat AABB of an object that has moved in place using a given fat AABB
+        bool refitObject(int32 nodeID, const AABB& newAABB, const AABB& newFatAABB, bool forceRefit = false);
+
+        /// Refit the ancestors of the objects that have moved and perform some tree rotations
+        uint32 refit(uint32 maxNbRotations);
+
         /// Return the fat AABB corresponding to a given node ID
         const AABB& getFatAABB(int32 nodeID) const;
 
@@ -247,18 +299,52 @@ class DynamicAABBTree {
         /// Report all shapes overlapping with the AABB given in parameter.
         void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int>& overlappingNodes) const;
 
+        /// Report all shapes overlapping with the AABB given in parameter (using a given allocator for the traversal)
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int>& overlappingNodes, MemoryAllocator& stackAllocator) const;
+
+        /// Report the leaf nodes whose AABB is accepted by a volume test to a function
+        template<typename VolumeTest, typename LeafFunction>
+        void reportAllShapesOverlappingWithVolume(const VolumeTest& volumeTest, LeafFunction& leafFunction,
+                                                  MemoryAllocator& stackAllocator) const;
+
         /// Ray casting method
         void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback) const;
 
+        /// Ray casting method (using a given allocator for the traversal)
+        void raycast(const Ray& ray, DynamicAABBTreeRaycastCallback& callback, MemoryAllocator& stackAllocator) const;
+
+        /// Ray casting method that reports the leaf nodes hit by the ray to a function
+        template<typename LeafFunction>
+        void raycastWithLeafFunction(const Ray& ray, LeafFunction& leafFunction, MemoryAllocator& stackAllocator) const;
+
+        /// Report the shapes whose AABB is within a shrinking distance of the AABB given in parameter
+        void reportShapesWithinDistance(const AABB& aabb, decimal maxDistance, DynamicAABBTreeDistanceCallback& callback,
+                                        MemoryAllocator& stackAllocator) const;
+
         /// Compute the height of the tree
         int computeHeight();
 
         /// Return the root AABB of the tree
         const AABB& getRootAABB() const;
 
+        /// Return true if the tree does not contain any node
+        bool isEmpty() const;
+
         /// Clear all the nodes and reset the tree
         void reset();
 
+        /// Write the nodes of the tree (with integer data) into a binary buffer
+        void serialize(BinaryWriter& writer) const;
+
+        /// Replace the nodes of the tree by the nodes read from a binary buffer
+        bool deserialize(BinaryReader& reader, uint32 maxNodeDataInt);
+
+        /// Write the raw nodes of the tree into a world snapshot
+        void takeSnapshot(BinaryWriter& writer) const;
+
+        /// Replace the nodes of the tree by the raw nodes of a world snapshot
+        bool restoreSnapshot(BinaryReader& reader);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -298,6 +384,11 @@ RP3D_FORCE_INLINE const AABB& DynamicAABBTree::getRootAABB() const {
     return getFatAABB(mRootNodeID);
 }
 
+// Return true if the tree does not contain any node
+RP3D_FORCE_INLINE bool DynamicAABBTree::isEmpty() const {
+    return mRootNodeID == TreeNode::NULL_TREE_NODE;
+}
+
 // Add an object into the tree. This method creates a new leaf node in the tree and
 // returns the ID of the corresponding node.
 RP3D_FORCE_INLINE int32 DynamicAABBTree::addObject(const AABB& aabb, uint32 data) {
@@ -320,6 +411,102 @@ RP3D_FORCE_INLINE int32 DynamicAABBTree::addObject(const AABB& aabb, void* data)
     return nodeId;
 }
 
+// Report the leaf nodes whose AABB is accepted by a volume test to a function
+/// The volume test is called as volumeTest(aabb) with the AABB of each visited node and the subtree
+/// of the node is skipped if it returns false. The function is called as leafFunction(nodeID) for each
+/// leaf node accepted by the volume test. Both are inlined in the traversal (no virtual call per node).
+template<typename VolumeTest, typename LeafFunction>
+void DynamicAABBTree::reportAllShapesOverlappingWithVolume(const VolumeTest& volumeTest, LeafFunction& leafFunction,
+                                                           MemoryAllocator& stackAllocator) const {
+
+    // Create a stack with the nodes to visit
+    Stack<int32> stack(stackAllocator, 64);
+    stack.push(mRootNodeID);
+
+    // While there are still nodes to visit
+    while(stack.size() > 0) {
+
+        // Get the next node ID to visit
+        const int32 nodeIDToVisit = stack.pop();
+
+        // Skip it if it is a null node
+        if (nodeIDToVisit == TreeNode::NULL_TREE_NODE) continue;
+
+        // Get the corresponding node
+        const TreeNode* nodeToVisit = mNodes + nodeIDToVisit;
+
+        // If the volume overlaps with the AABB of the node to visit
+        if (volumeTest(nodeToVisit->aabb)) {
+
+            // If the node is a leaf
+            if (nodeToVisit->isLeaf()) {
+
+                leafFunction(nodeIDToVisit);
+            }
+            else {  // If the node is not a leaf
+
+                // We need to visit its children
+                stack.push(nodeToVisit->children[0]);
+                stack.push(nodeToVisit->children[1]);
+            }
+        }
+    }
+}
+
+// Ray casting method that reports the leaf nodes hit by the ray to a function
+/// The function is called as leafFunction(nodeID, ray) and follows the same protocol as
+/// DynamicAABBTreeRaycastCallback::raycastBroadPhaseShape(): a returned fraction of zero stops
+/// the traversal, a positive fraction clips the ray and a negative one ignores the leaf. The
+/// function is inlined in the traversal (no virtual call per leaf).
+template<typename LeafFunction>
+void DynamicAABBTree::raycastWithLeafFunction(const Ray& ray, LeafFunction& leafFunction, MemoryAllocator& stackAllocator) const {
+
+    decimal maxFraction = ray.maxFraction;
+
+    // Compute the inverse ray direction
+    const Vector3 rayDirection = ray.point2 - ray.point1;
+    const Vector3 rayDirectionInverse(decimal(1.0) / rayDirection.x, decimal(1.0) / rayDirection.y, decimal(1.0) / rayDirection.z);
+
+    Stack<int32> stack(stackAllocator, 128);
+    stack.push(mRootNodeID);
+
+    while (stack.size() > 0) {
+
+        // Get the next node in the stack
+        const int32 nodeID = stack.pop();
+
+        // If it is a null node, skip it
+        if (nodeID == TreeNode::NULL_TREE_NODE) continue;
+
+        // Get the corresponding node
+        const TreeNode* node = mNodes + nodeID;
+
+        // Test if the ray intersects with the current node AABB
+        if (!node->aabb.testRayIntersect(ray.point1, rayDirectionInverse, maxFraction)) continue;
+
+        // If the node is a leaf of the tree
+        if (node->isLeaf()) {
+
+            const Ray rayTemp(ray.point1, ray.point2, maxFraction);
+            const decimal hitFraction = leafFunction(nodeID, rayTemp);
+
+            // A fraction of zero stops the raycasting
+            if (hitFraction == decimal(0.0)) return;
+
+            // A positive fraction clips the ray
+            if (hitFraction > decimal(0.0) && hitFraction < maxFraction) {
+                maxFraction = hitFraction;
+            }
+        }
+        else {  // If the node has children
+
+            // Push its children in the stack of nodes to explore
+            stack.push(node->children[0]);
+            stack.push(node->children[1]);
+        }
+    }
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
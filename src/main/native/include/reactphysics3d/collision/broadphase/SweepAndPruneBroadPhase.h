@@ -0,0 +1,146 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_SWEEP_AND_PRUNE_BROAD_PHASE_H
+#define REACTPHYSICS3D_SWEEP_AND_PRUNE_BROAD_PHASE_H
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/BroadPhaseBackend.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Class SweepAndPruneBroadPhase
+/**
+ * This class implements an incremental sweep-and-prune broad-phase. The fat AABBs of the
+ * proxies are stored in an array sorted by their minimum coordinate along a single axis
+ * (the axis where the centers of the AABBs are the most spread out). The minimum coordinates
+ * along this axis are also stored in a separate contiguous array so that the sweep only reads
+ * consecutive values until it reaches the end of the interval of a proxy. When a proxy moves,
+ * it is moved to its new place with an insertion sort which is very cheap because the objects
+ * only move a little at each step.
+ */
+class SweepAndPruneBroadPhase : public BroadPhaseBackend {
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// The proxies are sorted along a new axis if its variance is larger than
+        /// the variance of the current axis times this factor
+        static constexpr decimal AXIS_CHANGE_VARIANCE_FACTOR = decimal(1.5);
+
+        // -------------------- Attributes -------------------- //
+
+        /// Index of the sorting axis (0 = x, 1 = y, 2 = z)
+        uint32 mAxis;
+
+        /// Minimum coordinates along the sorting axis of the sorted proxies
+        Array<decimal> mSortedMins;
+
+        /// Fat AABBs of the sorted proxies
+        Array<AABB> mSortedAABBs;
+
+        /// Ids of the sorted proxies
+        Array<int32> mSortedProxies;
+
+        /// Index of each proxy in the sorted arrays (indexed by proxy id)
+        Array<uint32> mProxyIndices;
+
+        /// Upper bound of the size of the fat AABBs along the sorting axis
+        decimal mMaxExtent;
+
+        /// True for the proxies to test during the full sweep (indexed by proxy id)
+        Array<bool> mIsProxyToTest;
+
+        // -------------------- Methods -------------------- //
+
+        /// Add a new proxy into the sorted arrays
+        virtual void insertProxy(int32 proxyId) override;
+
+        /// Remove a proxy from the sorted arrays
+        virtual void removeProxy(int32 proxyId) override;
+
+        /// Move a proxy to its new place in the sorted arrays
+        virtual void moveProxy(int32 proxyId) override;
+
+        /// Write the sorted arrays into a world snapshot
+        virtual void takeStructureSnapshot(BinaryWriter& writer) const override;
+
+        /// Restore the sorted arrays from a world snapshot
+        virtual bool restoreStructureSnapshot(BinaryReader& reader) override;
+
+        /// Swap two consecutive entries of the sorted arrays
+        void swapSortedEntries(uint32 index1, uint32 index2);
+
+        /// Move an entry of the sorted arrays to its sorted place
+        void sortEntry(uint32 index);
+
+        /// Sort all the proxies along the sorting axis
+        void sortAllProxies();
+
+        /// Return the axis with the largest variance of the centers of the AABBs
+        uint32 computeBestAxis(decimal& outCurrentAxisVariance, decimal& outBestAxisVariance) const;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        SweepAndPruneBroadPhase(MemoryAllocator& allocator, decimal fatAABBInflatePercentage);
+
+        /// Destructor
+        virtual ~SweepAndPruneBroadPhase() override = default;
+
+        /// Return the broad-phase method implemented by the backend
+        virtual BroadPhaseMethod getMethod() const override;
+
+        /// Update the sorting axis and the maximum extent of the AABBs
+        virtual void update() override;
+
+        /// Report the pairs of proxies whose fat AABBs overlap with the fat AABB of some proxies to test
+        virtual void reportAllShapesOverlappingWithShapes(const Array<int32>& proxiesToTest,
+                                                          Array<Pair<int32, int32>>& outOverlappingProxies) override;
+
+        /// Report the proxies whose fat AABB overlaps with a given AABB
+        virtual void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& outOverlappingProxies) const override;
+
+        /// Return the index of the sorting axis
+        uint32 getSortingAxis() const;
+};
+
+// Return the broad-phase method implemented by the backend
+RP3D_FORCE_INLINE BroadPhaseMethod SweepAndPruneBroadPhase::getMethod() const {
+    return BroadPhaseMethod::SWEEP_AND_PRUNE;
+}
+
+// Return the index of the sorting axis
+RP3D_FORCE_INLINE uint32 SweepAndPruneBroadPhase::getSortingAxis() const {
+    return mAxis;
+}
+
+}
+
+#endif
@@ -0,0 +1,247 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_UNIFORM_GRID_BROAD_PHASE_H
+#define REACTPHYSICS3D_UNIFORM_GRID_BROAD_PHASE_H
+
+// Libraries
+#include <reactphysics3d/collision/broadphase/BroadPhaseBackend.h>
+#include <reactphysics3d/containers/Map.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Class UniformGridBroadPhase
+/**
+ * This class implements a broad-phase with a uniform grid. Each proxy is stored in all the
+ * cells overlapped by its fat AABB. The cells are stored in a hash map (indexed by the integer
+ * coordinates of the cell) so that the grid is not bounded and only the non-empty cells use some
+ * memory. The proxies stored in a cell form a linked list of entries in a single pooled array.
+ * The proxies that overlap with too many cells (a ground for instance) are not stored in the
+ * grid but in a separate array and are tested against all the other proxies.
+ */
+class UniformGridBroadPhase : public BroadPhaseBackend {
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of cells of a proxy stored in the grid
+        static constexpr uint64 MAX_NB_CELLS_PER_PROXY = 64;
+
+        /// Largest absolute value of the integer coordinates of a cell
+        static constexpr int32 MAX_CELL_COORDINATE = (1 << 20) - 1;
+
+        // -------------------- Structures -------------------- //
+
+        /// Range of cells overlapped by a fat AABB
+        struct CellRange {
+
+            /// Integer coordinates of the first cell
+            int32 min[3];
+
+            /// Integer coordinates of the last cell
+            int32 max[3];
+
+            /// True if the proxy overlaps with too many cells and is not stored in the grid
+            bool isLarge;
+
+            /// Return true if two ranges are equal
+            bool operator==(const CellRange& range) const;
+        };
+
+        /// Hash function of the cell keys. The bucket of a key only depends on the lowest bits of its
+        /// hash which would only contain the x coordinate of the cell with the identity hash.
+        struct CellKeyHash {
+
+            size_t operator()(uint64 key) const {
+                return static_cast<size_t>((key * 0x9E3779B97F4A7C15ull) >> 32);
+            }
+        };
+
+        /// Element of the linked list of the proxies of a cell
+        struct CellEntry {
+
+            /// Id of the proxy
+            int32 proxyId;
+
+            /// Index of the next entry of the cell (or of the next free entry)
+            int32 nextEntry;
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// Size of a cell
+        decimal mCellSize;
+
+        /// Inverse of the size of a cell
+        decimal mInverseCellSize;
+
+        /// Map a cell key to the index of the first entry of the cell
+        Map<uint64, int32, CellKeyHash> mCells;
+
+        /// Entries of the linked lists of the cells
+        Array<CellEntry> mEntries;
+
+        /// Index of the first free entry (-1 if there are none)
+        int32 mFreeEntry;
+
+        /// Range of cells of each proxy (indexed by proxy id)
+        Array<CellRange> mProxyCellRanges;
+
+        /// Ids of the proxies that are not stored in the grid
+        Array<int32> mLargeProxies;
+
+        // -------------------- Methods -------------------- //
+
+        /// Add a new proxy into the grid
+        virtual void insertProxy(int32 proxyId) override;
+
+        /// Remove a proxy from the grid
+        virtual void removeProxy(int32 proxyId) override;
+
+        /// Update the cells of a proxy that has moved
+        virtual void moveProxy(int32 proxyId) override;
+
+        /// Write the grid into a world snapshot
+        virtual void takeStructureSnapshot(BinaryWriter& writer) const override;
+
+        /// Restore the grid from a world snapshot
+        virtual bool restoreStructureSnapshot(BinaryReader& reader) override;
+
+        /// Compute the range of cells overlapped by an AABB
+        CellRange computeCellRange(const AABB& aabb) const;
+
+        /// Return the key of a cell in the hash map
+        static uint64 computeCellKey(int32 x, int32 y, int32 z);
+
+        /// Return the number of cells in a range
+        static uint64 computeNbCells(const CellRange& range);
+
+        /// Add a proxy into the cells of its range
+        void addProxyToCells(int32 proxyId);
+
+        /// Remove a proxy from the cells of its range
+        void removeProxyFromCells(int32 proxyId);
+
+        /// Call a function with each proxy of the grid that shares a cell with a range (once per proxy)
+        template<typename ProxyFunction>
+        void reportProxiesInCells(const CellRange& range, ProxyFunction& proxyFunction) const;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        UniformGridBroadPhase(MemoryAllocator& allocator, decimal fatAABBInflatePercentage, decimal cellSize);
+
+        /// Destructor
+        virtual ~UniformGridBroadPhase() override = default;
+
+        /// Return the broad-phase method implemented by the backend
+        virtual BroadPhaseMethod getMethod() const override;
+
+        /// Report the pairs of proxies whose fat AABBs overlap with the fat AABB of some proxies to test
+        virtual void reportAllShapesOverlappingWithShapes(const Array<int32>& proxiesToTest,
+                                                          Array<Pair<int32, int32>>& outOverlappingProxies) override;
+
+        /// Report the proxies whose fat AABB overlaps with a given AABB
+        virtual void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& outOverlappingProxies) const override;
+
+        /// Return the size of a cell
+        decimal getCellSize() const;
+
+        /// Return the number of non-empty cells
+        uint32 getNbCells() const;
+};
+
+// Return true if two ranges are equal
+RP3D_FORCE_INLINE bool UniformGridBroadPhase::CellRange::operator==(const CellRange& range) const {
+    return min[0] == range.min[0] && min[1] == range.min[1] && min[2] == range.min[2] &&
+           max[0] == range.max[0] && max[1] == range.max[1] && max[2] == range.max[2] && isLarge == range.isLarge;
+}
+
+// Return the broad-phase method implemented by the backend
+RP3D_FORCE_INLINE BroadPhaseMethod UniformGridBroadPhase::getMethod() const {
+    return BroadPhaseMethod::UNIFORM_GRID;
+}
+
+// Return the size of a cell
+RP3D_FORCE_INLINE decimal UniformGridBroadPhase::getCellSize() const {
+    return mCellSize;
+}
+
+// Return the number of non-empty cells
+RP3D_FORCE_INLINE uint32 UniformGridBroadPhase::getNbCells() const {
+    return static_cast<uint32>(mCells.size());
+}
+
+// Return the key of a cell in the hash map (21 bits per coordinate)
+RP3D_FORCE_INLINE uint64 UniformGridBroadPhase::computeCellKey(int32 x, int32 y, int32 z) {
+    const uint64 mask = (uint64(1) << 21) - 1;
+    return (static_cast<uint64>(x + MAX_CELL_COORDINATE) & mask) |
+           ((static_cast<uint64>(y + MAX_CELL_COORDINATE) & mask) << 21) |
+           ((static_cast<uint64>(z + MAX_CELL_COORDINATE) & mask) << 42);
+}
+
+// Return the number of cells in a range
+RP3D_FORCE_INLINE uint64 UniformGridBroadPhase::computeNbCells(const CellRange& range) {
+    return static_cast<uint64>(range.max[0] - range.min[0] + 1) * static_cast<uint64>(range.max[1] - range.min[1] + 1) *
+           static_cast<uint64>(range.max[2] - range.min[2] + 1);
+}
+
+// Call a function with each proxy of the grid that shares a cell with a range (once per proxy)
+/// A proxy that shares several cells with the range is only reported in the first shared cell.
+template<typename ProxyFunction>
+void UniformGridBroadPhase::reportProxiesInCells(const CellRange& range, ProxyFunction& proxyFunction) const {
+
+    for (int32 x=range.min[0]; x <= range.max[0]; x++) {
+        for (int32 y=range.min[1]; y <= range.max[1]; y++) {
+            for (int32 z=range.min[2]; z <= range.max[2]; z++) {
+
+                auto it = mCells.find(computeCellKey(x, y, z));
+                if (it == mCells.end()) continue;
+
+                for (int32 entry = it->second; entry != -1; entry = mEntries[entry].nextEntry) {
+
+                    const int32 proxyId = mEntries[entry].proxyId;
+                    const CellRange& proxyRange = mProxyCellRanges[proxyId];
+
+                    // Skip the proxy if this is not the first cell shared with the range
+                    if (std::max(range.min[0], proxyRange.min[0]) != x || std::max(range.min[1], proxyRange.min[1]) != y ||
+                        std::max(range.min[2], proxyRange.min[2]) != z) {
+                        continue;
+                    }
+
+                    proxyFunction(proxyId);
+                }
+            }
+        }
+    }
+}
+
+}
+
+#endif
@@ -39,12 +39,17 @@ struct NarrowPhaseInfoBatch;
 class ConvexShape;
 class Profiler;
 class VoronoiSimplex;
+class Transform;
+struct Vector3;
 template<typename T> class Array;
 
 // Constants
 constexpr decimal REL_ERROR = decimal(1.0e-3);
 constexpr decimal REL_ERROR_SQUARE = REL_ERROR * REL_ERROR;
 constexpr int MAX_ITERATIONS_GJK_RAYCAST = 32;
+constexpr int MAX_ITERATIONS_GJK_DISTANCE = 64;
+constexpr int MAX_ITERATIONS_GJK_TIME_OF_IMPACT = 32;
+constexpr decimal GJK_TIME_OF_IMPACT_TOLERANCE = decimal(0.001);
 
 // Class GJKAlgorithm
 /**
@@ -100,6 +105,16 @@ class GJKAlgorithm {
         void testCollision(NarrowPhaseInfoBatch& narrowPhaseInfoBatch, uint32 batchStartIndex,
                            uint32 batchNbItems, Array<GJKResult>& gjkResults);
 
+        /// Compute the distance and the closest points between two convex shapes
+        bool computeClosestPoints(const ConvexShape* shape1, const Transform& shape1ToWorldTransform,
+                                  const ConvexShape* shape2, const Transform& shape2ToWorldTransform,
+                                  decimal& outDistance, Vector3& outPoint1, Vector3& outPoint2, Vector3& outNormal) const;
+
+        /// Compute the time of impact of a convex shape moving along a translation with another convex shape
+        bool computeTimeOfImpact(const ConvexShape* shape1, const Transform& shape1ToWorldTransform, const Vector3& translation1,
+                                 const ConvexShape* shape2, const Transform& shape2ToWorldTransform, decimal maxFraction,
+                                 decimal& outHitFraction, Vector3& outWorldPoint, Vector3& outWorldNormal) const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 		/// Set the profiler
@@ -66,9 +66,6 @@ struct NarrowPhaseInfoBatch {
         /// Collision info of the previous frame
         LastFrameCollisionInfo* lastFrameCollisionInfo;
 
-        /// Memory allocator for the collision shape (Used to release TriangleShape memory in destructor)
-        MemoryAllocator* collisionShapeAllocator;
-
         /// Shape local to world transform of sphere 1
         Transform shape1ToWorldTransform;
 
@@ -94,11 +91,11 @@ struct NarrowPhaseInfoBatch {
         ContactPointInfo contactPoints[NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO];
 
         /// Constructor
-        NarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator,
+        NarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, LastFrameCollisionInfo* lastFrameInfo,
                              const Transform& shape1ToWorldTransform, const Transform& shape2ToWorldTransform, CollisionShape* shape1,
                              CollisionShape* shape2, bool needToReportContacts)
                       : overlappingPairId(pairId), colliderEntity1(collider1), colliderEntity2(collider2), lastFrameCollisionInfo(lastFrameInfo),
-                         collisionShapeAllocator(&shapeAllocator), shape1ToWorldTransform(shape1ToWorldTransform),
+                         shape1ToWorldTransform(shape1ToWorldTransform),
                          shape2ToWorldTransform(shape2ToWorldTransform), collisionShape1(shape1),
                         collisionShape2(shape2), reportContacts(needToReportContacts), isColliding(false), nbContactPoints(0) {
 
@@ -116,9 +113,6 @@ struct NarrowPhaseInfoBatch {
         /// Cached capacity
         uint32 mCachedCapacity = 0;
 
-        /// TriangleShape allocated size
-        static const size_t mTriangleShapeAllocatedSize;
-
     public:
 
         /// For each collision test, we keep some meta data
@@ -133,7 +127,7 @@ struct NarrowPhaseInfoBatch {
         /// Add shapes to be tested during narrow-phase collision detection into the batch
         void addNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                                                       CollisionShape* shape2, const Transform& shape1Transform, const Transform& shape2Transform,
-                                                      bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
+                                                      bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo);
 
         /// Return the number of objects in the batch
         uint32 getNbObjects() const;
@@ -160,10 +154,10 @@ RP3D_FORCE_INLINE uint32 NarrowPhaseInfoBatch::getNbObjects() const {
 // Add shapes to be tested during narrow-phase collision detection into the batch
 RP3D_FORCE_INLINE void NarrowPhaseInfoBatch::addNarrowPhaseInfo(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                                               CollisionShape* shape2, const Transform& shape1Transform, const Transform& shape2Transform,
-                                              bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator) {
+                                              bool needToReportContacts, LastFrameCollisionInfo* lastFrameInfo) {
 
     // Create a meta data object
-    narrowPhaseInfos.emplace(pairId, collider1, collider2, lastFrameInfo, shapeAllocator, shape1Transform, shape2Transform, shape1, shape2, needToReportContacts);
+    narrowPhaseInfos.emplace(pairId, collider1, collider2, lastFrameInfo, shape1Transform, shape2Transform, shape1, shape2, needToReportContacts);
 }
 
 // Add a new contact point
@@ -29,6 +29,7 @@
 // Libraries
 #include <reactphysics3d/containers/Array.h>
 #include <reactphysics3d/collision/narrowphase/NarrowPhaseInfoBatch.h>
+#include <reactphysics3d/collision/narrowphase/TriangleShapeBatch.h>
 #include <reactphysics3d/collision/narrowphase/CollisionDispatch.h>
 
 /// Namespace ReactPhysics3D
@@ -42,6 +43,7 @@ struct ContactPointInfo;
 class NarrowPhaseAlgorithm;
 enum class NarrowPhaseAlgorithmType;
 class Transform;
+class HalfEdgeStructure;
 struct Vector3;
 
 // Class NarrowPhaseInput
@@ -60,16 +62,20 @@ class NarrowPhaseInput {
         NarrowPhaseInfoBatch mCapsuleVsConvexPolyhedronBatch;
         NarrowPhaseInfoBatch mConvexPolyhedronVsConvexPolyhedronBatch;
 
+        /// Triangles of the concave shapes tested in the batches
+        TriangleShapeBatch mTriangleShapeBatch;
+
     public:
 
         /// Constructor
-        NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs& overlappingPairs);
+        NarrowPhaseInput(MemoryAllocator& allocator, OverlappingPairs& overlappingPairs, MemoryAllocator& triangleAllocator,
+                         HalfEdgeStructure& triangleHalfEdgeStructure);
 
         /// Add shapes to be tested during narrow-phase collision detection into the batch
         void addNarrowPhaseTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1,
                         CollisionShape* shape2, const Transform& shape1Transform,
                         const Transform& shape2Transform, NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts,
-                        LastFrameCollisionInfo* lastFrameInfo, MemoryAllocator& shapeAllocator);
+                        LastFrameCollisionInfo* lastFrameInfo);
 
         /// Get a reference to the sphere vs sphere batch
         NarrowPhaseInfoBatch& getSphereVsSphereBatch();
@@ -89,6 +95,12 @@ class NarrowPhaseInput {
         /// Get a reference to the convex polyhedron vs convex polyhedron batch
         NarrowPhaseInfoBatch& getConvexPolyhedronVsConvexPolyhedronBatch();
 
+        /// Get a reference to the batch of triangles of the concave shapes
+        TriangleShapeBatch& getTriangleShapeBatch();
+
+        /// Return the total number of narrow-phase tests in the batches
+        uint32 getNbNarrowPhaseTests() const;
+
         /// Reserve memory for the containers with cached capacity
         void reserveMemory();
 
@@ -127,30 +139,41 @@ RP3D_FORCE_INLINE NarrowPhaseInfoBatch &NarrowPhaseInput::getConvexPolyhedronVsC
    return mConvexPolyhedronVsConvexPolyhedronBatch;
 }
 
+// Get a reference to the batch of triangles of the concave shapes
+RP3D_FORCE_INLINE TriangleShapeBatch& NarrowPhaseInput::getTriangleShapeBatch() {
+   return mTriangleShapeBatch;
+}
+
+// Return the total number of narrow-phase tests in the batches
+RP3D_FORCE_INLINE uint32 NarrowPhaseInput::getNbNarrowPhaseTests() const {
+   return mSphereVsSphereBatch.getNbObjects() + mSphereVsCapsuleBatch.getNbObjects() + mCapsuleVsCapsuleBatch.getNbObjects() +
+          mSphereVsConvexPolyhedronBatch.getNbObjects() + mCapsuleVsConvexPolyhedronBatch.getNbObjects() +
+          mConvexPolyhedronVsConvexPolyhedronBatch.getNbObjects();
+}
+
 // Add shapes to be tested during narrow-phase collision detection into the batch
 RP3D_FORCE_INLINE void NarrowPhaseInput::addNarrowPhaseTest(uint64 pairId, Entity collider1, Entity collider2, CollisionShape* shape1, CollisionShape* shape2,
                                           const Transform& shape1Transform, const Transform& shape2Transform,
-                                          NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts, LastFrameCollisionInfo* lastFrameInfo,
-                                          MemoryAllocator& shapeAllocator) {
+                                          NarrowPhaseAlgorithmType narrowPhaseAlgorithmType, bool reportContacts, LastFrameCollisionInfo* lastFrameInfo) {
 
     switch (narrowPhaseAlgorithmType) {
         case NarrowPhaseAlgorithmType::SphereVsSphere:
-            mSphereVsSphereBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsSphereBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::SphereVsCapsule:
-            mSphereVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::CapsuleVsCapsule:
-            mCapsuleVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mCapsuleVsCapsuleBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::SphereVsConvexPolyhedron:
-            mSphereVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mSphereVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::CapsuleVsConvexPolyhedron:
-            mCapsuleVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mCapsuleVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::ConvexPolyhedronVsConvexPolyhedron:
-            mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo, shapeAllocator);
+            mConvexPolyhedronVsConvexPolyhedronBatch.addNarrowPhaseInfo(pairId, collider1, collider2, shape1, shape2, shape1Transform, shape2Transform, reportContacts, lastFrameInfo);
             break;
         case NarrowPhaseAlgorithmType::NoCollisionTest:
             // Must never happen
@@ -0,0 +1,148 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_TRIANGLE_SHAPE_BATCH_H
+#define REACTPHYSICS3D_TRIANGLE_SHAPE_BATCH_H
+
+// Libraries
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <reactphysics3d/configuration.h>
+
+/// Namespace ReactPhysics3D
+namespace reactphysics3d {
+
+// Declarations
+class TriangleShape;
+class HalfEdgeStructure;
+class MemoryAllocator;
+
+// Class TriangleShapeBatch
+/**
+ * This class stores the triangles of the concave shapes that are tested during the
+ * narrow-phase collision detection. The overlapping triangles of a concave shape are
+ * gathered into shared vertices, normals and shape ids arrays and the TriangleShape
+ * objects are constructed in blocks that are kept from one frame to the next. Clearing
+ * the batch only resets the number of triangles in use so that, once the batch has grown
+ * to its working size, the middle-phase does not allocate memory for each triangle anymore.
+ */
+class TriangleShapeBatch {
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of triangle shapes in each allocated block
+        static const uint32 NB_TRIANGLES_PER_BLOCK;
+
+        /// TriangleShape allocated size
+        static const size_t mTriangleShapeAllocatedSize;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator for the blocks of triangle shapes and the triangles arrays
+        MemoryAllocator& mAllocator;
+
+        /// Reference to the triangle half-edge structure
+        HalfEdgeStructure& mTriangleHalfEdgeStructure;
+
+        /// Allocated blocks of triangle shapes
+        Array<void*> mBlocks;
+
+        /// Triangle shapes that have already been constructed in the blocks
+        Array<TriangleShape*> mTriangleShapes;
+
+        /// Number of triangle shapes in use since the last clear
+        uint32 mNbTriangleShapes;
+
+    public:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Vertices of the overlapping triangles (three vertices per triangle)
+        Array<Vector3> triangleVertices;
+
+        /// Vertices normals of the overlapping triangles (three normals per triangle)
+        Array<Vector3> triangleVerticesNormals;
+
+        /// Shape ids of the overlapping triangles
+        Array<uint32> triangleShapeIds;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        TriangleShapeBatch(MemoryAllocator& allocator, HalfEdgeStructure& triangleHalfEdgeStructure);
+
+        /// Destructor
+        ~TriangleShapeBatch();
+
+        /// Deleted copy-constructor
+        TriangleShapeBatch(const TriangleShapeBatch& batch) = delete;
+
+        /// Deleted assignment operator
+        TriangleShapeBatch& operator=(const TriangleShapeBatch& batch) = delete;
+
+        /// Clear the vertices, normals and shape ids arrays of the overlapping triangles
+        void clearTriangles();
+
+        /// Return a triangle shape for the triangle at a given index of the triangles arrays
+        TriangleShape* createTriangleShape(uint32 triangleIndex);
+
+        /// Return the number of triangle shapes in use since the last clear
+        uint32 getNbTriangleShapes() const;
+
+        /// Return the number of triangle shapes that have been constructed in the blocks
+        uint32 getNbAllocatedTriangleShapes() const;
+
+        /// Clear the batch (the triangle shapes are kept to be reused)
+        void clear();
+};
+
+// Clear the vertices, normals and shape ids arrays of the overlapping triangles
+RP3D_FORCE_INLINE void TriangleShapeBatch::clearTriangles() {
+    triangleVertices.clear();
+    triangleVerticesNormals.clear();
+    triangleShapeIds.clear();
+}
+
+// Return the number of triangle shapes in use since the last clear
+RP3D_FORCE_INLINE uint32 TriangleShapeBatch::getNbTriangleShapes() const {
+    return mNbTriangleShapes;
+}
+
+// Return the number of triangle shapes that have been constructed in the blocks
+RP3D_FORCE_INLINE uint32 TriangleShapeBatch::getNbAllocatedTriangleShapes() const {
+    return static_cast<uint32>(mTriangleShapes.size());
+}
+
+// Clear the batch (the triangle shapes are kept to be reused)
+RP3D_FORCE_INLINE void TriangleShapeBatch::clear() {
+    mNbTriangleShapes = 0;
+    clearTriangles();
+}
+
+}
+
+#endif
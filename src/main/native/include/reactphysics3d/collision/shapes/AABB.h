@@ -107,6 +107,15 @@ class AABB {
         /// Return true if the AABB of a triangle intersects the AABB
         bool testCollisionTriangleAABB(const Vector3* trianglePoints) const;
 
+        /// Return true if the AABB overlaps with a sphere
+        bool testCollisionWithSphere(const Vector3& center, decimal radius) const;
+
+        /// Return true if the AABB overlaps with a frustum (conservative test)
+        bool testCollisionWithFrustum(const Frustum& frustum) const;
+
+        /// Return the square distance between the AABB and another AABB (zero if they overlap)
+        decimal computeSquareDistance(const AABB& aabb) const;
+
         /// Return true if the ray intersects the AABB
         bool testRayIntersect(const Vector3& rayOrigin, const Vector3& rayDirectionInv, decimal rayMaxFraction) const;
 
@@ -186,6 +195,53 @@ RP3D_FORCE_INLINE bool AABB::testCollision(const AABB& aabb) const {
     return true;
 }
 
+// Return true if the AABB overlaps with a sphere
+RP3D_FORCE_INLINE bool AABB::testCollisionWithSphere(const Vector3& center, decimal radius) const {
+
+    // Square distance between the center of the sphere and the AABB
+    decimal squareDistance = decimal(0.0);
+    for (int i=0; i < 3; i++) {
+        if (center[i] < mMinCoordinates[i]) squareDistance += (mMinCoordinates[i] - center[i]) * (mMinCoordinates[i] - center[i]);
+        else if (center[i] > mMaxCoordinates[i]) squareDistance += (center[i] - mMaxCoordinates[i]) * (center[i] - mMaxCoordinates[i]);
+    }
+
+    return squareDistance <= radius * radius;
+}
+
+// Return the square distance between the AABB and another AABB (zero if they overlap)
+RP3D_FORCE_INLINE decimal AABB::computeSquareDistance(const AABB& aabb) const {
+
+    decimal squareDistance = decimal(0.0);
+    for (int i=0; i < 3; i++) {
+        const decimal gap = std::max(mMinCoordinates[i] - aabb.mMaxCoordinates[i], aabb.mMinCoordinates[i] - mMaxCoordinates[i]);
+        if (gap > decimal(0.0)) {
+            squareDistance += gap * gap;
+        }
+    }
+
+    return squareDistance;
+}
+
+// Return true if the AABB overlaps with a frustum
+/// The AABB is rejected only if it is completely outside of one of the planes of the
+/// frustum. Therefore, an AABB near a corner of the frustum can be reported as overlapping.
+RP3D_FORCE_INLINE bool AABB::testCollisionWithFrustum(const Frustum& frustum) const {
+
+    const Vector3 center = getCenter();
+    const Vector3 halfExtent = (mMaxCoordinates - mMinCoordinates) * decimal(0.5);
+
+    for (uint32 i=0; i < frustum.nbPlanes; i++) {
+
+        // Smallest value of normal.dot(p) for the points p of the AABB
+        const Vector3& normal = frustum.planeNormals[i];
+        const decimal minProjection = normal.dot(center) - (std::abs(normal.x) * halfExtent.x + std::abs(normal.y) * halfExtent.y +
+                                                             std::abs(normal.z) * halfExtent.z);
+        if (minProjection > frustum.planeDistances[i]) return false;
+    }
+
+    return true;
+}
+
 // Return the volume of the AABB
 RP3D_FORCE_INLINE decimal AABB::getVolume() const {
     const Vector3 diff = mMaxCoordinates - mMinCoordinates;
@@ -72,6 +72,9 @@ class BoxShape : public ConvexPolyhedronShape {
         /// Raycast method with feedback information
         virtual bool raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* collider, MemoryAllocator& allocator) const override;
 
+        /// Return true if a ray hits the shape (without computing the hit point and normal)
+        virtual bool testRayHit(const Ray& ray, Collider* collider, MemoryAllocator& allocator) const override;
+
         /// Return the number of bytes used by the collision shape
         virtual size_t getSizeInBytes() const override;
 
@@ -94,6 +94,9 @@ class CollisionShape {
         /// Raycast method with feedback information
         virtual bool raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* collider, MemoryAllocator& allocator) const=0;
 
+        /// Return true if a ray hits the shape (without computing the hit point and normal)
+        virtual bool testRayHit(const Ray& ray, Collider* collider, MemoryAllocator& allocator) const;
+
         /// Return the number of bytes used by the collision shape
         virtual size_t getSizeInBytes() const = 0;
 
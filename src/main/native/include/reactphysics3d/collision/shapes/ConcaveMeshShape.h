@@ -77,6 +77,7 @@ class ConcaveMeshRaycastCallback : public DynamicAABBTreeRaycastCallback {
         RaycastInfo& mRaycastInfo;
         const Ray& mRay;
         bool mIsHit;
+        bool mIsAnyHitQuery;
         MemoryAllocator& mAllocator;
 
 #ifdef IS_RP3D_PROFILING_ENABLED
@@ -92,16 +93,24 @@ class ConcaveMeshRaycastCallback : public DynamicAABBTreeRaycastCallback {
         ConcaveMeshRaycastCallback(const ConcaveMeshShape& concaveMeshShape,
                                    Collider* collider, RaycastInfo& raycastInfo, const Ray& ray, MemoryAllocator& allocator)
             : mHitAABBNodes(allocator), mConcaveMeshShape(concaveMeshShape), mCollider(collider),
-              mRaycastInfo(raycastInfo), mRay(ray), mIsHit(false), mAllocator(allocator) {
+              mRaycastInfo(raycastInfo), mRay(ray), mIsHit(false), mIsAnyHitQuery(false), mAllocator(allocator) {
 
         }
 
         /// Collect all the AABB nodes that are hit by the ray in the Dynamic AABB Tree
         virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray) override;
 
+        /// Raycast the triangle of a given node of the Dynamic AABB Tree
+        bool raycastTriangle(int32 nodeId, RaycastInfo& raycastInfo) const;
+
         /// Raycast all collision shapes that have been collected
         void raycastTriangles();
 
+        /// Set to true to stop the query at the first triangle hit by the ray
+        void setIsAnyHitQuery(bool isAnyHitQuery) {
+            mIsAnyHitQuery = isAnyHitQuery;
+        }
+
         /// Return true if a raycast hit has been found
         bool getIsHit() const {
             return mIsHit;
@@ -146,6 +155,9 @@ class ConcaveMeshShape : public ConcaveShape {
         /// Raycast method with feedback information
         virtual bool raycast(const Ray& ray, RaycastInfo& raycastInfo, Collider* collider, MemoryAllocator& allocator) const override;
 
+        /// Return true if a ray hits the shape (without computing the hit point and normal)
+        virtual bool testRayHit(const Ray& ray, Collider* collider, MemoryAllocator& allocator) const override;
+
         /// Return the number of bytes used by the collision shape
         virtual size_t getSizeInBytes() const override;
 
@@ -117,6 +117,9 @@ class TriangleShape : public ConvexPolyhedronShape {
         /// Destructor
         virtual ~TriangleShape() override = default;
 
+        /// Set the vertices, vertices normals and id of the triangle
+        void setTriangle(const Vector3* vertices, const Vector3* verticesNormals, uint32 shapeId);
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -188,6 +191,7 @@ class TriangleShape : public ConvexPolyhedronShape {
         friend class MiddlePhaseTriangleCallback;
         friend class HeightField;
         friend class CollisionDetectionSystem;
+        friend class TriangleShapeBatch;
 };
 
 // Return the number of bytes used by the collision shape
@@ -69,6 +69,12 @@ class BodyComponents : public Components {
         /// For each body, true if it has a least one simulation collider
         bool* mHasSimulationCollider;
 
+        /// For each body, true if its contact and trigger events are added to the contact event buffer
+        bool* mIsContactEventsEnabled;
+
+        /// For each body, true if its colliders are grouped under a single node of the broad-phase
+        bool* mIsCompoundBroadPhase;
+
         // -------------------- Methods -------------------- //
 
         /// Allocate memory for a given number of components
@@ -137,6 +143,18 @@ class BodyComponents : public Components {
         /// Set whether the body has at least one simulation collider
         void setHasSimulationCollider(Entity bodyEntity, bool hasSimulationCollider) const;
 
+        /// Return true if the contact events of the body are added to the contact event buffer
+        bool getIsContactEventsEnabled(Entity bodyEntity) const;
+
+        /// Set whether the contact events of the body are added to the contact event buffer
+        void setIsContactEventsEnabled(Entity bodyEntity, bool isEnabled) const;
+
+        /// Return true if the colliders of the body are grouped under a single node of the broad-phase
+        bool getIsCompoundBroadPhase(Entity bodyEntity) const;
+
+        /// Set whether the colliders of the body are grouped under a single node of the broad-phase
+        void setIsCompoundBroadPhase(Entity bodyEntity, bool isCompoundBroadPhase) const;
+
         // -------------------- Friendship -------------------- //
 
         friend class Body;
@@ -220,6 +238,34 @@ RP3D_FORCE_INLINE void BodyComponents::setHasSimulationCollider(Entity bodyEntit
    mHasSimulationCollider[mMapEntityToComponentIndex[bodyEntity]] = hasSimulationCollider;
 }
 
+// Return true if the contact events of the body are added to the contact event buffer
+RP3D_FORCE_INLINE bool BodyComponents::getIsContactEventsEnabled(Entity bodyEntity) const {
+
+   assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+   return mIsContactEventsEnabled[mMapEntityToComponentIndex[bodyEntity]];
+}
+
+// Set whether the contact events of the body are added to the contact event buffer
+RP3D_FORCE_INLINE void BodyComponents::setIsContactEventsEnabled(Entity bodyEntity, bool isEnabled) const {
+
+   assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+   mIsContactEventsEnabled[mMapEntityToComponentIndex[bodyEntity]] = isEnabled;
+}
+
+// Return true if the colliders of the body are grouped under a single node of the broad-phase
+RP3D_FORCE_INLINE bool BodyComponents::getIsCompoundBroadPhase(Entity bodyEntity) const {
+
+   assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+   return mIsCompoundBroadPhase[mMapEntityToComponentIndex[bodyEntity]];
+}
+
+// Set whether the colliders of the body are grouped under a single node of the broad-phase
+RP3D_FORCE_INLINE void BodyComponents::setIsCompoundBroadPhase(Entity bodyEntity, bool isCompoundBroadPhase) const {
+
+   assert(mMapEntityToComponentIndex.containsKey(bodyEntity));
+   mIsCompoundBroadPhase[mMapEntityToComponentIndex[bodyEntity]] = isCompoundBroadPhase;
+}
+
 }
 
 #endif
@@ -80,12 +80,12 @@ class ColliderComponents : public Components {
         /// together with the mCollideWithMaskBits variable so that given
         /// categories of shapes collide with each other and do not collide with
         /// other categories.
-        unsigned short* mCollisionCategoryBits;
+        uint64* mCollisionCategoryBits;
 
         /// Array of bits mask used to state which collision categories this shape can
-        /// collide with. This value is 0xFFFF by default. It means that this
+        /// collide with. All the bits are set by default (ALL_COLLISION_CATEGORIES). It means that this
         /// collider will collide with every collision categories by default.
-        unsigned short* mCollideWithMaskBits;
+        uint64* mCollideWithMaskBits;
 
         /// Array with the local-to-world transforms of the colliders
         Transform* mLocalToWorldTransforms;
@@ -123,6 +123,12 @@ class ColliderComponents : public Components {
         /// Swap two components in the array
         virtual void swapComponents(uint32 index1, uint32 index2) override;
 
+        /// Write the simulation state of the components into a world snapshot
+        virtual void takeStateSnapshot(BinaryWriter& writer) const override;
+
+        /// Restore the simulation state of the components from a world snapshot
+        virtual bool restoreStateSnapshot(BinaryReader& reader) override;
+
     public:
 
         /// Structure for the data of a collider component
@@ -133,15 +139,15 @@ class ColliderComponents : public Components {
             AABB localBounds;
             const Transform& localToBodyTransform;
             CollisionShape* collisionShape;
-            unsigned short collisionCategoryBits;
-            unsigned short collideWithMaskBits;
+            uint64 collisionCategoryBits;
+            uint64 collideWithMaskBits;
             const Transform& localToWorldTransform;
             const Material& material;
 
             /// Constructor
             ColliderComponent(Entity bodyEntity, Collider* collider, AABB localBounds, const Transform& localToBodyTransform,
-                                CollisionShape* collisionShape, unsigned short collisionCategoryBits,
-                                unsigned short collideWithMaskBits, const Transform& localToWorldTransform, const Material& material)
+                                CollisionShape* collisionShape, uint64 collisionCategoryBits,
+                                uint64 collideWithMaskBits, const Transform& localToWorldTransform, const Material& material)
                  :bodyEntity(bodyEntity), collider(collider), localBounds(localBounds), localToBodyTransform(localToBodyTransform),
                   collisionShape(collisionShape), collisionCategoryBits(collisionCategoryBits), collideWithMaskBits(collideWithMaskBits),
                   localToWorldTransform(localToWorldTransform), material(material) {
@@ -182,16 +188,16 @@ class ColliderComponents : public Components {
         void setBroadPhaseId(Entity colliderEntity, int32 broadPhaseId);
 
         /// Return the collision category bits of a given collider
-        unsigned short getCollisionCategoryBits(Entity colliderEntity) const;
+        uint64 getCollisionCategoryBits(Entity colliderEntity) const;
 
         /// Set the collision category bits of a given collider
-        void setCollisionCategoryBits(Entity colliderEntity, unsigned short collisionCategoryBits);
+        void setCollisionCategoryBits(Entity colliderEntity, uint64 collisionCategoryBits);
 
         /// Return the "collide with" mask bits of a given collider
-        unsigned short getCollideWithMaskBits(Entity colliderEntity) const;
+        uint64 getCollideWithMaskBits(Entity colliderEntity) const;
 
         /// Set the "collide with" mask bits of a given collider
-        void setCollideWithMaskBits(Entity colliderEntity, unsigned short collideWithMaskBits);
+        void setCollideWithMaskBits(Entity colliderEntity, uint64 collideWithMaskBits);
 
         /// Return the local-to-world transform of a collider
         const Transform& getLocalToWorldTransform(Entity colliderEntity) const;
@@ -240,6 +246,7 @@ class ColliderComponents : public Components {
         friend class DynamicsSystem;
         friend class OverlappingPairs;
         friend class RigidBody;
+        friend class WorldQueryContext;
 };
 
 // Return the body entity of a given collider
@@ -299,7 +306,7 @@ RP3D_FORCE_INLINE void ColliderComponents::setBroadPhaseId(Entity colliderEntity
 }
 
 // Return the collision category bits of a given collider
-RP3D_FORCE_INLINE unsigned short ColliderComponents::getCollisionCategoryBits(Entity colliderEntity) const {
+RP3D_FORCE_INLINE uint64 ColliderComponents::getCollisionCategoryBits(Entity colliderEntity) const {
 
     assert(mMapEntityToComponentIndex.containsKey(colliderEntity));
 
@@ -307,7 +314,7 @@ RP3D_FORCE_INLINE unsigned short ColliderComponents::getCollisionCategoryBits(En
 }
 
 // Return the "collide with" mask bits of a given collider
-RP3D_FORCE_INLINE unsigned short ColliderComponents::getCollideWithMaskBits(Entity colliderEntity) const {
+RP3D_FORCE_INLINE uint64 ColliderComponents::getCollideWithMaskBits(Entity colliderEntity) const {
 
     assert(mMapEntityToComponentIndex.containsKey(colliderEntity));
 
@@ -315,7 +322,7 @@ RP3D_FORCE_INLINE unsigned short ColliderComponents::getCollideWithMaskBits(Enti
 }
 
 // Set the collision category bits of a given collider
-RP3D_FORCE_INLINE void ColliderComponents::setCollisionCategoryBits(Entity colliderEntity, unsigned short collisionCategoryBits) {
+RP3D_FORCE_INLINE void ColliderComponents::setCollisionCategoryBits(Entity colliderEntity, uint64 collisionCategoryBits) {
 
     assert(mMapEntityToComponentIndex.containsKey(colliderEntity));
 
@@ -323,7 +330,7 @@ RP3D_FORCE_INLINE void ColliderComponents::setCollisionCategoryBits(Entity colli
 }
 
 // Set the "collide with" mask bits of a given collider
-RP3D_FORCE_INLINE void ColliderComponents::setCollideWithMaskBits(Entity colliderEntity, unsigned short collideWithMaskBits) {
+RP3D_FORCE_INLINE void ColliderComponents::setCollideWithMaskBits(Entity colliderEntity, uint64 collideWithMaskBits) {
 
     assert(mMapEntityToComponentIndex.containsKey(colliderEntity));
 
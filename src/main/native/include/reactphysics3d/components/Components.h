@@ -30,6 +30,7 @@
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/engine/Entity.h>
 #include <reactphysics3d/containers/Map.h>
+#include <reactphysics3d/utils/BinarySerializer.h>
 
 // ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -94,6 +95,20 @@ class Components {
         /// Swap two components in the array
         virtual void swapComponents(uint32 index1, uint32 index2)=0;
 
+        /// Write the simulation state of the components into a world snapshot
+        virtual void takeStateSnapshot(BinaryWriter& writer) const;
+
+        /// Restore the simulation state of the components from a world snapshot
+        virtual bool restoreStateSnapshot(BinaryReader& reader);
+
+        /// Write an array of the components into a world snapshot
+        template<typename T>
+        void writeSnapshotArray(BinaryWriter& writer, const T* array) const;
+
+        /// Read an array of the components from a world snapshot
+        template<typename T>
+        bool readSnapshotArray(BinaryReader& reader, T* array);
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -130,6 +145,15 @@ class Components {
 
         /// Return the index in the arrays for a given entity
         uint32 getEntityIndex(Entity entity) const;
+
+        /// Write the order and the simulation state of the components into a world snapshot
+        void takeSnapshot(BinaryWriter& writer) const;
+
+        /// Check that the order of the components in a world snapshot matches the current components
+        bool validateSnapshot(BinaryReader& reader) const;
+
+        /// Restore the order and the simulation state of the components from a world snapshot
+        bool restoreSnapshot(BinaryReader& reader);
 };
 
 // Return true if an entity is sleeping
@@ -171,6 +195,22 @@ RP3D_FORCE_INLINE uint32 Components::getEntityIndex(Entity entity) const {
     assert(hasComponent(entity));
     return mMapEntityToComponentIndex[entity];
 }
+
+// Write an array of the components into a world snapshot
+/// The values are copied as they are in memory. A snapshot can therefore only be
+/// restored with the same build of the library.
+template<typename T>
+RP3D_FORCE_INLINE void Components::writeSnapshotArray(BinaryWriter& writer, const T* array) const {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be written into a snapshot");
+    writer.writeBytes(array, mNbComponents * sizeof(T));
+}
+
+// Read an array of the components from a world snapshot
+template<typename T>
+RP3D_FORCE_INLINE bool Components::readSnapshotArray(BinaryReader& reader, T* array) {
+    static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be read from a snapshot");
+    return reader.readBytes(array, mNbComponents * sizeof(T));
+}
 }
 
 #endif
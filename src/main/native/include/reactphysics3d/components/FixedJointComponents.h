@@ -111,6 +111,12 @@ class FixedJointComponents : public Components {
         /// Swap two components in the array
         virtual void swapComponents(uint32 index1, uint32 index2) override;
 
+        /// Write the simulation state of the components into a world snapshot
+        virtual void takeStateSnapshot(BinaryWriter& writer) const override;
+
+        /// Restore the simulation state of the components from a world snapshot
+        virtual bool restoreStateSnapshot(BinaryReader& reader) override;
+
     public:
 
         /// Structure for the data of a transform component
@@ -159,6 +159,12 @@ class RigidBodyComponents : public Components {
         /// For each body, the vector of lock rotation vectors
         Vector3* mAngularLockAxisFactors;
 
+        /// For each body, the scale of the margin of the fat AABBs of its colliders in the broad-phase
+        decimal* mFatAABBMarginScales;
+
+        /// For each body, the number of steps since the last update of the fat AABBs of its colliders
+        uint32* mNbStepsSinceFatAABBUpdate;
+
         // -------------------- Methods -------------------- //
 
         /// Allocate memory for a given number of components
@@ -173,6 +179,12 @@ class RigidBodyComponents : public Components {
         /// Swap two components in the array
         virtual void swapComponents(uint32 index1, uint32 index2) override;
 
+        /// Write the simulation state of the components into a world snapshot
+        virtual void takeStateSnapshot(BinaryWriter& writer) const override;
+
+        /// Restore the simulation state of the components from a world snapshot
+        virtual bool restoreStateSnapshot(BinaryReader& reader) override;
+
     public:
 
         /// Structure for the data of a rigid body component
@@ -383,6 +395,7 @@ class RigidBodyComponents : public Components {
         // -------------------- Friendship -------------------- //
 
         friend class PhysicsWorld;
+        friend class BodyStateSnapshot;
         friend class ContactSolverSystem;
         friend class CollisionDetectionSystem;
         friend class SolveBallAndSocketJointSystem;
@@ -390,6 +403,7 @@ class RigidBodyComponents : public Components {
         friend class SolveHingeJointSystem;
         friend class SolveSliderJointSystem;
         friend class DynamicsSystem;
+        friend class BroadPhaseSystem;
         friend class BallAndSocketJoint;
         friend class FixedJoint;
         friend class HingeJoint;
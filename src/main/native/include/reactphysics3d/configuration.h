@@ -70,6 +70,19 @@
     #define RP3D_FORCE_INLINE inline
 #endif
 
+// The deterministic build relies on strict IEEE floating-point arithmetic. It must be compiled
+// without floating-point contraction (-ffp-contract=off with GCC and Clang) and without fast-math.
+#if defined(IS_RP3D_DETERMINISTIC_ENABLED) && defined(__FAST_MATH__)
+    #error "The deterministic build of ReactPhysics3D cannot be compiled with fast-math"
+#endif
+
+// Maximum level of the log messages compiled into the library (see Logger::Level): 4 keeps all
+// the messages, 2 keeps the warnings and errors, 1 keeps the errors and 0 removes all the logs.
+// The messages above this level are removed at compile time with the code that builds them.
+#ifndef RP3D_MAX_LOG_LEVEL
+    #define RP3D_MAX_LOG_LEVEL 4
+#endif
+
 /// Namespace reactphysics3d
 namespace reactphysics3d {
 
@@ -130,6 +143,19 @@ constexpr decimal PI_TIMES_2 = decimal(6.28318530);
 /// without triggering a large modification of the tree each frame which can be costly
 constexpr decimal DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE = decimal(0.08);
 
+/// With the predictive fat AABBs, the fat AABBs of a body cover its predicted displacement during a
+/// number of steps equal to its margin scale. This scale is kept between those two values
+constexpr decimal PREDICTIVE_FAT_AABB_MIN_MARGIN_SCALE = decimal(0.5);
+constexpr decimal PREDICTIVE_FAT_AABB_MAX_MARGIN_SCALE = decimal(8.0);
+
+/// With the predictive fat AABBs, the margin scale of a body is doubled when its fat AABBs need to be
+/// updated again less than this number of steps after the last update
+constexpr uint32 PREDICTIVE_FAT_AABB_GROW_NB_STEPS = 4;
+
+/// With the predictive fat AABBs, the margin scale of a body is halved when its fat AABBs have not been
+/// updated for this number of steps
+constexpr uint32 PREDICTIVE_FAT_AABB_SHRINK_NB_STEPS = 60;
+
 /// Maximum number of contact points in a narrow phase info object
 constexpr uint8 NB_MAX_CONTACT_POINTS_IN_NARROWPHASE_INFO = 16;
 
@@ -148,6 +174,10 @@ constexpr decimal SAME_CONTACT_POINT_DISTANCE_THRESHOLD = decimal(0.01);
 /// Global alignment (in bytes) that all allocators must enforce
 constexpr uint8 GLOBAL_ALIGNMENT = 16;
 
+/// Bits mask with all the 64 collision categories (default collide-with mask of the colliders and
+/// default category mask of the world queries)
+constexpr uint64 ALL_COLLISION_CATEGORIES = ~uint64(0);
+
 /// Current version of ReactPhysics3D
 const std::string RP3D_VERSION = std::string("0.10.2");
 
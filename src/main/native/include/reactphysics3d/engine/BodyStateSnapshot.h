@@ -0,0 +1,167 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_BODY_STATE_SNAPSHOT_H
+#define REACTPHYSICS3D_BODY_STATE_SNAPSHOT_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/engine/Entity.h>
+#include <reactphysics3d/mathematics/Transform.h>
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/containers/Map.h>
+
+namespace reactphysics3d {
+
+// Declarations
+class MemoryAllocator;
+class TransformComponents;
+class RigidBodyComponents;
+
+// Class BodyStateSnapshot
+/**
+ * This class contains an immutable copy of the transforms and velocities of all the bodies of a
+ * physics world at the end of a step. It is filled by the asynchronous update of the world
+ * (see PhysicsWorld::updateAsync()) and can be read while the next step is running on the
+ * worker thread. The bodies that are not rigid bodies have zero velocities.
+ */
+class BodyStateSnapshot {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Entity of each body
+        Array<Entity> mBodiesEntities;
+
+        /// Transform of each body
+        Array<Transform> mTransforms;
+
+        /// Linear velocity of each body
+        Array<Vector3> mLinearVelocities;
+
+        /// Angular velocity of each body
+        Array<Vector3> mAngularVelocities;
+
+        /// Map a body entity to its index in the arrays
+        Map<Entity, uint32> mMapEntityToIndex;
+
+        /// Number of steps of the world when the snapshot was taken
+        uint64 mStepIndex;
+
+        // -------------------- Methods -------------------- //
+
+        /// Copy the state of the bodies from the components of a world
+        void update(const TransformComponents& transformComponents, const RigidBodyComponents& rigidBodyComponents,
+                    uint64 stepIndex);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BodyStateSnapshot(MemoryAllocator& allocator);
+
+        /// Return the number of bodies
+        uint32 getNbBodies() const;
+
+        /// Return the index of a body in the snapshot (false if the body is not in the snapshot)
+        bool getBodyIndex(Entity bodyEntity, uint32& outIndex) const;
+
+        /// Return the entity of the body at a given index
+        Entity getBodyEntity(uint32 index) const;
+
+        /// Return the transform of the body at a given index
+        const Transform& getTransform(uint32 index) const;
+
+        /// Return the linear velocity of the body at a given index
+        const Vector3& getLinearVelocity(uint32 index) const;
+
+        /// Return the angular velocity of the body at a given index
+        const Vector3& getAngularVelocity(uint32 index) const;
+
+        /// Return the number of steps of the world when the snapshot was taken
+        uint64 getStepIndex() const;
+
+        // -------------------- Friendship -------------------- //
+
+        friend class PhysicsWorld;
+};
+
+// Return the number of bodies
+RP3D_FORCE_INLINE uint32 BodyStateSnapshot::getNbBodies() const {
+    return static_cast<uint32>(mBodiesEntities.size());
+}
+
+// Return the index of a body in the snapshot
+/**
+ * @param bodyEntity The entity of the body (see Body::getEntity())
+ * @param[out] outIndex The index of the body in the snapshot (0 if the body is not in the snapshot)
+ * @return True if the body is in the snapshot and false otherwise
+ */
+RP3D_FORCE_INLINE bool BodyStateSnapshot::getBodyIndex(Entity bodyEntity, uint32& outIndex) const {
+
+    outIndex = 0;
+
+    auto it = mMapEntityToIndex.find(bodyEntity);
+    if (it == mMapEntityToIndex.end()) return false;
+
+    outIndex = it->second;
+    return true;
+}
+
+// Return the entity of the body at a given index
+RP3D_FORCE_INLINE Entity BodyStateSnapshot::getBodyEntity(uint32 index) const {
+    assert(index < mBodiesEntities.size());
+    return mBodiesEntities[index];
+}
+
+// Return the transform of the body at a given index
+RP3D_FORCE_INLINE const Transform& BodyStateSnapshot::getTransform(uint32 index) const {
+    assert(index < mTransforms.size());
+    return mTransforms[index];
+}
+
+// Return the linear velocity of the body at a given index
+RP3D_FORCE_INLINE const Vector3& BodyStateSnapshot::getLinearVelocity(uint32 index) const {
+    assert(index < mLinearVelocities.size());
+    return mLinearVelocities[index];
+}
+
+// Return the angular velocity of the body at a given index
+RP3D_FORCE_INLINE const Vector3& BodyStateSnapshot::getAngularVelocity(uint32 index) const {
+    assert(index < mAngularVelocities.size());
+    return mAngularVelocities[index];
+}
+
+// Return the number of steps of the world when the snapshot was taken
+RP3D_FORCE_INLINE uint64 BodyStateSnapshot::getStepIndex() const {
+    return mStepIndex;
+}
+
+}
+
+#endif
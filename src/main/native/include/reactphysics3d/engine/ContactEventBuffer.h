@@ -0,0 +1,238 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_CONTACT_EVENT_BUFFER_H
+#define REACTPHYSICS3D_CONTACT_EVENT_BUFFER_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/engine/Entity.h>
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <reactphysics3d/containers/Array.h>
+
+namespace reactphysics3d {
+
+// Declarations
+class MemoryAllocator;
+
+// Structure ContactEvent
+/**
+ * This structure describes a pair of colliders (of two bodies) that started, kept or stopped
+ * touching during the last step of a physics world. It is a flat version of the data that is
+ * reported by the CollisionCallback::ContactPair objects.
+ */
+struct ContactEvent {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Entity of the first body
+    Entity body1Entity;
+
+    /// Entity of the second body
+    Entity body2Entity;
+
+    /// Entity of the first collider
+    Entity collider1Entity;
+
+    /// Entity of the second collider
+    Entity collider2Entity;
+
+    /// World-space contact normal (from the first to the second collider) of the first contact
+    /// point. This is the zero vector for an End event
+    Vector3 normal;
+
+    /// Average world-space contact point on the first collider. This is the zero vector
+    /// for an End event
+    Vector3 point;
+
+    /// Sum of the penetration impulses of the contact points (computed by the solver during the step)
+    decimal normalImpulse;
+
+    /// Sum of the friction impulses of the contact manifolds (computed by the solver during the step)
+    Vector3 frictionImpulse;
+
+    /// Number of contact points between the two colliders (zero for an End event)
+    uint32 nbContactPoints;
+
+    // -------------------- Methods -------------------- //
+
+    /// Constructor
+    ContactEvent(Entity body1Entity, Entity body2Entity, Entity collider1Entity, Entity collider2Entity)
+        : body1Entity(body1Entity), body2Entity(body2Entity), collider1Entity(collider1Entity),
+          collider2Entity(collider2Entity), normal(0, 0, 0), point(0, 0, 0), normalImpulse(0),
+          frictionImpulse(0, 0, 0), nbContactPoints(0) {
+
+    }
+};
+
+// Structure TriggerEvent
+/**
+ * This structure describes a pair of colliders (at least one of them being a trigger) that
+ * started, kept or stopped overlapping during the last step of a physics world.
+ */
+struct TriggerEvent {
+
+    // -------------------- Attributes -------------------- //
+
+    /// Entity of the first body
+    Entity body1Entity;
+
+    /// Entity of the second body
+    Entity body2Entity;
+
+    /// Entity of the first collider
+    Entity collider1Entity;
+
+    /// Entity of the second collider
+    Entity collider2Entity;
+
+    // -------------------- Methods -------------------- //
+
+    /// Constructor
+    TriggerEvent(Entity body1Entity, Entity body2Entity, Entity collider1Entity, Entity collider2Entity)
+        : body1Entity(body1Entity), body2Entity(body2Entity), collider1Entity(collider1Entity),
+          collider2Entity(collider2Entity) {
+
+    }
+};
+
+// Class ContactEventBuffer
+/**
+ * This class contains the contact and trigger events of the last step of a physics world in
+ * contiguous arrays (one array per type of event). It is an alternative to the EventListener
+ * callbacks that can be polled after PhysicsWorld::update(). The buffer is only filled if it has
+ * been enabled with PhysicsWorld::setIsContactEventBufferEnabled() and an event is only created
+ * for a pair of colliders if at least one of the two bodies has enabled its contact events with
+ * Body::setIsContactEventsEnabled(). The arrays are cleared at the beginning of each step.
+ */
+class ContactEventBuffer {
+
+    public:
+
+        /// Type of an event
+        enum class EventType {
+
+            /// The two colliders started touching (or overlapping) during the last step
+            Begin,
+
+            /// The two colliders were already touching (or overlapping) in the previous step
+            Stay,
+
+            /// The two colliders stopped touching (or overlapping) during the last step
+            End
+        };
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Contact events of the pairs that started touching
+        Array<ContactEvent> mBeginContactEvents;
+
+        /// Contact events of the pairs that are still touching
+        Array<ContactEvent> mStayContactEvents;
+
+        /// Contact events of the pairs that stopped touching
+        Array<ContactEvent> mEndContactEvents;
+
+        /// Trigger events of the pairs that started overlapping
+        Array<TriggerEvent> mBeginTriggerEvents;
+
+        /// Trigger events of the pairs that are still overlapping
+        Array<TriggerEvent> mStayTriggerEvents;
+
+        /// Trigger events of the pairs that stopped overlapping
+        Array<TriggerEvent> mEndTriggerEvents;
+
+        /// Index of the internal contact pair of each Begin contact event (used to collect the impulses)
+        Array<uint32> mBeginContactPairsIndices;
+
+        /// Index of the internal contact pair of each Stay contact event (used to collect the impulses)
+        Array<uint32> mStayContactPairsIndices;
+
+        // -------------------- Methods -------------------- //
+
+        /// Remove all the events
+        void clear();
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        ContactEventBuffer(MemoryAllocator& allocator);
+
+        /// Return the contact events of a given type
+        const Array<ContactEvent>& getContactEvents(EventType eventType) const;
+
+        /// Return the trigger events of a given type
+        const Array<TriggerEvent>& getTriggerEvents(EventType eventType) const;
+
+        /// Return the total number of contact and trigger events
+        uint32 getNbEvents() const;
+
+        // -------------------- Friendship -------------------- //
+
+        friend class CollisionDetectionSystem;
+        friend class PhysicsWorld;
+};
+
+// Return the contact events of a given type
+/**
+ * @param eventType The type of the events (Begin, Stay or End)
+ * @return A contiguous array with the contact events of this type in the last step
+ */
+RP3D_FORCE_INLINE const Array<ContactEvent>& ContactEventBuffer::getContactEvents(EventType eventType) const {
+
+    switch (eventType) {
+        case EventType::Begin: return mBeginContactEvents;
+        case EventType::Stay: return mStayContactEvents;
+        default: return mEndContactEvents;
+    }
+}
+
+// Return the trigger events of a given type
+/**
+ * @param eventType The type of the events (Begin, Stay or End)
+ * @return A contiguous array with the trigger events of this type in the last step
+ */
+RP3D_FORCE_INLINE const Array<TriggerEvent>& ContactEventBuffer::getTriggerEvents(EventType eventType) const {
+
+    switch (eventType) {
+        case EventType::Begin: return mBeginTriggerEvents;
+        case EventType::Stay: return mStayTriggerEvents;
+        default: return mEndTriggerEvents;
+    }
+}
+
+// Return the total number of contact and trigger events
+RP3D_FORCE_INLINE uint32 ContactEventBuffer::getNbEvents() const {
+    return static_cast<uint32>(mBeginContactEvents.size() + mStayContactEvents.size() + mEndContactEvents.size() +
+                               mBeginTriggerEvents.size() + mStayTriggerEvents.size() + mEndTriggerEvents.size());
+}
+
+}
+
+#endif
@@ -364,6 +364,26 @@ class OverlappingPairs {
         /// Remove a disabled concave overlapping pair
         void removeDisabledConcavePairWithIndex(uint64 pairIndex, bool removeFromColliders);
 
+        /// Destroy all the pairs without removing them from the colliders
+        void clearPairs();
+
+        /// Write the common attributes of a pair into a world snapshot
+        static void writePairSnapshot(BinaryWriter& writer, const OverlappingPair& pair);
+
+        /// Write an array of convex pairs into a world snapshot
+        static void writeConvexPairsSnapshot(BinaryWriter& writer, const Array<ConvexOverlappingPair>& pairs);
+
+        /// Write an array of concave pairs into a world snapshot
+        static void writeConcavePairsSnapshot(BinaryWriter& writer, const Array<ConcaveOverlappingPair>& pairs);
+
+        /// Read an array of convex pairs from a world snapshot
+        bool readConvexPairsSnapshot(BinaryReader& reader, Array<ConvexOverlappingPair>& pairs,
+                                     Map<uint64, uint64>& mapPairIdToPairIndex);
+
+        /// Read an array of concave pairs from a world snapshot
+        bool readConcavePairsSnapshot(BinaryReader& reader, Array<ConcaveOverlappingPair>& pairs,
+                                      Map<uint64, uint64>& mapPairIdToPairIndex);
+
     public:
 
         // -------------------- Methods -------------------- //
@@ -431,6 +451,12 @@ class OverlappingPairs {
         /// Return a reference to an overlapping pair
         OverlappingPair* getOverlappingPair(uint64 pairId);
 
+        /// Write the overlapping pairs and their last frame collision infos into a world snapshot
+        void takeSnapshot(BinaryWriter& writer) const;
+
+        /// Replace the overlapping pairs by the pairs of a world snapshot
+        bool restoreSnapshot(BinaryReader& reader);
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
         /// Set the profiler
@@ -39,6 +39,7 @@
 #include <reactphysics3d/collision/ConvexMesh.h>
 #include <reactphysics3d/collision/HeightField.h>
 #include <reactphysics3d/utils/DefaultLogger.h>
+#include <reactphysics3d/utils/AsyncLogger.h>
 #include <reactphysics3d/collision/PolygonVertexArray.h>
 #include <reactphysics3d/collision/VertexArray.h>
 
@@ -46,6 +47,8 @@
 namespace reactphysics3d {
 
 class VertexArray;
+class BinaryWriter;
+class BinaryReader;
 
 // Class PhysicsCommon
 /**
@@ -101,6 +104,9 @@ class PhysicsCommon {
         /// Set of default loggers
         Set<DefaultLogger*> mDefaultLoggers;
 
+        /// Set of asynchronous loggers
+        Set<AsyncLogger*> mAsyncLoggers;
+
         /// Half-edge structure of a box polyhedron
         HalfEdgeStructure mBoxShapeHalfEdgeStructure;
 
@@ -148,12 +154,21 @@ class PhysicsCommon {
         /// Delete a default logger
         void deleteDefaultLogger(DefaultLogger* logger);
 
+        /// Delete an asynchronous logger
+        void deleteAsyncLogger(AsyncLogger* logger);
+
         /// Initialize the half-edge structure of a BoxShape
         void initBoxShapeHalfEdgeStructure();
 
         /// Initialize the static half-edge structure of a TriangleShape
         void initTriangleShapeHalfEdgeStructure();
 
+        /// Write the header of cooked mesh data
+        static void writeCookedMeshHeader(BinaryWriter& writer, uint32 meshType);
+
+        /// Read and check the header of cooked mesh data
+        static bool readCookedMeshHeader(BinaryReader& reader, uint32 meshType, std::vector<Message>& messages);
+
 // If profiling is enabled
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -211,7 +226,12 @@ class PhysicsCommon {
         /// Create and return a height-field
         HeightField* createHeightField(int nbGridColumns, int nbGridRows, const void* heightFieldData,
                                        HeightField::HeightDataType dataType, std::vector<Message>& messages,
-                                       decimal integerHeightScale = 1.0f);
+                                       decimal integerHeightScale = 1.0f,
+                                       HeightField::HeightStorageType storageType = HeightField::HeightStorageType::COPY);
+
+        /// Create and return a height-field whose tiles are loaded lazily from a tiled height-field file
+        HeightField* createHeightField(const std::string& tiledFilePath, std::vector<Message>& messages,
+                                       size_t tileCacheMemoryBudget = HeightField::DEFAULT_TILE_CACHE_MEMORY_BUDGET);
 
         /// Create and return a height-field shape
         HeightFieldShape* createHeightFieldShape(HeightField* heightField,
@@ -232,11 +252,32 @@ class PhysicsCommon {
         /// Create a convex mesh from an array of vertices (automatically computing the convex hull using QuickHull)
         ConvexMesh* createConvexMesh(const VertexArray& vertexArray, std::vector<Message>& messages);
 
+        /// Create a convex mesh from cooked data (see cookConvexMesh())
+        ConvexMesh* createConvexMeshFromCookedData(const void* cookedData, size_t cookedDataSize,
+                                                   std::vector<Message>& messages);
+
+        /// Create a convex mesh from a file of cooked data that is memory-mapped during the loading
+        ConvexMesh* createConvexMeshFromCookedFile(const std::string& cookedFilePath, std::vector<Message>& messages);
+
+        /// Write the cooked data of a convex mesh into a byte buffer
+        void cookConvexMesh(const ConvexMesh* convexMesh, std::vector<uint8>& outCookedData) const;
+
         /// Destroy a convex mesh
         void destroyConvexMesh(ConvexMesh* convexMesh);
 
         /// Create a triangle mesh
-        TriangleMesh* createTriangleMesh(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages);
+        TriangleMesh* createTriangleMesh(const TriangleVertexArray& triangleVertexArray, std::vector<Message>& messages,
+                                         TriangleMesh::StorageType storageType = TriangleMesh::StorageType::COPY);
+
+        /// Create a triangle mesh from cooked data (see cookTriangleMesh())
+        TriangleMesh* createTriangleMeshFromCookedData(const void* cookedData, size_t cookedDataSize,
+                                                       std::vector<Message>& messages);
+
+        /// Create a triangle mesh from a file of cooked data that is memory-mapped during the loading
+        TriangleMesh* createTriangleMeshFromCookedFile(const std::string& cookedFilePath, std::vector<Message>& messages);
+
+        /// Write the cooked data of a triangle mesh into a byte buffer
+        void cookTriangleMesh(const TriangleMesh* triangleMesh, std::vector<uint8>& outCookedData) const;
 
         /// Destroy a triangle mesh
         void destroyTriangleMesh(TriangleMesh* triangleMesh);
@@ -250,6 +291,12 @@ class PhysicsCommon {
         /// Destroy a default logger
         void destroyDefaultLogger(DefaultLogger* logger);
 
+        /// Create and return a new asynchronous logger
+        AsyncLogger* createAsyncLogger(uint32 queueCapacity = AsyncLogger::DEFAULT_QUEUE_CAPACITY);
+
+        /// Destroy an asynchronous logger
+        void destroyAsyncLogger(AsyncLogger* logger);
+
         /// Return the current logger
         static Logger* getLogger();
 
@@ -281,7 +328,11 @@ RP3D_FORCE_INLINE void PhysicsCommon::setLogger(Logger* logger) {
 }
 
 // Use this macro to log something
-#define RP3D_LOG(physicsWorldName, level, category, message, filename, lineNumber) if (reactphysics3d::PhysicsCommon::getLogger() != nullptr) PhysicsCommon::getLogger()->log(level, physicsWorldName, category, message, filename, lineNumber)
+// The message is only built if its level is compiled in (see RP3D_MAX_LOG_LEVEL) and enabled in the current logger
+#define RP3D_LOG(physicsWorldName, level, category, message, filename, lineNumber) \
+    if (static_cast<int>(level) <= RP3D_MAX_LOG_LEVEL && reactphysics3d::PhysicsCommon::getLogger() != nullptr && \
+        reactphysics3d::PhysicsCommon::getLogger()->isLevelEnabled(level)) \
+        reactphysics3d::PhysicsCommon::getLogger()->log(level, physicsWorldName, category, message, filename, lineNumber)
 
 }
 
@@ -43,6 +43,9 @@
 #include <reactphysics3d/components/SliderJointComponents.h>
 #include <reactphysics3d/collision/CollisionCallback.h>
 #include <reactphysics3d/collision/OverlapCallback.h>
+#include <reactphysics3d/collision/ShapeCastInfo.h>
+#include <reactphysics3d/collision/DistanceInfo.h>
+#include <reactphysics3d/collision/CollisionPairFilter.h>
 #include <reactphysics3d/configuration.h>
 #include <reactphysics3d/utils/Logger.h>
 #include <reactphysics3d/systems/ConstraintSolverSystem.h>
@@ -50,8 +53,14 @@
 #include <reactphysics3d/systems/ContactSolverSystem.h>
 #include <reactphysics3d/systems/DynamicsSystem.h>
 #include <reactphysics3d/engine/Islands.h>
+#include <reactphysics3d/engine/StepStats.h>
+#include <reactphysics3d/engine/ContactEventBuffer.h>
+#include <reactphysics3d/engine/BodyStateSnapshot.h>
 #include <reactphysics3d/utils/DebugRenderer.h>
+#include <condition_variable>
+#include <mutex>
 #include <sstream>
+#include <thread>
 
 /// Namespace ReactPhysics3D
 namespace reactphysics3d {
@@ -119,6 +128,31 @@ class PhysicsWorld {
             /// than the value bellow, the manifold are considered to be similar.
             decimal cosAngleSimilarContactManifold;
 
+            /// True if the overlapping pairs and the contacts are processed in a stable order (sorted by ids)
+            /// that does not depend on the history of the broad-phase. Combined with the deterministic build
+            /// (IS_RP3D_DETERMINISTIC_ENABLED and no floating-point contraction), a given scene produces the
+            /// same results on all the supported platforms.
+            bool isDeterministic;
+
+            /// Method used to update the dynamic AABB trees of the broad-phase when the colliders move
+            /// out of their fat AABB (remove and reinsert the leaves or refit the trees in place)
+            DynamicAABBTreeUpdateMethod broadPhaseTreeUpdateMethod;
+
+            /// Maximum number of tree rotations each time the broad-phase trees are refitted (REFIT method only)
+            uint32 broadPhaseMaxNbTreeRotations;
+
+            /// Data structure used by the broad-phase for the colliders that are not in a compound body
+            BroadPhaseMethod broadPhaseMethod;
+
+            /// Size of the cells of the broad-phase grid (UNIFORM_GRID method only). The best size is
+            /// usually slightly larger than the size of most of the colliders.
+            decimal broadPhaseGridCellSize;
+
+            /// True if the fat AABBs of the broad-phase are extended along the predicted displacement of
+            /// the bodies (from their linear velocity) and if their margin is adapted to the movement
+            /// history of each body instead of being a constant percentage of the size of the colliders
+            bool isPredictiveFatAABBEnabled;
+
             WorldSettings() {
 
                 worldName = "";
@@ -134,6 +168,12 @@ class PhysicsWorld {
                 defaultSleepLinearVelocity = decimal(0.02);
                 defaultSleepAngularVelocity = decimal(3.0) * (PI_RP3D / decimal(180.0));
                 cosAngleSimilarContactManifold = decimal(0.95);
+                isDeterministic = false;
+                broadPhaseTreeUpdateMethod = DynamicAABBTreeUpdateMethod::REINSERT;
+                broadPhaseMaxNbTreeRotations = 1024;
+                broadPhaseMethod = BroadPhaseMethod::DYNAMIC_AABB_TREE;
+                broadPhaseGridCellSize = decimal(1.0);
+                isPredictiveFatAABBEnabled = false;
             }
 
             ~WorldSettings() = default;
@@ -156,6 +196,13 @@ class PhysicsWorld {
                 ss << "defaultSleepLinearVelocity=" << defaultSleepLinearVelocity << std::endl;
                 ss << "defaultSleepAngularVelocity=" << defaultSleepAngularVelocity << std::endl;
                 ss << "cosAngleSimilarContactManifold=" << cosAngleSimilarContactManifold << std::endl;
+                ss << "isDeterministic=" << isDeterministic << std::endl;
+                ss << "broadPhaseTreeUpdateMethod=" << (broadPhaseTreeUpdateMethod == DynamicAABBTreeUpdateMethod::REFIT ? "REFIT" : "REINSERT") << std::endl;
+                ss << "broadPhaseMaxNbTreeRotations=" << broadPhaseMaxNbTreeRotations << std::endl;
+                ss << "broadPhaseMethod=" << (broadPhaseMethod == BroadPhaseMethod::SWEEP_AND_PRUNE ? "SWEEP_AND_PRUNE" :
+                                              broadPhaseMethod == BroadPhaseMethod::UNIFORM_GRID ? "UNIFORM_GRID" : "DYNAMIC_AABB_TREE") << std::endl;
+                ss << "broadPhaseGridCellSize=" << broadPhaseGridCellSize << std::endl;
+                ss << "isPredictiveFatAABBEnabled=" << isPredictiveFatAABBEnabled << std::endl;
 
                 return ss.str();
             }
@@ -183,6 +230,9 @@ class PhysicsWorld {
         /// True if the gravity force is on
         bool mIsGravityEnabled;
 
+        /// Counters and timings of the last call of update()
+        StepStats mLastStepStats;
+
         /// Collision Body Components
         BodyComponents mBodyComponents;
 
@@ -219,6 +269,48 @@ class PhysicsWorld {
         /// Pointer to an event listener object
         EventListener* mEventListener;
 
+        /// True if the contact event buffer is filled at each step
+        bool mIsContactEventBufferEnabled;
+
+        /// Contact and trigger events of the last step (if the buffer is enabled)
+        ContactEventBuffer mContactEventBuffer;
+
+        /// Number of calls of update() since the creation of the world
+        uint64 mNbSteps;
+
+        /// First buffer of the state of the bodies for the asynchronous update
+        BodyStateSnapshot mBodyStateSnapshot1;
+
+        /// Second buffer of the state of the bodies for the asynchronous update
+        BodyStateSnapshot mBodyStateSnapshot2;
+
+        /// Snapshot of the last completed asynchronous step (read by the user)
+        BodyStateSnapshot* mFrontBodyStateSnapshot;
+
+        /// Snapshot filled by the worker thread at the end of the running asynchronous step
+        BodyStateSnapshot* mBackBodyStateSnapshot;
+
+        /// Worker thread of the asynchronous update (started at the first call of updateAsync())
+        std::thread mAsyncUpdateThread;
+
+        /// Mutex protecting the state shared with the worker thread
+        mutable std::mutex mAsyncUpdateMutex;
+
+        /// Condition variable to wake up the worker thread or the thread waiting for the step
+        std::condition_variable mAsyncUpdateCondition;
+
+        /// Time step of the pending asynchronous step
+        decimal mAsyncUpdateTimeStep;
+
+        /// True if the worker thread has a step to run or is running it
+        bool mIsAsyncUpdatePending;
+
+        /// True if the worker thread has to stop
+        bool mIsAsyncUpdateThreadStopping;
+
+        /// True if an asynchronous step has been started and waitForUpdate() has not been called yet
+        bool mIsAsyncUpdateInFlight;
+
         /// Name of the physics world
         std::string mName;
 
@@ -296,6 +388,12 @@ class PhysicsWorld {
         /// Put bodies to sleep if needed.
         void updateSleepingBodies(decimal timeStep);
 
+        /// Main loop of the worker thread of the asynchronous update
+        void runAsyncUpdateThread();
+
+        /// Stop the worker thread of the asynchronous update
+        void stopAsyncUpdateThread();
+
         /// Add the joint to the array of joints of the two bodies involved in the joint
         void addJointToBodies(Entity body1, Entity body2, Entity joint);
 
@@ -313,7 +411,33 @@ class PhysicsWorld {
         CollisionDispatch& getCollisionDispatch();
 
         /// Ray cast method
-        void raycast(const Ray& ray, RaycastCallback* raycastCallback, unsigned short raycastWithCategoryMaskBits = 0xFFFF) const;
+        void raycast(const Ray& ray, RaycastCallback* raycastCallback, uint64 raycastWithCategoryMaskBits = ALL_COLLISION_CATEGORIES) const;
+
+        /// Return true if a ray hits at least one collider
+        bool raycastAny(const Ray& ray, uint64 raycastWithCategoryMaskBits = ALL_COLLISION_CATEGORIES) const;
+
+        /// Compute the closest hit of a ray with the colliders
+        bool raycastClosest(const Ray& ray, RaycastInfo& outRaycastInfo, uint64 raycastWithCategoryMaskBits = ALL_COLLISION_CATEGORIES) const;
+
+        /// Shape cast method
+        bool shapeCast(const ConvexShape& shape, const Transform& transform, const Vector3& translation,
+                       ShapeCastInfo& outHit, uint64 shapeCastWithCategoryMaskBits = ALL_COLLISION_CATEGORIES) const;
+
+        /// Batched shape cast method
+        uint32 shapeCast(const ConvexShape& shape, const Array<ShapeCastQuery>& queries, Array<ShapeCastInfo>& outHits,
+                         uint64 shapeCastWithCategoryMaskBits = ALL_COLLISION_CATEGORIES) const;
+
+        /// Compute the distance and the closest points between a convex shape and a collider
+        bool computeDistance(const ConvexShape& shape, const Transform& transform, Collider* collider,
+                             DistanceInfo& outInfo, decimal maxDistance = DECIMAL_LARGEST) const;
+
+        /// Compute the distance and the closest points between a convex shape and the closest collider of the world
+        bool computeClosestCollider(const ConvexShape& shape, const Transform& transform, DistanceInfo& outInfo,
+                                    decimal maxDistance = DECIMAL_LARGEST, uint64 categoryMaskBits = ALL_COLLISION_CATEGORIES) const;
+
+        /// Batched version of computeClosestCollider() for several convex shapes
+        uint32 computeClosestColliders(const Array<DistanceQuery>& queries, Array<DistanceInfo>& outInfos,
+                                       uint64 categoryMaskBits = ALL_COLLISION_CATEGORIES) const;
 
         /// Return true if two bodies overlap (collide)
         bool testOverlap(Body* body1, Body* body2);
@@ -324,6 +448,30 @@ class PhysicsWorld {
         /// Report all the bodies that overlap (collide) in the world
         void testOverlap(OverlapCallback& overlapCallback);
 
+        /// Report the colliders whose AABB overlaps with a given AABB
+        void queryAABB(const AABB& aabb, Array<Collider*>& outColliders, uint64 categoryMaskBits = ALL_COLLISION_CATEGORIES,
+                       bool useExactAABB = false) const;
+
+        /// Report the bodies with a collider whose AABB overlaps with a given AABB
+        void queryAABB(const AABB& aabb, Array<Body*>& outBodies, uint64 categoryMaskBits = ALL_COLLISION_CATEGORIES,
+                       bool useExactAABB = false) const;
+
+        /// Report the colliders whose AABB overlaps with a given sphere
+        void querySphere(const Vector3& center, decimal radius, Array<Collider*>& outColliders,
+                         uint64 categoryMaskBits = ALL_COLLISION_CATEGORIES, bool useExactAABB = false) const;
+
+        /// Report the bodies with a collider whose AABB overlaps with a given sphere
+        void querySphere(const Vector3& center, decimal radius, Array<Body*>& outBodies,
+                         uint64 categoryMaskBits = ALL_COLLISION_CATEGORIES, bool useExactAABB = false) const;
+
+        /// Report the colliders whose AABB overlaps with a given frustum
+        void queryFrustum(const Frustum& frustum, Array<Collider*>& outColliders, uint64 categoryMaskBits = ALL_COLLISION_CATEGORIES,
+                          bool useExactAABB = false) const;
+
+        /// Report the bodies with a collider whose AABB overlaps with a given frustum
+        void queryFrustum(const Frustum& frustum, Array<Body*>& outBodies, uint64 categoryMaskBits = ALL_COLLISION_CATEGORIES,
+                          bool useExactAABB = false) const;
+
         /// Test collision and report contacts between two bodies.
         void testCollision(Body* body1, Body* body2, CollisionCallback& callback);
 
@@ -351,6 +499,31 @@ class PhysicsWorld {
         /// Update the physics simulation
         void update(decimal timeStep);
 
+        /// Start a step of the simulation on a worker thread. The methods of the event listener
+        /// of the world are called from the worker thread (not from the calling thread).
+        void updateAsync(decimal timeStep);
+
+        /// Wait for the end of the asynchronous step and publish its body state snapshot
+        void waitForUpdate();
+
+        /// Return true if an asynchronous step has been started and is not finished yet
+        bool isAsyncUpdateRunning() const;
+
+        /// Return the state of the bodies at the end of the last completed asynchronous step
+        const BodyStateSnapshot& getBodyStateSnapshot() const;
+
+        /// Return the number of calls of update() since the creation of the world
+        uint64 getNbSteps() const;
+
+        /// Write the simulation state of the world into a binary snapshot
+        void takeSnapshot(std::vector<uint8>& outSnapshot) const;
+
+        /// Restore the simulation state of the world from a binary snapshot
+        bool restoreSnapshot(const void* snapshot, size_t snapshotSize);
+
+        /// Return the counters and timings of the last call of update()
+        const StepStats& getLastStepStats() const;
+
         /// Get the number of iterations for the velocity constraint solver
         uint16 getNbIterationsVelocitySolver() const;
 
@@ -420,6 +593,12 @@ class PhysicsWorld {
         /// Set an event listener object to receive events callbacks.
         void setEventListener(EventListener* eventListener);
 
+        /// Set a filter object to reject pairs of colliders before the narrow-phase
+        void setCollisionPairFilter(CollisionPairFilter* collisionPairFilter);
+
+        /// Return the filter of the pairs of colliders (nullptr if there is none)
+        CollisionPairFilter* getCollisionPairFilter() const;
+
         /// Return the number of RigidBody in the physics world
         uint32 getNbRigidBodies() const;
 
@@ -438,6 +617,15 @@ class PhysicsWorld {
         /// Return a reference to the Debug Renderer of the world
         DebugRenderer& getDebugRenderer();
 
+        /// Return true if the contact event buffer is filled at each step
+        bool getIsContactEventBufferEnabled() const;
+
+        /// Set whether the contact event buffer is filled at each step
+        void setIsContactEventBufferEnabled(bool isEnabled);
+
+        /// Return the contact and trigger events of the last step
+        const ContactEventBuffer& getContactEventBuffer() const;
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
         /// Return a reference to the profiler
@@ -463,6 +651,8 @@ class PhysicsWorld {
         friend class CollisionCallback::CallbackData;
         friend class OverlapCallback::CallbackData;
         friend class DebugRenderer;
+        friend class DataLogRecorder;
+        friend class WorldQueryContext;
 };
 
 // Set the collision dispatch configuration
@@ -485,10 +675,118 @@ RP3D_FORCE_INLINE CollisionDispatch& PhysicsWorld::getCollisionDispatch() {
  */
 RP3D_FORCE_INLINE void PhysicsWorld::raycast(const Ray& ray,
                                     RaycastCallback* raycastCallback,
-                                    unsigned short raycastWithCategoryMaskBits) const {
+                                    uint64 raycastWithCategoryMaskBits) const {
     mCollisionDetection.raycast(raycastCallback, ray, raycastWithCategoryMaskBits);
 }
 
+// Return true if a ray hits at least one collider
+/// The raycasting stops at the first collider hit by the ray and the hit point and normal
+/// are not computed. This is faster than raycast() with a callback for visibility tests.
+/**
+ * @param ray Ray to use for raycasting
+ * @param raycastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                    bodies to be raycasted
+ * @return True if the ray hits at least one collider
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::raycastAny(const Ray& ray, uint64 raycastWithCategoryMaskBits) const {
+    return mCollisionDetection.raycastAny(ray, raycastWithCategoryMaskBits);
+}
+
+// Compute the closest hit of a ray with the colliders
+/// This gives the same hit as raycast() with a callback that always returns the hit fraction
+/// but without a virtual call for each collider hit by the ray.
+/**
+ * @param ray Ray to use for raycasting
+ * @param[out] outRaycastInfo Information about the closest hit (only valid if the method returns true)
+ * @param raycastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                    bodies to be raycasted
+ * @return True if the ray hits at least one collider
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::raycastClosest(const Ray& ray, RaycastInfo& outRaycastInfo,
+                                                    uint64 raycastWithCategoryMaskBits) const {
+    return mCollisionDetection.raycastClosest(ray, outRaycastInfo, raycastWithCategoryMaskBits);
+}
+
+// Shape cast method
+/// Move a convex shape along a translation (without rotation) and report the first collider
+/// that it hits. Return true if a collider has been hit. The shape stops at a small distance
+/// (GJK_TIME_OF_IMPACT_TOLERANCE) of the hit collider.
+/**
+ * @param shape Convex shape to cast
+ * @param transform Local-to-world transform of the shape at the start of the motion
+ * @param translation Translation of the shape in world-space
+ * @param[out] outHit Information about the first hit (hit fraction of 1 if nothing has been hit)
+ * @param shapeCastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                      colliders to be tested
+ * @return True if a collider has been hit
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::shapeCast(const ConvexShape& shape, const Transform& transform, const Vector3& translation,
+                                               ShapeCastInfo& outHit, uint64 shapeCastWithCategoryMaskBits) const {
+    return mCollisionDetection.shapeCast(shape, transform, translation, outHit, shapeCastWithCategoryMaskBits);
+}
+
+// Batched shape cast method
+/// Cast the same convex shape for each query in the array. The hit of the i-th query is
+/// written at index i in the output array. This is faster than several calls to shapeCast()
+/// because the temporary memory of the queries is only allocated once.
+/**
+ * @param shape Convex shape to cast
+ * @param queries Array with the start transform and the translation of each query
+ * @param[out] outHits Array with the first hit of each query
+ * @param shapeCastWithCategoryMaskBits Bits mask corresponding to the category of
+ *                                      colliders to be tested
+ * @return Number of queries that have hit a collider
+ */
+RP3D_FORCE_INLINE uint32 PhysicsWorld::shapeCast(const ConvexShape& shape, const Array<ShapeCastQuery>& queries, Array<ShapeCastInfo>& outHits,
+                                                 uint64 shapeCastWithCategoryMaskBits) const {
+    return mCollisionDetection.shapeCast(shape, queries, outHits, shapeCastWithCategoryMaskBits);
+}
+
+// Compute the distance and the closest points between a convex shape and a collider
+/// The shape does not need to be attached to a body. This can be used to model a distance
+/// sensor for instance.
+/**
+ * @param shape Convex shape of the query
+ * @param transform Local-to-world transform of the shape
+ * @param collider Pointer to a collider of the world
+ * @param[out] outInfo Distance and closest points between the shape and the collider
+ * @param maxDistance The collider is ignored if it is farther than this distance
+ * @return True if the distance between the shape and the collider is not larger than the maximum distance
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::computeDistance(const ConvexShape& shape, const Transform& transform, Collider* collider,
+                                                     DistanceInfo& outInfo, decimal maxDistance) const {
+    return mCollisionDetection.computeDistance(shape, transform, collider, outInfo, maxDistance);
+}
+
+// Compute the distance and the closest points between a convex shape and the closest collider of the world
+/**
+ * @param shape Convex shape of the query
+ * @param transform Local-to-world transform of the shape
+ * @param[out] outInfo Distance and closest points between the shape and the closest collider
+ * @param maxDistance Colliders farther than this distance are ignored
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be tested
+ * @return True if a collider has been found within the maximum distance
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::computeClosestCollider(const ConvexShape& shape, const Transform& transform, DistanceInfo& outInfo,
+                                                            decimal maxDistance, uint64 categoryMaskBits) const {
+    return mCollisionDetection.computeClosestCollider(shape, transform, outInfo, maxDistance, categoryMaskBits);
+}
+
+// Batched version of computeClosestCollider() for several convex shapes
+/// The result of the i-th query is written at index i in the output array. This is faster than
+/// several calls to computeClosestCollider() because the temporary memory of the queries is only
+/// allocated once.
+/**
+ * @param queries Array with the shape, the transform and the maximum distance of each query
+ * @param[out] outInfos Array with the closest collider of each query
+ * @param categoryMaskBits Bits mask corresponding to the category of colliders to be tested
+ * @return Number of queries that have found a collider within their maximum distance
+ */
+RP3D_FORCE_INLINE uint32 PhysicsWorld::computeClosestColliders(const Array<DistanceQuery>& queries, Array<DistanceInfo>& outInfos,
+                                                               uint64 categoryMaskBits) const {
+    return mCollisionDetection.computeClosestColliders(queries, outInfos, categoryMaskBits);
+}
+
 // Test collision and report contacts between two bodies.
 /// Use this method if you only want to get all the contacts between two bodies.
 /// All the contacts will be reported using the callback object in paramater.
@@ -664,6 +962,25 @@ RP3D_FORCE_INLINE void PhysicsWorld::setEventListener(EventListener* eventListen
     mEventListener = eventListener;
 }
 
+// Set a filter object to reject pairs of colliders before the narrow-phase
+/// The filter is called for each new pair of colliders that overlap in the broad-phase and that
+/// are accepted by the collision category and collide-with mask bits. A rejected pair never reaches
+/// the middle-phase and narrow-phase. If you use "nullptr" as an argument, the filter is disabled.
+/**
+ * @param collisionPairFilter Pointer to the filter object (the world does not take ownership of it)
+ */
+RP3D_FORCE_INLINE void PhysicsWorld::setCollisionPairFilter(CollisionPairFilter* collisionPairFilter) {
+    mCollisionDetection.mCollisionPairFilter = collisionPairFilter;
+}
+
+// Return the filter of the pairs of colliders
+/**
+ * @return Pointer to the filter of the pairs of colliders (nullptr if there is none)
+ */
+RP3D_FORCE_INLINE CollisionPairFilter* PhysicsWorld::getCollisionPairFilter() const {
+    return mCollisionDetection.mCollisionPairFilter;
+}
+
 // Return the number of RigidBody in the physics world
 /**
  * @return The number of rigid bodies in the physics world
@@ -696,6 +1013,66 @@ RP3D_FORCE_INLINE DebugRenderer& PhysicsWorld::getDebugRenderer() {
     return mDebugRenderer;
 }
 
+// Return true if the contact event buffer is filled at each step
+/**
+ * @return True if the contact event buffer is enabled and false otherwise
+ */
+RP3D_FORCE_INLINE bool PhysicsWorld::getIsContactEventBufferEnabled() const {
+    return mIsContactEventBufferEnabled;
+}
+
+// Set whether the contact event buffer is filled at each step
+/// Only the pairs of colliders where at least one body has enabled its contact events
+/// (see Body::setIsContactEventsEnabled()) are added to the buffer. The buffer is emptied
+/// when it is disabled.
+/**
+ * @param isEnabled True if you want to enable the contact event buffer and false otherwise
+ */
+RP3D_FORCE_INLINE void PhysicsWorld::setIsContactEventBufferEnabled(bool isEnabled) {
+    mIsContactEventBufferEnabled = isEnabled;
+    if (!isEnabled) {
+        mContactEventBuffer.clear();
+    }
+}
+
+// Return the contact and trigger events of the last step
+/// The buffer can be read after PhysicsWorld::update() instead of (or in addition to)
+/// receiving the EventListener callbacks.
+/**
+ * @return A reference to the contact event buffer of the world
+ */
+RP3D_FORCE_INLINE const ContactEventBuffer& PhysicsWorld::getContactEventBuffer() const {
+    return mContactEventBuffer;
+}
+
+// Return the state of the bodies at the end of the last completed asynchronous step
+/// The snapshot is published by waitForUpdate() and is not modified until the next call of
+/// waitForUpdate(). It can therefore be read while the next step is running on the worker thread.
+/**
+ * @return A reference to the immutable snapshot of the transforms and velocities of the bodies
+ */
+RP3D_FORCE_INLINE const BodyStateSnapshot& PhysicsWorld::getBodyStateSnapshot() const {
+    return *mFrontBodyStateSnapshot;
+}
+
+// Return the number of calls of update() since the creation of the world
+/**
+ * @return The number of steps of the world (synchronous and asynchronous)
+ */
+RP3D_FORCE_INLINE uint64 PhysicsWorld::getNbSteps() const {
+    return mNbSteps;
+}
+
+// Return the counters and timings of the last call of update()
+/// The statistics are always collected (the profiling does not need to be enabled). They are
+/// reset at the beginning of each call of update().
+/**
+ * @return A reference to the statistics of the last step of the world
+ */
+RP3D_FORCE_INLINE const StepStats& PhysicsWorld::getLastStepStats() const {
+    return mLastStepStats;
+}
+
 }
 
 #endif
@@ -0,0 +1,165 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_STEP_STATS_H
+#define REACTPHYSICS3D_STEP_STATS_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <chrono>
+#include <sstream>
+#include <string>
+
+namespace reactphysics3d {
+
+// Structure StepStats
+/**
+ * This structure contains the counters and the timings of a step of a physics world. It is
+ * filled during each call of PhysicsWorld::update() (whether profiling is enabled or not) and can
+ * be retrieved with PhysicsWorld::getLastStepStats(). The timings are measured with a steady clock
+ * around each phase of the step and are given in milliseconds.
+ */
+struct StepStats {
+
+    // -------------------- Counters -------------------- //
+
+    /// Number of overlapping pairs of colliders in the broad-phase
+    uint32 nbOverlappingPairs;
+
+    /// Number of narrow-phase tests (pairs of convex shapes or of convex shape and triangle)
+    uint32 nbNarrowPhaseTests;
+
+    /// Number of pairs of colliders in contact
+    uint32 nbContactPairs;
+
+    /// Number of contact manifolds
+    uint32 nbContactManifolds;
+
+    /// Number of contact points
+    uint32 nbContactPoints;
+
+    /// Number of islands
+    uint32 nbIslands;
+
+    /// Number of awake (enabled and not sleeping) dynamic and kinematic bodies
+    uint32 nbAwakeBodies;
+
+    /// Number of iterations of the velocity solver
+    uint32 nbVelocitySolverIterations;
+
+    /// Number of iterations of the position solver
+    uint32 nbPositionSolverIterations;
+
+    /// Number of colliders that have moved out of their fat AABB and whose fat AABB has been
+    /// updated in the broad-phase at the end of the step
+    uint32 nbBroadPhaseReinsertions;
+
+    // -------------------- Timings -------------------- //
+
+    /// Time of the broad-phase collision detection (in milliseconds)
+    double broadPhaseTime;
+
+    /// Time of the middle-phase collision detection (in milliseconds)
+    double middlePhaseTime;
+
+    /// Time of the narrow-phase collision detection (in milliseconds)
+    double narrowPhaseTime;
+
+    /// Time to create the islands (in milliseconds)
+    double islandsTime;
+
+    /// Time to solve the contacts and joints velocity and position constraints (in milliseconds)
+    double solveTime;
+
+    /// Time to integrate the velocities and positions of the bodies (in milliseconds)
+    double integrateTime;
+
+    /// Total time of the step (in milliseconds)
+    double totalTime;
+
+    // -------------------- Methods -------------------- //
+
+    /// Constructor
+    StepStats() {
+        reset();
+    }
+
+    /// Reset all the counters and timings to zero
+    void reset() {
+
+        nbOverlappingPairs = 0;
+        nbNarrowPhaseTests = 0;
+        nbContactPairs = 0;
+        nbContactManifolds = 0;
+        nbContactPoints = 0;
+        nbIslands = 0;
+        nbAwakeBodies = 0;
+        nbVelocitySolverIterations = 0;
+        nbPositionSolverIterations = 0;
+        nbBroadPhaseReinsertions = 0;
+        broadPhaseTime = 0.0;
+        middlePhaseTime = 0.0;
+        narrowPhaseTime = 0.0;
+        islandsTime = 0.0;
+        solveTime = 0.0;
+        integrateTime = 0.0;
+        totalTime = 0.0;
+    }
+
+    /// Return the time (in milliseconds) elapsed since a given time point
+    static double getElapsedTime(const std::chrono::steady_clock::time_point& startTime) {
+        return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - startTime).count();
+    }
+
+    /// Return a string with the step statistics
+    std::string to_string() const {
+
+        std::stringstream ss;
+
+        ss << "nbOverlappingPairs=" << nbOverlappingPairs << std::endl;
+        ss << "nbNarrowPhaseTests=" << nbNarrowPhaseTests << std::endl;
+        ss << "nbContactPairs=" << nbContactPairs << std::endl;
+        ss << "nbContactManifolds=" << nbContactManifolds << std::endl;
+        ss << "nbContactPoints=" << nbContactPoints << std::endl;
+        ss << "nbIslands=" << nbIslands << std::endl;
+        ss << "nbAwakeBodies=" << nbAwakeBodies << std::endl;
+        ss << "nbVelocitySolverIterations=" << nbVelocitySolverIterations << std::endl;
+        ss << "nbPositionSolverIterations=" << nbPositionSolverIterations << std::endl;
+        ss << "nbBroadPhaseReinsertions=" << nbBroadPhaseReinsertions << std::endl;
+        ss << "broadPhaseTime=" << broadPhaseTime << std::endl;
+        ss << "middlePhaseTime=" << middlePhaseTime << std::endl;
+        ss << "narrowPhaseTime=" << narrowPhaseTime << std::endl;
+        ss << "islandsTime=" << islandsTime << std::endl;
+        ss << "solveTime=" << solveTime << std::endl;
+        ss << "integrateTime=" << integrateTime << std::endl;
+        ss << "totalTime=" << totalTime << std::endl;
+
+        return ss.str();
+    }
+};
+
+}
+
+#endif
@@ -0,0 +1,124 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_WORLD_QUERY_CONTEXT_H
+#define REACTPHYSICS3D_WORLD_QUERY_CONTEXT_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/memory/HeapAllocator.h>
+#include <reactphysics3d/memory/PoolAllocator.h>
+#include <reactphysics3d/engine/OverlappingPairs.h>
+
+namespace reactphysics3d {
+
+// Declarations
+class PhysicsWorld;
+class Body;
+class Collider;
+class RaycastCallback;
+class OverlapCallback;
+class NarrowPhaseInput;
+struct Ray;
+struct ContactPair;
+
+// Class WorldQueryContext
+/**
+ * This class is used to run read-only queries (raycasts and overlap tests) on a physics world
+ * from several threads at the same time. Each thread must use its own context. A context has its
+ * own scratch allocators and only reads the broad-phase tree and the components of the world. It
+ * never updates the overlapping pairs of the world like the PhysicsWorld::raycast() and
+ * PhysicsWorld::testOverlap() methods do. Queries are only safe between two steps: the world must
+ * not be updated or modified (bodies, colliders, transforms, ...) while a query is running. The
+ * base allocator given to the PhysicsCommon (if any) must be thread-safe and the profiler must not
+ * be enabled.
+ */
+class WorldQueryContext {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Reference to the physics world
+        PhysicsWorld& mWorld;
+
+        /// Scratch heap allocator of the context
+        HeapAllocator mHeapAllocator;
+
+        /// Scratch pool allocator of the context
+        PoolAllocator mPoolAllocator;
+
+        // -------------------- Methods -------------------- //
+
+        /// Add the narrow-phase tests between the colliders of a body and the colliders overlapping
+        /// them in the broad-phase (only the colliders of otherBody if it is not null)
+        void computeMiddlePhase(Body* body, Body* otherBody, NarrowPhaseInput& narrowPhaseInput,
+                                Array<LastFrameCollisionInfo*>& lastFrameInfos,
+                                Array<OverlappingPairs::ConcaveOverlappingPair*>& concavePairs);
+
+        /// Release the temporary data created by the middle-phase of a query
+        void releaseMiddlePhaseData(Array<LastFrameCollisionInfo*>& lastFrameInfos,
+                                    Array<OverlappingPairs::ConcaveOverlappingPair*>& concavePairs);
+
+        /// Run the narrow-phase and fill the array with the overlapping pairs of colliders (if not null)
+        bool computeNarrowPhase(NarrowPhaseInput& narrowPhaseInput, Array<ContactPair>* overlapPairs);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        WorldQueryContext(PhysicsWorld& world);
+
+        /// Destructor
+        ~WorldQueryContext() = default;
+
+        /// Deleted copy-constructor
+        WorldQueryContext(const WorldQueryContext& context) = delete;
+
+        /// Deleted assignment operator
+        WorldQueryContext& operator=(const WorldQueryContext& context) = delete;
+
+        /// Return a reference to the physics world
+        PhysicsWorld& getWorld() const;
+
+        /// Ray cast method
+        void raycast(const Ray& ray, RaycastCallback* raycastCallback, uint64 raycastWithCategoryMaskBits = ALL_COLLISION_CATEGORIES);
+
+        /// Return true if two bodies overlap
+        bool testOverlap(Body* body1, Body* body2);
+
+        /// Report all the bodies that overlap with the body in parameter
+        void testOverlap(Body* body, OverlapCallback& overlapCallback);
+};
+
+// Return a reference to the physics world
+RP3D_FORCE_INLINE PhysicsWorld& WorldQueryContext::getWorld() const {
+    return mWorld;
+}
+
+}
+
+#endif
@@ -0,0 +1,139 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_FRUSTUM_H
+#define REACTPHYSICS3D_FRUSTUM_H
+
+// Libraries
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <reactphysics3d/mathematics/Transform.h>
+#include <cassert>
+#include <cmath>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Structure Frustum
+/**
+ * This structure represents a convex volume bounded by at most six planes (the view
+ * frustum of a camera for instance). Each plane is given by its unit normal pointing
+ * outside of the volume and its distance to the origin. A point p is inside the volume
+ * if normal.dot(p) <= distance for each plane. The planes are in world-space.
+ */
+struct Frustum {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Maximum number of planes of a frustum
+        static const uint32 MAX_NB_PLANES = 6;
+
+        // -------------------- Attributes -------------------- //
+
+        /// Outward unit normals of the planes
+        Vector3 planeNormals[MAX_NB_PLANES];
+
+        /// Distances of the planes to the origin
+        decimal planeDistances[MAX_NB_PLANES];
+
+        /// Number of planes
+        uint32 nbPlanes;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor of an empty frustum (without planes, it contains everything)
+        Frustum() : nbPlanes(0) {
+
+        }
+
+        /// Add a plane to the frustum
+        void addPlane(const Vector3& normal, decimal distance);
+
+        /// Return true if a point is inside the frustum
+        bool contains(const Vector3& point) const;
+
+        /// Create the view frustum of a perspective camera looking along its local -Z axis
+        static Frustum createPerspective(const Transform& cameraTransform, decimal fieldOfViewY, decimal aspectRatio,
+                                         decimal nearDistance, decimal farDistance);
+};
+
+// Add a plane to the frustum
+/**
+ * @param normal Unit normal of the plane pointing outside of the frustum
+ * @param distance Distance of the plane to the origin
+ */
+RP3D_FORCE_INLINE void Frustum::addPlane(const Vector3& normal, decimal distance) {
+    assert(nbPlanes < MAX_NB_PLANES);
+    planeNormals[nbPlanes] = normal;
+    planeDistances[nbPlanes] = distance;
+    nbPlanes++;
+}
+
+// Return true if a point is inside the frustum
+RP3D_FORCE_INLINE bool Frustum::contains(const Vector3& point) const {
+    for (uint32 i=0; i < nbPlanes; i++) {
+        if (planeNormals[i].dot(point) > planeDistances[i]) return false;
+    }
+    return true;
+}
+
+// Create the view frustum of a perspective camera looking along its local -Z axis
+/// The local +Y axis of the camera is its up direction.
+/**
+ * @param cameraTransform Local-to-world transform of the camera
+ * @param fieldOfViewY Vertical field of view (in radians)
+ * @param aspectRatio Width of the view divided by its height
+ * @param nearDistance Distance of the near plane
+ * @param farDistance Distance of the far plane
+ * @return The frustum in world-space
+ */
+RP3D_FORCE_INLINE Frustum Frustum::createPerspective(const Transform& cameraTransform, decimal fieldOfViewY, decimal aspectRatio,
+                                                     decimal nearDistance, decimal farDistance) {
+
+    assert(nearDistance >= decimal(0.0) && farDistance > nearDistance);
+
+    const decimal tanHalfY = std::tan(fieldOfViewY * decimal(0.5));
+    const decimal tanHalfX = tanHalfY * aspectRatio;
+
+    // Planes in the local-space of the camera
+    const Vector3 localNormals[MAX_NB_PLANES] = {Vector3(0, 0, 1), Vector3(0, 0, -1),
+                                                 Vector3(1, 0, tanHalfX).getUnit(), Vector3(-1, 0, tanHalfX).getUnit(),
+                                                 Vector3(0, 1, tanHalfY).getUnit(), Vector3(0, -1, tanHalfY).getUnit()};
+    const decimal localDistances[MAX_NB_PLANES] = {-nearDistance, farDistance, 0, 0, 0, 0};
+
+    // Transform the planes into world-space
+    Frustum frustum;
+    for (uint32 i=0; i < MAX_NB_PLANES; i++) {
+        const Vector3 normal = cameraTransform.getOrientation() * localNormals[i];
+        frustum.addPlane(normal, localDistances[i] + normal.dot(cameraTransform.getPosition()));
+    }
+
+    return frustum;
+}
+
+}
+
+#endif
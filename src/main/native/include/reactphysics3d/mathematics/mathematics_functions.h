@@ -432,6 +432,69 @@ RP3D_FORCE_INLINE uint64 pairNumbers(uint32 number1, uint32 number2) {
     return nb1 * nb1 + nb1 + nb2;
 }
 
+/// Return the arc tangent of a value in range [-tan(pi/8), tan(pi/8)]
+/// This only uses additions and multiplications in a fixed order (Taylor series) so that
+/// the result is the same on all the platforms (without floating-point contraction).
+RP3D_FORCE_INLINE decimal computePortableAtanReduced(decimal x) {
+
+    const decimal x2 = x * x;
+
+    // Horner evaluation of x * (1 - x^2/3 + x^4/5 - x^6/7 + ...)
+    decimal sum = decimal(0.0);
+    for (int n = 22; n >= 0; n--) {
+        const decimal term = decimal(1.0) / decimal(2 * n + 1);
+        sum = (n % 2 == 0 ? term : -term) + x2 * sum;
+    }
+
+    return x * sum;
+}
+
+/// Return the arc tangent of y/x in range [-pi, pi] with the same result on all the platforms
+RP3D_FORCE_INLINE decimal computePortableAtan2(decimal y, decimal x) {
+
+    const decimal absX = std::abs(x);
+    const decimal absY = std::abs(y);
+    if (absX == decimal(0.0) && absY == decimal(0.0)) return decimal(0.0);
+
+    // Reduce the argument to [0, 1] and then to [-tan(pi/8), tan(pi/8)]
+    const bool isSwapped = absY > absX;
+    const decimal t = isSwapped ? absX / absY : absY / absX;
+    const decimal PI = decimal(3.14159265358979323846);
+    const decimal TAN_PI_OVER_8 = decimal(0.41421356237309504880);
+    decimal angle = t > TAN_PI_OVER_8 ? PI / decimal(4.0) + computePortableAtanReduced((t - decimal(1.0)) / (t + decimal(1.0))) :
+                                        computePortableAtanReduced(t);
+
+    if (isSwapped) angle = PI / decimal(2.0) - angle;
+    if (x < decimal(0.0)) angle = PI - angle;
+    return y < decimal(0.0) ? -angle : angle;
+}
+
+/// Return the arc cosine of a value (clamped to [-1, 1]) with the same result on all the platforms
+RP3D_FORCE_INLINE decimal computePortableAcos(decimal x) {
+    x = clamp(x, decimal(-1.0), decimal(1.0));
+    return computePortableAtan2(std::sqrt((decimal(1.0) - x) * (decimal(1.0) + x)), x);
+}
+
+/// Return the arc tangent of y/x in range [-pi, pi]
+/// When the deterministic build is enabled, the result does not depend on the math library of the platform.
+RP3D_FORCE_INLINE decimal computeAtan2(decimal y, decimal x) {
+#ifdef IS_RP3D_DETERMINISTIC_ENABLED
+    return computePortableAtan2(y, x);
+#else
+    return std::atan2(y, x);
+#endif
+}
+
+/// Return the arc cosine of a value in range [0, pi]
+/// When the deterministic build is enabled, the result does not depend on the math library of the platform.
+RP3D_FORCE_INLINE decimal computeAcos(decimal x) {
+#ifdef IS_RP3D_DETERMINISTIC_ENABLED
+    return computePortableAcos(x);
+#else
+    return std::acos(x);
+#endif
+}
+
 
 }
 
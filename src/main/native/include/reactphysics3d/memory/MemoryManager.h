@@ -88,6 +88,9 @@ class MemoryManager {
         /// Release previously allocated memory.
         void release(AllocationType allocationType, void* pointer, size_t size);
 
+        /// Return the base memory allocator
+        MemoryAllocator& getBaseAllocator();
+
         /// Return the pool allocator
         PoolAllocator& getPoolAllocator();
 
@@ -129,6 +132,11 @@ RP3D_FORCE_INLINE void MemoryManager::release(AllocationType allocationType, voi
     }
 }
 
+// Return the base memory allocator
+RP3D_FORCE_INLINE MemoryAllocator& MemoryManager::getBaseAllocator() {
+   return *mBaseAllocator;
+}
+
 // Return the pool allocator
 RP3D_FORCE_INLINE PoolAllocator& MemoryManager::getPoolAllocator() {
    return mPoolAllocator;
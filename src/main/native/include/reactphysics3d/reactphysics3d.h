@@ -43,6 +43,9 @@
 #include <reactphysics3d/engine/PhysicsWorld.h>
 #include <reactphysics3d/engine/Material.h>
 #include <reactphysics3d/engine/EventListener.h>
+#include <reactphysics3d/engine/ContactEventBuffer.h>
+#include <reactphysics3d/engine/BodyStateSnapshot.h>
+#include <reactphysics3d/engine/WorldQueryContext.h>
 #include <reactphysics3d/collision/shapes/CollisionShape.h>
 #include <reactphysics3d/collision/shapes/BoxShape.h>
 #include <reactphysics3d/collision/shapes/SphereShape.h>
@@ -54,6 +57,8 @@
 #include <reactphysics3d/collision/shapes/AABB.h>
 #include <reactphysics3d/collision/Collider.h>
 #include <reactphysics3d/collision/RaycastInfo.h>
+#include <reactphysics3d/collision/ShapeCastInfo.h>
+#include <reactphysics3d/collision/DistanceInfo.h>
 #include <reactphysics3d/collision/TriangleMesh.h>
 #include <reactphysics3d/collision/ConvexMesh.h>
 #include <reactphysics3d/collision/HeightField.h>
@@ -62,12 +67,17 @@
 #include <reactphysics3d/collision/VertexArray.h>
 #include <reactphysics3d/collision/CollisionCallback.h>
 #include <reactphysics3d/collision/OverlapCallback.h>
+#include <reactphysics3d/collision/CollisionPairFilter.h>
 #include <reactphysics3d/constraint/BallAndSocketJoint.h>
 #include <reactphysics3d/constraint/SliderJoint.h>
 #include <reactphysics3d/constraint/HingeJoint.h>
 #include <reactphysics3d/constraint/FixedJoint.h>
 #include <reactphysics3d/containers/Array.h>
 #include <reactphysics3d/utils/Message.h>
+#include <reactphysics3d/utils/TraceRecorder.h>
+#include <reactphysics3d/utils/AsyncLogger.h>
+#include <reactphysics3d/utils/DataLogRecorder.h>
+#include <reactphysics3d/utils/BinaryLogDecoder.h>
 
 /// Alias to the ReactPhysics3D namespace
 namespace rp3d = reactphysics3d;
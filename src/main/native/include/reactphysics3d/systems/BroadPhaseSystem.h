@@ -28,8 +28,10 @@
 
 // Libraries
 #include <reactphysics3d/collision/broadphase/DynamicAABBTree.h>
+#include <reactphysics3d/collision/broadphase/BroadPhaseBackend.h>
 #include <reactphysics3d/containers/LinkedList.h>
 #include <reactphysics3d/containers/Set.h>
+#include <reactphysics3d/containers/Map.h>
 #include <reactphysics3d/components/ColliderComponents.h>
 #include <reactphysics3d/components/TransformComponents.h>
 #include <reactphysics3d/components/RigidBodyComponents.h>
@@ -45,6 +47,7 @@ class Body;
 class Collider;
 class MemoryManager;
 class Profiler;
+struct RaycastInfo;
 
 // class AABBOverlapCallback
 /**
@@ -67,56 +70,103 @@ class AABBOverlapCallback : public DynamicAABBTreeOverlapCallback {
 
 };
 
-// Class BroadPhaseRaycastCallback
+// Class BroadPhaseSystem
 /**
- * Callback called when the AABB of a leaf node is hit by a ray the
- * broad-phase Dynamic AABB Tree.
+ * This class represents the broad-phase collision detection. The
+ * goal of the broad-phase collision detection is to compute the pairs of colliders
+ * that have their AABBs overlapping. Only those pairs of bodies will be tested
+ * later for collision during the narrow-phase collision detection. A dynamic AABB
+ * tree data structure is used for fast broad-phase collision detection. Another
+ * data structure (a BroadPhaseBackend) can be selected with setBroadPhaseMethod().
+ * The colliders of a compound body are not inserted in this tree. The body is
+ * represented by a single node of a second tree (the compounds tree) and its
+ * colliders are stored in a small tree owned by the body. The broad-phase ids
+ * of those colliders start at COMPOUND_BROAD_PHASE_ID_OFFSET.
  */
-class BroadPhaseRaycastCallback : public DynamicAABBTreeRaycastCallback {
+class BroadPhaseSystem {
 
-    private :
+    public :
 
-        const DynamicAABBTree& mDynamicAABBTree;
+        // -------------------- Constants -------------------- //
 
-        unsigned short mRaycastWithCategoryMaskBits;
+        /// First broad-phase id of the colliders of the compound bodies
+        static constexpr int32 COMPOUND_BROAD_PHASE_ID_OFFSET = 1 << 24;
 
-        RaycastTest& mRaycastTest;
+    protected :
 
-    public:
+        // -------------------- Structures -------------------- //
 
-        // Constructor
-        BroadPhaseRaycastCallback(const DynamicAABBTree& dynamicAABBTree, unsigned short raycastWithCategoryMaskBits,
-                                  RaycastTest& raycastTest)
-            : mDynamicAABBTree(dynamicAABBTree), mRaycastWithCategoryMaskBits(raycastWithCategoryMaskBits),
-              mRaycastTest(raycastTest) {
+        /// Broad-phase node of a compound body
+        struct CompoundProxy {
 
-        }
+            /// Entity of the body
+            Entity bodyEntity;
 
-        // Destructor
-        virtual ~BroadPhaseRaycastCallback() override = default;
+            /// Id of the node of the body in the compounds tree
+            int32 nodeId;
 
-        // Called for a broad-phase shape that has to be tested for raycast
-        virtual decimal raycastBroadPhaseShape(int32 nodeId, const Ray& ray) override;
+            /// Tree with the fat AABBs of the colliders of the body (the data of a leaf is
+            /// the broad-phase id of the collider)
+            DynamicAABBTree collidersTree;
 
-};
+            /// Constructor
+            CompoundProxy(Entity bodyEntity, MemoryAllocator& allocator)
+                : bodyEntity(bodyEntity), nodeId(-1), collidersTree(allocator, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE) {
 
-// Class BroadPhaseSystem
-/**
- * This class represents the broad-phase collision detection. The
- * goal of the broad-phase collision detection is to compute the pairs of colliders
- * that have their AABBs overlapping. Only those pairs of bodies will be tested
- * later for collision during the narrow-phase collision detection. A dynamic AABB
- * tree data structure is used for fast broad-phase collision detection.
- */
-class BroadPhaseSystem {
+            }
+        };
 
-    protected :
+        /// Collider of a compound body
+        struct CompoundCollider {
+
+            /// Pointer to the collider (null if this slot is free)
+            Collider* collider;
+
+            /// Compound body of the collider
+            CompoundProxy* proxy;
+
+            /// Id of the node of the collider in the tree of the compound body
+            int32 nodeId;
+        };
 
         // -------------------- Attributes -------------------- //
 
         /// Dynamic AABB tree
         DynamicAABBTree mDynamicAABBTree;
 
+        /// Broad-phase backend used instead of the dynamic AABB tree for the colliders that
+        /// are not in a compound body (null if the dynamic AABB tree is used)
+        BroadPhaseBackend* mBackend;
+
+        /// Dynamic AABB tree with a node for each compound body (the data of a
+        /// leaf is a pointer to the CompoundProxy of the body)
+        DynamicAABBTree mCompoundsTree;
+
+        /// Map a body entity to its compound proxy
+        Map<Entity, CompoundProxy*> mCompoundProxies;
+
+        /// Colliders of the compound bodies (indexed by broad-phase id - COMPOUND_BROAD_PHASE_ID_OFFSET)
+        Array<CompoundCollider> mCompoundColliders;
+
+        /// Indices of the free slots of the mCompoundColliders array
+        Array<uint32> mFreeCompoundColliders;
+
+        /// Method used to update the dynamic AABB trees when the colliders move out of their fat AABB
+        DynamicAABBTreeUpdateMethod mTreeUpdateMethod;
+
+        /// Maximum number of rotations per tree each time the trees are refitted (REFIT method only)
+        uint32 mMaxNbTreeRotations;
+
+        /// True if the fat AABBs are extended along the predicted displacement of the bodies and
+        /// if their margin is adapted to the movement history of each body
+        bool mIsPredictiveFatAABBEnabled;
+
+        /// Time step of the last call to updateColliders() (used to predict the displacement of the bodies)
+        decimal mTimeStep;
+
+        /// Number of colliders whose fat AABB has been updated since the last call to updateColliders()
+        uint32 mNbReinsertions;
+
         /// Reference to the colliders components
         ColliderComponents& mCollidersComponents;
 
@@ -142,12 +192,41 @@ class BroadPhaseSystem {
 #endif
         // -------------------- Methods -------------------- //
 
+        /// Destroy the broad-phase backend (if any)
+        void destroyBackend();
+
         /// Notify the Dynamic AABB tree that a collider needs to be updated
-        void updateColliderInternal(int32 broadPhaseId, Collider* collider, const AABB& aabb,
-                                    bool forceReInsert);
+        bool updateColliderInternal(int32 broadPhaseId, Collider* collider, const AABB& aabb,
+                                    const AABB& fatAABB, bool forceReInsert);
+
+        /// Notify the tree of a compound body that a collider needs to be updated
+        bool updateCompoundColliderInternal(int32 broadPhaseId, Collider* collider, const AABB& aabb,
+                                            const AABB& fatAABB, bool forceReInsert);
+
+        /// Compute the fat AABB of a collider from its AABB, a margin scale and a predicted displacement
+        static AABB computeFatAABB(const AABB& aabb, decimal marginScale, const Vector3& displacement);
+
+        /// Add a collider of a compound body into the broad-phase
+        void addCompoundCollider(Collider* collider, const AABB& aabb);
+
+        /// Remove a collider of a compound body from the broad-phase
+        void removeCompoundCollider(Collider* collider);
 
         /// Update the broad-phase state of some colliders components
-        void updateCollidersComponents(uint32 startIndex, uint32 nbItems);
+        void updateCollidersComponents(uint32 startIndex, uint32 nbItems, bool adaptMargins);
+
+        /// Update the number of steps since the last fat AABB update and the margin scale of the awake bodies
+        void updateFatAABBMarginScales();
+
+        /// Call a function with the broad-phase id of each collider of the compound bodies whose fat AABB is accepted by a volume test
+        template<typename VolumeTest, typename ColliderFunction>
+        void reportCompoundCollidersOverlappingWithVolume(const VolumeTest& volumeTest, ColliderFunction& colliderFunction,
+                                                          MemoryAllocator& allocator, const CompoundProxy* ignoredProxy = nullptr) const;
+
+        /// Report the colliders whose AABB is accepted by a volume test
+        template<typename VolumeTest>
+        void reportCollidersOverlappingWithVolume(const VolumeTest& volumeTest, uint64 categoryMaskBits, bool useExactAABB,
+                                                  Array<Collider*>& outColliders, MemoryAllocator& allocator) const;
 
     public :
 
@@ -158,7 +237,7 @@ class BroadPhaseSystem {
                          TransformComponents& transformComponents, RigidBodyComponents& rigidBodyComponents);
 
         /// Destructor
-        ~BroadPhaseSystem() = default;
+        ~BroadPhaseSystem();
 
         /// Deleted copy-constructor
         BroadPhaseSystem(const BroadPhaseSystem& algorithm) = delete;
@@ -175,8 +254,29 @@ class BroadPhaseSystem {
         /// Update the broad-phase state of a single collider
         void updateCollider(Entity colliderEntity);
 
-        /// Update the broad-phase state of all the enabled colliders
-        void updateColliders();
+        /// Update the broad-phase state of all the enabled colliders at the end of a step
+        void updateColliders(decimal timeStep);
+
+        /// Return the number of colliders whose fat AABB has been updated during the last call to updateColliders()
+        uint32 getNbReinsertions() const;
+
+        /// Enable or disable the predictive fat AABBs
+        void setIsPredictiveFatAABBEnabled(bool isEnabled);
+
+        /// Return true if the predictive fat AABBs are enabled
+        bool isPredictiveFatAABBEnabled() const;
+
+        /// Set the method used to update the dynamic AABB trees when the colliders move
+        void setTreeUpdateMethod(DynamicAABBTreeUpdateMethod method, uint32 maxNbRotations);
+
+        /// Return the method used to update the dynamic AABB trees when the colliders move
+        DynamicAABBTreeUpdateMethod getTreeUpdateMethod() const;
+
+        /// Set the data structure used for the colliders that are not in a compound body
+        void setBroadPhaseMethod(BroadPhaseMethod method, decimal gridCellSize);
+
+        /// Return the data structure used for the colliders that are not in a compound body
+        BroadPhaseMethod getBroadPhaseMethod() const;
 
         /// Add a collider in the array of colliders that have moved in the last simulation step
         /// and that need to be tested again for broad-phase overlapping.
@@ -198,8 +298,47 @@ class BroadPhaseSystem {
         /// Return the fat AABB of a given broad-phase shape
         const AABB& getFatAABB(int broadPhaseId) const;
 
+        /// Return true if the broad-phase id is the id of a collider of a compound body
+        static bool isCompoundBroadPhaseId(int broadPhaseId);
+
         /// Ray casting method
-        void raycast(const Ray& ray, RaycastTest& raycastTest, unsigned short raycastWithCategoryMaskBits) const;
+        void raycast(const Ray& ray, RaycastTest& raycastTest, uint64 raycastWithCategoryMaskBits) const;
+
+        /// Ray casting method that reports the colliders whose fat AABB is hit by the ray to a function
+        template<typename ColliderFunction>
+        void raycastColliders(const Ray& ray, ColliderFunction& colliderFunction, MemoryAllocator& allocator) const;
+
+        /// Return true if a ray hits at least one collider
+        bool raycastAny(const Ray& ray, uint64 raycastWithCategoryMaskBits, MemoryAllocator& allocator) const;
+
+        /// Compute the closest hit of a ray with the colliders
+        bool raycastClosest(const Ray& ray, uint64 raycastWithCategoryMaskBits, RaycastInfo& outRaycastInfo,
+                            MemoryAllocator& allocator) const;
+
+        /// Report the broad-phase ids of all the colliders whose fat AABB overlaps with a given AABB
+        void reportAllShapesOverlappingWithAABB(const AABB& aabb, Array<int32>& overlappingNodes, MemoryAllocator& allocator) const;
+
+        /// Report the broad-phase ids of the colliders whose fat AABB is within a shrinking distance of a given AABB
+        void reportShapesWithinDistance(const AABB& aabb, decimal maxDistance, DynamicAABBTreeDistanceCallback& callback,
+                                        MemoryAllocator& allocator) const;
+
+        /// Report the colliders whose AABB overlaps with a given AABB
+        void reportCollidersOverlappingWithAABB(const AABB& aabb, uint64 categoryMaskBits, bool useExactAABB,
+                                                Array<Collider*>& outColliders, MemoryAllocator& allocator) const;
+
+        /// Report the colliders whose AABB overlaps with a given sphere
+        void reportCollidersOverlappingWithSphere(const Vector3& center, decimal radius, uint64 categoryMaskBits, bool useExactAABB,
+                                                  Array<Collider*>& outColliders, MemoryAllocator& allocator) const;
+
+        /// Report the colliders whose AABB overlaps with a given frustum
+        void reportCollidersOverlappingWithFrustum(const Frustum& frustum, uint64 categoryMaskBits, bool useExactAABB,
+                                                   Array<Collider*>& outColliders, MemoryAllocator& allocator) const;
+
+        /// Write the dynamic AABB tree and the moved shapes into a world snapshot
+        void takeSnapshot(BinaryWriter& writer) const;
+
+        /// Restore the dynamic AABB tree and the moved shapes from a world snapshot
+        bool restoreSnapshot(BinaryReader& reader);
 
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -210,8 +349,59 @@ class BroadPhaseSystem {
 
 };
 
+// Return true if the broad-phase id is the id of a collider of a compound body
+RP3D_FORCE_INLINE bool BroadPhaseSystem::isCompoundBroadPhaseId(int broadPhaseId) {
+    return broadPhaseId >= COMPOUND_BROAD_PHASE_ID_OFFSET;
+}
+
+// Set the method used to update the dynamic AABB trees when the colliders move
+/**
+ * @param method The update method of the trees
+ * @param maxNbRotations Maximum number of rotations per tree each time the trees are refitted (REFIT method only)
+ */
+RP3D_FORCE_INLINE void BroadPhaseSystem::setTreeUpdateMethod(DynamicAABBTreeUpdateMethod method, uint32 maxNbRotations) {
+    mTreeUpdateMethod = method;
+    mMaxNbTreeRotations = maxNbRotations;
+}
+
+// Return the method used to update the dynamic AABB trees when the colliders move
+RP3D_FORCE_INLINE DynamicAABBTreeUpdateMethod BroadPhaseSystem::getTreeUpdateMethod() const {
+    return mTreeUpdateMethod;
+}
+
+// Return the number of colliders whose fat AABB has been updated during the last call to updateColliders()
+RP3D_FORCE_INLINE uint32 BroadPhaseSystem::getNbReinsertions() const {
+    return mNbReinsertions;
+}
+
+// Enable or disable the predictive fat AABBs
+/// The new fat AABBs are only used for the colliders that move out of their current fat AABB.
+RP3D_FORCE_INLINE void BroadPhaseSystem::setIsPredictiveFatAABBEnabled(bool isEnabled) {
+    mIsPredictiveFatAABBEnabled = isEnabled;
+}
+
+// Return true if the predictive fat AABBs are enabled
+RP3D_FORCE_INLINE bool BroadPhaseSystem::isPredictiveFatAABBEnabled() const {
+    return mIsPredictiveFatAABBEnabled;
+}
+
+// Return the data structure used for the colliders that are not in a compound body
+RP3D_FORCE_INLINE BroadPhaseMethod BroadPhaseSystem::getBroadPhaseMethod() const {
+    return mBackend != nullptr ? mBackend->getMethod() : BroadPhaseMethod::DYNAMIC_AABB_TREE;
+}
+
 // Return the fat AABB of a given broad-phase shape
 RP3D_FORCE_INLINE const AABB& BroadPhaseSystem::getFatAABB(int broadPhaseId) const  {
+
+    if (isCompoundBroadPhaseId(broadPhaseId)) {
+        const CompoundCollider& compoundCollider = mCompoundColliders[broadPhaseId - COMPOUND_BROAD_PHASE_ID_OFFSET];
+        return compoundCollider.proxy->collidersTree.getFatAABB(compoundCollider.nodeId);
+    }
+
+    if (mBackend != nullptr) {
+        return mBackend->getFatAABB(broadPhaseId);
+    }
+
     return mDynamicAABBTree.getFatAABB(broadPhaseId);
 }
 
@@ -225,15 +415,88 @@ RP3D_FORCE_INLINE void BroadPhaseSystem::removeMovedCollider(int broadPhaseID) {
 
 // Return the collider corresponding to the broad-phase node id in parameter
 RP3D_FORCE_INLINE Collider* BroadPhaseSystem::getColliderForBroadPhaseId(int broadPhaseId) const {
+
+    if (isCompoundBroadPhaseId(broadPhaseId)) {
+        return mCompoundColliders[broadPhaseId - COMPOUND_BROAD_PHASE_ID_OFFSET].collider;
+    }
+
+    if (mBackend != nullptr) {
+        return mBackend->getCollider(broadPhaseId);
+    }
+
     return static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(broadPhaseId));
 }
 
+// Ray casting method that reports the colliders whose fat AABB is hit by the ray to a function
+/// The function is called as colliderFunction(collider, ray) and follows the same protocol as
+/// DynamicAABBTree::raycastWithLeafFunction(). The colliders of the compound bodies are visited
+/// after the other colliders with the ray clipped by the previous hits.
+template<typename ColliderFunction>
+void BroadPhaseSystem::raycastColliders(const Ray& ray, ColliderFunction& colliderFunction, MemoryAllocator& allocator) const {
+
+    decimal maxFraction = ray.maxFraction;
+    bool isStopped = false;
+
+    // Call the function and keep track of the hit fraction for the other trees
+    auto raycastCollider = [&](Collider* collider, const Ray& clippedRay) {
+
+        const decimal hitFraction = colliderFunction(collider, clippedRay);
+        if (hitFraction == decimal(0.0)) {
+            isStopped = true;
+        }
+        else if (hitFraction > decimal(0.0) && hitFraction < maxFraction) {
+            maxFraction = hitFraction;
+        }
+
+        return hitFraction;
+    };
+
+    if (mBackend != nullptr) {
+
+        auto raycastProxy = [&](int32 proxyId, const Ray& clippedRay) {
+            return raycastCollider(mBackend->getCollider(proxyId), clippedRay);
+        };
+
+        mBackend->raycastWithLeafFunction(ray, raycastProxy);
+    }
+    else {
+
+        auto raycastLeaf = [&](int32 nodeId, const Ray& clippedRay) {
+            return raycastCollider(static_cast<Collider*>(mDynamicAABBTree.getNodeDataPointer(nodeId)), clippedRay);
+        };
+
+        mDynamicAABBTree.raycastWithLeafFunction(ray, raycastLeaf, allocator);
+    }
+
+    if (isStopped || mCompoundsTree.isEmpty()) return;
+
+    // Raycast the tree of each compound body hit by the ray
+    auto raycastCompound = [&](int32 nodeId, const Ray& clippedRay) {
+
+        const CompoundProxy* proxy = static_cast<const CompoundProxy*>(mCompoundsTree.getNodeDataPointer(nodeId));
+
+        auto raycastCompoundLeaf = [&](int32 colliderNodeId, const Ray& colliderClippedRay) {
+            return raycastCollider(getColliderForBroadPhaseId(proxy->collidersTree.getNodeDataInt(colliderNodeId)), colliderClippedRay);
+        };
+
+        proxy->collidersTree.raycastWithLeafFunction(clippedRay, raycastCompoundLeaf, allocator);
+
+        return isStopped ? decimal(0.0) : maxFraction;
+    };
+
+    mCompoundsTree.raycastWithLeafFunction(Ray(ray.point1, ray.point2, maxFraction), raycastCompound, allocator);
+}
+
 #ifdef IS_RP3D_PROFILING_ENABLED
 
 // Set the profiler
 RP3D_FORCE_INLINE void BroadPhaseSystem::setProfiler(Profiler* profiler) {
 	mProfiler = profiler;
 	mDynamicAABBTree.setProfiler(profiler);
+	mCompoundsTree.setProfiler(profiler);
+	if (mBackend != nullptr) {
+		mBackend->setProfiler(profiler);
+	}
 }
 
 #endif
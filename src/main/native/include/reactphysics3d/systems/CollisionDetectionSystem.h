@@ -44,6 +44,7 @@
 #include <reactphysics3d/components/ColliderComponents.h>
 #include <reactphysics3d/components/TransformComponents.h>
 #include <reactphysics3d/collision/HalfEdgeStructure.h>
+#include <reactphysics3d/engine/StepStats.h>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -56,7 +57,64 @@ class RaycastCallback;
 class ContactPoint;
 class MemoryManager;
 class EventListener;
+class CollisionPairFilter;
 class CollisionDispatch;
+class ContactEventBuffer;
+class ConvexShape;
+class TriangleShapeBatch;
+struct ShapeCastQuery;
+struct ShapeCastInfo;
+struct DistanceQuery;
+struct DistanceInfo;
+class GJKAlgorithm;
+
+// Class ClosestColliderCallback
+/**
+ * Callback called when the fat AABB of a collider is within the search distance
+ * of a closest collider query in the broad-phase Dynamic AABB Tree.
+ */
+class ClosestColliderCallback : public DynamicAABBTreeDistanceCallback {
+
+    private :
+
+        const CollisionDetectionSystem& mCollisionDetection;
+
+        const ConvexShape& mShape;
+
+        const Transform& mTransform;
+
+        uint64 mCategoryMaskBits;
+
+        const GJKAlgorithm& mGJKAlgorithm;
+
+        TriangleShapeBatch& mTriangleShapeBatch;
+
+        DistanceInfo& mClosestInfo;
+
+        bool mIsColliderFound;
+
+    public:
+
+        // Constructor
+        ClosestColliderCallback(const CollisionDetectionSystem& collisionDetection, const ConvexShape& shape, const Transform& transform,
+                                uint64 categoryMaskBits, const GJKAlgorithm& gjkAlgorithm, TriangleShapeBatch& triangleShapeBatch,
+                                DistanceInfo& closestInfo)
+            : mCollisionDetection(collisionDetection), mShape(shape), mTransform(transform), mCategoryMaskBits(categoryMaskBits),
+              mGJKAlgorithm(gjkAlgorithm), mTriangleShapeBatch(triangleShapeBatch), mClosestInfo(closestInfo), mIsColliderFound(false) {
+
+        }
+
+        // Destructor
+        virtual ~ClosestColliderCallback() override = default;
+
+        // Return true if a collider has been found within the maximum distance
+        bool isColliderFound() const {
+            return mIsColliderFound;
+        }
+
+        // Called for a broad-phase shape whose distance to the query shape has to be computed
+        virtual decimal notifyNodeWithinDistance(int32 nodeId, decimal maxDistance) override;
+};
 
 // Class CollisionDetectionSystem
 /**
@@ -96,6 +154,9 @@ class CollisionDetectionSystem {
         /// Set of pair of bodies that cannot collide between each other
         Set<bodypair> mNoCollisionPairs;
 
+        /// Pointer to the user filter of the new overlapping pairs (nullptr if there is no filter)
+        CollisionPairFilter* mCollisionPairFilter;
+
         /// Broad-phase overlapping pairs
         OverlappingPairs mOverlappingPairs;
 
@@ -169,9 +230,6 @@ class CollisionDetectionSystem {
         /// Reference to the half-edge structure of the triangle polyhedron
         HalfEdgeStructure& mTriangleHalfEdgeStructure;
 
-        /// Allocated size for a triangle shape
-        static const size_t mTriangleShapeAllocatedSize;
-
 #ifdef IS_RP3D_PROFILING_ENABLED
 
     /// Pointer to the profiler
@@ -255,6 +313,20 @@ class CollisionDetectionSystem {
         /// Create the actual contact manifolds and contacts points (from potential contacts) for a given contact pair
         void createContacts();
 
+        /// Sort the overlapping broad-phase nodes by node ids (deterministic mode)
+        void sortOverlappingNodes(Array<Pair<int32, int32>>& overlappingNodes);
+
+        /// Sort the contact pairs by overlapping pair id (deterministic mode)
+        void sortContactPairs(Array<ContactPair>* contactPairs);
+
+        /// Write an array of contacts of the current frame into a world snapshot
+        template<typename T>
+        static void writeContactsSnapshot(BinaryWriter& writer, const Array<T>& contacts);
+
+        /// Read an array of contacts of the current frame from a world snapshot
+        template<typename T>
+        static bool readContactsSnapshot(BinaryReader& reader, Array<T>& contacts);
+
         /// Add the contact pairs to the corresponding bodies
         void addContactPairsToBodies();
 
@@ -287,6 +359,13 @@ class CollisionDetectionSystem {
         /// Report all contacts for debug rendering
         void reportDebugRenderingContacts(Array<ContactPair>* contactPairs, Array<ContactManifold>* manifolds, Array<ContactPoint>* contactPoints, Array<ContactPair>& lostContactPairs);
 
+        /// Fill in the contact event buffer with the contact pairs of the bodies that have enabled their contact events
+        void fillContactEventBuffer(ContactEventBuffer& buffer, Array<ContactPair>* contactPairs, Array<ContactPoint>* contactPoints,
+                                    Array<ContactPair>& lostContactPairs);
+
+        /// Return true if one of the two bodies of a pair has enabled its contact events
+        bool isContactEventsEnabled(Entity body1Entity, Entity body2Entity) const;
+
         /// Return the largest depth of all the contact points of a potential manifold
         decimal computePotentialManifoldLargestContactDepth(const ContactManifoldInfo& manifold,
                                                             const Array<ContactPointInfo>& potentialContactPoints) const;
@@ -306,6 +385,20 @@ class CollisionDetectionSystem {
         /// Remove the duplicated contact points in a given contact manifold
         void removeDuplicatedContactPointsInManifold(ContactManifoldInfo& manifold, const Array<ContactPointInfo>& potentialContactPoints) const;
 
+        /// Compute the distance between a convex shape and a collider if it is not larger than a maximum distance
+        bool computeColliderDistance(const ConvexShape& shape, const Transform& transform, Collider* collider, decimal maxDistance,
+                                     const GJKAlgorithm& gjkAlgorithm, TriangleShapeBatch& triangleShapeBatch, DistanceInfo& outInfo) const;
+
+        /// Compute the closest collider of the world to a convex shape
+        bool computeClosestCollider(const ConvexShape& shape, const Transform& transform, decimal maxDistance,
+                                    uint64 categoryMaskBits, const GJKAlgorithm& gjkAlgorithm,
+                                    TriangleShapeBatch& triangleShapeBatch, DistanceInfo& outInfo) const;
+
+        /// Compute the first hit of a convex shape moving along a translation
+        bool computeShapeCast(const ConvexShape& shape, const Transform& transform, const Vector3& translation,
+                              uint64 shapeCastWithCategoryMaskBits, Array<int32>& overlappingNodes,
+                              TriangleShapeBatch& triangleShapeBatch, ShapeCastInfo& outHit) const;
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -337,7 +430,7 @@ class CollisionDetectionSystem {
         void updateCollider(Entity colliderEntity);
 
         /// Update all the enabled colliders
-        void updateColliders();
+        void updateColliders(decimal timeStep);
 
         /// Add a pair of bodies that cannot collide with each other
         void addNoCollisionPair(Entity body1Entity, Entity body2Entity);
@@ -354,12 +447,41 @@ class CollisionDetectionSystem {
         /// Report contacts and triggers
         void reportContactsAndTriggers();
 
+        /// Collect the impulses computed by the contact solver into the contact events of the buffer
+        void updateContactEventBufferImpulses(ContactEventBuffer& buffer) const;
+
         /// Compute the collision detection
-        void computeCollisionDetection();
+        void computeCollisionDetection(StepStats& stepStats);
 
         /// Ray casting method
         void raycast(RaycastCallback* raycastCallback, const Ray& ray,
-                     unsigned short raycastWithCategoryMaskBits) const;
+                     uint64 raycastWithCategoryMaskBits) const;
+
+        /// Return true if a ray hits at least one collider
+        bool raycastAny(const Ray& ray, uint64 raycastWithCategoryMaskBits) const;
+
+        /// Compute the closest hit of a ray with the colliders
+        bool raycastClosest(const Ray& ray, RaycastInfo& outRaycastInfo, uint64 raycastWithCategoryMaskBits) const;
+
+        /// Cast a convex shape along a translation and return true if it hits a collider
+        bool shapeCast(const ConvexShape& shape, const Transform& transform, const Vector3& translation,
+                       ShapeCastInfo& outHit, uint64 shapeCastWithCategoryMaskBits) const;
+
+        /// Cast a convex shape along several translations and return the number of hits
+        uint32 shapeCast(const ConvexShape& shape, const Array<ShapeCastQuery>& queries, Array<ShapeCastInfo>& outHits,
+                         uint64 shapeCastWithCategoryMaskBits) const;
+
+        /// Compute the distance and the closest points between a convex shape and a collider
+        bool computeDistance(const ConvexShape& shape, const Transform& transform, Collider* collider,
+                             DistanceInfo& outInfo, decimal maxDistance) const;
+
+        /// Compute the distance and the closest points between a convex shape and the closest collider of the world
+        bool computeClosestCollider(const ConvexShape& shape, const Transform& transform, DistanceInfo& outInfo,
+                                    decimal maxDistance, uint64 categoryMaskBits) const;
+
+        /// Compute the closest collider of the world for several convex shapes and return the number of colliders found
+        uint32 computeClosestColliders(const Array<DistanceQuery>& queries, Array<DistanceInfo>& outInfos,
+                                       uint64 categoryMaskBits) const;
 
         /// Return true if two bodies (collide) overlap
         bool testOverlap(Body* body1, Body* body2);
@@ -379,6 +501,12 @@ class CollisionDetectionSystem {
         /// Test collision and report contacts between each colliding bodies in the world
         void testCollision(CollisionCallback& callback);
 
+        /// Write the broad-phase, the overlapping pairs and the contacts of the current frame into a world snapshot
+        void takeSnapshot(BinaryWriter& writer) const;
+
+        /// Restore the broad-phase, the overlapping pairs and the contacts of the current frame from a world snapshot
+        bool restoreSnapshot(BinaryReader& reader);
+
         /// Return a reference to the memory manager
         MemoryManager& getMemoryManager() const;
 
@@ -404,6 +532,8 @@ class CollisionDetectionSystem {
         friend class ConvexMeshShape;
         friend class RigidBody;
         friend class DebugRenderer;
+        friend class WorldQueryContext;
+        friend class ClosestColliderCallback;
 };
 
 // Return a reference to the collision dispatch configuration
@@ -458,8 +588,8 @@ RP3D_FORCE_INLINE void CollisionDetectionSystem::updateCollider(Entity colliderE
 }
 
 // Update all the enabled colliders
-RP3D_FORCE_INLINE void CollisionDetectionSystem::updateColliders() {
-    mBroadPhaseSystem.updateColliders();
+RP3D_FORCE_INLINE void CollisionDetectionSystem::updateColliders(decimal timeStep) {
+    mBroadPhaseSystem.updateColliders(timeStep);
 }
 
 #ifdef IS_RP3D_PROFILING_ENABLED
@@ -0,0 +1,282 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_ASYNC_LOGGER_H
+#define REACTPHYSICS3D_ASYNC_LOGGER_H
+
+// Libraries
+#include <reactphysics3d/utils/Logger.h>
+#include <reactphysics3d/utils/BinaryLogDecoder.h>
+#include <reactphysics3d/containers/Array.h>
+#include <reactphysics3d/containers/Map.h>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <fstream>
+#include <mutex>
+#include <string>
+#include <thread>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class AsyncLogger
+/**
+ * This class is a logger that does not write the messages on the thread that logs them. The
+ * messages are copied into a lock-free bounded queue (multiple producers and a single consumer)
+ * and a background writer thread formats them and writes them to the destinations. A destination
+ * can be a compact binary log (see BinaryLogDecoder) or text lines. Logging never blocks: if the
+ * queue is full, the message is dropped and the number of dropped messages is written in the logs.
+ * The destinations should be added before the logger is used.
+ */
+class AsyncLogger : public Logger {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Default number of slots of the queue
+        static constexpr uint32 DEFAULT_QUEUE_CAPACITY = 4096;
+
+        /// Minimum number of slots of the queue
+        static constexpr uint32 MIN_QUEUE_CAPACITY = 64;
+
+    private:
+
+        // -------------------- Constants -------------------- //
+
+        /// Number of bytes of data in a slot of the queue
+        static constexpr uint32 SLOT_DATA_SIZE = 56;
+
+        /// Maximum number of bytes of a physics world name in a message
+        static constexpr uint32 MAX_WORLD_NAME_SIZE = 255;
+
+        // -------------------- Types -------------------- //
+
+        // Structure Slot
+        /**
+         * Slot of the queue. A message is copied into one or more consecutive slots.
+         */
+        struct Slot {
+
+            /// Sequence number of the slot: equal to the position of the slot in the queue when
+            /// the slot is free and to the position plus one when the data of the slot is ready
+            std::atomic<uint64> sequence;
+
+            /// Data of the slot
+            unsigned char data[SLOT_DATA_SIZE];
+        };
+
+        // Structure MessageHeader
+        /**
+         * Header of a message in the queue (followed by the world name and the message text)
+         */
+        struct MessageHeader {
+
+            /// Time of the message since the start of the logger (in nanoseconds)
+            uint64 time;
+
+            /// Source file of the message
+            const char* filename;
+
+            /// Line of the message in the source file
+            int32 lineNumber;
+
+            /// Number of bytes of the message text
+            uint32 messageSize;
+
+            /// Number of bytes of the world name
+            uint16 worldNameSize;
+
+            /// Level of the message
+            uint8 level;
+
+            /// Category of the message
+            uint8 category;
+        };
+
+        // Structure Destination
+        /**
+         * Destination of the logs (only used by the writer thread)
+         */
+        struct Destination {
+
+            /// Output stream
+            std::ostream* stream;
+
+            /// Output file stream (if the destination is a file)
+            std::ofstream* fileStream;
+
+            /// True if the logs are written in the binary format
+            bool isBinary;
+
+            /// Maximum level flag of the messages written in this destination
+            uint maxLevelFlag;
+
+            /// Index of the strings already defined in the binary log
+            Map<std::string, uint32> stringIndices;
+
+            /// Time of the previous message written in the binary log
+            uint64 previousTime;
+
+            /// Constructor
+            Destination(MemoryAllocator& allocator, std::ostream* stream, std::ofstream* fileStream, bool isBinary,
+                        uint maxLevelFlag)
+                : stream(stream), fileStream(fileStream), isBinary(isBinary), maxLevelFlag(maxLevelFlag),
+                  stringIndices(allocator), previousTime(0) {
+
+            }
+        };
+
+        // -------------------- Attributes -------------------- //
+
+        /// Memory allocator
+        MemoryAllocator& mAllocator;
+
+        /// Slots of the queue
+        Slot* mSlots;
+
+        /// Number of slots of the queue (power of two)
+        const uint32 mCapacity;
+
+        /// Next position to write in the queue (shared by the producers)
+        std::atomic<uint64> mEnqueuePosition;
+
+        /// Padding to keep the positions of the producers and of the writer thread on different cache lines
+        unsigned char mPadding[64];
+
+        /// Next position to read in the queue (advanced by the writer thread)
+        std::atomic<uint64> mDequeuePosition;
+
+        /// Number of messages dropped since the last report
+        std::atomic<uint64> mNbDroppedMessages;
+
+        /// Steady time of the start of the logger
+        const std::chrono::steady_clock::time_point mStartTime;
+
+        /// System time of the start of the logger (in microseconds since the epoch)
+        const uint64 mStartSystemTime;
+
+        /// Destinations of the logs
+        Array<Destination*> mDestinations;
+
+        /// Mutex protecting the destinations
+        std::mutex mDestinationsMutex;
+
+        /// Mutex used to wake up the writer thread
+        std::mutex mWakeUpMutex;
+
+        /// Condition variable used to wake up the writer thread
+        std::condition_variable mWakeUpCondition;
+
+        /// True when the writer thread must stop
+        std::atomic<bool> mIsStopping;
+
+        /// Writer thread
+        std::thread mWriterThread;
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        AsyncLogger(MemoryAllocator& allocator, uint32 queueCapacity);
+
+        /// Destructor
+        virtual ~AsyncLogger() override;
+
+        /// Add a destination
+        void addDestination(std::ostream* stream, std::ofstream* fileStream, bool isBinary, uint logLevelFlag);
+
+        /// Update the maximum level flag of the logged messages from the destinations
+        void updateMaxLevelFlag();
+
+        /// Copy bytes into the slots of the queue from a given position and offset
+        void writeToSlots(uint64 position, uint32 offset, const void* data, uint32 size);
+
+        /// Copy bytes from the slots of the queue from a given position and offset
+        void readFromSlots(uint64 position, uint32 offset, void* data, uint32 size) const;
+
+        /// Main loop of the writer thread
+        void runWriterThread();
+
+        /// Write all the ready messages of the queue. Return true if a message has been written.
+        bool writeReadyMessages();
+
+        /// Write the number of messages dropped since the last report (the destinations must be locked)
+        void writeDroppedMessages();
+
+        /// Delete all the destinations (the destinations must be locked)
+        void deleteDestinations();
+
+        /// Write a record into a destination
+        void writeRecord(Destination& destination, const BinaryLogDecoder::Record& record, const char* filename);
+
+        /// Return the index of a string of a binary destination (the string is defined if needed)
+        uint32 getStringIndex(Destination& destination, const std::string& string);
+
+    public :
+
+        // -------------------- Methods -------------------- //
+
+        /// Deleted copy-constructor
+        AsyncLogger(const AsyncLogger& logger) = delete;
+
+        /// Deleted assignment operator
+        AsyncLogger& operator=(const AsyncLogger& logger) = delete;
+
+        /// Add a file destination in the binary format
+        bool addBinaryFileDestination(const std::string& filePath, uint logLevelFlag);
+
+        /// Add a stream destination in the binary format
+        void addBinaryStreamDestination(std::ostream& outputStream, uint logLevelFlag);
+
+        /// Add a stream destination with a text line per message
+        void addTextStreamDestination(std::ostream& outputStream, uint logLevelFlag);
+
+        /// Remove all the destinations (the messages still in the queue are written before)
+        void removeAllDestinations();
+
+        /// Wait until all the messages logged before this call are written and flush the destinations
+        void flush();
+
+        /// Return the number of slots of the queue
+        uint32 getQueueCapacity() const;
+
+        /// Log something (copy the message into the queue)
+        virtual void log(Level level, const std::string& physicsWorldName, Category category, const std::string& message,
+                         const char* filename, int lineNumber) override;
+
+        // ---------- Friendship ---------- //
+
+        friend class PhysicsCommon;
+};
+
+// Return the number of slots of the queue
+RP3D_FORCE_INLINE uint32 AsyncLogger::getQueueCapacity() const {
+    return mCapacity;
+}
+
+}
+
+#endif
@@ -0,0 +1,115 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_BINARY_LOG_DECODER_H
+#define REACTPHYSICS3D_BINARY_LOG_DECODER_H
+
+// Libraries
+#include <reactphysics3d/utils/Logger.h>
+#include <reactphysics3d/utils/Message.h>
+#include <functional>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class BinaryLogDecoder
+/**
+ * This class decodes the binary logs written by the AsyncLogger. A binary log starts with a
+ * header (the "RP3DLOG" magic, the version of the format and the system time of the start of
+ * the logger in microseconds since the epoch) followed by records of three kinds:
+ *  - string records that define the strings (world names and filenames) referenced by an index
+ *  - message records with the time since the previous message (in nanoseconds), the level, the
+ *    category, the indices of the world name and filename strings, the line number and the text
+ *  - dropped records with the number of messages dropped because the queue of the logger was full
+ * The integers of the records are encoded as variable-length integers (7 bits per byte).
+ */
+class BinaryLogDecoder {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Magic bytes at the beginning of a binary log
+        static constexpr char MAGIC[8] = {'R', 'P', '3', 'D', 'L', 'O', 'G', '\0'};
+
+        /// Version of the binary log format
+        static constexpr uint32 FORMAT_VERSION = 1;
+
+        /// Kinds of records
+        static constexpr uint8 STRING_RECORD = 1;
+        static constexpr uint8 MESSAGE_RECORD = 2;
+        static constexpr uint8 DROPPED_RECORD = 3;
+
+        // Structure Record
+        /**
+         * A decoded log message (or a number of dropped messages)
+         */
+        struct Record {
+
+            /// Time of the message since the start of the logger (in nanoseconds)
+            uint64 time = 0;
+
+            /// Level of the message
+            Logger::Level level = Logger::Level::Information;
+
+            /// Category of the message
+            Logger::Category category = Logger::Category::PhysicCommon;
+
+            /// Name of the physics world
+            std::string worldName;
+
+            /// Source file of the message
+            std::string filename;
+
+            /// Line of the message in the source file
+            int lineNumber = 0;
+
+            /// Text of the message
+            std::string message;
+
+            /// Number of messages dropped before this point (the other fields are not used if non-zero)
+            uint64 nbDroppedMessages = 0;
+        };
+
+        // -------------------- Methods -------------------- //
+
+        /// Decode a binary log and call a function for each record. Return false if the log is invalid.
+        static bool decode(std::istream& input, const std::function<void(const Record&)>& recordCallback,
+                           std::vector<Message>& messages, uint64* outStartTime = nullptr);
+
+        /// Decode a binary log into text lines. Return false if the log is invalid.
+        static bool decodeToText(std::istream& input, std::ostream& output, std::vector<Message>& messages);
+
+        /// Return the text line of a record
+        static std::string formatRecord(const Record& record);
+};
+
+}
+
+#endif
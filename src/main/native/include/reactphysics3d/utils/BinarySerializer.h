@@ -0,0 +1,372 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_BINARY_SERIALIZER_H
+#define REACTPHYSICS3D_BINARY_SERIALIZER_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <reactphysics3d/mathematics/Vector3.h>
+#include <vector>
+#include <cassert>
+#include <cstring>
+#include <type_traits>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class BinaryWriter
+/**
+ * This class appends scalar values and arrays of scalar values to a byte buffer.
+ * All the values are written in little-endian byte order whatever the endianness
+ * of the machine so that the data can be read back on any platform. On little-endian
+ * machines, the arrays are copied with a single memcpy().
+ */
+class BinaryWriter {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Buffer where the bytes are appended
+        std::vector<uint8>& mBuffer;
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BinaryWriter(std::vector<uint8>& buffer) : mBuffer(buffer) {}
+
+        /// Write raw bytes (no byte order conversion)
+        void writeBytes(const void* data, size_t size);
+
+        /// Write a scalar value
+        template<typename T>
+        void write(T value);
+
+        /// Write an array of scalar values
+        template<typename T>
+        void writeArray(const T* values, size_t nbValues);
+
+        /// Write a vector
+        void writeVector3(const Vector3& vector);
+
+        /// Write an array of vectors
+        void writeVectors3(const Vector3* vectors, size_t nbVectors);
+
+        /// Overwrite a scalar value previously written at a given offset in the buffer
+        template<typename T>
+        void writeAt(size_t offset, T value);
+
+        /// Return the number of bytes in the buffer
+        size_t getSize() const;
+};
+
+// Class BinaryReader
+/**
+ * This class reads back the values written by a BinaryWriter from a memory buffer
+ * (for instance a memory-mapped file). Reading past the end of the buffer never
+ * overflows it: the read fails, the reader is flagged with an error and the following
+ * reads return zero values. The decimal values can be read from a buffer written with a
+ * different floating-point precision (they are converted in this case).
+ */
+class BinaryReader {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Pointer to the first byte of the buffer
+        const uint8* mData;
+
+        /// Size of the buffer (in bytes)
+        size_t mSize;
+
+        /// Current read offset in the buffer (in bytes)
+        size_t mOffset;
+
+        /// Size (in bytes) of the decimal values in the buffer (4 or 8)
+        uint32 mDecimalSize;
+
+        /// True if a read has failed
+        bool mHasError;
+
+        // -------------------- Methods -------------------- //
+
+        /// Check that a given number of bytes can be read and flag an error otherwise
+        bool canRead(size_t nbElements, size_t elementSize);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        BinaryReader(const void* data, size_t size)
+            : mData(static_cast<const uint8*>(data)), mSize(size), mOffset(0), mDecimalSize(sizeof(decimal)),
+              mHasError(false) {}
+
+        /// Read raw bytes (no byte order conversion)
+        bool readBytes(void* outData, size_t size);
+
+        /// Read a scalar value
+        template<typename T>
+        T read();
+
+        /// Read an array of scalar values
+        template<typename T>
+        bool readArray(T* outValues, size_t nbValues);
+
+        /// Read a decimal value
+        decimal readDecimal();
+
+        /// Read an array of decimal values
+        bool readDecimals(decimal* outValues, size_t nbValues);
+
+        /// Read a vector
+        Vector3 readVector3();
+
+        /// Read an array of vectors
+        bool readVectors3(Vector3* outVectors, size_t nbVectors);
+
+        /// Set the size (in bytes) of the decimal values in the buffer
+        void setDecimalSize(uint32 decimalSize);
+
+        /// Skip a given number of bytes
+        bool skip(size_t size);
+
+        /// Return true if a given number of elements of a given size remains in the buffer
+        bool hasRemaining(size_t nbElements, size_t elementSize) const;
+
+        /// Return true if a read has failed
+        bool hasError() const;
+
+        /// Return the current read offset in the buffer (in bytes)
+        size_t getOffset() const;
+
+        /// Return true if the machine stores the values in little-endian byte order
+        static bool isLittleEndianMachine();
+
+        /// Reverse the bytes of a scalar value
+        template<typename T>
+        static T swapBytes(T value);
+};
+
+// Return true if the machine stores the values in little-endian byte order
+RP3D_FORCE_INLINE bool BinaryReader::isLittleEndianMachine() {
+    const uint32 value = 1;
+    uint8 firstByte;
+    std::memcpy(&firstByte, &value, 1);
+    return firstByte == 1;
+}
+
+// Reverse the bytes of a scalar value
+template<typename T>
+RP3D_FORCE_INLINE T BinaryReader::swapBytes(T value) {
+    static_assert(std::is_arithmetic<T>::value, "Only scalar values can be swapped");
+    uint8 bytes[sizeof(T)];
+    std::memcpy(bytes, &value, sizeof(T));
+    for (size_t i=0; i < sizeof(T) / 2; i++) {
+        const uint8 byte = bytes[i];
+        bytes[i] = bytes[sizeof(T) - 1 - i];
+        bytes[sizeof(T) - 1 - i] = byte;
+    }
+    std::memcpy(&value, bytes, sizeof(T));
+    return value;
+}
+
+// Write raw bytes (no byte order conversion)
+RP3D_FORCE_INLINE void BinaryWriter::writeBytes(const void* data, size_t size) {
+    const uint8* bytes = static_cast<const uint8*>(data);
+    mBuffer.insert(mBuffer.end(), bytes, bytes + size);
+}
+
+// Write a scalar value
+template<typename T>
+RP3D_FORCE_INLINE void BinaryWriter::write(T value) {
+    static_assert(std::is_arithmetic<T>::value, "Only scalar values can be written");
+    if (!BinaryReader::isLittleEndianMachine()) {
+        value = BinaryReader::swapBytes(value);
+    }
+    writeBytes(&value, sizeof(T));
+}
+
+// Write an array of scalar values
+template<typename T>
+RP3D_FORCE_INLINE void BinaryWriter::writeArray(const T* values, size_t nbValues) {
+    static_assert(std::is_arithmetic<T>::value, "Only scalar values can be written");
+    if (BinaryReader::isLittleEndianMachine()) {
+        writeBytes(values, nbValues * sizeof(T));
+    }
+    else {
+        for (size_t i=0; i < nbValues; i++) {
+            write(values[i]);
+        }
+    }
+}
+
+// Write a vector
+RP3D_FORCE_INLINE void BinaryWriter::writeVector3(const Vector3& vector) {
+    write(vector.x);
+    write(vector.y);
+    write(vector.z);
+}
+
+// Write an array of vectors
+RP3D_FORCE_INLINE void BinaryWriter::writeVectors3(const Vector3* vectors, size_t nbVectors) {
+    static_assert(sizeof(Vector3) == 3 * sizeof(decimal), "A Vector3 must only contain three decimal values");
+    writeArray(reinterpret_cast<const decimal*>(vectors), nbVectors * 3);
+}
+
+// Overwrite a scalar value previously written at a given offset in the buffer
+template<typename T>
+RP3D_FORCE_INLINE void BinaryWriter::writeAt(size_t offset, T value) {
+    static_assert(std::is_arithmetic<T>::value, "Only scalar values can be written");
+    assert(offset + sizeof(T) <= mBuffer.size());
+    if (!BinaryReader::isLittleEndianMachine()) {
+        value = BinaryReader::swapBytes(value);
+    }
+    std::memcpy(&mBuffer[offset], &value, sizeof(T));
+}
+
+// Return the number of bytes in the buffer
+RP3D_FORCE_INLINE size_t BinaryWriter::getSize() const {
+    return mBuffer.size();
+}
+
+// Return true if a given number of elements of a given size remains in the buffer
+RP3D_FORCE_INLINE bool BinaryReader::hasRemaining(size_t nbElements, size_t elementSize) const {
+    return !mHasError && nbElements <= (mSize - mOffset) / elementSize;
+}
+
+// Check that a given number of bytes can be read and flag an error otherwise
+RP3D_FORCE_INLINE bool BinaryReader::canRead(size_t nbElements, size_t elementSize) {
+    if (!hasRemaining(nbElements, elementSize)) {
+        mHasError = true;
+        return false;
+    }
+    return true;
+}
+
+// Read raw bytes (no byte order conversion)
+RP3D_FORCE_INLINE bool BinaryReader::readBytes(void* outData, size_t size) {
+    if (!canRead(size, 1)) return false;
+    std::memcpy(outData, mData + mOffset, size);
+    mOffset += size;
+    return true;
+}
+
+// Skip a given number of bytes
+RP3D_FORCE_INLINE bool BinaryReader::skip(size_t size) {
+    if (!canRead(size, 1)) return false;
+    mOffset += size;
+    return true;
+}
+
+// Read a scalar value
+template<typename T>
+RP3D_FORCE_INLINE T BinaryReader::read() {
+    static_assert(std::is_arithmetic<T>::value, "Only scalar values can be read");
+    T value = T(0);
+    if (readBytes(&value, sizeof(T)) && !isLittleEndianMachine()) {
+        value = swapBytes(value);
+    }
+    return value;
+}
+
+// Read an array of scalar values
+template<typename T>
+RP3D_FORCE_INLINE bool BinaryReader::readArray(T* outValues, size_t nbValues) {
+    static_assert(std::is_arithmetic<T>::value, "Only scalar values can be read");
+    if (!canRead(nbValues, sizeof(T))) return false;
+    std::memcpy(outValues, mData + mOffset, nbValues * sizeof(T));
+    mOffset += nbValues * sizeof(T);
+    if (!isLittleEndianMachine()) {
+        for (size_t i=0; i < nbValues; i++) {
+            outValues[i] = swapBytes(outValues[i]);
+        }
+    }
+    return true;
+}
+
+// Read a decimal value
+RP3D_FORCE_INLINE decimal BinaryReader::readDecimal() {
+    if (mDecimalSize == sizeof(float)) {
+        return static_cast<decimal>(read<float>());
+    }
+    return static_cast<decimal>(read<double>());
+}
+
+// Read an array of decimal values
+RP3D_FORCE_INLINE bool BinaryReader::readDecimals(decimal* outValues, size_t nbValues) {
+
+    // Fast path: the values have the precision of the decimal type
+    if (mDecimalSize == sizeof(decimal)) {
+        return readArray(outValues, nbValues);
+    }
+
+    if (!canRead(nbValues, mDecimalSize)) return false;
+    for (size_t i=0; i < nbValues; i++) {
+        outValues[i] = readDecimal();
+    }
+    return true;
+}
+
+// Read a vector
+RP3D_FORCE_INLINE Vector3 BinaryReader::readVector3() {
+    const decimal x = readDecimal();
+    const decimal y = readDecimal();
+    const decimal z = readDecimal();
+    return Vector3(x, y, z);
+}
+
+// Read an array of vectors
+RP3D_FORCE_INLINE bool BinaryReader::readVectors3(Vector3* outVectors, size_t nbVectors) {
+    static_assert(sizeof(Vector3) == 3 * sizeof(decimal), "A Vector3 must only contain three decimal values");
+    return readDecimals(reinterpret_cast<decimal*>(outVectors), nbVectors * 3);
+}
+
+// Set the size (in bytes) of the decimal values in the buffer
+/**
+ * @param decimalSize Size of the decimal values in the buffer (sizeof(float) or sizeof(double))
+ */
+RP3D_FORCE_INLINE void BinaryReader::setDecimalSize(uint32 decimalSize) {
+    assert(decimalSize == sizeof(float) || decimalSize == sizeof(double));
+    mDecimalSize = decimalSize;
+}
+
+// Return true if a read has failed
+RP3D_FORCE_INLINE bool BinaryReader::hasError() const {
+    return mHasError;
+}
+
+// Return the current read offset in the buffer (in bytes)
+RP3D_FORCE_INLINE size_t BinaryReader::getOffset() const {
+    return mOffset;
+}
+
+}
+
+#endif
@@ -0,0 +1,161 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_DATA_LOG_RECORDER_H
+#define REACTPHYSICS3D_DATA_LOG_RECORDER_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+// Declarations
+namespace wpi::log {
+class DataLog;
+}
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Declarations
+class PhysicsWorld;
+
+// Class DataLogRecorder
+/**
+ * This class records the simulation of a physics world into a WPILib data log (.wpilog file)
+ * that can be opened with AdvantageScope or the DataLogTool. Each call of record() appends a
+ * few records, whatever the number of bodies:
+ *  - <prefix>/Poses: the transforms of all the bodies (struct:Pose3d[]) read directly from the
+ *    transform components of the world
+ *  - <prefix>/Bodies: the ids of the entities of the bodies of the poses array (int64[]), only
+ *    appended when the order of the bodies has changed (bodies created, destroyed, put to sleep ...)
+ *  - <prefix>/StepStats: the statistics of the last step (struct:RP3DStepStats)
+ *  - <prefix>/ContactPoints: the contact points (struct:Translation3d[]) of the contact event
+ *    buffer of the world (only if the buffer is enabled)
+ * The records are packed into a single reusable buffer and appended with one call to the log.
+ * When the recorder owns its log, the file is written by a WPILib background writer thread whose
+ * amount of buffered data is bounded (the log is paused if the disk cannot keep up). The poses
+ * are written as they are in the world (no change of coordinate system).
+ */
+class DataLogRecorder {
+
+    public:
+
+        // -------------------- Constants -------------------- //
+
+        /// Default prefix of the names of the log entries
+        static constexpr std::string_view DEFAULT_PREFIX = "/Physics";
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Physics world to record
+        PhysicsWorld& mWorld;
+
+        /// Data log owned by the recorder (null if the log is provided by the user)
+        std::unique_ptr<wpi::log::DataLog> mOwnedLog;
+
+        /// Data log where the records are appended
+        wpi::log::DataLog& mLog;
+
+        /// Entry of the poses of the bodies
+        int mPosesEntry;
+
+        /// Entry of the ids of the bodies
+        int mBodiesEntry;
+
+        /// Entry of the statistics of the steps
+        int mStepStatsEntry;
+
+        /// Entry of the contact points
+        int mContactPointsEntry;
+
+        /// Reusable buffer where the records are packed
+        std::vector<uint8_t> mBuffer;
+
+        /// Ids of the bodies in the order of the last poses record
+        std::vector<uint32> mRecordedBodies;
+
+        /// Number of calls of record()
+        uint64 mNbRecords;
+
+        // -------------------- Methods -------------------- //
+
+        /// Add the struct schemas and start the entries of the log
+        void startEntries(std::string_view prefix);
+
+        /// Append the ids of the bodies if their order has changed since the last record
+        void recordBodies(int64_t timestamp);
+
+        /// Append the poses of the bodies
+        void recordPoses(int64_t timestamp);
+
+        /// Append the statistics of the last step
+        void recordStepStats(int64_t timestamp);
+
+        /// Append the contact points of the contact event buffer
+        void recordContactPoints(int64_t timestamp);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor to record into an existing data log (for instance frc::DataLogManager::GetLog())
+        DataLogRecorder(PhysicsWorld& world, wpi::log::DataLog& log, std::string_view prefix = DEFAULT_PREFIX);
+
+        /// Constructor to record into a new .wpilog file written by a background thread
+        DataLogRecorder(PhysicsWorld& world, std::string_view directory, std::string_view filename,
+                        double flushPeriod = 0.25, std::string_view prefix = DEFAULT_PREFIX);
+
+        /// Destructor
+        ~DataLogRecorder();
+
+        /// Deleted copy-constructor
+        DataLogRecorder(const DataLogRecorder& recorder) = delete;
+
+        /// Deleted assignment operator
+        DataLogRecorder& operator=(const DataLogRecorder& recorder) = delete;
+
+        /// Append the state of the world after its last step (timestamp in microseconds, 0 for now)
+        void record(int64_t timestamp = 0);
+
+        /// Ask the data log to write its buffered records
+        void flush();
+
+        /// Return the number of calls of record()
+        uint64 getNbRecords() const;
+};
+
+// Return the number of calls of record()
+RP3D_FORCE_INLINE uint64 DataLogRecorder::getNbRecords() const {
+    return mNbRecords;
+}
+
+}
+
+#endif
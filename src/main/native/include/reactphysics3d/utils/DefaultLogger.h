@@ -504,6 +504,9 @@ class DefaultLogger : public Logger {
         /// Return the corresponding formatter
         Formatter* getFormatter(Format format) const;
 
+        /// Update the maximum level flag of the logged messages from the destinations
+        void updateMaxLevelFlag();
+
         /// Constructor
         DefaultLogger(MemoryAllocator& allocator);
 
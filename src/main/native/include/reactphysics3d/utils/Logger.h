@@ -31,6 +31,7 @@
 #include <reactphysics3d/containers/Map.h>
 #include <string>
 #include <iostream>
+#include <atomic>
 
 /// ReactPhysics3D namespace
 namespace reactphysics3d {
@@ -78,6 +79,14 @@ class Logger {
             return "";
         }
 
+    protected :
+
+        // -------------------- Attributes -------------------- //
+
+        /// Maximum level flag of the messages to log. The messages with a higher level are
+        /// skipped by RP3D_LOG before they are built.
+        std::atomic<uint> mMaxLevelFlag{static_cast<uint>(Level::Information)};
+
     public :
 
         // -------------------- Methods -------------------- //
@@ -88,6 +97,11 @@ class Logger {
         /// Destructor
         virtual ~Logger() = default;
 
+        /// Return true if the messages of a given level are logged
+        bool isLevelEnabled(Level level) const {
+            return static_cast<uint>(level) <= mMaxLevelFlag.load(std::memory_order_relaxed);
+        }
+
         /// Log something
         virtual void log(Level level, const std::string& physicsWorldName, Category category, const std::string& message, const char* filename, int lineNumber)=0;
 
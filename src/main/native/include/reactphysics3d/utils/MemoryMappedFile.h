@@ -0,0 +1,114 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_MEMORY_MAPPED_FILE_H
+#define REACTPHYSICS3D_MEMORY_MAPPED_FILE_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <string>
+#include <cstddef>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class MemoryMappedFile
+/**
+ * This class maps a file of the file system into read-only memory. The pages of
+ * the file are loaded by the operating system the first time they are accessed
+ * and, since they are never modified, they can be reclaimed again at any time.
+ */
+class MemoryMappedFile {
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// Pointer to the first byte of the mapped file (null if no file is mapped)
+        const unsigned char* mData;
+
+        /// Size of the mapped file (in bytes)
+        size_t mSize;
+
+#ifdef RP3D_PLATFORM_WINDOWS
+
+        /// Handle of the opened file
+        void* mFileHandle;
+
+        /// Handle of the file mapping object
+        void* mMappingHandle;
+
+#endif
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Constructor
+        MemoryMappedFile();
+
+        /// Destructor
+        ~MemoryMappedFile();
+
+        /// Deleted copy-constructor
+        MemoryMappedFile(const MemoryMappedFile& file) = delete;
+
+        /// Deleted assignment operator
+        MemoryMappedFile& operator=(const MemoryMappedFile& file) = delete;
+
+        /// Map a file into memory
+        bool open(const std::string& filePath);
+
+        /// Unmap the file
+        void close();
+
+        /// Return true if a file is currently mapped
+        bool isOpen() const;
+
+        /// Return a pointer to the first byte of the mapped file
+        const unsigned char* getData() const;
+
+        /// Return the size of the mapped file (in bytes)
+        size_t getSize() const;
+};
+
+// Return true if a file is currently mapped
+RP3D_FORCE_INLINE bool MemoryMappedFile::isOpen() const {
+    return mData != nullptr;
+}
+
+// Return a pointer to the first byte of the mapped file
+RP3D_FORCE_INLINE const unsigned char* MemoryMappedFile::getData() const {
+    return mData;
+}
+
+// Return the size of the mapped file (in bytes)
+RP3D_FORCE_INLINE size_t MemoryMappedFile::getSize() const {
+    return mSize;
+}
+
+}
+
+#endif
@@ -26,6 +26,9 @@
 #ifndef REACTPHYSICS3D_PROFILER_H
 #define REACTPHYSICS3D_PROFILER_H
 
+// Libraries
+#include <reactphysics3d/utils/TraceRecorder.h>
+
 // If profiling is enabled
 #ifdef IS_RP3D_PROFILING_ENABLED
 
@@ -397,7 +400,8 @@ class ProfileSample {
 
 
 // Use this macro to start profile a block of code
-#define RP3D_PROFILE(name, profiler) ProfileSample profileSample(name, profiler)
+#define RP3D_PROFILE(name, profiler) ProfileSample profileSample(name, profiler); \
+                                     reactphysics3d::TraceScope traceScope(name)
 
 // Return true if we are at the root of the profiler tree
 RP3D_FORCE_INLINE bool ProfileNodeIterator::isRoot() {
@@ -514,8 +518,8 @@ RP3D_FORCE_INLINE void Profiler::destroy() {
 // If profiling is disabled
 #else
 
-// Empty macro in case profiling is not active
-#define RP3D_PROFILE(name, profiler)
+// In case profiling is not active, the block of code is only recorded by the TraceRecorder
+#define RP3D_PROFILE(name, profiler) reactphysics3d::TraceScope traceScope(name)
 
 #endif
 
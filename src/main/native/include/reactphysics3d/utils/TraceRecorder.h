@@ -0,0 +1,168 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2024 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef REACTPHYSICS3D_TRACE_RECORDER_H
+#define REACTPHYSICS3D_TRACE_RECORDER_H
+
+// Libraries
+#include <reactphysics3d/configuration.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+
+/// ReactPhysics3D namespace
+namespace reactphysics3d {
+
+// Class TraceRecorder
+/**
+ * This class records a timeline of the profiled blocks of code (the RP3D_PROFILE() scopes) in order
+ * to diagnose latency spikes frame by frame. Contrary to the Profiler, it is available in release builds
+ * and is switched on and off at runtime. When the recording is disabled, a profiled scope only costs a
+ * relaxed atomic load.
+ *
+ * Each thread records its events into its own ring buffer without any lock (only the first event of a
+ * thread takes a lock to register its buffer). When a ring buffer is full, the oldest events of this
+ * thread are overwritten. The recorded events can be exported into a Chrome trace JSON file (for
+ * chrome://tracing or ui.perfetto.dev) or into a Perfetto protobuf trace file. The export and clear()
+ * must be called while the recording is disabled or while no thread is running a profiled scope.
+ *
+ * The recorder is global to the process because the profiled scopes do not have access to the world.
+ */
+class TraceRecorder {
+
+    public:
+
+        /// Event recorded for a profiled block of code
+        struct Event {
+
+            /// Name of the block of code (string literal of the RP3D_PROFILE() macro)
+            const char* name;
+
+            /// Starting time of the block of code (in nanoseconds since the recording epoch)
+            uint64 startTime;
+
+            /// Duration of the block of code (in nanoseconds)
+            uint64 duration;
+        };
+
+    private:
+
+        // -------------------- Attributes -------------------- //
+
+        /// True if the events are recorded
+        static std::atomic<bool> mIsEnabled;
+
+        // -------------------- Methods -------------------- //
+
+        /// Record an event into the ring buffer of the calling thread
+        static void recordEvent(const char* name, uint64 startTime, uint64 endTime);
+
+    public:
+
+        // -------------------- Methods -------------------- //
+
+        /// Deleted constructor
+        TraceRecorder() = delete;
+
+        /// Enable or disable the recording of the events
+        static void setIsEnabled(bool isEnabled);
+
+        /// Return true if the events are recorded
+        static bool isEnabled();
+
+        /// Set the number of events of the ring buffer of each thread (rounded up to a power of two).
+        /// The ring buffers are reallocated, therefore this must be called while the recording is
+        /// disabled and no thread is running a profiled scope.
+        static void setBufferCapacity(uint32 nbEventsPerThread);
+
+        /// Set the name of the calling thread in the exported traces
+        static void setThreadName(const std::string& name);
+
+        /// Return the current time (in nanoseconds since the recording epoch)
+        static uint64 getTime();
+
+        /// Return the number of events currently stored in the ring buffers of all the threads
+        static uint64 getNbRecordedEvents();
+
+        /// Remove all the recorded events
+        static void clear();
+
+        /// Export the recorded events into a Chrome trace JSON file
+        static bool exportChromeTrace(const std::string& filePath);
+
+        /// Export the recorded events into a Perfetto protobuf trace file
+        static bool exportPerfettoTrace(const std::string& filePath);
+
+        // ---------- Friendship ---------- //
+
+        friend class TraceScope;
+};
+
+// Class TraceScope
+/**
+ * This class records the duration of a scope into the TraceRecorder. It is
+ * created by the RP3D_PROFILE() macro at the beginning of a profiled block of code.
+ */
+class TraceScope {
+
+    private:
+
+        /// Name of the block of code
+        const char* mName;
+
+        /// Starting time (only valid if the name is not null)
+        uint64 mStartTime;
+
+    public:
+
+        /// Constructor
+        TraceScope(const char* name)
+            : mName(TraceRecorder::isEnabled() ? name : nullptr),
+              mStartTime(mName != nullptr ? TraceRecorder::getTime() : 0) {
+
+        }
+
+        /// Destructor
+        ~TraceScope() {
+            if (mName != nullptr) {
+                TraceRecorder::recordEvent(mName, mStartTime, TraceRecorder::getTime());
+            }
+        }
+
+        /// Deleted copy-constructor
+        TraceScope(const TraceScope& scope) = delete;
+
+        /// Deleted assignment operator
+        TraceScope& operator=(const TraceScope& scope) = delete;
+};
+
+// Return true if the events are recorded
+RP3D_FORCE_INLINE bool TraceRecorder::isEnabled() {
+    return mIsEnabled.load(std::memory_order_relaxed);
+}
+
+}
+
+#endif
@@ -0,0 +1,228 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "JsonReader.h"
+#include <cstdlib>
+
+using namespace reactphysics3d;
+
+namespace {
+
+// Recursive descent parser of a JSON document
+class JsonParser {
+
+    private:
+
+        /// Text of the document
+        const std::string& mText;
+
+        /// Current position in the text
+        size_t mPosition = 0;
+
+        /// Error message
+        std::string mError;
+
+        /// Skip the whitespaces
+        void skipWhitespaces() {
+            while (mPosition < mText.size() && (mText[mPosition] == ' ' || mText[mPosition] == '\t' ||
+                                                 mText[mPosition] == '\n' || mText[mPosition] == '\r')) {
+                mPosition++;
+            }
+        }
+
+        /// Set the error message and return false
+        bool fail(const std::string& message) {
+            if (mError.empty()) {
+                mError = message + " at offset " + std::to_string(mPosition);
+            }
+            return false;
+        }
+
+        /// Consume a given character if it is the next one
+        bool consume(char character) {
+            skipWhitespaces();
+            if (mPosition < mText.size() && mText[mPosition] == character) {
+                mPosition++;
+                return true;
+            }
+            return false;
+        }
+
+        /// Consume a given keyword if it is next
+        bool consumeKeyword(const char* keyword) {
+            const std::string word(keyword);
+            if (mText.compare(mPosition, word.size(), word) == 0) {
+                mPosition += word.size();
+                return true;
+            }
+            return false;
+        }
+
+        /// Parse a string (the opening quote is already consumed)
+        bool parseString(std::string& outString) {
+            while (mPosition < mText.size()) {
+                char character = mText[mPosition++];
+                if (character == '"') {
+                    return true;
+                }
+                if (character == '\\') {
+                    if (mPosition >= mText.size()) break;
+                    character = mText[mPosition++];
+                    switch (character) {
+                        case 'n': character = '\n'; break;
+                        case 't': character = '\t'; break;
+                        case 'r': character = '\r'; break;
+                        case 'b': character = '\b'; break;
+                        case 'f': character = '\f'; break;
+                        case 'u': return fail("Unsupported unicode escape");
+                        default: break;
+                    }
+                }
+                outString.push_back(character);
+            }
+            return fail("Unterminated string");
+        }
+
+    public:
+
+        /// Constructor
+        explicit JsonParser(const std::string& text) : mText(text) {}
+
+        /// Return the error message
+        const std::string& getError() const {
+            return mError;
+        }
+
+        /// Return true if the whole document has been consumed
+        bool isAtEnd() {
+            skipWhitespaces();
+            return mPosition == mText.size();
+        }
+
+        /// Parse a value
+        bool parseValue(JsonValue& outValue) {
+
+            skipWhitespaces();
+            if (mPosition >= mText.size()) {
+                return fail("Unexpected end of document");
+            }
+
+            const char character = mText[mPosition];
+            if (character == '{') {
+                mPosition++;
+                outValue.type = JsonValue::Type::OBJECT;
+                if (consume('}')) return true;
+                do {
+                    if (!consume('"')) return fail("Expected a member name");
+                    std::string name;
+                    if (!parseString(name)) return false;
+                    if (!consume(':')) return fail("Expected ':'");
+                    outValue.members.emplace_back(name, JsonValue());
+                    if (!parseValue(outValue.members.back().second)) return false;
+                } while (consume(','));
+                return consume('}') || fail("Expected '}'");
+            }
+            if (character == '[') {
+                mPosition++;
+                outValue.type = JsonValue::Type::ARRAY;
+                if (consume(']')) return true;
+                do {
+                    outValue.elements.emplace_back();
+                    if (!parseValue(outValue.elements.back())) return false;
+                } while (consume(','));
+                return consume(']') || fail("Expected ']'");
+            }
+            if (character == '"') {
+                mPosition++;
+                outValue.type = JsonValue::Type::STRING;
+                return parseString(outValue.string);
+            }
+            if (consumeKeyword("true")) {
+                outValue.type = JsonValue::Type::BOOLEAN;
+                outValue.number = 1;
+                return true;
+            }
+            if (consumeKeyword("false")) {
+                outValue.type = JsonValue::Type::BOOLEAN;
+                outValue.number = 0;
+                return true;
+            }
+            if (consumeKeyword("null")) {
+                outValue.type = JsonValue::Type::NULL_VALUE;
+                return true;
+            }
+
+            const char* start = mText.c_str() + mPosition;
+            char* end = nullptr;
+            outValue.number = std::strtod(start, &end);
+            if (end == start) {
+                return fail("Unexpected character");
+            }
+            outValue.type = JsonValue::Type::NUMBER;
+            mPosition += size_t(end - start);
+            return true;
+        }
+};
+
+}
+
+// Return the member of an object with a given name (or nullptr)
+const JsonValue* JsonValue::find(const std::string& name) const {
+    for (const std::pair<std::string, JsonValue>& member : members) {
+        if (member.first == name) {
+            return &member.second;
+        }
+    }
+    return nullptr;
+}
+
+// Return the number of a member of an object (or a default value)
+double JsonValue::getNumber(const std::string& name, double defaultValue) const {
+    const JsonValue* value = find(name);
+    return value != nullptr && value->type == Type::NUMBER ? value->number : defaultValue;
+}
+
+// Return the string of a member of an object (or an empty string)
+std::string JsonValue::getString(const std::string& name) const {
+    const JsonValue* value = find(name);
+    return value != nullptr && value->type == Type::STRING ? value->string : std::string();
+}
+
+// Read a JSON document. Return false and set the error message if the document is invalid.
+bool reactphysics3d::readJson(const std::string& text, JsonValue& outValue, std::string& outError) {
+
+    JsonParser parser(text);
+    outValue = JsonValue();
+    if (!parser.parseValue(outValue)) {
+        outError = parser.getError();
+        return false;
+    }
+    if (!parser.isAtEnd()) {
+        outError = "Unexpected content after the document";
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,76 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef PERF_JSON_READER_H
+#define PERF_JSON_READER_H
+
+// Libraries
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace reactphysics3d {
+
+// Structure JsonValue
+/**
+ * Value of a JSON document read by readJson(). This is a minimal reader for the reports of
+ * the performance regression harness (and their baselines), not a general JSON library.
+ */
+struct JsonValue {
+
+    /// Type of a JSON value
+    enum class Type {NULL_VALUE, BOOLEAN, NUMBER, STRING, ARRAY, OBJECT};
+
+    /// Type of the value
+    Type type = Type::NULL_VALUE;
+
+    /// Value of a boolean or a number
+    double number = 0;
+
+    /// Value of a string
+    std::string string;
+
+    /// Elements of an array
+    std::vector<JsonValue> elements;
+
+    /// Members of an object (in the order of the document)
+    std::vector<std::pair<std::string, JsonValue>> members;
+
+    /// Return the member of an object with a given name (or nullptr)
+    const JsonValue* find(const std::string& name) const;
+
+    /// Return the number of a member of an object (or a default value)
+    double getNumber(const std::string& name, double defaultValue = 0) const;
+
+    /// Return the string of a member of an object (or an empty string)
+    std::string getString(const std::string& name) const;
+};
+
+/// Read a JSON document. Return false and set the error message if the document is invalid.
+bool readJson(const std::string& text, JsonValue& outValue, std::string& outError);
+
+}
+
+#endif
@@ -0,0 +1,134 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Performance regression harness. It replays fixed scenes for a given number of steps, writes a
+// JSON summary (median times per phase, step counters and hash of the final state of each scene) and
+// compares it with a baseline summary. The exit code is 1 if the output of a simulation has
+// changed or if a time is slower than the baseline by more than the tolerance.
+//
+// Usage: VendorPerf [--baseline <file>] [--output <file>] [--steps <n>] [--repetitions <n>]
+//                   [--time-tolerance <ratio>] [--min-time <ms>]
+
+// Libraries
+#include "PerfReport.h"
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+using namespace reactphysics3d;
+
+namespace {
+
+// Options of the harness
+struct Options {
+    std::string baselinePath;
+    std::string outputPath;
+    uint32 nbSteps = 300;
+    uint32 nbRepetitions = 3;
+    double timeTolerance = -1;
+    double minTime = -1;
+};
+
+// Parse the command line. Return false if it is invalid.
+bool parseOptions(int argc, char** argv, Options& outOptions) {
+
+    for (int i = 1; i < argc; i++) {
+        const std::string argument = argv[i];
+        if (i + 1 >= argc) {
+            return false;
+        }
+        const char* value = argv[++i];
+        if (argument == "--baseline") outOptions.baselinePath = value;
+        else if (argument == "--output") outOptions.outputPath = value;
+        else if (argument == "--steps") outOptions.nbSteps = uint32(std::strtoul(value, nullptr, 10));
+        else if (argument == "--repetitions") outOptions.nbRepetitions = uint32(std::strtoul(value, nullptr, 10));
+        else if (argument == "--time-tolerance") outOptions.timeTolerance = std::strtod(value, nullptr);
+        else if (argument == "--min-time") outOptions.minTime = std::strtod(value, nullptr);
+        else return false;
+    }
+
+    return outOptions.nbSteps > 0;
+}
+
+}
+
+int main(int argc, char** argv) {
+
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        std::cerr << "Usage: " << argv[0] << " [--baseline <file>] [--output <file>] [--steps <n>] "
+                  << "[--repetitions <n>] [--time-tolerance <ratio>] [--min-time <ms>]" << std::endl;
+        return 2;
+    }
+
+    // Read the baseline (its tolerances are used unless they are given on the command line)
+    PerfTolerances tolerances;
+    std::vector<SceneReport> baseline;
+    if (!options.baselinePath.empty()) {
+        std::ifstream file(options.baselinePath);
+        std::stringstream text;
+        text << file.rdbuf();
+        JsonValue document;
+        std::string error;
+        if (!file || !readJson(text.str(), document, error) || !readReports(document, baseline, tolerances, error)) {
+            std::cerr << "Cannot read the baseline " << options.baselinePath << ": " << error << std::endl;
+            return 2;
+        }
+    }
+    if (options.timeTolerance >= 0) tolerances.time = options.timeTolerance;
+    if (options.minTime >= 0) tolerances.minTime = options.minTime;
+
+    // Replay the scenes
+    std::vector<SceneReport> reports;
+    for (const PerfScene& scene : getPerfScenes()) {
+        SceneReport report;
+        std::string error;
+        if (!replayScene(scene, options.nbSteps, options.nbRepetitions, report, error)) {
+            std::cerr << error << std::endl;
+            return 1;
+        }
+        reports.push_back(report);
+    }
+
+    // Write the summary
+    if (options.outputPath.empty()) {
+        writeReports(std::cout, reports, tolerances);
+    }
+    else {
+        std::ofstream file(options.outputPath);
+        writeReports(file, reports, tolerances);
+        if (!file) {
+            std::cerr << "Cannot write the summary " << options.outputPath << std::endl;
+            return 2;
+        }
+    }
+
+    if (!options.baselinePath.empty()) {
+        return compareReports(reports, baseline, tolerances, std::cout) ? 0 : 1;
+    }
+
+    return 0;
+}
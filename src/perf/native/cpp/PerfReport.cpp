@@ -0,0 +1,363 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+// Libraries
+#include "PerfReport.h"
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+
+using namespace reactphysics3d;
+
+// Names of the phases of a step in the reports
+const char* const reactphysics3d::PERF_PHASE_NAMES[NB_PERF_PHASES] = {"broadPhase", "middlePhase", "narrowPhase",
+                                                                      "islands", "solve", "integrate"};
+
+// Names of the step counters in the reports
+const char* const reactphysics3d::PERF_STAT_NAMES[NB_PERF_STATS] = {"overlappingPairs", "narrowPhaseTests",
+                                                                    "contactPairs", "contactManifolds",
+                                                                    "contactPoints", "islands", "awakeBodies"};
+
+namespace {
+
+// Add bytes to a FNV-1a hash
+void hashBytes(uint64_t& hash, const void* data, size_t size) {
+    const unsigned char* bytes = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < size; i++) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+}
+
+// Add a vector to a FNV-1a hash
+void hashVector(uint64_t& hash, const Vector3& vector) {
+    hashBytes(hash, &vector.x, sizeof(decimal));
+    hashBytes(hash, &vector.y, sizeof(decimal));
+    hashBytes(hash, &vector.z, sizeof(decimal));
+}
+
+// Return the hash of the transforms and velocities of all the bodies of a world
+std::string computeStateHash(const PhysicsWorld& world) {
+
+    uint64_t hash = 14695981039346656037ull;
+    for (uint32 i = 0; i < world.getNbRigidBodies(); i++) {
+        const RigidBody* body = world.getRigidBody(i);
+        const Transform& transform = body->getTransform();
+        const Quaternion& orientation = transform.getOrientation();
+        hashVector(hash, transform.getPosition());
+        hashVector(hash, Vector3(orientation.x, orientation.y, orientation.z));
+        hashBytes(hash, &orientation.w, sizeof(decimal));
+        hashVector(hash, body->getLinearVelocity());
+        hashVector(hash, body->getAngularVelocity());
+    }
+
+    char text[17];
+    std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(hash));
+    return text;
+}
+
+// Return the times of the phases of a step
+void getPhaseTimes(const StepStats& stats, double outTimes[NB_PERF_PHASES]) {
+    outTimes[0] = stats.broadPhaseTime;
+    outTimes[1] = stats.middlePhaseTime;
+    outTimes[2] = stats.narrowPhaseTime;
+    outTimes[3] = stats.islandsTime;
+    outTimes[4] = stats.solveTime;
+    outTimes[5] = stats.integrateTime;
+}
+
+// Return the counters of a step
+void getStats(const StepStats& stats, uint64_t outStats[NB_PERF_STATS]) {
+    outStats[0] = stats.nbOverlappingPairs;
+    outStats[1] = stats.nbNarrowPhaseTests;
+    outStats[2] = stats.nbContactPairs;
+    outStats[3] = stats.nbContactManifolds;
+    outStats[4] = stats.nbContactPoints;
+    outStats[5] = stats.nbIslands;
+    outStats[6] = stats.nbAwakeBodies;
+}
+
+// Return the median of values (the values are reordered)
+double computeMedian(std::vector<double>& values) {
+    if (values.empty()) {
+        return 0;
+    }
+    std::nth_element(values.begin(), values.begin() + values.size() / 2, values.end());
+    return values[values.size() / 2];
+}
+
+// Replay a scene once
+bool replaySceneOnce(const PerfScene& scene, uint32 nbSteps, SceneReport& outReport) {
+
+    BenchmarkScene benchmarkScene;
+    if (!scene.builder(benchmarkScene, scene.parameter)) {
+        return false;
+    }
+    PhysicsWorld& world = benchmarkScene.getWorld();
+
+    outReport = SceneReport();
+    outReport.name = scene.name;
+    outReport.nbSteps = nbSteps;
+    outReport.nbBodies = world.getNbRigidBodies();
+
+    std::vector<double> stepTimes;
+    std::vector<double> phaseTimes[NB_PERF_PHASES];
+    for (uint32 i = 0; i < nbSteps; i++) {
+        world.update(BENCHMARK_TIME_STEP);
+
+        const StepStats& stats = world.getLastStepStats();
+        double stepPhaseTimes[NB_PERF_PHASES];
+        uint64_t stepStats[NB_PERF_STATS];
+        getPhaseTimes(stats, stepPhaseTimes);
+        getStats(stats, stepStats);
+        for (int p = 0; p < NB_PERF_PHASES; p++) {
+            phaseTimes[p].push_back(stepPhaseTimes[p]);
+        }
+        for (int s = 0; s < NB_PERF_STATS; s++) {
+            outReport.statTotals[s] += stepStats[s];
+        }
+        stepTimes.push_back(stats.totalTime);
+    }
+
+    outReport.stepTime = computeMedian(stepTimes);
+    for (int p = 0; p < NB_PERF_PHASES; p++) {
+        outReport.phaseTimes[p] = computeMedian(phaseTimes[p]);
+    }
+    outReport.stateHash = computeStateHash(world);
+
+    return true;
+}
+
+// Compare a time with its baseline. Return false if it is a regression.
+bool compareTime(const std::string& sceneName, const std::string& timeName, double time, double baselineTime,
+                 const PerfTolerances& tolerances, std::ostream& stream) {
+
+    if (baselineTime < tolerances.minTime) {
+        return true;
+    }
+
+    const double change = time / baselineTime - 1.0;
+    if (change > tolerances.time) {
+        stream << "[FAIL] " << sceneName << ": " << timeName << " time " << time << " ms is "
+               << change * 100.0 << "% slower than the baseline (" << baselineTime << " ms, tolerance "
+               << tolerances.time * 100.0 << "%)" << std::endl;
+        return false;
+    }
+    if (change < -tolerances.time) {
+        stream << "[INFO] " << sceneName << ": " << timeName << " time " << time << " ms is "
+               << -change * 100.0 << "% faster than the baseline (" << baselineTime
+               << " ms), the baseline can be updated" << std::endl;
+    }
+    return true;
+}
+
+}
+
+// Return the fixed scenes replayed by the harness
+const std::vector<PerfScene>& reactphysics3d::getPerfScenes() {
+    static const std::vector<PerfScene> scenes = {
+        {"BoxPyramid", createBoxPyramidScene, 20},
+        {"BallPit", createBallPitScene, 1000},
+        {"RagdollChains", createRagdollChainsScene, 8},
+        {"ConvexHullsOnConcaveMesh", createConvexHullsOnConcaveMeshScene, 12},
+        {"HeightFieldTerrain", createHeightFieldTerrainScene, 8}
+    };
+    return scenes;
+}
+
+// Replay a scene a given number of times and return its summary with the fastest time of each
+// phase over the repetitions. Return false if the scene cannot be created or if its simulation is not reproducible.
+bool reactphysics3d::replayScene(const PerfScene& scene, uint32 nbSteps, uint32 nbRepetitions,
+                                 SceneReport& outReport, std::string& outError) {
+
+    for (uint32 r = 0; r < std::max(nbRepetitions, 1u); r++) {
+
+        SceneReport report;
+        if (!replaySceneOnce(scene, nbSteps, report)) {
+            outError = std::string("Cannot create the scene ") + scene.name;
+            return false;
+        }
+
+        if (r == 0) {
+            outReport = report;
+            continue;
+        }
+
+        // Every repetition must simulate exactly the same steps
+        if (report.stateHash != outReport.stateHash ||
+            !std::equal(report.statTotals, report.statTotals + NB_PERF_STATS, outReport.statTotals)) {
+            outError = std::string("The simulation of the scene ") + scene.name + " is not reproducible";
+            return false;
+        }
+
+        outReport.stepTime = std::min(outReport.stepTime, report.stepTime);
+        for (int p = 0; p < NB_PERF_PHASES; p++) {
+            outReport.phaseTimes[p] = std::min(outReport.phaseTimes[p], report.phaseTimes[p]);
+        }
+    }
+
+    return true;
+}
+
+// Write the JSON summary of the reports
+void reactphysics3d::writeReports(std::ostream& stream, const std::vector<SceneReport>& reports,
+                                  const PerfTolerances& tolerances) {
+
+    const std::ios_base::fmtflags flags = stream.flags();
+    stream << std::setprecision(6);
+
+    stream << "{\n";
+    stream << "  \"tolerances\": {\"time\": " << tolerances.time << ", \"minTime\": " << tolerances.minTime << "},\n";
+    stream << "  \"scenes\": [";
+    for (size_t i = 0; i < reports.size(); i++) {
+        const SceneReport& report = reports[i];
+        stream << (i > 0 ? "," : "") << "\n    {\n";
+        stream << "      \"name\": \"" << report.name << "\",\n";
+        stream << "      \"nbSteps\": " << report.nbSteps << ",\n";
+        stream << "      \"nbBodies\": " << report.nbBodies << ",\n";
+        stream << "      \"stateHash\": \"" << report.stateHash << "\",\n";
+        stream << "      \"stepTime\": " << report.stepTime << ",\n";
+        stream << "      \"phaseTimes\": {";
+        for (int p = 0; p < NB_PERF_PHASES; p++) {
+            stream << (p > 0 ? ", " : "") << "\"" << PERF_PHASE_NAMES[p] << "\": " << report.phaseTimes[p];
+        }
+        stream << "},\n";
+        stream << "      \"stats\": {";
+        for (int s = 0; s < NB_PERF_STATS; s++) {
+            stream << (s > 0 ? ", " : "") << "\"" << PERF_STAT_NAMES[s] << "\": " << report.statTotals[s];
+        }
+        stream << "}\n    }";
+    }
+    stream << "\n  ]\n}\n";
+
+    stream.flags(flags);
+}
+
+// Read the reports of a JSON summary. Return false and set the error message if it is invalid.
+bool reactphysics3d::readReports(const JsonValue& document, std::vector<SceneReport>& outReports,
+                                 PerfTolerances& outTolerances, std::string& outError) {
+
+    const JsonValue* scenes = document.find("scenes");
+    if (document.type != JsonValue::Type::OBJECT || scenes == nullptr || scenes->type != JsonValue::Type::ARRAY) {
+        outError = "The summary must be an object with an array of scenes";
+        return false;
+    }
+
+    const JsonValue* tolerances = document.find("tolerances");
+    if (tolerances != nullptr) {
+        outTolerances.time = tolerances->getNumber("time", outTolerances.time);
+        outTolerances.minTime = tolerances->getNumber("minTime", outTolerances.minTime);
+    }
+
+    outReports.clear();
+    for (const JsonValue& scene : scenes->elements) {
+
+        const JsonValue* phaseTimes = scene.find("phaseTimes");
+        const JsonValue* stats = scene.find("stats");
+        if (scene.getString("name").empty() || phaseTimes == nullptr || stats == nullptr) {
+            outError = "A scene of the summary is incomplete";
+            return false;
+        }
+
+        SceneReport report;
+        report.name = scene.getString("name");
+        report.nbSteps = uint32(scene.getNumber("nbSteps"));
+        report.nbBodies = uint32(scene.getNumber("nbBodies"));
+        report.stateHash = scene.getString("stateHash");
+        report.stepTime = scene.getNumber("stepTime");
+        for (int p = 0; p < NB_PERF_PHASES; p++) {
+            report.phaseTimes[p] = phaseTimes->getNumber(PERF_PHASE_NAMES[p]);
+        }
+        for (int s = 0; s < NB_PERF_STATS; s++) {
+            report.statTotals[s] = uint64_t(stats->getNumber(PERF_STAT_NAMES[s]));
+        }
+        outReports.push_back(report);
+    }
+
+    return true;
+}
+
+// Compare reports with their baseline and print the differences. Return false if the output of a
+// simulation has changed or if a time is slower than the baseline by more than the tolerance.
+bool reactphysics3d::compareReports(const std::vector<SceneReport>& reports, const std::vector<SceneReport>& baseline,
+                                    const PerfTolerances& tolerances, std::ostream& stream) {
+
+    bool isSuccess = true;
+
+    for (const SceneReport& report : reports) {
+
+        auto it = std::find_if(baseline.begin(), baseline.end(),
+                               [&report](const SceneReport& baselineReport) { return baselineReport.name == report.name; });
+        if (it == baseline.end()) {
+            stream << "[NEW ] " << report.name << ": not in the baseline" << std::endl;
+            continue;
+        }
+        const SceneReport& baselineReport = *it;
+
+        if (report.nbSteps != baselineReport.nbSteps) {
+            stream << "[FAIL] " << report.name << ": replayed for " << report.nbSteps << " steps but the baseline has "
+                   << baselineReport.nbSteps << " steps" << std::endl;
+            isSuccess = false;
+            continue;
+        }
+
+        // Any change of the simulation output is a failure
+        bool isSceneSuccess = true;
+        if (report.nbBodies != baselineReport.nbBodies || report.stateHash != baselineReport.stateHash) {
+            stream << "[FAIL] " << report.name << ": simulation output changed (state hash " << report.stateHash
+                   << ", baseline " << baselineReport.stateHash << ")" << std::endl;
+            isSceneSuccess = false;
+        }
+        for (int s = 0; s < NB_PERF_STATS; s++) {
+            if (report.statTotals[s] != baselineReport.statTotals[s]) {
+                stream << "[FAIL] " << report.name << ": " << PERF_STAT_NAMES[s] << " total " << report.statTotals[s]
+                       << " differs from the baseline (" << baselineReport.statTotals[s] << ")" << std::endl;
+                isSceneSuccess = false;
+            }
+        }
+
+        // Times slower than the baseline by more than the tolerance are regressions
+        isSceneSuccess &= compareTime(report.name, "step", report.stepTime, baselineReport.stepTime, tolerances, stream);
+        for (int p = 0; p < NB_PERF_PHASES; p++) {
+            isSceneSuccess &= compareTime(report.name, PERF_PHASE_NAMES[p], report.phaseTimes[p],
+                                          baselineReport.phaseTimes[p], tolerances, stream);
+        }
+
+        if (isSceneSuccess) {
+            stream << "[ OK ] " << report.name << ": step time " << report.stepTime << " ms (baseline "
+                   << baselineReport.stepTime << " ms)" << std::endl;
+        }
+        isSuccess &= isSceneSuccess;
+    }
+
+    for (const SceneReport& baselineReport : baseline) {
+        if (std::none_of(reports.begin(), reports.end(),
+                         [&baselineReport](const SceneReport& report) { return report.name == baselineReport.name; })) {
+            stream << "[WARN] " << baselineReport.name << ": in the baseline but not replayed" << std::endl;
+        }
+    }
+
+    return isSuccess;
+}
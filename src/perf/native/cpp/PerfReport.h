@@ -0,0 +1,128 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef PERF_REPORT_H
+#define PERF_REPORT_H
+
+// Libraries
+#include "BenchmarkScenes.h"
+#include "JsonReader.h"
+#include <cstdint>
+#include <ostream>
+#include <string>
+#include <vector>
+
+namespace reactphysics3d {
+
+// Constants
+constexpr int NB_PERF_PHASES = 6;
+constexpr int NB_PERF_STATS = 7;
+
+/// Names of the phases of a step in the reports
+extern const char* const PERF_PHASE_NAMES[NB_PERF_PHASES];
+
+/// Names of the step counters in the reports
+extern const char* const PERF_STAT_NAMES[NB_PERF_STATS];
+
+// Structure PerfScene
+/**
+ * Fixed scene replayed by the performance regression harness
+ */
+struct PerfScene {
+
+    /// Name of the scene in the reports
+    const char* name;
+
+    /// Builder of the scene
+    bool (*builder)(BenchmarkScene& scene, int parameter);
+
+    /// Parameter of the builder
+    int parameter;
+};
+
+// Structure SceneReport
+/**
+ * Summary of the replay of a scene for a given number of steps
+ */
+struct SceneReport {
+
+    /// Name of the scene
+    std::string name;
+
+    /// Number of simulated steps
+    uint32 nbSteps = 0;
+
+    /// Number of bodies of the scene
+    uint32 nbBodies = 0;
+
+    /// Hash (FNV-1a) of the final transforms and velocities of the bodies (hexadecimal)
+    std::string stateHash;
+
+    /// Median time of a step (in milliseconds)
+    double stepTime = 0;
+
+    /// Median time of each phase of a step (in milliseconds)
+    double phaseTimes[NB_PERF_PHASES] = {};
+
+    /// Sum of each step counter over all the steps
+    uint64_t statTotals[NB_PERF_STATS] = {};
+};
+
+// Structure PerfTolerances
+/**
+ * Tolerances of the comparison of a report with a baseline
+ */
+struct PerfTolerances {
+
+    /// Maximum relative slowdown of a time before it is a regression (0.15 is 15%)
+    double time = 0.15;
+
+    /// Times (in milliseconds) below this value in the baseline are too noisy to be compared
+    double minTime = 0.02;
+};
+
+/// Return the fixed scenes replayed by the harness
+const std::vector<PerfScene>& getPerfScenes();
+
+/// Replay a scene a given number of times and return its summary with the fastest time of each
+/// phase over the repetitions. Return false if the scene cannot be created or if its simulation is not reproducible.
+bool replayScene(const PerfScene& scene, uint32 nbSteps, uint32 nbRepetitions, SceneReport& outReport,
+                 std::string& outError);
+
+/// Write the JSON summary of the reports
+void writeReports(std::ostream& stream, const std::vector<SceneReport>& reports, const PerfTolerances& tolerances);
+
+/// Read the reports of a JSON summary. Return false and set the error message if it is invalid.
+bool readReports(const JsonValue& document, std::vector<SceneReport>& outReports, PerfTolerances& outTolerances,
+                 std::string& outError);
+
+/// Compare reports with their baseline and print the differences. Return false if the output of a
+/// simulation has changed or if a time is slower than the baseline by more than the tolerance.
+bool compareReports(const std::vector<SceneReport>& reports, const std::vector<SceneReport>& baseline,
+                    const PerfTolerances& tolerances, std::ostream& stream);
+
+}
+
+#endif
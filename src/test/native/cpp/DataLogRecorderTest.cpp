@@ -0,0 +1,180 @@
+#include <gtest/gtest.h>
+
+#include <reactphysics3d/reactphysics3d.h>
+#include <wpi/DataLogBackgroundWriter.h>
+#include <wpi/DataLogReader.h>
+#include <wpi/MemoryBuffer.h>
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <span>
+#include <string>
+#include <vector>
+
+using namespace reactphysics3d;
+
+namespace {
+
+// Read a little-endian unsigned integer of a WPILib struct
+uint64_t ReadUint(std::span<const uint8_t> data, size_t offset, size_t nbBytes) {
+  uint64_t value = 0;
+  for (size_t i = 0; i < nbBytes; i++) {
+    value |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+  }
+  return value;
+}
+
+// Read a little-endian double of a WPILib struct
+double ReadDouble(std::span<const uint8_t> data, size_t offset) {
+  const uint64_t bits = ReadUint(data, offset, sizeof(double));
+  double value;
+  std::memcpy(&value, &bits, sizeof(double));
+  return value;
+}
+
+// World with a ground and a falling sphere
+class DataLogRecorderTest : public ::testing::Test {
+ protected:
+  void SetUp() override {
+    world = physicsCommon.createPhysicsWorld();
+
+    RigidBody* ground = world->createRigidBody(Transform::identity());
+    ground->setType(BodyType::STATIC);
+    ground->addCollider(physicsCommon.createBoxShape(Vector3(10, 1, 10)), Transform::identity());
+
+    sphere = world->createRigidBody(Transform(Vector3(0, 2, 0), Quaternion::identity()));
+    sphere->addCollider(physicsCommon.createSphereShape(decimal(0.5)), Transform::identity());
+    sphere->setIsContactEventsEnabled(true);
+    world->setIsContactEventBufferEnabled(true);
+  }
+
+  void TearDown() override {
+    physicsCommon.destroyPhysicsWorld(world);
+  }
+
+  PhysicsCommon physicsCommon;
+  PhysicsWorld* world = nullptr;
+  RigidBody* sphere = nullptr;
+};
+
+}  // namespace
+
+TEST_F(DataLogRecorderTest, RecordIntoExistingLog) {
+  wpi::log::DataLogBackgroundWriter log{std::filesystem::temp_directory_path().string(), "rp3d_recorder_shared.wpilog"};
+  {
+    DataLogRecorder recorder{*world, log};
+    for (int i = 0; i < 60; i++) {
+      world->update(decimal(1.0) / decimal(60.0));
+      recorder.record();
+    }
+    EXPECT_EQ(60u, recorder.getNbRecords());
+  }
+
+  // A second recorder can share the log (the schemas are only added once)
+  DataLogRecorder recorder{*world, log, "/OtherPhysics"};
+  recorder.record();
+  EXPECT_EQ(1u, recorder.getNbRecords());
+}
+
+TEST_F(DataLogRecorderTest, RecordIntoFile) {
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::filesystem::path path = directory / "rp3d_recorder_test.wpilog";
+  std::filesystem::remove(path);
+  {
+    DataLogRecorder recorder{*world, directory.string(), path.filename().string()};
+    for (int i = 0; i < 120; i++) {
+      world->update(decimal(1.0) / decimal(60.0));
+      recorder.record();
+    }
+    recorder.flush();
+  }
+
+  // The file is complete once the recorder has been destroyed
+  std::ifstream file{path, std::ios::binary};
+  ASSERT_TRUE(file.is_open());
+  std::string header(6, '\0');
+  file.read(header.data(), 6);
+  EXPECT_EQ("WPILOG", header);
+  file.close();
+  std::filesystem::remove(path);
+}
+
+TEST_F(DataLogRecorderTest, ReadBackRecords) {
+  const std::filesystem::path directory = std::filesystem::temp_directory_path();
+  const std::filesystem::path path = directory / "rp3d_recorder_read_back.wpilog";
+  std::filesystem::remove(path);
+  {
+    DataLogRecorder recorder{*world, directory.string(), path.filename().string()};
+    for (int i = 0; i < 30; i++) {
+      world->update(decimal(1.0) / decimal(60.0));
+      recorder.record(i + 1);
+    }
+  }
+
+  auto fileBuffer = wpi::MemoryBuffer::GetFile(path.string());
+  ASSERT_TRUE(fileBuffer);
+  wpi::log::DataLogReader reader{std::move(*fileBuffer)};
+  ASSERT_TRUE(reader.IsValid());
+
+  // Keep the last record of each entry
+  std::map<int, std::string> entryNames;
+  std::map<std::string, std::vector<uint8_t>> lastRecords;
+  std::map<std::string, int64_t> lastTimestamps;
+  for (const wpi::log::DataLogRecord& record : reader) {
+    if (record.IsStart()) {
+      wpi::log::StartRecordData startData;
+      ASSERT_TRUE(record.GetStartData(&startData));
+      entryNames[startData.entry] = std::string(startData.name);
+    } else if (!record.IsControl()) {
+      const std::string& name = entryNames[record.GetEntry()];
+      const std::span<const uint8_t> data = record.GetRaw();
+      lastRecords[name].assign(data.begin(), data.end());
+      lastTimestamps[name] = record.GetTimestamp();
+    }
+  }
+  EXPECT_EQ(30, lastTimestamps["/Physics/Poses"]);
+  EXPECT_EQ(30, lastTimestamps["/Physics/StepStats"]);
+
+  // Find the pose of the sphere with the ids of the bodies
+  const std::vector<uint8_t>& bodies = lastRecords["/Physics/Bodies"];
+  const std::vector<uint8_t>& poses = lastRecords["/Physics/Poses"];
+  ASSERT_EQ(2u * sizeof(int64_t), bodies.size());
+  ASSERT_EQ(2u * 7 * sizeof(double), poses.size());
+  size_t sphereIndex = 0;
+  while (sphereIndex < 2 && ReadUint(bodies, sphereIndex * sizeof(int64_t), sizeof(int64_t)) != sphere->getEntity().id) {
+    sphereIndex++;
+  }
+  ASSERT_LT(sphereIndex, 2u);
+
+  const Transform& transform = sphere->getTransform();
+  const size_t poseOffset = sphereIndex * 7 * sizeof(double);
+  EXPECT_EQ(static_cast<double>(transform.getPosition().x), ReadDouble(poses, poseOffset));
+  EXPECT_EQ(static_cast<double>(transform.getPosition().y), ReadDouble(poses, poseOffset + 8));
+  EXPECT_EQ(static_cast<double>(transform.getPosition().z), ReadDouble(poses, poseOffset + 16));
+  EXPECT_EQ(static_cast<double>(transform.getOrientation().w), ReadDouble(poses, poseOffset + 24));
+  EXPECT_EQ(static_cast<double>(transform.getOrientation().x), ReadDouble(poses, poseOffset + 32));
+  EXPECT_EQ(static_cast<double>(transform.getOrientation().y), ReadDouble(poses, poseOffset + 40));
+  EXPECT_EQ(static_cast<double>(transform.getOrientation().z), ReadDouble(poses, poseOffset + 48));
+
+  // The statistics of the last step (10 uint32 counters followed by 7 double timings)
+  const StepStats& stats = world->getLastStepStats();
+  const std::vector<uint8_t>& statsRecord = lastRecords["/Physics/StepStats"];
+  ASSERT_EQ(10 * sizeof(uint32_t) + 7 * sizeof(double), statsRecord.size());
+  EXPECT_EQ(stats.nbOverlappingPairs, ReadUint(statsRecord, 0, 4));
+  EXPECT_EQ(stats.nbNarrowPhaseTests, ReadUint(statsRecord, 4, 4));
+  EXPECT_EQ(stats.nbContactPairs, ReadUint(statsRecord, 8, 4));
+  EXPECT_EQ(stats.nbContactManifolds, ReadUint(statsRecord, 12, 4));
+  EXPECT_EQ(stats.nbContactPoints, ReadUint(statsRecord, 16, 4));
+  EXPECT_EQ(stats.nbIslands, ReadUint(statsRecord, 20, 4));
+  EXPECT_EQ(stats.nbAwakeBodies, ReadUint(statsRecord, 24, 4));
+  EXPECT_EQ(stats.nbVelocitySolverIterations, ReadUint(statsRecord, 28, 4));
+  EXPECT_EQ(stats.nbPositionSolverIterations, ReadUint(statsRecord, 32, 4));
+  EXPECT_EQ(stats.nbBroadPhaseReinsertions, ReadUint(statsRecord, 36, 4));
+  EXPECT_EQ(stats.broadPhaseTime, ReadDouble(statsRecord, 40));
+  EXPECT_EQ(stats.totalTime, ReadDouble(statsRecord, 88));
+
+  std::filesystem::remove(path);
+}
@@ -0,0 +1,414 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_BROAD_PHASE_BACKENDS_H
+#define TEST_BROAD_PHASE_BACKENDS_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/collision/broadphase/SweepAndPruneBroadPhase.h>
+#include <reactphysics3d/collision/broadphase/UniformGridBroadPhase.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <algorithm>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class BroadPhaseTestScene
+/**
+ * Scene with spheres and boxes falling on a ground in a world using a given broad-phase method
+ */
+struct BroadPhaseTestScene {
+
+    PhysicsWorld* world;
+
+    RigidBody* ground;
+
+    std::vector<RigidBody*> bodies;
+
+    /// Create the scene in a new world of the physics common
+    BroadPhaseTestScene(PhysicsCommon& physicsCommon, BroadPhaseMethod method, BoxShape* groundShape, BoxShape* boxShape,
+                        SphereShape* sphereShape) {
+
+        PhysicsWorld::WorldSettings settings;
+        settings.broadPhaseMethod = method;
+        settings.broadPhaseGridCellSize = decimal(1.5);
+        world = physicsCommon.createPhysicsWorld(settings);
+
+        ground = world->createRigidBody(Transform::identity());
+        ground->setType(BodyType::STATIC);
+        ground->addCollider(groundShape, Transform::identity());
+
+        // Columns of two spheres and two boxes (each column falls on its own place of the ground)
+        for (int i=0; i < 36; i++) {
+
+            const decimal x = decimal(i % 6) * decimal(2.5) - decimal(6.25);
+            const decimal z = decimal(i / 6) * decimal(2.5) - decimal(6.25);
+            for (int j=0; j < 4; j++) {
+
+                RigidBody* body = world->createRigidBody(Transform(Vector3(x, decimal(1.5) + decimal(j) * decimal(1.2), z), Quaternion::identity()));
+                if (j % 2 == 0) {
+                    body->addCollider(boxShape, Transform::identity());
+                }
+                else {
+                    body->addCollider(sphereShape, Transform::identity());
+                }
+                bodies.push_back(body);
+            }
+        }
+    }
+
+    /// Run some steps of the simulation
+    void simulate(uint32 nbSteps) {
+        for (uint32 i=0; i < nbSteps; i++) {
+            world->update(decimal(1.0) / decimal(60.0));
+        }
+    }
+};
+
+// Class BroadPhaseHitCounter
+/**
+ * Raycast callback that counts all the hits of a ray
+ */
+class BroadPhaseHitCounter : public RaycastCallback {
+
+    public:
+
+        uint32 nbHits = 0;
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& /*info*/) override {
+            nbHits++;
+            return decimal(1.0);
+        }
+};
+
+// Class TestBroadPhaseBackends
+/**
+ * Unit test for the sweep-and-prune and uniform grid broad-phase methods
+ */
+class TestBroadPhaseBackends : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        BoxShape* mGroundShape;
+        BoxShape* mBoxShape;
+        SphereShape* mSphereShape;
+
+        /// Objects whose addresses are used as colliders in the backends
+        int mObjects[300];
+
+        /// State of the pseudo-random number generator
+        uint32 mRandomState;
+
+        /// Return a pseudo-random number in [min, max]
+        decimal random(decimal min, decimal max) {
+            mRandomState = mRandomState * 1664525u + 1013904223u;
+            return min + (max - min) * decimal(mRandomState >> 8) / decimal(1 << 24);
+        }
+
+        /// Return a random AABB (some of them are much larger than the others)
+        AABB randomAABB(int i) {
+            const Vector3 center(random(-20, 20), random(-5, 5), random(-20, 20));
+            const decimal size = i % 50 == 0 ? decimal(15.0) : random(decimal(0.2), decimal(2.0));
+            const Vector3 halfSize(size * random(decimal(0.5), 1), size * random(decimal(0.5), 1), size * random(decimal(0.5), 1));
+            return AABB(center - halfSize, center + halfSize);
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestBroadPhaseBackends(const std::string& name) : Test(name), mRandomState(1) {
+
+            mGroundShape = mPhysicsCommon.createBoxShape(Vector3(20, 1, 20));
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+        }
+
+        /// Destructor
+        virtual ~TestBroadPhaseBackends() {
+            mPhysicsCommon.destroyBoxShape(mGroundShape);
+            mPhysicsCommon.destroyBoxShape(mBoxShape);
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+        }
+
+        /// Run the tests
+        void run() {
+
+            SweepAndPruneBroadPhase sweepAndPrune(mAllocator, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE);
+            UniformGridBroadPhase grid(mAllocator, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE, decimal(2.0));
+            testBackend(sweepAndPrune);
+            testBackend(grid);
+
+            testSimulation();
+            testQueries();
+            testSnapshot();
+        }
+
+        /// Return the sorted pairs (smallest id first and without duplicates) with at least one proxy to test
+        std::vector<std::pair<int32, int32>> computeSortedPairs(BroadPhaseBackend& backend, const Array<int32>& proxiesToTest) {
+
+            Array<Pair<int32, int32>> pairs(mAllocator);
+            backend.reportAllShapesOverlappingWithShapes(proxiesToTest, pairs);
+
+            std::vector<std::pair<int32, int32>> sortedPairs;
+            for (uint32 i=0; i < pairs.size(); i++) {
+                sortedPairs.push_back(std::make_pair(std::min(pairs[i].first, pairs[i].second), std::max(pairs[i].first, pairs[i].second)));
+            }
+            std::sort(sortedPairs.begin(), sortedPairs.end());
+            sortedPairs.erase(std::unique(sortedPairs.begin(), sortedPairs.end()), sortedPairs.end());
+
+            return sortedPairs;
+        }
+
+        /// Return the sorted pairs with at least one proxy to test computed by testing all the pairs of proxies
+        std::vector<std::pair<int32, int32>> computeBruteForcePairs(BroadPhaseBackend& backend, const std::vector<int32>& proxies,
+                                                                    const Array<int32>& proxiesToTest) {
+
+            std::vector<std::pair<int32, int32>> pairs;
+            for (uint32 i=0; i < proxies.size(); i++) {
+                for (uint32 j=i+1; j < proxies.size(); j++) {
+
+                    const bool isToTest = std::find(proxiesToTest.begin(), proxiesToTest.end(), proxies[i]) != proxiesToTest.end() ||
+                                          std::find(proxiesToTest.begin(), proxiesToTest.end(), proxies[j]) != proxiesToTest.end();
+                    if (isToTest && backend.getFatAABB(proxies[i]).testCollision(backend.getFatAABB(proxies[j]))) {
+                        pairs.push_back(std::make_pair(std::min(proxies[i], proxies[j]), std::max(proxies[i], proxies[j])));
+                    }
+                }
+            }
+            std::sort(pairs.begin(), pairs.end());
+
+            return pairs;
+        }
+
+        /// Test the pairs and the AABB queries of a backend against a brute force computation
+        void testBackend(BroadPhaseBackend& backend) {
+
+            mRandomState = 1;
+            rp3d_test(backend.isEmpty());
+
+            // Add the proxies
+            std::vector<int32> proxies;
+            for (int i=0; i < 300; i++) {
+                proxies.push_back(backend.addObject(randomAABB(i), reinterpret_cast<Collider*>(mObjects + i)));
+            }
+            backend.update();
+            rp3d_test(!backend.isEmpty());
+            rp3d_test(backend.getCollider(proxies[10]) == reinterpret_cast<Collider*>(mObjects + 10));
+
+            for (int step=0; step < 6; step++) {
+
+                // Move some proxies (a few of them far away)
+                Array<int32> proxiesToTest(mAllocator);
+                for (uint32 i=0; i < proxies.size(); i++) {
+
+                    if (step % 2 == 0 && i % 7 != 0) continue;
+
+                    const AABB& aabb = backend.getFatAABB(proxies[i]);
+                    const Vector3 displacement = i % 11 == 0 ? Vector3(random(-20, 20), 0, random(-20, 20)) :
+                                                               Vector3(random(-1, 1), random(-1, 1), random(-1, 1));
+                    if (backend.updateObject(proxies[i], AABB(aabb.getMin() + displacement, aabb.getMax() + displacement))) {
+                        proxiesToTest.add(proxies[i]);
+                    }
+                }
+
+                // Remove and add a proxy
+                if (step == 3) {
+                    backend.removeObject(proxies[5]);
+                    proxies.erase(proxies.begin() + 5);
+                    const int32 proxyId = backend.addObject(randomAABB(5), reinterpret_cast<Collider*>(mObjects + 5));
+                    proxies.push_back(proxyId);
+                    proxiesToTest.add(proxyId);
+                }
+
+                backend.update();
+
+                rp3d_test(computeSortedPairs(backend, proxiesToTest) == computeBruteForcePairs(backend, proxies, proxiesToTest));
+
+                // A single proxy to test
+                Array<int32> singleProxy(mAllocator);
+                singleProxy.add(proxies[step]);
+                rp3d_test(computeSortedPairs(backend, singleProxy) == computeBruteForcePairs(backend, proxies, singleProxy));
+
+                // AABB queries (small and very large)
+                for (int q=0; q < 2; q++) {
+
+                    const AABB queryAABB = q == 0 ? AABB(Vector3(-3, -3, -3), Vector3(4, 2, 5)) : AABB(Vector3(-500, -500, -500), Vector3(500, 500, 500));
+                    Array<int32> overlappingProxies(mAllocator);
+                    backend.reportAllShapesOverlappingWithAABB(queryAABB, overlappingProxies);
+                    std::sort(overlappingProxies.begin(), overlappingProxies.end());
+
+                    std::vector<int32> expectedProxies;
+                    for (int32 proxyId : proxies) {
+                        if (queryAABB.testCollision(backend.getFatAABB(proxyId))) {
+                            expectedProxies.push_back(proxyId);
+                        }
+                    }
+                    std::sort(expectedProxies.begin(), expectedProxies.end());
+
+                    rp3d_test(overlappingProxies.size() == expectedProxies.size());
+                    rp3d_test(std::equal(expectedProxies.begin(), expectedProxies.end(), overlappingProxies.begin()));
+                }
+            }
+
+            for (int32 proxyId : proxies) {
+                backend.removeObject(proxyId);
+            }
+            rp3d_test(backend.isEmpty());
+        }
+
+        /// Test that the same simulation is computed with all the broad-phase methods
+        void testSimulation() {
+
+            BroadPhaseTestScene treeScene(mPhysicsCommon, BroadPhaseMethod::DYNAMIC_AABB_TREE, mGroundShape, mBoxShape, mSphereShape);
+            BroadPhaseTestScene sweepAndPruneScene(mPhysicsCommon, BroadPhaseMethod::SWEEP_AND_PRUNE, mGroundShape, mBoxShape, mSphereShape);
+            BroadPhaseTestScene gridScene(mPhysicsCommon, BroadPhaseMethod::UNIFORM_GRID, mGroundShape, mBoxShape, mSphereShape);
+
+            for (uint32 i=0; i < 120; i++) {
+
+                treeScene.simulate(1);
+                sweepAndPruneScene.simulate(1);
+                gridScene.simulate(1);
+
+                // The same pairs of colliders are found by the broad-phase
+                const uint32 nbOverlappingPairs = treeScene.world->getLastStepStats().nbOverlappingPairs;
+                rp3d_test(sweepAndPruneScene.world->getLastStepStats().nbOverlappingPairs == nbOverlappingPairs);
+                rp3d_test(gridScene.world->getLastStepStats().nbOverlappingPairs == nbOverlappingPairs);
+            }
+
+            // The columns are resting on the ground at the same place (the contacts may not be
+            // solved in the same order because the broad-phase ids are different)
+            for (uint32 i=0; i < treeScene.bodies.size(); i++) {
+                const Vector3 position = treeScene.bodies[i]->getTransform().getPosition();
+                rp3d_test(Vector3::approxEqual(sweepAndPruneScene.bodies[i]->getTransform().getPosition(), position, decimal(0.05)));
+                rp3d_test(Vector3::approxEqual(gridScene.bodies[i]->getTransform().getPosition(), position, decimal(0.05)));
+            }
+
+            // Destroy some bodies and add new ones
+            BroadPhaseTestScene* scenes[3] = {&treeScene, &sweepAndPruneScene, &gridScene};
+            for (BroadPhaseTestScene* scene : scenes) {
+                for (uint32 i=0; i < 20; i++) {
+                    scene->world->destroyRigidBody(scene->bodies[i * 3]);
+                }
+                RigidBody* sphere = scene->world->createRigidBody(Transform(Vector3(decimal(0.1), 10, decimal(0.2)), Quaternion::identity()));
+                sphere->addCollider(mSphereShape, Transform::identity());
+                scene->simulate(60);
+            }
+            rp3d_test(sweepAndPruneScene.world->getLastStepStats().nbOverlappingPairs == treeScene.world->getLastStepStats().nbOverlappingPairs);
+            rp3d_test(gridScene.world->getLastStepStats().nbOverlappingPairs == treeScene.world->getLastStepStats().nbOverlappingPairs);
+
+            mPhysicsCommon.destroyPhysicsWorld(treeScene.world);
+            mPhysicsCommon.destroyPhysicsWorld(sweepAndPruneScene.world);
+            mPhysicsCommon.destroyPhysicsWorld(gridScene.world);
+        }
+
+        /// Test that the world queries give the same results with all the broad-phase methods
+        void testQueries() {
+
+            BroadPhaseTestScene treeScene(mPhysicsCommon, BroadPhaseMethod::DYNAMIC_AABB_TREE, mGroundShape, mBoxShape, mSphereShape);
+            BroadPhaseTestScene sweepAndPruneScene(mPhysicsCommon, BroadPhaseMethod::SWEEP_AND_PRUNE, mGroundShape, mBoxShape, mSphereShape);
+            BroadPhaseTestScene gridScene(mPhysicsCommon, BroadPhaseMethod::UNIFORM_GRID, mGroundShape, mBoxShape, mSphereShape);
+
+            BroadPhaseTestScene* scenes[3] = {&treeScene, &sweepAndPruneScene, &gridScene};
+            for (BroadPhaseTestScene* scene : scenes) {
+
+                scene->simulate(1);
+
+                // A vertical ray through a column hits its four bodies and the ground
+                const Vector3 columnTop = scene->bodies[4 * 7 + 3]->getTransform().getPosition();
+                BroadPhaseHitCounter callback;
+                scene->world->raycast(Ray(columnTop + Vector3(0, 10, 0), columnTop - Vector3(0, 10, 0)), &callback);
+                rp3d_test(callback.nbHits == 5);
+
+                RaycastInfo raycastInfo;
+                rp3d_test(scene->world->raycastClosest(Ray(columnTop + Vector3(0, 10, 0), columnTop - Vector3(0, 10, 0)), raycastInfo));
+                rp3d_test(raycastInfo.body == scene->bodies[4 * 7 + 3]);
+                rp3d_test(!scene->world->raycastAny(Ray(columnTop + Vector3(decimal(1.25), 10, 0), columnTop + Vector3(decimal(1.25), 0, 0))));
+
+                // Volume queries
+                Array<Collider*> colliders(mAllocator);
+                scene->world->queryAABB(AABB(columnTop - Vector3(decimal(0.1), 5, decimal(0.1)), columnTop + Vector3(decimal(0.1), 0, decimal(0.1))),
+                                        colliders, ALL_COLLISION_CATEGORIES, true);
+                rp3d_test(colliders.size() == 5);
+                scene->world->querySphere(columnTop, decimal(1.0), colliders, ALL_COLLISION_CATEGORIES, true);
+                rp3d_test(colliders.size() == 2);
+
+                // Closest collider from a point above a column
+                DistanceInfo distanceInfo;
+                rp3d_test(scene->world->computeClosestCollider(*mSphereShape, Transform(columnTop + Vector3(0, 3, 0), Quaternion::identity()), distanceInfo));
+                rp3d_test(distanceInfo.collider->getBody() == scene->bodies[4 * 7 + 3]);
+                rp3d_test(approxEqual(distanceInfo.distance, decimal(2.0), decimal(0.001)));
+
+                mPhysicsCommon.destroyPhysicsWorld(scene->world);
+            }
+        }
+
+        /// Test the snapshots of the worlds with the other broad-phase methods
+        void testSnapshot() {
+
+            const BroadPhaseMethod methods[2] = {BroadPhaseMethod::SWEEP_AND_PRUNE, BroadPhaseMethod::UNIFORM_GRID};
+            for (BroadPhaseMethod method : methods) {
+
+                BroadPhaseTestScene scene(mPhysicsCommon, method, mGroundShape, mBoxShape, mSphereShape);
+                scene.simulate(20);
+
+                std::vector<uint8> snapshot;
+                scene.world->takeSnapshot(snapshot);
+
+                scene.simulate(40);
+                std::vector<Transform> transforms;
+                for (RigidBody* body : scene.bodies) {
+                    transforms.push_back(body->getTransform());
+                }
+
+                // The simulation is the same after the restore
+                rp3d_test(scene.world->restoreSnapshot(snapshot.data(), snapshot.size()));
+                scene.simulate(40);
+                for (uint32 i=0; i < scene.bodies.size(); i++) {
+                    rp3d_test(scene.bodies[i]->getTransform() == transforms[i]);
+                }
+
+                // A snapshot of a world with another broad-phase method cannot be restored
+                BroadPhaseTestScene treeScene(mPhysicsCommon, BroadPhaseMethod::DYNAMIC_AABB_TREE, mGroundShape, mBoxShape, mSphereShape);
+                rp3d_test(!treeScene.world->restoreSnapshot(snapshot.data(), snapshot.size()));
+
+                mPhysicsCommon.destroyPhysicsWorld(scene.world);
+                mPhysicsCommon.destroyPhysicsWorld(treeScene.world);
+            }
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,235 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_COLLISION_FILTERING_H
+#define TEST_COLLISION_FILTERING_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestPairFilter
+/**
+ * Pair filter that rejects all the pairs with a given body
+ */
+class TestPairFilter : public CollisionPairFilter {
+
+    public:
+
+        /// Body whose pairs are rejected
+        const Body* rejectedBody = nullptr;
+
+        /// Pairs of bodies that have been given to the filter
+        std::vector<std::pair<const Body*, const Body*>> evaluatedPairs;
+
+        virtual bool shouldCollide(const Collider* collider1, const Collider* collider2) override {
+
+            evaluatedPairs.push_back(std::make_pair(collider1->getBody(), collider2->getBody()));
+
+            return collider1->getBody() != rejectedBody && collider2->getBody() != rejectedBody;
+        }
+
+        /// Return true if the filter has been called for a given pair of bodies
+        bool hasEvaluated(const Body* body1, const Body* body2) const {
+            for (const auto& pair : evaluatedPairs) {
+                if ((pair.first == body1 && pair.second == body2) || (pair.first == body2 && pair.second == body1)) {
+                    return true;
+                }
+            }
+            return false;
+        }
+};
+
+// Class TestCollisionFiltering
+/**
+ * Unit test for the 64 bits collision categories and the collision pair filter
+ */
+class TestCollisionFiltering : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        RigidBody* mGround;
+        RigidBody* mSphere1;
+        RigidBody* mSphere2;
+        RigidBody* mSphere3;
+
+        Collider* mGroundCollider;
+        Collider* mSphere1Collider;
+        Collider* mSphere2Collider;
+        Collider* mSphere3Collider;
+
+        BoxShape* mBoxShape;
+        SphereShape* mSphereShape;
+
+        /// Create a sphere body that overlaps the ground at a given x coordinate
+        RigidBody* createSphere(decimal x, Collider*& outCollider) {
+            RigidBody* body = mWorld->createRigidBody(Transform(Vector3(x, decimal(1.4), 0), Quaternion::identity()));
+            outCollider = body->addCollider(mSphereShape, Transform::identity());
+            return body;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestCollisionFiltering(const std::string& name) : Test(name) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            mBoxShape = mPhysicsCommon.createBoxShape(Vector3(20, 1, 20));
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+
+            mGround = mWorld->createRigidBody(Transform::identity());
+            mGround->setType(BodyType::STATIC);
+            mGroundCollider = mGround->addCollider(mBoxShape, Transform::identity());
+
+            mSphere1 = createSphere(-6, mSphere1Collider);
+            mSphere2 = createSphere(0, mSphere2Collider);
+            mSphere3 = createSphere(6, mSphere3Collider);
+        }
+
+        /// Destructor
+        virtual ~TestCollisionFiltering() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+            mPhysicsCommon.destroyBoxShape(mBoxShape);
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+        }
+
+        /// Run the tests
+        void run() {
+            testCollisionCategories();
+            testPairFilter();
+        }
+
+        /// Test the collision categories and masks above the first 16 bits
+        void testCollisionCategories() {
+
+            const uint64 category40 = uint64(1) << 40;
+            const uint64 category63 = uint64(1) << 63;
+
+            // Default values
+            rp3d_test(mSphere1Collider->getCollisionCategoryBits() == 0x0001);
+            rp3d_test(mSphere1Collider->getCollideWithMaskBits() == ALL_COLLISION_CATEGORIES);
+
+            mSphere1Collider->setCollisionCategoryBits(category40);
+            mSphere2Collider->setCollisionCategoryBits(category63);
+            rp3d_test(mSphere1Collider->getCollisionCategoryBits() == category40);
+            rp3d_test(mSphere2Collider->getCollisionCategoryBits() == category63);
+
+            // The ground does not collide with the category 63
+            mGroundCollider->setCollideWithMaskBits(ALL_COLLISION_CATEGORIES & ~category63);
+            rp3d_test(mGroundCollider->getCollideWithMaskBits() == (ALL_COLLISION_CATEGORIES & ~category63));
+
+            mWorld->update(decimal(1.0) / decimal(60.0));
+
+            rp3d_test(mWorld->testOverlap(mGround, mSphere1));
+            rp3d_test(!mWorld->testOverlap(mGround, mSphere2));
+            rp3d_test(mWorld->testOverlap(mGround, mSphere3));
+            rp3d_test(mWorld->getLastStepStats().nbOverlappingPairs == 2);
+
+            // The world queries also use 64 bits masks
+            const Ray ray1(Vector3(-6, 10, 0), Vector3(-6, -10, 0));
+            const Ray ray2(Vector3(0, 10, 0), Vector3(0, -10, 0));
+            rp3d_test(mWorld->raycastAny(ray1, category40));
+            rp3d_test(!mWorld->raycastAny(ray2, category40));
+            rp3d_test(mWorld->raycastAny(ray2, category63));
+            rp3d_test(!mWorld->raycastAny(Ray(ray2.point1, ray2.point2, decimal(0.5)), category40 | (uint64(1) << 62)));
+            rp3d_test(mWorld->raycastAny(Ray(ray2.point1, ray2.point2, decimal(0.5)), category63));
+
+            Array<Collider*> colliders(mAllocator);
+            mWorld->queryAABB(AABB(Vector3(-30, -5, -30), Vector3(30, 5, 30)), colliders, category63);
+            rp3d_test(colliders.size() == 1 && colliders[0] == mSphere2Collider);
+            mWorld->queryAABB(AABB(Vector3(-30, -5, -30), Vector3(30, 5, 30)), colliders);
+            rp3d_test(colliders.size() == 4);
+
+            // Restore the default filtering
+            mGroundCollider->setCollideWithMaskBits(ALL_COLLISION_CATEGORIES);
+            mSphere1Collider->setCollisionCategoryBits(0x0001);
+            mSphere2Collider->setCollisionCategoryBits(0x0001);
+
+            mWorld->update(decimal(1.0) / decimal(60.0));
+
+            rp3d_test(mWorld->testOverlap(mGround, mSphere2));
+        }
+
+        /// Test the user filter of the pairs of colliders
+        void testPairFilter() {
+
+            TestPairFilter filter;
+            rp3d_test(mWorld->getCollisionPairFilter() == nullptr);
+            mWorld->setCollisionPairFilter(&filter);
+            rp3d_test(mWorld->getCollisionPairFilter() == &filter);
+
+            // New bodies overlapping with the ground
+            Collider* sphere4Collider;
+            Collider* sphere5Collider;
+            RigidBody* sphere4 = createSphere(-12, sphere4Collider);
+            RigidBody* sphere5 = createSphere(12, sphere5Collider);
+            filter.rejectedBody = sphere4;
+
+            // The pair of sphere 5 is rejected by the masks before the filter
+            mGroundCollider->setCollideWithMaskBits(ALL_COLLISION_CATEGORIES & ~(uint64(1) << 20));
+            sphere5Collider->setCollisionCategoryBits(uint64(1) << 20);
+
+            mWorld->update(decimal(1.0) / decimal(60.0));
+
+            rp3d_test(filter.hasEvaluated(mGround, sphere4));
+            rp3d_test(!filter.hasEvaluated(mGround, sphere5));
+            rp3d_test(!mWorld->testOverlap(mGround, sphere4));
+            rp3d_test(!mWorld->testOverlap(mGround, sphere5));
+            rp3d_test(mWorld->testOverlap(mGround, mSphere1));
+
+            // The pairs that already exist are not evaluated again
+            rp3d_test(!filter.hasEvaluated(mGround, mSphere1));
+
+            // Once the filter is removed, the rejected pair is created when the broad-phase reports it again
+            mWorld->setCollisionPairFilter(nullptr);
+            sphere4Collider->setCollideWithMaskBits(ALL_COLLISION_CATEGORIES);
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            rp3d_test(mWorld->testOverlap(mGround, sphere4));
+
+            mWorld->destroyRigidBody(sphere4);
+            mWorld->destroyRigidBody(sphere5);
+            mGroundCollider->setCollideWithMaskBits(ALL_COLLISION_CATEGORIES);
+        }
+};
+
+}
+
+#endif
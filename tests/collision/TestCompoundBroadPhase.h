@@ -0,0 +1,307 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_COMPOUND_BROAD_PHASE_H
+#define TEST_COMPOUND_BROAD_PHASE_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class CompoundTestScene
+/**
+ * Scene with a multi-collider robot on a ground and a few other bodies
+ */
+struct CompoundTestScene {
+
+    PhysicsWorld* world;
+
+    RigidBody* ground;
+    RigidBody* robot;
+    RigidBody* sphere;
+    RigidBody* crate;
+
+    /// Colliders of the robot (chassis first)
+    std::vector<Collider*> robotColliders;
+
+    /// Create the scene in a new world of the physics common
+    CompoundTestScene(PhysicsCommon& physicsCommon, BoxShape* groundShape, BoxShape* partShape, SphereShape* sphereShape,
+                      bool isCompound) {
+
+        world = physicsCommon.createPhysicsWorld();
+
+        ground = world->createRigidBody(Transform::identity());
+        ground->setType(BodyType::STATIC);
+        ground->addCollider(groundShape, Transform::identity());
+
+        // Robot made of a chassis and two arms of several segments
+        robot = world->createRigidBody(Transform(Vector3(0, decimal(1.49), 0), Quaternion::identity()));
+        robot->setIsCompoundBroadPhase(isCompound);
+        for (int i=-3; i <= 3; i++) {
+            robotColliders.push_back(robot->addCollider(partShape, Transform(Vector3(i, 0, 0), Quaternion::identity())));
+        }
+        for (int i=1; i <= 3; i++) {
+            robotColliders.push_back(robot->addCollider(partShape, Transform(Vector3(-3, i, 0), Quaternion::identity())));
+            robotColliders.push_back(robot->addCollider(partShape, Transform(Vector3(3, i, 0), Quaternion::identity())));
+        }
+        robot->updateMassPropertiesFromColliders();
+
+        // A sphere falling on the right arm and a crate (also compound) falling on the chassis
+        sphere = world->createRigidBody(Transform(Vector3(3, decimal(6.0), 0), Quaternion::identity()));
+        sphere->addCollider(sphereShape, Transform::identity());
+
+        crate = world->createRigidBody(Transform(Vector3(0, decimal(3.5), 0), Quaternion::identity()));
+        crate->setIsCompoundBroadPhase(isCompound);
+        crate->addCollider(partShape, Transform(Vector3(decimal(-0.5), 0, 0), Quaternion::identity()));
+        crate->addCollider(partShape, Transform(Vector3(decimal(0.5), 0, 0), Quaternion::identity()));
+        crate->updateMassPropertiesFromColliders();
+    }
+
+    /// Run some steps of the simulation
+    void simulate(uint32 nbSteps) {
+        for (uint32 i=0; i < nbSteps; i++) {
+            world->update(decimal(1.0) / decimal(60.0));
+        }
+    }
+};
+
+// Class CountRaycastCallback
+/**
+ * Raycast callback that counts all the hits of a ray
+ */
+class CountRaycastCallback : public RaycastCallback {
+
+    public:
+
+        uint32 nbHits = 0;
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& /*info*/) override {
+            nbHits++;
+            return decimal(1.0);
+        }
+};
+
+// Class TestCompoundBroadPhase
+/**
+ * Unit test for the bodies whose colliders are grouped under a single node of the broad-phase
+ */
+class TestCompoundBroadPhase : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        BoxShape* mGroundShape;
+        BoxShape* mPartShape;
+        SphereShape* mSphereShape;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestCompoundBroadPhase(const std::string& name) : Test(name) {
+
+            mGroundShape = mPhysicsCommon.createBoxShape(Vector3(20, 1, 20));
+            mPartShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+        }
+
+        /// Destructor
+        virtual ~TestCompoundBroadPhase() {
+            mPhysicsCommon.destroyBoxShape(mGroundShape);
+            mPhysicsCommon.destroyBoxShape(mPartShape);
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+        }
+
+        /// Run the tests
+        void run() {
+            testSimulation();
+            testQueries();
+            testChangeColliders();
+            testSnapshot();
+        }
+
+        /// Test that a compound body is simulated as the same body with its colliders in the world tree
+        void testSimulation() {
+
+            CompoundTestScene compoundScene(mPhysicsCommon, mGroundShape, mPartShape, mSphereShape, true);
+            CompoundTestScene regularScene(mPhysicsCommon, mGroundShape, mPartShape, mSphereShape, false);
+
+            rp3d_test(compoundScene.robot->isCompoundBroadPhase());
+            rp3d_test(!regularScene.robot->isCompoundBroadPhase());
+
+            for (uint32 i=0; i < 90; i++) {
+
+                compoundScene.simulate(1);
+                regularScene.simulate(1);
+
+                // The same pairs of colliders are found by the broad-phase
+                rp3d_test(compoundScene.world->getLastStepStats().nbOverlappingPairs == regularScene.world->getLastStepStats().nbOverlappingPairs);
+            }
+
+            rp3d_test(compoundScene.world->testOverlap(compoundScene.robot, compoundScene.ground));
+            rp3d_test(compoundScene.world->testOverlap(compoundScene.robot, compoundScene.sphere));
+            rp3d_test(compoundScene.world->testOverlap(compoundScene.robot, compoundScene.crate));
+
+            // The pairs are not created in the same order (the broad-phase ids are different) and so are the contacts
+            // given to the solver. Therefore, only the bodies with a simple resting contact end at the same positions.
+            rp3d_test(Vector3::approxEqual(compoundScene.robot->getTransform().getPosition(), regularScene.robot->getTransform().getPosition(), decimal(0.01)));
+            rp3d_test(Vector3::approxEqual(compoundScene.sphere->getTransform().getPosition(), regularScene.sphere->getTransform().getPosition(), decimal(0.01)));
+
+            mPhysicsCommon.destroyPhysicsWorld(compoundScene.world);
+            mPhysicsCommon.destroyPhysicsWorld(regularScene.world);
+        }
+
+        /// Test the world queries against the colliders of a compound body
+        void testQueries() {
+
+            CompoundTestScene scene(mPhysicsCommon, mGroundShape, mPartShape, mSphereShape, true);
+            scene.simulate(1);
+
+            // Closest hit on the top segment of the left arm
+            RaycastInfo raycastInfo;
+            const Vector3 armTop = scene.robot->getWorldPoint(Vector3(-3, 3, 0));
+            rp3d_test(scene.world->raycastClosest(Ray(armTop + Vector3(0, 10, 0), armTop - Vector3(0, 10, 0)), raycastInfo));
+            rp3d_test(raycastInfo.collider == scene.robotColliders[11]);
+            rp3d_test(approxEqual(raycastInfo.worldPoint.y, armTop.y + decimal(0.5), decimal(0.001)));
+
+            // All the segments of the arm and the ground are hit
+            CountRaycastCallback callback;
+            scene.world->raycast(Ray(armTop + Vector3(0, 10, 0), armTop - Vector3(0, 10, 0)), &callback);
+            rp3d_test(callback.nbHits == 5);
+
+            WorldQueryContext context(*scene.world);
+            CountRaycastCallback contextCallback;
+            context.raycast(Ray(armTop + Vector3(0, 10, 0), armTop - Vector3(0, 10, 0)), &contextCallback);
+            rp3d_test(contextCallback.nbHits == 5);
+
+            // A ray between the arms only hits the ground
+            const Vector3 betweenArms = scene.robot->getWorldPoint(Vector3(decimal(1.5), 3, 0));
+            rp3d_test(!scene.world->raycastClosest(Ray(betweenArms, betweenArms - Vector3(0, 2, 0)), raycastInfo));
+            rp3d_test(scene.world->raycastAny(Ray(betweenArms, betweenArms - Vector3(0, 10, 0))));
+
+            // Volume queries
+            Array<Collider*> colliders(mAllocator);
+            scene.world->queryAABB(AABB(armTop - Vector3(decimal(0.1), decimal(0.1), decimal(0.1)), armTop + Vector3(decimal(0.1), decimal(0.1), decimal(0.1))), colliders,
+                                   ALL_COLLISION_CATEGORIES, true);
+            rp3d_test(colliders.size() == 1 && colliders[0] == scene.robotColliders[11]);
+            scene.world->querySphere(scene.robot->getWorldPoint(Vector3(0, 0, 0)), decimal(1.2), colliders, ALL_COLLISION_CATEGORIES, true);
+            rp3d_test(colliders.size() >= 3);
+
+            // Closest collider from a point beside the left arm
+            const Vector3 besideLeftArm = scene.robot->getWorldPoint(Vector3(-5, 2, 0));
+            DistanceInfo distanceInfo;
+            rp3d_test(scene.world->computeClosestCollider(*mSphereShape, Transform(besideLeftArm, Quaternion::identity()), distanceInfo));
+            rp3d_test(distanceInfo.collider == scene.robotColliders[9]);
+            rp3d_test(approxEqual(distanceInfo.distance, decimal(1.0), decimal(0.001)));
+
+            // Overlap between bodies with a query context
+            rp3d_test(context.testOverlap(scene.robot, scene.ground));
+            rp3d_test(!context.testOverlap(scene.robot, scene.sphere));
+
+            mPhysicsCommon.destroyPhysicsWorld(scene.world);
+        }
+
+        /// Test adding and removing colliders and changing the compound option
+        void testChangeColliders() {
+
+            CompoundTestScene scene(mPhysicsCommon, mGroundShape, mPartShape, mSphereShape, true);
+            scene.simulate(5);
+            rp3d_test(scene.world->testOverlap(scene.robot, scene.ground));
+
+            // Remove the chassis segments (the arms do not touch the ground anymore)
+            for (uint32 i=0; i < 7; i++) {
+                scene.robot->removeCollider(scene.robotColliders[i]);
+            }
+            scene.simulate(1);
+            rp3d_test(!scene.world->testOverlap(scene.robot, scene.ground));
+
+            // Add a collider under the robot
+            Collider* foot = scene.robot->addCollider(mPartShape, Transform(Vector3(-3, -1, 0), Quaternion::identity()));
+            scene.simulate(1);
+            rp3d_test(scene.world->testOverlap(scene.robot, scene.ground));
+
+            // The colliders are moved to the world tree when the option is disabled
+            scene.robot->setIsCompoundBroadPhase(false);
+            rp3d_test(!scene.robot->isCompoundBroadPhase());
+            scene.simulate(1);
+            rp3d_test(scene.world->testOverlap(scene.robot, scene.ground));
+            scene.robot->setIsCompoundBroadPhase(true);
+            scene.simulate(1);
+            rp3d_test(scene.world->testOverlap(scene.robot, scene.ground));
+
+            // Disable and enable the body
+            scene.robot->setIsActive(false);
+            rp3d_test(foot->getBroadPhaseId() == -1);
+            scene.simulate(1);
+            rp3d_test(!scene.world->raycastAny(Ray(scene.robot->getWorldPoint(Vector3(-3, 10, 0)), scene.robot->getWorldPoint(Vector3(-3, decimal(0.5), 0)))));
+            scene.robot->setIsActive(true);
+            scene.simulate(1);
+            rp3d_test(scene.world->raycastAny(Ray(scene.robot->getWorldPoint(Vector3(-3, 10, 0)), scene.robot->getWorldPoint(Vector3(-3, decimal(0.5), 0)))));
+            rp3d_test(scene.world->testOverlap(scene.robot, scene.ground));
+
+            // Destroy a compound body with its colliders
+            scene.world->destroyRigidBody(scene.crate);
+            scene.simulate(1);
+
+            mPhysicsCommon.destroyPhysicsWorld(scene.world);
+        }
+
+        /// Test a snapshot of a world with compound bodies
+        void testSnapshot() {
+
+            CompoundTestScene scene(mPhysicsCommon, mGroundShape, mPartShape, mSphereShape, true);
+            scene.simulate(20);
+
+            std::vector<uint8> snapshot;
+            scene.world->takeSnapshot(snapshot);
+
+            scene.simulate(30);
+            const Transform robotTransform = scene.robot->getTransform();
+            const Transform crateTransform = scene.crate->getTransform();
+
+            // The simulation is the same after the restore
+            rp3d_test(scene.world->restoreSnapshot(snapshot.data(), snapshot.size()));
+            scene.simulate(30);
+            rp3d_test(scene.robot->getTransform() == robotTransform);
+            rp3d_test(scene.crate->getTransform() == crateTransform);
+
+            mPhysicsCommon.destroyPhysicsWorld(scene.world);
+        }
+};
+
+}
+
+#endif
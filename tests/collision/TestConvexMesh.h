@@ -29,6 +29,8 @@
 // Libraries
 #include "Test.h"
 #include <reactphysics3d/reactphysics3d.h>
+#include <cstdio>
+#include <fstream>
 
 /// Reactphysics3D namespace
 namespace reactphysics3d {
@@ -100,6 +102,7 @@ class TestConvexMesh : public Test {
         /// Run the tests
         void run() {
             test();
+            testCookedMesh();
         }
 
         void test() {
@@ -133,6 +136,61 @@ class TestConvexMesh : public Test {
             rp3d_test(Vector3::approxEqual(mConvexMesh->getBounds().getMin(), Vector3(-3, -3 ,-3)));
             rp3d_test(Vector3::approxEqual(mConvexMesh->getBounds().getMax(), Vector3(3, 3 ,3)));
         }
+
+        void testCookedMesh() {
+
+            std::vector<uint8> cookedData;
+            mPhysicsCommon.cookConvexMesh(mConvexMesh, cookedData);
+            rp3d_test(cookedData.size() > 0);
+
+            std::vector<Message> messages;
+            ConvexMesh* mesh = mPhysicsCommon.createConvexMeshFromCookedData(cookedData.data(), cookedData.size(), messages);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(messages.size() == 0);
+
+            rp3d_test(mesh->getNbVertices() == 8);
+            rp3d_test(mesh->getNbFaces() == 6);
+            rp3d_test(mesh->getVolume() == 216);
+            bool isSameData = true;
+            for (uint32 v=0; v < mConvexMesh->getNbVertices(); v++) {
+                isSameData &= mesh->getVertex(v) == mConvexMesh->getVertex(v);
+            }
+            for (uint32 f=0; f < mConvexMesh->getNbFaces(); f++) {
+                isSameData &= mesh->getFaceNormal(f) == mConvexMesh->getFaceNormal(f);
+                const HalfEdgeStructure::Face& face = mConvexMesh->getHalfEdgeStructure().getFace(f);
+                const HalfEdgeStructure::Face& cookedFace = mesh->getHalfEdgeStructure().getFace(f);
+                isSameData &= face.edgeIndex == cookedFace.edgeIndex && face.faceVertices == cookedFace.faceVertices;
+            }
+            for (uint32 e=0; e < mConvexMesh->getHalfEdgeStructure().getNbHalfEdges(); e++) {
+                const HalfEdgeStructure::Edge& edge = mConvexMesh->getHalfEdgeStructure().getHalfEdge(e);
+                const HalfEdgeStructure::Edge& cookedEdge = mesh->getHalfEdgeStructure().getHalfEdge(e);
+                isSameData &= edge.vertexIndex == cookedEdge.vertexIndex && edge.twinEdgeIndex == cookedEdge.twinEdgeIndex &&
+                              edge.faceIndex == cookedEdge.faceIndex && edge.nextEdgeIndex == cookedEdge.nextEdgeIndex;
+            }
+            rp3d_test(isSameData);
+            rp3d_test(mesh->getHalfEdgeStructure().getNbHalfEdges() == 12 * 2);
+            rp3d_test(mesh->getCentroid() == mConvexMesh->getCentroid());
+            rp3d_test(mesh->getBounds().getMin() == mConvexMesh->getBounds().getMin());
+            rp3d_test(mesh->getBounds().getMax() == mConvexMesh->getBounds().getMax());
+            mPhysicsCommon.destroyConvexMesh(mesh);
+
+            // Load the mesh from a memory-mapped file
+            const std::string filePath = "rp3d_test_convex_mesh.cooked";
+            {
+                std::ofstream file(filePath, std::ios::binary);
+                file.write(reinterpret_cast<const char*>(cookedData.data()), static_cast<std::streamsize>(cookedData.size()));
+            }
+            mesh = mPhysicsCommon.createConvexMeshFromCookedFile(filePath, messages);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(mesh->getNbFaces() == 6);
+            mPhysicsCommon.destroyConvexMesh(mesh);
+            std::remove(filePath.c_str());
+
+            // Truncated or corrupted data are rejected
+            rp3d_test(mPhysicsCommon.createConvexMeshFromCookedData(cookedData.data(), cookedData.size() - 1, messages) == nullptr);
+            cookedData[0] = 'X';
+            rp3d_test(mPhysicsCommon.createConvexMeshFromCookedData(cookedData.data(), cookedData.size(), messages) == nullptr);
+        }
  };
 
 }
@@ -0,0 +1,293 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_DISTANCE_QUERIES_H
+#define TEST_DISTANCE_QUERIES_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <cmath>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestDistanceQueries
+/**
+ * Unit test for the distance and closest point queries of the PhysicsWorld class
+ */
+class TestDistanceQueries : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        RigidBody* mGroundBody;
+        RigidBody* mSphereBody;
+        RigidBody* mPlatformBody;
+        RigidBody* mHeightFieldBody;
+
+        std::vector<Collider*> mColliders;
+
+        SphereShape* mSensorSphereShape;
+        BoxShape* mSensorBoxShape;
+
+        float mHeightFieldData[100];
+
+        // Maximum error of a distance computed with GJK
+        decimal mDistanceEpsilon;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestDistanceQueries(const std::string& name) : Test(name) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            mDistanceEpsilon = decimal(0.001);
+
+            // Ground box with its top face at y=0
+            mGroundBody = mWorld->createRigidBody(Transform(Vector3(0, -1, 0), Quaternion::identity()));
+            mGroundBody->setType(BodyType::STATIC);
+            mColliders.push_back(mGroundBody->addCollider(mPhysicsCommon.createBoxShape(Vector3(10, 1, 10)), Transform::identity()));
+
+            // Sphere obstacle above the ground
+            mSphereBody = mWorld->createRigidBody(Transform(Vector3(5, 3, 0), Quaternion::identity()));
+            mSphereBody->setType(BodyType::STATIC);
+            mColliders.push_back(mSphereBody->addCollider(mPhysicsCommon.createSphereShape(decimal(1.0)), Transform::identity()));
+
+            // Platform in another category with its top face at y=0.5
+            mPlatformBody = mWorld->createRigidBody(Transform(Vector3(20, 0, 0), Quaternion::identity()));
+            mPlatformBody->setType(BodyType::STATIC);
+            mColliders.push_back(mPlatformBody->addCollider(mPhysicsCommon.createBoxShape(Vector3(2, decimal(0.5), 2)), Transform::identity()));
+            mColliders.back()->setCollisionCategoryBits(0x0002);
+
+            // Flat height field with its surface at y=-2
+            for (int i=0; i < 100; i++) mHeightFieldData[i] = 0.0f;
+            std::vector<Message> messages;
+            HeightField* heightField = mPhysicsCommon.createHeightField(10, 10, mHeightFieldData, HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+            mHeightFieldBody = mWorld->createRigidBody(Transform(Vector3(-20, -2, 0), Quaternion::identity()));
+            mHeightFieldBody->setType(BodyType::STATIC);
+            mColliders.push_back(mHeightFieldBody->addCollider(mPhysicsCommon.createHeightFieldShape(heightField), Transform::identity()));
+
+            // Rotated capsules and boxes scattered above the ground
+            for (int i=0; i < 4; i++) {
+                for (int j=0; j < 4; j++) {
+
+                    const Vector3 position(decimal(-7.5) + decimal(5.0) * i, decimal(1.5) + decimal(0.5) * ((i + j) % 3), decimal(-7.5) + decimal(5.0) * j);
+                    RigidBody* body = mWorld->createRigidBody(Transform(position, Quaternion::fromEulerAngles(decimal(0.4) * i, decimal(0.3) * j, 0)));
+                    body->setType(BodyType::STATIC);
+                    if ((i + j) % 2 == 0) {
+                        mColliders.push_back(body->addCollider(mPhysicsCommon.createCapsuleShape(decimal(0.3), decimal(1.0)), Transform::identity()));
+                    }
+                    else {
+                        mColliders.push_back(body->addCollider(mPhysicsCommon.createBoxShape(Vector3(decimal(0.6), decimal(0.3), decimal(0.4))), Transform::identity()));
+                    }
+                }
+            }
+
+            mSensorSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+            mSensorBoxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+
+            // Compute the AABBs of the colliders in the broad-phase
+            mWorld->update(decimal(1.0) / decimal(60.0));
+        }
+
+        /// Destructor
+        virtual ~TestDistanceQueries() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testDistanceToCollider();
+            testOverlap();
+            testClosestCollider();
+            testClosestColliderBruteForce();
+            testBatchedQueries();
+        }
+
+        void testDistanceToCollider() {
+
+            // Sensor above the sphere obstacle
+            DistanceInfo info;
+            rp3d_test(mWorld->computeDistance(*mSensorSphereShape, Transform(Vector3(5, 6, 0), Quaternion::identity()), mColliders[1], info));
+            rp3d_test(info.body == mSphereBody);
+            rp3d_test(info.collider == mColliders[1]);
+            rp3d_test(approxEqual(info.distance, decimal(1.5), mDistanceEpsilon));
+            rp3d_test(Vector3::approxEqual(info.worldPoint1, Vector3(5, decimal(5.5), 0), decimal(0.01)));
+            rp3d_test(Vector3::approxEqual(info.worldPoint2, Vector3(5, 4, 0), decimal(0.01)));
+            rp3d_test(Vector3::approxEqual(info.worldNormal, Vector3(0, -1, 0), decimal(0.01)));
+
+            // Sensor above the ground
+            rp3d_test(mWorld->computeDistance(*mSensorSphereShape, Transform(Vector3(0, 2, 0), Quaternion::identity()), mColliders[0], info));
+            rp3d_test(approxEqual(info.distance, decimal(1.5), mDistanceEpsilon));
+            rp3d_test(Vector3::approxEqual(info.worldPoint2, Vector3(0, 0, 0), decimal(0.01)));
+
+            // The collider is farther than the maximum distance
+            rp3d_test(!mWorld->computeDistance(*mSensorSphereShape, Transform(Vector3(0, 2, 0), Quaternion::identity()), mColliders[0], info, decimal(1.0)));
+            rp3d_test(info.body == nullptr);
+            rp3d_test(info.collider == nullptr);
+
+            // Box sensor above the height field
+            rp3d_test(mWorld->computeDistance(*mSensorBoxShape, Transform(Vector3(-20, 1, decimal(0.3)), Quaternion::identity()), mColliders[3], info));
+            rp3d_test(info.body == mHeightFieldBody);
+            rp3d_test(approxEqual(info.distance, decimal(2.5), mDistanceEpsilon));
+            rp3d_test(approxEqual(info.worldPoint2.y, decimal(-2.0), decimal(0.01)));
+            rp3d_test(Vector3::approxEqual(info.worldNormal, Vector3(0, -1, 0), decimal(0.01)));
+
+            // Sensor next to the height field (the closest point is on its border)
+            rp3d_test(mWorld->computeDistance(*mSensorSphereShape, Transform(Vector3(-30, -2, 0), Quaternion::identity()), mColliders[3], info));
+            rp3d_test(approxEqual(info.distance, decimal(5.0), mDistanceEpsilon));
+        }
+
+        void testOverlap() {
+
+            // The sensor slightly penetrates the ground
+            DistanceInfo info;
+            rp3d_test(mWorld->computeDistance(*mSensorSphereShape, Transform(Vector3(0, decimal(0.2), 0), Quaternion::identity()), mColliders[0], info));
+            rp3d_test(approxEqual(info.distance, decimal(0.0)));
+            rp3d_test(Vector3::approxEqual(info.worldNormal, Vector3(0, -1, 0), decimal(0.01)));
+
+            // The center of the sensor is inside the ground
+            rp3d_test(mWorld->computeDistance(*mSensorSphereShape, Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()), mColliders[0], info));
+            rp3d_test(approxEqual(info.distance, decimal(0.0)));
+            rp3d_test(Vector3::approxEqual(info.worldNormal, Vector3(0, 0, 0)));
+
+            rp3d_test(mWorld->computeClosestCollider(*mSensorSphereShape, Transform(Vector3(0, decimal(-0.5), 0), Quaternion::identity()), info));
+            rp3d_test(info.body == mGroundBody);
+            rp3d_test(approxEqual(info.distance, decimal(0.0)));
+        }
+
+        void testClosestCollider() {
+
+            // The sphere obstacle is closer than the ground
+            DistanceInfo info;
+            rp3d_test(mWorld->computeClosestCollider(*mSensorSphereShape, Transform(Vector3(5, decimal(5.5), 0), Quaternion::identity()), info));
+            rp3d_test(info.body == mSphereBody);
+            rp3d_test(approxEqual(info.distance, decimal(1.0), mDistanceEpsilon));
+
+            // The ground is closer than the sphere obstacle
+            rp3d_test(mWorld->computeClosestCollider(*mSensorSphereShape, Transform(Vector3(0, 1, decimal(2.5)), Quaternion::identity()), info));
+            rp3d_test(info.body == mGroundBody);
+            rp3d_test(approxEqual(info.distance, decimal(0.5), mDistanceEpsilon));
+
+            // Category mask
+            const Transform platformSensorTransform(Vector3(20, 3, 0), Quaternion::identity());
+            rp3d_test(mWorld->computeClosestCollider(*mSensorSphereShape, platformSensorTransform, info));
+            rp3d_test(info.body == mPlatformBody);
+            rp3d_test(approxEqual(info.distance, decimal(2.0), mDistanceEpsilon));
+
+            rp3d_test(mWorld->computeClosestCollider(*mSensorSphereShape, platformSensorTransform, info, DECIMAL_LARGEST, 0x0001));
+            rp3d_test(info.body == mGroundBody);
+            rp3d_test(approxEqual(info.distance, std::sqrt(decimal(109.0)) - decimal(0.5), mDistanceEpsilon));
+
+            // Maximum distance
+            rp3d_test(!mWorld->computeClosestCollider(*mSensorSphereShape, platformSensorTransform, info, decimal(5.0), 0x0001));
+            rp3d_test(info.body == nullptr);
+            rp3d_test(mWorld->computeClosestCollider(*mSensorSphereShape, platformSensorTransform, info, decimal(2.5)));
+            rp3d_test(info.body == mPlatformBody);
+        }
+
+        void testClosestColliderBruteForce() {
+
+            // Compare the closest collider of the world with the distances to all the colliders
+            int nbMismatches = 0;
+            for (int i=0; i < 9; i++) {
+                for (int j=0; j < 5; j++) {
+                    for (int k=0; k < 5; k++) {
+
+                        const Transform transform(Vector3(decimal(-24) + decimal(6) * i, decimal(0.8) + decimal(1.3) * j, decimal(-9) + decimal(4.5) * k),
+                                                  Quaternion::fromEulerAngles(decimal(0.2) * j, decimal(0.5) * i, decimal(0.1) * k));
+                        const ConvexShape& shape = (i + j + k) % 2 == 0 ? static_cast<const ConvexShape&>(*mSensorSphereShape) : *mSensorBoxShape;
+
+                        decimal minDistance = DECIMAL_LARGEST;
+                        for (uint32 c=0; c < mColliders.size(); c++) {
+
+                            DistanceInfo colliderInfo;
+                            if (mWorld->computeDistance(shape, transform, mColliders[c], colliderInfo) && colliderInfo.distance < minDistance) {
+                                minDistance = colliderInfo.distance;
+                            }
+                        }
+
+                        DistanceInfo info;
+                        if (!mWorld->computeClosestCollider(shape, transform, info) ||
+                            !approxEqual(info.distance, minDistance, mDistanceEpsilon)) {
+                            nbMismatches++;
+                        }
+                    }
+                }
+            }
+
+            rp3d_test(nbMismatches == 0);
+        }
+
+        void testBatchedQueries() {
+
+            Array<DistanceQuery> queries(mAllocator);
+            queries.add(DistanceQuery(mSensorSphereShape, Transform(Vector3(5, decimal(5.5), 0), Quaternion::identity())));
+            queries.add(DistanceQuery(mSensorBoxShape, Transform(Vector3(-20, 1, decimal(0.3)), Quaternion::identity())));
+            queries.add(DistanceQuery(mSensorSphereShape, Transform(Vector3(20, 3, 0), Quaternion::identity()), decimal(1.0)));
+            queries.add(DistanceQuery(mSensorBoxShape, Transform(Vector3(0, 1, decimal(2.5)), Quaternion::identity()), decimal(5.0)));
+            queries.add(DistanceQuery(mSensorSphereShape, Transform(Vector3(0, 40, 0), Quaternion::identity()), decimal(10.0)));
+
+            // The output array is cleared before the results are written
+            Array<DistanceInfo> infos(mAllocator);
+            infos.add(DistanceInfo());
+
+            rp3d_test(mWorld->computeClosestColliders(queries, infos) == 3);
+            rp3d_test(infos.size() == queries.size());
+
+            // The batched results are the same as the results of the single queries
+            for (uint32 i=0; i < queries.size(); i++) {
+
+                DistanceInfo info;
+                const bool isFound = mWorld->computeClosestCollider(*queries[i].shape, queries[i].transform, info, queries[i].maxDistance);
+                rp3d_test(isFound == (infos[i].collider != nullptr));
+                rp3d_test(infos[i].body == info.body);
+                rp3d_test(infos[i].collider == info.collider);
+                rp3d_test(approxEqual(infos[i].distance, info.distance));
+                rp3d_test(Vector3::approxEqual(infos[i].worldPoint1, info.worldPoint1));
+                rp3d_test(Vector3::approxEqual(infos[i].worldPoint2, info.worldPoint2));
+            }
+
+            rp3d_test(infos[1].body == mHeightFieldBody);
+            rp3d_test(infos[2].body == nullptr);
+        }
+};
+
+}
+
+#endif
@@ -136,9 +136,20 @@ class TestDynamicAABBTree : public Test {
             testBasicsMethods();
             testOverlapping();
             testRaycast();
+            testRefit();
+            testRefitWorld();
 
         }
 
+        /// Return the sorted nodes overlapping with an AABB
+        Array<int> computeSortedOverlappingNodes(const DynamicAABBTree& tree, const AABB& aabb) {
+
+            Array<int> overlappingNodes(mAllocator);
+            tree.reportAllShapesOverlappingWithAABB(aabb, overlappingNodes);
+            std::sort(overlappingNodes.begin(), overlappingNodes.end());
+            return overlappingNodes;
+        }
+
         void testBasicsMethods() {
 
             // ------------ Create tree ---------- //
@@ -560,6 +571,131 @@ class TestDynamicAABBTree : public Test {
             rp3d_test(mRaycastCallback.isHit(object4Id));
 
         }
+
+        void testRefit() {
+
+            // ------------- Create trees ----------- //
+
+            // The same objects are moved in a tree updated with reinsertions and in a refitted tree
+            DynamicAABBTree treeReinsert(mAllocator, decimal(0.1));
+            DynamicAABBTree treeRefit(mAllocator, decimal(0.1));
+#ifdef IS_RP3D_PROFILING_ENABLED
+
+            treeReinsert.setProfiler(mProfiler);
+            treeRefit.setProfiler(mProfiler);
+#endif
+
+            const int nbObjects = 200;
+            std::vector<int> objectIds;
+            for (int i=0; i < nbObjects; i++) {
+
+                const Vector3 position(decimal(i % 10) * 3, decimal((i / 10) % 5) * 3, decimal(i / 50) * 3);
+                const AABB aabb(position, position + Vector3(1, 1, 1));
+                const int objectId = treeReinsert.addObject(aabb, static_cast<uint32>(i));
+                rp3d_test(treeRefit.addObject(aabb, static_cast<uint32>(i)) == objectId);
+                objectIds.push_back(objectId);
+            }
+
+            const AABB queryAABB1(Vector3(-2, -2, -2), Vector3(8, 8, 8));
+            const AABB queryAABB2(Vector3(10, 0, 0), Vector3(20, 5, 12));
+            const AABB queryAABB3(Vector3(-50, -50, -50), Vector3(50, 50, 50));
+
+            // ---------- Tests ---------- //
+
+            for (int step=1; step <= 20; step++) {
+
+                // Move the objects (some of them move out of their fat AABB)
+                for (int i=0; i < nbObjects; i++) {
+
+                    const Vector3 position(decimal(i % 10) * 3 + std::sin(decimal(step + i)) * decimal(i % 7),
+                                           decimal((i / 10) % 5) * 3 + std::cos(decimal(step * i)) * 2,
+                                           decimal(i / 50) * 3 + decimal(step % 3) * decimal(i % 2));
+                    const AABB aabb(position, position + Vector3(1, 1, 1));
+                    const bool hasBeenReinserted = treeReinsert.updateObject(objectIds[i], aabb);
+                    rp3d_test(treeRefit.refitObject(objectIds[i], aabb) == hasBeenReinserted);
+                }
+
+                const uint32 nbRotations = treeRefit.refit(8);
+                rp3d_test(nbRotations <= 8);
+
+                // Both trees must contain the same fat AABBs
+                rp3d_test(treeRefit.getRootAABB().getMin() == treeReinsert.getRootAABB().getMin());
+                rp3d_test(treeRefit.getRootAABB().getMax() == treeReinsert.getRootAABB().getMax());
+                for (int i=0; i < nbObjects; i++) {
+                    rp3d_test(treeRefit.getFatAABB(objectIds[i]).getMin() == treeReinsert.getFatAABB(objectIds[i]).getMin());
+                    rp3d_test(treeRefit.getFatAABB(objectIds[i]).getMax() == treeReinsert.getFatAABB(objectIds[i]).getMax());
+                }
+
+                // Both trees must report the same overlapping objects
+                rp3d_test(computeSortedOverlappingNodes(treeRefit, queryAABB1) == computeSortedOverlappingNodes(treeReinsert, queryAABB1));
+                rp3d_test(computeSortedOverlappingNodes(treeRefit, queryAABB2) == computeSortedOverlappingNodes(treeReinsert, queryAABB2));
+                rp3d_test(computeSortedOverlappingNodes(treeRefit, queryAABB3).size() == static_cast<uint64>(nbObjects));
+            }
+
+            // The number of rotations is bounded
+            for (int i=0; i < nbObjects; i++) {
+                const Vector3 position(decimal(nbObjects - i) * decimal(0.5), 0, 0);
+                treeRefit.refitObject(objectIds[i], AABB(position, position + Vector3(1, 1, 1)));
+            }
+            rp3d_test(treeRefit.refit(0) == 0);
+
+            // Force an object to shrink its fat AABB
+            const AABB smallAABB(Vector3(1, 1, 1), Vector3(decimal(1.5), decimal(1.5), decimal(1.5)));
+            rp3d_test(treeRefit.refitObject(objectIds[0], smallAABB, true));
+            treeRefit.refit(8);
+            rp3d_test(treeRefit.getFatAABB(objectIds[0]).contains(smallAABB));
+            rp3d_test(treeRefit.getFatAABB(objectIds[0]).getMax().x < decimal(1.6));
+
+            Array<int> overlappingNodes(mAllocator);
+            treeRefit.reportAllShapesOverlappingWithAABB(AABB(Vector3(decimal(1.2), decimal(1.2), decimal(1.2)),
+                                                              Vector3(decimal(1.3), decimal(1.3), decimal(1.3))), overlappingNodes);
+            rp3d_test(isOverlapping(objectIds[0], overlappingNodes));
+        }
+
+        void testRefitWorld() {
+
+            // Simulate spheres falling on the ground in worlds with both tree update methods
+            int nbOverlappingPairs[2];
+            for (int m=0; m < 2; m++) {
+
+                PhysicsWorld::WorldSettings settings;
+                settings.broadPhaseTreeUpdateMethod = m == 0 ? DynamicAABBTreeUpdateMethod::REINSERT :
+                                                               DynamicAABBTreeUpdateMethod::REFIT;
+                settings.broadPhaseMaxNbTreeRotations = 4;
+                PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+                RigidBody* ground = world->createRigidBody(Transform::identity());
+                ground->setType(BodyType::STATIC);
+                BoxShape* groundShape = mPhysicsCommon.createBoxShape(Vector3(20, 1, 20));
+                ground->addCollider(groundShape, Transform::identity());
+
+                SphereShape* sphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+                std::vector<RigidBody*> spheres;
+                for (int i=0; i < 50; i++) {
+                    const Vector3 position(decimal(i % 5) * 2 - 4, decimal(2 + i / 25 * 2), decimal((i / 5) % 5) * 2 - 4);
+                    RigidBody* sphere = world->createRigidBody(Transform(position, Quaternion::identity()));
+                    sphere->addCollider(sphereShape, Transform::identity());
+                    spheres.push_back(sphere);
+                }
+
+                for (int i=0; i < 120; i++) {
+                    world->update(decimal(1.0) / decimal(60.0));
+                }
+
+                // All the spheres must rest on the ground
+                for (RigidBody* sphere : spheres) {
+                    rp3d_test(sphere->getTransform().getPosition().y > decimal(1.0));
+                }
+
+                nbOverlappingPairs[m] = static_cast<int>(world->getLastStepStats().nbOverlappingPairs);
+
+                mPhysicsCommon.destroyPhysicsWorld(world);
+                mPhysicsCommon.destroySphereShape(sphereShape);
+                mPhysicsCommon.destroyBoxShape(groundShape);
+            }
+
+            rp3d_test(nbOverlappingPairs[0] == nbOverlappingPairs[1]);
+        }
  };
 
 }
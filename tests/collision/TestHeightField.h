@@ -29,6 +29,12 @@
 // Libraries
 #include "Test.h"
 #include <reactphysics3d/reactphysics3d.h>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <algorithm>
+#include <vector>
+#include <thread>
 
 /// Reactphysics3D namespace
 namespace reactphysics3d {
@@ -90,6 +96,9 @@ class TestHeightField : public Test {
         void run() {
             testHeightField();
             testHeightFieldScaled();
+            testHeightFieldReference();
+            testHeightFieldQuantized();
+            testHeightFieldTiledFile();
         }
 
         void testHeightField() {
@@ -157,6 +166,190 @@ class TestHeightField : public Test {
             rp3d_test(Vector3::approxEqual(mHeightFieldScaled->getVertexAt(1, 1), Vector3(0.5, 3, 0)));
             rp3d_test(Vector3::approxEqual(mHeightFieldScaled->getVertexAt(1, 2), Vector3(0.5, 6, 1)));
         }
+
+        void testHeightFieldReference() {
+
+            float heightData[2 * 3] = {0.0, 0.0, 1.0, 3.0, 2.0, 4.0};
+
+            // Create a height-field that references the user data
+            std::vector<rp3d::Message> messages;
+            HeightField* heightField = mPhysicsCommon.createHeightField(2, 3, heightData,
+                                                                        rp3d::HeightField::HeightDataType::HEIGHT_FLOAT_TYPE,
+                                                                        messages, 1.0,
+                                                                        rp3d::HeightField::HeightStorageType::REFERENCE);
+            rp3d_test(heightField != nullptr);
+            rp3d_test(heightField->getHeightStorageType() == rp3d::HeightField::HeightStorageType::REFERENCE);
+
+            rp3d_test(heightField->getMinHeight() == 0);
+            rp3d_test(heightField->getMaxHeight() == 4);
+            rp3d_test(heightField->getHeightAt(0, 1) == 1.0);
+            rp3d_test(heightField->getHeightAt(1, 2) == 4.0);
+            rp3d_test(Vector3::approxEqual(heightField->getBounds().getMin(), Vector3(-0.5, -2, -1)));
+            rp3d_test(Vector3::approxEqual(heightField->getBounds().getMax(), Vector3(0.5, 2, 1)));
+            rp3d_test(Vector3::approxEqual(heightField->getVertexAt(1, 1), Vector3(0.5, 1, 0)));
+
+            // The height values are not copied
+            heightData[3] = 2.0;
+            rp3d_test(heightField->getHeightAt(1, 1) == 2.0);
+
+            mPhysicsCommon.destroyHeightField(heightField);
+        }
+
+        void testHeightFieldQuantized() {
+
+            int heightData[2 * 3] = {0, 0, 1, 3, 2, 4};
+
+            // Create a height-field with quantized height values
+            std::vector<rp3d::Message> messages;
+            HeightField* heightField = mPhysicsCommon.createHeightField(2, 3, heightData,
+                                                                        rp3d::HeightField::HeightDataType::HEIGHT_INT_TYPE,
+                                                                        messages, 3.0,
+                                                                        rp3d::HeightField::HeightStorageType::QUANTIZED);
+            rp3d_test(heightField != nullptr);
+            rp3d_test(heightField->getHeightStorageType() == rp3d::HeightField::HeightStorageType::QUANTIZED);
+
+            rp3d_test(approxEqual(heightField->getMinHeight(), 0, 0.001));
+            rp3d_test(approxEqual(heightField->getMaxHeight(), 12, 0.001));
+            rp3d_test(approxEqual(heightField->getHeightAt(0, 0), 0, 0.001));
+            rp3d_test(approxEqual(heightField->getHeightAt(0, 1), 3, 0.001));
+            rp3d_test(approxEqual(heightField->getHeightAt(0, 2), 6, 0.001));
+            rp3d_test(approxEqual(heightField->getHeightAt(1, 1), 9, 0.001));
+            rp3d_test(approxEqual(heightField->getHeightAt(1, 2), 12, 0.001));
+            rp3d_test(Vector3::approxEqual(heightField->getBounds().getMin(), Vector3(-0.5, -6, -1), 0.001));
+            rp3d_test(Vector3::approxEqual(heightField->getBounds().getMax(), Vector3(0.5, 6, 1), 0.001));
+
+            mPhysicsCommon.destroyHeightField(heightField);
+
+            // A flat height-field
+            int flatHeightData[2 * 2] = {5, 5, 5, 5};
+            heightField = mPhysicsCommon.createHeightField(2, 2, flatHeightData,
+                                                           rp3d::HeightField::HeightDataType::HEIGHT_INT_TYPE,
+                                                           messages, 1.0,
+                                                           rp3d::HeightField::HeightStorageType::QUANTIZED);
+            rp3d_test(heightField != nullptr);
+            rp3d_test(heightField->getMinHeight() == 5);
+            rp3d_test(heightField->getMaxHeight() == 5);
+            rp3d_test(heightField->getHeightAt(1, 1) == 5);
+
+            mPhysicsCommon.destroyHeightField(heightField);
+        }
+
+        void testHeightFieldTiledFile() {
+
+            const std::string filePath = "rp3d_test_height_field.tiles";
+
+            // Create a 10x7 grid of heights stored in 3x3 tiles
+            const int nbColumns = 10;
+            const int nbRows = 7;
+            double heightData[nbColumns * nbRows];
+            for (int i=0; i < nbColumns * nbRows; i++) {
+                heightData[i] = (i % 5) * 0.5 - 1.0;
+            }
+
+            std::vector<rp3d::Message> messages;
+            rp3d_test(HeightField::writeTiledFile(filePath, nbColumns, nbRows, heightData,
+                                                  rp3d::HeightField::HeightDataType::HEIGHT_DOUBLE_TYPE,
+                                                  messages, 1.0, 3));
+
+            // The cache can only contain the four tiles overlapped by a grid cell
+            HeightField* heightField = mPhysicsCommon.createHeightField(filePath, messages, 1);
+            rp3d_test(heightField != nullptr);
+            rp3d_test(heightField->getHeightStorageType() == rp3d::HeightField::HeightStorageType::TILED_FILE);
+            rp3d_test(heightField->getNbColumns() == nbColumns);
+            rp3d_test(heightField->getNbRows() == nbRows);
+            rp3d_test(heightField->getHeightDataType() == rp3d::HeightField::HeightDataType::HEIGHT_DOUBLE_TYPE);
+            rp3d_test(approxEqual(heightField->getMinHeight(), -1.0, 0.001));
+            rp3d_test(approxEqual(heightField->getMaxHeight(), 1.0, 0.001));
+
+            // No tile is decoded before the first query
+            rp3d_test(heightField->getNbTileLoads() == 0);
+            rp3d_test(heightField->getNbCachedTiles() == 0);
+
+            bool isHeightCorrect = true;
+            for (int y=0; y < nbRows; y++) {
+                for (int x=0; x < nbColumns; x++) {
+                    isHeightCorrect &= approxEqual(heightField->getHeightAt(x, y), heightData[y * nbColumns + x], 0.001);
+                }
+            }
+            rp3d_test(isHeightCorrect);
+
+            // The tiles have been evicted to respect the memory budget
+            rp3d_test(heightField->getNbCachedTiles() == 4);
+            rp3d_test(heightField->getNbTileLoads() == 12);
+
+            // A cached tile is not decoded again
+            heightField->getHeightAt(nbColumns - 1, nbRows - 1);
+            rp3d_test(heightField->getNbTileLoads() == 12);
+
+            mPhysicsCommon.destroyHeightField(heightField);
+
+            // Write the same file with the other endianness (the header has 8 magic bytes, six 32-bits
+            // integers and five doubles and it is followed by the 16-bits quantized heights)
+            const std::string swappedFilePath = "rp3d_test_height_field_swapped.tiles";
+            std::ifstream inputFile(filePath, std::ios::binary);
+            std::vector<char> bytes((std::istreambuf_iterator<char>(inputFile)), std::istreambuf_iterator<char>());
+            inputFile.close();
+            for (size_t i=8; i < 32; i += 4) std::reverse(bytes.begin() + i, bytes.begin() + i + 4);
+            for (size_t i=32; i < 72; i += 8) std::reverse(bytes.begin() + i, bytes.begin() + i + 8);
+            for (size_t i=72; i + 1 < bytes.size(); i += 2) std::reverse(bytes.begin() + i, bytes.begin() + i + 2);
+            std::ofstream swappedFile(swappedFilePath, std::ios::binary);
+            swappedFile.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+            swappedFile.close();
+
+            // The values of the file are byte-swapped when the tiles are decoded
+            heightField = mPhysicsCommon.createHeightField(swappedFilePath, messages);
+            rp3d_test(heightField != nullptr);
+            rp3d_test(heightField->getNbColumns() == nbColumns);
+            rp3d_test(heightField->getNbRows() == nbRows);
+            rp3d_test(approxEqual(heightField->getMinHeight(), -1.0, 0.001));
+            rp3d_test(approxEqual(heightField->getMaxHeight(), 1.0, 0.001));
+            isHeightCorrect = true;
+            for (int y=0; y < nbRows; y++) {
+                for (int x=0; x < nbColumns; x++) {
+                    isHeightCorrect &= approxEqual(heightField->getHeightAt(x, y), heightData[y * nbColumns + x], 0.001);
+                }
+            }
+            rp3d_test(isHeightCorrect);
+            mPhysicsCommon.destroyHeightField(heightField);
+            std::remove(swappedFilePath.c_str());
+
+            // The tile cache can be used by several threads at the same time (the tiles are constantly
+            // evicted because the cache is smaller than the number of tiles)
+            heightField = mPhysicsCommon.createHeightField(filePath, messages, 1);
+            rp3d_test(heightField != nullptr);
+            const int nbThreads = 4;
+            bool isThreadHeightCorrect[nbThreads];
+            std::vector<std::thread> threads;
+            for (int t=0; t < nbThreads; t++) {
+                threads.emplace_back([&, t]() {
+                    bool isCorrect = true;
+                    for (int i=0; i < 200; i++) {
+                        for (int y=0; y < nbRows; y++) {
+                            for (int x=0; x < nbColumns; x++) {
+                                const int column = (t % 2 == 0) ? x : nbColumns - 1 - x;
+                                isCorrect &= approxEqual(heightField->getHeightAt(column, y), heightData[y * nbColumns + column], 0.001);
+                            }
+                        }
+                    }
+                    isThreadHeightCorrect[t] = isCorrect;
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            for (int t=0; t < nbThreads; t++) {
+                rp3d_test(isThreadHeightCorrect[t]);
+            }
+            rp3d_test(heightField->getNbCachedTiles() == 4);
+            mPhysicsCommon.destroyHeightField(heightField);
+
+            // An invalid file cannot be used to create a height-field
+            messages.clear();
+            rp3d_test(mPhysicsCommon.createHeightField("rp3d_missing_height_field.tiles", messages) == nullptr);
+            rp3d_test(messages.size() == 1);
+
+            std::remove(filePath.c_str());
+        }
  };
 
 }
@@ -0,0 +1,245 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_PREDICTIVE_FAT_AABBS_H
+#define TEST_PREDICTIVE_FAT_AABBS_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/collision/broadphase/SweepAndPruneBroadPhase.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestPredictiveFatAABBs
+/**
+ * Unit test for the velocity-predictive fat AABBs of the broad-phase and the reinsertion counter
+ */
+class TestPredictiveFatAABBs : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        BoxShape* mGroundShape;
+        SphereShape* mSphereShape;
+
+        /// Create a world with some spheres thrown at a given velocity above a ground
+        PhysicsWorld* createWorld(bool isPredictive, const Vector3& gravity, const Vector3& velocity,
+                                  std::vector<RigidBody*>& spheres) {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.gravity = gravity;
+            settings.isSleepingEnabled = false;
+            settings.isPredictiveFatAABBEnabled = isPredictive;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            RigidBody* ground = world->createRigidBody(Transform::identity());
+            ground->setType(BodyType::STATIC);
+            ground->addCollider(mGroundShape, Transform::identity());
+
+            for (int i=0; i < 16; i++) {
+                const Vector3 position(decimal(i % 4) * decimal(3.0) - decimal(4.5), decimal(3.0) + decimal(i / 4),
+                                       decimal(i / 4) * decimal(3.0) - decimal(4.5));
+                RigidBody* sphere = world->createRigidBody(Transform(position, Quaternion::identity()));
+                sphere->addCollider(mSphereShape, Transform::identity());
+                sphere->setLinearVelocity(velocity);
+                spheres.push_back(sphere);
+            }
+
+            return world;
+        }
+
+        /// Run some steps of the simulation and return the total number of broad-phase reinsertions
+        uint32 simulate(PhysicsWorld* world, uint32 nbSteps) {
+
+            uint32 nbReinsertions = 0;
+            for (uint32 i=0; i < nbSteps; i++) {
+                world->update(decimal(1.0) / decimal(60.0));
+                nbReinsertions += world->getLastStepStats().nbBroadPhaseReinsertions;
+            }
+            return nbReinsertions;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestPredictiveFatAABBs(const std::string& name) : Test(name) {
+
+            mGroundShape = mPhysicsCommon.createBoxShape(Vector3(20, 1, 20));
+            mSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+        }
+
+        /// Destructor
+        virtual ~TestPredictiveFatAABBs() {
+            mPhysicsCommon.destroyBoxShape(mGroundShape);
+            mPhysicsCommon.destroySphereShape(mSphereShape);
+        }
+
+        /// Run the tests
+        void run() {
+
+            testGivenFatAABB();
+            testReinsertions();
+            testContacts();
+            testSnapshot();
+        }
+
+        /// Test the update of the trees and the backends with a given fat AABB
+        void testGivenFatAABB() {
+
+            const AABB aabb(Vector3(-1, -1, -1), Vector3(1, 1, 1));
+            const AABB movedAABB(Vector3(0, -1, -1), Vector3(2, 1, 1));
+            const AABB fatAABB(Vector3(-1, -2, -2), Vector3(6, 2, 2));
+
+            int object = 0;
+            DynamicAABBTree tree(mAllocator, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE);
+            const int32 nodeId = tree.addObject(aabb, &object);
+
+            // The node is reinserted with the given fat AABB
+            rp3d_test(tree.updateObject(nodeId, movedAABB, fatAABB));
+            rp3d_test(tree.getFatAABB(nodeId).getMin() == fatAABB.getMin());
+            rp3d_test(tree.getFatAABB(nodeId).getMax() == fatAABB.getMax());
+
+            // Nothing is done while the AABB stays inside the fat AABB
+            const AABB nextAABB(Vector3(3, -1, -1), Vector3(5, 1, 1));
+            rp3d_test(!tree.updateObject(nodeId, nextAABB, AABB(Vector3(2, -2, -2), Vector3(9, 2, 2))));
+            rp3d_test(tree.getFatAABB(nodeId).getMax() == fatAABB.getMax());
+
+            // Except if the update is forced
+            rp3d_test(tree.refitObject(nodeId, nextAABB, nextAABB, true));
+            tree.refit(0);
+            rp3d_test(tree.getFatAABB(nodeId).getMin() == nextAABB.getMin());
+            rp3d_test(tree.getFatAABB(nodeId).getMax() == nextAABB.getMax());
+            rp3d_test(tree.getRootAABB().getMax() == nextAABB.getMax());
+
+            SweepAndPruneBroadPhase sweepAndPrune(mAllocator, DYNAMIC_TREE_FAT_AABB_INFLATE_PERCENTAGE);
+            const int32 proxyId = sweepAndPrune.addObject(aabb, reinterpret_cast<Collider*>(&object));
+            rp3d_test(sweepAndPrune.updateObject(proxyId, movedAABB, fatAABB));
+            rp3d_test(sweepAndPrune.getFatAABB(proxyId).getMax() == fatAABB.getMax());
+            rp3d_test(!sweepAndPrune.updateObject(proxyId, nextAABB, nextAABB));
+            sweepAndPrune.removeObject(proxyId);
+        }
+
+        /// Test that the fast bodies are reinserted less often with the predictive fat AABBs
+        void testReinsertions() {
+
+            // Spheres moving at a constant velocity without gravity
+            std::vector<RigidBody*> spheres;
+            std::vector<RigidBody*> predictiveSpheres;
+            PhysicsWorld* world = createWorld(false, Vector3::zero(), Vector3(decimal(6.0), 0, 0), spheres);
+            PhysicsWorld* predictiveWorld = createWorld(true, Vector3::zero(), Vector3(decimal(6.0), 0, 0), predictiveSpheres);
+
+            // The fat AABBs of the spheres are updated at each step with the constant margin
+            const uint32 nbReinsertions = simulate(world, 60);
+            rp3d_test(nbReinsertions >= 15 * 60);
+
+            // The fat AABBs are extended along the displacement and their margin grows with the movement
+            const uint32 nbPredictiveReinsertions = simulate(predictiveWorld, 60);
+            rp3d_test(nbPredictiveReinsertions > 0);
+            rp3d_test(nbPredictiveReinsertions * 4 < nbReinsertions);
+
+            // The spheres are moving the same way
+            for (uint32 i=0; i < spheres.size(); i++) {
+                rp3d_test(spheres[i]->getTransform() == predictiveSpheres[i]->getTransform());
+            }
+
+            // No collider is reinserted when the spheres stop (the margins of the resting bodies shrink
+            // after a while and the fat AABBs are then reinserted once)
+            for (uint32 i=0; i < predictiveSpheres.size(); i++) {
+                predictiveSpheres[i]->setLinearVelocity(Vector3::zero());
+            }
+            simulate(predictiveWorld, 10);
+            rp3d_test(simulate(predictiveWorld, 30) == 0);
+            rp3d_test(simulate(predictiveWorld, 250) > 0);
+            rp3d_test(simulate(predictiveWorld, 100) == 0);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyPhysicsWorld(predictiveWorld);
+        }
+
+        /// Test that the same contacts are found with the predictive fat AABBs
+        void testContacts() {
+
+            std::vector<RigidBody*> spheres;
+            std::vector<RigidBody*> predictiveSpheres;
+            const Vector3 gravity(0, decimal(-9.81), 0);
+            PhysicsWorld* world = createWorld(false, gravity, Vector3(0, decimal(-4.0), 0), spheres);
+            PhysicsWorld* predictiveWorld = createWorld(true, gravity, Vector3(0, decimal(-4.0), 0), predictiveSpheres);
+
+            uint32 nbReinsertions = 0;
+            uint32 nbPredictiveReinsertions = 0;
+            for (uint32 i=0; i < 120; i++) {
+
+                nbReinsertions += simulate(world, 1);
+                nbPredictiveReinsertions += simulate(predictiveWorld, 1);
+
+                // The spheres hit the ground at the same step
+                rp3d_test(predictiveWorld->getLastStepStats().nbContactPairs == world->getLastStepStats().nbContactPairs);
+            }
+
+            rp3d_test(nbPredictiveReinsertions < nbReinsertions);
+
+            // The spheres are resting on the ground at the same place
+            for (uint32 i=0; i < spheres.size(); i++) {
+                rp3d_test(Vector3::approxEqual(predictiveSpheres[i]->getTransform().getPosition(),
+                                               spheres[i]->getTransform().getPosition(), decimal(0.01)));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            mPhysicsCommon.destroyPhysicsWorld(predictiveWorld);
+        }
+
+        /// Test that the margins of the bodies are restored with a snapshot
+        void testSnapshot() {
+
+            std::vector<RigidBody*> spheres;
+            PhysicsWorld* world = createWorld(true, Vector3::zero(), Vector3(decimal(6.0), 0, 0), spheres);
+            simulate(world, 30);
+
+            std::vector<uint8> snapshot;
+            world->takeSnapshot(snapshot);
+
+            const uint32 nbReinsertions = simulate(world, 30);
+
+            rp3d_test(world->restoreSnapshot(snapshot.data(), snapshot.size()));
+            rp3d_test(simulate(world, 30) == nbReinsertions);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+};
+
+}
+
+#endif
@@ -92,6 +92,41 @@ class WorldRaycastCallback : public RaycastCallback {
         }
 };
 
+/// Class ClosestRaycastCallback
+class ClosestRaycastCallback : public RaycastCallback {
+
+    public:
+
+        RaycastInfo raycastInfo;
+        bool isHit;
+
+        ClosestRaycastCallback() {
+            isHit = false;
+        }
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+
+            raycastInfo.body = info.body;
+            raycastInfo.hitFraction = info.hitFraction;
+            raycastInfo.collider = info.collider;
+            raycastInfo.worldNormal = info.worldNormal;
+            raycastInfo.worldPoint = info.worldPoint;
+            isHit = true;
+
+            // Clip the ray to only keep the closest hit
+            return info.hitFraction;
+        }
+
+        void reset() {
+            raycastInfo.body = nullptr;
+            raycastInfo.hitFraction = decimal(0.0);
+            raycastInfo.collider = nullptr;
+            raycastInfo.worldNormal.setToZero();
+            raycastInfo.worldPoint.setToZero();
+            isHit = false;
+        }
+};
+
 // Class TestPointInside
 /**
  * Unit test for the RigidBody::testPointInside() method.
@@ -335,6 +370,7 @@ class TestRaycast : public Test {
             testCompound();
             testConcaveMesh();
             testHeightField();
+            testFastPaths();
         }
 
         /// Test the Collider::raycast(), RigidBody::raycast() and
@@ -1750,6 +1786,124 @@ class TestRaycast : public Test {
             mWorld->raycast(Ray(ray14.point1, ray14.point2, decimal(0.82)), &mCallback);
             rp3d_test(mCallback.isHit);
         }
+
+        /// Test the PhysicsWorld::raycastAny() and PhysicsWorld::raycastClosest() methods
+        /// against the raycast() method with a callback
+        void testFastPaths() {
+
+            // Grid of rays along the local x, y and z axis of the shapes
+            std::vector<Ray> rays;
+            for (decimal u = decimal(-7.5); u <= decimal(7.5); u += decimal(1.5)) {
+                for (decimal v = decimal(-7.5); v <= decimal(7.5); v += decimal(1.5)) {
+                    rays.push_back(Ray(mLocalShapeToWorld * Vector3(u, v, 20), mLocalShapeToWorld * Vector3(u, v, -20)));
+                    rays.push_back(Ray(mLocalShapeToWorld * Vector3(-20, u, v), mLocalShapeToWorld * Vector3(20, u, v)));
+                    rays.push_back(Ray(mLocalShapeToWorld * Vector3(-20, u, v), mLocalShapeToWorld * Vector3(20, u, v), decimal(0.3)));
+                    rays.push_back(Ray(mLocalShapeToWorld * Vector3(u, 20, v), mLocalShapeToWorld * Vector3(u, -20, v)));
+                }
+            }
+
+            const uint64 masks[3] = {0xFFFF, CATEGORY1, CATEGORY2};
+
+            // ----- Compare with the raycast() method with a callback ----- //
+
+            ClosestRaycastCallback callback;
+            int nbHits = 0;
+            int nbMismatches = 0;
+            for (int m = 0; m < 3; m++) {
+                for (const Ray& ray : rays) {
+
+                    callback.reset();
+                    mWorld->raycast(ray, &callback, masks[m]);
+
+                    RaycastInfo raycastInfo;
+                    const bool isHitClosest = mWorld->raycastClosest(ray, raycastInfo, masks[m]);
+                    const bool isHitAny = mWorld->raycastAny(ray, masks[m]);
+
+                    if (isHitClosest != callback.isHit || isHitAny != callback.isHit) {
+                        nbMismatches++;
+                        continue;
+                    }
+
+                    if (!callback.isHit) continue;
+
+                    nbHits++;
+
+                    // Several colliders can be hit at the same point (same shape dimensions) so
+                    // we only compare the geometry of the closest hit
+                    if (!approxEqual(raycastInfo.hitFraction, callback.raycastInfo.hitFraction, epsilon) ||
+                        !Vector3::approxEqual(raycastInfo.worldPoint, callback.raycastInfo.worldPoint, epsilon) ||
+                        raycastInfo.collider == nullptr || raycastInfo.body != raycastInfo.collider->getBody() ||
+                        (raycastInfo.collider->getCollisionCategoryBits() & masks[m]) == 0) {
+                        nbMismatches++;
+                    }
+                }
+            }
+            rp3d_test(nbHits > 0);
+            rp3d_test(nbMismatches == 0);
+
+            // The raycastClosest() method must give the same result as the raycast() method of the collider
+            RaycastInfo raycastInfo1;
+            RaycastInfo raycastInfo2;
+            Ray ray(mLocalShapeToWorld * Vector3(1, 2, 10), mLocalShapeToWorld * Vector3(1, 2, -20));
+            rp3d_test(mWorld->raycastClosest(ray, raycastInfo1, CATEGORY1));
+            rp3d_test(raycastInfo1.collider->raycast(ray, raycastInfo2));
+            rp3d_test(approxEqual(raycastInfo1.hitFraction, raycastInfo2.hitFraction, epsilon));
+            rp3d_test(Vector3::approxEqual(raycastInfo1.worldNormal, raycastInfo2.worldNormal, epsilon));
+
+            // A ray that is too short cannot hit anything
+            Ray shortRay(ray.point1, ray.point2, decimal(0.01));
+            rp3d_test(!mWorld->raycastAny(shortRay));
+            rp3d_test(!mWorld->raycastClosest(shortRay, raycastInfo1));
+
+            // ----- Test the raycastAny() method of each shape alone ----- //
+
+            Collider* colliders[9] = {mBoxCollider, mSphereCollider, mCapsuleCollider, mConvexMeshCollider,
+                                      mCompoundSphereCollider, mCompoundCapsuleCollider, mConcaveMeshCollider,
+                                      mHeightFieldCollider, nullptr};
+
+            for (int c = 0; colliders[c] != nullptr; c++) {
+
+                // Disable the world queries for all the other colliders
+                for (int i = 0; colliders[i] != nullptr; i++) {
+                    colliders[i]->setIsWorldQueryCollider(i == c);
+                }
+
+                int nbShapeHits = 0;
+                int nbShapeMismatches = 0;
+                for (const Ray& shapeRay : rays) {
+
+                    RaycastInfo colliderRaycastInfo;
+                    const bool isColliderHit = colliders[c]->raycast(shapeRay, colliderRaycastInfo);
+                    if (isColliderHit) nbShapeHits++;
+
+                    RaycastInfo closestRaycastInfo;
+                    if (mWorld->raycastAny(shapeRay) != isColliderHit ||
+                        mWorld->raycastClosest(shapeRay, closestRaycastInfo) != isColliderHit) {
+                        nbShapeMismatches++;
+                    }
+                }
+                rp3d_test(nbShapeHits > 0);
+                rp3d_test(nbShapeMismatches == 0);
+            }
+
+            // Restore the world queries for all the colliders
+            for (int i = 0; colliders[i] != nullptr; i++) {
+                colliders[i]->setIsWorldQueryCollider(true);
+            }
+
+            // An inactive body cannot be hit by the ray
+            mBoxCollider->getBody()->setIsActive(false);
+            for (int i = 0; colliders[i] != nullptr; i++) {
+                colliders[i]->setIsWorldQueryCollider(colliders[i] == mBoxCollider);
+            }
+            rp3d_test(!mWorld->raycastAny(ray));
+            rp3d_test(!mWorld->raycastClosest(ray, raycastInfo1));
+            mBoxCollider->getBody()->setIsActive(true);
+            rp3d_test(mWorld->raycastAny(ray));
+            for (int i = 0; colliders[i] != nullptr; i++) {
+                colliders[i]->setIsWorldQueryCollider(true);
+            }
+        }
 };
 
 }
@@ -0,0 +1,255 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_SHAPE_CAST_H
+#define TEST_SHAPE_CAST_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <algorithm>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestShapeCast
+/**
+ * Unit test for the shape cast queries of the PhysicsWorld class
+ */
+class TestShapeCast : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        RigidBody* mGroundBody;
+        RigidBody* mSphereBody;
+        RigidBody* mPlatformBody;
+        RigidBody* mHeightFieldBody;
+
+        SphereShape* mCastSphereShape;
+        BoxShape* mCastBoxShape;
+
+        float mHeightFieldData[100];
+
+        // Maximum error of a hit fraction (the shape stops within the time of impact tolerance)
+        decimal mFractionEpsilon;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestShapeCast(const std::string& name) : Test(name) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            mFractionEpsilon = decimal(0.001);
+
+            // Ground box with its top face at y=0
+            mGroundBody = mWorld->createRigidBody(Transform(Vector3(0, -1, 0), Quaternion::identity()));
+            mGroundBody->setType(BodyType::STATIC);
+            mGroundBody->addCollider(mPhysicsCommon.createBoxShape(Vector3(10, 1, 10)), Transform::identity());
+
+            // Sphere obstacle above the ground
+            mSphereBody = mWorld->createRigidBody(Transform(Vector3(5, 3, 0), Quaternion::identity()));
+            mSphereBody->setType(BodyType::STATIC);
+            mSphereBody->addCollider(mPhysicsCommon.createSphereShape(decimal(1.0)), Transform::identity());
+
+            // Platform in another category with its top face at y=0.5
+            mPlatformBody = mWorld->createRigidBody(Transform(Vector3(20, 0, 0), Quaternion::identity()));
+            mPlatformBody->setType(BodyType::STATIC);
+            Collider* platformCollider = mPlatformBody->addCollider(mPhysicsCommon.createBoxShape(Vector3(2, decimal(0.5), 2)), Transform::identity());
+            platformCollider->setCollisionCategoryBits(0x0002);
+
+            // Flat height field with its surface at y=-2
+            for (int i=0; i < 100; i++) mHeightFieldData[i] = 0.0f;
+            std::vector<Message> messages;
+            HeightField* heightField = mPhysicsCommon.createHeightField(10, 10, mHeightFieldData, HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+            mHeightFieldBody = mWorld->createRigidBody(Transform(Vector3(-20, -2, 0), Quaternion::identity()));
+            mHeightFieldBody->setType(BodyType::STATIC);
+            mHeightFieldBody->addCollider(mPhysicsCommon.createHeightFieldShape(heightField), Transform::identity());
+
+            mCastSphereShape = mPhysicsCommon.createSphereShape(decimal(0.5));
+            mCastBoxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+
+            // Compute the AABBs of the colliders in the broad-phase
+            mWorld->update(decimal(1.0) / decimal(60.0));
+        }
+
+        /// Destructor
+        virtual ~TestShapeCast() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testConvexHits();
+            testMisses();
+            testCategoryMask();
+            testInitialOverlap();
+            testConcaveHit();
+            testBatchedQueries();
+        }
+
+        void testConvexHits() {
+
+            // Sphere falling on the ground
+            ShapeCastInfo hit;
+            rp3d_test(mWorld->shapeCast(*mCastSphereShape, Transform(Vector3(0, 5, 0), Quaternion::identity()), Vector3(0, -10, 0), hit));
+            rp3d_test(hit.body == mGroundBody);
+            rp3d_test(hit.collider == mGroundBody->getCollider(0));
+            rp3d_test(approxEqual(hit.hitFraction, decimal(0.45), mFractionEpsilon));
+            rp3d_test(Vector3::approxEqual(hit.worldNormal, Vector3(0, 1, 0), decimal(0.01)));
+            rp3d_test(Vector3::approxEqual(hit.worldPoint, Vector3(0, 0, 0), decimal(0.01)));
+
+            // Sphere moving towards the sphere obstacle (the center stops at a distance of 1.5)
+            rp3d_test(mWorld->shapeCast(*mCastSphereShape, Transform(Vector3(-5, 3, 0), Quaternion::identity()), Vector3(20, 0, 0), hit));
+            rp3d_test(hit.body == mSphereBody);
+            rp3d_test(approxEqual(hit.hitFraction, decimal(0.425), mFractionEpsilon));
+            rp3d_test(Vector3::approxEqual(hit.worldNormal, Vector3(-1, 0, 0), decimal(0.01)));
+            rp3d_test(Vector3::approxEqual(hit.worldPoint, Vector3(4, 3, 0), decimal(0.01)));
+
+            // Rotated box falling on the ground (it touches the ground with its lowest corner)
+            const Quaternion orientation = Quaternion::fromEulerAngles(decimal(0.3), decimal(0.7), decimal(0.4));
+            decimal lowestCornerHeight = decimal(0.0);
+            for (int c=0; c < 8; c++) {
+                const Vector3 corner((c & 1) ? decimal(0.5) : decimal(-0.5), (c & 2) ? decimal(0.5) : decimal(-0.5), (c & 4) ? decimal(0.5) : decimal(-0.5));
+                lowestCornerHeight = std::min(lowestCornerHeight, (orientation * corner).y);
+            }
+            rp3d_test(mWorld->shapeCast(*mCastBoxShape, Transform(Vector3(0, 5, 5), orientation), Vector3(0, -5, 0), hit));
+            rp3d_test(hit.body == mGroundBody);
+            rp3d_test(approxEqual(hit.hitFraction, (decimal(5.0) + lowestCornerHeight) / decimal(5.0), mFractionEpsilon));
+            rp3d_test(Vector3::approxEqual(hit.worldNormal, Vector3(0, 1, 0), decimal(0.01)));
+        }
+
+        void testMisses() {
+
+            // Motion away from all the colliders
+            ShapeCastInfo hit;
+            rp3d_test(!mWorld->shapeCast(*mCastSphereShape, Transform(Vector3(0, 5, 0), Quaternion::identity()), Vector3(0, 0, 3), hit));
+            rp3d_test(hit.body == nullptr);
+            rp3d_test(hit.collider == nullptr);
+            rp3d_test(approxEqual(hit.hitFraction, decimal(1.0)));
+
+            // Motion too short to reach the ground
+            rp3d_test(!mWorld->shapeCast(*mCastSphereShape, Transform(Vector3(0, 5, 0), Quaternion::identity()), Vector3(0, -4, 0), hit));
+
+            // Motion passing next to the sphere obstacle
+            rp3d_test(!mWorld->shapeCast(*mCastSphereShape, Transform(Vector3(-5, 3, decimal(1.6)), Quaternion::identity()), Vector3(20, 0, 0), hit));
+        }
+
+        void testCategoryMask() {
+
+            const Transform transform(Vector3(20, 5, 0), Quaternion::identity());
+            const Vector3 translation(0, -10, 0);
+
+            ShapeCastInfo hit;
+            rp3d_test(mWorld->shapeCast(*mCastSphereShape, transform, translation, hit));
+            rp3d_test(hit.body == mPlatformBody);
+            rp3d_test(approxEqual(hit.hitFraction, decimal(0.4), mFractionEpsilon));
+
+            rp3d_test(mWorld->shapeCast(*mCastSphereShape, transform, translation, hit, 0x0002));
+            rp3d_test(hit.body == mPlatformBody);
+
+            rp3d_test(!mWorld->shapeCast(*mCastSphereShape, transform, translation, hit, 0x0001));
+            rp3d_test(hit.body == nullptr);
+        }
+
+        void testInitialOverlap() {
+
+            // The sphere already penetrates the ground a little bit (the normal can still be computed)
+            ShapeCastInfo hit;
+            rp3d_test(mWorld->shapeCast(*mCastSphereShape, Transform(Vector3(0, decimal(0.2), 0), Quaternion::identity()), Vector3(0, -1, 0), hit));
+            rp3d_test(hit.body == mGroundBody);
+            rp3d_test(approxEqual(hit.hitFraction, decimal(0.0)));
+            rp3d_test(Vector3::approxEqual(hit.worldNormal, Vector3(0, 1, 0), decimal(0.01)));
+
+            // The center of the sphere is inside the ground
+            rp3d_test(mWorld->shapeCast(*mCastSphereShape, Transform(Vector3(0, decimal(-0.3), 0), Quaternion::identity()), Vector3(0, 1, 0), hit));
+            rp3d_test(hit.body == mGroundBody);
+            rp3d_test(approxEqual(hit.hitFraction, decimal(0.0)));
+            rp3d_test(Vector3::approxEqual(hit.worldNormal, Vector3(0, 0, 0)));
+        }
+
+        void testConcaveHit() {
+
+            // Box falling on the height field
+            ShapeCastInfo hit;
+            rp3d_test(mWorld->shapeCast(*mCastBoxShape, Transform(Vector3(-20, 3, decimal(0.3)), Quaternion::identity()), Vector3(0, -10, 0), hit));
+            rp3d_test(hit.body == mHeightFieldBody);
+            rp3d_test(approxEqual(hit.hitFraction, decimal(0.45), mFractionEpsilon));
+            rp3d_test(Vector3::approxEqual(hit.worldNormal, Vector3(0, 1, 0), decimal(0.01)));
+            rp3d_test(approxEqual(hit.worldPoint.y, decimal(-2.0), decimal(0.01)));
+
+            // Sphere moving along the height field without touching it
+            rp3d_test(!mWorld->shapeCast(*mCastSphereShape, Transform(Vector3(-23, -1, 0), Quaternion::identity()), Vector3(6, 0, 0), hit));
+        }
+
+        void testBatchedQueries() {
+
+            Array<ShapeCastQuery> queries(mAllocator);
+            queries.add(ShapeCastQuery(Transform(Vector3(0, 5, 0), Quaternion::identity()), Vector3(0, -10, 0)));
+            queries.add(ShapeCastQuery(Transform(Vector3(0, 5, 0), Quaternion::identity()), Vector3(0, 0, 3)));
+            queries.add(ShapeCastQuery(Transform(Vector3(-5, 3, 0), Quaternion::identity()), Vector3(20, 0, 0)));
+            queries.add(ShapeCastQuery(Transform(Vector3(20, 5, 0), Quaternion::identity()), Vector3(0, -10, 0)));
+            queries.add(ShapeCastQuery(Transform(Vector3(-20, 3, 0), Quaternion::identity()), Vector3(0, -10, 0)));
+            queries.add(ShapeCastQuery(Transform(Vector3(-23, -1, 0), Quaternion::identity()), Vector3(6, 0, 0)));
+
+            // The output array is cleared before the results are written
+            Array<ShapeCastInfo> hits(mAllocator);
+            hits.add(ShapeCastInfo());
+
+            rp3d_test(mWorld->shapeCast(*mCastSphereShape, queries, hits) == 4);
+            rp3d_test(hits.size() == queries.size());
+
+            // The batched results are the same as the results of the single queries
+            for (uint32 i=0; i < queries.size(); i++) {
+
+                ShapeCastInfo hit;
+                const bool isHit = mWorld->shapeCast(*mCastSphereShape, queries[i].transform, queries[i].translation, hit);
+                rp3d_test(isHit == (hits[i].body != nullptr));
+                rp3d_test(hits[i].body == hit.body);
+                rp3d_test(hits[i].collider == hit.collider);
+                rp3d_test(approxEqual(hits[i].hitFraction, hit.hitFraction));
+                rp3d_test(Vector3::approxEqual(hits[i].worldPoint, hit.worldPoint));
+                rp3d_test(Vector3::approxEqual(hits[i].worldNormal, hit.worldNormal));
+            }
+
+            rp3d_test(hits[4].body == mHeightFieldBody);
+            rp3d_test(approxEqual(hits[4].hitFraction, decimal(0.45), mFractionEpsilon));
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,325 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_SPATIAL_QUERIES_H
+#define TEST_SPATIAL_QUERIES_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/memory/DefaultAllocator.h>
+#include <algorithm>
+#include <functional>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestSpatialQueries
+/**
+ * Unit test for the AABB, sphere and frustum queries of the PhysicsWorld class
+ */
+class TestSpatialQueries : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        DefaultAllocator mAllocator;
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        std::vector<RigidBody*> mBodies;
+
+        std::vector<Collider*> mColliders;
+
+        // ---------- Methods ---------- //
+
+        /// Return the sorted colliders that pass a test on their AABB and on their category (brute force)
+        std::vector<Collider*> filterColliders(const std::function<bool(const AABB&)>& test, uint64 categoryMaskBits, bool useExactAABB) {
+
+            std::vector<Collider*> colliders;
+            for (uint32 i=0; i < mColliders.size(); i++) {
+
+                Collider* collider = mColliders[i];
+                if ((collider->getCollisionCategoryBits() & categoryMaskBits) == 0 || !collider->getIsWorldQueryCollider()) continue;
+                if (!test(mWorld->getWorldAABB(collider))) continue;
+                if (useExactAABB && !test(collider->getWorldAABB())) continue;
+                colliders.push_back(collider);
+            }
+
+            std::sort(colliders.begin(), colliders.end());
+            return colliders;
+        }
+
+        /// Return the content of an array as a sorted vector
+        template<typename T>
+        static std::vector<T> toSortedVector(const Array<T>& array) {
+            std::vector<T> values;
+            for (uint32 i=0; i < array.size(); i++) values.push_back(array[i]);
+            std::sort(values.begin(), values.end());
+            return values;
+        }
+
+        /// Return the sorted bodies of some colliders (without duplicates)
+        static std::vector<Body*> getBodies(const std::vector<Collider*>& colliders) {
+            std::vector<Body*> bodies;
+            for (uint32 i=0; i < colliders.size(); i++) bodies.push_back(colliders[i]->getBody());
+            std::sort(bodies.begin(), bodies.end());
+            bodies.erase(std::unique(bodies.begin(), bodies.end()), bodies.end());
+            return bodies;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestSpatialQueries(const std::string& name) : Test(name) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            // Grid of bodies with different shapes
+            for (int i=0; i < 6; i++) {
+                for (int j=0; j < 6; j++) {
+
+                    const Vector3 position(decimal(-10) + decimal(4) * i, decimal(0.5) * ((i + j) % 3), decimal(-10) + decimal(4) * j);
+                    RigidBody* body = mWorld->createRigidBody(Transform(position, Quaternion::fromEulerAngles(decimal(0.3) * i, decimal(0.2) * j, 0)));
+
+                    Collider* collider;
+                    if ((i + j) % 2 == 0) {
+                        collider = body->addCollider(mPhysicsCommon.createSphereShape(decimal(0.8)), Transform::identity());
+                    }
+                    else {
+                        collider = body->addCollider(mPhysicsCommon.createBoxShape(Vector3(decimal(1.2), decimal(0.3), decimal(0.5))), Transform::identity());
+                    }
+                    mColliders.push_back(collider);
+
+                    // Some colliders are in another category
+                    if (j == 3) collider->setCollisionCategoryBits(0x0002);
+
+                    // Some bodies have two colliders
+                    if (i == 4) {
+                        mColliders.push_back(body->addCollider(mPhysicsCommon.createCapsuleShape(decimal(0.3), decimal(1.0)),
+                                                               Transform(Vector3(0, decimal(1.5), 0), Quaternion::identity())));
+                    }
+
+                    mBodies.push_back(body);
+                }
+            }
+
+            // A collider that cannot be found by world queries
+            mColliders[5]->setIsWorldQueryCollider(false);
+
+            // Move some bodies so that their fat AABB is larger than their exact AABB
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            for (uint32 b=0; b < mBodies.size(); b += 3) {
+                mBodies[b]->setLinearVelocity(Vector3(decimal(3.0), 0, decimal(-2.0)));
+            }
+            mWorld->setIsGravityEnabled(false);
+            for (int s=0; s < 5; s++) {
+                mWorld->update(decimal(1.0) / decimal(60.0));
+            }
+        }
+
+        /// Destructor
+        virtual ~TestSpatialQueries() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testAABBSphereFrustumTests();
+            testQueryAABB();
+            testQuerySphere();
+            testQueryFrustum();
+        }
+
+        void testAABBSphereFrustumTests() {
+
+            const AABB aabb(Vector3(-1, -1, -1), Vector3(1, 2, 3));
+
+            rp3d_test(aabb.testCollisionWithSphere(Vector3(0, 0, 0), decimal(0.1)));
+            rp3d_test(aabb.testCollisionWithSphere(Vector3(3, 0, 0), decimal(2.1)));
+            rp3d_test(!aabb.testCollisionWithSphere(Vector3(3, 0, 0), decimal(1.9)));
+            rp3d_test(aabb.testCollisionWithSphere(Vector3(2, 3, 0), decimal(1.5)));
+            rp3d_test(!aabb.testCollisionWithSphere(Vector3(2, 3, 0), decimal(1.4)));
+
+            // Camera at (0, 0, 10) looking along -Z
+            const Frustum frustum = Frustum::createPerspective(Transform(Vector3(0, 0, 10), Quaternion::identity()),
+                                                               PI_RP3D / decimal(2.0), decimal(1.0), decimal(1.0), decimal(20.0));
+            rp3d_test(frustum.nbPlanes == 6);
+            rp3d_test(frustum.contains(Vector3(0, 0, 5)));
+            rp3d_test(frustum.contains(Vector3(4, -4, 5)));
+            rp3d_test(!frustum.contains(Vector3(6, 0, 5)));
+            rp3d_test(!frustum.contains(Vector3(0, 0, decimal(9.5))));
+            rp3d_test(!frustum.contains(Vector3(0, 0, -11)));
+            rp3d_test(!frustum.contains(Vector3(0, 0, 11)));
+
+            rp3d_test(aabb.testCollisionWithFrustum(frustum));
+            rp3d_test(AABB(Vector3(5, -1, 4), Vector3(7, 1, 6)).testCollisionWithFrustum(frustum));
+            rp3d_test(!AABB(Vector3(decimal(6.5), -1, 4), Vector3(7, 1, 5)).testCollisionWithFrustum(frustum));
+            rp3d_test(!AABB(Vector3(-1, -1, 11), Vector3(1, 1, 12)).testCollisionWithFrustum(frustum));
+
+            // Camera looking along +X
+            const Frustum rotatedFrustum = Frustum::createPerspective(Transform(Vector3(0, 0, 0), Quaternion::fromEulerAngles(0, -PI_RP3D / decimal(2.0), 0)),
+                                                                      decimal(1.0), decimal(1.5), decimal(0.5), decimal(10.0));
+            rp3d_test(rotatedFrustum.contains(Vector3(5, 0, 0)));
+            rp3d_test(!rotatedFrustum.contains(Vector3(-5, 0, 0)));
+            rp3d_test(!rotatedFrustum.contains(Vector3(0, 0, -5)));
+
+            // A frustum without planes contains everything
+            rp3d_test(Frustum().contains(Vector3(100, -50, 3)));
+            rp3d_test(aabb.testCollisionWithFrustum(Frustum()));
+        }
+
+        void testQueryAABB() {
+
+            Array<Collider*> colliders(mAllocator);
+            Array<Body*> bodies(mAllocator);
+
+            const AABB aabbs[3] = {AABB(Vector3(-5, -1, -5), Vector3(5, 1, 5)), AABB(Vector3(-20, -20, -20), Vector3(20, 20, 20)),
+                                   AABB(Vector3(decimal(1.5), decimal(0.9), decimal(-6.5)), Vector3(decimal(2.5), decimal(1.2), decimal(-5.5)))};
+            const uint64 masks[3] = {0xFFFF, 0x0001, 0x0002};
+
+            bool isMismatch = false;
+            uint32 nbColliders = 0;
+            for (int a=0; a < 3; a++) {
+                for (int m=0; m < 3; m++) {
+                    for (int e=0; e < 2; e++) {
+
+                        const AABB& aabb = aabbs[a];
+                        const std::vector<Collider*> expected = filterColliders([&aabb](const AABB& colliderAABB) { return aabb.testCollision(colliderAABB); },
+                                                                                masks[m], e == 1);
+
+                        mWorld->queryAABB(aabb, colliders, masks[m], e == 1);
+                        isMismatch |= toSortedVector(colliders) != expected;
+
+                        mWorld->queryAABB(aabb, bodies, masks[m], e == 1);
+                        isMismatch |= toSortedVector(bodies) != getBodies(expected);
+
+                        nbColliders += static_cast<uint32>(expected.size());
+                    }
+                }
+            }
+
+            rp3d_test(!isMismatch);
+            rp3d_test(nbColliders > 40);
+
+            // The large AABB contains everything except the collider that is not a world query collider (and its body)
+            mWorld->queryAABB(aabbs[1], colliders);
+            rp3d_test(colliders.size() == mColliders.size() - 1);
+            mWorld->queryAABB(aabbs[1], bodies);
+            rp3d_test(bodies.size() == mBodies.size() - 1);
+
+            // Empty result (the output arrays are cleared)
+            mWorld->queryAABB(AABB(Vector3(100, 100, 100), Vector3(101, 101, 101)), colliders);
+            rp3d_test(colliders.size() == 0);
+            mWorld->queryAABB(AABB(Vector3(100, 100, 100), Vector3(101, 101, 101)), bodies);
+            rp3d_test(bodies.size() == 0);
+        }
+
+        void testQuerySphere() {
+
+            Array<Collider*> colliders(mAllocator);
+            Array<Body*> bodies(mAllocator);
+
+            const Vector3 centers[3] = {Vector3(0, 0, 0), Vector3(-8, 1, 4), Vector3(2, 3, -2)};
+            const decimal radiuses[3] = {decimal(5.0), decimal(2.5), decimal(1.0)};
+
+            bool isMismatch = false;
+            uint32 nbColliders = 0;
+            for (int s=0; s < 3; s++) {
+                for (int e=0; e < 2; e++) {
+
+                    const Vector3& center = centers[s];
+                    const decimal radius = radiuses[s];
+                    const std::vector<Collider*> expected = filterColliders([&center, radius](const AABB& colliderAABB) {
+                        return colliderAABB.testCollisionWithSphere(center, radius); }, 0xFFFF, e == 1);
+
+                    mWorld->querySphere(center, radius, colliders, 0xFFFF, e == 1);
+                    isMismatch |= toSortedVector(colliders) != expected;
+
+                    mWorld->querySphere(center, radius, bodies, 0xFFFF, e == 1);
+                    isMismatch |= toSortedVector(bodies) != getBodies(expected);
+
+                    nbColliders += static_cast<uint32>(expected.size());
+                }
+            }
+
+            rp3d_test(!isMismatch);
+            rp3d_test(nbColliders > 10);
+
+            mWorld->querySphere(Vector3(0, 50, 0), decimal(10.0), colliders);
+            rp3d_test(colliders.size() == 0);
+        }
+
+        void testQueryFrustum() {
+
+            Array<Collider*> colliders(mAllocator);
+            Array<Body*> bodies(mAllocator);
+
+            const Frustum frustums[2] = {Frustum::createPerspective(Transform(Vector3(0, 5, 15), Quaternion::fromEulerAngles(decimal(-0.3), 0, 0)),
+                                                                    decimal(0.8), decimal(1.5), decimal(0.1), decimal(20.0)),
+                                         Frustum::createPerspective(Transform(Vector3(-15, 1, 0), Quaternion::fromEulerAngles(0, -PI_RP3D / decimal(2.0), 0)),
+                                                                    decimal(0.5), decimal(1.0), decimal(1.0), decimal(12.0))};
+
+            bool isMismatch = false;
+            uint32 nbColliders = 0;
+            for (int f=0; f < 2; f++) {
+                for (int e=0; e < 2; e++) {
+
+                    const Frustum& frustum = frustums[f];
+                    const std::vector<Collider*> expected = filterColliders([&frustum](const AABB& colliderAABB) {
+                        return colliderAABB.testCollisionWithFrustum(frustum); }, 0xFFFD, e == 1);
+
+                    mWorld->queryFrustum(frustum, colliders, 0xFFFD, e == 1);
+                    isMismatch |= toSortedVector(colliders) != expected;
+
+                    mWorld->queryFrustum(frustum, bodies, 0xFFFD, e == 1);
+                    isMismatch |= toSortedVector(bodies) != getBodies(expected);
+
+                    nbColliders += static_cast<uint32>(expected.size());
+
+                    // Not all the colliders are visible
+                    isMismatch |= expected.size() == 0 || expected.size() == mColliders.size();
+                }
+            }
+
+            rp3d_test(!isMismatch);
+            rp3d_test(nbColliders > 10);
+
+            // Camera looking away from the scene
+            mWorld->queryFrustum(Frustum::createPerspective(Transform(Vector3(0, 0, 20), Quaternion::fromEulerAngles(0, PI_RP3D, 0)),
+                                                            decimal(1.0), decimal(1.0), decimal(0.1), decimal(50.0)), bodies);
+            rp3d_test(bodies.size() == 0);
+        }
+};
+
+}
+
+#endif
@@ -29,6 +29,8 @@
 // Libraries
 #include "Test.h"
 #include <reactphysics3d/reactphysics3d.h>
+#include <cstdio>
+#include <fstream>
 
 /// Reactphysics3D namespace
 namespace reactphysics3d {
@@ -45,6 +47,10 @@ class TestTriangleMesh : public Test {
 
         PhysicsCommon mPhysicsCommon;
         TriangleMesh* mTriangleMesh;
+        TriangleMesh* mReferencedTriangleMesh;
+
+        float mPlaneVertices[36 * 3];
+        int mPlaneIndices[25 * 2 * 3];
 
     public :
 
@@ -53,8 +59,8 @@ class TestTriangleMesh : public Test {
         /// Constructor
         TestTriangleMesh(const std::string& name) : Test(name) {
 
-            float planeVertices[36 * 3];
-            int planeIndices[25 * 2 * 3];
+            float* planeVertices = mPlaneVertices;
+            int* planeIndices = mPlaneIndices;
 
             // ---------- Concave Mesh ---------- //
             for (int i = 0; i < 6; i++) {
@@ -90,6 +96,10 @@ class TestTriangleMesh : public Test {
             // Add the triangle vertex array of the subpart to the triangle mesh
             std::vector<rp3d::Message> messages;
             mTriangleMesh = mPhysicsCommon.createTriangleMesh(triangleVertexArray, messages);
+
+            // Create a mesh that references the vertices and indices buffers
+            mReferencedTriangleMesh = mPhysicsCommon.createTriangleMesh(triangleVertexArray, messages,
+                                                                        rp3d::TriangleMesh::StorageType::REFERENCE);
         }
 
         /// Destructor
@@ -100,6 +110,9 @@ class TestTriangleMesh : public Test {
         /// Run the tests
         void run() {
             test();
+            testReferencedMesh();
+            testCookedMesh();
+            testWeldedVertices();
         }
 
         void test() {
@@ -139,6 +152,189 @@ class TestTriangleMesh : public Test {
             rp3d_test(Vector3::approxEqual(mTriangleMesh->getBounds().getMin(), Vector3(-2.5, 0 ,-2.5)));
             rp3d_test(Vector3::approxEqual(mTriangleMesh->getBounds().getMax(), Vector3(2.5, 0, 2.5)));
         }
+
+        void testReferencedMesh() {
+
+            rp3d_test(mReferencedTriangleMesh != nullptr);
+            rp3d_test(mReferencedTriangleMesh->getStorageType() == rp3d::TriangleMesh::StorageType::REFERENCE);
+
+            rp3d_test(mReferencedTriangleMesh->getNbVertices() == 36);
+            rp3d_test(mReferencedTriangleMesh->getNbTriangles() == 50);
+
+            // The mesh returns the same data as the copied mesh
+            bool isSameData = true;
+            for (uint32 v=0; v < mTriangleMesh->getNbVertices(); v++) {
+                isSameData &= mReferencedTriangleMesh->getVertex(v) == mTriangleMesh->getVertex(v);
+                isSameData &= Vector3::approxEqual(mReferencedTriangleMesh->getVertexNormal(v), mTriangleMesh->getVertexNormal(v));
+            }
+            for (uint32 t=0; t < mTriangleMesh->getNbTriangles(); t++) {
+                uint32 indices[3], referencedIndices[3];
+                mTriangleMesh->getTriangleVerticesIndices(t, indices[0], indices[1], indices[2]);
+                mReferencedTriangleMesh->getTriangleVerticesIndices(t, referencedIndices[0], referencedIndices[1], referencedIndices[2]);
+                isSameData &= indices[0] == referencedIndices[0] && indices[1] == referencedIndices[1] &&
+                              indices[2] == referencedIndices[2];
+            }
+            rp3d_test(isSameData);
+
+            rp3d_test(Vector3::approxEqual(mReferencedTriangleMesh->getBounds().getMin(), Vector3(-2.5, 0 ,-2.5)));
+            rp3d_test(Vector3::approxEqual(mReferencedTriangleMesh->getBounds().getMax(), Vector3(2.5, 0, 2.5)));
+
+            // The vertices are read from the user buffer
+            mPlaneVertices[7 * 3 + 1] = 1.0f;
+            rp3d_test(mReferencedTriangleMesh->getVertex(7) == Vector3(-1.5, 1, -1.5));
+            mPlaneVertices[7 * 3 + 1] = 0.0f;
+
+            // A degenerate triangle is kept in the buffers but not inserted into the BVH
+            float vertices[4 * 3] = {0, 0, 0,   1, 0, 0,   0, 0, 1,   2, 0, 0};
+            short indices[2 * 3] = {0, 2, 1,   0, 1, 3};
+            rp3d::TriangleVertexArray triangleVertexArray(4, vertices, 3 * sizeof(float), 2, indices, 3 * sizeof(short),
+                    rp3d::TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                    rp3d::TriangleVertexArray::IndexDataType::INDEX_SHORT_TYPE);
+            std::vector<rp3d::Message> messages;
+            TriangleMesh* mesh = mPhysicsCommon.createTriangleMesh(triangleVertexArray, messages,
+                                                                   rp3d::TriangleMesh::StorageType::REFERENCE);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(messages.size() == 1);
+            rp3d_test(mesh->getNbTriangles() == 2);
+            rp3d_test(mesh->getNbVertices() == 4);
+            rp3d_test(Vector3::approxEqual(mesh->getVertexNormal(0), Vector3(0, 1, 0)));
+            rp3d_test(Vector3::approxEqual(mesh->getBounds().getMax(), Vector3(1, 0, 1)));
+
+            mPhysicsCommon.destroyTriangleMesh(mesh);
+        }
+
+        void testCookedMesh() {
+
+            // Cook the copied and the referenced meshes (they must give the same data)
+            std::vector<uint8> cookedData;
+            mPhysicsCommon.cookTriangleMesh(mTriangleMesh, cookedData);
+            std::vector<uint8> referencedCookedData;
+            mPhysicsCommon.cookTriangleMesh(mReferencedTriangleMesh, referencedCookedData);
+            rp3d_test(cookedData.size() > 0);
+            rp3d_test(cookedData == referencedCookedData);
+
+            std::vector<rp3d::Message> messages;
+            TriangleMesh* mesh = mPhysicsCommon.createTriangleMeshFromCookedData(cookedData.data(), cookedData.size(), messages);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(messages.size() == 0);
+            rp3d_test(mesh->getStorageType() == rp3d::TriangleMesh::StorageType::COPY);
+            rp3d_test(mesh->getNbVertices() == mTriangleMesh->getNbVertices());
+            rp3d_test(mesh->getNbTriangles() == mTriangleMesh->getNbTriangles());
+
+            bool isSameData = true;
+            for (uint32 v=0; v < mTriangleMesh->getNbVertices(); v++) {
+                isSameData &= mesh->getVertex(v) == mTriangleMesh->getVertex(v);
+                isSameData &= mesh->getVertexNormal(v) == mTriangleMesh->getVertexNormal(v);
+            }
+            for (uint32 t=0; t < mTriangleMesh->getNbTriangles(); t++) {
+                uint32 indices[3], cookedIndices[3];
+                mTriangleMesh->getTriangleVerticesIndices(t, indices[0], indices[1], indices[2]);
+                mesh->getTriangleVerticesIndices(t, cookedIndices[0], cookedIndices[1], cookedIndices[2]);
+                isSameData &= indices[0] == cookedIndices[0] && indices[1] == cookedIndices[1] &&
+                              indices[2] == cookedIndices[2];
+            }
+            rp3d_test(isSameData);
+            rp3d_test(mesh->getBounds().getMin() == mTriangleMesh->getBounds().getMin());
+            rp3d_test(mesh->getBounds().getMax() == mTriangleMesh->getBounds().getMax());
+
+            // Cooking the loaded mesh again gives the same data
+            std::vector<uint8> cookedDataAgain;
+            mPhysicsCommon.cookTriangleMesh(mesh, cookedDataAgain);
+            rp3d_test(cookedDataAgain == cookedData);
+
+            mPhysicsCommon.destroyTriangleMesh(mesh);
+
+            // Load the mesh from a memory-mapped file
+            const std::string filePath = "rp3d_test_triangle_mesh.cooked";
+            {
+                std::ofstream file(filePath, std::ios::binary);
+                file.write(reinterpret_cast<const char*>(cookedData.data()), static_cast<std::streamsize>(cookedData.size()));
+            }
+            mesh = mPhysicsCommon.createTriangleMeshFromCookedFile(filePath, messages);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(mesh->getNbTriangles() == 50);
+            rp3d_test(Vector3::approxEqual(mesh->getBounds().getMax(), Vector3(2.5, 0, 2.5)));
+            mPhysicsCommon.destroyTriangleMesh(mesh);
+            std::remove(filePath.c_str());
+
+            // Truncated or invalid data are rejected
+            messages.clear();
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedData(cookedData.data(), cookedData.size() - 1, messages) == nullptr);
+            rp3d_test(messages.size() == 1);
+            rp3d_test(mPhysicsCommon.createConvexMeshFromCookedData(cookedData.data(), cookedData.size(), messages) == nullptr);
+            rp3d_test(mPhysicsCommon.createTriangleMeshFromCookedFile("rp3d_missing_file.cooked", messages) == nullptr);
+        }
+
+        void testWeldedVertices() {
+
+            // Two triangles that do not share their vertices indices, a duplicated vertex
+            // slightly moved (closer than the mesh epsilon) and an unused first vertex
+            float vertices[7 * 3] = {5, 5, 5,   0, 0, 0,   1, 0, 0,   0, 0, 1,
+                                     1, 0, 0,   0, 0, 1.000001f,   1, 0, 1};
+            int indices[2 * 3] = {1, 3, 2,   4, 5, 6};
+            rp3d::TriangleVertexArray triangleVertexArray(7, vertices, 3 * sizeof(float), 2, indices, 3 * sizeof(int),
+                    rp3d::TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                    rp3d::TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            std::vector<rp3d::Message> messages;
+            TriangleMesh* mesh = mPhysicsCommon.createTriangleMesh(triangleVertexArray, messages);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(messages.size() == 0);
+            rp3d_test(mesh->getNbTriangles() == 2);
+            rp3d_test(mesh->getNbVertices() == 4);
+
+            uint32 v1Index, v2Index, v3Index;
+            mesh->getTriangleVerticesIndices(0, v1Index, v2Index, v3Index);
+            rp3d_test(v1Index == 0 && v2Index == 2 && v3Index == 1);
+            mesh->getTriangleVerticesIndices(1, v1Index, v2Index, v3Index);
+            rp3d_test(v1Index == 1 && v2Index == 2 && v3Index == 3);
+
+            rp3d_test(mesh->getVertex(0) == Vector3(0, 0, 0));
+            rp3d_test(mesh->getVertex(3) == Vector3(1, 0, 1));
+            rp3d_test(Vector3::approxEqual(mesh->getVertexNormal(1), Vector3(0, 1, 0)));
+
+            mPhysicsCommon.destroyTriangleMesh(mesh);
+
+            // The vertices with different user normals are not welded
+            float normals[7 * 3] = {0, 1, 0,   0, 1, 0,   0, 1, 0,   0, 1, 0,
+                                    1, 0, 0,   0, 1, 0,   0, 1, 0};
+            rp3d::TriangleVertexArray triangleVertexArrayWithNormals(7, vertices, 3 * sizeof(float), normals, 3 * sizeof(float),
+                    2, indices, 3 * sizeof(int),
+                    rp3d::TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                    rp3d::TriangleVertexArray::NormalDataType::NORMAL_FLOAT_TYPE,
+                    rp3d::TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            mesh = mPhysicsCommon.createTriangleMesh(triangleVertexArrayWithNormals, messages);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(mesh->getNbVertices() == 5);
+            mesh->getTriangleVerticesIndices(1, v1Index, v2Index, v3Index);
+            rp3d_test(v1Index == 3 && v2Index == 2 && v3Index == 4);
+            rp3d_test(mesh->getVertexNormal(3) == Vector3(1, 0, 0));
+
+            mPhysicsCommon.destroyTriangleMesh(mesh);
+
+            // The second triangle has a valid area but its first and third vertices are both
+            // welded with the first vertex of the first triangle (greedy welding)
+            const float epsilon = float(3 * 3 * MACHINE_EPSILON);
+            float collapsingVertices[6 * 3] = {0.75f * epsilon, 0, 0,   0, 0, 0,   1.5f * epsilon, 0, 0,
+                                               0, 0, 1,   1, 0, 0,   0, 1, 0};
+            int collapsingIndices[2 * 3] = {0, 3, 4,   1, 5, 2};
+            rp3d::TriangleVertexArray collapsingTriangleVertexArray(6, collapsingVertices, 3 * sizeof(float), 2, collapsingIndices, 3 * sizeof(int),
+                    rp3d::TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE,
+                    rp3d::TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            messages.clear();
+            mesh = mPhysicsCommon.createTriangleMesh(collapsingTriangleVertexArray, messages);
+            rp3d_test(mesh != nullptr);
+            rp3d_test(messages.size() == 1);
+            rp3d_test(messages[0].type == rp3d::Message::Type::Warning);
+            rp3d_test(mesh->getNbTriangles() == 1);
+            rp3d_test(mesh->getNbVertices() == 3);
+            mesh->getTriangleVerticesIndices(0, v1Index, v2Index, v3Index);
+            rp3d_test(v1Index == 0 && v2Index == 1 && v3Index == 2);
+            for (uint32 v=0; v < 3; v++) {
+                rp3d_test(approxEqual(mesh->getVertexNormal(v).length(), decimal(1.0)));
+            }
+
+            mPhysicsCommon.destroyTriangleMesh(mesh);
+        }
  };
 
 }
@@ -0,0 +1,187 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_TRIANGLE_SHAPE_BATCH_H
+#define TEST_TRIANGLE_SHAPE_BATCH_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <reactphysics3d/collision/narrowphase/TriangleShapeBatch.h>
+#include "Test.h"
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+
+// Class TestTriangleShapeBatch
+/**
+ * Unit test for the TriangleShapeBatch class.
+ */
+class TestTriangleShapeBatch : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        /// Memory allocator
+        DefaultAllocator mAllocator;
+
+        /// Half-edge structure referenced by the triangle shapes
+        HalfEdgeStructure mTriangleHalfEdgeStructure;
+
+        // ---------- Methods ---------- //
+
+        /// Add a triangle into the triangles arrays of a batch
+        void addTriangle(TriangleShapeBatch& batch, const Vector3& offset, uint32 shapeId) {
+
+            batch.triangleVertices.add(offset + Vector3(0, 0, 0));
+            batch.triangleVertices.add(offset + Vector3(1, 0, 0));
+            batch.triangleVertices.add(offset + Vector3(0, 0, 1));
+
+            batch.triangleVerticesNormals.add(Vector3(0, 1, 0));
+            batch.triangleVerticesNormals.add(Vector3(0, 1, 0));
+            batch.triangleVerticesNormals.add(Vector3(0, 1, 0));
+
+            batch.triangleShapeIds.add(shapeId);
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestTriangleShapeBatch(const std::string& name)
+            : Test(name), mTriangleHalfEdgeStructure(mAllocator, 2, 3, 6) {
+
+        }
+
+        /// Destructor
+        virtual ~TestTriangleShapeBatch() {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testCreateTriangleShapes();
+            testReuseAfterClear();
+            testManyBlocks();
+        }
+
+        void testCreateTriangleShapes() {
+
+            TriangleShapeBatch batch(mAllocator, mTriangleHalfEdgeStructure);
+
+            addTriangle(batch, Vector3(0, 0, 0), 10);
+            addTriangle(batch, Vector3(5, 0, 0), 11);
+
+            TriangleShape* triangle1 = batch.createTriangleShape(0);
+            TriangleShape* triangle2 = batch.createTriangleShape(1);
+
+            rp3d_test(triangle1 != triangle2);
+            rp3d_test(batch.getNbTriangleShapes() == 2);
+            rp3d_test(batch.getNbAllocatedTriangleShapes() == 2);
+
+            rp3d_test(triangle1->getName() == CollisionShapeName::TRIANGLE);
+            rp3d_test(triangle1->getId() == 10);
+            rp3d_test(triangle2->getId() == 11);
+            rp3d_test(triangle2->getVertexPosition(1) == Vector3(6, 0, 0));
+
+            // The triangle normal is computed from the vertices
+            rp3d_test(triangle1->getFaceNormal(0) == Vector3(0, -1, 0));
+
+            // The triangles arrays can be cleared without affecting the shapes
+            batch.clearTriangles();
+            rp3d_test(batch.triangleVertices.size() == 0);
+            rp3d_test(batch.getNbTriangleShapes() == 2);
+            rp3d_test(triangle1->getVertexPosition(2) == Vector3(0, 0, 1));
+        }
+
+        void testReuseAfterClear() {
+
+            TriangleShapeBatch batch(mAllocator, mTriangleHalfEdgeStructure);
+
+            addTriangle(batch, Vector3(0, 0, 0), 1);
+            addTriangle(batch, Vector3(0, 0, 0), 2);
+            TriangleShape* triangle1 = batch.createTriangleShape(0);
+            TriangleShape* triangle2 = batch.createTriangleShape(1);
+
+            batch.clear();
+            rp3d_test(batch.getNbTriangleShapes() == 0);
+            rp3d_test(batch.getNbAllocatedTriangleShapes() == 2);
+            rp3d_test(batch.triangleShapeIds.size() == 0);
+
+            // The shapes of the previous frame are reused with the new triangles
+            addTriangle(batch, Vector3(0, 3, 0), 7);
+            TriangleShape* triangle = batch.createTriangleShape(0);
+
+            rp3d_test(triangle == triangle1);
+            rp3d_test(triangle != triangle2);
+            rp3d_test(triangle->getId() == 7);
+            rp3d_test(triangle->getRaycastTestType() == TriangleRaycastSide::FRONT);
+            rp3d_test(triangle->getVertexPosition(0) == Vector3(0, 3, 0));
+            rp3d_test(batch.getNbTriangleShapes() == 1);
+            rp3d_test(batch.getNbAllocatedTriangleShapes() == 2);
+        }
+
+        void testManyBlocks() {
+
+            TriangleShapeBatch batch(mAllocator, mTriangleHalfEdgeStructure);
+
+            const uint32 nbTriangles = 150;
+            for (uint32 i=0; i < nbTriangles; i++) {
+                addTriangle(batch, Vector3(decimal(i), 0, 0), i);
+            }
+
+            Array<TriangleShape*> triangles(mAllocator);
+            for (uint32 i=0; i < nbTriangles; i++) {
+                triangles.add(batch.createTriangleShape(i));
+            }
+
+            rp3d_test(batch.getNbAllocatedTriangleShapes() == nbTriangles);
+
+            // The shapes of the previous blocks must not have moved
+            bool isValid = true;
+            for (uint32 i=0; i < nbTriangles; i++) {
+                isValid &= triangles[i]->getId() == i;
+                isValid &= triangles[i]->getVertexPosition(0) == Vector3(decimal(i), 0, 0);
+            }
+            rp3d_test(isValid);
+
+            // Reusing all the shapes does not construct new ones
+            batch.clear();
+            for (uint32 i=0; i < nbTriangles; i++) {
+                addTriangle(batch, Vector3(0, decimal(i), 0), i + 1000);
+            }
+            for (uint32 i=0; i < nbTriangles; i++) {
+                rp3d_test(batch.createTriangleShape(i) == triangles[i]);
+            }
+            rp3d_test(batch.getNbAllocatedTriangleShapes() == nbTriangles);
+            rp3d_test(triangles[nbTriangles - 1]->getId() == nbTriangles - 1 + 1000);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,194 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_ASYNC_UPDATE_H
+#define TEST_ASYNC_UPDATE_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestAsyncUpdate
+/**
+ * Unit test for the asynchronous update of a physics world
+ */
+class TestAsyncUpdate : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        // ---------- Methods ---------- //
+
+        /// Create a world with a ground and a few falling boxes
+        static PhysicsWorld* createWorld(PhysicsCommon& physicsCommon, std::vector<RigidBody*>& outBodies) {
+
+            PhysicsWorld* world = physicsCommon.createPhysicsWorld();
+
+            RigidBody* ground = world->createRigidBody(Transform::identity());
+            ground->setType(BodyType::STATIC);
+            ground->addCollider(physicsCommon.createBoxShape(Vector3(20, 1, 20)), Transform::identity());
+            outBodies.push_back(ground);
+
+            for (int i=0; i < 10; i++) {
+                const Vector3 position(decimal(i % 3) * decimal(0.8), decimal(2 + i), decimal(i % 2) * decimal(0.3));
+                RigidBody* box = world->createRigidBody(Transform(position, Quaternion::fromEulerAngles(0, decimal(0.1) * decimal(i), 0)));
+                box->addCollider(physicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5))), Transform::identity());
+                outBodies.push_back(box);
+            }
+
+            return world;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestAsyncUpdate(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testSnapshots();
+            testSameResultAsUpdate();
+            testDestroyWhileRunning();
+        }
+
+        void testSnapshots() {
+
+            std::vector<RigidBody*> bodies;
+            PhysicsWorld* world = createWorld(mPhysicsCommon, bodies);
+            const decimal timeStep = decimal(1.0) / decimal(60.0);
+
+            rp3d_test(!world->isAsyncUpdateRunning());
+            rp3d_test(world->getBodyStateSnapshot().getNbBodies() == 0);
+
+            // The first snapshot contains the state of the bodies before the first step
+            const Vector3 initialPosition = bodies[5]->getTransform().getPosition();
+            world->updateAsync(timeStep);
+
+            const BodyStateSnapshot& snapshot = world->getBodyStateSnapshot();
+            rp3d_test(snapshot.getNbBodies() == bodies.size());
+            rp3d_test(snapshot.getStepIndex() == 0);
+            uint32 index;
+            rp3d_test(snapshot.getBodyIndex(bodies[5]->getEntity(), index));
+            rp3d_test(snapshot.getBodyEntity(index) == bodies[5]->getEntity());
+            rp3d_test(snapshot.getTransform(index).getPosition() == initialPosition);
+            rp3d_test(snapshot.getLinearVelocity(index) == Vector3::zero());
+
+            world->waitForUpdate();
+            rp3d_test(!world->isAsyncUpdateRunning());
+            rp3d_test(world->getNbSteps() == 1);
+
+            // After the fence, the snapshot is the state at the end of the step
+            const BodyStateSnapshot& snapshot1 = world->getBodyStateSnapshot();
+            rp3d_test(snapshot1.getStepIndex() == 1);
+            rp3d_test(snapshot1.getBodyIndex(bodies[5]->getEntity(), index));
+            rp3d_test(snapshot1.getTransform(index) == bodies[5]->getTransform());
+            rp3d_test(snapshot1.getLinearVelocity(index) == bodies[5]->getLinearVelocity());
+            rp3d_test(snapshot1.getLinearVelocity(index).y < decimal(0.0));
+
+            // The snapshot does not change while the next steps are running
+            for (int i=0; i < 30; i++) {
+
+                const Transform previousTransform = bodies[5]->getTransform();
+                world->updateAsync(timeStep);
+
+                const BodyStateSnapshot& previousSnapshot = world->getBodyStateSnapshot();
+                rp3d_test(previousSnapshot.getStepIndex() == uint64(i + 1));
+                rp3d_test(previousSnapshot.getBodyIndex(bodies[5]->getEntity(), index));
+                rp3d_test(previousSnapshot.getTransform(index) == previousTransform);
+
+                world->waitForUpdate();
+            }
+
+            // Calling waitForUpdate() again does nothing
+            world->waitForUpdate();
+            rp3d_test(world->getBodyStateSnapshot().getStepIndex() == 31);
+
+            // A body that is not in the world is not in the snapshot
+            RigidBody* newBody = world->createRigidBody(Transform::identity());
+            rp3d_test(!world->getBodyStateSnapshot().getBodyIndex(newBody->getEntity(), index));
+            world->updateAsync(timeStep);
+            world->waitForUpdate();
+            rp3d_test(world->getBodyStateSnapshot().getBodyIndex(newBody->getEntity(), index));
+            rp3d_test(world->getBodyStateSnapshot().getNbBodies() == bodies.size() + 1);
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        void testSameResultAsUpdate() {
+
+            std::vector<RigidBody*> bodies1;
+            std::vector<RigidBody*> bodies2;
+            // The worlds of a PhysicsCommon share its memory allocators and cannot be updated at the
+            // same time, so the reference world is created with another PhysicsCommon
+            PhysicsCommon physicsCommon2;
+            PhysicsWorld* world1 = createWorld(mPhysicsCommon, bodies1);
+            PhysicsWorld* world2 = createWorld(physicsCommon2, bodies2);
+            const decimal timeStep = decimal(1.0) / decimal(60.0);
+
+            // Starting an asynchronous step waits for the previous one
+            for (int i=0; i < 120; i++) {
+                world1->updateAsync(timeStep);
+                world2->update(timeStep);
+            }
+            world1->waitForUpdate();
+
+            bool isSame = true;
+            for (uint32 i=0; i < bodies1.size(); i++) {
+                isSame &= bodies1[i]->getTransform() == bodies2[i]->getTransform();
+                isSame &= bodies1[i]->getLinearVelocity() == bodies2[i]->getLinearVelocity();
+            }
+            rp3d_test(isSame);
+            rp3d_test(world1->getNbSteps() == world2->getNbSteps());
+
+            mPhysicsCommon.destroyPhysicsWorld(world1);
+            physicsCommon2.destroyPhysicsWorld(world2);
+        }
+
+        void testDestroyWhileRunning() {
+
+            std::vector<RigidBody*> bodies;
+            PhysicsWorld* world = createWorld(mPhysicsCommon, bodies);
+
+            // The destruction of the world waits for the step
+            world->updateAsync(decimal(1.0) / decimal(60.0));
+            mPhysicsCommon.destroyPhysicsWorld(world);
+            rp3d_test(true);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,213 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_CONTACT_EVENT_BUFFER_H
+#define TEST_CONTACT_EVENT_BUFFER_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestContactEventBuffer
+/**
+ * Unit test for the contact event buffer of a physics world
+ */
+class TestContactEventBuffer : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        RigidBody* mGround;
+
+        RigidBody* mSphere1;
+
+        RigidBody* mSphere2;
+
+        RigidBody* mTriggerBody;
+
+        // ---------- Methods ---------- //
+
+        /// Return true if one of the two bodies of a contact event is the given body
+        static bool isEventOfBody(const ContactEvent& event, const Body* body) {
+            return event.body1Entity == body->getEntity() || event.body2Entity == body->getEntity();
+        }
+
+        /// Return true if one of the two bodies of a trigger event is the given body
+        static bool isEventOfBody(const TriggerEvent& event, const Body* body) {
+            return event.body1Entity == body->getEntity() || event.body2Entity == body->getEntity();
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestContactEventBuffer(const std::string& name) : Test(name) {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.isSleepingEnabled = false;
+            mWorld = mPhysicsCommon.createPhysicsWorld(settings);
+
+            mGround = mWorld->createRigidBody(Transform::identity());
+            mGround->setType(BodyType::STATIC);
+            Collider* groundCollider = mGround->addCollider(mPhysicsCommon.createBoxShape(Vector3(10, 1, 10)), Transform::identity());
+            groundCollider->getMaterial().setBounciness(0);
+
+            mSphere1 = mWorld->createRigidBody(Transform(Vector3(-3, 2, 0), Quaternion::identity()));
+            Collider* sphereCollider = mSphere1->addCollider(mPhysicsCommon.createSphereShape(decimal(0.5)), Transform::identity());
+            sphereCollider->getMaterial().setBounciness(0);
+
+            mSphere2 = mWorld->createRigidBody(Transform(Vector3(3, 2, 0), Quaternion::identity()));
+            mSphere2->addCollider(mPhysicsCommon.createSphereShape(decimal(0.5)), Transform::identity());
+
+            // Trigger volume around the top of the first sphere
+            mTriggerBody = mWorld->createRigidBody(Transform(Vector3(-3, decimal(2.8), 0), Quaternion::identity()));
+            mTriggerBody->setType(BodyType::STATIC);
+            Collider* trigger = mTriggerBody->addCollider(mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5))),
+                                                          Transform::identity());
+            trigger->setIsTrigger(true);
+        }
+
+        /// Destructor
+        virtual ~TestContactEventBuffer() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testDisabledByDefault();
+            testEvents();
+        }
+
+        void testDisabledByDefault() {
+
+            rp3d_test(!mWorld->getIsContactEventBufferEnabled());
+            rp3d_test(!mSphere1->isContactEventsEnabled());
+
+            // The buffer stays empty when no body has enabled its events (the first sphere
+            // overlaps with the trigger from the first step)
+            mWorld->setIsContactEventBufferEnabled(true);
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            rp3d_test(mWorld->getContactEventBuffer().getNbEvents() == 0);
+        }
+
+        void testEvents() {
+
+            mWorld->setIsContactEventBufferEnabled(true);
+            mSphere1->setIsContactEventsEnabled(true);
+            rp3d_test(mSphere1->isContactEventsEnabled());
+            rp3d_test(!mSphere2->isContactEventsEnabled());
+
+            const ContactEventBuffer& buffer = mWorld->getContactEventBuffer();
+            typedef ContactEventBuffer::EventType EventType;
+
+            uint32 nbBeginContacts = 0;
+            uint32 nbStayContacts = 0;
+            uint32 nbStayTriggers = 0;
+            uint32 nbEndTriggers = 0;
+            bool isStayEventValid = true;
+
+            // Let the spheres fall on the ground
+            for (int i=0; i < 90; i++) {
+
+                mWorld->update(decimal(1.0) / decimal(60.0));
+
+                // Only the pairs of the first sphere are reported
+                for (EventType type : {EventType::Begin, EventType::Stay, EventType::End}) {
+                    for (uint32 e=0; e < buffer.getContactEvents(type).size(); e++) {
+                        rp3d_test(isEventOfBody(buffer.getContactEvents(type)[e], mSphere1));
+                    }
+                    for (uint32 e=0; e < buffer.getTriggerEvents(type).size(); e++) {
+                        rp3d_test(isEventOfBody(buffer.getTriggerEvents(type)[e], mTriggerBody));
+                    }
+                }
+
+                nbBeginContacts += static_cast<uint32>(buffer.getContactEvents(EventType::Begin).size());
+                nbStayTriggers += static_cast<uint32>(buffer.getTriggerEvents(EventType::Stay).size());
+                nbEndTriggers += static_cast<uint32>(buffer.getTriggerEvents(EventType::End).size());
+                rp3d_test(buffer.getContactEvents(EventType::End).size() == 0);
+                rp3d_test(buffer.getTriggerEvents(EventType::Begin).size() == 0);
+
+                const Array<ContactEvent>& stayEvents = buffer.getContactEvents(EventType::Stay);
+                for (uint32 e=0; e < stayEvents.size(); e++) {
+
+                    const ContactEvent& event = stayEvents[e];
+                    nbStayContacts++;
+
+                    isStayEventValid &= isEventOfBody(event, mGround);
+                    isStayEventValid &= event.nbContactPoints == 1;
+                    isStayEventValid &= approxEqual(std::abs(event.normal.y), decimal(1.0), decimal(0.01));
+                    isStayEventValid &= approxEqual(event.point.x, decimal(-3.0), decimal(0.05));
+                    isStayEventValid &= approxEqual(event.point.y, decimal(1.0), decimal(0.05));
+                }
+            }
+
+            rp3d_test(nbBeginContacts == 1);
+            rp3d_test(nbStayContacts > 0);
+            rp3d_test(isStayEventValid);
+            rp3d_test(nbStayTriggers > 0);
+            rp3d_test(nbEndTriggers == 1);
+
+            // The resting sphere is supported by the ground (impulse of about m * g * dt)
+            rp3d_test(buffer.getContactEvents(EventType::Stay).size() == 1);
+            const ContactEvent& restingEvent = buffer.getContactEvents(EventType::Stay)[0];
+            const decimal expectedImpulse = mSphere1->getMass() * decimal(9.81) / decimal(60.0);
+            rp3d_test(approxEqual(restingEvent.normalImpulse, expectedImpulse, expectedImpulse * decimal(0.05)));
+
+            // The events are not reported anymore once the body has disabled them
+            mSphere1->setIsContactEventsEnabled(false);
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            rp3d_test(buffer.getNbEvents() == 0);
+
+            // Move the first sphere away from the ground
+            mSphere1->setIsContactEventsEnabled(true);
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            rp3d_test(buffer.getContactEvents(EventType::Stay).size() == 1);
+            rp3d_test(buffer.getContactEvents(EventType::Begin).size() == 0);
+            mSphere1->setTransform(Transform(Vector3(-3, 10, 0), Quaternion::identity()));
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            rp3d_test(buffer.getContactEvents(EventType::End).size() == 1);
+            rp3d_test(buffer.getContactEvents(EventType::Stay).size() == 0);
+            rp3d_test(buffer.getContactEvents(EventType::End)[0].nbContactPoints == 0);
+
+            // The buffer is emptied when it is disabled
+            mWorld->setIsContactEventBufferEnabled(false);
+            rp3d_test(buffer.getNbEvents() == 0);
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            rp3d_test(buffer.getNbEvents() == 0);
+        }
+ };
+
+}
+
+#endif
@@ -0,0 +1,190 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_DETERMINISM_H
+#define TEST_DETERMINISM_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestDeterminism
+/**
+ * Regression test for the deterministic mode of the physics world. The transforms
+ * of the bodies are hashed after each step of a reference scene. With the deterministic
+ * build (IS_RP3D_DETERMINISTIC_ENABLED), the hash must be the same on all the platforms.
+ */
+class TestDeterminism : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        // ---------- Methods ---------- //
+
+        /// Hash a buffer with the FNV-1a hash function
+        static uint64 hashBytes(uint64 hash, const void* data, size_t size) {
+
+            const uint8* bytes = static_cast<const uint8*>(data);
+            for (size_t i=0; i < size; i++) {
+                hash ^= bytes[i];
+                hash *= 1099511628211ull;
+            }
+            return hash;
+        }
+
+        /// Create the reference scene in a new world
+        PhysicsWorld* createScene(std::vector<RigidBody*>& bodies) {
+
+            PhysicsWorld::WorldSettings settings;
+            settings.isDeterministic = true;
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld(settings);
+
+            // Static ground
+            RigidBody* ground = world->createRigidBody(Transform(Vector3(0, -1, 0), Quaternion::identity()));
+            ground->setType(BodyType::STATIC);
+            ground->addCollider(mPhysicsCommon.createBoxShape(Vector3(30, 1, 30)), Transform::identity());
+
+            // Pyramid of boxes and spheres falling on the ground
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            SphereShape* sphereShape = mPhysicsCommon.createSphereShape(decimal(0.4));
+            CapsuleShape* capsuleShape = mPhysicsCommon.createCapsuleShape(decimal(0.3), decimal(1.0));
+            for (int level=0; level < 4; level++) {
+                for (int i=0; i < 4 - level; i++) {
+                    const Vector3 position(decimal(i) * decimal(1.1) + decimal(level) * decimal(0.55), decimal(0.5) + decimal(level) * decimal(1.05),
+                                           decimal(0.1) * decimal(level));
+                    RigidBody* body = world->createRigidBody(Transform(position, Quaternion::fromEulerAngles(0, decimal(0.1) * i, 0)));
+                    body->addCollider(boxShape, Transform::identity());
+                    bodies.push_back(body);
+                }
+            }
+            for (int i=0; i < 6; i++) {
+                RigidBody* body = world->createRigidBody(Transform(Vector3(decimal(0.3) * i, decimal(6.0) + decimal(1.2) * i, decimal(0.2) * i),
+                                                                   Quaternion::identity()));
+                body->addCollider(i % 2 == 0 ? static_cast<CollisionShape*>(sphereShape) : static_cast<CollisionShape*>(capsuleShape),
+                                  Transform::identity());
+                bodies.push_back(body);
+            }
+
+            // Chain of bodies with a ball and socket joint (with cone limit) and a hinge joint (with limits)
+            RigidBody* anchor = world->createRigidBody(Transform(Vector3(-5, 6, 0), Quaternion::identity()));
+            anchor->setType(BodyType::STATIC);
+            RigidBody* link1 = world->createRigidBody(Transform(Vector3(-3, 6, 0), Quaternion::identity()));
+            link1->addCollider(boxShape, Transform::identity());
+            bodies.push_back(link1);
+            RigidBody* link2 = world->createRigidBody(Transform(Vector3(-1, 6, 0), Quaternion::identity()));
+            link2->addCollider(boxShape, Transform::identity());
+            bodies.push_back(link2);
+
+            BallAndSocketJointInfo ballAndSocketJointInfo(anchor, link1, Vector3(-4, 6, 0));
+            BallAndSocketJoint* ballAndSocketJoint = static_cast<BallAndSocketJoint*>(world->createJoint(ballAndSocketJointInfo));
+            ballAndSocketJoint->setConeLimitHalfAngle(PI_RP3D / decimal(6.0));
+            ballAndSocketJoint->enableConeLimit(true);
+
+            HingeJointInfo hingeJointInfo(link1, link2, Vector3(-2, 6, 0), Vector3(0, 0, 1), -PI_RP3D / decimal(3.0), PI_RP3D / decimal(3.0));
+            world->createJoint(hingeJointInfo);
+
+            return world;
+        }
+
+        /// Simulate the reference scene and return the hash of the transforms after each step
+        std::vector<uint64> simulateScene(int nbSteps) {
+
+            std::vector<RigidBody*> bodies;
+            PhysicsWorld* world = createScene(bodies);
+
+            std::vector<uint64> frameHashes;
+            uint64 hash = 14695981039346656037ull;
+            for (int i=0; i < nbSteps; i++) {
+
+                world->update(decimal(1.0) / decimal(60.0));
+
+                for (RigidBody* body : bodies) {
+                    const Transform& transform = body->getTransform();
+                    const decimal values[7] = {transform.getPosition().x, transform.getPosition().y, transform.getPosition().z,
+                                               transform.getOrientation().x, transform.getOrientation().y,
+                                               transform.getOrientation().z, transform.getOrientation().w};
+                    hash = hashBytes(hash, values, sizeof(values));
+                }
+                frameHashes.push_back(hash);
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+
+            return frameHashes;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestDeterminism(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testReproducibility();
+            testReferenceHash();
+        }
+
+        /// Check that the same scene gives the same transforms at each step
+        void testReproducibility() {
+
+            const std::vector<uint64> frameHashes1 = simulateScene(240);
+            const std::vector<uint64> frameHashes2 = simulateScene(240);
+
+            rp3d_test(frameHashes1.size() == 240);
+            rp3d_test(frameHashes1 == frameHashes2);
+        }
+
+        /// Compare the hash of the reference scene with the value obtained on the reference platform
+        void testReferenceHash() {
+
+#ifdef IS_RP3D_DETERMINISTIC_ENABLED
+
+            // Hash of the transforms after the last step. If a change of the library modifies the
+            // simulation on purpose, this value must be updated (on any platform) in the same change.
+#if defined(IS_RP3D_DOUBLE_PRECISION_ENABLED)
+            const uint64 referenceHash = 9928126189132151246ull;
+#else
+            const uint64 referenceHash = 7506883671002674559ull;
+#endif
+
+            const std::vector<uint64> frameHashes = simulateScene(240);
+            rp3d_test(frameHashes.back() == referenceHash);
+#endif
+        }
+};
+
+}
+
+#endif
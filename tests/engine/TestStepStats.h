@@ -0,0 +1,125 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_STEP_STATS_H
+#define TEST_STEP_STATS_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestStepStats
+/**
+ * Unit test for the statistics of the steps of a physics world
+ */
+class TestStepStats : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestStepStats(const std::string& name) : Test(name) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            RigidBody* ground = mWorld->createRigidBody(Transform::identity());
+            ground->setType(BodyType::STATIC);
+            ground->addCollider(mPhysicsCommon.createBoxShape(Vector3(10, 1, 10)), Transform::identity());
+
+            RigidBody* sphere1 = mWorld->createRigidBody(Transform(Vector3(-3, 2, 0), Quaternion::identity()));
+            sphere1->addCollider(mPhysicsCommon.createSphereShape(decimal(0.5)), Transform::identity());
+
+            RigidBody* sphere2 = mWorld->createRigidBody(Transform(Vector3(3, 2, 0), Quaternion::identity()));
+            sphere2->addCollider(mPhysicsCommon.createSphereShape(decimal(0.5)), Transform::identity());
+        }
+
+        /// Destructor
+        virtual ~TestStepStats() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testStepStats();
+        }
+
+        void testStepStats() {
+
+            // No step has been taken yet
+            rp3d_test(mWorld->getLastStepStats().nbOverlappingPairs == 0);
+            rp3d_test(mWorld->getLastStepStats().totalTime == 0.0);
+
+            // Let the spheres fall on the ground
+            for (int i=0; i < 60; i++) {
+                mWorld->update(decimal(1.0) / decimal(60.0));
+            }
+
+            const StepStats& stats = mWorld->getLastStepStats();
+            rp3d_test(stats.nbOverlappingPairs == 2);
+            rp3d_test(stats.nbNarrowPhaseTests == 2);
+            rp3d_test(stats.nbContactPairs == 2);
+            rp3d_test(stats.nbContactManifolds == 2);
+            rp3d_test(stats.nbContactPoints == 2);
+            rp3d_test(stats.nbIslands == 2);
+            rp3d_test(stats.nbAwakeBodies == 2);
+            rp3d_test(stats.nbVelocitySolverIterations == mWorld->getNbIterationsVelocitySolver());
+            rp3d_test(stats.nbPositionSolverIterations == mWorld->getNbIterationsPositionSolver());
+
+            rp3d_test(stats.broadPhaseTime >= 0.0);
+            rp3d_test(stats.middlePhaseTime >= 0.0);
+            rp3d_test(stats.narrowPhaseTime >= 0.0);
+            rp3d_test(stats.islandsTime >= 0.0);
+            rp3d_test(stats.solveTime >= 0.0);
+            rp3d_test(stats.integrateTime >= 0.0);
+            rp3d_test(stats.totalTime > 0.0);
+            rp3d_test(stats.totalTime >= stats.broadPhaseTime + stats.middlePhaseTime + stats.narrowPhaseTime +
+                                        stats.islandsTime + stats.solveTime + stats.integrateTime);
+            rp3d_test(stats.to_string().find("nbContactManifolds=2") != std::string::npos);
+
+            // Once the spheres are sleeping, they are not simulated anymore
+            for (int i=0; i < 300; i++) {
+                mWorld->update(decimal(1.0) / decimal(60.0));
+            }
+
+            rp3d_test(mWorld->getLastStepStats().nbAwakeBodies == 0);
+            rp3d_test(mWorld->getLastStepStats().nbIslands == 0);
+        }
+ };
+
+}
+
+#endif
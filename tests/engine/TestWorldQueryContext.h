@@ -0,0 +1,290 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_WORLD_QUERY_CONTEXT_H
+#define TEST_WORLD_QUERY_CONTEXT_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <algorithm>
+#include <thread>
+#include <utility>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class QueryContextRaycastCallback
+class QueryContextRaycastCallback : public RaycastCallback {
+
+    public:
+
+        std::vector<std::pair<uint32, decimal>> hits;
+
+        virtual decimal notifyRaycastHit(const RaycastInfo& info) override {
+            hits.push_back(std::make_pair(info.body->getEntity().id, info.hitFraction));
+            return decimal(1.0);
+        }
+};
+
+// Class QueryContextOverlapCallback
+class QueryContextOverlapCallback : public OverlapCallback {
+
+    public:
+
+        std::vector<std::pair<uint32, uint32>> pairs;
+
+        virtual void onOverlap(CallbackData& callbackData) override {
+
+            for (uint32 i=0; i < callbackData.getNbOverlappingPairs(); i++) {
+
+                OverlapPair overlapPair = callbackData.getOverlappingPair(i);
+                const uint32 id1 = overlapPair.getBody1()->getEntity().id;
+                const uint32 id2 = overlapPair.getBody2()->getEntity().id;
+                pairs.push_back(std::make_pair(std::min(id1, id2), std::max(id1, id2)));
+            }
+        }
+};
+
+// Class TestWorldQueryContext
+/**
+ * Unit test for the thread-safe queries of the WorldQueryContext class
+ */
+class TestWorldQueryContext : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        PhysicsWorld* mWorld;
+
+        std::vector<RigidBody*> mBodies;
+
+        float mHeightFieldData[100];
+
+        // ---------- Methods ---------- //
+
+        /// Return the sorted results of all the queries of the scene using a given query method
+        template<typename RaycastMethod, typename OverlapBodyMethod, typename OverlapPairMethod>
+        std::vector<std::vector<std::pair<uint32, decimal>>> runQueries(RaycastMethod raycast, OverlapBodyMethod testOverlapBody,
+                                                                        OverlapPairMethod testOverlapPair, std::vector<std::pair<uint32, uint32>>& outPairs,
+                                                                        std::vector<bool>& outOverlaps) {
+
+            std::vector<std::vector<std::pair<uint32, decimal>>> rayHits;
+
+            // Vertical rays over the scene and a few rays with a category mask
+            for (int i=0; i < 11; i++) {
+                for (int j=0; j < 11; j++) {
+
+                    const Vector3 origin(decimal(-4.5) + decimal(0.9) * i, decimal(10), decimal(-4.5) + decimal(0.9) * j);
+                    const Ray ray(origin, origin - Vector3(0, 20, 0));
+                    QueryContextRaycastCallback callback;
+                    raycast(ray, callback, (i + j) % 4 == 0 ? 0x0002 : 0xFFFF);
+                    std::sort(callback.hits.begin(), callback.hits.end());
+                    rayHits.push_back(callback.hits);
+                }
+            }
+
+            // Overlaps of each body with the other ones
+            for (uint32 b=0; b < mBodies.size(); b++) {
+
+                QueryContextOverlapCallback callback;
+                testOverlapBody(mBodies[b], callback);
+                outPairs.insert(outPairs.end(), callback.pairs.begin(), callback.pairs.end());
+            }
+            std::sort(outPairs.begin(), outPairs.end());
+
+            // Overlaps between two given bodies
+            for (uint32 b1=0; b1 < mBodies.size(); b1++) {
+                for (uint32 b2=b1 + 1; b2 < mBodies.size(); b2++) {
+                    outOverlaps.push_back(testOverlapPair(mBodies[b1], mBodies[b2]));
+                }
+            }
+
+            return rayHits;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestWorldQueryContext(const std::string& name) : Test(name) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            // Bumpy height field ground
+            for (int i=0; i < 100; i++) mHeightFieldData[i] = float(std::sin(i * 0.7)) * 0.5f;
+            std::vector<Message> messages;
+            HeightField* heightField = mPhysicsCommon.createHeightField(10, 10, mHeightFieldData, HeightField::HeightDataType::HEIGHT_FLOAT_TYPE, messages);
+            RigidBody* ground = mWorld->createRigidBody(Transform::identity());
+            ground->setType(BodyType::STATIC);
+            ground->addCollider(mPhysicsCommon.createHeightFieldShape(heightField), Transform::identity());
+            mBodies.push_back(ground);
+
+            // Grid of bodies with different shapes, close enough to overlap with some of their neighbours
+            for (int i=0; i < 5; i++) {
+                for (int j=0; j < 5; j++) {
+
+                    const Vector3 position(decimal(-3.6) + decimal(1.7) * i + decimal(0.05) * j, decimal(0.2) + decimal(0.25) * ((i + j) % 3),
+                                           decimal(-3.6) + decimal(1.6) * j);
+                    RigidBody* body = mWorld->createRigidBody(Transform(position, Quaternion::fromEulerAngles(0, decimal(0.3) * i, decimal(0.2) * j)));
+
+                    Collider* collider;
+                    switch ((i + j) % 3) {
+                        case 0: collider = body->addCollider(mPhysicsCommon.createSphereShape(decimal(0.9)), Transform::identity()); break;
+                        case 1: collider = body->addCollider(mPhysicsCommon.createBoxShape(Vector3(decimal(0.8), decimal(0.5), decimal(0.7))), Transform::identity()); break;
+                        default: collider = body->addCollider(mPhysicsCommon.createCapsuleShape(decimal(0.4), decimal(1.2)), Transform::identity()); break;
+                    }
+
+                    // Some bodies are in another category and only collide with the ground
+                    if (i == 2) {
+                        collider->setCollisionCategoryBits(0x0002);
+                        collider->setCollideWithMaskBits(0x0001);
+                    }
+
+                    mBodies.push_back(body);
+                }
+            }
+
+            // An inactive body cannot be hit by rays
+            mBodies[7]->setIsActive(false);
+        }
+
+        /// Destructor
+        virtual ~TestWorldQueryContext() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testSameResultsAsWorld();
+            testConcurrentQueries();
+        }
+
+        void testSameResultsAsWorld() {
+
+            WorldQueryContext context(*mWorld);
+            rp3d_test(&context.getWorld() == mWorld);
+
+            // Results of the queries of the world
+            std::vector<std::pair<uint32, uint32>> worldPairs;
+            std::vector<bool> worldOverlaps;
+            const std::vector<std::vector<std::pair<uint32, decimal>>> worldRayHits = runQueries(
+                [&](const Ray& ray, RaycastCallback& callback, uint64 mask) { mWorld->raycast(ray, &callback, mask); },
+                [&](Body* body, OverlapCallback& callback) { mWorld->testOverlap(body, callback); },
+                [&](Body* body1, Body* body2) { return mWorld->testOverlap(body1, body2); },
+                worldPairs, worldOverlaps);
+
+            // Results of the queries of the context
+            std::vector<std::pair<uint32, uint32>> contextPairs;
+            std::vector<bool> contextOverlaps;
+            const std::vector<std::vector<std::pair<uint32, decimal>>> contextRayHits = runQueries(
+                [&](const Ray& ray, RaycastCallback& callback, uint64 mask) { context.raycast(ray, &callback, mask); },
+                [&](Body* body, OverlapCallback& callback) { context.testOverlap(body, callback); },
+                [&](Body* body1, Body* body2) { return context.testOverlap(body1, body2); },
+                contextPairs, contextOverlaps);
+
+            // Make sure that the scene exercises the different cases
+            uint32 nbHits = 0;
+            for (uint32 i=0; i < worldRayHits.size(); i++) nbHits += static_cast<uint32>(worldRayHits[i].size());
+            rp3d_test(nbHits > 121);
+            rp3d_test(worldPairs.size() > 20);
+            rp3d_test(std::count(worldOverlaps.begin(), worldOverlaps.end(), true) > 10);
+            rp3d_test(std::count(worldOverlaps.begin(), worldOverlaps.end(), false) > 10);
+
+            rp3d_test(contextRayHits == worldRayHits);
+            rp3d_test(contextPairs == worldPairs);
+            rp3d_test(contextOverlaps == worldOverlaps);
+
+            // The inactive body is never hit
+            bool isInactiveBodyHit = false;
+            for (uint32 i=0; i < contextRayHits.size(); i++) {
+                for (uint32 h=0; h < contextRayHits[i].size(); h++) {
+                    isInactiveBodyHit |= contextRayHits[i][h].first == mBodies[7]->getEntity().id;
+                }
+            }
+            rp3d_test(!isInactiveBodyHit);
+        }
+
+        void testConcurrentQueries() {
+
+            // Reference results computed on a single thread
+            WorldQueryContext context(*mWorld);
+            std::vector<std::pair<uint32, uint32>> referencePairs;
+            std::vector<bool> referenceOverlaps;
+            const std::vector<std::vector<std::pair<uint32, decimal>>> referenceRayHits = runQueries(
+                [&](const Ray& ray, RaycastCallback& callback, uint64 mask) { context.raycast(ray, &callback, mask); },
+                [&](Body* body, OverlapCallback& callback) { context.testOverlap(body, callback); },
+                [&](Body* body1, Body* body2) { return context.testOverlap(body1, body2); },
+                referencePairs, referenceOverlaps);
+
+            // Several threads run all the queries at the same time, each one with its own context
+            const int nbThreads = 4;
+            const int nbIterations = 10;
+            std::vector<int> nbMismatches(nbThreads, 0);
+            std::vector<std::thread> threads;
+            for (int t=0; t < nbThreads; t++) {
+
+                threads.emplace_back([&, t]() {
+
+                    WorldQueryContext threadContext(*mWorld);
+                    for (int i=0; i < nbIterations; i++) {
+
+                        std::vector<std::pair<uint32, uint32>> pairs;
+                        std::vector<bool> overlaps;
+                        const std::vector<std::vector<std::pair<uint32, decimal>>> rayHits = runQueries(
+                            [&](const Ray& ray, RaycastCallback& callback, uint64 mask) { threadContext.raycast(ray, &callback, mask); },
+                            [&](Body* body, OverlapCallback& callback) { threadContext.testOverlap(body, callback); },
+                            [&](Body* body1, Body* body2) { return threadContext.testOverlap(body1, body2); },
+                            pairs, overlaps);
+
+                        if (rayHits != referenceRayHits || pairs != referencePairs || overlaps != referenceOverlaps) {
+                            nbMismatches[t]++;
+                        }
+                    }
+                });
+            }
+
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+
+            for (int t=0; t < nbThreads; t++) {
+                rp3d_test(nbMismatches[t] == 0);
+            }
+
+            // The world can still be updated after the queries
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            rp3d_test(mWorld->getNbSteps() == 1);
+        }
+ };
+
+}
+
+#endif
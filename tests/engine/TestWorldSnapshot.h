@@ -0,0 +1,335 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_WORLD_SNAPSHOT_H
+#define TEST_WORLD_SNAPSHOT_H
+
+// Libraries
+#include <reactphysics3d/reactphysics3d.h>
+#include <vector>
+#include <cstring>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestWorldSnapshot
+/**
+ * Unit test for the snapshot and restore of the state of a PhysicsWorld.
+ */
+class TestWorldSnapshot : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+        PhysicsWorld* mWorld;
+
+        std::vector<RigidBody*> mBodies;
+
+        SliderJoint* mSliderJoint;
+        FixedJoint* mFixedJoint;
+
+        TriangleMesh* mGroundMesh;
+        std::vector<Vector3> mGroundVertices;
+        std::vector<uint> mGroundIndices;
+
+        // ---------- Methods ---------- //
+
+        /// Simulate the world and return the transforms and velocities of the bodies after each step
+        std::vector<decimal> simulate(int nbSteps) {
+
+            std::vector<decimal> states;
+            for (int i=0; i < nbSteps; i++) {
+
+                mWorld->update(decimal(1.0) / decimal(60.0));
+
+                for (RigidBody* body : mBodies) {
+                    const Transform& transform = body->getTransform();
+                    const Vector3& linearVelocity = body->getLinearVelocity();
+                    const Vector3& angularVelocity = body->getAngularVelocity();
+                    states.push_back(transform.getPosition().x);
+                    states.push_back(transform.getPosition().y);
+                    states.push_back(transform.getPosition().z);
+                    states.push_back(transform.getOrientation().x);
+                    states.push_back(transform.getOrientation().y);
+                    states.push_back(transform.getOrientation().z);
+                    states.push_back(transform.getOrientation().w);
+                    states.push_back(linearVelocity.x);
+                    states.push_back(linearVelocity.y);
+                    states.push_back(linearVelocity.z);
+                    states.push_back(angularVelocity.x);
+                    states.push_back(angularVelocity.y);
+                    states.push_back(angularVelocity.z);
+                }
+            }
+
+            return states;
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestWorldSnapshot(const std::string& name) : Test(name) {
+
+            mWorld = mPhysicsCommon.createPhysicsWorld();
+
+            // Static concave ground made of two triangles
+            mGroundVertices.push_back(Vector3(-20, 0, -20)); mGroundVertices.push_back(Vector3(20, 0, -20));
+            mGroundVertices.push_back(Vector3(20, 0, 20)); mGroundVertices.push_back(Vector3(-20, 0, 20));
+            mGroundIndices.push_back(0); mGroundIndices.push_back(2); mGroundIndices.push_back(1);
+            mGroundIndices.push_back(0); mGroundIndices.push_back(3); mGroundIndices.push_back(2);
+            TriangleVertexArray::VertexDataType vertexType = sizeof(decimal) == 4 ? TriangleVertexArray::VertexDataType::VERTEX_FLOAT_TYPE :
+                                                                                    TriangleVertexArray::VertexDataType::VERTEX_DOUBLE_TYPE;
+            TriangleVertexArray groundVertexArray(4, &(mGroundVertices[0]), sizeof(Vector3), 2, &(mGroundIndices[0]), 3 * sizeof(uint),
+                                                  vertexType, TriangleVertexArray::IndexDataType::INDEX_INTEGER_TYPE);
+            std::vector<Message> errors;
+            mGroundMesh = mPhysicsCommon.createTriangleMesh(groundVertexArray, errors);
+            RigidBody* ground = mWorld->createRigidBody(Transform::identity());
+            ground->setType(BodyType::STATIC);
+            ground->addCollider(mPhysicsCommon.createConcaveMeshShape(mGroundMesh), Transform::identity());
+
+            // Stack of boxes resting on the ground
+            BoxShape* boxShape = mPhysicsCommon.createBoxShape(Vector3(decimal(0.5), decimal(0.5), decimal(0.5)));
+            for (int i=0; i < 4; i++) {
+                RigidBody* box = mWorld->createRigidBody(Transform(Vector3(decimal(0.05) * i, decimal(0.5) + i * decimal(1.01), 0),
+                                                                   Quaternion::identity()));
+                box->addCollider(boxShape, Transform::identity());
+                mBodies.push_back(box);
+            }
+
+            // Box on a stack of convex-convex contacts
+            RigidBody* fallingBox = mWorld->createRigidBody(Transform(Vector3(5, 3, 0), Quaternion::fromEulerAngles(decimal(0.3), decimal(0.2), decimal(0.1))));
+            fallingBox->addCollider(boxShape, Transform::identity());
+            mBodies.push_back(fallingBox);
+
+            // Pendulum attached to a static body with a ball and socket joint
+            RigidBody* anchor = mWorld->createRigidBody(Transform(Vector3(-5, 6, 0), Quaternion::identity()));
+            anchor->setType(BodyType::STATIC);
+            RigidBody* pendulum = mWorld->createRigidBody(Transform(Vector3(-3, 6, 0), Quaternion::identity()));
+            pendulum->addCollider(mPhysicsCommon.createSphereShape(decimal(0.5)), Transform::identity());
+            mBodies.push_back(pendulum);
+            BallAndSocketJointInfo ballAndSocketJointInfo(anchor, pendulum, Vector3(-5, 6, 0));
+            mWorld->createJoint(ballAndSocketJointInfo);
+
+            // Door attached to the pendulum with a hinge joint
+            RigidBody* door = mWorld->createRigidBody(Transform(Vector3(-2, 6, 0), Quaternion::identity()));
+            door->addCollider(boxShape, Transform::identity());
+            mBodies.push_back(door);
+            HingeJointInfo hingeJointInfo(pendulum, door, Vector3(decimal(-2.5), 6, 0), Vector3(0, 0, 1), -PI_RP3D / 4, PI_RP3D / 4);
+            mWorld->createJoint(hingeJointInfo);
+
+            // Carriage attached to a static rail with a slider joint (it slides down to its lower limit)
+            RigidBody* rail = mWorld->createRigidBody(Transform(Vector3(8, 6, 0), Quaternion::identity()));
+            rail->setType(BodyType::STATIC);
+            RigidBody* carriage = mWorld->createRigidBody(Transform(Vector3(8, 6, 0), Quaternion::identity()));
+            carriage->addCollider(boxShape, Transform::identity());
+            mBodies.push_back(carriage);
+            SliderJointInfo sliderJointInfo(rail, carriage, Vector3(8, 6, 0), Vector3(1, 1, 0), decimal(-1.5), decimal(1.5));
+            mSliderJoint = static_cast<SliderJoint*>(mWorld->createJoint(sliderJointInfo));
+
+            // Load welded to the carriage with a fixed joint
+            RigidBody* load = mWorld->createRigidBody(Transform(Vector3(9, 6, 0), Quaternion::identity()));
+            load->addCollider(mPhysicsCommon.createSphereShape(decimal(0.4)), Transform::identity());
+            mBodies.push_back(load);
+            FixedJointInfo fixedJointInfo(carriage, load, Vector3(decimal(8.5), 6, 0));
+            mFixedJoint = static_cast<FixedJoint*>(mWorld->createJoint(fixedJointInfo));
+        }
+
+        /// Destructor
+        virtual ~TestWorldSnapshot() {
+            mPhysicsCommon.destroyPhysicsWorld(mWorld);
+        }
+
+        /// Run the tests
+        void run() {
+            testRestoreIsDeterministic();
+            testRestoreAfterBroadPhaseGrowth();
+            testSliderAndFixedJoints();
+            testInvalidSnapshot();
+            testFailedRestoreKeepsWorld();
+        }
+
+        /// Check that the simulation after restoring a snapshot is identical to the simulation after taking it
+        void testRestoreIsDeterministic() {
+
+            // Simulate until the boxes are in contact with the ground and with each other
+            simulate(30);
+
+            std::vector<uint8> snapshot;
+            mWorld->takeSnapshot(snapshot);
+            rp3d_test(snapshot.size() > 0);
+
+            const std::vector<decimal> statesAfterSnapshot = simulate(40);
+
+            rp3d_test(mWorld->restoreSnapshot(snapshot.data(), snapshot.size()));
+
+            const std::vector<decimal> statesAfterRestore = simulate(40);
+
+            rp3d_test(statesAfterSnapshot.size() == statesAfterRestore.size());
+            rp3d_test(std::memcmp(statesAfterSnapshot.data(), statesAfterRestore.data(), statesAfterSnapshot.size() * sizeof(decimal)) == 0);
+
+            // The same snapshot can be restored several times
+            rp3d_test(mWorld->restoreSnapshot(snapshot.data(), snapshot.size()));
+
+            const std::vector<decimal> statesAfterSecondRestore = simulate(40);
+            rp3d_test(std::memcmp(statesAfterSnapshot.data(), statesAfterSecondRestore.data(), statesAfterSnapshot.size() * sizeof(decimal)) == 0);
+
+            // Taking a snapshot of the restored world gives the same snapshot
+            rp3d_test(mWorld->restoreSnapshot(snapshot.data(), snapshot.size()));
+            std::vector<uint8> snapshot2;
+            mWorld->takeSnapshot(snapshot2);
+            rp3d_test(snapshot == snapshot2);
+        }
+
+        /// Check that the simulation after a restore is identical even if the broad-phase has grown
+        /// (more moved shapes than at the time of the snapshot) between the snapshot and the restore
+        void testRestoreAfterBroadPhaseGrowth() {
+
+            std::vector<uint8> snapshot;
+            mWorld->takeSnapshot(snapshot);
+
+            const std::vector<decimal> statesAfterSnapshot = simulate(20);
+            std::vector<uint8> snapshotAfterSteps;
+            mWorld->takeSnapshot(snapshotAfterSteps);
+
+            // Temporary bodies are created and destroyed to grow the set of moved shapes of the broad-phase
+            std::vector<RigidBody*> temporaryBodies;
+            SphereShape* sphereShape = mPhysicsCommon.createSphereShape(decimal(0.2));
+            for (int i=0; i < 100; i++) {
+                RigidBody* body = mWorld->createRigidBody(Transform(Vector3(-15 + (i % 10) * decimal(0.5), 10, -15 + (i / 10) * decimal(0.5)),
+                                                                    Quaternion::identity()));
+                body->addCollider(sphereShape, Transform::identity());
+                temporaryBodies.push_back(body);
+            }
+            mWorld->update(decimal(1.0) / decimal(60.0));
+            for (RigidBody* body : temporaryBodies) {
+                mWorld->destroyRigidBody(body);
+            }
+
+            rp3d_test(mWorld->restoreSnapshot(snapshot.data(), snapshot.size()));
+
+            const std::vector<decimal> statesAfterRestore = simulate(20);
+            rp3d_test(statesAfterSnapshot.size() == statesAfterRestore.size());
+            rp3d_test(std::memcmp(statesAfterSnapshot.data(), statesAfterRestore.data(), statesAfterSnapshot.size() * sizeof(decimal)) == 0);
+
+            // The internal state of the world (order of the overlapping pairs, ...) is also identical
+            std::vector<uint8> snapshotAfterRestoredSteps;
+            mWorld->takeSnapshot(snapshotAfterRestoredSteps);
+            rp3d_test(snapshotAfterRestoredSteps == snapshotAfterSteps);
+        }
+
+        /// Check that the state of the slider and fixed joints is restored
+        void testSliderAndFixedJoints() {
+
+            simulate(30);
+
+            std::vector<uint8> snapshot;
+            mWorld->takeSnapshot(snapshot);
+            const decimal translation = mSliderJoint->getTranslation();
+            const Vector3 sliderForce = mSliderJoint->getReactionForce(decimal(1.0) / decimal(60.0));
+            const Vector3 fixedForce = mFixedJoint->getReactionForce(decimal(1.0) / decimal(60.0));
+            const Vector3 fixedTorque = mFixedJoint->getReactionTorque(decimal(1.0) / decimal(60.0));
+
+            // The carriage has reached the lower limit of the slider and the joints hold the load
+            rp3d_test(translation < decimal(-1.0));
+            rp3d_test(sliderForce.lengthSquare() > decimal(0.0));
+            rp3d_test(fixedForce.lengthSquare() > decimal(0.0));
+
+            simulate(20);
+
+            rp3d_test(mWorld->restoreSnapshot(snapshot.data(), snapshot.size()));
+            rp3d_test(mSliderJoint->getTranslation() == translation);
+            rp3d_test(mSliderJoint->getReactionForce(decimal(1.0) / decimal(60.0)) == sliderForce);
+            rp3d_test(mFixedJoint->getReactionForce(decimal(1.0) / decimal(60.0)) == fixedForce);
+            rp3d_test(mFixedJoint->getReactionTorque(decimal(1.0) / decimal(60.0)) == fixedTorque);
+        }
+
+        /// Check that invalid snapshots are rejected
+        void testInvalidSnapshot() {
+
+            std::vector<uint8> snapshot;
+            mWorld->takeSnapshot(snapshot);
+
+            // Truncated snapshot
+            rp3d_test(!mWorld->restoreSnapshot(snapshot.data(), 10));
+
+            // Snapshot with an invalid magic string
+            std::vector<uint8> invalidSnapshot = snapshot;
+            invalidSnapshot[0] = 'X';
+            rp3d_test(!mWorld->restoreSnapshot(invalidSnapshot.data(), invalidSnapshot.size()));
+
+            // Snapshot of another world
+            PhysicsWorld* otherWorld = mPhysicsCommon.createPhysicsWorld();
+            rp3d_test(!otherWorld->restoreSnapshot(snapshot.data(), snapshot.size()));
+            std::vector<uint8> otherSnapshot;
+            otherWorld->takeSnapshot(otherSnapshot);
+            rp3d_test(!mWorld->restoreSnapshot(otherSnapshot.data(), otherSnapshot.size()));
+            mPhysicsCommon.destroyPhysicsWorld(otherWorld);
+
+            // Snapshot taken before a body has been created
+            RigidBody* body = mWorld->createRigidBody(Transform(Vector3(10, 10, 10), Quaternion::identity()));
+            rp3d_test(!mWorld->restoreSnapshot(snapshot.data(), snapshot.size()));
+            mWorld->destroyRigidBody(body);
+        }
+
+        /// Check that a snapshot that is rejected after its header has been read does not modify the world
+        void testFailedRestoreKeepsWorld() {
+
+            std::vector<uint8> snapshot;
+            mWorld->takeSnapshot(snapshot);
+
+            simulate(10);
+
+            std::vector<uint8> stateBeforeRestore;
+            mWorld->takeSnapshot(stateBeforeRestore);
+            rp3d_test(stateBeforeRestore != snapshot);
+
+            // The components are read before the end of the snapshot is reached
+            rp3d_test(!mWorld->restoreSnapshot(snapshot.data(), snapshot.size() - 4));
+
+            std::vector<uint8> stateAfterRestore;
+            mWorld->takeSnapshot(stateAfterRestore);
+            rp3d_test(stateAfterRestore == stateBeforeRestore);
+
+            // The snapshot does not contain a body created after it
+            RigidBody* body = mWorld->createRigidBody(Transform(Vector3(0, 30, 0), Quaternion::identity()));
+            std::vector<uint8> stateWithBody;
+            mWorld->takeSnapshot(stateWithBody);
+            rp3d_test(!mWorld->restoreSnapshot(snapshot.data(), snapshot.size()));
+
+            std::vector<uint8> stateAfterRestoreWithBody;
+            mWorld->takeSnapshot(stateAfterRestoreWithBody);
+            rp3d_test(stateAfterRestoreWithBody == stateWithBody);
+
+            mWorld->destroyRigidBody(body);
+        }
+};
+
+}
+
+#endif
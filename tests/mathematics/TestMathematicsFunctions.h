@@ -301,6 +301,22 @@ class TestMathematicsFunctions : public Test {
             rp3d_test(nextPowerOfTwo64Bits(1000) == 1024);
             rp3d_test(nextPowerOfTwo64Bits(129) == 256);
             rp3d_test(nextPowerOfTwo64Bits(260) == 512);
+
+            // Test computePortableAtan2() and computePortableAcos()
+            for (int i=-10; i <= 10; i++) {
+                for (int j=-10; j <= 10; j++) {
+                    const decimal y = decimal(i) * decimal(0.37);
+                    const decimal x = decimal(j) * decimal(0.53);
+                    if (i == 0 && j == 0) continue;
+                    rp3d_test(approxEqual(computePortableAtan2(y, x), std::atan2(y, x), decimal(0.000001)));
+                }
+            }
+            rp3d_test(computePortableAtan2(0, 0) == decimal(0.0));
+            for (int i=-20; i <= 20; i++) {
+                const decimal x = decimal(i) / decimal(20.0);
+                rp3d_test(approxEqual(computePortableAcos(x), std::acos(x), decimal(0.000001)));
+            }
+            rp3d_test(approxEqual(computePortableAcos(decimal(1.0001)), decimal(0.0)));
         }
 
  };
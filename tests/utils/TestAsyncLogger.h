@@ -0,0 +1,293 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_ASYNC_LOGGER_H
+#define TEST_ASYNC_LOGGER_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestAsyncLogger
+/**
+ * Unit test for the AsyncLogger and BinaryLogDecoder classes
+ */
+class TestAsyncLogger : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        /// Number of messages built by the RP3D_LOG test
+        int mNbBuiltMessages = 0;
+
+        // ---------- Methods ---------- //
+
+        /// Build a message (and count it)
+        std::string buildMessage(const std::string& text) {
+            mNbBuiltMessages++;
+            return text;
+        }
+
+        /// Decode a binary log
+        static bool decode(const std::string& binaryLog, std::vector<BinaryLogDecoder::Record>& records) {
+            std::istringstream input(binaryLog);
+            std::vector<Message> messages;
+            return BinaryLogDecoder::decode(input, [&records](const BinaryLogDecoder::Record& record) {
+                records.push_back(record);
+            }, messages);
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestAsyncLogger(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testBinaryLog();
+            testTextLog();
+            testMultipleThreads();
+            testFullQueue();
+            testLevels();
+            testInvalidLog();
+        }
+
+        void testBinaryLog() {
+
+            std::ostringstream output;
+            AsyncLogger* logger = mPhysicsCommon.createAsyncLogger();
+            logger->addBinaryStreamDestination(output, static_cast<uint>(Logger::Level::Information));
+
+            const std::string longMessage(1000, 'x');
+            logger->log(Logger::Level::Information, "World1", Logger::Category::Body, "Body 1 created", "Body.cpp", 12);
+            logger->log(Logger::Level::Warning, "World1", Logger::Category::Joint, "Joint broken", "Joint.cpp", 34);
+            logger->log(Logger::Level::Error, "World2", Logger::Category::Collider, longMessage, "Body.cpp", 56);
+            logger->flush();
+
+            std::vector<BinaryLogDecoder::Record> records;
+            rp3d_test(decode(output.str(), records));
+            rp3d_test(records.size() == 3);
+
+            rp3d_test(records[0].level == Logger::Level::Information);
+            rp3d_test(records[0].category == Logger::Category::Body);
+            rp3d_test(records[0].worldName == "World1");
+            rp3d_test(records[0].filename == "Body.cpp");
+            rp3d_test(records[0].lineNumber == 12);
+            rp3d_test(records[0].message == "Body 1 created");
+
+            rp3d_test(records[1].level == Logger::Level::Warning);
+            rp3d_test(records[1].category == Logger::Category::Joint);
+            rp3d_test(records[1].filename == "Joint.cpp");
+            rp3d_test(records[1].message == "Joint broken");
+            rp3d_test(records[1].time >= records[0].time);
+
+            // A message larger than a slot of the queue
+            rp3d_test(records[2].worldName == "World2");
+            rp3d_test(records[2].message == longMessage);
+            rp3d_test(records[2].lineNumber == 56);
+
+            // The strings are only written once in the binary log
+            rp3d_test(output.str().find("Body.cpp") == output.str().rfind("Body.cpp"));
+
+            // Text decoding
+            std::istringstream input(output.str());
+            std::ostringstream text;
+            std::vector<Message> messages;
+            rp3d_test(BinaryLogDecoder::decodeToText(input, text, messages));
+            rp3d_test(text.str().find("World:World1 Warning Joint: Joint broken (in file Joint.cpp at line 34)") != std::string::npos);
+
+            mPhysicsCommon.destroyAsyncLogger(logger);
+        }
+
+        void testTextLog() {
+
+            std::ostringstream output;
+            AsyncLogger* logger = mPhysicsCommon.createAsyncLogger();
+            logger->addTextStreamDestination(output, static_cast<uint>(Logger::Level::Warning));
+
+            logger->log(Logger::Level::Information, "World", Logger::Category::World, "Skipped", "World.cpp", 1);
+            logger->log(Logger::Level::Error, "World", Logger::Category::World, "Written", "World.cpp", 2);
+
+            // The messages still in the queue are written when the logger is destroyed
+            mPhysicsCommon.destroyAsyncLogger(logger);
+
+            rp3d_test(output.str().find("Skipped") == std::string::npos);
+            rp3d_test(output.str().find("World:World Error World: Written (in file World.cpp at line 2)") != std::string::npos);
+        }
+
+        void testMultipleThreads() {
+
+            const int nbThreads = 4;
+            const int nbMessagesPerThread = 2000;
+
+            std::ostringstream output;
+            AsyncLogger* logger = mPhysicsCommon.createAsyncLogger(1 << 16);
+            logger->addBinaryStreamDestination(output, static_cast<uint>(Logger::Level::Information));
+
+            std::vector<std::thread> threads;
+            for (int t = 0; t < nbThreads; t++) {
+                threads.emplace_back([logger, t]() {
+                    const std::string worldName = "World" + std::to_string(t);
+                    for (int i = 0; i < nbMessagesPerThread; i++) {
+                        logger->log(Logger::Level::Information, worldName, Logger::Category::World,
+                                    std::to_string(i), __FILE__, __LINE__);
+                    }
+                });
+            }
+            for (std::thread& thread : threads) {
+                thread.join();
+            }
+            logger->flush();
+
+            std::vector<BinaryLogDecoder::Record> records;
+            rp3d_test(decode(output.str(), records));
+
+            // Each thread must find all its messages in order (unless some have been dropped)
+            uint64 nbDroppedMessages = 0;
+            std::vector<int> nextMessages(nbThreads, 0);
+            bool isOrdered = true;
+            for (const BinaryLogDecoder::Record& record : records) {
+                if (record.nbDroppedMessages > 0) {
+                    nbDroppedMessages += record.nbDroppedMessages;
+                    continue;
+                }
+                const int thread = std::stoi(record.worldName.substr(5));
+                const int message = std::stoi(record.message);
+                isOrdered &= message >= nextMessages[thread];
+                nextMessages[thread] = message + 1;
+            }
+            rp3d_test(isOrdered);
+            rp3d_test(records.size() - (nbDroppedMessages > 0 ? 1 : 0) + nbDroppedMessages >= uint64(nbThreads * nbMessagesPerThread));
+
+            mPhysicsCommon.destroyAsyncLogger(logger);
+        }
+
+        void testFullQueue() {
+
+            const int nbMessages = 20000;
+
+            std::ostringstream output;
+            AsyncLogger* logger = mPhysicsCommon.createAsyncLogger(AsyncLogger::MIN_QUEUE_CAPACITY);
+            rp3d_test(logger->getQueueCapacity() == AsyncLogger::MIN_QUEUE_CAPACITY);
+            logger->addBinaryStreamDestination(output, static_cast<uint>(Logger::Level::Information));
+
+            // The logger never blocks, so the messages that do not fit in the queue are dropped and counted
+            for (int i = 0; i < nbMessages; i++) {
+                logger->log(Logger::Level::Information, "World", Logger::Category::Body, "Message", __FILE__, __LINE__);
+            }
+            logger->flush();
+
+            std::vector<BinaryLogDecoder::Record> records;
+            rp3d_test(decode(output.str(), records));
+
+            uint64 nbWrittenMessages = 0;
+            uint64 nbDroppedMessages = 0;
+            for (const BinaryLogDecoder::Record& record : records) {
+                nbWrittenMessages += record.nbDroppedMessages == 0 ? 1 : 0;
+                nbDroppedMessages += record.nbDroppedMessages;
+            }
+            rp3d_test(nbWrittenMessages + nbDroppedMessages == uint64(nbMessages));
+
+            mPhysicsCommon.destroyAsyncLogger(logger);
+        }
+
+        void testLevels() {
+
+            std::ostringstream output;
+            AsyncLogger* logger = mPhysicsCommon.createAsyncLogger();
+
+            // Nothing is logged without a destination
+            rp3d_test(!logger->isLevelEnabled(Logger::Level::Error));
+
+            logger->addTextStreamDestination(output, static_cast<uint>(Logger::Level::Warning) | static_cast<uint>(Logger::Level::Error));
+            rp3d_test(logger->isLevelEnabled(Logger::Level::Error));
+            rp3d_test(logger->isLevelEnabled(Logger::Level::Warning));
+            rp3d_test(!logger->isLevelEnabled(Logger::Level::Information));
+
+            // The messages of the disabled levels are not built by RP3D_LOG
+            Logger* previousLogger = PhysicsCommon::getLogger();
+            PhysicsCommon::setLogger(logger);
+            mNbBuiltMessages = 0;
+            RP3D_LOG("World", Logger::Level::Information, Logger::Category::World, buildMessage("Information"), __FILE__, __LINE__);
+            rp3d_test(mNbBuiltMessages == 0);
+            RP3D_LOG("World", Logger::Level::Warning, Logger::Category::World, buildMessage("Warning"), __FILE__, __LINE__);
+            rp3d_test(mNbBuiltMessages == 1);
+            PhysicsCommon::setLogger(previousLogger);
+
+            logger->flush();
+            rp3d_test(output.str().find("Warning World: Warning") != std::string::npos);
+
+            logger->removeAllDestinations();
+            rp3d_test(!logger->isLevelEnabled(Logger::Level::Error));
+
+            // The default logger also skips the levels of none of its destinations
+            DefaultLogger* defaultLogger = mPhysicsCommon.createDefaultLogger();
+            rp3d_test(!defaultLogger->isLevelEnabled(Logger::Level::Error));
+            defaultLogger->addStreamDestination(output, static_cast<uint>(Logger::Level::Error), DefaultLogger::Format::Text);
+            rp3d_test(defaultLogger->isLevelEnabled(Logger::Level::Error));
+            rp3d_test(!defaultLogger->isLevelEnabled(Logger::Level::Warning));
+
+            mPhysicsCommon.destroyDefaultLogger(defaultLogger);
+            mPhysicsCommon.destroyAsyncLogger(logger);
+        }
+
+        void testInvalidLog() {
+
+            std::vector<Message> messages;
+            std::istringstream input("not a binary log");
+            rp3d_test(!BinaryLogDecoder::decode(input, [](const BinaryLogDecoder::Record&) {}, messages));
+            rp3d_test(messages.size() == 1);
+
+            // Truncated log
+            std::ostringstream output;
+            AsyncLogger* logger = mPhysicsCommon.createAsyncLogger();
+            logger->addBinaryStreamDestination(output, static_cast<uint>(Logger::Level::Information));
+            logger->log(Logger::Level::Error, "World", Logger::Category::World, "Message", __FILE__, __LINE__);
+            mPhysicsCommon.destroyAsyncLogger(logger);
+
+            const std::string binaryLog = output.str();
+            std::istringstream truncatedInput(binaryLog.substr(0, binaryLog.size() - 3));
+            messages.clear();
+            rp3d_test(!BinaryLogDecoder::decode(truncatedInput, [](const BinaryLogDecoder::Record&) {}, messages));
+            rp3d_test(messages.size() == 1);
+        }
+};
+
+}
+
+#endif
@@ -0,0 +1,214 @@
+/********************************************************************************
+* ReactPhysics3D physics library, http://www.reactphysics3d.com                 *
+* Copyright (c) 2010-2016 Daniel Chappuis                                       *
+*********************************************************************************
+*                                                                               *
+* This software is provided 'as-is', without any express or implied warranty.   *
+* In no event will the authors be held liable for any damages arising from the  *
+* use of this software.                                                         *
+*                                                                               *
+* Permission is granted to anyone to use this software for any purpose,         *
+* including commercial applications, and to alter it and redistribute it        *
+* freely, subject to the following restrictions:                                *
+*                                                                               *
+* 1. The origin of this software must not be misrepresented; you must not claim *
+*    that you wrote the original software. If you use this software in a        *
+*    product, an acknowledgment in the product documentation would be           *
+*    appreciated but is not required.                                           *
+*                                                                               *
+* 2. Altered source versions must be plainly marked as such, and must not be    *
+*    misrepresented as being the original software.                             *
+*                                                                               *
+* 3. This notice may not be removed or altered from any source distribution.    *
+*                                                                               *
+********************************************************************************/
+
+#ifndef TEST_TRACE_RECORDER_H
+#define TEST_TRACE_RECORDER_H
+
+// Libraries
+#include "Test.h"
+#include <reactphysics3d/reactphysics3d.h>
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+/// Reactphysics3D namespace
+namespace reactphysics3d {
+
+// Class TestTraceRecorder
+/**
+ * Unit test for the TraceRecorder class
+ */
+class TestTraceRecorder : public Test {
+
+    private :
+
+        // ---------- Atributes ---------- //
+
+        PhysicsCommon mPhysicsCommon;
+
+        // ---------- Methods ---------- //
+
+        /// Create a world with a few falling bodies and take some steps
+        void simulate(uint32 nbSteps) {
+
+            PhysicsWorld* world = mPhysicsCommon.createPhysicsWorld();
+
+            RigidBody* ground = world->createRigidBody(Transform::identity());
+            ground->setType(BodyType::STATIC);
+            ground->addCollider(mPhysicsCommon.createBoxShape(Vector3(10, 1, 10)), Transform::identity());
+
+            for (int i=0; i < 3; i++) {
+                RigidBody* body = world->createRigidBody(Transform(Vector3(0, decimal(2 + 2 * i), 0), Quaternion::identity()));
+                body->addCollider(mPhysicsCommon.createSphereShape(decimal(0.5)), Transform::identity());
+            }
+
+            for (uint32 i=0; i < nbSteps; i++) {
+                world->update(decimal(1.0) / decimal(60.0));
+            }
+
+            mPhysicsCommon.destroyPhysicsWorld(world);
+        }
+
+        /// Return the content of a file
+        static std::string readFile(const std::string& filePath) {
+            std::ifstream file(filePath, std::ios::binary);
+            std::stringstream content;
+            content << file.rdbuf();
+            return content.str();
+        }
+
+    public :
+
+        // ---------- Methods ---------- //
+
+        /// Constructor
+        TestTraceRecorder(const std::string& name) : Test(name) {
+
+        }
+
+        /// Run the tests
+        void run() {
+            testDisabled();
+            testExport();
+            testRingBuffer();
+            testBufferCapacityOfOtherThreads();
+        }
+
+        void testDisabled() {
+
+            TraceRecorder::setIsEnabled(false);
+            TraceRecorder::clear();
+
+            simulate(10);
+
+            rp3d_test(!TraceRecorder::isEnabled());
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == 0);
+        }
+
+        void testExport() {
+
+            TraceRecorder::clear();
+            TraceRecorder::setIsEnabled(true);
+
+            simulate(10);
+
+            // Record events from another thread
+            std::thread thread([]() {
+                TraceRecorder::setThreadName("Worker \"1\"");
+                TraceScope outerScope("Worker::outer");
+                TraceScope innerScope("Worker::inner");
+            });
+            thread.join();
+
+            TraceRecorder::setIsEnabled(false);
+
+            const uint64 nbEvents = TraceRecorder::getNbRecordedEvents();
+            rp3d_test(nbEvents >= 12);
+
+            // Chrome trace
+            const std::string chromeFilePath = "rp3d_test_trace.json";
+            rp3d_test(TraceRecorder::exportChromeTrace(chromeFilePath));
+            const std::string chromeTrace = readFile(chromeFilePath);
+            rp3d_test(chromeTrace.find("{\"displayTimeUnit\":\"ms\",\"traceEvents\":[") == 0);
+            rp3d_test(chromeTrace.find("\"name\":\"PhysicsWorld::update()\"") != std::string::npos);
+            rp3d_test(chromeTrace.find("\"name\":\"Worker::inner\"") != std::string::npos);
+            rp3d_test(chromeTrace.find("\"args\":{\"name\":\"Worker \\\"1\\\"\"}") != std::string::npos);
+            rp3d_test(chromeTrace.find("\"ph\":\"X\"") != std::string::npos);
+            rp3d_test(chromeTrace.find("]}") != std::string::npos);
+            std::remove(chromeFilePath.c_str());
+
+            // Perfetto trace (a sequence of TracePacket fields)
+            const std::string perfettoFilePath = "rp3d_test_trace.perfetto-trace";
+            rp3d_test(TraceRecorder::exportPerfettoTrace(perfettoFilePath));
+            const std::string perfettoTrace = readFile(perfettoFilePath);
+            rp3d_test(perfettoTrace.size() > 0);
+            rp3d_test(perfettoTrace[0] == 0x0A);
+            rp3d_test(perfettoTrace.find("PhysicsWorld::update()") != std::string::npos);
+            rp3d_test(perfettoTrace.find("Worker::outer") != std::string::npos);
+            std::remove(perfettoFilePath.c_str());
+
+            // Exporting does not remove the events
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == nbEvents);
+
+            TraceRecorder::clear();
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == 0);
+        }
+
+        void testRingBuffer() {
+
+            TraceRecorder::setBufferCapacity(3);
+            TraceRecorder::setIsEnabled(true);
+
+            for (int i=0; i < 10; i++) {
+                TraceScope scope("Loop");
+            }
+
+            TraceRecorder::setIsEnabled(false);
+
+            // The capacity is rounded up to a power of two and the oldest events are overwritten
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == 4);
+
+            TraceRecorder::setBufferCapacity(1 << 16);
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == 0);
+        }
+
+        void testBufferCapacityOfOtherThreads() {
+
+            TraceRecorder::clear();
+            TraceRecorder::setIsEnabled(true);
+
+            auto recordEvents = []() {
+                for (int i=0; i < 10; i++) {
+                    TraceScope scope("Worker::loop");
+                }
+            };
+
+            std::thread thread(recordEvents);
+            thread.join();
+
+            // The capacity is changed while the recording is disabled (the buffer of
+            // the thread that has already recorded events is reallocated)
+            TraceRecorder::setIsEnabled(false);
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == 10);
+            TraceRecorder::setBufferCapacity(2);
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == 0);
+
+            // The new threads and the calling thread use the new capacity
+            TraceRecorder::setIsEnabled(true);
+            std::thread thread2(recordEvents);
+            thread2.join();
+            recordEvents();
+            TraceRecorder::setIsEnabled(false);
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == 4);
+
+            TraceRecorder::setBufferCapacity(1 << 16);
+            rp3d_test(TraceRecorder::getNbRecordedEvents() == 0);
+        }
+ };
+
+}
+
+#endif